@@ -0,0 +1,156 @@
+#ifndef COMPONENT_STORAGE_HPP
+#define COMPONENT_STORAGE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+
+// Storage for the components of one EntityInterface that only pays for the
+// components it actually holds.
+//
+// Small trivially copyable components live in an inline arena, packed in
+// the order they are first touched. Anything else -- components with
+// vectors, maps or strings, or whatever no longer fits inline -- goes to a
+// full std::tuple that is only allocated the first time it is needed. A
+// terrain voxel (entity type, position, matter container) therefore never
+// allocates, and only rich entities such as creatures with an inventory
+// carry the tuple.
+//
+// A component keeps its place once it has one, so references stay valid
+// for the lifetime of the storage (removing a component from the mask does
+// not free its slot). Like the std::tuple this replaces, get() on a
+// component that was never set gives a value-initialised one.
+
+template <std::size_t InlineBytes, typename Tuple>
+class SparseComponentStorage;
+
+template <std::size_t InlineBytes, typename... Components>
+class SparseComponentStorage<InlineBytes, std::tuple<Components...>> {
+  static_assert(InlineBytes < 0xFE, "inline offsets must fit in a byte");
+
+public:
+  using Tuple = std::tuple<Components...>;
+
+  SparseComponentStorage() { slots_.fill(kAbsent); }
+
+  SparseComponentStorage(const SparseComponentStorage &other)
+      : slots_(other.slots_), used_(other.used_),
+        spill_(other.spill_ ? std::make_unique<Tuple>(*other.spill_)
+                            : nullptr) {
+    std::memcpy(arena_, other.arena_, used_);
+  }
+
+  SparseComponentStorage(SparseComponentStorage &&other) noexcept
+      : slots_(other.slots_), used_(other.used_),
+        spill_(std::move(other.spill_)) {
+    std::memcpy(arena_, other.arena_, used_);
+    other.slots_.fill(kAbsent);
+    other.used_ = 0;
+  }
+
+  SparseComponentStorage &operator=(const SparseComponentStorage &other) {
+    if (this != &other) {
+      SparseComponentStorage copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  SparseComponentStorage &operator=(SparseComponentStorage &&other) noexcept {
+    if (this != &other) {
+      slots_ = other.slots_;
+      used_ = other.used_;
+      spill_ = std::move(other.spill_);
+      std::memcpy(arena_, other.arena_, used_);
+      other.slots_.fill(kAbsent);
+      other.used_ = 0;
+    }
+    return *this;
+  }
+
+  // The component, giving it a value-initialised slot if it has none yet.
+  template <typename Component> Component &get() {
+    constexpr std::size_t i = indexOf<Component>();
+    static_assert(i < sizeof...(Components), "not a stored component type");
+    const uint8_t slot = slots_[i];
+    if (slot == kSpilled) {
+      return std::get<Component>(*spill_);
+    }
+    if (slot != kAbsent) {
+      return *std::launder(reinterpret_cast<Component *>(arena_ + slot));
+    }
+    return place<Component>();
+  }
+
+  template <typename Component> const Component &get() const {
+    constexpr std::size_t i = indexOf<Component>();
+    static_assert(i < sizeof...(Components), "not a stored component type");
+    const uint8_t slot = slots_[i];
+    if (slot == kSpilled) {
+      return std::get<Component>(*spill_);
+    }
+    if (slot != kAbsent) {
+      const unsigned char *at = arena_ + slot;
+      return *std::launder(reinterpret_cast<const Component *>(at));
+    }
+    static const Component empty{};
+    return empty;
+  }
+
+  template <typename Component> void set(const Component &component) {
+    get<Component>() = component;
+  }
+
+  // Bytes in use inline, and whether the tuple has been allocated.
+  std::size_t inlineBytesUsed() const { return used_; }
+  bool spilled() const { return spill_ != nullptr; }
+
+private:
+  static constexpr uint8_t kAbsent = 0xFF;
+  static constexpr uint8_t kSpilled = 0xFE;
+  static constexpr std::size_t kArenaAlign = alignof(std::uint64_t);
+
+  template <typename Component> static constexpr std::size_t indexOf() {
+    constexpr bool matches[] = {std::is_same_v<Component, Components>...};
+    for (std::size_t i = 0; i < sizeof...(Components); ++i) {
+      if (matches[i]) {
+        return i;
+      }
+    }
+    return sizeof...(Components);
+  }
+
+  template <typename Component> Component &place() {
+    constexpr std::size_t i = indexOf<Component>();
+    if constexpr (std::is_trivially_copyable_v<Component> &&
+                  alignof(Component) <= kArenaAlign &&
+                  sizeof(Component) <= InlineBytes) {
+      const std::size_t offset =
+          (used_ + alignof(Component) - 1) / alignof(Component) *
+          alignof(Component);
+      if (offset + sizeof(Component) <= InlineBytes) {
+        Component *c = ::new (arena_ + offset) Component{};
+        slots_[i] = static_cast<uint8_t>(offset);
+        used_ = static_cast<uint8_t>(offset + sizeof(Component));
+        return *c;
+      }
+    }
+    if (!spill_) {
+      spill_ = std::make_unique<Tuple>();
+    }
+    slots_[i] = kSpilled;
+    return std::get<Component>(*spill_);
+  }
+
+  std::array<uint8_t, sizeof...(Components)> slots_;
+  uint8_t used_ = 0;
+  alignas(kArenaAlign) unsigned char arena_[InlineBytes];
+  std::unique_ptr<Tuple> spill_;
+};
+
+#endif // COMPONENT_STORAGE_HPP
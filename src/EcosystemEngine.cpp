@@ -9,6 +9,7 @@
 #include <ranges>
 #include <sstream>
 #include <thread>
+#include <utility>
 
 #include "components/WaterStressComponent.hpp"
 #include "ecosystem/ReadonlyQueries.hpp"
@@ -56,7 +57,8 @@ void GridBoxProcessor::initializeAccessors(entt::registry &registry,
 }
 
 std::vector<WaterFlow> GridBoxProcessor::processBox(const GridBox &box,
-                                                    float sunIntensity) {
+                                                    float sunIntensity,
+                                                    int ticksDue) {
   std::vector<WaterFlow> pendingFlows;
 
   std::random_device rd;
@@ -69,7 +71,7 @@ std::vector<WaterFlow> GridBoxProcessor::processBox(const GridBox &box,
     for (int y = box.minY; y <= box.maxY; ++y) {
       for (int x = box.minX; x <= box.maxX; ++x) {
         processTileWater(x, y, z, *registry_, *voxelGrid_, *sink_, sunIntensity,
-                         rd, gen, disWaterSpreading);
+                         rd, gen, disWaterSpreading, ticksDue);
         // processVoxelWater(x, y, z, pendingFlows);
         // processVoxelEvaporation(x, y, z, pendingFlows);
       }
@@ -209,7 +211,8 @@ void WaterSimulationManager::workerThreadFunction(int threadId,
   while (!stopWorkers_) {
     size_t boxIndex;
     float sunIntensity;
-    bool hasTask = scheduler_.getNextTask(boxIndex, sunIntensity);
+    int ticksDue;
+    bool hasTask = scheduler_.getNextTask(boxIndex, sunIntensity, ticksDue);
 
     if (!hasTask) {
       // No tasks available, wait briefly or until notified
@@ -226,8 +229,9 @@ void WaterSimulationManager::workerThreadFunction(int threadId,
 
     try {
       // Process the box
-      auto modifications = processBoxConcurrently(
-          threadId % processors_.size(), gridBoxes_[boxIndex], sunIntensity);
+      auto modifications =
+          processBoxConcurrently(threadId % processors_.size(),
+                                 gridBoxes_[boxIndex], sunIntensity, ticksDue);
 
       // Push results to concurrent queue
       resultQueue_.push(std::move(modifications));
@@ -269,21 +273,51 @@ void WaterSimulationManager::populateSchedulerWithSubset(float percentage,
   const bool runSync =
       PhysicsManager::Instance()->getRunEcosystemSynchronously();
 
+  const std::shared_ptr<const SimulationLodMap> lod =
+      simulationLod_ ? simulationLod_->snapshot() : nullptr;
+  if (boxVisits_.size() != gridBoxes_.size()) {
+    boxVisits_.assign(gridBoxes_.size(), 0);
+    boxSkipped_.assign(gridBoxes_.size(), 0);
+  }
+  LodTally tally;
+
   for (size_t i = 0; i < numBoxesToAdd; ++i) {
     size_t boxIndex = (startIndex + i) % gridBoxes_.size();
+    // Visits this run covers: itself plus the ones LOD skipped since the
+    // box last ran, even if its level has changed since.
+    int ticksDue = 1;
+    if (lod) {
+      const GridBox &box = gridBoxes_[boxIndex];
+      const LodLevel level =
+          lod->nearestLevel(box.minX, box.minY, box.maxX, box.maxY);
+      const bool due = boxVisits_[boxIndex]++ % lod->interval(level) == 0;
+      tally.add(level, due);
+      if (!due) {
+        ++boxSkipped_[boxIndex];
+        continue;
+      }
+      ticksDue += std::exchange(boxSkipped_[boxIndex], 0);
+    }
     if (runSync) {
       // Diagnostic mode: bypass the worker pool and process the box on the
       // calling (main) thread. Workers idle on their wait_for(1ms) loop.
-      auto modifications =
-          processors_[0]->processBox(gridBoxes_[boxIndex], sunIntensity);
+      std::vector<WaterFlow> modifications;
+      {
+        aetherion::diag::ScopedTimer boxTimer(boxJobNs_);
+        modifications = processors_[0]->processBox(gridBoxes_[boxIndex],
+                                                   sunIntensity, ticksDue);
+      }
       resultQueue_.push(std::move(modifications));
     } else {
-      scheduler_.addTask(boxIndex, sunIntensity);
+      scheduler_.addTask(boxIndex, sunIntensity, ticksDue);
     }
   }
 
   // Update start index for next call to ensure different boxes are processed
   startIndex = (startIndex + numBoxesToAdd) % gridBoxes_.size();
+  if (lod) {
+    lod->record(tally);
+  }
 }
 
 std::vector<GridBox> WaterSimulationManager::partitionGridIntoBoxes(
@@ -336,14 +370,23 @@ std::vector<GridBox> WaterSimulationManager::partitionGridIntoBoxes(
 }
 
 std::vector<WaterFlow> WaterSimulationManager::processBoxConcurrently(
-    int processorIndex, const GridBox &box, float sunIntensity) {
+    int processorIndex, const GridBox &box, float sunIntensity, int ticksDue) {
   if (processorIndex >= processors_.size()) {
     return {}; // Safety check
   }
 
   // Use shared_lock for concurrent reads
   std::shared_lock<std::shared_mutex> readLock(gridWriteMutex_);
-  return processors_[processorIndex]->processBox(box, sunIntensity);
+  aetherion::diag::ScopedTimer boxTimer(boxJobNs_);
+  return processors_[processorIndex]->processBox(box, sunIntensity, ticksDue);
+}
+
+void WaterSimulationManager::registerDiagCounters() {
+  aetherion::diag::HistogramConfig cfg;
+  cfg.name = "water_box_job_ns";
+  cfg.flush_every = std::chrono::seconds{1};
+  cfg.sinks = {aetherion::diag::GameDBSink{}};
+  boxJobNs_ = aetherion::diag::Registry::instance().histogram(cfg);
 }
 
 void WaterSimulationManager::applyModificationsWithLock(
@@ -527,24 +570,25 @@ void spreadWater(int terrainId, int terrainX, int terrainY, int terrainZ,
                  entt::registry &registry, VoxelGrid &voxelGrid,
                  EventSink &sink, entt::entity entity,
                  EntityTypeComponent &type, MatterContainer &matterContainer,
-                 int x, int y, int z, DirectionEnum direction) {
+                 int x, int y, int z, DirectionEnum direction,
+                 const TerrainStencil *stencil) {
   auto logger = Logger::getLogger();
   if (matterContainer.WaterMatter <= 0) {
     // No water to spread
     return;
   }
 
-  int terrainNeighborId = voxelGrid.getTerrain(x, y, z);
+  int terrainNeighborId = terrainIdAt(voxelGrid, stencil, x, y, z);
   bool actionPerformed = false;
-  const bool isAboveNeighborEmpty{
-      isTerrainVoxelEmptyOrSoftEmpty(registry, voxelGrid, sink, x, y, z + 1)};
+  const bool isAboveNeighborEmpty{isTerrainVoxelEmptyOrSoftEmpty(
+      registry, voxelGrid, sink, x, y, z + 1, stencil)};
 
   if (terrainNeighborId != static_cast<int>(TerrainIdTypeEnum::NONE)) {
     auto terrainNeighbor = static_cast<entt::entity>(terrainNeighborId);
     EntityTypeComponent typeNeighbor =
-        voxelGrid.terrainGridRepository->getTerrainEntityType(x, y, z);
+        terrainEntityTypeAt(voxelGrid, stencil, x, y, z);
     MatterContainer matterContainerNeighbor =
-        voxelGrid.terrainGridRepository->getTerrainMatterContainer(x, y, z);
+        terrainMatterAt(voxelGrid, stencil, x, y, z);
 
     // if (registry.all_of<EntityTypeComponent,
     // MatterContainer>(terrainNeighbor)) {
@@ -733,7 +777,14 @@ bool moveWater(int terrainEntityId, entt::registry &registry,
   const bool isWater =
       (type.mainType == static_cast<int>(EntityEnum::TERRAIN) &&
        type.subType0 == static_cast<int>(TerrainEnum::WATER));
-  int terrainBellowId = voxelGrid.getTerrain(pos.x, pos.y, pos.z - 1);
+  // Everything below probes this voxel's 3x3x3 neighbourhood (below, the
+  // four sides, and the cell above the chosen side); read it in one pass.
+  const TerrainStencil stencil = voxelGrid.terrainGridRepository->getStencil(
+      pos.x, pos.y, pos.z,
+      StencilField::TERRAIN_ID | StencilField::ENTITY_TYPE |
+          StencilField::MATTER);
+  const int below = TerrainStencil::index(0, 0, -1);
+  int terrainBellowId = static_cast<int>(stencil.terrainId[below]);
 
   bool isBellowGrass = false;
   bool canSpredWaterDown = false;
@@ -753,12 +804,10 @@ bool moveWater(int terrainEntityId, entt::registry &registry,
 
   if (terrainBellowId != static_cast<int>(TerrainIdTypeEnum::NONE)) {
     // Read terrain data for detection (no state changes here)
-    EntityTypeComponent typeBellow =
-        voxelGrid.terrainGridRepository->getTerrainEntityType(pos.x, pos.y,
-                                                              pos.z - 1);
-    MatterContainer matterContainerBellow =
-        voxelGrid.terrainGridRepository->getTerrainMatterContainer(pos.x, pos.y,
-                                                                   pos.z - 1);
+    EntityTypeComponent typeBellow{stencil.mainType[below],
+                                   stencil.subType0[below],
+                                   stencil.subType1[below]};
+    MatterContainer matterContainerBellow = stencil.matter[below];
 
     // Water can only be taken from a water terrain and moved to a terrain that
     // is not higher (not full type of terrain).
@@ -806,28 +855,28 @@ bool moveWater(int terrainEntityId, entt::registry &registry,
         bool isNeighborWater = false;
         if (movingDirection == static_cast<int>(DirectionEnum::UP)) {
           std::tie(isNeighborEmpty, isNeighborWater) = isNeighborWaterOrEmpty(
-              registry, voxelGrid, pos.x, pos.y - 1, pos.z);
+              registry, voxelGrid, pos.x, pos.y - 1, pos.z, &stencil);
           if (!isNeighborEmpty && isNeighborWater) {
             movingDirection = disWaterSpreading(gen);
           }
 
         } else if (movingDirection == static_cast<int>(DirectionEnum::LEFT)) {
           std::tie(isNeighborEmpty, isNeighborWater) = isNeighborWaterOrEmpty(
-              registry, voxelGrid, pos.x - 1, pos.y, pos.z);
+              registry, voxelGrid, pos.x - 1, pos.y, pos.z, &stencil);
           if (!isNeighborEmpty && isNeighborWater) {
             movingDirection = disWaterSpreading(gen);
           }
 
         } else if (movingDirection == static_cast<int>(DirectionEnum::RIGHT)) {
           std::tie(isNeighborEmpty, isNeighborWater) = isNeighborWaterOrEmpty(
-              registry, voxelGrid, pos.x + 1, pos.y, pos.z);
+              registry, voxelGrid, pos.x + 1, pos.y, pos.z, &stencil);
           if (!isNeighborEmpty && isNeighborWater) {
             movingDirection = disWaterSpreading(gen);
           }
 
         } else if (movingDirection == static_cast<int>(DirectionEnum::DOWN)) {
           std::tie(isNeighborEmpty, isNeighborWater) = isNeighborWaterOrEmpty(
-              registry, voxelGrid, pos.x, pos.y + 1, pos.z);
+              registry, voxelGrid, pos.x, pos.y + 1, pos.z, &stencil);
           if (!isNeighborEmpty && isNeighborWater) {
             movingDirection = disWaterSpreading(gen);
           }
@@ -867,19 +916,23 @@ bool moveWater(int terrainEntityId, entt::registry &registry,
       if (movingDirection == static_cast<int>(DirectionEnum::UP)) {
         spreadWater(terrainEntityId, pos.x, pos.y, pos.z, registry, voxelGrid,
                     sink, terrain, type, matterContainer, pos.x, pos.y - 1,
-                    pos.z, static_cast<DirectionEnum>(movingDirection));
+                    pos.z, static_cast<DirectionEnum>(movingDirection),
+                    &stencil);
       } else if (movingDirection == static_cast<int>(DirectionEnum::LEFT)) {
         spreadWater(terrainEntityId, pos.x, pos.y, pos.z, registry, voxelGrid,
                     sink, terrain, type, matterContainer, pos.x - 1, pos.y,
-                    pos.z, static_cast<DirectionEnum>(movingDirection));
+                    pos.z, static_cast<DirectionEnum>(movingDirection),
+                    &stencil);
       } else if (movingDirection == static_cast<int>(DirectionEnum::RIGHT)) {
         spreadWater(terrainEntityId, pos.x, pos.y, pos.z, registry, voxelGrid,
                     sink, terrain, type, matterContainer, pos.x + 1, pos.y,
-                    pos.z, static_cast<DirectionEnum>(movingDirection));
+                    pos.z, static_cast<DirectionEnum>(movingDirection),
+                    &stencil);
       } else if (movingDirection == static_cast<int>(DirectionEnum::DOWN)) {
         spreadWater(terrainEntityId, pos.x, pos.y, pos.z, registry, voxelGrid,
                     sink, terrain, type, matterContainer, pos.x, pos.y + 1,
-                    pos.z, static_cast<DirectionEnum>(movingDirection));
+                    pos.z, static_cast<DirectionEnum>(movingDirection),
+                    &stencil);
       }
       actionPerformed = true;
     }
@@ -1051,7 +1104,10 @@ void moveVaporUp(entt::registry &registry, VoxelGrid &voxelGrid,
                  EventSink &sink, Position &pos, EntityTypeComponent &type,
                  MatterContainer &matterContainer) {
   // RAII-based lock guard: automatically unlocks on any exit (return/exception)
-  TerrainGridLock lock(voxelGrid.terrainGridRepository.get());
+  // Only reads happen here (the move itself is an event), so a shared lock on
+  // the cell's region and its neighbours is enough.
+  TerrainRegionLock lock(voxelGrid.terrainGridRepository.get(),
+                         {{pos.x, pos.y, pos.z}}, TerrainLockMode::SHARED);
 
   // Atomic operation: Get terrain ID at current position
   int terrainId = voxelGrid.getTerrain(pos.x, pos.y, pos.z);
@@ -1128,14 +1184,15 @@ void moveVaporUp(entt::registry &registry, VoxelGrid &voxelGrid,
     }
   }
 
-  // Lock automatically released by TerrainGridLock destructor
+  // Lock automatically released by TerrainRegionLock destructor
 }
 
 void moveVaporSideways(entt::registry &registry, VoxelGrid &voxelGrid,
                        EventSink &sink, Position &pos,
                        EntityTypeComponent &type,
                        MatterContainer &matterContainer) {
-  TerrainGridLock lock(voxelGrid.terrainGridRepository.get());
+  TerrainRegionLock lock(voxelGrid.terrainGridRepository.get(),
+                         {{pos.x, pos.y, pos.z}}, TerrainLockMode::SHARED);
 
   int terrainId = voxelGrid.getTerrain(pos.x, pos.y, pos.z);
 
@@ -1423,7 +1480,8 @@ void moveVapor(entt::registry &registry, VoxelGrid &voxelGrid, EventSink &sink,
 void processTileWater(int x, int y, int z, entt::registry &registry,
                       VoxelGrid &voxelGrid, EventSink &sink, float sunIntensity,
                       std::random_device &rd, std::mt19937 &gen,
-                      std::uniform_int_distribution<> &disWaterSpreading) {
+                      std::uniform_int_distribution<> &disWaterSpreading,
+                      int ticksDue) {
   bool terrainExists = voxelGrid.checkIfTerrainExists(x, y, z);
 
   if (!terrainExists) {
@@ -1544,9 +1602,10 @@ void processTileWater(int x, int y, int z, entt::registry &registry,
                matterContainer.WaterMatter > 0);
           if (canEvaporate) {
             // Dispatch event - PhysicsEngine handles heat accumulation and
-            // evaporation
-            EvaporateWaterEntityEvent evaporateWaterEntityEvent{entt::null, pos,
-                                                                sunIntensity};
+            // evaporation. Heat builds up linearly with sunIntensity, so a
+            // box LOD skipped gets the heat of every visit it missed.
+            EvaporateWaterEntityEvent evaporateWaterEntityEvent{
+                entt::null, pos, sunIntensity * static_cast<float>(ticksDue)};
             sink.enqueue<EvaporateWaterEntityEvent>(evaporateWaterEntityEvent);
             actionPerformed = true;
           }
@@ -1598,7 +1657,9 @@ void processTileWater(int x, int y, int z, entt::registry &registry,
 //==============================================================================
 
 void processPlants(entt::registry &registry, VoxelGrid &voxelGrid,
-                   EventSink &sink, GameClock &clock) {
+                   EventSink &sink, GameClock &clock,
+                   const SimulationLodMap *lod) {
+  LodTally tally;
   std::random_device rd;
   std::mt19937 gen(rd());
 
@@ -1621,63 +1682,79 @@ void processPlants(entt::registry &registry, VoxelGrid &voxelGrid,
     auto &plantResources = plantResourcesView.get<PlantResources>(entity);
     auto &health = plantResourcesView.get<HealthComponent>(entity);
 
-    const float healthPercent = health.healthLevel / health.maxHealth;
-
-    if (plantResources.water >= WATER_FOR_PRODUCE_ENERGY && sunIntensity > 0) {
-      plantResources.water -= WATER_FOR_PRODUCE_ENERGY;
-      const float energyProduced =
-          PHOTOSYNTHESIS_BASE_RATE * sunIntensity * healthPercent;
-      plantResources.currentEnergy += energyProduced;
-      // std::cout << "Plant produced " << energyProduced << " amounts of
-      // energy\n";
+    int ticks = 1;
+    if (lod) {
+      if (const auto *pos = registry.try_get<Position>(entity)) {
+        ticks = lod->ticksDue(pos->x, pos->y);
+        tally.add(lod->level(pos->x, pos->y), ticks != 0);
+      }
     }
 
-    // TODO: Evaluate if it is better to have another async system for
-    // processing plants
-    if (registry.all_of<FruitGrowth, EntityTypeComponent, Inventory>(entity)) {
-      auto &fruitGrowth = fruitGrowthView.get<FruitGrowth>(entity);
-
-      int dice_throw = disFruitGrowth(gen);
-      if (
-          // dice_throw > 5 &&
-          fruitGrowth.currentEnergy < fruitGrowth.energyNeeded &&
-          plantResources.currentEnergy > 1.0) {
-        plantResources.currentEnergy -= 1.0;
-        fruitGrowth.currentEnergy++;
+    // Plants in a LOD region that just came due catch up on every tick
+    // since it last ran.
+    for (int tick = 0; tick < ticks; ++tick) {
+      const float healthPercent = health.healthLevel / health.maxHealth;
+
+      if (plantResources.water >= WATER_FOR_PRODUCE_ENERGY &&
+          sunIntensity > 0) {
+        plantResources.water -= WATER_FOR_PRODUCE_ENERGY;
+        const float energyProduced =
+            PHOTOSYNTHESIS_BASE_RATE * sunIntensity * healthPercent;
+        plantResources.currentEnergy += energyProduced;
+        // std::cout << "Plant produced " << energyProduced << " amounts of
+        // energy\n";
       }
 
-      auto &&[type, inventory] =
-          inventoryView.get<EntityTypeComponent, Inventory>(entity);
-      if (type.mainType == 1 && type.subType0 == 1 &&
-          inventory.itemIDs.size() < static_cast<size_t>(inventory.maxItems) &&
-          fruitGrowth.currentEnergy >= fruitGrowth.energyNeeded) {
-        auto raspberryFruit = registry.create();
-
-        registry.emplace<ItemTypeComponent>(
-            raspberryFruit,
-            ItemTypeComponent{static_cast<int>(ItemEnum::FOOD),
-                              static_cast<int>(ItemFoodEnum::RASPBERRY_FRUIT)});
-        registry.emplace<FoodItem>(raspberryFruit,
-                                   FoodItem{.energyDensity = 0.1,
-                                            .mass = 60,
-                                            .volume = 20,
-                                            .energyHealthRatio = 0.3,
-                                            .convertionEfficiency = 0.3});
-
-        auto entityId = entt::to_integral(raspberryFruit);
-        inventory.itemIDs.push_back(entityId);
-
-        fruitGrowth.currentEnergy = 0;
-      }
+      // TODO: Evaluate if it is better to have another async system for
+      // processing plants
+      if (registry.all_of<FruitGrowth, EntityTypeComponent, Inventory>(
+              entity)) {
+        auto &fruitGrowth = fruitGrowthView.get<FruitGrowth>(entity);
+
+        int dice_throw = disFruitGrowth(gen);
+        if (
+            // dice_throw > 5 &&
+            fruitGrowth.currentEnergy < fruitGrowth.energyNeeded &&
+            plantResources.currentEnergy > 1.0) {
+          plantResources.currentEnergy -= 1.0;
+          fruitGrowth.currentEnergy++;
+        }
+
+        auto &&[type, inventory] =
+            inventoryView.get<EntityTypeComponent, Inventory>(entity);
+        if (type.mainType == 1 && type.subType0 == 1 &&
+            inventory.itemIDs.size() <
+                static_cast<size_t>(inventory.maxItems) &&
+            fruitGrowth.currentEnergy >= fruitGrowth.energyNeeded) {
+          auto raspberryFruit = registry.create();
+
+          registry.emplace<ItemTypeComponent>(
+              raspberryFruit,
+              ItemTypeComponent{
+                  static_cast<int>(ItemEnum::FOOD),
+                  static_cast<int>(ItemFoodEnum::RASPBERRY_FRUIT)});
+          registry.emplace<FoodItem>(raspberryFruit,
+                                     FoodItem{.energyDensity = 0.1,
+                                              .mass = 60,
+                                              .volume = 20,
+                                              .energyHealthRatio = 0.3,
+                                              .convertionEfficiency = 0.3});
+
+          auto entityId = entt::to_integral(raspberryFruit);
+          inventory.itemIDs.push_back(entityId);
+
+          fruitGrowth.currentEnergy = 0;
+        }
 
-      int health_dice_throw = disFruitGrowth(gen);
-      if (health_dice_throw > 5 && plantResources.currentEnergy > 1.0 &&
-          health.healthLevel < health.maxHealth) {
-        plantResources.currentEnergy -= 1.0;
+        int health_dice_throw = disFruitGrowth(gen);
+        if (health_dice_throw > 5 && plantResources.currentEnergy > 1.0 &&
+            health.healthLevel < health.maxHealth) {
+          plantResources.currentEnergy -= 1.0;
 
-        health.healthLevel++;
-        if (health.healthLevel > health.maxHealth) {
-          health.healthLevel = health.maxHealth;
+          health.healthLevel++;
+          if (health.healthLevel > health.maxHealth) {
+            health.healthLevel = health.maxHealth;
+          }
         }
       }
     }
@@ -1712,6 +1789,15 @@ void processPlants(entt::registry &registry, VoxelGrid &voxelGrid,
     auto &health = stressView.get<HealthComponent>(entity);
     auto &pos = stressView.get<Position>(entity);
 
+    int ticks = 1;
+    if (lod) {
+      ticks = lod->ticksDue(pos.x, pos.y);
+      tally.add(lod->level(pos.x, pos.y), ticks != 0);
+      if (ticks == 0) {
+        continue;
+      }
+    }
+
     bool has_water_supply = false;
     if (auto *res = registry.try_get<PlantResources>(entity);
         res && res->water > 0) {
@@ -1726,24 +1812,30 @@ void processPlants(entt::registry &registry, VoxelGrid &voxelGrid,
       }
     }
 
-    if (has_water_supply) {
-      stress.water_stress_ticks = std::max(0, stress.water_stress_ticks - 1);
-    } else {
-      stress.water_stress_ticks +=
-          PhysicsManager::Instance()->getStressPerDryTick();
-    }
+    for (int tick = 0; tick < ticks; ++tick) {
+      if (has_water_supply) {
+        stress.water_stress_ticks = std::max(0, stress.water_stress_ticks - 1);
+      } else {
+        stress.water_stress_ticks +=
+            PhysicsManager::Instance()->getStressPerDryTick();
+      }
 
-    if (stress.water_stress_ticks >
-        PhysicsManager::Instance()->getMaxWaterStressTicks()) {
-      // One stress cycle complete: apply chunk damage and reset the
-      // counter so the plant has another full stress runway before the
-      // next hit. Produces a visible step-down in HP each cycle rather
-      // than a smooth per-tick drain.
-      health.healthLevel -=
-          PhysicsManager::Instance()->getDroughtDamagePerCycle();
-      stress.water_stress_ticks = 0;
+      if (stress.water_stress_ticks >
+          PhysicsManager::Instance()->getMaxWaterStressTicks()) {
+        // One stress cycle complete: apply chunk damage and reset the
+        // counter so the plant has another full stress runway before the
+        // next hit. Produces a visible step-down in HP each cycle rather
+        // than a smooth per-tick drain.
+        health.healthLevel -=
+            PhysicsManager::Instance()->getDroughtDamagePerCycle();
+        stress.water_stress_ticks = 0;
+      }
     }
   }
+
+  if (lod) {
+    lod->record(tally);
+  }
 }
 
 //==============================================================================
@@ -1765,7 +1857,9 @@ void EcosystemEngine::processEcosystem(entt::registry &registry,
   // std::cout << "Processing ecosystem\n";
 
   float sunIntensity = SunIntensity::getIntensity(clock);
-  processPlants(registry, voxelGrid, sink, clock);
+  const std::shared_ptr<const SimulationLodMap> lod =
+      simulationLod_ ? simulationLod_->snapshot() : nullptr;
+  processPlants(registry, voxelGrid, sink, clock, lod.get());
 }
 
 // 8.2 processEcosystemAsync - Async water simulation
@@ -20,6 +20,7 @@
 #include "LifeEvents.hpp"
 #include "Logger.hpp"
 #include "MoveEntityEvent.hpp"
+#include "SimulationLod.hpp"
 #include "SunIntensity.hpp"
 #include "components/EntityTypeComponent.hpp"
 #include "components/HealthComponents.hpp"
@@ -28,6 +29,7 @@
 #include "components/PhysicsComponents.hpp"
 #include "components/PlantsComponents.hpp"
 #include "components/TerrainComponents.hpp"
+#include "diag/Diag.hpp"
 #include "ecosystem/EcosystemEvents.hpp"
 #include "physics/PhysicsManager.hpp"
 #include "terrain/TerrainStorage.hpp"
@@ -79,11 +81,12 @@ class WaterSimulationManager;
 struct GridBoxTask {
   size_t boxIndex;
   float sunIntensity;
+  int ticksDue; // Round-robin visits this run covers (see SimulationLod)
   std::chrono::steady_clock::time_point creationTime;
   int priority; // Lower values = higher priority
 
-  GridBoxTask(size_t idx, float sunIntensity)
-      : boxIndex(idx), sunIntensity(sunIntensity),
+  GridBoxTask(size_t idx, float sunIntensity, int ticksDue = 1)
+      : boxIndex(idx), sunIntensity(sunIntensity), ticksDue(ticksDue),
         creationTime(std::chrono::steady_clock::now()), priority(0) {}
 
   // Comparison operator for priority queue (lower priority value = higher
@@ -111,15 +114,15 @@ public:
   RoundRobinScheduler()
       : gen_(rd_()), randomDist_(0, 5) {} // Small random variance
 
-  void addTask(size_t boxIndex, float sunIntensity) {
+  void addTask(size_t boxIndex, float sunIntensity, int ticksDue = 1) {
     std::lock_guard<std::mutex> lock(queueMutex_);
-    GridBoxTask task(boxIndex, sunIntensity);
+    GridBoxTask task(boxIndex, sunIntensity, ticksDue);
     task.priority = nextPriority_.fetch_add(1) +
                     randomDist_(gen_); // FIFO with small randomization
     taskQueue_.push(task);
   }
 
-  bool getNextTask(size_t &boxIndex, float &sunIntensity) {
+  bool getNextTask(size_t &boxIndex, float &sunIntensity, int &ticksDue) {
     std::lock_guard<std::mutex> lock(queueMutex_);
     if (taskQueue_.empty())
       return false;
@@ -129,6 +132,7 @@ public:
 
     boxIndex = task.boxIndex;
     sunIntensity = task.sunIntensity;
+    ticksDue = task.ticksDue;
     return true;
   }
 
@@ -180,7 +184,9 @@ public:
   void initializeAccessors(entt::registry &registry, VoxelGrid &voxelGrid,
                            EventSink &sink);
 
-  std::vector<WaterFlow> processBox(const GridBox &box, float sunIntensity);
+  // `ticksDue` > 1 when SimulationLod skipped the box on earlier visits.
+  std::vector<WaterFlow> processBox(const GridBox &box, float sunIntensity,
+                                    int ticksDue = 1);
 
 private:
   void processVoxelWater(int x, int y, int z, std::vector<WaterFlow> &flows);
@@ -213,6 +219,16 @@ private:
   std::atomic<bool> hasEncounteredCriticalError_{false};
   std::atomic<bool> isShuttingDown_{false};
 
+  // Boxes far from observers are only scheduled on every interval-th
+  // round-robin visit; boxVisits_ counts the visits per box and
+  // boxSkipped_ the ones since it last ran, which its next run catches up.
+  const SimulationLod *simulationLod_ = nullptr;
+  std::vector<uint32_t> boxVisits_;
+  std::vector<int> boxSkipped_;
+
+  // Wall time of one processBox() call, on a worker or the main thread.
+  aetherion::diag::Histogram boxJobNs_;
+
   // Default minimum box dimensions for optimal cache performance (32x32x32)
   static constexpr int DEFAULT_MIN_BOX_SIZE = 32;
 
@@ -232,6 +248,12 @@ public:
   void populateSchedulerWithSubset(float percentage = 0.3f,
                                    float sunIntensity = 1.0f);
 
+  // Register the box job histogram. Call once after
+  // `aetherion::diag::Registry::instance().initialize(...)`.
+  void registerDiagCounters();
+
+  void setSimulationLod(const SimulationLod *lod) { simulationLod_ = lod; }
+
   // Error checking methods
   bool hasErrors();
   std::vector<ThreadError> getErrors();
@@ -262,7 +284,8 @@ private:
   // Process a single box concurrently
   std::vector<WaterFlow> processBoxConcurrently(int processorIndex,
                                                 const GridBox &box,
-                                                float sunIntensity);
+                                                float sunIntensity,
+                                                int ticksDue);
 
   // Apply water flow modifications with thread synchronization
   void applyModificationsWithLock(entt::registry &registry,
@@ -284,10 +307,13 @@ struct ToBeCreatedWaterTile {
   StructuralIntegrityComponent structuralIntegrity;
 };
 
+// `ticksDue` visits are caught up at once: evaporation heat is scaled by
+// it, while water still moves at most one voxel per call.
 void processTileWater(int x, int y, int z, entt::registry &registry,
                       VoxelGrid &voxelGrid, EventSink &sink, float sunIntensity,
                       std::random_device &rd, std::mt19937 &gen,
-                      std::uniform_int_distribution<> &disWaterSpreading);
+                      std::uniform_int_distribution<> &disWaterSpreading,
+                      int ticksDue = 1);
 
 class EcosystemEngine {
 public:
@@ -327,7 +353,16 @@ public:
 
   bool isProcessingComplete() const;
 
+  // Plants and water boxes skip LOD regions that are not due; null runs
+  // them every tick.
+  void setSimulationLod(const SimulationLod *lod) {
+    simulationLod_ = lod;
+    waterSimManager_->setSimulationLod(lod);
+  }
+
 private:
+  const SimulationLod *simulationLod_ = nullptr;
+
   // entt::registry& registry;
   // VoxelGrid* voxelGrid;
 
@@ -0,0 +1,240 @@
+#ifndef ECS_COMMAND_BUFFER_HPP
+#define ECS_COMMAND_BUFFER_HPP
+
+#include <oneapi/tbb/enumerable_thread_specific.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Deferred structural edits (create / emplace / remove / destroy) for an
+// entt::registry, which is not safe to restructure from worker threads.
+// Where EventSink defers *events* to the main thread, EcsCommandQueue
+// defers the registry edits themselves: any thread records into its own
+// EcsCommandBuffer, and World plays every buffer back at the cleanup sync
+// point in World::update, when no async task is touching the registry.
+//
+// A buffer is applied in three steps:
+//   1. creates      -- one range registry.create()
+//   2. components   -- per component type, emplaces and removes in the
+//                      order they were recorded; each run of consecutive
+//                      removes is one range registry.remove<T>()
+//   3. destroys     -- sorted, deduplicated, one range registry.destroy()
+// Edits to different component types commute, so each entity ends up as if
+// its commands had run in recording order: "remove<T> then emplace<T>"
+// leaves T in place, "emplace<T> then remove<T>" leaves it absent. Anything
+// recorded for an entity that is destroyed in the same buffer is dropped
+// with it. Commands for entities that are no longer valid at playback are
+// skipped.
+
+// An entity reserved by EcsCommandBuffer::create(). It only has meaning in
+// the buffer that made it (i.e. on the thread that recorded it) and turns
+// into a real entity at playback.
+struct PendingEntity {
+  uint32_t index;
+};
+
+class EcsCommandBuffer {
+public:
+  // Either an existing entity or one reserved by create().
+  class Target {
+  public:
+    Target(entt::entity entity) : entity_(entity) {}
+    Target(PendingEntity pending) : pending_(pending.index) {}
+
+    entt::entity resolve(const std::vector<entt::entity> &created) const {
+      return pending_ == kNotPending ? entity_ : created[pending_];
+    }
+
+  private:
+    static constexpr uint32_t kNotPending = ~uint32_t{0};
+    entt::entity entity_ = entt::null;
+    uint32_t pending_ = kNotPending;
+  };
+
+  EcsCommandBuffer() = default;
+  EcsCommandBuffer(const EcsCommandBuffer &) = delete;
+  EcsCommandBuffer &operator=(const EcsCommandBuffer &) = delete;
+
+  PendingEntity create() { return PendingEntity{createCount_++}; }
+
+  // Paren-init, like WorkerEventSink::enqueue, so aggregates and the
+  // narrowing conversions existing emplace calls rely on both work.
+  template <typename T, typename... Args>
+  void emplace(Target target, Args &&...args) {
+    queue<T>().ops.emplace_back(target, T(std::forward<Args>(args)...));
+  }
+
+  template <typename T> void remove(Target target) {
+    queue<T>().ops.emplace_back(target, std::nullopt);
+  }
+
+  void destroy(Target target) { destroys_.push_back(target); }
+
+  bool empty() const {
+    if (createCount_ != 0 || !destroys_.empty()) {
+      return false;
+    }
+    return std::none_of(queues_.begin(), queues_.end(),
+                        [](const auto &q) { return q.queue->size() != 0; });
+  }
+
+  // Applies the buffer to `registry` and clears it. Main thread only.
+  void playback(entt::registry &registry) {
+    created_.resize(createCount_);
+    if (createCount_ != 0) {
+      registry.create(created_.begin(), created_.end());
+    }
+    for (auto &q : queues_) {
+      q.queue->apply(registry, created_, scratch_);
+    }
+
+    scratch_.clear();
+    for (const Target &target : destroys_) {
+      const entt::entity entity = target.resolve(created_);
+      if (registry.valid(entity)) {
+        scratch_.push_back(entity);
+      }
+    }
+    std::sort(scratch_.begin(), scratch_.end());
+    scratch_.erase(std::unique(scratch_.begin(), scratch_.end()),
+                   scratch_.end());
+    registry.destroy(scratch_.begin(), scratch_.end());
+
+    destroys_.clear();
+    created_.clear();
+    scratch_.clear();
+    createCount_ = 0;
+  }
+
+private:
+  struct QueueBase {
+    virtual ~QueueBase() = default;
+    virtual std::size_t size() const = 0;
+    virtual void apply(entt::registry &registry,
+                       const std::vector<entt::entity> &created,
+                       std::vector<entt::entity> &scratch) = 0;
+  };
+
+  // One component type's emplaces (a value) and removes (nullopt), in
+  // recording order.
+  template <typename T> struct Queue final : QueueBase {
+    std::vector<std::pair<Target, std::optional<T>>> ops;
+
+    std::size_t size() const override { return ops.size(); }
+
+    void apply(entt::registry &registry,
+               const std::vector<entt::entity> &created,
+               std::vector<entt::entity> &scratch) override {
+      // Removes are gathered until the next emplace, then applied as one
+      // range, so the order between an entity's commands is kept.
+      scratch.clear();
+      auto flushRemoves = [&] {
+        registry.remove<T>(scratch.begin(), scratch.end());
+        scratch.clear();
+      };
+      for (auto &[target, value] : ops) {
+        const entt::entity entity = target.resolve(created);
+        if (!registry.valid(entity)) {
+          continue;
+        }
+        if (!value) {
+          scratch.push_back(entity);
+          continue;
+        }
+        if (!scratch.empty()) {
+          flushRemoves();
+        }
+        registry.emplace_or_replace<T>(entity, std::move(*value));
+      }
+      flushRemoves();
+      ops.clear();
+    }
+  };
+
+  struct TypedQueue {
+    entt::id_type type;
+    std::unique_ptr<QueueBase> queue;
+  };
+
+  // A handful of component types per buffer, so a linear scan beats a map.
+  // Queues are kept across playbacks to reuse their capacity.
+  template <typename T> Queue<T> &queue() {
+    const entt::id_type type = entt::type_hash<T>::value();
+    for (auto &q : queues_) {
+      if (q.type == type) {
+        return static_cast<Queue<T> &>(*q.queue);
+      }
+    }
+    queues_.push_back(TypedQueue{type, std::make_unique<Queue<T>>()});
+    return static_cast<Queue<T> &>(*queues_.back().queue);
+  }
+
+  uint32_t createCount_ = 0;
+  std::vector<TypedQueue> queues_;
+  std::vector<Target> destroys_;
+  std::vector<entt::entity> created_;
+  std::vector<entt::entity> scratch_;
+};
+
+// One EcsCommandBuffer per recording thread. The recording calls are safe
+// from any thread; pending() may be read from any thread; playback() must
+// run on the main thread while no other thread is recording.
+class EcsCommandQueue {
+public:
+  EcsCommandQueue() = default;
+  EcsCommandQueue(const EcsCommandQueue &) = delete;
+  EcsCommandQueue &operator=(const EcsCommandQueue &) = delete;
+
+  // The calling thread's buffer, for a run of commands that refer to the
+  // same PendingEntity. Count them with noteRecorded().
+  EcsCommandBuffer &local() { return buffers_.local(); }
+  void noteRecorded(std::size_t commands = 1) {
+    pending_.fetch_add(commands, std::memory_order_relaxed);
+  }
+
+  PendingEntity create() {
+    noteRecorded();
+    return local().create();
+  }
+
+  template <typename T, typename... Args>
+  void emplace(EcsCommandBuffer::Target target, Args &&...args) {
+    local().emplace<T>(target, std::forward<Args>(args)...);
+    noteRecorded();
+  }
+
+  template <typename T> void remove(EcsCommandBuffer::Target target) {
+    local().remove<T>(target);
+    noteRecorded();
+  }
+
+  void destroy(EcsCommandBuffer::Target target) {
+    local().destroy(target);
+    noteRecorded();
+  }
+
+  // Commands recorded since the last playback.
+  std::size_t pending() const {
+    return pending_.load(std::memory_order_relaxed);
+  }
+
+  void playback(entt::registry &registry) {
+    for (EcsCommandBuffer &buffer : buffers_) {
+      buffer.playback(registry);
+    }
+    pending_.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  tbb::enumerable_thread_specific<EcsCommandBuffer> buffers_;
+  std::atomic<std::size_t> pending_{0};
+};
+
+#endif // ECS_COMMAND_BUFFER_HPP
@@ -14,6 +14,7 @@
 #include <utility>
 #include <ylt/struct_pack.hpp>
 
+#include "ComponentStorage.hpp"
 #include "components/ConsoleLogsComponent.hpp"
 #include "components/DnaComponents.hpp"
 #include "components/EntityTypeComponent.hpp"
@@ -72,8 +73,10 @@ public:
   int entityId = -1;
   std::bitset<COMPONENT_COUNT> componentMask; // Bitmask for component presence
 
-  // Components stored in a tuple
-  ComponentTypes components;
+  // Only the components that have been touched take space; see
+  // ComponentStorage.hpp. 64 inline bytes hold a terrain voxel's entity
+  // type, position and matter container without allocating.
+  SparseComponentStorage<64, ComponentTypes> components;
 
   // Mark components as present
   void addComponent(ComponentFlag flag) { componentMask.set(flag); }
@@ -92,15 +95,15 @@ public:
 
   // Generic getter and setter for components
   template <typename Component> Component &getComponent() {
-    return std::get<Component>(components);
+    return components.get<Component>();
   }
 
   template <typename Component> const Component &getComponent() const {
-    return std::get<Component>(components);
+    return components.get<Component>();
   }
 
   template <typename Component> void setComponent(const Component &component) {
-    std::get<Component>(components) = component;
+    components.set(component);
     addComponent(componentFlag<Component>());
   }
 
@@ -121,26 +124,44 @@ public:
   // Exact byte size of the serialized representation. Public so callers
   // that write into a pre-sized destination can ask for the size up front.
   size_t computeSerializedSize() const {
-    EntityHeader header{entityId, componentMask.to_ullong()};
-    size_t total = struct_pack::get_needed_size(header).size();
-    addSerializedSizeForComponents(
-        total,
-        std::make_index_sequence<std::tuple_size<ComponentTypes>::value>{});
-    return total;
+    return computeSerializedSize(componentMask);
   }
 
   // Writes the entity bytes into `dst[0..N-1]`, `N == computeSerializedSize()`.
   // Caller owns sizing the buffer; no growth, no bounds check. Produces the
   // same bytes as `serialize()`.
   size_t serializeInto(uint8_t *dst) const {
+    return serializeInto(dst, componentMask);
+  }
+
+  // Same as above for the present components in `mask` only; the header
+  // carries that narrower mask, so deserialize() reads back just those.
+  size_t computeSerializedSize(std::bitset<COMPONENT_COUNT> mask) const {
+    mask &= componentMask;
+    EntityHeader header{entityId, mask.to_ullong()};
+    size_t total = struct_pack::get_needed_size(header).size();
+    addSerializedSizeForComponents(
+        total, mask,
+        std::make_index_sequence<std::tuple_size<ComponentTypes>::value>{});
+    return total;
+  }
+
+  size_t serializeInto(uint8_t *dst, std::bitset<COMPONENT_COUNT> mask) const {
+    mask &= componentMask;
     size_t cursor = 0;
-    writeHeaderInto(dst, cursor);
+    writeHeaderInto(dst, cursor, mask);
     writeComponentsInto(
-        dst, cursor,
+        dst, cursor, mask,
         std::make_index_sequence<std::tuple_size<ComponentTypes>::value>{});
     return cursor;
   }
 
+  // Helper to get the ComponentFlag for a given component type
+  template <typename Component> static constexpr ComponentFlag componentFlag() {
+    return componentFlagImpl<Component, ComponentTypes>(
+        std::make_index_sequence<std::tuple_size<ComponentTypes>::value>{});
+  }
+
   // Deserialization function
   static EntityInterface deserialize(const char *data, size_t size) {
     EntityInterface entityInterface;
@@ -188,12 +209,6 @@ public:
 #endif
 
 private:
-  // Helper to get the ComponentFlag for a given component type
-  template <typename Component> static constexpr ComponentFlag componentFlag() {
-    return componentFlagImpl<Component, ComponentTypes>(
-        std::make_index_sequence<std::tuple_size<ComponentTypes>::value>{});
-  }
-
   template <typename Component, typename Tuple, std::size_t... Is>
   static constexpr ComponentFlag componentFlagImpl(std::index_sequence<Is...>) {
     ComponentFlag flags[] = {static_cast<ComponentFlag>(Is)...};
@@ -282,15 +297,17 @@ private:
 
   template <std::size_t... Is>
   void addSerializedSizeForComponents(size_t &total,
+                                      const std::bitset<COMPONENT_COUNT> &mask,
                                       std::index_sequence<Is...>) const {
     (...,
      addSerializedSizeForComponent<std::tuple_element_t<Is, ComponentTypes>>(
-         total));
+         total, mask));
   }
 
   template <typename Component>
-  void addSerializedSizeForComponent(size_t &total) const {
-    if (!hasComponent(componentFlag<Component>())) {
+  void addSerializedSizeForComponent(
+      size_t &total, const std::bitset<COMPONENT_COUNT> &mask) const {
+    if (!mask.test(componentFlag<Component>())) {
       return;
     }
     if constexpr (std::is_trivially_copyable_v<Component>) {
@@ -309,8 +326,9 @@ private:
     }
   };
 
-  void writeHeaderInto(uint8_t *dst, size_t &cursor) const {
-    EntityHeader header{entityId, componentMask.to_ullong()};
+  void writeHeaderInto(uint8_t *dst, size_t &cursor,
+                       const std::bitset<COMPONENT_COUNT> &mask) const {
+    EntityHeader header{entityId, mask.to_ullong()};
     const size_t hsz = struct_pack::get_needed_size(header).size();
     RawByteWriter w{reinterpret_cast<char *>(dst + cursor)};
     struct_pack::serialize_to(w, header);
@@ -319,14 +337,17 @@ private:
 
   template <std::size_t... Is>
   void writeComponentsInto(uint8_t *dst, size_t &cursor,
+                           const std::bitset<COMPONENT_COUNT> &mask,
                            std::index_sequence<Is...>) const {
     (...,
-     writeComponentInto<std::tuple_element_t<Is, ComponentTypes>>(dst, cursor));
+     writeComponentInto<std::tuple_element_t<Is, ComponentTypes>>(dst, cursor,
+                                                                  mask));
   }
 
   template <typename Component>
-  void writeComponentInto(uint8_t *dst, size_t &cursor) const {
-    if (!hasComponent(componentFlag<Component>())) {
+  void writeComponentInto(uint8_t *dst, size_t &cursor,
+                          const std::bitset<COMPONENT_COUNT> &mask) const {
+    if (!mask.test(componentFlag<Component>())) {
       return;
     }
     if constexpr (std::is_trivially_copyable_v<Component>) {
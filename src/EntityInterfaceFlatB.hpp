@@ -0,0 +1,229 @@
+#ifndef ENTITY_INTERFACE_FLATB_HPP
+#define ENTITY_INTERFACE_FLATB_HPP
+
+#include <atomic>
+#include <bitset>
+#include <optional>
+#include <stdexcept>
+
+#include "EntityInterface.hpp"
+#include "EntityInterface_generated.h"
+#include "flatbuffers/flatbuffers.h"
+
+// EntityInterface on the FlatBuffers wire. With EntityWireFormat::TABLES
+// (the default) the flat per-entity components -- entity type, position,
+// velocity, health and perception -- go out as the tables in
+// schemas/Components.fbs, and only the remaining components are packed into
+// the struct_pack entity_data blob. Readers can then pick a single field
+// without decoding anything else (EntityInterfaceFlatB below).
+//
+// EntityWireFormat::BLOB writes the old all-blob form for clients that have
+// not moved over yet. Both forms are always read.
+
+enum class EntityWireFormat : uint8_t { BLOB, TABLES };
+
+inline std::atomic<EntityWireFormat> &entityWireFormatSetting() {
+  static std::atomic<EntityWireFormat> format{EntityWireFormat::TABLES};
+  return format;
+}
+
+inline EntityWireFormat getEntityWireFormat() {
+  return entityWireFormatSetting().load(std::memory_order_relaxed);
+}
+
+inline void setEntityWireFormat(EntityWireFormat format) {
+  entityWireFormatSetting().store(format, std::memory_order_relaxed);
+}
+
+// Components written as tables in the TABLES format.
+inline std::bitset<COMPONENT_COUNT> entityTableComponents() {
+  std::bitset<COMPONENT_COUNT> mask;
+  mask.set(ENTITY_TYPE);
+  mask.set(POSITION);
+  mask.set(VELOCITY);
+  mask.set(HEALTH);
+  mask.set(PERCEPTION);
+  return mask;
+}
+
+inline flatbuffers::Offset<GameEngine::EntityInterface>
+serializeEntityFlatB(flatbuffers::FlatBufferBuilder &builder,
+                     const EntityInterface &entity, int entityId) {
+  if (getEntityWireFormat() == EntityWireFormat::BLOB) {
+    const size_t total = entity.computeSerializedSize();
+    uint8_t *dst = nullptr;
+    auto data = builder.CreateUninitializedVector<uint8_t>(total, &dst);
+    entity.serializeInto(dst);
+    return GameEngine::CreateEntityInterface(builder, entityId, data);
+  }
+
+  const std::bitset<COMPONENT_COUNT> rest =
+      entity.componentMask & ~entityTableComponents();
+  flatbuffers::Offset<flatbuffers::Vector<uint8_t>> data = 0;
+  if (rest.any()) {
+    const size_t total = entity.computeSerializedSize(rest);
+    uint8_t *dst = nullptr;
+    data = builder.CreateUninitializedVector<uint8_t>(total, &dst);
+    entity.serializeInto(dst, rest);
+  }
+
+  flatbuffers::Offset<GameEngine::EntityTypeComponent> entityType = 0;
+  if (entity.hasComponent(ENTITY_TYPE)) {
+    const auto &c = entity.getComponent<EntityTypeComponent>();
+    entityType = GameEngine::CreateEntityTypeComponent(builder, c.mainType,
+                                                       c.subType0, c.subType1);
+  }
+  flatbuffers::Offset<GameEngine::Position> position = 0;
+  if (entity.hasComponent(POSITION)) {
+    const auto &c = entity.getComponent<Position>();
+    position = GameEngine::CreatePosition(
+        builder, c.x, c.y, c.z,
+        static_cast<GameEngine::DirectionEnum>(c.direction));
+  }
+  flatbuffers::Offset<GameEngine::Velocity> velocity = 0;
+  if (entity.hasComponent(VELOCITY)) {
+    const auto &c = entity.getComponent<Velocity>();
+    velocity = GameEngine::CreateVelocity(builder, c.vx, c.vy, c.vz);
+  }
+  flatbuffers::Offset<GameEngine::HealthComponent> health = 0;
+  if (entity.hasComponent(HEALTH)) {
+    const auto &c = entity.getComponent<HealthComponent>();
+    health =
+        GameEngine::CreateHealthComponent(builder, c.healthLevel, c.maxHealth);
+  }
+  flatbuffers::Offset<GameEngine::PerceptionComponent> perception = 0;
+  if (entity.hasComponent(PERCEPTION)) {
+    const auto &c = entity.getComponent<PerceptionComponent>();
+    perception = GameEngine::CreatePerceptionComponent(
+        builder, c.perception_area, c.z_perception_area);
+  }
+
+  return GameEngine::CreateEntityInterface(
+      builder, entityId, data, GameEngine::EntityFormat_TABLES,
+      entity.componentMask.to_ullong(), entityType, position, velocity, health,
+      perception);
+}
+
+// Full decode of either format.
+inline EntityInterface
+deserializeEntityFlatB(const GameEngine::EntityInterface *fbEntity) {
+  if (!fbEntity) {
+    throw std::invalid_argument("fbEntity pointer is null");
+  }
+
+  EntityInterface entity;
+  const auto *data = fbEntity->entity_data();
+  if (data && data->size() != 0) {
+    entity = EntityInterface::deserialize(
+        reinterpret_cast<const char *>(data->data()), data->size());
+  } else if (fbEntity->format() == GameEngine::EntityFormat_BLOB) {
+    throw std::runtime_error(
+        "entity_data is missing in FlatBuffer EntityInterface");
+  }
+  entity.entityId = fbEntity->entityId();
+  if (fbEntity->format() == GameEngine::EntityFormat_BLOB) {
+    return entity;
+  }
+
+  if (const auto *t = fbEntity->entity_type()) {
+    entity.setComponent(EntityTypeComponent{t->type(), t->subType0(),
+                                            t->subType1()});
+  }
+  if (const auto *t = fbEntity->position()) {
+    entity.setComponent(Position{t->x(), t->y(), t->z(),
+                                 static_cast<DirectionEnum>(t->direction())});
+  }
+  if (const auto *t = fbEntity->velocity()) {
+    entity.setComponent(Velocity{t->vx(), t->vy(), t->vz()});
+  }
+  if (const auto *t = fbEntity->health()) {
+    entity.setComponent(HealthComponent{t->healthLevel(), t->maxHealth()});
+  }
+  if (const auto *t = fbEntity->perception()) {
+    entity.setComponent(
+        PerceptionComponent{t->perception_area(), t->z_perception_area()});
+  }
+  entity.componentMask =
+      std::bitset<COMPONENT_COUNT>(fbEntity->component_mask());
+  return entity;
+}
+
+// Reads single components of a FlatBuffers entity in place. Table
+// components cost one vtable lookup per field; anything else (and every
+// component of a BLOB entity) falls back to decoding the entity once.
+// The view does not own the buffer it points into.
+class EntityInterfaceFlatB {
+public:
+  explicit EntityInterfaceFlatB(const GameEngine::EntityInterface *fbEntity)
+      : fbEntity(fbEntity) {
+    if (!fbEntity) {
+      throw std::invalid_argument("fbEntity pointer is null");
+    }
+  }
+
+  int getEntityId() const { return fbEntity->entityId(); }
+
+  bool isTables() const {
+    return fbEntity->format() == GameEngine::EntityFormat_TABLES;
+  }
+
+  bool hasComponent(ComponentFlag flag) const {
+    if (isTables()) {
+      return std::bitset<COMPONENT_COUNT>(fbEntity->component_mask())
+          .test(flag);
+    }
+    return decoded().hasComponent(flag);
+  }
+
+  EntityTypeComponent getEntityType() const {
+    if (const auto *t = isTables() ? fbEntity->entity_type() : nullptr) {
+      return EntityTypeComponent{t->type(), t->subType0(), t->subType1()};
+    }
+    return decoded().getComponent<EntityTypeComponent>();
+  }
+
+  Position getPosition() const {
+    if (const auto *t = isTables() ? fbEntity->position() : nullptr) {
+      return Position{t->x(), t->y(), t->z(),
+                      static_cast<DirectionEnum>(t->direction())};
+    }
+    return decoded().getComponent<Position>();
+  }
+
+  Velocity getVelocity() const {
+    if (const auto *t = isTables() ? fbEntity->velocity() : nullptr) {
+      return Velocity{t->vx(), t->vy(), t->vz()};
+    }
+    return decoded().getComponent<Velocity>();
+  }
+
+  HealthComponent getHealth() const {
+    if (const auto *t = isTables() ? fbEntity->health() : nullptr) {
+      return HealthComponent{t->healthLevel(), t->maxHealth()};
+    }
+    return decoded().getComponent<HealthComponent>();
+  }
+
+  PerceptionComponent getPerception() const {
+    if (const auto *t = isTables() ? fbEntity->perception() : nullptr) {
+      return PerceptionComponent{t->perception_area(), t->z_perception_area()};
+    }
+    return decoded().getComponent<PerceptionComponent>();
+  }
+
+  // Every component, decoded.
+  const EntityInterface &getEntity() const { return decoded(); }
+
+private:
+  const EntityInterface &decoded() const {
+    if (!entity) {
+      entity = deserializeEntityFlatB(fbEntity);
+    }
+    return *entity;
+  }
+
+  const GameEngine::EntityInterface *fbEntity;
+  mutable std::optional<EntityInterface> entity;
+};
+
+#endif // ENTITY_INTERFACE_FLATB_HPP
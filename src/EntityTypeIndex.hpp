@@ -0,0 +1,123 @@
+#ifndef ENTITY_TYPE_INDEX_HPP
+#define ENTITY_TYPE_INDEX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "components/EntityTypeComponent.hpp"
+
+// Secondary index from (mainType, subType0) to the entities carrying that
+// EntityTypeComponent, so "all squirrels" or "all plants" is a lookup
+// instead of a scan over every typed entity. Each type keeps a dense
+// entt::sparse_set, so a query hands back one packed array.
+//
+// connect() keeps the index in step with the registry through the
+// EntityTypeComponent construct/update/destroy signals. Changing the type
+// in place through get<>() bypasses them; use replace()/patch() (or
+// emplace_or_replace) to retype an entity.
+//
+// Not synchronised: writers are whoever touches the registry, readers
+// hold the same locks they would for a registry view.
+class EntityTypeIndex {
+public:
+  EntityTypeIndex() = default;
+  EntityTypeIndex(const EntityTypeIndex &) = delete;
+  EntityTypeIndex &operator=(const EntityTypeIndex &) = delete;
+
+  // Hooks the EntityTypeComponent signals of `registry` and indexes the
+  // components it already holds. Pair with disconnect() before either
+  // side is destroyed.
+  void connect(entt::registry &registry) {
+    registry.on_construct<EntityTypeComponent>()
+        .connect<&EntityTypeIndex::onTypeChanged>(*this);
+    registry.on_update<EntityTypeComponent>()
+        .connect<&EntityTypeIndex::onTypeChanged>(*this);
+    registry.on_destroy<EntityTypeComponent>()
+        .connect<&EntityTypeIndex::onTypeDestroyed>(*this);
+    for (auto [entity, type] : registry.view<EntityTypeComponent>().each()) {
+      insert(entity, type);
+    }
+  }
+
+  void disconnect(entt::registry &registry) {
+    registry.on_construct<EntityTypeComponent>()
+        .disconnect<&EntityTypeIndex::onTypeChanged>(*this);
+    registry.on_update<EntityTypeComponent>()
+        .disconnect<&EntityTypeIndex::onTypeChanged>(*this);
+    registry.on_destroy<EntityTypeComponent>()
+        .disconnect<&EntityTypeIndex::onTypeDestroyed>(*this);
+  }
+
+  // Entities of the type, packed and in no particular order. Valid until
+  // the next change to an entity of that type.
+  const entt::sparse_set &entities(int mainType, int subType0) const {
+    auto it = byType_.find(keyOf(mainType, subType0));
+    return it != byType_.end() ? it->second : empty_;
+  }
+
+  std::size_t count(int mainType, int subType0) const {
+    return entities(mainType, subType0).size();
+  }
+
+  // Number of indexed entities.
+  std::size_t size() const { return size_; }
+
+private:
+  static constexpr uint64_t kUnindexed = ~uint64_t{0};
+
+  static uint64_t keyOf(int mainType, int subType0) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(mainType)) << 32) |
+           static_cast<uint32_t>(subType0);
+  }
+
+  static std::size_t indexOf(entt::entity entity) {
+    return static_cast<std::size_t>(entt::to_entity(entity));
+  }
+
+  void insert(entt::entity entity, const EntityTypeComponent &type) {
+    const uint64_t key = keyOf(type.mainType, type.subType0);
+    const std::size_t i = indexOf(entity);
+    if (i >= keys_.size()) {
+      keys_.resize(std::max<std::size_t>(i + 1, keys_.size() * 2),
+                   kUnindexed);
+    }
+    if (keys_[i] == key) {
+      return;
+    }
+    if (keys_[i] != kUnindexed) {
+      byType_[keys_[i]].remove(entity);
+      --size_;
+    }
+    byType_[key].push(entity);
+    keys_[i] = key;
+    ++size_;
+  }
+
+  void erase(entt::entity entity) {
+    const std::size_t i = indexOf(entity);
+    if (i < keys_.size() && keys_[i] != kUnindexed) {
+      byType_[keys_[i]].remove(entity);
+      keys_[i] = kUnindexed;
+      --size_;
+    }
+  }
+
+  void onTypeChanged(entt::registry &registry, entt::entity entity) {
+    insert(entity, registry.get<EntityTypeComponent>(entity));
+  }
+  void onTypeDestroyed(entt::registry &, entt::entity entity) {
+    erase(entity);
+  }
+
+  std::unordered_map<uint64_t, entt::sparse_set> byType_;
+  std::vector<uint64_t> keys_; // type key by entity id
+  entt::sparse_set empty_;
+  std::size_t size_ = 0;
+};
+
+#endif // ENTITY_TYPE_INDEX_HPP
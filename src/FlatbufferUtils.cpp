@@ -15,20 +15,7 @@ nb::object fbGetEntityById(
     if (entity->entityId() == entity_id) {
       // std::cout << "Entity found. ID: " << entity_id << std::endl;
 
-      // Retrieve the entity_data
-      auto data = entity->entity_data();
-      std::vector<char> entity_buffer;
-      if (data) {
-        entity_buffer.resize(data->size());
-        std::memcpy(entity_buffer.data(), data->data(), data->size());
-      }
-
-      // Deserialize into EntityInterface
-      EntityInterface deserializedEntity = EntityInterface::deserialize(
-          entity_buffer.data(), entity_buffer.size());
-
-      // Assign the entityId (if not already handled in deserialize)
-      deserializedEntity.entityId = entity->entityId();
+      EntityInterface deserializedEntity = deserializeEntityFlatB(entity);
 
       return nb::cast(deserializedEntity);
     }
@@ -47,20 +34,8 @@ void populateEntitiesMap(std::unordered_map<int, EntityInterface> &entities,
   }
 
   for (auto flatbufferEntity : flatbuffersEntities) {
-    // Retrieve the entity_data
-    auto data = flatbufferEntity->entity_data();
-    std::vector<char> entity_buffer;
-    if (data) {
-      entity_buffer.resize(data->size());
-      std::memcpy(entity_buffer.data(), data->data(), data->size());
-    }
-
-    // Deserialize into EntityInterface
-    EntityInterface deserializedEntity = EntityInterface::deserialize(
-        entity_buffer.data(), entity_buffer.size());
-
-    // Assign the entityId (if not already handled in deserialize)
-    deserializedEntity.entityId = flatbufferEntity->entityId();
+    EntityInterface deserializedEntity =
+        deserializeEntityFlatB(flatbufferEntity);
 
     entities[flatbufferEntity->entityId()] = deserializedEntity;
   }
@@ -5,6 +5,7 @@
 #include <nanobind/stl/shared_ptr.h>
 
 #include "EntityInterface.hpp"
+#include "EntityInterfaceFlatB.hpp"
 #include "EntityInterface_generated.h"
 #include "PerceptionResponse_generated.h"
 #include "QueryResponse.hpp"
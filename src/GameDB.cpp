@@ -1,5 +1,6 @@
 #include "GameDB.hpp"
 
+#include <array>
 #include <chrono>
 #include <filesystem>
 
@@ -19,6 +20,28 @@ constexpr int kMaxOnDiskRowsPerSeries = 10000;
 // strictly: the worst-case overshoot is K-1 rows above the cap before
 // the next trim fires.
 constexpr std::size_t kInsertsPerTrim = 500;
+
+// Rollup tiers maintained alongside the raw rows, finest first. Raw rows
+// are 1 s resolution (timestamps are whole seconds), so a dashboard
+// asking for hours of data at a few hundred points lands on the 60 s or
+// 600 s tier instead of pulling every raw row. Each tier is capped at
+// kMaxOnDiskRowsPerSeries buckets by the same amortised trim, which at
+// 600 s buckets is ~70 days of history.
+constexpr std::array<uint64_t, 3> kRollupTiersSeconds = {10, 60, 600};
+
+// Samples are folded into buckets as they arrive. A rewrite of an
+// existing raw timestamp (INSERT OR REPLACE) is counted again in the
+// rollup, so a bucket's count is "samples received", which is what the
+// diag flush cadence actually produced.
+constexpr const char *kRollupUpsertSql =
+    "INSERT INTO time_series_rollup "
+    "(series_name, tier_seconds, bucket_start, min_value, max_value, "
+    "sum_value, sample_count) VALUES (?1, ?2, ?3, ?4, ?4, ?4, 1) "
+    "ON CONFLICT(series_name, tier_seconds, bucket_start) DO UPDATE SET "
+    "min_value = MIN(min_value, excluded.min_value), "
+    "max_value = MAX(max_value, excluded.max_value), "
+    "sum_value = sum_value + excluded.sum_value, "
+    "sample_count = sample_count + 1";
 } // namespace
 
 GameDB::GameDB(const std::string &sqlite_path)
@@ -61,7 +84,8 @@ GameDB::~GameDB() {
     syncToDatabase();
   }
 
-  // Close SQLite database
+  // Close SQLite database; sqlite3_close refuses while statements are live.
+  sqlite3_finalize(rollupUpsertStmt);
   if (sqliteDb) {
     sqlite3_close(sqliteDb);
   }
@@ -119,31 +143,26 @@ void GameDB::validateTimeSeriesSchema() {
   }
 }
 
+TimeSeriesComponent &GameDB::cacheFor(const std::string &seriesName) {
+  auto view = registry.view<TimeSeriesComponent>();
+  for (auto entity : view) {
+    auto &comp = view.get<TimeSeriesComponent>(entity);
+    if (comp.timeSeriesName == seriesName) {
+      return comp;
+    }
+  }
+  auto entity = registry.create();
+  auto &comp = registry.emplace<TimeSeriesComponent>(entity);
+  comp.timeSeriesName = seriesName;
+  return comp;
+}
+
 bool GameDB::putTimeSeries(const std::string &seriesName, uint64_t timestamp,
                            double value) {
+  bool inTransaction = false;
   try {
-    entt::entity targetEntity = entt::null;
-
-    // 1) Search for an existing TimeSeriesComponent with that name.
-    auto view = registry.view<TimeSeriesComponent>();
-    for (auto entity : view) {
-      auto &comp = view.get<TimeSeriesComponent>(entity);
-      if (comp.timeSeriesName == seriesName) {
-        targetEntity = entity;
-        break;
-      }
-    }
-
-    // 2) Update the in-memory cache (with eviction at the per-series cap).
-    if (targetEntity != entt::null) {
-      auto &existingComp = registry.get<TimeSeriesComponent>(targetEntity);
-      existingComp.addDataPoint(timestamp, value);
-    } else {
-      targetEntity = registry.create();
-      auto &newComp = registry.emplace<TimeSeriesComponent>(targetEntity);
-      newComp.timeSeriesName = seriesName;
-      newComp.addDataPoint(timestamp, value);
-    }
+    // 1-2) Update the in-memory cache (with eviction at the per-series cap).
+    cacheFor(seriesName).addDataPoint(timestamp, value);
 
     // 3) Persist this single point to SQLite immediately. We deliberately
     // do NOT call syncToDatabase() here — that path replays the entire
@@ -152,7 +171,17 @@ bool GameDB::putTimeSeries(const std::string &seriesName, uint64_t timestamp,
     // synced ..." log spam. One INSERT per put is O(1); with WAL +
     // synchronous=NORMAL (set in the constructor) the per-put cost is
     // microseconds, not milliseconds.
-    if (!insertSinglePoint(seriesName, timestamp, value)) {
+    //
+    // The raw row and its rollup buckets go in one transaction, so a
+    // failed upsert cannot leave a raw row the tiers never counted.
+    sqlite3_stmt *rollupStmt = rollupUpsertStatement();
+    if (rollupStmt == nullptr || !executeSQL("BEGIN TRANSACTION")) {
+      return false;
+    }
+    inTransaction = true;
+    if (!insertSinglePoint(seriesName, timestamp, value) ||
+        !upsertRollups(rollupStmt, seriesName, timestamp, value)) {
+      executeSQL("ROLLBACK");
       return false;
     }
 
@@ -165,13 +194,127 @@ bool GameDB::putTimeSeries(const std::string &seriesName, uint64_t timestamp,
       trimSeriesOnDisk(seriesName);
       counter = 0;
     }
+    if (!executeSQL("COMMIT")) {
+      executeSQL("ROLLBACK");
+      return false;
+    }
     return true;
   } catch (const std::exception &e) {
     Logger::getLogger()->error("Error storing time series data: {}", e.what());
+    if (inTransaction) {
+      executeSQL("ROLLBACK");
+    }
     return false;
   }
 }
 
+bool GameDB::putTimeSeriesBatch(const std::vector<TimeSeriesPoint> &points) {
+  if (points.empty()) {
+    return true;
+  }
+  if (!sqliteDb) {
+    return false;
+  }
+  const char *sql = "INSERT OR REPLACE INTO time_series "
+                    "(series_name, timestamp, value) VALUES (?, ?, ?)";
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v2(sqliteDb, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+    Logger::getLogger()->error("Failed to prepare batch insert: {}",
+                               sqlite3_errmsg(sqliteDb));
+    return false;
+  }
+  sqlite3_stmt *rollupStmt = rollupUpsertStatement();
+  if (rollupStmt == nullptr) {
+    sqlite3_finalize(stmt);
+    return false;
+  }
+  if (!executeSQL("BEGIN TRANSACTION")) {
+    sqlite3_finalize(stmt);
+    return false;
+  }
+
+  try {
+    // Series names repeat heavily inside one batch (one row per metric
+    // per flush), so resolve each cache component once per batch rather
+    // than scanning the registry per row.
+    std::unordered_map<std::string, TimeSeriesComponent *> caches;
+    std::vector<const std::string *> toTrim;
+
+    for (const auto &p : points) {
+      auto [it, inserted] = caches.try_emplace(p.seriesName, nullptr);
+      if (inserted) {
+        it->second = &cacheFor(p.seriesName);
+      }
+      it->second->addDataPoint(p.timestamp, p.value);
+
+      sqlite3_bind_text(stmt, 1, p.seriesName.c_str(), -1, SQLITE_STATIC);
+      sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(p.timestamp));
+      sqlite3_bind_double(stmt, 3, p.value);
+      if (sqlite3_step(stmt) != SQLITE_DONE ||
+          !upsertRollups(rollupStmt, p.seriesName, p.timestamp, p.value)) {
+        Logger::getLogger()->error("Batch insert failed for '{}': {}",
+                                   p.seriesName, sqlite3_errmsg(sqliteDb));
+        sqlite3_finalize(stmt);
+        executeSQL("ROLLBACK");
+        return false;
+      }
+      sqlite3_reset(stmt);
+
+      auto &counter = insertsSinceTrim_[p.seriesName];
+      if (++counter >= kInsertsPerTrim) {
+        counter = 0;
+        toTrim.push_back(&p.seriesName);
+      }
+    }
+    sqlite3_finalize(stmt);
+
+    for (const auto *name : toTrim) {
+      trimSeriesOnDisk(*name);
+    }
+    return executeSQL("COMMIT");
+  } catch (const std::exception &e) {
+    Logger::getLogger()->error("Error storing time series batch: {}",
+                               e.what());
+    sqlite3_finalize(stmt);
+    executeSQL("ROLLBACK");
+    return false;
+  }
+}
+
+sqlite3_stmt *GameDB::rollupUpsertStatement() {
+  if (!sqliteDb) {
+    return nullptr;
+  }
+  if (rollupUpsertStmt == nullptr &&
+      sqlite3_prepare_v2(sqliteDb, kRollupUpsertSql, -1, &rollupUpsertStmt,
+                         nullptr) != SQLITE_OK) {
+    Logger::getLogger()->error("Failed to prepare rollup upsert: {}",
+                               sqlite3_errmsg(sqliteDb));
+    sqlite3_finalize(rollupUpsertStmt);
+    rollupUpsertStmt = nullptr;
+  }
+  return rollupUpsertStmt;
+}
+
+bool GameDB::upsertRollups(sqlite3_stmt *stmt, const std::string &seriesName,
+                           uint64_t timestamp, double value) {
+  for (uint64_t tier : kRollupTiersSeconds) {
+    sqlite3_bind_text(stmt, 1, seriesName.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(tier));
+    sqlite3_bind_int64(stmt, 3,
+                       static_cast<sqlite3_int64>(timestamp / tier * tier));
+    sqlite3_bind_double(stmt, 4, value);
+    int rc = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+    if (rc != SQLITE_DONE) {
+      Logger::getLogger()->error("Rollup upsert failed for '{}': {}",
+                                 seriesName, sqlite3_errmsg(sqliteDb));
+      return false;
+    }
+  }
+  return true;
+}
+
 bool GameDB::insertSinglePoint(const std::string &seriesName,
                                uint64_t timestamp, double value) {
   if (!sqliteDb) {
@@ -223,6 +366,32 @@ void GameDB::trimSeriesOnDisk(const std::string &seriesName) {
                                sqlite3_errmsg(sqliteDb));
   }
   sqlite3_finalize(stmt);
+
+  // Same cap per rollup tier. Cut at the N-th newest bucket rather than
+  // NOT IN so the delete is a single range scan on the primary key.
+  const char *rollupSql =
+      "DELETE FROM time_series_rollup WHERE series_name = ?1 "
+      "AND tier_seconds = ?2 AND bucket_start < ("
+      "  SELECT bucket_start FROM time_series_rollup "
+      "  WHERE series_name = ?1 AND tier_seconds = ?2 "
+      "  ORDER BY bucket_start DESC LIMIT 1 OFFSET ?3)";
+  if (sqlite3_prepare_v2(sqliteDb, rollupSql, -1, &stmt, nullptr) !=
+      SQLITE_OK) {
+    Logger::getLogger()->error("Failed to prepare rollup trim: {}",
+                               sqlite3_errmsg(sqliteDb));
+    return;
+  }
+  for (uint64_t tier : kRollupTiersSeconds) {
+    sqlite3_bind_text(stmt, 1, seriesName.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(tier));
+    sqlite3_bind_int(stmt, 3, kMaxOnDiskRowsPerSeries - 1);
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+      Logger::getLogger()->error("Rollup trim failed for '{}' ({} s): {}",
+                                 seriesName, tier, sqlite3_errmsg(sqliteDb));
+    }
+    sqlite3_reset(stmt);
+  }
+  sqlite3_finalize(stmt);
 }
 
 std::vector<std::pair<uint64_t, double>>
@@ -330,6 +499,78 @@ GameDB::queryTimeSeries(const std::string &seriesName, uint64_t start_time,
   return results;
 }
 
+std::vector<TimeSeriesBucket>
+GameDB::queryTimeSeriesDownsampled(const std::string &seriesName,
+                                   uint64_t start_time, uint64_t end_time,
+                                   std::size_t max_points) {
+  std::vector<TimeSeriesBucket> results;
+  if (!sqliteDb || seriesName.empty()) {
+    return results;
+  }
+  if (start_time > end_time) {
+    std::swap(start_time, end_time);
+  }
+  if (max_points == 0) {
+    max_points = 1;
+  }
+
+  // Raw rows are at most one per second, so the raw path fits the budget
+  // whenever the span does. Tier 1 stands for the raw table. Bucket
+  // counts use aligned bounds, since a range rarely starts on a bucket edge.
+  const uint64_t span = end_time - start_time + 1;
+  uint64_t tier = kRollupTiersSeconds.back();
+  if (span <= max_points) {
+    tier = 1;
+  } else {
+    for (uint64_t candidate : kRollupTiersSeconds) {
+      if (end_time / candidate - start_time / candidate + 1 <= max_points) {
+        tier = candidate;
+        break;
+      }
+    }
+  }
+
+  // Read straight from disk: the in-memory cache only holds the newest
+  // kMaxInMemoryPointsPerSeries raw points, so it can't answer a long range.
+  const char *query =
+      tier == 1
+          ? "SELECT timestamp, value, value, value, 1 FROM time_series "
+            "WHERE series_name = ?1 AND timestamp >= ?3 AND timestamp <= ?4 "
+            "ORDER BY timestamp"
+          : "SELECT bucket_start, min_value, max_value, sum_value, "
+            "sample_count FROM time_series_rollup WHERE series_name = ?1 "
+            "AND tier_seconds = ?2 AND bucket_start >= ?3 AND bucket_start <= "
+            "?4 ORDER BY bucket_start";
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v2(sqliteDb, query, -1, &stmt, nullptr) != SQLITE_OK) {
+    spdlog::get("console")->error(
+        "[queryTimeSeriesDownsampled] Failed to prepare query: {}",
+        sqlite3_errmsg(sqliteDb));
+    return results;
+  }
+  sqlite3_bind_text(stmt, 1, seriesName.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(tier));
+  // The bucket containing start_time begins at or before it.
+  sqlite3_bind_int64(stmt, 3,
+                     static_cast<sqlite3_int64>(start_time / tier * tier));
+  sqlite3_bind_int64(stmt, 4, static_cast<sqlite3_int64>(end_time));
+
+  results.reserve(static_cast<std::size_t>(span / tier + 1));
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    TimeSeriesBucket b;
+    b.timestamp = static_cast<uint64_t>(sqlite3_column_int64(stmt, 0));
+    b.min = sqlite3_column_double(stmt, 1);
+    b.max = sqlite3_column_double(stmt, 2);
+    b.count = static_cast<uint64_t>(sqlite3_column_int64(stmt, 4));
+    b.mean = b.count > 0
+                 ? sqlite3_column_double(stmt, 3) / static_cast<double>(b.count)
+                 : 0.0;
+    results.push_back(b);
+  }
+  sqlite3_finalize(stmt);
+  return results;
+}
+
 bool GameDB::executeSQL(const std::string &query) {
   char *errMsg = nullptr;
   int rc = sqlite3_exec(sqliteDb, query.c_str(), nullptr, nullptr, &errMsg);
@@ -347,6 +588,18 @@ bool GameDB::createTables() {
   // cadence (see trimSeriesOnDisk + kInsertsPerTrim).
   executeSQL("DROP TRIGGER IF EXISTS trim_time_series_per_series");
 
+  // Remember whether the rollup table predates this call so rows written
+  // by an older build get folded into it exactly once.
+  bool rollupExisted = false;
+  sqlite3_stmt *checkStmt = nullptr;
+  if (sqlite3_prepare_v2(sqliteDb,
+                         "SELECT 1 FROM sqlite_master WHERE type='table' "
+                         "AND name='time_series_rollup'",
+                         -1, &checkStmt, nullptr) == SQLITE_OK) {
+    rollupExisted = (sqlite3_step(checkStmt) == SQLITE_ROW);
+    sqlite3_finalize(checkStmt);
+  }
+
   const std::string query = R"(
         CREATE TABLE IF NOT EXISTS players (
             id INTEGER PRIMARY KEY AUTOINCREMENT,
@@ -359,6 +612,16 @@ bool GameDB::createTables() {
             value REAL NOT NULL,
             PRIMARY KEY(series_name, timestamp)
         );
+        CREATE TABLE IF NOT EXISTS time_series_rollup (
+            series_name TEXT NOT NULL,
+            tier_seconds INTEGER NOT NULL,
+            bucket_start INTEGER NOT NULL,
+            min_value REAL NOT NULL,
+            max_value REAL NOT NULL,
+            sum_value REAL NOT NULL,
+            sample_count INTEGER NOT NULL,
+            PRIMARY KEY(series_name, tier_seconds, bucket_start)
+        );
         CREATE TABLE IF NOT EXISTS game_state (
             player_id INTEGER PRIMARY KEY,
             level INTEGER NOT NULL,
@@ -366,7 +629,24 @@ bool GameDB::createTables() {
             FOREIGN KEY(player_id) REFERENCES players(id)
         );
     )";
-  return executeSQL(query);
+  if (!executeSQL(query)) {
+    return false;
+  }
+  if (rollupExisted) {
+    return true;
+  }
+
+  bool ok = true;
+  for (uint64_t tier : kRollupTiersSeconds) {
+    const std::string t = std::to_string(tier);
+    ok &= executeSQL(
+        "INSERT OR IGNORE INTO time_series_rollup SELECT series_name, " + t +
+        ", (timestamp / " + t + ") * " + t +
+        ", MIN(value), MAX(value), SUM(value), COUNT(*) FROM time_series "
+        "GROUP BY series_name, timestamp / " +
+        t);
+  }
+  return ok;
 }
 
 const TimeSeriesComponent *
@@ -402,6 +682,8 @@ bool GameDB::resetDB() {
   Logger::getLogger()->warn("Resetting database");
 
   // Close the database connection
+  sqlite3_finalize(rollupUpsertStmt);
+  rollupUpsertStmt = nullptr;
   if (sqliteDb) {
     sqlite3_close(sqliteDb);
     sqliteDb = nullptr;
@@ -14,6 +14,29 @@
 #include "Logger.hpp"
 #include "components/TimeSeriesComponent.hpp"
 
+/**
+ * @brief One (series, timestamp, value) row, as queued by the diag
+ * GameDB writer thread and committed via GameDB::putTimeSeriesBatch.
+ */
+struct TimeSeriesPoint {
+  std::string seriesName;
+  uint64_t timestamp = 0;
+  double value = 0.0;
+};
+
+/**
+ * @brief One downsampled bucket returned by
+ * GameDB::queryTimeSeriesDownsampled. Raw rows come back as single-sample
+ * buckets (min == max == mean, count == 1).
+ */
+struct TimeSeriesBucket {
+  uint64_t timestamp = 0; // bucket start (seconds)
+  double min = 0.0;
+  double max = 0.0;
+  double mean = 0.0;
+  uint64_t count = 0;
+};
+
 /**
  * @brief Database handler for game data
  *
@@ -36,6 +59,9 @@ public:
   /**
    * @brief Store a time series data point
    *
+   * The raw row and its rollup buckets are written in one transaction;
+   * on failure neither is kept.
+   *
    * @param seriesName Name of the time series
    * @param timestamp Time point for the data point
    * @param value Value to store
@@ -44,6 +70,18 @@ public:
   bool putTimeSeries(const std::string &seriesName, uint64_t timestamp,
                      double value);
 
+  /**
+   * @brief Store many data points in a single SQLite transaction
+   *
+   * Reuses one prepared statement for every row and runs the amortised
+   * on-disk trim before COMMIT. Used by the diag writer thread so a
+   * whole Registry flush costs one fsync instead of one per row.
+   *
+   * @param points Rows to store; any series order
+   * @return bool Success status (false rolls back the whole batch)
+   */
+  bool putTimeSeriesBatch(const std::vector<TimeSeriesPoint> &points);
+
   /**
    * @brief Query time series data within a time range
    *
@@ -57,6 +95,28 @@ public:
   queryTimeSeries(const std::string &seriesName, uint64_t start_time,
                   uint64_t end_time);
 
+  /**
+   * @brief Query a time range at a resolution bounded by a point budget
+   *
+   * Every put also folds the sample into rollup tiers (see
+   * kRollupTiersSeconds in GameDB.cpp). This picks the finest
+   * resolution — raw 1 s rows, then each tier in turn — whose bucket
+   * count over [start_time, end_time] fits in `max_points`, so the cost
+   * is proportional to the points returned, not the points stored. If
+   * even the coarsest tier exceeds the budget, the coarsest tier is
+   * returned as-is.
+   *
+   * @param seriesName Name of the time series
+   * @param start_time Start timestamp for the query range
+   * @param end_time End timestamp for the query range
+   * @param max_points Target upper bound on returned buckets (>= 1)
+   * @return std::vector<TimeSeriesBucket> Buckets in ascending time order
+   */
+  std::vector<TimeSeriesBucket>
+  queryTimeSeriesDownsampled(const std::string &seriesName,
+                             uint64_t start_time, uint64_t end_time,
+                             std::size_t max_points);
+
   /**
    * @brief Execute an arbitrary SQL query
    *
@@ -132,9 +192,29 @@ private:
    */
   void trimSeriesOnDisk(const std::string &seriesName);
 
+  /**
+   * @brief Fold one sample into every rollup tier using a prepared
+   * upsert statement (see rollupUpsertStatement). Caller owns the
+   * transaction, if any.
+   */
+  bool upsertRollups(sqlite3_stmt *stmt, const std::string &seriesName,
+                     uint64_t timestamp, double value);
+
+  /**
+   * @brief The rollup upsert statement, prepared on first use and kept
+   * until the connection closes; nullptr on failure.
+   */
+  sqlite3_stmt *rollupUpsertStatement();
+
+  /**
+   * @brief Find or create the in-memory TimeSeriesComponent for a series.
+   */
+  TimeSeriesComponent &cacheFor(const std::string &seriesName);
+
   // SQLite database
   std::string sqlitePath;
   sqlite3 *sqliteDb;
+  sqlite3_stmt *rollupUpsertStmt = nullptr; // see rollupUpsertStatement
 
   // EnTT registry for in-memory components
   entt::registry registry;
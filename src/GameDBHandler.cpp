@@ -15,6 +15,7 @@ GameDBHandler::GameDBHandler(const std::string &sqliteFile)
 GameDBHandler::~GameDBHandler() = default;
 
 void GameDBHandler::createTables() {
+  std::lock_guard<std::mutex> lock(dbMutex_);
   std::string createPlayersSQL = R"(
         CREATE TABLE IF NOT EXISTS players (
             id INTEGER PRIMARY KEY AUTOINCREMENT,
@@ -45,12 +46,24 @@ void GameDBHandler::putTimeSeries(const std::string &seriesName,
   // Convert timestamp to uint64_t for storage
   uint64_t ts = static_cast<uint64_t>(timestamp);
 
+  std::lock_guard<std::mutex> lock(dbMutex_);
   // Store directly in our improved GameDB
   if (!gameDB->putTimeSeries(seriesName, ts, value)) {
     Logger::getLogger()->error("Failed to store time series data");
   }
 }
 
+bool GameDBHandler::putTimeSeriesBatch(
+    const std::vector<TimeSeriesPoint> &points) {
+  std::lock_guard<std::mutex> lock(dbMutex_);
+  if (!gameDB->putTimeSeriesBatch(points)) {
+    Logger::getLogger()->error("Failed to store time series batch of {} rows",
+                               points.size());
+    return false;
+  }
+  return true;
+}
+
 std::vector<std::pair<uint64_t, double>>
 GameDBHandler::queryTimeSeries(const std::string &seriesName, long long start,
                                long long end) {
@@ -63,6 +76,7 @@ GameDBHandler::queryTimeSeries(const std::string &seriesName, long long start,
   uint64_t endTime = static_cast<uint64_t>(end);
 
   // Query from our improved GameDB
+  std::lock_guard<std::mutex> lock(dbMutex_);
   auto results = gameDB->queryTimeSeries(seriesName, startTime, endTime);
 
   // Logger::getLogger()->info("Found {} results in time series query for {}",
@@ -71,20 +85,33 @@ GameDBHandler::queryTimeSeries(const std::string &seriesName, long long start,
   return results;
 }
 
+std::vector<TimeSeriesBucket> GameDBHandler::queryTimeSeriesDownsampled(
+    const std::string &seriesName, long long start, long long end,
+    size_t maxPoints) {
+  std::lock_guard<std::mutex> lock(dbMutex_);
+  return gameDB->queryTimeSeriesDownsampled(
+      seriesName, static_cast<uint64_t>(start), static_cast<uint64_t>(end),
+      maxPoints);
+}
+
 void GameDBHandler::executeSQL(const std::string &sql) {
+  std::lock_guard<std::mutex> lock(dbMutex_);
   gameDB->executeSQL(sql);
 }
 
 bool GameDBHandler::resetDB() {
   Logger::getLogger()->warn("[GameDBHandler::resetDB] Resetting database");
+  std::lock_guard<std::mutex> lock(dbMutex_);
   return gameDB->resetDB();
 }
 
 size_t GameDBHandler::peekInMemorySize(const std::string &seriesName) const {
+  std::lock_guard<std::mutex> lock(dbMutex_);
   const auto *comp = gameDB->findTimeSeriesComponent(seriesName);
   return comp ? comp->size() : 0;
 }
 
 long long GameDBHandler::countOnDiskRows(const std::string &seriesName) const {
+  std::lock_guard<std::mutex> lock(dbMutex_);
   return gameDB->countOnDiskRows(seriesName);
 }
\ No newline at end of file
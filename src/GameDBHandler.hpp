@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory> // Required for std::unique_ptr
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -16,16 +17,24 @@ public:
   GameDBHandler(const GameDBHandler &) = delete;
   GameDBHandler &operator=(const GameDBHandler &) = delete;
 
-  // Allow move operations (transferring ownership)
-  GameDBHandler(GameDBHandler &&) noexcept = default;
-  GameDBHandler &operator=(GameDBHandler &&) noexcept = default;
+  // Not movable either: the diag GameDB writer thread holds a raw pointer
+  // to this handler for its whole lifetime, and `dbMutex_` pins it.
+  GameDBHandler(GameDBHandler &&) = delete;
+  GameDBHandler &operator=(GameDBHandler &&) = delete;
 
   void createTables();
   void putTimeSeries(const std::string &seriesName, long long timestamp,
                      double value);
+  // One transaction for the whole batch. Called from the diag writer
+  // thread; see diag/GameDBWriter.hpp.
+  bool putTimeSeriesBatch(const std::vector<TimeSeriesPoint> &points);
   std::vector<std::pair<uint64_t, double>>
   queryTimeSeries(const std::string &seriesName, long long start,
                   long long end);
+  // Bounded-size view of [start, end]; see GameDB::queryTimeSeriesDownsampled.
+  std::vector<TimeSeriesBucket>
+  queryTimeSeriesDownsampled(const std::string &seriesName, long long start,
+                             long long end, size_t maxPoints);
   void executeSQL(const std::string &sql);
 
   // Force database reset if necessary
@@ -42,4 +51,9 @@ public:
 private:
   std::string sqliteFile_;
   std::unique_ptr<GameDB> gameDB;
+
+  // Serialises every GameDB call. The diag writer thread commits batches
+  // while the main thread (Python tests, GUI plots) queries, and neither
+  // the SQLite handle nor the EnTT-backed cache is safe to share.
+  mutable std::mutex dbMutex_;
 };
\ No newline at end of file
@@ -0,0 +1,210 @@
+#ifndef GUI_VOXEL_SURFACE_MESH_HPP
+#define GUI_VOXEL_SURFACE_MESH_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// Visible surface of a voxel array as greedy-merged quads, for the 3D voxel
+// viewport. The array is x-fastest (index = z * width * height + y * width
+// + x), as the viewport has always read it; 2D arrays are one z slice.
+//
+// update() rebuilds only when the array's address, dtype, shape or contents
+// differ from the last build (contents are compared against a private copy,
+// so edits made in place from Python are picked up). Between rebuilds the
+// viewport only transforms, culls and sorts the cached quads.
+//
+// A face is emitted where a solid voxel meets an empty one or the edge of
+// the array. Coplanar faces of voxels with the same value are merged into
+// rectangles, so a flat floor is one quad per side instead of one per
+// voxel.
+
+enum class VoxelSurfaceFace : uint8_t {
+  LEFT,   // -x
+  RIGHT,  // +x
+  BOTTOM, // -y
+  TOP,    // +y
+  BACK,   // -z
+  FRONT   // +z
+};
+
+struct SurfaceQuad {
+  float corners[4][3]; // counter-clockwise seen from outside
+  float normal[3];
+  int value;
+  VoxelSurfaceFace face;
+};
+
+class VoxelSurfaceMesh {
+public:
+  enum class Kind { INT, FLOAT };
+
+  // Returns true when the quads were rebuilt.
+  bool update(const void *data, Kind kind, std::size_t width,
+              std::size_t height, std::size_t depth) {
+    const std::size_t count = width * height * depth;
+    const std::size_t bytes =
+        count * (kind == Kind::INT ? sizeof(int) : sizeof(float));
+    if (data == data_ && kind == kind_ && width == dims_[0] &&
+        height == dims_[1] && depth == dims_[2] && snapshot_.size() == bytes &&
+        (bytes == 0 || std::memcmp(snapshot_.data(), data, bytes) == 0)) {
+      return false;
+    }
+
+    data_ = data;
+    kind_ = kind;
+    dims_[0] = width;
+    dims_[1] = height;
+    dims_[2] = depth;
+    snapshot_.resize(bytes);
+    if (bytes != 0) {
+      std::memcpy(snapshot_.data(), data, bytes);
+    }
+
+    values_.resize(count);
+    solid_.resize(count);
+    if (kind == Kind::INT) {
+      const int *src = static_cast<const int *>(data);
+      for (std::size_t i = 0; i < count; ++i) {
+        values_[i] = src[i];
+        solid_[i] = src[i] != 0;
+      }
+    } else {
+      // Same rule as the old per-voxel path: |v| > 0.001 is drawn, coloured
+      // by its integer part.
+      const float *src = static_cast<const float *>(data);
+      for (std::size_t i = 0; i < count; ++i) {
+        values_[i] = static_cast<int>(src[i]);
+        solid_[i] = std::abs(src[i]) > 0.001f;
+      }
+    }
+
+    build();
+    return true;
+  }
+
+  const std::vector<SurfaceQuad> &quads() const { return quads_; }
+
+  // Unmerged face count of the last build (what per-voxel drawing emits).
+  std::size_t exposedFaces() const { return exposedFaces_; }
+
+private:
+  static constexpr int64_t kNoFace = std::numeric_limits<int64_t>::min();
+
+  void build() {
+    quads_.clear();
+    exposedFaces_ = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+      for (int sign = -1; sign <= 1; sign += 2) {
+        buildDirection(axis, sign);
+      }
+    }
+  }
+
+  // All faces whose outward normal is `sign` along `axis`, one slice at a
+  // time. u and v are the other two axes in cyclic order, so u x v points
+  // along +axis.
+  void buildDirection(int axis, int sign) {
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+    const std::size_t nu = dims_[u];
+    const std::size_t nv = dims_[v];
+    mask_.assign(nu * nv, kNoFace);
+
+    const std::size_t stride[3] = {1, dims_[0], dims_[0] * dims_[1]};
+    const std::size_t across = stride[axis];
+    for (std::size_t slice = 0; slice < dims_[axis]; ++slice) {
+      const bool edge = sign < 0 ? slice == 0 : slice + 1 == dims_[axis];
+      for (std::size_t j = 0; j < nv; ++j) {
+        std::size_t i = slice * stride[axis] + j * stride[v];
+        int64_t *row = &mask_[j * nu];
+        for (std::size_t k = 0; k < nu; ++k, i += stride[u]) {
+          int64_t face = kNoFace;
+          const std::size_t next = sign < 0 ? i - across : i + across;
+          if (solid_[i] && (edge || !solid_[next])) {
+            face = values_[i];
+            ++exposedFaces_;
+          }
+          row[k] = face;
+        }
+      }
+      mergeSlice(axis, sign, slice, nu, nv);
+    }
+  }
+
+  // Greedy merge: grow each unclaimed face along u while the value
+  // matches, then along v while the whole run matches.
+  void mergeSlice(int axis, int sign, std::size_t slice, std::size_t nu,
+                  std::size_t nv) {
+    for (std::size_t j = 0; j < nv; ++j) {
+      for (std::size_t k = 0; k < nu;) {
+        const int64_t face = mask_[j * nu + k];
+        if (face == kNoFace) {
+          ++k;
+          continue;
+        }
+        std::size_t w = 1;
+        while (k + w < nu && mask_[j * nu + k + w] == face) {
+          ++w;
+        }
+        std::size_t h = 1;
+        for (; j + h < nv; ++h) {
+          bool rowMatches = true;
+          for (std::size_t x = 0; x < w && rowMatches; ++x) {
+            rowMatches = mask_[(j + h) * nu + k + x] == face;
+          }
+          if (!rowMatches) {
+            break;
+          }
+        }
+        for (std::size_t y = 0; y < h; ++y) {
+          for (std::size_t x = 0; x < w; ++x) {
+            mask_[(j + y) * nu + k + x] = kNoFace;
+          }
+        }
+        emit(axis, sign, slice, k, j, w, h, static_cast<int>(face));
+        k += w;
+      }
+    }
+  }
+
+  void emit(int axis, int sign, std::size_t slice, std::size_t k,
+            std::size_t j, std::size_t w, std::size_t h, int value) {
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+    const float plane = static_cast<float>(sign < 0 ? slice : slice + 1);
+    const float u0 = static_cast<float>(k);
+    const float u1 = static_cast<float>(k + w);
+    const float v0 = static_cast<float>(j);
+    const float v1 = static_cast<float>(j + h);
+    const float uv[4][2] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+
+    SurfaceQuad quad{};
+    for (int c = 0; c < 4; ++c) {
+      // Reverse the winding for faces looking down -axis.
+      const int from = sign > 0 ? c : 3 - c;
+      quad.corners[c][axis] = plane;
+      quad.corners[c][u] = uv[from][0];
+      quad.corners[c][v] = uv[from][1];
+    }
+    quad.normal[axis] = static_cast<float>(sign);
+    quad.value = value;
+    quad.face = static_cast<VoxelSurfaceFace>(axis * 2 + (sign > 0 ? 1 : 0));
+    quads_.push_back(quad);
+  }
+
+  const void *data_ = nullptr;
+  Kind kind_ = Kind::INT;
+  std::size_t dims_[3] = {0, 0, 0};
+  std::vector<unsigned char> snapshot_;
+  std::vector<int> values_;
+  std::vector<uint8_t> solid_;
+  std::vector<int64_t> mask_;
+  std::vector<SurfaceQuad> quads_;
+  std::size_t exposedFaces_ = 0;
+};
+
+#endif // GUI_VOXEL_SURFACE_MESH_HPP
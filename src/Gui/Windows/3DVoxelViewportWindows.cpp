@@ -1,4 +1,5 @@
 #include "Gui/Gui.hpp"
+#include "Gui/VoxelSurfaceMesh.hpp"
 
 // Helper struct for 3D vector operations
 struct Vec3 {
@@ -947,36 +948,15 @@ void setupProjectionMatrix(float cameraProjection[16], float aspect) {
   cameraProjection[15] = 0.0f;
 }
 
-// Forward declarations for helper structs and functions
-struct VoxelPoint {
-  float x, y, z;
-  int value;
-  float depth;
-};
-
-void renderVoxelData(
-    nb::ndarray<nb::numpy> &voxel_data, ImDrawList *drawList,
+// Forward declarations for helper functions
+void renderVoxelData(nb::ndarray<nb::numpy> &voxel_data, ImDrawList *drawList,
+                     std::function<ImVec2(float, float, float)> projectToScreen,
+                     const float viewModel[16], bool showVoxelBorders,
+                     bool showDebugFaceOrder);
+void drawSurfaceQuads(
+    const VoxelSurfaceMesh &mesh, bool floatData, ImDrawList *drawList,
     std::function<ImVec2(float, float, float)> projectToScreen,
-    std::function<std::tuple<float, float, float>(float, float, float)>
-        transformPoint,
-    float zoom, size_t totalSize, bool showVoxelBorders,
-    bool showDebugFaceOrder,
-    std::function<float(float, float, float)> cameraDepthFn);
-void processFloatVoxelData(const float *data,
-                           nb::ndarray<nb::numpy> &voxel_data,
-                           std::vector<VoxelPoint> &voxelPoints, int gridSize,
-                           size_t totalSize);
-void processIntVoxelData(const int *data, nb::ndarray<nb::numpy> &voxel_data,
-                         std::vector<VoxelPoint> &voxelPoints, int gridSize,
-                         size_t totalSize);
-void drawVoxelPoints(
-    const std::vector<VoxelPoint> &voxelPoints, ImDrawList *drawList,
-    std::function<ImVec2(float, float, float)> projectToScreen,
-    std::function<std::tuple<float, float, float>(float, float, float)>
-        transformPoint,
-    float zoom, nb::ndarray<nb::numpy> &voxel_data, bool showVoxelBorders,
-    bool showDebugFaceOrder,
-    std::function<float(float, float, float)> cameraDepthFn);
+    const float viewModel[16], bool showVoxelBorders, bool showDebugFaceOrder);
 void renderTransformationInfo(nb::ndarray<nb::numpy> &voxel_data,
                               float objectMatrix[16]);
 void drawCoordinateAxes(
@@ -1024,12 +1004,7 @@ void render3DViewport(nb::ndarray<nb::numpy> &voxel_data, nb::dict &shared_data,
   multiplyMatrix4(cameraView, objectMatrix, MV); // MV = V * M
   multiplyMatrix4(cameraProjection, MV, MVP);    // MVP = P * (V * M)
   multiplyMatrix4(cameraView, objectMatrix,
-                  VM); // VM = V * M (for depth calculation)
-
-  // Camera depth function for proper depth sorting (camera-space z, not NDC)
-  auto cameraDepth = [&](float x, float y, float z) -> float {
-    return VM[2] * x + VM[6] * y + VM[10] * z + VM[14]; // camera-space z
-  };
+                  VM); // VM = V * M (camera space, for culling and depth)
 
   // Transform point using proper MVP pipeline
   auto transformPoint = [&](float x, float y,
@@ -1167,9 +1142,8 @@ void render3DViewport(nb::ndarray<nb::numpy> &voxel_data, nb::dict &shared_data,
 
   // Render voxels based on actual data
   if (totalSize > 0 && voxel_data.data() != nullptr) {
-    renderVoxelData(voxel_data, drawList, projectToScreen, transformPoint, zoom,
-                    totalSize, showVoxelBorders, showDebugFaceOrder,
-                    cameraDepth);
+    renderVoxelData(voxel_data, drawList, projectToScreen, VM,
+                    showVoxelBorders, showDebugFaceOrder);
   }
 
   // Use ImGuizmo to manipulate the object (only if enabled)
@@ -1200,412 +1174,147 @@ void render3DViewport(nb::ndarray<nb::numpy> &voxel_data, nb::dict &shared_data,
   renderTransformationInfo(voxel_data, objectMatrix);
 }
 
-// Render voxel data points
-void renderVoxelData(
-    nb::ndarray<nb::numpy> &voxel_data, ImDrawList *drawList,
-    std::function<ImVec2(float, float, float)> projectToScreen,
-    std::function<std::tuple<float, float, float>(float, float, float)>
-        transformPoint,
-    float zoom, size_t totalSize, bool showVoxelBorders,
-    bool showDebugFaceOrder,
-    std::function<float(float, float, float)> cameraDepthFn) {
-  // Determine grid size based on data dimensions - support large voxel grids
-  int gridSize = 64; // Default to support 64x64x64 voxel grids
-  if (voxel_data.ndim() >= 2) {
-    gridSize = std::max((int)voxel_data.shape(0),
-                        64); // Use actual data size, minimum 64
-  }
-
-  // Collect all voxel positions for depth sorting
-  std::vector<VoxelPoint> voxelPoints;
+// Render the voxel array's surface. The surface is only re-extracted when
+// the array changes (see VoxelSurfaceMesh); each frame culls, sorts and
+// projects the cached quads.
+void renderVoxelData(nb::ndarray<nb::numpy> &voxel_data, ImDrawList *drawList,
+                     std::function<ImVec2(float, float, float)> projectToScreen,
+                     const float viewModel[16], bool showVoxelBorders,
+                     bool showDebugFaceOrder) {
+  static VoxelSurfaceMesh surfaceMesh;
 
-  // Render voxels based on data content
+  VoxelSurfaceMesh::Kind kind;
   if (voxel_data.dtype() == nb::dtype<float>()) {
-    const float *data = static_cast<const float *>(voxel_data.data());
-    processFloatVoxelData(data, voxel_data, voxelPoints, gridSize, totalSize);
-  }
-  // Handle integer data
-  else if (voxel_data.dtype() == nb::dtype<int>()) {
-    const int *data = static_cast<const int *>(voxel_data.data());
-    processIntVoxelData(data, voxel_data, voxelPoints, gridSize, totalSize);
+    kind = VoxelSurfaceMesh::Kind::FLOAT;
+  } else if (voxel_data.dtype() == nb::dtype<int>()) {
+    kind = VoxelSurfaceMesh::Kind::INT;
+  } else {
+    return;
   }
-
-  // Update depth values using proper camera-space depth (not NDC z)
-  for (auto &voxel : voxelPoints) {
-    float cx = voxel.x + 0.5f, cy = voxel.y + 0.5f, cz = voxel.z + 0.5f;
-    voxel.depth = cameraDepthFn(cx, cy, cz); // camera-space z
+  if (voxel_data.ndim() < 2) {
+    return;
   }
 
-  // Sort voxels by camera depth (back to front for proper rendering)
-  std::sort(voxelPoints.begin(), voxelPoints.end(),
-            [](const VoxelPoint &a, const VoxelPoint &b) {
-              return a.depth < b.depth;
-            });
-
-  // Draw sorted voxels
-  drawVoxelPoints(voxelPoints, drawList, projectToScreen, transformPoint, zoom,
-                  voxel_data, showVoxelBorders, showDebugFaceOrder,
-                  cameraDepthFn);
-}
+  // 2D data is a single slice at z = 0 (ground level)
+  size_t width = voxel_data.shape(0);
+  size_t height = voxel_data.shape(1);
+  size_t depth = voxel_data.ndim() >= 3 ? voxel_data.shape(2) : 1;
+  surfaceMesh.update(voxel_data.data(), kind, width, height, depth);
 
-// Process float voxel data
-void processFloatVoxelData(const float *data,
-                           nb::ndarray<nb::numpy> &voxel_data,
-                           std::vector<VoxelPoint> &voxelPoints, int gridSize,
-                           size_t totalSize) {
-  // For 3D data visualization
-  if (voxel_data.ndim() >= 3) {
-    size_t width = voxel_data.shape(0);
-    size_t height = voxel_data.shape(1);
-    size_t depth = voxel_data.shape(2);
-
-    for (size_t x = 0; x < width; x++) {
-      for (size_t y = 0; y < height; y++) {
-        for (size_t z = 0; z < depth; z++) {
-          size_t index = z * width * height + y * width + x;
-          if (index < totalSize) {
-            float value = data[index];
-
-            // Only draw non-zero voxels
-            if (std::abs(value) > 0.001f) {
-              // Use actual spatial coordinates: each voxel = 1 unit
-              float nx = (float)x;
-              float ny = (float)y;
-              float nz = (float)z;
-
-              // Use voxel center for depth calculation (will be updated with
-              // camera depth later)
-              voxelPoints.push_back({nx, ny, nz, (int)value, nz});
-            }
-          }
-        }
-      }
-    }
-  }
-  // For 2D data visualization
-  else if (voxel_data.ndim() >= 2) {
-    size_t width = voxel_data.shape(0);
-    size_t height = voxel_data.shape(1);
-
-    for (size_t x = 0; x < width; x++) {
-      for (size_t y = 0; y < height; y++) {
-        size_t index = y * width + x;
-        if (index < totalSize) {
-          float value = data[index];
-
-          // Only draw non-zero voxels
-          if (std::abs(value) > 0.001f) {
-            // Use actual spatial coordinates, z=0 for 2D (at ground level)
-            float nx = (float)x;
-            float ny = (float)y;
-            float nz = 0.0f;
-
-            voxelPoints.push_back({nx, ny, nz, (int)value, nz});
-          }
-        }
-      }
-    }
-  }
+  drawSurfaceQuads(surfaceMesh, kind == VoxelSurfaceMesh::Kind::FLOAT,
+                   drawList, projectToScreen, viewModel, showVoxelBorders,
+                   showDebugFaceOrder);
 }
 
-// Process integer voxel data
-void processIntVoxelData(const int *data, nb::ndarray<nb::numpy> &voxel_data,
-                         std::vector<VoxelPoint> &voxelPoints, int gridSize,
-                         size_t totalSize) {
-  // For 3D data
-  if (voxel_data.ndim() >= 3) {
-    size_t width = voxel_data.shape(0);
-    size_t height = voxel_data.shape(1);
-    size_t depth = voxel_data.shape(2);
-
-    for (size_t x = 0; x < width; x++) {
-      for (size_t y = 0; y < height; y++) {
-        for (size_t z = 0; z < depth; z++) {
-          size_t index = z * width * height + y * width + x;
-          if (index < totalSize) {
-            int value = data[index];
-
-            if (value != 0) {
-              // Use actual spatial coordinates: each voxel = 1 unit
-              // Place voxel at its grid position (no offset needed)
-              float nx = (float)x;
-              float ny = (float)y;
-              float nz = (float)z;
-
-              voxelPoints.push_back({nx, ny, nz, value, nz});
-            }
-          }
-        }
-      }
-    }
-  }
-  // For 2D data
-  else if (voxel_data.ndim() >= 2) {
-    size_t width = voxel_data.shape(0);
-    size_t height = voxel_data.shape(1);
-
-    for (size_t x = 0; x < width; x++) {
-      for (size_t y = 0; y < height; y++) {
-        size_t index = y * width + x;
-        if (index < totalSize) {
-          int value = data[index];
-
-          if (value != 0) {
-            // Use actual spatial coordinates, z=0 for 2D (at ground level)
-            float nx = (float)x;
-            float ny = (float)y;
-            float nz = 0.0f;
-
-            voxelPoints.push_back({nx, ny, nz, value, nz});
-          }
-        }
-      }
-    }
+// Color based on value - fully opaque to avoid blending seams
+static ImU32 voxelColor(int value, bool floatData) {
+  if (floatData) {
+    // Color based on value intensity
+    uint8_t intensity =
+        (uint8_t)(std::min(std::abs((float)value) * 255.0f, 255.0f));
+    return value > 0 ? IM_COL32(intensity, intensity / 2, 0, 255)
+                     : // Orange for positive
+               IM_COL32(0, intensity / 2, intensity, 255); // Blue for negative
   }
+  uint8_t r = (uint8_t)((value * 67) % 256);
+  uint8_t g = (uint8_t)((value * 131) % 256);
+  uint8_t b = (uint8_t)((value * 197) % 256);
+  return IM_COL32(r, g, b, 255);
 }
 
-// Draw voxel points on screen
-void drawVoxelPoints(
-    const std::vector<VoxelPoint> &voxelPoints, ImDrawList *drawList,
+// Draw the cached surface quads back to front
+void drawSurfaceQuads(
+    const VoxelSurfaceMesh &mesh, bool floatData, ImDrawList *drawList,
     std::function<ImVec2(float, float, float)> projectToScreen,
-    std::function<std::tuple<float, float, float>(float, float, float)>
-        transformPoint,
-    float zoom, nb::ndarray<nb::numpy> &voxel_data, bool showVoxelBorders,
-    bool showDebugFaceOrder,
-    std::function<float(float, float, float)> cameraDepthFn) {
-  // Helper function to check if a voxel exists at given coordinates
-  auto hasVoxelAt = [&](int x, int y, int z) -> bool {
-    // Check bounds
-    if (x < 0 || y < 0 || z < 0)
-      return false;
-    if (voxel_data.ndim() < 3) {
-      if (voxel_data.ndim() == 2) {
-        if (x >= (int)voxel_data.shape(0) || y >= (int)voxel_data.shape(1) ||
-            z > 0)
-          return false;
-      } else {
-        return false;
-      }
-    } else {
-      if (x >= (int)voxel_data.shape(0) || y >= (int)voxel_data.shape(1) ||
-          z >= (int)voxel_data.shape(2))
-        return false;
-    }
-
-    // Check if voxel has non-zero value
-    if (voxel_data.dtype() == nb::dtype<float>()) {
-      const float *data = static_cast<const float *>(voxel_data.data());
-      size_t index;
-      if (voxel_data.ndim() == 3) {
-        index = z * voxel_data.shape(0) * voxel_data.shape(1) +
-                y * voxel_data.shape(0) + x;
-      } else {
-        index = y * voxel_data.shape(0) + x;
-      }
-      return std::abs(data[index]) > 0.001f;
-    } else if (voxel_data.dtype() == nb::dtype<int>()) {
-      const int *data = static_cast<const int *>(voxel_data.data());
-      size_t index;
-      if (voxel_data.ndim() == 3) {
-        index = z * voxel_data.shape(0) * voxel_data.shape(1) +
-                y * voxel_data.shape(0) + x;
-      } else {
-        index = y * voxel_data.shape(0) + x;
-      }
-      return data[index] != 0;
-    }
-    return false;
+    const float viewModel[16], bool showVoxelBorders,
+    bool showDebugFaceOrder) {
+  static const char *faceNames[] = {"Left", "Right", "Bottom",
+                                    "Top",  "Back",  "Front"};
+  struct VisibleQuad {
+    float depth; // camera-space z of the quad center
+    uint32_t index;
   };
-
-  for (const auto &voxel : voxelPoints) {
-    // Each voxel occupies a 1x1x1 cube from (x,y,z) to (x+1,y+1,z+1)
-    // No epsilon needed since we're only drawing external faces
-
-    std::vector<std::tuple<float, float, float>> cubeCorners = {
-        // Back face (z)
-        {voxel.x, voxel.y, voxel.z},               // 0: bottom-left-back
-        {voxel.x + 1.0f, voxel.y, voxel.z},        // 1: bottom-right-back
-        {voxel.x + 1.0f, voxel.y + 1.0f, voxel.z}, // 2: top-right-back
-        {voxel.x, voxel.y + 1.0f, voxel.z},        // 3: top-left-back
-        // Front face (z + 1)
-        {voxel.x, voxel.y, voxel.z + 1.0f},        // 4: bottom-left-front
-        {voxel.x + 1.0f, voxel.y, voxel.z + 1.0f}, // 5: bottom-right-front
-        {voxel.x + 1.0f, voxel.y + 1.0f, voxel.z + 1.0f}, // 6: top-right-front
-        {voxel.x, voxel.y + 1.0f, voxel.z + 1.0f}         // 7: top-left-front
-    };
-
-    // Project all corners to screen space
-    std::vector<ImVec2> screenCorners;
-    for (const auto &corner : cubeCorners) {
-      screenCorners.push_back(projectToScreen(
-          std::get<0>(corner), std::get<1>(corner), std::get<2>(corner)));
+  static std::vector<VisibleQuad> visible;
+  visible.clear();
+
+  const float *VM = viewModel;
+  const std::vector<SurfaceQuad> &quads = mesh.quads();
+  for (uint32_t i = 0; i < quads.size(); i++) {
+    const SurfaceQuad &quad = quads[i];
+    float cx = (quad.corners[0][0] + quad.corners[2][0]) * 0.5f;
+    float cy = (quad.corners[0][1] + quad.corners[2][1]) * 0.5f;
+    float cz = (quad.corners[0][2] + quad.corners[2][2]) * 0.5f;
+
+    // Camera-space center and normal; the camera sits at the origin
+    float px = VM[0] * cx + VM[4] * cy + VM[8] * cz + VM[12];
+    float py = VM[1] * cx + VM[5] * cy + VM[9] * cz + VM[13];
+    float pz = VM[2] * cx + VM[6] * cy + VM[10] * cz + VM[14];
+    float nx = VM[0] * quad.normal[0] + VM[4] * quad.normal[1] +
+               VM[8] * quad.normal[2];
+    float ny = VM[1] * quad.normal[0] + VM[5] * quad.normal[1] +
+               VM[9] * quad.normal[2];
+    float nz = VM[2] * quad.normal[0] + VM[6] * quad.normal[1] +
+               VM[10] * quad.normal[2];
+
+    // A face turned away from the camera is always behind its own voxel
+    if (nx * px + ny * py + nz * pz >= 0.0f) {
+      continue;
     }
+    visible.push_back({pz, i});
+  }
 
-    // Color based on value - make fully opaque to avoid blending seams
-    ImU32 voxelColor;
-    ImU32 borderColor = IM_COL32(0, 0, 0, 255); // Black border
+  // Sort faces by camera depth (back to front for proper rendering)
+  std::sort(visible.begin(), visible.end(),
+            [](const VisibleQuad &a, const VisibleQuad &b) {
+              return a.depth < b.depth;
+            });
 
-    if (voxel_data.dtype() == nb::dtype<float>()) {
-      // Color based on value intensity
-      uint8_t intensity =
-          (uint8_t)(std::min(std::abs((float)voxel.value) * 255.0f, 255.0f));
-      voxelColor = voxel.value > 0 ? IM_COL32(intensity, intensity / 2, 0, 255)
-                                   : // Orange for positive - fully opaque
-                       IM_COL32(0, intensity / 2, intensity,
-                                255); // Blue for negative - fully opaque
-    } else {
-      // Color based on value
-      uint8_t r = (uint8_t)((voxel.value * 67) % 256);
-      uint8_t g = (uint8_t)((voxel.value * 131) % 256);
-      uint8_t b = (uint8_t)((voxel.value * 197) % 256);
-      voxelColor = IM_COL32(r, g, b, 255); // Fully opaque
+  ImU32 borderColor = IM_COL32(0, 0, 0, 255); // Black border
+  for (size_t order = 0; order < visible.size(); order++) {
+    const SurfaceQuad &quad = quads[visible[order].index];
+    ImVec2 screenCorners[4];
+    for (int c = 0; c < 4; c++) {
+      screenCorners[c] = projectToScreen(quad.corners[c][0], quad.corners[c][1],
+                                         quad.corners[c][2]);
     }
 
-    // Define faces with neighbor checks - only draw external faces
-    struct Face {
-      std::vector<int> indices;
-      float centerX, centerY, centerZ;
-      float viewDepth; // Depth from camera perspective
-      std::string name;
-      int neighborX, neighborY, neighborZ; // Neighbor position to check
-    };
-
-    // Helper function to transform a point and get view depth
-    auto getViewDepth = [&](float x, float y, float z) -> float {
-      return cameraDepthFn(x, y, z); // camera-space z
-    };
+    drawList->AddQuadFilled(screenCorners[0], screenCorners[1],
+                            screenCorners[2], screenCorners[3],
+                            voxelColor(quad.value, floatData));
 
-    // Define all potential faces with their neighbor positions
-    std::vector<Face> potentialFaces = {
-        // Only include face if neighbor in that direction is empty
-        {{0, 1, 2, 3},
-         voxel.x + 0.5f,
-         voxel.y + 0.5f,
-         voxel.z,
-         0.0f,
-         "Back",
-         (int)voxel.x,
-         (int)voxel.y,
-         (int)voxel.z - 1},
-        {{4, 5, 6, 7},
-         voxel.x + 0.5f,
-         voxel.y + 0.5f,
-         voxel.z + 1.0f,
-         0.0f,
-         "Front",
-         (int)voxel.x,
-         (int)voxel.y,
-         (int)voxel.z + 1},
-        {{0, 1, 5, 4},
-         voxel.x + 0.5f,
-         voxel.y,
-         voxel.z + 0.5f,
-         0.0f,
-         "Bottom",
-         (int)voxel.x,
-         (int)voxel.y - 1,
-         (int)voxel.z},
-        {{3, 2, 6, 7},
-         voxel.x + 0.5f,
-         voxel.y + 1.0f,
-         voxel.z + 0.5f,
-         0.0f,
-         "Top",
-         (int)voxel.x,
-         (int)voxel.y + 1,
-         (int)voxel.z},
-        {{0, 3, 7, 4},
-         voxel.x,
-         voxel.y + 0.5f,
-         voxel.z + 0.5f,
-         0.0f,
-         "Left",
-         (int)voxel.x - 1,
-         (int)voxel.y,
-         (int)voxel.z},
-        {{1, 2, 6, 5},
-         voxel.x + 1.0f,
-         voxel.y + 0.5f,
-         voxel.z + 0.5f,
-         0.0f,
-         "Right",
-         (int)voxel.x + 1,
-         (int)voxel.y,
-         (int)voxel.z}};
-
-    // Filter faces - only keep external faces (no solid neighbor)
-    std::vector<Face> faces;
-    for (auto &face : potentialFaces) {
-      if (!hasVoxelAt(face.neighborX, face.neighborY, face.neighborZ)) {
-        face.viewDepth = getViewDepth(face.centerX, face.centerY, face.centerZ);
-        faces.push_back(face);
-      }
+    // Borders outline merged faces, not every voxel
+    if (showVoxelBorders) {
+      drawList->AddQuad(screenCorners[0], screenCorners[1], screenCorners[2],
+                        screenCorners[3], borderColor, 1.0f);
     }
 
-    // Sort faces by view depth (back to front from camera perspective)
-    std::sort(faces.begin(), faces.end(), [](const Face &a, const Face &b) {
-      return a.viewDepth < b.viewDepth;
-    });
-
-    // Draw faces in depth-sorted order
-    for (size_t faceIndex = 0; faceIndex < faces.size(); faceIndex++) {
-      const auto &face = faces[faceIndex];
-      const auto &indices = face.indices;
-
-      // Draw filled face
-      drawList->AddQuadFilled(
-          screenCorners[indices[0]], screenCorners[indices[1]],
-          screenCorners[indices[2]], screenCorners[indices[3]], voxelColor);
-
-      // Draw border if enabled
-      if (showVoxelBorders) {
-        drawList->AddQuad(screenCorners[indices[0]], screenCorners[indices[1]],
-                          screenCorners[indices[2]], screenCorners[indices[3]],
-                          borderColor, 1.0f);
-      }
-
-      // Debug: Show face rendering order and depth values
-      if (showDebugFaceOrder) {
-        // Calculate face center in screen space for label positioning
-        ImVec2 faceCenter =
-            ImVec2((screenCorners[indices[0]].x + screenCorners[indices[1]].x +
-                    screenCorners[indices[2]].x + screenCorners[indices[3]].x) *
-                       0.25f,
-                   (screenCorners[indices[0]].y + screenCorners[indices[1]].y +
-                    screenCorners[indices[2]].y + screenCorners[indices[3]].y) *
-                       0.25f);
-
-        // Create debug label with face name, render order, and depth
-        char debugLabel[64];
-        snprintf(debugLabel, sizeof(debugLabel), "%s\n#%zu\nD:%.2f",
-                 face.name.c_str(), faceIndex, face.viewDepth);
-
-        // Draw debug info with background for readability
-        ImVec2 textSize = ImGui::CalcTextSize(debugLabel);
-        ImVec2 bgMin = ImVec2(faceCenter.x - textSize.x * 0.5f - 2,
-                              faceCenter.y - textSize.y * 0.5f - 2);
-        ImVec2 bgMax = ImVec2(faceCenter.x + textSize.x * 0.5f + 2,
-                              faceCenter.y + textSize.y * 0.5f + 2);
-
-        // Semi-transparent background
-        drawList->AddRectFilled(bgMin, bgMax, IM_COL32(0, 0, 0, 180));
-        drawList->AddRect(bgMin, bgMax, IM_COL32(255, 255, 255, 255), 0.0f, 0,
-                          1.0f);
-
-        // Debug text
-        ImVec2 textPos = ImVec2(faceCenter.x - textSize.x * 0.5f,
-                                faceCenter.y - textSize.y * 0.5f);
-        drawList->AddText(textPos, IM_COL32(255, 255, 255, 255), debugLabel);
-
-        // Draw arrow pointing from face center to camera direction
-        ImVec2 arrowEnd = ImVec2(faceCenter.x, faceCenter.y - 20);
-        drawList->AddLine(faceCenter, arrowEnd, IM_COL32(255, 255, 0, 255),
-                          2.0f);
-        drawList->AddTriangleFilled(ImVec2(arrowEnd.x, arrowEnd.y - 5),
-                                    ImVec2(arrowEnd.x - 3, arrowEnd.y + 2),
-                                    ImVec2(arrowEnd.x + 3, arrowEnd.y + 2),
-                                    IM_COL32(255, 255, 0, 255));
-      }
+    // Debug: Show face rendering order and depth values
+    if (showDebugFaceOrder) {
+      ImVec2 faceCenter = ImVec2(
+          (screenCorners[0].x + screenCorners[1].x + screenCorners[2].x +
+           screenCorners[3].x) *
+              0.25f,
+          (screenCorners[0].y + screenCorners[1].y + screenCorners[2].y +
+           screenCorners[3].y) *
+              0.25f);
+
+      char debugLabel[64];
+      snprintf(debugLabel, sizeof(debugLabel), "%s\n#%zu\nD:%.2f",
+               faceNames[static_cast<int>(quad.face)], order,
+               visible[order].depth);
+
+      // Draw debug info with background for readability
+      ImVec2 textSize = ImGui::CalcTextSize(debugLabel);
+      ImVec2 bgMin = ImVec2(faceCenter.x - textSize.x * 0.5f - 2,
+                            faceCenter.y - textSize.y * 0.5f - 2);
+      ImVec2 bgMax = ImVec2(faceCenter.x + textSize.x * 0.5f + 2,
+                            faceCenter.y + textSize.y * 0.5f + 2);
+      drawList->AddRectFilled(bgMin, bgMax, IM_COL32(0, 0, 0, 180));
+      drawList->AddRect(bgMin, bgMax, IM_COL32(255, 255, 255, 255), 0.0f, 0,
+                        1.0f);
+      ImVec2 textPos = ImVec2(faceCenter.x - textSize.x * 0.5f,
+                              faceCenter.y - textSize.y * 0.5f);
+      drawList->AddText(textPos, IM_COL32(255, 255, 255, 255), debugLabel);
     }
   }
 }
@@ -1,12 +1,8 @@
-
 #include "HealthSystem.hpp"
 
 void HealthSystem::processHealth(entt::registry &registry, VoxelGrid &voxelGrid,
                                  entt::dispatcher &dispatcher) {
-  auto healthCompView = registry.view<HealthComponent>();
-  for (auto entity : healthCompView) {
-    auto &health = registry.get<HealthComponent>(entity);
-
+  for (auto [entity, health] : registry.view<HealthComponent>().each()) {
     if (health.healthLevel <= 0) {
       // Kill the entity
       dispatcher.enqueue<KillEntityEvent>(entity, true);
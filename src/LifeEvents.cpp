@@ -6,6 +6,7 @@
 #include <chrono>
 #include <iostream>
 
+#include "diag/Diag.hpp"
 #include "diag/ThrottledLog.hpp"
 #include "physics/PhysicsMutators.hpp" // For softKillEntity and dropEntityItems
 
@@ -66,7 +67,7 @@ void LifeEngine::onTerrainRemoveVelocityEvent(
   // std::endl;
 
   if (entityId != -1 && entityId != -2) {
-    entitiesToRemoveVelocity.emplace_back(event.entity, false);
+    commands.remove<Velocity>(event.entity);
   }
 }
 
@@ -78,7 +79,7 @@ void LifeEngine::onTerrainRemoveMovingComponentEvent(
   // std::endl;
 
   if (entityId != -1 && entityId != -2) {
-    entitiesToRemoveMovingComponent.emplace_back(event.entity, false);
+    commands.remove<MovingComponent>(event.entity);
   }
 }
 
@@ -101,7 +102,12 @@ void LifeEngine::flushLifeMetrics(GameDBHandler *dbHandler) {
   for (const auto &kv : lifeMetrics_) {
     const std::string &name = kv.first;
     uint64_t value = kv.second;
-    dbHandler->putTimeSeries(name, ts, static_cast<double>(value));
+    // Prefer the diag writer thread so this per-tick flush never runs a
+    // SQLite insert on the simulation thread.
+    if (!aetherion::diag::Registry::instance().enqueue_time_series(
+            name, ts, static_cast<double>(value))) {
+      dbHandler->putTimeSeries(name, ts, static_cast<double>(value));
+    }
   }
 
   // reset counters
@@ -12,6 +12,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "EcsCommandBuffer.hpp"
 #include "EntityInterface.hpp"
 #include "EventSink.hpp"
 #include "GameDBHandler.hpp"
@@ -33,13 +34,13 @@ inline const std::string LIFE_REMOVE_MOVING_COMPONENT =
 class LifeEngine {
 public:
   std::vector<std::tuple<entt::entity, bool>> entitiesToDelete;
-  std::vector<std::tuple<entt::entity, bool>> entitiesToRemoveVelocity;
-  std::vector<std::tuple<entt::entity, bool>> entitiesToRemoveMovingComponent;
   std::unordered_set<entt::entity> entitiesScheduledForDeletion;
 
   LifeEngine() = default;
-  LifeEngine(entt::registry &reg, EventSink &sinkRef, VoxelGrid *voxelGrid)
-      : registry(reg), sink(sinkRef), voxelGrid(voxelGrid) {}
+  LifeEngine(entt::registry &reg, EventSink &sinkRef, VoxelGrid *voxelGrid,
+             EcsCommandQueue &commandsRef)
+      : registry(reg), sink(sinkRef), voxelGrid(voxelGrid),
+        commands(commandsRef) {}
 
   // Handle entity movement event
   void onKillEntity(const KillEntityEvent &event);
@@ -60,6 +61,9 @@ private:
   entt::registry &registry;
   EventSink &sink;
   VoxelGrid *voxelGrid;
+  // Velocity / MovingComponent removals are deferred to the World's
+  // command playback.
+  EcsCommandQueue &commands;
 
   // Monitoring counters for life events
   std::unordered_map<std::string, uint64_t> lifeMetrics_;
@@ -0,0 +1,220 @@
+#ifndef METABOLISM_PASS_HPP
+#define METABOLISM_PASS_HPP
+
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <vector>
+
+#include "SimulationLod.hpp"
+#include "components/EntityTypeComponent.hpp"
+#include "components/HealthComponents.hpp"
+#include "components/ItemsComponents.hpp"
+#include "components/MetabolismComponents.hpp"
+#include "components/PerceptionComponent.hpp"
+#include "components/PhysicsComponents.hpp"
+
+// The per-creature half of MetabolismSystem: starvation, reproduction and
+// digestion for every entity of the metabolism group, run as a TBB
+// parallel_for over the group's packed arrays. Each entity only writes its
+// own components, so the pass needs no locks; everything that restructures
+// the registry (kills, births) comes back in a MetabolismOutcome for the
+// caller to apply in one batch once the pass is over.
+//
+// With a SimulationLodMap, creatures in regions that are not due this tick
+// are skipped, and the others catch up on the ticks since their region
+// last ran: starvation and digestion advance by that many ticks,
+// reproduction is still checked once.
+
+struct MetabolismRules {
+  int chunkDigestionTime = 10;
+  float chunkMass = 1;
+  float starvationDamage = 10;  // health lost per tick below zero energy
+  float starvationRefund = 10;  // energy recovered from that health
+  float reproduceAbove = 100;   // energy needed to have offspring
+  float reproduceCost = 60;     // energy the parent spends on it
+  float offspringEnergy = 10;   // energy the offspring starts with
+  int playerSubType = 1;        // BeastEnum.PLAYER; players never breed
+};
+
+struct MetabolismOutcome {
+  std::size_t entities = 0;           // size of the metabolism group
+  std::vector<entt::entity> starved;  // health ran out while starving
+  std::vector<entt::entity> parents;  // one offspring each, in group order
+  LodTally lod;                       // only filled with a SimulationLodMap
+};
+
+// Metabolism, digestion and the entity type live in an owning group, so the
+// first two are packed in step and the pass indexes them directly. Every
+// caller must ask for the group with this same signature.
+inline auto metabolismGroup(entt::registry &registry) {
+  return registry.group<MetabolismComponent, DigestionComponent>(
+      entt::get<EntityTypeComponent>);
+}
+
+namespace metabolism_detail {
+
+// Per-entity result bits; the LOD level goes in the top two.
+enum : uint8_t { kStarved = 1, kParent = 2, kSkipped = 4, kLevelShift = 6 };
+
+// One update of one creature, standing for `ticks` ticks.
+inline uint8_t metabolizeOne(MetabolismComponent &metabolism,
+                             DigestionComponent &digestion,
+                             const EntityTypeComponent &etc,
+                             HealthComponent *health,
+                             const MetabolismRules &rules, bool allowBirths,
+                             int ticks) {
+  uint8_t result = 0;
+
+  for (int t = 0; t < ticks && metabolism.energyReserve < 0 && health; ++t) {
+    health->healthLevel -= rules.starvationDamage;
+    if (health->healthLevel <= 0) {
+      result |= kStarved;
+    }
+    metabolism.energyReserve += rules.starvationRefund;
+  }
+
+  if (allowBirths && metabolism.energyReserve > rules.reproduceAbove &&
+      etc.mainType == static_cast<int>(EntityEnum::BEAST) &&
+      etc.subType0 != rules.playerSubType) {
+    metabolism.energyReserve -= rules.reproduceCost;
+    result |= kParent;
+  }
+
+  if (digestion.digestingItems.empty()) {
+    return result;
+  }
+  std::vector<int> itemsToRemove;
+  for (auto &item : digestion.digestingItems) {
+    const int before = item.processingTime;
+    item.processingTime += ticks;
+    // Chunks whose digestion time fell within the ticks just covered.
+    int chunks = item.processingTime / rules.chunkDigestionTime -
+                 before / rules.chunkDigestionTime;
+    for (; chunks > 0; --chunks) {
+      double digestedMass = rules.chunkMass * item.convertionEfficiency;
+      double energyInChunk = digestedMass * item.energyDensity;
+      item.mass -= digestedMass;
+      metabolism.energyReserve += energyInChunk;
+
+      if (health) {
+        double healthInChunk = energyInChunk * item.energyHealthRatio;
+        if (healthInChunk > 0 &&
+            health->healthLevel + healthInChunk < health->maxHealth) {
+          health->healthLevel += healthInChunk;
+        } else if (healthInChunk > 0) {
+          health->healthLevel = health->maxHealth;
+        }
+      }
+
+      if (item.mass <= 0) {
+        itemsToRemove.push_back(item.foodItemID);
+        break;
+      }
+    }
+  }
+  for (int foodItemID : itemsToRemove) {
+    digestion.removeItem(foodItemID);
+  }
+  return result;
+}
+
+template <typename Component>
+void clonePool(entt::registry &registry,
+               const std::vector<entt::entity> &prototypes,
+               const std::vector<entt::entity> &clones) {
+  auto &pool = registry.storage<Component>();
+  std::vector<entt::entity> targets;
+  std::vector<Component> values;
+  for (std::size_t i = 0; i < prototypes.size(); ++i) {
+    if (pool.contains(prototypes[i])) {
+      targets.push_back(clones[i]);
+      values.push_back(pool.get(prototypes[i]));
+    }
+  }
+  registry.insert<Component>(targets.begin(), targets.end(), values.begin());
+}
+
+} // namespace metabolism_detail
+
+// Runs the metabolism rules over every entity of metabolismGroup(). Births
+// are only reported while `allowBirths` holds. Creatures without a
+// Position are never skipped by `lod`.
+inline MetabolismOutcome
+runMetabolismPass(entt::registry &registry, const MetabolismRules &rules,
+                  bool allowBirths, const SimulationLodMap *lod = nullptr) {
+  using namespace metabolism_detail;
+  auto group = metabolismGroup(registry);
+  // Looked up here, on the calling thread: storage<T>() may create the
+  // pool, which is not safe from the workers.
+  auto &healthPool = registry.storage<HealthComponent>();
+  auto &positionPool = registry.storage<Position>();
+
+  MetabolismOutcome outcome;
+  outcome.entities = group.size();
+  std::vector<uint8_t> results(outcome.entities, 0);
+  tbb::parallel_for(
+      tbb::blocked_range<std::size_t>(0, outcome.entities, 256),
+      [&](const tbb::blocked_range<std::size_t> &range) {
+        for (std::size_t i = range.begin(); i != range.end(); ++i) {
+          const entt::entity entity = group.begin()[i];
+          int ticks = 1;
+          if (lod && positionPool.contains(entity)) {
+            const Position &pos = positionPool.get(entity);
+            const LodCell &cell = lod->at(pos.x, pos.y);
+            ticks = cell.ticksDue;
+            results[i] = static_cast<uint8_t>(
+                static_cast<uint8_t>(cell.level) << kLevelShift);
+            if (ticks == 0) {
+              results[i] |= kSkipped;
+              continue;
+            }
+          }
+          auto [metabolism, digestion, etc] = group.get(entity);
+          HealthComponent *health =
+              healthPool.contains(entity) ? &healthPool.get(entity) : nullptr;
+          results[i] |= metabolizeOne(metabolism, digestion, etc, health,
+                                      rules, allowBirths, ticks);
+        }
+      });
+
+  for (std::size_t i = 0; i < outcome.entities; ++i) {
+    if (lod) {
+      outcome.lod.add(static_cast<LodLevel>(results[i] >> kLevelShift),
+                      !(results[i] & kSkipped));
+    }
+    if (results[i] & kStarved) {
+      outcome.starved.push_back(group.begin()[i]);
+    }
+    if (results[i] & kParent) {
+      outcome.parents.push_back(group.begin()[i]);
+    }
+  }
+  return outcome;
+}
+
+// Creates one entity per prototype and copies the prototype's components
+// onto it, one range insert per component type. Returns the clones in
+// prototype order.
+inline std::vector<entt::entity>
+cloneEntities(entt::registry &registry,
+              const std::vector<entt::entity> &prototypes) {
+  using namespace metabolism_detail;
+  std::vector<entt::entity> clones(prototypes.size());
+  registry.create(clones.begin(), clones.end());
+  clonePool<EntityTypeComponent>(registry, prototypes, clones);
+  clonePool<PhysicsStats>(registry, prototypes, clones);
+  clonePool<Position>(registry, prototypes, clones);
+  clonePool<Velocity>(registry, prototypes, clones);
+  clonePool<HealthComponent>(registry, prototypes, clones);
+  clonePool<PerceptionComponent>(registry, prototypes, clones);
+  clonePool<DigestionComponent>(registry, prototypes, clones);
+  clonePool<MetabolismComponent>(registry, prototypes, clones);
+  clonePool<Inventory>(registry, prototypes, clones);
+  return clones;
+}
+
+#endif // METABOLISM_PASS_HPP
@@ -4,6 +4,7 @@
 #include <entt/entt.hpp>
 
 #include "LifeEvents.hpp"
+#include "MetabolismPass.hpp"
 #include "components/DnaComponents.hpp"
 #include "components/EntityTypeComponent.hpp"
 #include "components/HealthComponents.hpp"
@@ -18,20 +19,26 @@ public:
   MetabolismSystem() = default;
   MetabolismSystem(entt::registry &reg, VoxelGrid *voxelGrid) : registry(reg) {}
 
-  // Method to process physics-related events
+  // One metabolism tick: runMetabolismPass over every creature, then the
+  // starvation kills and the births it reports, applied as one batch.
   void processMetabolism(entt::registry &registry, VoxelGrid &voxelGrid,
                          entt::dispatcher &dispatcher);
-  void processMetabolismAsync(entt::registry &registry, VoxelGrid &voxelGrid,
-                              entt::dispatcher &dispatcher);
 
   // Register the event handler
   void registerEventHandlers(entt::dispatcher &dispatcher);
 
   bool isProcessingComplete() const;
 
+  // Skips creatures whose LOD region is not due; null runs every tick.
+  void setSimulationLod(const SimulationLod *lod) { simulationLod_ = lod; }
+
 private:
-  int chunkDigestionTime = 10;
-  float chunkMass = 1;
+  // Clones `parents` and places each offspring one voxel above its parent.
+  void spawnOffspring(entt::registry &registry, VoxelGrid &voxelGrid,
+                      const std::vector<entt::entity> &parents);
+
+  MetabolismRules rules;
+  const SimulationLod *simulationLod_ = nullptr;
   entt::registry &registry;
   VoxelGrid *voxelGrid;
 
@@ -7,6 +7,7 @@
 #include <nanobind/nanobind.h>
 
 #include "EntityInterface.hpp"
+#include "EntityInterfaceFlatB.hpp"
 #include "FlatbufferUtils.hpp"
 #include "GameClock.hpp"
 #include "PerceptionResponse_generated.h"
@@ -51,20 +52,13 @@ public:
 
   // Get the EntityInterface object
   nb::object getEntity() const {
-    const GameEngine::EntityInterface *entity_fb =
-        fbPerceptionResponse->entity();
-
-    // Deserialize entity data
-    std::vector<char> entity_buffer(entity_fb->entity_data()->begin(),
-                                    entity_fb->entity_data()->end());
-    EntityInterface entity = EntityInterface::deserialize(entity_buffer.data(),
-                                                          entity_buffer.size());
-
-    // Assign the entityId from the FlatBuffer
-    entity.entityId = entity_fb->entityId();
-
     // Return the deserialized entity as a Python object
-    return nb::cast(entity);
+    return nb::cast(deserializeEntityFlatB(fbPerceptionResponse->entity()));
+  }
+
+  // Read the observer's components without decoding the whole entity
+  EntityInterfaceFlatB getEntityView() const {
+    return EntityInterfaceFlatB(fbPerceptionResponse->entity());
   }
 
   // Get the EntityInterface object
@@ -123,15 +117,8 @@ struct PerceptionResponse {
   std::vector<char> serializeFlatBuffer() const {
     flatbuffers::FlatBufferBuilder builder;
 
-    const size_t entity_total = entity.computeSerializedSize();
-    uint8_t *entity_dst = nullptr;
-    auto entity_data_offset =
-        builder.CreateUninitializedVector<uint8_t>(entity_total, &entity_dst);
-    entity.serializeInto(entity_dst);
-
     // Create FlatBuffer for EntityInterface
-    auto entity_offset = GameEngine::CreateEntityInterface(
-        builder, entity.entityId, entity_data_offset);
+    auto entity_offset = serializeEntityFlatB(builder, entity, entity.entityId);
 
     // Serialize the WorldView — terrain voxels + visible entities. Almost
     // always the heaviest sub-phase for the player observer.
@@ -148,15 +135,8 @@ struct PerceptionResponse {
         itemsEntitiesOffsets;
 
     for (const auto &[itemsEntityId, itemsEntityInterface] : itemsEntities) {
-      const size_t total = itemsEntityInterface.computeSerializedSize();
-      uint8_t *dst = nullptr;
-      auto entityDataOffset =
-          builder.CreateUninitializedVector<uint8_t>(total, &dst);
-      itemsEntityInterface.serializeInto(dst);
-
-      auto entityOffset = GameEngine::CreateEntityInterface(
-          builder, itemsEntityId, entityDataOffset);
-      itemsEntitiesOffsets.push_back(entityOffset);
+      itemsEntitiesOffsets.push_back(
+          serializeEntityFlatB(builder, itemsEntityInterface, itemsEntityId));
     }
 
     auto itemsEntitiesFinalOffset = builder.CreateVector(itemsEntitiesOffsets);
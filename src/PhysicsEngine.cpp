@@ -53,6 +53,9 @@ inline const std::string PHYSICS_INVALID_TERRAIN_FOUND =
     "physics_invalid_terrain_found";
 inline const std::string PHYSICS_PLANT_WATER_UPTAKE =
     "physics_plant_water_uptake";
+inline const std::string PHYSICS_GRAVITY_AWAKE = "physics_gravity_awake";
+inline const std::string PHYSICS_GRAVITY_ASLEEP = "physics_gravity_asleep";
+inline const std::string PHYSICS_GRAVITY_WAKEUPS = "physics_gravity_wakeups";
 
 // =========================================================================
 // ================ PHYSICS ENGINE ORGANIZATION ================
@@ -375,7 +378,8 @@ void PhysicsEngine::onPlantWaterUptakeEvent(
 
 // Register a diag::Counter for each physics metric, using the legacy
 // metric name as the GameDB series name so existing dashboards and
-// historical data continue to work.
+// historical data continue to work. The pass-time histograms are new
+// series (`<name>.p50` … `.max`), in nanoseconds.
 void PhysicsEngine::registerDiagCounters() {
   using namespace aetherion::diag;
   auto &reg = Registry::instance();
@@ -404,6 +408,29 @@ void PhysicsEngine::registerDiagCounters() {
   counters_.delete_or_convert_terrain = make(PHYSICS_DELETE_OR_CONVERT_TERRAIN);
   counters_.invalid_terrain_found = make(PHYSICS_INVALID_TERRAIN_FOUND);
   counters_.plant_water_uptake = make(PHYSICS_PLANT_WATER_UPTAKE);
+  counters_.gravity_wakeups = make(PHYSICS_GRAVITY_WAKEUPS);
+
+  auto makeGauge = [&](const std::string &name) {
+    GaugeConfig cfg;
+    cfg.name = name;
+    cfg.unit = "entities";
+    cfg.flush_every = std::chrono::seconds{1};
+    cfg.sinks = {GameDBSink{}};
+    return reg.gauge(cfg);
+  };
+  counters_.gravity_awake = makeGauge(PHYSICS_GRAVITY_AWAKE);
+  counters_.gravity_asleep = makeGauge(PHYSICS_GRAVITY_ASLEEP);
+
+  auto makeTimer = [&](const std::string &name) {
+    HistogramConfig cfg;
+    cfg.name = name;
+    cfg.flush_every = std::chrono::seconds{1};
+    cfg.sinks = {GameDBSink{}};
+    return reg.histogram(cfg);
+  };
+  counters_.process_physics_ns = makeTimer("physics_process_physics_ns");
+  counters_.process_physics_async_ns =
+      makeTimer("physics_process_physics_async_ns");
 }
 
 // ================ END OF REFACTORING ================
@@ -663,8 +690,15 @@ void handleMovement(entt::registry &registry, EventSink &sink,
                     int(entity), newVelocityZ, willStopZ);
     }
 
+    // One neighbourhood read serves the stability, destination and collision
+    // checks below; nothing in between writes terrain type or flags.
+    const TerrainStencil moveStencil =
+        voxelGrid.terrainGridRepository->getStencil(
+            position.x, position.y, position.z, kMovementStencilFields);
+
     // Check stability below entity and apply friction
-    bool bellowIsStable = checkBelowStability(registry, voxelGrid, position);
+    bool bellowIsStable =
+        checkBelowStability(registry, voxelGrid, position, &moveStencil);
 
     if (isTerrain && matterState == MatterState::LIQUID) {
       logger->debug("[handleMovement][TERRAIN id={}] bellowIsStable={}",
@@ -702,7 +736,7 @@ void handleMovement(entt::registry &registry, EventSink &sink,
     auto [movingToX, movingToY, movingToZ, completionTime] =
         calculateMovementDestination(registry, voxelGrid, position, velocity,
                                      physicsStats, velocity.vx, velocity.vy,
-                                     velocity.vz);
+                                     velocity.vz, &moveStencil);
 
     if (isTerrain) {
       int timeThreshold = calculateTimeToMove(physicsStats.minSpeed);
@@ -717,7 +751,8 @@ void handleMovement(entt::registry &registry, EventSink &sink,
     // Check collision and handle movement
     bool collision =
         hasCollision(registry, voxelGrid, entity, position.x, position.y,
-                     position.z, movingToX, movingToY, movingToZ, isTerrain);
+                     position.z, movingToX, movingToY, movingToZ, isTerrain,
+                     &moveStencil);
 
     if (isTerrain) {
       logger->debug("[handleMovement][TERRAIN id={}] collision={}", int(entity),
@@ -847,20 +882,17 @@ void handleMovingTo(entt::registry &registry, VoxelGrid &voxelGrid,
                     entt::entity entity, bool isTerrain) {
   // SAFETY CHECK: Validate entity is still valid
   if (!registry.valid(entity)) {
-    std::ostringstream ossMessage;
-    ossMessage << "[handleMovingTo] WARNING: Invalid entity "
-               << static_cast<int>(entity) << " - skipping";
-    spdlog::get("console")->debug(ossMessage.str());
+    spdlog::get("console")->debug(
+        "[handleMovingTo] WARNING: Invalid entity {} - skipping",
+        static_cast<int>(entity));
     return;
   }
 
   // SAFETY CHECK: Ensure entity has required components
   if (!registry.all_of<MovingComponent, Position>(entity)) {
-    std::ostringstream ossMessage;
-    ossMessage << "[handleMovingTo] WARNING: Entity "
-               << static_cast<int>(entity)
-               << " missing MovingComponent or Position - skipping";
-    spdlog::get("console")->debug(ossMessage.str());
+    spdlog::get("console")->debug("[handleMovingTo] WARNING: Entity {} missing "
+                                  "MovingComponent or Position - skipping",
+                                  static_cast<int>(entity));
     return;
   }
 
@@ -888,86 +920,83 @@ void handleMovingTo(entt::registry &registry, VoxelGrid &voxelGrid,
         voxelGrid.terrainGridRepository.get());
   }
 
-  auto &&[movingComponent, position] =
-      registry.get<MovingComponent, Position>(entity);
-
-  if (movingComponent.timeRemaining <= 0) {
-    // voxelGrid.setEntity(position.x, position.y, position.z, -1);
-    // voxelGrid.setEntity(movingComponent.movingToX, movingComponent.movingToY,
-    //                     movingComponent.movingToZ, static_cast<int>(entity));
-    // position.x = movingComponent.movingToX;
-    // position.y = movingComponent.movingToY;
-    // position.z = movingComponent.movingToZ;
-
-    bool hasVelocity = registry.all_of<Velocity>(entity);
-    Velocity velocity;
-    if (!hasVelocity) {
-      velocity = {0.0f, 0.0f, 0.0f};
-    } else {
-      velocity = registry.get<Velocity>(entity);
-    }
+  // Called by processPhysics once the MovementSchedule says the move is
+  // due, so there is no countdown left to check here.
+  auto &position = registry.get<Position>(entity);
+
+  // voxelGrid.setEntity(position.x, position.y, position.z, -1);
+  // voxelGrid.setEntity(movingComponent.movingToX, movingComponent.movingToY,
+  //                     movingComponent.movingToZ, static_cast<int>(entity));
+  // position.x = movingComponent.movingToX;
+  // position.y = movingComponent.movingToY;
+  // position.z = movingComponent.movingToZ;
+
+  bool hasVelocity = registry.all_of<Velocity>(entity);
+  Velocity velocity;
+  if (!hasVelocity) {
+    velocity = {0.0f, 0.0f, 0.0f};
+  } else {
+    velocity = registry.get<Velocity>(entity);
+  }
 
-    MatterState matterState = MatterState::SOLID;
-    // TODO: Terrains does not get this component like this anymore - fix later
-    StructuralIntegrityComponent *p_sic =
-        registry.try_get<StructuralIntegrityComponent>(entity);
-    if (p_sic && !isTerrain) {
-      matterState = p_sic->matterState;
-    } else if (isTerrain) {
-      // TODO: Remove me
-      throw std::runtime_error("handleMovingTo: isTerrain - Just checking...");
-      spdlog::get("console")->debug("[handleMovingTo] isTerrain Fetching "
-                                    "matter state for terrain entity ID={}",
-                                    int(entity));
-      StructuralIntegrityComponent sic =
-          voxelGrid.terrainGridRepository->getTerrainStructuralIntegrity(
-              position.x, position.y, position.z);
-      matterState = sic.matterState;
-    }
+  MatterState matterState = MatterState::SOLID;
+  // TODO: Terrains does not get this component like this anymore - fix later
+  StructuralIntegrityComponent *p_sic =
+      registry.try_get<StructuralIntegrityComponent>(entity);
+  if (p_sic && !isTerrain) {
+    matterState = p_sic->matterState;
+  } else if (isTerrain) {
+    // TODO: Remove me
+    throw std::runtime_error("handleMovingTo: isTerrain - Just checking...");
+    spdlog::get("console")->debug("[handleMovingTo] isTerrain Fetching "
+                                  "matter state for terrain entity ID={}",
+                                  int(entity));
+    StructuralIntegrityComponent sic =
+        voxelGrid.terrainGridRepository->getTerrainStructuralIntegrity(
+            position.x, position.y, position.z);
+    matterState = sic.matterState;
+  }
 
-    if (matterState == MatterState::SOLID) {
-      float newVelocityZ;
-      bool willStopZ{false};
-      std::pair<float, bool> resultZ;
-      resultZ = calculateVelocityAfterGravityStep(registry, voxelGrid,
-                                                  position.x, position.y,
-                                                  position.z, velocity.vz, 1);
-      newVelocityZ = resultZ.first;
-      resultZ = calculateVelocityAfterGravityStep(registry, voxelGrid,
-                                                  position.x, position.y,
-                                                  position.z, velocity.vz, 2);
-      willStopZ = resultZ.second;
+  if (matterState == MatterState::SOLID) {
+    float newVelocityZ;
+    bool willStopZ{false};
+    std::pair<float, bool> resultZ;
+    resultZ = calculateVelocityAfterGravityStep(registry, voxelGrid,
+                                                position.x, position.y,
+                                                position.z, velocity.vz, 1);
+    newVelocityZ = resultZ.first;
+    resultZ = calculateVelocityAfterGravityStep(registry, voxelGrid,
+                                                position.x, position.y,
+                                                position.z, velocity.vz, 2);
+    willStopZ = resultZ.second;
 
-      velocity.vz = newVelocityZ;
-    } else if (isTerrain && matterState == MatterState::LIQUID) {
-      // TODO: Remove me
-      throw std::runtime_error(
-          "handleMovingTo: Entity is liquid, bingo - Just checking...");
-    }
-
-    if (!hasVelocity) {
-      // if (isTerrain) {
-      //     std::ostringstream ossMessage;
-      //     ossMessage
-      //         << "[handleMovingTo] WARNING: Creating Velocity component for
-      //         terrain entity
-      //         "
-      //         << static_cast<int>(entity) << " at position (" << position.x
-      //         << ", "
-      //         << position.y << ", " << position.z << ")";
-      //     spdlog::get("console")->info(ossMessage.str());
-      // }
-      registry.emplace<Velocity>(entity, velocity);
-    }
+    velocity.vz = newVelocityZ;
+  } else if (isTerrain && matterState == MatterState::LIQUID) {
+    // TODO: Remove me
+    throw std::runtime_error(
+        "handleMovingTo: Entity is liquid, bingo - Just checking...");
+  }
 
-    // CRITICAL: Remove MovingComponent to allow new movement events to be
-    // processed std::cout << "[handleMovingTo] Removing MovingComponent from
-    // entity "
-    //           << static_cast<int>(entity) << std::endl;
-    registry.remove<MovingComponent>(entity);
-  } else {
-    movingComponent.timeRemaining--;
+  if (!hasVelocity) {
+    // if (isTerrain) {
+    //     std::ostringstream ossMessage;
+    //     ossMessage
+    //         << "[handleMovingTo] WARNING: Creating Velocity component for
+    //         terrain entity
+    //         "
+    //         << static_cast<int>(entity) << " at position (" << position.x
+    //         << ", "
+    //         << position.y << ", " << position.z << ")";
+    //     spdlog::get("console")->info(ossMessage.str());
+    // }
+    registry.emplace<Velocity>(entity, velocity);
   }
+
+  // CRITICAL: Remove MovingComponent to allow new movement events to be
+  // processed std::cout << "[handleMovingTo] Removing MovingComponent from
+  // entity "
+  //           << static_cast<int>(entity) << std::endl;
+  registry.remove<MovingComponent>(entity);
 }
 
 void PhysicsEngine::processPhysics(entt::registry &registry,
@@ -976,142 +1005,118 @@ void PhysicsEngine::processPhysics(entt::registry &registry,
 #ifdef TRACY_ENABLE
   ZoneScopedN("PhysicsEngine::processPhysics");
 #endif
+  aetherion::diag::ScopedTimer passTimer(counters_.process_physics_ns);
   // spdlog::get("console")->debug("Processing physics");
 
   processVelocityForECSEntities(registry, voxelGrid, sink);
 
   processVelocityForVDBVoxels(registry, voxelGrid);
 
-  auto movingComponentView = registry.view<MovingComponent>();
-  for (auto entity : movingComponentView) {
-    // SAFETY CHECK: Validate entity before processing
-    // Note: handleMovingTo also validates, but checking here prevents
-    // unnecessary calls SAFETY CHECK: Validate entity before processing
-    if (!registry.valid(entity)) {
-      // Entity is invalid but still listed in the MovingComponent storage —
-      // skip defensively; tracking-map cleanup happens at the explicit
-      // remove site (moveTerrain / deleteTerrain).
-      std::ostringstream ossMessage;
-      ossMessage
-          << "[processPhysics:MovingComponent] WARNING: Invalid entity in "
-             "movingComponentView - skipping; entity ID="
-          << static_cast<int>(entity);
-      spdlog::get("console")->debug(ossMessage.str());
+  processMovementCompletions(registry, voxelGrid, sink);
+}
 
-      continue;
+void PhysicsEngine::processMovementCompletions(entt::registry &registry,
+                                               VoxelGrid &voxelGrid,
+                                               EventSink &sink) {
+  movementSchedule_.advance([&](entt::entity entity) {
+    completeMovementForEntity(entity, registry, voxelGrid, sink);
+    // The old loop visited every MovingComponent each tick, so one that was
+    // skipped here rather than completed is looked at again next tick.
+    if (registry.valid(entity) && registry.all_of<MovingComponent>(entity) &&
+        !movementSchedule_.scheduled(entity)) {
+      movementSchedule_.schedule(entity, 0);
     }
+  });
+}
 
-    // SAFETY CHECK: Ensure entity has Position component
-    Position pos;
-    bool isTerrain = false;
-    int entityId = static_cast<int>(entity);
-    if (!registry.all_of<Position>(entity)) {
-      {
-        std::ostringstream ossMessage;
-        ossMessage << "[processPhysics:MovingComponent] WARNING: Entity "
-                   << static_cast<int>(entity)
-                   << " has Velocity but no Position - skipping";
-        spdlog::get("console")->debug(ossMessage.str());
-      }
-
-      // delete from terrain repository mapping.
-      try {
-        pos = voxelGrid.terrainGridRepository->getPositionOfEntt(entity);
-      } catch (const aetherion::InvalidEntityException &e) {
-        std::ostringstream ossMessage;
-        ossMessage << "[processPhysics:MovingComponent] Entity " << entityId
-                   << " not found in TerrainGridRepository: " << e.what()
-                   << " - skipping";
-        spdlog::get("console")->debug(ossMessage.str());
-        sink.enqueue<KillEntityEvent>(entity);
-        continue;
-      }
-      if (pos.x == -1 && pos.y == -1 && pos.z == -1) {
-        {
-          std::ostringstream ossMessage;
-          ossMessage << "[processPhysics:MovingComponent] Could not find "
-                        "position of entity "
-                     << entityId
-                     << " in TerrainGridRepository, skipping entity.";
-          spdlog::get("console")->debug(ossMessage.str());
-        }
-        continue;
-      }
+void PhysicsEngine::completeMovementForEntity(entt::entity entity,
+                                              entt::registry &registry,
+                                              VoxelGrid &voxelGrid,
+                                              EventSink &sink) {
+  // SAFETY CHECK: Validate entity before processing
+  // Note: handleMovingTo also validates, but checking here prevents
+  // unnecessary calls
+  if (!registry.valid(entity)) {
+    // Entity is invalid but was still scheduled — skip defensively;
+    // tracking-map cleanup happens at the explicit remove site
+    // (moveTerrain / deleteTerrain).
+    spdlog::get("console")->debug(
+        "[processPhysics:MovingComponent] WARNING: Invalid entity in "
+        "movement schedule - skipping; entity ID={}",
+        static_cast<int>(entity));
+    return;
+  }
 
-      {
-        // std::ostringstream ossMessage;
-        // ossMessage << "[processPhysics:MovingComponent] Found position of
-        // entity " << entityId
-        //           << " in TerrainGridRepository at (" << pos.x << ", " <<
-        //           pos.y << ", "
-        //           << pos.z
-        //           << ") - checking if vapor terrain needs revival";
-        // spdlog::get("console")->debug(ossMessage.str());
-      }
+  // SAFETY CHECK: Ensure entity has Position component
+  Position pos;
+  bool isTerrain = false;
+  int entityId = static_cast<int>(entity);
+  if (!registry.all_of<Position>(entity)) {
+    spdlog::get("console")->debug(
+        "[processPhysics:MovingComponent] WARNING: Entity {} has Velocity but "
+        "no Position - skipping",
+        entityId);
 
-      // Check if this is vapor terrain that needs to be revived
-      EntityTypeComponent terrainType =
-          voxelGrid.terrainGridRepository->getTerrainEntityType(pos.x, pos.y,
-                                                                pos.z);
-      int vaporMatter =
-          voxelGrid.terrainGridRepository->getVaporMatter(pos.x, pos.y, pos.z);
+    // delete from terrain repository mapping.
+    try {
+      pos = voxelGrid.terrainGridRepository->getPositionOfEntt(entity);
+    } catch (const aetherion::InvalidEntityException &e) {
+      spdlog::get("console")->debug(
+          "[processPhysics:MovingComponent] Entity {} not found in "
+          "TerrainGridRepository: {} - skipping",
+          entityId, e.what());
+      sink.enqueue<KillEntityEvent>(entity);
+      return;
+    }
+    if (pos.x == -1 && pos.y == -1 && pos.z == -1) {
+      spdlog::get("console")->debug(
+          "[processPhysics:MovingComponent] Could not find position of entity "
+          "{} in TerrainGridRepository, skipping entity.",
+          entityId);
+      return;
+    }
 
-      bool isTerrain =
-          terrainType.mainType == static_cast<int>(EntityEnum::TERRAIN);
+    // Check if this is vapor terrain that needs to be revived
+    EntityTypeComponent terrainType =
+        voxelGrid.terrainGridRepository->getTerrainEntityType(pos.x, pos.y,
+                                                              pos.z);
+    int vaporMatter =
+        voxelGrid.terrainGridRepository->getVaporMatter(pos.x, pos.y, pos.z);
 
-      if (terrainType.mainType == static_cast<int>(EntityEnum::TERRAIN) &&
-          vaporMatter > 0) {
-        {
-          std::ostringstream ossMessage;
-          ossMessage << "[processPhysics:MovingComponent] Reviving cold vapor "
-                        "terrain at ("
-                     << pos.x << ", " << pos.y << ", " << pos.z
-                     << ") with vapor matter: " << vaporMatter;
-          spdlog::get("console")->debug(ossMessage.str());
-        }
+    if (terrainType.mainType == static_cast<int>(EntityEnum::TERRAIN) &&
+        vaporMatter > 0) {
+      spdlog::get("console")->debug(
+          "[processPhysics:MovingComponent] Reviving cold vapor terrain at "
+          "({}, {}, {}) with vapor matter: {}",
+          pos.x, pos.y, pos.z, vaporMatter);
 
-        // Revive the terrain by ensuring it's active in ECS
-        entity = _ensureEntityActive(voxelGrid, pos.x, pos.y, pos.z);
+      // Revive the terrain by ensuring it's active in ECS
+      entity = _ensureEntityActive(voxelGrid, pos.x, pos.y, pos.z);
 
-        {
-          std::ostringstream ossMessage;
-          ossMessage << "[processPhysics:MovingComponent] Revived vapor "
-                        "terrain as entity "
-                     << static_cast<int>(entity)
-                     << " - will continue processing";
-          spdlog::get("console")->debug(ossMessage.str());
-        }
+      spdlog::get("console")->debug(
+          "[processPhysics:MovingComponent] Revived vapor terrain as entity "
+          "{} - will continue processing",
+          static_cast<int>(entity));
 
-        // Get the position from the newly revived entity
-        pos = registry.get<Position>(entity);
-      } else {
-        {
-          std::ostringstream ossMessage;
-          ossMessage
-              << "[processPhysics:MovingComponent] Not vapor terrain (mainType="
-              << terrainType.mainType << ", vapor=" << vaporMatter
-              << ") - skipping";
-          spdlog::get("console")->debug(ossMessage.str());
-        }
-        continue;
-      }
-    } else {
-      // std::cout << "[processPhysics] Entity " << static_cast<int>(entity)
-      //           << " has Velocity and Position - proceeding" << std::endl;
+      // Get the position from the newly revived entity
       pos = registry.get<Position>(entity);
+    } else {
+      spdlog::get("console")->debug(
+          "[processPhysics:MovingComponent] Not vapor terrain (mainType={}, "
+          "vapor={}) - skipping",
+          terrainType.mainType, vaporMatter);
+      return;
     }
+  } else {
+    pos = registry.get<Position>(entity);
+  }
 
-    if (!registry.valid(entity)) {
-      // std::cout << "[processPhysics] WARNING: Invalid entity in
-      // movingComponentView - "
-      //              "skipping; Entity ID="
-      //           << static_cast<int>(entity) << std::endl;
-      _destroyEntity(registry, sink, voxelGrid, entity);
-      continue;
-    }
-
-    handleMovingTo(registry, voxelGrid, entity, isTerrain);
+  if (!registry.valid(entity)) {
+    _destroyEntity(registry, sink, voxelGrid, entity);
+    return;
   }
+
+  handleMovingTo(registry, voxelGrid, entity, isTerrain);
 }
 
 void PhysicsEngine::processPhysicsAsync(entt::registry &registry,
@@ -1121,6 +1126,7 @@ void PhysicsEngine::processPhysicsAsync(entt::registry &registry,
   ZoneScopedN("PhysicsEngine::processPhysicsAsync");
 #endif
   std::scoped_lock lock(physicsMutex); // Ensure exclusive access
+  aetherion::diag::ScopedTimer passTimer(counters_.process_physics_async_ns);
 
   processingComplete = false;
 
@@ -1136,9 +1142,31 @@ void PhysicsEngine::applyGravityForcesToECSEntities(entt::registry &registry,
 
   // spdlog::get("console")->debug("Processing physics Async");
 
+  // Wake sleepers whose voxel or support changed since the last pass. The
+  // drain happens before any support is read below, so a change that lands
+  // during this pass is either seen by the read or drained next pass.
+  supportChanges_.clear();
+  std::size_t woken = 0;
+  if (voxelGrid.supportChanges.drain(supportChanges_)) {
+    woken = gravitySleep_.wakeAll();
+  } else {
+    for (const VoxelCoord &changed : supportChanges_) {
+      woken += gravitySleep_.wakeAround(changed);
+    }
+  }
+  woken += gravitySleep_.wakeRepositioned();
+  counters_.gravity_wakeups.inc(woken);
+
+  std::size_t awake = 0;
   for (auto entity : position_view) {
+    if (gravitySleep_.asleep(entity)) {
+      continue;
+    }
+    ++awake;
     applyGravityForceToEntity(entity, registry, voxelGrid, sink);
   }
+  counters_.gravity_awake.set(static_cast<double>(awake));
+  counters_.gravity_asleep.set(static_cast<double>(gravitySleep_.size()));
 }
 
 void PhysicsEngine::applyGravityForceToEntity(entt::entity entity,
@@ -1174,10 +1202,15 @@ void PhysicsEngine::applyGravityForceToEntity(entt::entity entity,
       // Guard: Don't enqueue movement event if entity is already moving
       // This prevents feedback loops where MoveSolidEntityEvent cascades
       bool isAlreadyMoving = registry.all_of<MovingComponent>(entity);
-      if (!isAlreadyMoving &&
-          checkIfCanFall(registry, voxelGrid, pos.x, pos.y, pos.z)) {
-        float gravity = PhysicsManager::Instance()->getGravity();
-        sink.enqueue<MoveSolidEntityEvent>(entity, 0, 0, -gravity);
+      if (!isAlreadyMoving) {
+        if (checkIfCanFall(registry, voxelGrid, pos.x, pos.y, pos.z)) {
+          float gravity = PhysicsManager::Instance()->getGravity();
+          sink.enqueue<MoveSolidEntityEvent>(entity, 0, 0, -gravity);
+        } else {
+          // Resting: nothing to do until this voxel or the one below it
+          // changes.
+          gravitySleep_.sleep(entity, VoxelCoord{pos.x, pos.y, pos.z});
+        }
       }
     } else if (isTerrain) {
       EntityTypeComponent type =
@@ -1207,6 +1240,9 @@ void PhysicsEngine::applyGravityForceToEntity(entt::entity entity,
           sink.enqueue<MoveSolidLiquidTerrainEvent>(entity, 0, 0, -gravity);
         }
       } else {
+        if (!isAlreadyMoving) {
+          gravitySleep_.sleep(entity, VoxelCoord{pos.x, pos.y, pos.z});
+        }
         spdlog::get("console")->debug(
             "Not enqueuing MoveSolidEntityEvent for terrain entity {} at "
             "position ({}, {}, {}), entity type.mainType: {} , "
@@ -1455,7 +1491,11 @@ void PhysicsEngine::processVelocityForVoxel(int x, int y, int z, float vx,
 
     auto [newVz, willStopZ] = resolveVerticalMotion(
         registry, voxelGrid, pos, vel.vz, ms, entt::null, entt::null);
-    bool belowStable = checkBelowStability(registry, voxelGrid, pos);
+    const TerrainStencil moveStencil =
+        voxelGrid.terrainGridRepository->getStencil(x, y, z,
+                                                    kMovementStencilFields);
+    bool belowStable =
+        checkBelowStability(registry, voxelGrid, pos, &moveStencil);
     auto [newVx, newVy, willStopX, willStopY] =
         applyKineticFrictionDamping(vel.vx, vel.vy, ms, belowStable, newVz);
 
@@ -1469,11 +1509,12 @@ void PhysicsEngine::processVelocityForVoxel(int x, int y, int z, float vx,
     voxelGrid.terrainGridRepository->setVelocity(x, y, z, vel);
 
     // Trigger movement if velocity warrants it
-    auto [toX, toY, toZ, completionTime] = calculateMovementDestination(
-        registry, voxelGrid, pos, vel, ps, vel.vx, vel.vy, vel.vz);
+    auto [toX, toY, toZ, completionTime] =
+        calculateMovementDestination(registry, voxelGrid, pos, vel, ps, vel.vx,
+                                     vel.vy, vel.vz, &moveStencil);
 
     bool collision = hasCollision(registry, voxelGrid, entt::null, x, y, z, toX,
-                                  toY, toZ, true);
+                                  toY, toZ, true, &moveStencil);
 
     if (!collision && completionTime < calculateTimeToMove(ps.minSpeed)) {
       if (!voxelGrid.terrainGridRepository->hasMovingComponent(x, y, z)) {
@@ -24,6 +24,8 @@
 #include "components/PlantsComponents.hpp"
 #include "components/TerrainComponents.hpp"
 #include "diag/Diag.hpp"
+#include "physics/GravitySleep.hpp"
+#include "physics/MovementSchedule.hpp"
 #include "physics/PhysicsEvents.hpp"
 #include "physics/PhysicsManager.hpp"
 #include "voxelgrid/VoxelGrid.hpp"
@@ -56,7 +58,14 @@ public:
 
   PhysicsEngine() = default;
   PhysicsEngine(entt::registry &reg, EventSink &sinkRef, VoxelGrid *voxelGrid)
-      : registry(reg), sink(sinkRef), voxelGrid(voxelGrid) {}
+      : registry(reg), sink(sinkRef), voxelGrid(voxelGrid) {
+    movementSchedule_.connect(registry);
+    gravitySleep_.connect(registry);
+  }
+  ~PhysicsEngine() {
+    gravitySleep_.disconnect(registry);
+    movementSchedule_.disconnect(registry);
+  }
 
   // Method to process physics-related events
   void processPhysics(entt::registry &registry, VoxelGrid &voxelGrid,
@@ -70,7 +79,9 @@ public:
   // scan) stay clearly separated.
 
   // Gravity-force enqueue for ECS-backed entities. Outer iterates
-  // `registry.view<Position>()`; inner is the per-entity decision tree.
+  // `registry.view<Position>()`, skipping entities in `gravitySleep_` after
+  // waking the ones whose voxel or support changed; inner is the
+  // per-entity decision tree, which puts resting entities to sleep.
   void applyGravityForcesToECSEntities(entt::registry &registry,
                                        VoxelGrid &voxelGrid, EventSink &sink);
   void applyGravityForceToEntity(entt::entity entity, entt::registry &registry,
@@ -95,6 +106,21 @@ public:
                                float vz, entt::registry &registry,
                                VoxelGrid &voxelGrid);
 
+  // Movement completion. `processMovementCompletions` advances the
+  // MovementSchedule one tick and runs `completeMovementForEntity` (vapor
+  // revival + `handleMovingTo`) only for the moves that finish on it.
+  void processMovementCompletions(entt::registry &registry,
+                                  VoxelGrid &voxelGrid, EventSink &sink);
+  void completeMovementForEntity(entt::entity entity, entt::registry &registry,
+                                 VoxelGrid &voxelGrid, EventSink &sink);
+
+  // In-flight moves by completion tick. Perception and PyRegistry refresh
+  // MovingComponent::timeRemaining from it, since the registry copy is no
+  // longer counted down.
+  const MovementSchedule &movementSchedule() const {
+    return movementSchedule_;
+  }
+
   // Example: Applying force to an entity
   // void applyForce(entt::registry& registry, VoxelGrid& voxelGrid,
   // entt::entity entity, float fx, float fy, float fz);
@@ -155,6 +181,14 @@ public:
     aetherion::diag::Counter delete_or_convert_terrain;
     aetherion::diag::Counter invalid_terrain_found;
     aetherion::diag::Counter plant_water_uptake;
+    // Gravity pass populations (checked vs. asleep) and sleepers woken by
+    // support changes.
+    aetherion::diag::Gauge gravity_awake;
+    aetherion::diag::Gauge gravity_asleep;
+    aetherion::diag::Counter gravity_wakeups;
+    // Wall time of one processPhysics() / processPhysicsAsync() pass.
+    aetherion::diag::Histogram process_physics_ns;
+    aetherion::diag::Histogram process_physics_async_ns;
   };
   PhysicsCounters counters_;
 
@@ -162,6 +196,9 @@ private:
   entt::registry &registry;
   EventSink &sink; // routes enqueue by thread (main → direct, other → staging)
   VoxelGrid *voxelGrid = nullptr;
+  MovementSchedule movementSchedule_;
+  GravitySleep gravitySleep_;
+  std::vector<VoxelCoord> supportChanges_; // drain buffer, reused per pass
 
   // Mutex for thread safety
   bool processingComplete = true; // Flag to indicate processing state
@@ -0,0 +1,225 @@
+#ifndef PY_COMPONENT_ARRAYS_HPP
+#define PY_COMPONENT_ARRAYS_HPP
+
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <entt/entt.hpp>
+
+#include "components/EntityTypeComponent.hpp"
+#include "components/HealthComponents.hpp"
+#include "components/MetabolismComponents.hpp"
+#include "components/MovingComponent.hpp"
+#include "components/PerceptionComponent.hpp"
+#include "components/PhysicsComponents.hpp"
+#include "components/WaterStressComponent.hpp"
+
+namespace nb = nanobind;
+
+// NumPy views over the EnTT pools of plain-data components, so Python
+// systems can work on every entity of a component at once instead of one
+// get_component/set_component call per entity.
+//
+// A pool is stored in pages of component_traits<C>::page_size (1024)
+// components, so each page becomes one structured array (field names as in
+// the Python bindings) that points straight into the registry; writes to
+// it are writes to the components. Next to it goes a copy of the matching
+// entity ids. The arrays are only valid until components of that type are
+// added or removed (for MetabolismComponent, DigestionComponents too: the
+// metabolism group keeps the two pools in step), so take them inside a
+// system's update() and drop them before returning.
+//
+// Writes fire no registry signals, so components other systems index are
+// exported read-only: EntityTypeComponent (World's type index), Position
+// (entityGrid, the spatial index, gravity sleepers) and MovingComponent
+// (the movement schedule). Change those with set_component.
+
+struct NumpyField {
+  const char *name;
+  const char *format; // NumPy type string
+  std::size_t offset;
+  std::size_t size; // sizeof the member, checked against `format`
+};
+
+template <typename Component> struct NumpyLayout;
+
+// Components whose arrays Python may only read.
+template <typename Component> inline constexpr bool kNumpyReadOnly = false;
+template <> inline constexpr bool kNumpyReadOnly<EntityTypeComponent> = true;
+template <> inline constexpr bool kNumpyReadOnly<Position> = true;
+template <> inline constexpr bool kNumpyReadOnly<MovingComponent> = true;
+
+#define AETHERION_NUMPY_FIELD(type, member, name, format)                      \
+  NumpyField { name, format, offsetof(type, member), sizeof(type::member) }
+
+template <> struct NumpyLayout<EntityTypeComponent> {
+  static constexpr std::array<NumpyField, 3> fields = {
+      AETHERION_NUMPY_FIELD(EntityTypeComponent, mainType, "main_type", "<i4"),
+      AETHERION_NUMPY_FIELD(EntityTypeComponent, subType0, "sub_type0", "<i4"),
+      AETHERION_NUMPY_FIELD(EntityTypeComponent, subType1, "sub_type1",
+                            "<i4")};
+};
+
+template <> struct NumpyLayout<Position> {
+  static constexpr std::array<NumpyField, 4> fields = {
+      AETHERION_NUMPY_FIELD(Position, x, "x", "<i4"),
+      AETHERION_NUMPY_FIELD(Position, y, "y", "<i4"),
+      AETHERION_NUMPY_FIELD(Position, z, "z", "<i4"),
+      AETHERION_NUMPY_FIELD(Position, direction, "direction", "<i4")};
+};
+
+template <> struct NumpyLayout<Velocity> {
+  static constexpr std::array<NumpyField, 3> fields = {
+      AETHERION_NUMPY_FIELD(Velocity, vx, "vx", "<f4"),
+      AETHERION_NUMPY_FIELD(Velocity, vy, "vy", "<f4"),
+      AETHERION_NUMPY_FIELD(Velocity, vz, "vz", "<f4")};
+};
+
+template <> struct NumpyLayout<MovingComponent> {
+  static constexpr std::array<NumpyField, 16> fields = {
+      AETHERION_NUMPY_FIELD(MovingComponent, isMoving, "is_moving", "?"),
+      AETHERION_NUMPY_FIELD(MovingComponent, movingFromX, "moving_from_x",
+                            "<i4"),
+      AETHERION_NUMPY_FIELD(MovingComponent, movingFromY, "moving_from_y",
+                            "<i4"),
+      AETHERION_NUMPY_FIELD(MovingComponent, movingFromZ, "moving_from_z",
+                            "<i4"),
+      AETHERION_NUMPY_FIELD(MovingComponent, movingToX, "moving_to_x", "<i4"),
+      AETHERION_NUMPY_FIELD(MovingComponent, movingToY, "moving_to_y", "<i4"),
+      AETHERION_NUMPY_FIELD(MovingComponent, movingToZ, "moving_to_z", "<i4"),
+      AETHERION_NUMPY_FIELD(MovingComponent, vx, "vx", "<f4"),
+      AETHERION_NUMPY_FIELD(MovingComponent, vy, "vy", "<f4"),
+      AETHERION_NUMPY_FIELD(MovingComponent, vz, "vz", "<f4"),
+      AETHERION_NUMPY_FIELD(MovingComponent, willStopX, "will_stop_x", "?"),
+      AETHERION_NUMPY_FIELD(MovingComponent, willStopY, "will_stop_y", "?"),
+      AETHERION_NUMPY_FIELD(MovingComponent, willStopZ, "will_stop_z", "?"),
+      AETHERION_NUMPY_FIELD(MovingComponent, completionTime, "completion_time",
+                            "<i4"),
+      AETHERION_NUMPY_FIELD(MovingComponent, timeRemaining, "time_remaining",
+                            "<i4"),
+      AETHERION_NUMPY_FIELD(MovingComponent, direction, "direction", "<i4")};
+};
+
+template <> struct NumpyLayout<PhysicsStats> {
+  static constexpr std::array<NumpyField, 7> fields = {
+      AETHERION_NUMPY_FIELD(PhysicsStats, mass, "mass", "<f4"),
+      AETHERION_NUMPY_FIELD(PhysicsStats, maxSpeed, "max_speed", "<f4"),
+      AETHERION_NUMPY_FIELD(PhysicsStats, minSpeed, "min_speed", "<f4"),
+      AETHERION_NUMPY_FIELD(PhysicsStats, forceX, "force_x", "<f4"),
+      AETHERION_NUMPY_FIELD(PhysicsStats, forceY, "force_y", "<f4"),
+      AETHERION_NUMPY_FIELD(PhysicsStats, forceZ, "force_z", "<f4"),
+      AETHERION_NUMPY_FIELD(PhysicsStats, heat, "heat", "<f4")};
+};
+
+template <> struct NumpyLayout<HealthComponent> {
+  static constexpr std::array<NumpyField, 2> fields = {
+      AETHERION_NUMPY_FIELD(HealthComponent, healthLevel, "health_level",
+                            "<f4"),
+      AETHERION_NUMPY_FIELD(HealthComponent, maxHealth, "max_health", "<f4")};
+};
+
+template <> struct NumpyLayout<PerceptionComponent> {
+  static constexpr std::array<NumpyField, 2> fields = {
+      AETHERION_NUMPY_FIELD(PerceptionComponent, perception_area,
+                            "perception_area", "<i4"),
+      AETHERION_NUMPY_FIELD(PerceptionComponent, z_perception_area,
+                            "z_perception_area", "<i4")};
+};
+
+template <> struct NumpyLayout<MetabolismComponent> {
+  static constexpr std::array<NumpyField, 2> fields = {
+      AETHERION_NUMPY_FIELD(MetabolismComponent, energyReserve,
+                            "energy_reserve", "<f4"),
+      AETHERION_NUMPY_FIELD(MetabolismComponent, maxEnergyReserve,
+                            "max_energy_reserve", "<f4")};
+};
+
+template <> struct NumpyLayout<WaterStressComponent> {
+  static constexpr std::array<NumpyField, 1> fields = {
+      AETHERION_NUMPY_FIELD(WaterStressComponent, water_stress_ticks,
+                            "water_stress_ticks", "<i4")};
+};
+
+#undef AETHERION_NUMPY_FIELD
+
+// Bytes a NumPy type string reads: "<i4"/"<f4" take 4, "?" takes 1.
+constexpr std::size_t numpyFormatSize(const char *format) {
+  return format[0] == '?' ? 1 : static_cast<std::size_t>(format[2] - '0');
+}
+
+// Every field's type string must cover exactly its member. Enums such as
+// Position::direction have an implementation-defined size.
+template <typename Component> constexpr bool numpyLayoutMatches() {
+  for (const NumpyField &field : NumpyLayout<Component>::fields) {
+    if (numpyFormatSize(field.format) != field.size) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Structured dtype with the exact C++ layout of Component, padding
+// included.
+template <typename Component> nb::object numpyComponentDtype() {
+  static_assert(std::is_trivially_copyable_v<Component> &&
+                std::is_standard_layout_v<Component>);
+  static_assert(numpyLayoutMatches<Component>(),
+                "NumPy field format does not match the member size");
+  nb::list names, formats, offsets;
+  for (const NumpyField &field : NumpyLayout<Component>::fields) {
+    names.append(field.name);
+    formats.append(field.format);
+    offsets.append(field.offset);
+  }
+  nb::dict spec;
+  spec["names"] = names;
+  spec["formats"] = formats;
+  spec["offsets"] = offsets;
+  spec["itemsize"] = sizeof(Component);
+  return nb::module_::import_("numpy").attr("dtype")(spec);
+}
+
+// [(entity_ids, components), ...], one pair per page of the pool. `owner`
+// is kept alive by every components array.
+template <typename Component>
+nb::list numpyComponentArrays(entt::registry &registry, nb::handle owner) {
+  static_assert(sizeof(entt::entity) == sizeof(int32_t));
+  // NumPy marks arrays over const data non-writable, views included.
+  using Byte = std::conditional_t<kNumpyReadOnly<Component>, const uint8_t,
+                                  uint8_t>;
+  auto &storage = registry.storage<Component>();
+  const std::size_t count = storage.size();
+  const std::size_t page = entt::component_traits<Component>::page_size;
+  nb::list pages;
+  if (count == 0) {
+    return pages;
+  }
+
+  int32_t *ids = new int32_t[count];
+  for (std::size_t i = 0; i < count; ++i) {
+    ids[i] = static_cast<int32_t>(entt::to_integral(storage.data()[i]));
+  }
+  nb::capsule idsOwner(ids, [](void *p) noexcept {
+    delete[] static_cast<int32_t *>(p);
+  });
+
+  const nb::object dtype = numpyComponentDtype<Component>();
+  for (std::size_t begin = 0; begin < count; begin += page) {
+    const std::size_t n = std::min(page, count - begin);
+    auto *bytes = reinterpret_cast<Byte *>(storage.raw()[begin / page]);
+    nb::object raw = nb::cast(nb::ndarray<nb::numpy, Byte, nb::ndim<1>>(
+        bytes, {n * sizeof(Component)}, owner));
+    pages.append(nb::make_tuple(
+        nb::ndarray<nb::numpy, int32_t, nb::ndim<1>>(ids + begin, {n},
+                                                     idsOwner),
+        raw.attr("view")(dtype)));
+  }
+  return pages;
+}
+
+#endif // PY_COMPONENT_ARRAYS_HPP
@@ -4,16 +4,19 @@
 #include <nanobind/nanobind.h>
 
 #include <entt/entt.hpp>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "PyComponentArrays.hpp"
 #include "components/HealthComponents.hpp"
 #include "components/ItemsComponents.hpp"
 #include "components/MetabolismComponents.hpp"
 #include "components/MovingComponent.hpp"
 #include "components/PhysicsComponents.hpp"
 #include "components/WaterStressComponent.hpp"
+#include "physics/MovementSchedule.hpp"
 
 namespace nb = nanobind;
 using namespace entt::literals;
@@ -32,6 +35,12 @@ public:
   PyRegistry(PyRegistry &&) = delete;
   PyRegistry &operator=(PyRegistry &&) = delete;
 
+  // Source of MovingComponent::timeRemaining for Python reads; the registry
+  // copy is not counted down (see MovementSchedule). Set by World.
+  void setMovementSchedule(const MovementSchedule *schedule) {
+    movementSchedule = schedule;
+  }
+
   // Entity management
   int create_entity() {
     auto entity = registry.create();
@@ -175,8 +184,12 @@ public:
     }
     if (component_name == "MovingComponent") {
       MovingComponent *comp = get<MovingComponent>(entity);
-      if (comp)
+      if (comp) {
+        if (movementSchedule) {
+          movementSchedule->refreshTimeRemaining(entity, *comp);
+        }
         return nb::cast(*comp);
+      }
     }
     if (component_name == "Inventory") {
       Inventory *comp = get<Inventory>(entity);
@@ -365,6 +378,48 @@ public:
     }
   }
 
+  // Zero-copy NumPy views of a plain-data component pool; see
+  // PyComponentArrays.hpp.
+  nb::list component_arrays(const std::string &component_name) {
+    nb::handle self = nb::find(this);
+    if (component_name == "EntityTypeComponent") {
+      return numpyComponentArrays<EntityTypeComponent>(registry, self);
+    }
+    if (component_name == "Position") {
+      return numpyComponentArrays<Position>(registry, self);
+    }
+    if (component_name == "Velocity") {
+      return numpyComponentArrays<Velocity>(registry, self);
+    }
+    if (component_name == "MovingComponent") {
+      // The views alias the pool, so time_remaining is as of this call.
+      if (movementSchedule) {
+        for (auto [entity, moving] :
+             registry.view<MovingComponent>().each()) {
+          movementSchedule->refreshTimeRemaining(entity, moving);
+        }
+      }
+      return numpyComponentArrays<MovingComponent>(registry, self);
+    }
+    if (component_name == "PhysicsStats") {
+      return numpyComponentArrays<PhysicsStats>(registry, self);
+    }
+    if (component_name == "HealthComponent") {
+      return numpyComponentArrays<HealthComponent>(registry, self);
+    }
+    if (component_name == "PerceptionComponent") {
+      return numpyComponentArrays<PerceptionComponent>(registry, self);
+    }
+    if (component_name == "MetabolismComponent") {
+      return numpyComponentArrays<MetabolismComponent>(registry, self);
+    }
+    if (component_name == "WaterStressComponent") {
+      return numpyComponentArrays<WaterStressComponent>(registry, self);
+    }
+    throw std::invalid_argument("No NumPy layout for component " +
+                                component_name);
+  }
+
   bool is_valid(uint32_t entity_id) {
     entt::entity entity = entt::entity{entity_id};
     return registry.valid(entity);
@@ -373,6 +428,7 @@ public:
 private:
   entt::registry &registry;
   entt::dispatcher &dispatcher;
+  const MovementSchedule *movementSchedule = nullptr;
 
   // Helper to convert entities to a Python list
   template <typename View> nb::list entities_to_pylist(View view) {
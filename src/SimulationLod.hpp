@@ -0,0 +1,274 @@
+#ifndef SIMULATION_LOD_HPP
+#define SIMULATION_LOD_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "terrain/VoxelCoord.hpp"
+
+// Simulation level of detail: systems only run every tick where someone is
+// watching. The map is cut into square columns of `regionSize` voxels (all
+// of z) and each region gets a level from its Chebyshev distance, in
+// regions, to the nearest observer (perceiving entities plus the points
+// World::set_lod_observers gives it):
+//   Near  within nearRegions        every tick
+//   Mid   within midRegions         every midInterval ticks
+//   Far   everything else           every farInterval ticks
+// Regions of one level are spread over the interval so the far work does
+// not all land on the same tick.
+//
+// beginTick() runs on the main thread at the top of World::update and
+// publishes an immutable SimulationLodMap for that tick; systems, including
+// the async water workers, read it through snapshot(). ticksDue() is 0 when
+// a position is skipped this tick, otherwise the ticks since its region
+// last ran, which the system catches up on (accumulated dt).
+//
+// Metabolism and plants catch up fully. Water boxes catch up on
+// evaporation heat, but their water still moves at most one voxel per run.
+// The velocity passes in PhysicsEngine ignore LOD and run every tick:
+// catching up there would move an entity several voxels in one step, with
+// a collision check at each.
+//
+// Disabled by default: snapshot() is null then and every system runs its
+// full per-tick update.
+
+enum class LodLevel : uint8_t { Near = 0, Mid = 1, Far = 2 };
+constexpr std::size_t kLodLevels = 3;
+
+struct SimulationLodConfig {
+  int regionSize = 16;
+  int nearRegions = 2;
+  int midRegions = 6;
+  int midInterval = 4;
+  int farInterval = 16;
+};
+
+// Per-level updates done and skipped by the systems on one tick.
+struct LodTally {
+  std::array<uint64_t, kLodLevels> updated{};
+  std::array<uint64_t, kLodLevels> skipped{};
+
+  void add(LodLevel level, bool due) {
+    (due ? updated : skipped)[static_cast<std::size_t>(level)] += 1;
+  }
+};
+
+// What a region does this tick.
+struct LodCell {
+  uint16_t ticksDue = 1; // 0: skipped, else ticks since it last ran
+  LodLevel level = LodLevel::Near;
+};
+
+struct SimulationLodStats {
+  uint64_t tick = 0;
+  std::array<uint64_t, kLodLevels> regions{};
+  std::array<uint64_t, kLodLevels> updated{};
+  std::array<uint64_t, kLodLevels> skipped{};
+};
+
+class SimulationLodMap {
+public:
+  const LodCell &at(int x, int y) const { return cells_[regionOf(x, y)]; }
+  LodLevel level(int x, int y) const { return at(x, y).level; }
+  int ticksDue(int x, int y) const { return at(x, y).ticksDue; }
+
+  int interval(LodLevel level) const {
+    return intervals_[static_cast<std::size_t>(level)];
+  }
+
+  // Nearest level over the columns of [minX, maxX] x [minY, maxY].
+  LodLevel nearestLevel(int minX, int minY, int maxX, int maxY) const {
+    const std::size_t first = regionOf(minX, minY);
+    const std::size_t last = regionOf(maxX, maxY);
+    const int x0 = static_cast<int>(first % regionsX_);
+    const int x1 = static_cast<int>(last % regionsX_);
+    LodLevel nearest = LodLevel::Far;
+    for (std::size_t row = first - x0; row <= last - x1; row += regionsX_) {
+      for (int rx = x0; rx <= x1; ++rx) {
+        nearest = std::min(nearest, cells_[row + rx].level);
+      }
+    }
+    return nearest;
+  }
+
+  // Adds a system's tally for this tick. Thread-safe.
+  void record(const LodTally &tally) const {
+    for (std::size_t l = 0; l < kLodLevels; ++l) {
+      updated_[l].fetch_add(tally.updated[l], std::memory_order_relaxed);
+      skipped_[l].fetch_add(tally.skipped[l], std::memory_order_relaxed);
+    }
+  }
+
+private:
+  friend class SimulationLod;
+
+  std::size_t regionOf(int x, int y) const {
+    const int rx = std::clamp(x / regionSize_, 0, regionsX_ - 1);
+    const int ry = std::clamp(y / regionSize_, 0, regionsY_ - 1);
+    return static_cast<std::size_t>(ry) * regionsX_ + rx;
+  }
+
+  int regionSize_ = 1;
+  int regionsX_ = 1;
+  int regionsY_ = 1;
+  std::array<int, kLodLevels> intervals_{1, 1, 1};
+  std::vector<LodCell> cells_;
+  uint64_t tick_ = 0;
+  mutable std::array<std::atomic<uint64_t>, kLodLevels> updated_{};
+  mutable std::array<std::atomic<uint64_t>, kLodLevels> skipped_{};
+};
+
+class SimulationLod {
+public:
+  // Sizes the region grid for a width x height map and enables LOD.
+  void configure(int width, int height, const SimulationLodConfig &config) {
+    config_ = config;
+    config_.regionSize = std::max(1, config_.regionSize);
+    config_.nearRegions = std::max(0, config_.nearRegions);
+    config_.midRegions = std::max(config_.nearRegions, config_.midRegions);
+    config_.midInterval = std::max(1, config_.midInterval);
+    config_.farInterval = std::max(config_.midInterval, config_.farInterval);
+    regionsX_ = std::max(1, (width + config_.regionSize - 1) /
+                                config_.regionSize);
+    regionsY_ = std::max(1, (height + config_.regionSize - 1) /
+                                config_.regionSize);
+    lastRun_.assign(static_cast<std::size_t>(regionsX_) * regionsY_, tick_);
+    enabled_ = true;
+  }
+
+  void disable() {
+    enabled_ = false;
+    std::scoped_lock lock(mapMutex_);
+    map_.reset();
+  }
+
+  bool enabled() const { return enabled_; }
+  const SimulationLodConfig &config() const { return config_; }
+
+  // Levels the regions from `observers` and publishes this tick's map.
+  // Returns the stats of the tick before, now that its systems are done.
+  SimulationLodStats beginTick(const std::vector<VoxelCoord> &observers) {
+    SimulationLodStats previous = statsOf(snapshot());
+    if (!enabled_) {
+      return previous;
+    }
+    ++tick_;
+
+    auto map = std::make_shared<SimulationLodMap>();
+    map->regionSize_ = config_.regionSize;
+    map->regionsX_ = regionsX_;
+    map->regionsY_ = regionsY_;
+    map->intervals_ = {1, config_.midInterval, config_.farInterval};
+    map->tick_ = tick_;
+
+    const std::vector<int> distance = observerDistances(observers);
+    map->cells_.resize(distance.size());
+    for (std::size_t r = 0; r < distance.size(); ++r) {
+      const LodLevel level = distance[r] <= config_.nearRegions ? LodLevel::Near
+                             : distance[r] <= config_.midRegions
+                                 ? LodLevel::Mid
+                                 : LodLevel::Far;
+      LodCell &cell = map->cells_[r];
+      cell.level = level;
+      const uint64_t interval = map->interval(level);
+      // Staggered so a level's regions do not all run on the same tick.
+      if ((tick_ + r * 7) % interval != 0) {
+        cell.ticksDue = 0;
+        continue;
+      }
+      cell.ticksDue = static_cast<uint16_t>(
+          std::min<uint64_t>(tick_ - lastRun_[r], UINT16_MAX));
+      lastRun_[r] = tick_;
+    }
+
+    std::scoped_lock lock(mapMutex_);
+    map_ = std::move(map);
+    return previous;
+  }
+
+  // This tick's map, or null while LOD is disabled.
+  std::shared_ptr<const SimulationLodMap> snapshot() const {
+    std::scoped_lock lock(mapMutex_);
+    return map_;
+  }
+
+private:
+  static SimulationLodStats
+  statsOf(const std::shared_ptr<const SimulationLodMap> &map) {
+    SimulationLodStats stats;
+    if (!map) {
+      return stats;
+    }
+    stats.tick = map->tick_;
+    for (const LodCell &cell : map->cells_) {
+      ++stats.regions[static_cast<std::size_t>(cell.level)];
+    }
+    for (std::size_t l = 0; l < kLodLevels; ++l) {
+      stats.updated[l] = map->updated_[l].load(std::memory_order_relaxed);
+      stats.skipped[l] = map->skipped_[l].load(std::memory_order_relaxed);
+    }
+    return stats;
+  }
+
+  // Chebyshev distance, in regions, from every region to the nearest
+  // observer: a breadth-first search over the 8-connected region grid.
+  std::vector<int> observerDistances(const std::vector<VoxelCoord> &observers) {
+    const std::size_t count = static_cast<std::size_t>(regionsX_) * regionsY_;
+    const int unreached = config_.midRegions + 1;
+    std::vector<int> distance(count, unreached);
+    std::deque<std::size_t> frontier;
+    for (const VoxelCoord &o : observers) {
+      const int rx = std::clamp(o.x / config_.regionSize, 0, regionsX_ - 1);
+      const int ry = std::clamp(o.y / config_.regionSize, 0, regionsY_ - 1);
+      const std::size_t r = static_cast<std::size_t>(ry) * regionsX_ + rx;
+      if (distance[r] != 0) {
+        distance[r] = 0;
+        frontier.push_back(r);
+      }
+    }
+    // Anything past midRegions is Far, so the search stops there.
+    while (!frontier.empty()) {
+      const std::size_t r = frontier.front();
+      frontier.pop_front();
+      const int next = distance[r] + 1;
+      if (next >= unreached) {
+        continue;
+      }
+      const int rx = static_cast<int>(r % regionsX_);
+      const int ry = static_cast<int>(r / regionsX_);
+      for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+          const int nx = rx + dx, ny = ry + dy;
+          if (nx < 0 || ny < 0 || nx >= regionsX_ || ny >= regionsY_) {
+            continue;
+          }
+          const std::size_t n = static_cast<std::size_t>(ny) * regionsX_ + nx;
+          if (distance[n] > next) {
+            distance[n] = next;
+            frontier.push_back(n);
+          }
+        }
+      }
+    }
+    return distance;
+  }
+
+  SimulationLodConfig config_;
+  bool enabled_ = false;
+  int regionsX_ = 1;
+  int regionsY_ = 1;
+  uint64_t tick_ = 0;
+  std::vector<uint64_t> lastRun_; // tick each region last ran
+
+  mutable std::mutex mapMutex_;
+  std::shared_ptr<const SimulationLodMap> map_;
+};
+
+#endif // SIMULATION_LOD_HPP
@@ -77,6 +77,20 @@ void WavePhysicsEngine::emitWave(VoxelGrid &grid, int x, int y, int z,
     return;
   }
 
+  if (mode_ == WavePropagationMode::FIELD) {
+    const std::size_t i = fieldIndex(wave.type);
+    const VoxelCoord &extent = fields_[i].extent();
+    if (extent.x != grid.width || extent.y != grid.height ||
+        extent.z != grid.depth) {
+      fields_[i].resize(grid.width, grid.height, grid.depth);
+      emissions_[i].clear();
+    }
+    fields_[i].inject(x, y, z, wave.amplitude);
+    emissions_[i].push_back(FieldEmission{wave.sourceId, wave.frequency, x, y,
+                                          z, 0, wave.lifetimeTicks});
+    return;
+  }
+
   uint64_t key = coordToKey(x, y, z);
   activeWaves[key].push_back(wave);
 }
@@ -335,7 +349,132 @@ void WavePhysicsEngine::processWaves(entt::registry &registry, VoxelGrid &grid,
   processEmitters(registry, grid);
 
   // Then propagate existing waves
-  propagateWaves(registry, grid, dispatcher, dtTicks);
+  if (mode_ == WavePropagationMode::FIELD) {
+    advanceFields(registry, dispatcher);
+  } else {
+    propagateWaves(registry, grid, dispatcher, dtTicks);
+  }
+}
+
+void WavePhysicsEngine::setPropagationMode(WavePropagationMode mode) {
+  if (mode == mode_) {
+    return;
+  }
+  mode_ = mode;
+  activeWaves.clear();
+  for (std::size_t i = 0; i < fields_.size(); ++i) {
+    fields_[i].clear();
+    emissions_[i].clear();
+  }
+}
+
+const WavePhysicsEngine::FieldEmission *
+WavePhysicsEngine::attributeEmission(WaveType type, int x, int y,
+                                     int z) const {
+  // The field does not remember who made which ripple. Credit the emission
+  // whose front (speed * age from its origin) is closest to this voxel.
+  const float speed = fieldSettings_[fieldIndex(type)].speed;
+  const FieldEmission *best = nullptr;
+  float bestError = 0.0f;
+  for (const FieldEmission &e : emissions_[fieldIndex(type)]) {
+    const float dx = float(x - e.x);
+    const float dy = float(y - e.y);
+    const float dz = float(z - e.z);
+    const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+    const float error = std::fabs(distance - speed * float(e.ageTicks));
+    if (!best || error < bestError) {
+      best = &e;
+      bestError = error;
+    }
+  }
+  return best;
+}
+
+void WavePhysicsEngine::advanceFields(entt::registry &registry,
+                                      entt::dispatcher &dispatcher) {
+  bool anyActive = false;
+  for (std::size_t i = 0; i < fields_.size(); ++i) {
+    const WaveFieldSettings &settings = fieldSettings_[i];
+    fields_[i].advance(settings.speed, settings.damping, settings.threshold);
+
+    // Emissions past their lifetime are no longer credited; once the field
+    // has died out there is nothing left to credit them for.
+    auto &emissions = emissions_[i];
+    if (fields_[i].activeTiles() == 0) {
+      emissions.clear();
+      continue;
+    }
+    for (FieldEmission &e : emissions) {
+      ++e.ageTicks;
+    }
+    emissions.erase(std::remove_if(emissions.begin(), emissions.end(),
+                                   [](const FieldEmission &e) {
+                                     return e.ageTicks > e.lifetimeTicks;
+                                   }),
+                    emissions.end());
+    anyActive = anyActive || !emissions.empty();
+  }
+  if (!anyActive) {
+    return;
+  }
+
+  // Receivers sample both fields once per tick instead of being scanned
+  // for every wave position.
+  registry.view<WaveReceiverComponent, Position>().each(
+      [&](auto entity, auto &receiver, auto &pos) {
+        for (WaveType type : {WaveType::SOUND, WaveType::IMPACT}) {
+          const float amplitude = std::fabs(
+              fields_[fieldIndex(type)].sample(pos.x, pos.y, pos.z));
+          if (amplitude < receiver.hearingThreshold) {
+            continue;
+          }
+          if (const FieldEmission *e =
+                  attributeEmission(type, pos.x, pos.y, pos.z)) {
+            dispatcher.enqueue<SoundHeardEvent>(entity, e->sourceId, type,
+                                                e->frequency, amplitude);
+          }
+        }
+      });
+
+  const WaveField &impacts = fields_[fieldIndex(WaveType::IMPACT)];
+  if (emissions_[fieldIndex(WaveType::IMPACT)].empty()) {
+    return;
+  }
+  const float threshold =
+      fieldSettings_[fieldIndex(WaveType::IMPACT)].threshold;
+  registry.view<Velocity, Position>().each(
+      [&](auto entity, auto &velocity, auto &pos) {
+        const float amplitude =
+            std::fabs(impacts.sample(pos.x, pos.y, pos.z));
+        if (amplitude <= threshold) {
+          return;
+        }
+        const FieldEmission *e =
+            attributeEmission(WaveType::IMPACT, pos.x, pos.y, pos.z);
+        if (!e) {
+          return;
+        }
+
+        // Push away from where the impact was emitted
+        float dx = float(pos.x - e->x);
+        float dy = float(pos.y - e->y);
+        float dz = float(pos.z - e->z);
+        float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (distance < 1e-6f)
+          return;
+        dx /= distance;
+        dy /= distance;
+        dz /= distance;
+
+        float impulseMagnitude =
+            amplitude * 0.1f; // Same scale as applyPhysicsImpulse
+        velocity.vx += dx * impulseMagnitude;
+        velocity.vy += dy * impulseMagnitude;
+        velocity.vz += dz * impulseMagnitude;
+        dispatcher.enqueue<WaveImpactEvent>(
+            entity, e->sourceId, dx * impulseMagnitude, dy * impulseMagnitude,
+            dz * impulseMagnitude, amplitude);
+      });
 }
 
 void WavePhysicsEngine::registerEventHandlers(entt::dispatcher &dispatcher) {
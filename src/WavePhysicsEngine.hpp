@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "components/PhysicsComponents.hpp"
+#include "physics/WaveField.hpp"
 #include "voxelgrid/VoxelGrid.hpp"
 
 // Forward declarations
@@ -19,6 +20,21 @@ enum class WaveType {
   IMPACT // Impulse waves that stop when colliding with other impact waves
 };
 
+// How waves travel through the grid.
+enum class WavePropagationMode {
+  PACKET, // per-voxel wave packets, re-emitted into each neighbour per tick
+  FIELD   // one amplitude field per wave type, advanced by a stencil
+};
+
+// FIELD-mode propagation for one wave type. A field carries every wave of
+// its type at once, so speed and attenuation are set here rather than per
+// emitter; the emitter's amplitude, frequency and lifetime still apply.
+struct WaveFieldSettings {
+  float speed = 1.0f;       // voxels per tick
+  float damping = 0.05f;    // fraction of amplitude lost per voxel travelled
+  float threshold = 0.001f; // amplitude below which the field is dropped
+};
+
 // WaveComponent: represents a propagating wave packet through the voxel grid
 struct WaveComponent {
   int32_t sourceId;         // entity that emitted the wave
@@ -111,7 +127,43 @@ public:
   // Register event handlers
   void registerEventHandlers(entt::dispatcher &dispatcher);
 
+  // Switching modes drops every wave in flight.
+  void setPropagationMode(WavePropagationMode mode);
+  WavePropagationMode getPropagationMode() const { return mode_; }
+
+  void setFieldSettings(WaveType type, const WaveFieldSettings &settings) {
+    fieldSettings_[fieldIndex(type)] = settings;
+  }
+  const WaveFieldSettings &getFieldSettings(WaveType type) const {
+    return fieldSettings_[fieldIndex(type)];
+  }
+
 private:
+  // A wave injected into a field, kept so receivers can be told who made
+  // what they hear. Dropped once it outlives its lifetime.
+  struct FieldEmission {
+    int32_t sourceId;
+    float frequency;
+    int x, y, z;
+    uint32_t ageTicks;
+    uint32_t lifetimeTicks;
+  };
+
+  static std::size_t fieldIndex(WaveType type) {
+    return type == WaveType::SOUND ? 0 : 1;
+  }
+
+  WavePropagationMode mode_ = WavePropagationMode::PACKET;
+  std::array<WaveField, 2> fields_;
+  std::array<WaveFieldSettings, 2> fieldSettings_;
+  std::array<std::vector<FieldEmission>, 2> emissions_;
+
+  // FIELD mode: advance both fields one tick and sample them at receivers
+  // and movable entities.
+  void advanceFields(entt::registry &registry, entt::dispatcher &dispatcher);
+  const FieldEmission *attributeEmission(WaveType type, int x, int y,
+                                         int z) const;
+
   // Wave storage: coordinate hash -> vector of waves at that position
   std::unordered_map<uint64_t, std::vector<WaveComponent>> activeWaves;
 
@@ -2,6 +2,10 @@
 
 #include "physics/PhysicsManager.hpp"
 
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/tuple.h>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
 // #include <pybind11/stl.h>
 #include <sys/types.h>
 #include <sys/wait.h>
@@ -14,8 +18,10 @@
 #include <execution>
 #include <future>
 #include <iostream>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "PerceptionResponse_generated.h"
@@ -26,6 +32,7 @@
 #include "ecosystem/EcosystemEvents.hpp"
 #include "flatbuffers/flatbuffers.h"
 #include "physics/PhysicsMutators.hpp"
+#include "terrain/VoxelCoord.hpp"
 #include "voxelgrid/VoxelGrid.hpp"
 
 #ifdef TRACY_ENABLE
@@ -39,7 +46,8 @@ World::World(int width, int height, int depth)
       // Update to use just SQLite file path parameter
       dbHandler(std::make_unique<GameDBHandler>("./data/game.sqlite")),
       physicsEngine(new PhysicsEngine(registry, eventSink_, voxelGrid)),
-      lifeEngine(new LifeEngine(registry, eventSink_, voxelGrid)),
+      lifeEngine(
+          new LifeEngine(registry, eventSink_, voxelGrid, ecsCommands_)),
       ecosystemEngine(new EcosystemEngine()),
       metabolismSystem(new MetabolismSystem(registry, voxelGrid)),
       combatSystem(new CombatSystem(registry, voxelGrid)),
@@ -54,6 +62,14 @@ World::World(int width, int height, int depth)
   voxelGrid->width = width;
   voxelGrid->height = height;
   voxelGrid->depth = depth;
+  // Pre-allocate the terrain regions so region-locked writers never have to
+  // grow the trees' upper levels.
+  voxelGrid->terrainGridRepository->reserveRegions(width, height, depth);
+
+  entityTypeIndex_.connect(registry);
+  pyRegistry.setMovementSchedule(&physicsEngine->movementSchedule());
+  voxelGrid->terrainGridRepository->setMovementSchedule(
+      &physicsEngine->movementSchedule());
 
   // Initialise the diag registry against this World's GameDB before any
   // engine constructor registers a Counter / Gauge / EventLogger.
@@ -65,6 +81,40 @@ World::World(int width, int height, int depth)
 
   // Register diag counters owned by each engine.
   physicsEngine->registerDiagCounters();
+  ecosystemEngine->waterSimManager_->registerDiagCounters();
+  {
+    using namespace aetherion::diag;
+    auto makeTimer = [](const std::string &name) {
+      HistogramConfig cfg;
+      cfg.name = name;
+      cfg.flush_every = std::chrono::seconds{1};
+      cfg.sinks = {GameDBSink{}};
+      return Registry::instance().histogram(cfg);
+    };
+    perceptionResponseNs_ = makeTimer("world_perception_response_ns");
+    dispatcherUpdateNs_ = makeTimer("world_dispatcher_update_ns");
+  }
+  // Simulation LOD: creatures, plants, voxels and water boxes the systems
+  // looked at per level, and how many of them they skipped.
+  {
+    using namespace aetherion::diag;
+    const char *names[kLodLevels] = {"lod_near_population",
+                                     "lod_mid_population",
+                                     "lod_far_population"};
+    for (std::size_t l = 0; l < kLodLevels; ++l) {
+      GaugeConfig cfg;
+      cfg.name = names[l];
+      cfg.unit = "updates";
+      cfg.flush_every = std::chrono::seconds{1};
+      cfg.sinks = {GameDBSink{}};
+      lodPopulation_[l] = Registry::instance().gauge(cfg);
+    }
+    CounterConfig cfg;
+    cfg.name = "lod_skipped_updates";
+    cfg.flush_every = std::chrono::seconds{1};
+    cfg.sinks = {GameDBSink{}};
+    lodSkippedUpdates_ = Registry::instance().counter(cfg);
+  }
 
   // Register event handlers
   physicsEngine->registerEventHandlers(dispatcher);
@@ -73,6 +123,8 @@ World::World(int width, int height, int depth)
   ecosystemEngine->registerEventHandlers(dispatcher);
   ecosystemEngine->waterSimManager_->initializeProcessors(registry, *voxelGrid,
                                                           eventSink_);
+  ecosystemEngine->setSimulationLod(&simulationLod_);
+  metabolismSystem->setSimulationLod(&simulationLod_);
 
   if (!Py_IsInitialized()) {
     std::cout << "Python was not initialized! Starting python interpreter."
@@ -99,6 +151,13 @@ World::~World() {
                                "non-std::exception during shutdown");
   }
 
+  // Drain and join the diag GameDB writer while `dbHandler` is alive;
+  // it holds a raw pointer to the handler. Only this World's writer: a
+  // World created since owns the Registry now.
+  aetherion::diag::Registry::instance().detach_gamedb(dbHandler.get());
+
+  entityTypeIndex_.disconnect(registry);
+
   releasePythonState();    // Drop Python refs before any other member runs
   delete voxelGrid;        // Clean up the VoxelGrid
   delete physicsEngine;    // Clean up the physics engine
@@ -460,68 +519,310 @@ entt::entity World::createEntityFromPython(nb::object pyEntity) {
                      // -Wcovered-switch
 }
 
+namespace {
+
+template <typename T>
+using TerrainColumnArray = nb::ndarray<const T, nb::c_contig, nb::device::cpu>;
+
+// The NumPy columns of a bulk terrain load. Arrays that had to be converted
+// (dtype or layout) are owned here, so this outlives the load.
+struct TerrainColumnArrays {
+  TerrainVoxelColumns columns;
+  std::vector<TerrainColumnArray<int32_t>> ints;
+  std::optional<TerrainColumnArray<int64_t>> terrainId;
+  std::optional<TerrainColumnArray<float>> heat;
+};
+
+template <typename Array>
+void checkTerrainColumnShape(const Array &array, const std::string &name,
+                             const std::vector<std::size_t> &shape) {
+  bool same = array.ndim() == shape.size();
+  for (std::size_t d = 0; same && d < shape.size(); ++d) {
+    same = array.shape(d) == shape[d];
+  }
+  if (!same) {
+    throw std::invalid_argument("Terrain column " + name +
+                                " does not match the shape of the load");
+  }
+}
+
+TerrainColumnArrays readTerrainColumns(nb::dict columns,
+                                       const std::vector<std::size_t> &shape) {
+  static const std::pair<const char *, const int32_t *TerrainVoxelColumns::*>
+      kIntColumns[] = {
+          {"main_type", &TerrainVoxelColumns::mainType},
+          {"sub_type0", &TerrainVoxelColumns::subType0},
+          {"sub_type1", &TerrainVoxelColumns::subType1},
+          {"terrain_matter", &TerrainVoxelColumns::terrainMatter},
+          {"water_matter", &TerrainVoxelColumns::waterMatter},
+          {"vapor_matter", &TerrainVoxelColumns::vaporMatter},
+          {"biomass_matter", &TerrainVoxelColumns::biomassMatter},
+          {"mass", &TerrainVoxelColumns::mass},
+          {"max_speed", &TerrainVoxelColumns::maxSpeed},
+          {"min_speed", &TerrainVoxelColumns::minSpeed},
+          {"flags", &TerrainVoxelColumns::flags},
+          {"max_load_capacity", &TerrainVoxelColumns::maxLoadCapacity}};
+
+  TerrainColumnArrays out;
+  out.ints.reserve(std::size(kIntColumns));
+  for (auto [key, value] : columns) {
+    const std::string name = nb::str(key).c_str();
+    if (name == "terrain_id") {
+      out.terrainId = nb::cast<TerrainColumnArray<int64_t>>(value);
+      checkTerrainColumnShape(*out.terrainId, name, shape);
+      out.columns.terrainId = out.terrainId->data();
+      continue;
+    }
+    if (name == "heat") {
+      out.heat = nb::cast<TerrainColumnArray<float>>(value);
+      checkTerrainColumnShape(*out.heat, name, shape);
+      out.columns.heat = out.heat->data();
+      continue;
+    }
+    auto it = std::find_if(std::begin(kIntColumns), std::end(kIntColumns),
+                           [&](const auto &c) { return name == c.first; });
+    if (it == std::end(kIntColumns)) {
+      throw std::invalid_argument("Unknown terrain column " + name);
+    }
+    out.ints.push_back(nb::cast<TerrainColumnArray<int32_t>>(value));
+    checkTerrainColumnShape(out.ints.back(), name, shape);
+    out.columns.*(it->second) = out.ints.back().data();
+  }
+  return out;
+}
+
+// A voxel of a bulk load that carries an Inventory, and its column row.
+struct HybridTerrainVoxel {
+  VoxelCoord coord;
+  std::size_t row;
+  Inventory inventory;
+};
+
+constexpr std::size_t kNoRow = static_cast<std::size_t>(-1);
+
+std::vector<HybridTerrainVoxel> readTerrainInventories(nb::object inventories) {
+  std::vector<HybridTerrainVoxel> voxels;
+  if (inventories.is_none()) {
+    return voxels;
+  }
+  for (auto [key, value] : nb::cast<nb::dict>(inventories)) {
+    const auto [x, y, z] = nb::cast<std::tuple<int, int, int>>(key);
+    voxels.push_back({{x, y, z}, kNoRow, nb::cast<Inventory>(value)});
+  }
+  return voxels;
+}
+
+// Hybrid terrain for the inventory voxels of a finished bulk load: the
+// entity gets the same components createHybridTerrainFromPython emplaces
+// for terrain, the grids already hold the terrain-state, and the terrain
+// id becomes the entity.
+nb::list createBulkHybridTerrain(entt::registry &registry,
+                                 TerrainGridRepository &repo,
+                                 std::vector<HybridTerrainVoxel> &voxels,
+                                 const TerrainVoxelColumns &columns) {
+  nb::list ids;
+  for (HybridTerrainVoxel &voxel : voxels) {
+    const std::size_t i = voxel.row;
+    auto at = [i](const int32_t *column) { return column ? column[i] : 0; };
+    const auto [x, y, z] = voxel.coord;
+
+    const entt::entity entity = registry.create();
+    registry.emplace<EntityTypeComponent>(
+        entity, EntityTypeComponent{at(columns.mainType),
+                                    at(columns.subType0),
+                                    at(columns.subType1)});
+    registry.emplace<Position>(entity,
+                               Position{x, y, z, repo.getDirection(x, y, z)});
+    registry.emplace<MatterContainer>(
+        entity,
+        MatterContainer{at(columns.terrainMatter), at(columns.vaporMatter),
+                        at(columns.waterMatter), at(columns.biomassMatter)});
+    const float heat = columns.heat ? columns.heat[i] : 0.0f;
+    registry.emplace<PhysicsStats>(
+        entity, PhysicsStats{static_cast<float>(at(columns.mass)),
+                             static_cast<float>(at(columns.maxSpeed)),
+                             static_cast<float>(at(columns.minSpeed)), 0.0f,
+                             0.0f, 0.0f, heat});
+    registry.emplace<Inventory>(entity, std::move(voxel.inventory));
+    repo.setTerrainId(x, y, z, static_cast<int>(entity));
+    ids.append(static_cast<int>(entity));
+  }
+  return ids;
+}
+
+void checkHybridTerrainRows(const std::vector<HybridTerrainVoxel> &voxels,
+                            const TerrainVoxelColumns &columns) {
+  for (const HybridTerrainVoxel &voxel : voxels) {
+    if (voxel.row == kNoRow ||
+        (columns.terrainId &&
+         columns.terrainId[voxel.row] ==
+             static_cast<int64_t>(TerrainIdTypeEnum::NONE))) {
+      throw std::invalid_argument(
+          "Inventory at (" + std::to_string(voxel.coord.x) + ", " +
+          std::to_string(voxel.coord.y) + ", " +
+          std::to_string(voxel.coord.z) + ") is not on loaded terrain");
+    }
+  }
+}
+
+} // namespace
+
+nb::list World::loadTerrainBox(std::tuple<int, int, int> origin,
+                               nb::dict columns, nb::object inventories) {
+  if (!columns.contains("main_type")) {
+    throw std::invalid_argument("Terrain box needs a main_type column");
+  }
+  const auto mainType =
+      nb::cast<TerrainColumnArray<int32_t>>(columns["main_type"]);
+  if (mainType.ndim() != 3) {
+    throw std::invalid_argument(
+        "Terrain box columns are (depth, height, width) arrays");
+  }
+  const std::vector<std::size_t> shape{mainType.shape(0), mainType.shape(1),
+                                       mainType.shape(2)};
+  const int depth = static_cast<int>(shape[0]);
+  const int height = static_cast<int>(shape[1]);
+  const int width = static_cast<int>(shape[2]);
+  const auto [x0, y0, z0] = origin;
+
+  TerrainColumnArrays arrays = readTerrainColumns(columns, shape);
+  std::vector<HybridTerrainVoxel> hybrids = readTerrainInventories(inventories);
+  for (HybridTerrainVoxel &voxel : hybrids) {
+    const auto [x, y, z] = voxel.coord;
+    if (x >= x0 && y >= y0 && z >= z0 && x < x0 + width &&
+        y < y0 + height && z < z0 + depth) {
+      voxel.row = (static_cast<std::size_t>(z - z0) * height + (y - y0)) *
+                      width +
+                  (x - x0);
+    }
+  }
+  checkHybridTerrainRows(hybrids, arrays.columns);
+
+  auto &repo = *voxelGrid->terrainGridRepository;
+  {
+    nb::gil_scoped_release gil;
+    repo.loadTerrainBox(x0, y0, z0, width, height, depth, arrays.columns);
+  }
+  return createBulkHybridTerrain(registry, repo, hybrids, arrays.columns);
+}
+
+nb::list World::loadTerrainPoints(nb::object coords, nb::dict columns,
+                                  nb::object inventories) {
+  const auto xyz = nb::cast<TerrainColumnArray<int32_t>>(coords);
+  if (xyz.ndim() != 2 || xyz.shape(1) != 3) {
+    throw std::invalid_argument("Terrain coords are an (N, 3) array");
+  }
+  const std::size_t count = xyz.shape(0);
+
+  TerrainColumnArrays arrays = readTerrainColumns(columns, {count});
+  std::vector<HybridTerrainVoxel> hybrids = readTerrainInventories(inventories);
+  if (!hybrids.empty()) {
+    // Rows of the inventory voxels; a repeated point keeps its last row,
+    // as in the load itself.
+    std::unordered_map<VoxelCoord, std::size_t, VoxelCoordHash> rows;
+    for (const HybridTerrainVoxel &voxel : hybrids) {
+      rows.emplace(voxel.coord, kNoRow);
+    }
+    const int32_t *p = xyz.data();
+    for (std::size_t i = 0; i < count; ++i, p += 3) {
+      if (auto it = rows.find({p[0], p[1], p[2]}); it != rows.end()) {
+        it->second = i;
+      }
+    }
+    for (HybridTerrainVoxel &voxel : hybrids) {
+      voxel.row = rows[voxel.coord];
+    }
+  }
+  checkHybridTerrainRows(hybrids, arrays.columns);
+
+  auto &repo = *voxelGrid->terrainGridRepository;
+  {
+    nb::gil_scoped_release gil;
+    repo.loadTerrainPoints(xyz.data(), count, arrays.columns);
+  }
+  return createBulkHybridTerrain(registry, repo, hybrids, arrays.columns);
+}
+
 // Get entities based on their type
 nb::dict World::getEntitiesByType(int entityMainType, int entitySubType0) {
   // Acquire shared lock to prevent entity destruction during entity queries
   std::shared_lock lifecycleLock(entityLifecycleMutex);
 
   nb::dict entitiesMetadata;
-
-  // Iterate through all entities that have the EntityTypeComponent
-  auto view = registry.view<EntityTypeComponent>();
-  for (auto entity : view) {
-    // Retrieve the entity type component
-    EntityTypeComponent *entityTypeComp =
-        registry.try_get<EntityTypeComponent>(entity);
-
-    // If the entity's type matches the input type
-    if (entityTypeComp && entityTypeComp->mainType == entityMainType &&
-        entityTypeComp->subType0 == entitySubType0) {
-      // Retrieve additional entity components, such as position or other
-      // metadata
-      EntityInterface entityInterface = createEntityInterface(registry, entity);
-
-      // Store the entity interface in the dictionary with the entity ID as the
-      // key
-      entitiesMetadata[nb::int_(static_cast<int>(entity))] =
-          nb::cast(entityInterface);
-    }
+  for (auto entity :
+       entityTypeIndex_.entities(entityMainType, entitySubType0)) {
+    entitiesMetadata[nb::int_(static_cast<int>(entity))] =
+        nb::cast(createEntityInterface(registry, entity));
   }
-
   return entitiesMetadata;
 }
 
-// Get entity IDs based on their type
+// Get IDs of the entities of a type that can perceive
 nb::list World::getEntityIdsByType(int entityMainType, int entitySubType0) {
   // Acquire shared lock to prevent entity destruction during entity ID queries
   std::shared_lock lifecycleLock(entityLifecycleMutex);
 
   nb::list entityIds;
-
-  // Iterate through all entities that have the EntityTypeComponent
-  auto view = registry.view<EntityTypeComponent, PerceptionComponent>();
-  for (auto entity : view) {
-    // Retrieve the entity type component
-    EntityTypeComponent *entityTypeComp =
-        registry.try_get<EntityTypeComponent>(entity);
-    PerceptionComponent *perceptionComp =
-        registry.try_get<PerceptionComponent>(entity);
-
-    // If the entity's type matches the input type
-    if (entityTypeComp && perceptionComp &&
-        entityTypeComp->mainType == entityMainType &&
-        entityTypeComp->subType0 == entitySubType0) {
-      // Add the entity ID to the list
+  for (auto entity :
+       entityTypeIndex_.entities(entityMainType, entitySubType0)) {
+    if (registry.all_of<PerceptionComponent>(entity)) {
       entityIds.append(nb::int_(static_cast<int>(entity)));
     }
   }
-
   return entityIds;
 }
 
-nb::dict World::createPerceptionResponses(nb::dict entitiesWithQueries) {
+namespace {
+
+// `count` ids copied into an int32 NumPy array that owns its buffer;
+// idAt(i) gives the i-th.
+template <typename IdAt>
+nb::object makeIdArray(std::size_t count, IdAt &&idAt) {
+  int32_t *ids = new int32_t[std::max<std::size_t>(count, 1)];
+  for (std::size_t i = 0; i < count; ++i) {
+    ids[i] = static_cast<int32_t>(idAt(i));
+  }
+  nb::capsule owner(ids, [](void *p) noexcept {
+    delete[] static_cast<int32_t *>(p);
+  });
+  return nb::cast(
+      nb::ndarray<nb::numpy, int32_t, nb::ndim<1>>(ids, {count}, owner));
+}
+
+} // namespace
+
+nb::object World::getEntityIdArrayByType(int entityMainType,
+                                         int entitySubType0) {
+  std::shared_lock lifecycleLock(entityLifecycleMutex);
+
+  const entt::sparse_set &entities =
+      entityTypeIndex_.entities(entityMainType, entitySubType0);
+  return makeIdArray(entities.size(), [&](std::size_t i) {
+    return entt::to_integral(entities.data()[i]);
+  });
+}
+
+nb::object World::getEntityIdsInRadius(int x, int y, int z, float radius) {
+  std::shared_lock lifecycleLock(entityLifecycleMutex);
+
+  const std::vector<int> ids =
+      voxelGrid->getEntityIdsInRadius(x, y, z, radius);
+  return makeIdArray(ids.size(), [&](std::size_t i) { return ids[i]; });
+}
+
+nb::object World::getNearestEntityIds(int x, int y, int z, int k,
+                                      float maxRadius) {
+  std::shared_lock lifecycleLock(entityLifecycleMutex);
+
+  const std::vector<int> ids = voxelGrid->getNearestEntityIds(
+      x, y, z, static_cast<std::size_t>(std::max(k, 0)), maxRadius);
+  return makeIdArray(ids.size(), [&](std::size_t i) { return ids[i]; });
+}
+
+std::vector<std::vector<char>>
+World::buildPerceptionResponses(nb::dict entitiesWithQueries,
+                                std::vector<int> &entityIds) {
   const size_t BATCH_NUMBER = 16;
-  nb::dict perceptionResponses;
 
   // Acquire shared lock to prevent entity destruction during perception
   // creation
@@ -556,15 +857,19 @@ nb::dict World::createPerceptionResponses(nb::dict entitiesWithQueries) {
   } // GIL is released automatically here when gil_scoped_acquire goes out of
     // scope
 
-  // Per-batch output slots. Pre-allocated so each task_group lambda
+  entityIds.resize(jobs.size());
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    entityIds[i] = jobs[i].entityId;
+  }
+
+  // One output slot per job, pre-allocated so each task_group lambda
   // writes to a disjoint index — no mutex, no future<vector>. After
-  // `asyncTasks_.wait()` returns, every slot is populated and we
-  // assemble the final `nb::dict` on the main thread under the GIL.
-  using BatchResult = std::vector<std::pair<int, std::vector<char>>>;
-  std::vector<BatchResult> batchResults(BATCH_NUMBER);
+  // `perceptionTasks.wait()` returns, every slot is populated and the
+  // caller assembles its result on the main thread.
+  std::vector<std::vector<char>> responses(jobs.size());
 
   // Compute the actual number of batches based on jobs.size() — empty
-  // tail batches stay default-constructed and are cheap to skip below.
+  // tail batches are skipped below.
   const size_t numBatches = BATCH_NUMBER;
   const size_t batchSize =
       jobs.empty() ? 0 : (jobs.size() + numBatches - 1) / numBatches;
@@ -594,28 +899,21 @@ nb::dict World::createPerceptionResponses(nb::dict entitiesWithQueries) {
       }
       const size_t end = std::min(start + batchSize, jobs.size());
 
-      perceptionTasks.run(
-          [this, start, end, batchIndex, &jobs, &batchResults]() {
-            BatchResult &out = batchResults[batchIndex];
-            out.reserve(end - start);
-
-            for (size_t i = start; i < end; ++i) {
-              auto &job = jobs[i];
-              std::vector<char> serializedResponse;
-
-              try {
-                serializedResponse =
-                    createPerceptionResponseC(job.entityId, job.commands);
-              } catch (const std::exception &e) {
-                Logger::getLogger()->error(
-                    "Failed to create perception response for entity " +
-                    std::to_string(job.entityId) + ": " + e.what());
-                // leave serializedResponse empty for the caller to detect
-              }
-
-              out.emplace_back(job.entityId, std::move(serializedResponse));
-            }
-          });
+      perceptionTasks.run([this, start, end, &jobs, &responses]() {
+        for (size_t i = start; i < end; ++i) {
+          auto &job = jobs[i];
+
+          try {
+            responses[i] =
+                createPerceptionResponseC(job.entityId, job.commands);
+          } catch (const std::exception &e) {
+            Logger::getLogger()->error(
+                "Failed to create perception response for entity " +
+                std::to_string(job.entityId) + ": " + e.what());
+            // leave the response empty for the caller to detect
+          }
+        }
+      });
     }
 
     // Block (without the GIL) until every perception batch finishes.
@@ -626,20 +924,78 @@ nb::dict World::createPerceptionResponses(nb::dict entitiesWithQueries) {
     perceptionTasks.wait();
   }
 
+  return responses;
+}
+
+nb::dict World::createPerceptionResponses(nb::dict entitiesWithQueries) {
+  std::vector<int> entityIds;
+  std::vector<std::vector<char>> responses =
+      buildPerceptionResponses(entitiesWithQueries, entityIds);
+
   // Re-acquire GIL to populate `perceptionResponses` from the
-  // pre-allocated batch outputs.
-  {
-    nb::gil_scoped_acquire gil;
+  // per-job outputs.
+  nb::gil_scoped_acquire gil;
+  nb::dict perceptionResponses;
+  for (size_t i = 0; i < entityIds.size(); ++i) {
+    nb::bytes resp(responses[i].data(), responses[i].size());
+    perceptionResponses[nb::int_(entityIds[i])] = resp;
+  }
+  return perceptionResponses;
+}
 
-    for (auto &batch : batchResults) {
-      for (auto &[entityId, serializedResponse] : batch) {
-        nb::bytes resp(serializedResponse.data(), serializedResponse.size());
-        perceptionResponses[nb::int_(entityId)] = resp;
-      }
-    }
+nb::tuple
+World::createPerceptionResponsesPacked(nb::dict entitiesWithQueries) {
+  std::vector<int> entityIds;
+  std::vector<std::vector<char>> responses =
+      buildPerceptionResponses(entitiesWithQueries, entityIds);
+
+  const size_t count = entityIds.size();
+  auto ids = std::make_unique<int32_t[]>(std::max<size_t>(count, 1));
+  auto offsets = std::make_unique<int64_t[]>(count + 1);
+  offsets[0] = 0;
+  for (size_t i = 0; i < count; ++i) {
+    ids[i] = entityIds[i];
+    offsets[i + 1] = offsets[i] + static_cast<int64_t>(responses[i].size());
+  }
+  const size_t total = static_cast<size_t>(offsets[count]);
+  auto arena = std::make_unique_for_overwrite<uint8_t[]>(
+      std::max<size_t>(total, 1));
+  {
+    // The copies into the arena are disjoint, so they run on the TBB pool
+    // like the responses did.
+    nb::gil_scoped_release gil;
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, count),
+        [&](const tbb::blocked_range<size_t> &range) {
+          for (size_t i = range.begin(); i != range.end(); ++i) {
+            if (!responses[i].empty()) {
+              std::memcpy(arena.get() + offsets[i], responses[i].data(),
+                          responses[i].size());
+            }
+          }
+        });
   }
 
-  return perceptionResponses;
+  // The capsules own the buffers from here on.
+  nb::gil_scoped_acquire gil;
+  int32_t *idData = ids.release();
+  nb::capsule idsOwner(idData, [](void *p) noexcept {
+    delete[] static_cast<int32_t *>(p);
+  });
+  int64_t *offsetData = offsets.release();
+  nb::capsule offsetsOwner(offsetData, [](void *p) noexcept {
+    delete[] static_cast<int64_t *>(p);
+  });
+  uint8_t *arenaData = arena.release();
+  nb::capsule arenaOwner(arenaData, [](void *p) noexcept {
+    delete[] static_cast<uint8_t *>(p);
+  });
+  return nb::make_tuple(
+      nb::ndarray<nb::numpy, int32_t, nb::ndim<1>>(idData, {count}, idsOwner),
+      nb::ndarray<nb::numpy, int64_t, nb::ndim<1>>(offsetData, {count + 1},
+                                                   offsetsOwner),
+      nb::ndarray<nb::numpy, uint8_t, nb::ndim<1>>(arenaData, {total},
+                                                   arenaOwner));
 }
 
 EntityInterface World::getEntityById(int entityId) {
@@ -1175,6 +1531,45 @@ void World::runEcosystemStep() {
   }
 }
 
+void World::configureSimulationLod(bool enabled,
+                                  const SimulationLodConfig &config) {
+  if (enabled) {
+    simulationLod_.configure(width, height, config);
+  } else {
+    simulationLod_.disable();
+  }
+  lodStats_ = SimulationLodStats{};
+}
+
+void World::setLodObservers(std::vector<VoxelCoord> observers) {
+  lodObservers_ = std::move(observers);
+}
+
+void World::beginLodTick() {
+  if (!simulationLod_.enabled()) {
+    return;
+  }
+  std::vector<VoxelCoord> observers = lodObservers_;
+  auto perceivers = registry.view<PerceptionComponent, Position>();
+  for (auto entity : perceivers) {
+    const auto &pos = perceivers.get<Position>(entity);
+    observers.push_back(VoxelCoord{pos.x, pos.y, pos.z});
+  }
+
+  const SimulationLodStats last = simulationLod_.beginTick(observers);
+  if (last.tick == 0) {
+    return;
+  }
+  lodStats_ = last;
+  uint64_t skipped = 0;
+  for (std::size_t l = 0; l < kLodLevels; ++l) {
+    lodPopulation_[l].set(
+        static_cast<double>(last.updated[l] + last.skipped[l]));
+    skipped += last.skipped[l];
+  }
+  lodSkippedUpdates_.inc(skipped);
+}
+
 void World::update() {
 #ifdef TRACY_ENABLE
   ZoneScopedN("World::update");
@@ -1186,47 +1581,74 @@ void World::update() {
 
   std::lock_guard<std::mutex> lock(registryMutex);
 
-  healthSystem->processHealth(registry, *voxelGrid, dispatcher);
+  using aetherion::diag::TickPhase;
+  tickProfiler_.beginTick();
+  beginLodTick();
+
+  {
+    auto _phase = tickProfiler_.phase(TickPhase::Health);
+    healthSystem->processHealth(registry, *voxelGrid, dispatcher);
+  }
 
   // Walk the diag Registry and flush any counters whose `flush_every`
   // window has elapsed. Replaces the per-engine flush methods that used
   // to live in PhysicsEngine / LifeEngine. The Registry routes samples
   // to GameDB via the GameDBSink configured at registration time.
-  aetherion::diag::Registry::instance().tick();
+  {
+    auto _phase = tickProfiler_.phase(TickPhase::DiagTick);
+    aetherion::diag::Registry::instance().tick();
 
-  // Legacy LifeEngine flush — to be migrated in v2 (Task 14).
-  if (dbHandler) {
-    lifeEngine->flushLifeMetrics(dbHandler.get());
+    // Legacy LifeEngine flush — to be migrated in v2 (Task 14).
+    if (dbHandler) {
+      lifeEngine->flushLifeMetrics(dbHandler.get());
+    }
   }
 
   // Replay events staged by worker threads (ecosystem future, water-sim
   // pool, physics future) before the main thread dispatches. After this
   // point the dispatcher is single-threaded for the duration of update().
-  workerSink_.drain(dispatcher);
-
-  dispatcher.update();
+  {
+    auto _phase = tickProfiler_.phase(TickPhase::DispatcherUpdate);
+    workerSink_.drain(dispatcher);
+    aetherion::diag::ScopedTimer dispatchTimer(dispatcherUpdateNs_);
+    dispatcher.update();
+  }
 
-  physicsEngine->processPhysics(registry, *voxelGrid, eventSink_, gameClock);
+  {
+    auto _phase = tickProfiler_.phase(TickPhase::Physics);
+    physicsEngine->processPhysics(registry, *voxelGrid, eventSink_, gameClock);
+  }
 
   if (processMetabolism_) {
+    auto _phase = tickProfiler_.phase(TickPhase::Metabolism);
     metabolismSystem->processMetabolism(registry, *voxelGrid, dispatcher);
   }
 
-  ecosystemEngine->processEcosystem(registry, *voxelGrid, eventSink_,
-                                    gameClock);
+  {
+    auto _phase = tickProfiler_.phase(TickPhase::Ecosystem);
+    ecosystemEngine->processEcosystem(registry, *voxelGrid, eventSink_,
+                                      gameClock);
+  }
 
-  effectsSystem->processEffects(registry, *voxelGrid, dispatcher);
+  {
+    auto _phase = tickProfiler_.phase(TickPhase::Effects);
+    effectsSystem->processEffects(registry, *voxelGrid, dispatcher);
+  }
 
   // Acquire GIL before executing Python code
   nb::gil_scoped_acquire acquire;
   nb::object pyRegistryObj = nb::cast(&pyRegistry);
 
   // Update Python systems
-  for (auto &system : pythonSystems) {
-    try {
-      system.attr("update")(pyRegistryObj, voxelGrid);
-    } catch (const nb::cast_error &e) {
-      std::cerr << "Error in Python system update: " << e.what() << std::endl;
+  {
+    auto _phase = tickProfiler_.phase(TickPhase::PythonSystems);
+    for (auto &system : pythonSystems) {
+      try {
+        system.attr("update")(pyRegistryObj, voxelGrid);
+      } catch (const nb::cast_error &e) {
+        std::cerr << "Error in Python system update: " << e.what()
+                  << std::endl;
+      }
     }
   }
 
@@ -1247,28 +1669,38 @@ void World::update() {
   {
     static aetherion::diag::ThrottledLog _tickLog{std::chrono::seconds(1)};
     _tickLog.fire([&](spdlog::logger &log) {
-      log.info(
-          "[tick] toDelete={} toRemoveVel={} toRemoveMov={} asyncRunning={}",
-          lifeEngine->entitiesToDelete.size(),
-          lifeEngine->entitiesToRemoveVelocity.size(),
-          lifeEngine->entitiesToRemoveMovingComponent.size(),
-          anyAsyncTasksRunning);
+      log.info("[tick] toDelete={} commands={} asyncRunning={}",
+               lifeEngine->entitiesToDelete.size(), ecsCommands_.pending(),
+               anyAsyncTasksRunning);
     });
   }
 
+  // Deferred ECS commands get their own sync point: they are played back
+  // whenever no async task is running, but never hold back the dispatch
+  // below. Commands recorded while a task is in flight wait for the next
+  // tick that finds it finished.
+  if (ecsCommands_.pending() != 0 && !anyAsyncTasksRunning) {
+    auto _phase = tickProfiler_.phase(TickPhase::CommandPlayback);
+    playbackEcsCommands();
+  }
+
   // Only perform cleanup if we have cleanup work AND no async tasks are running
   if (hasAnyCleanup && !anyAsyncTasksRunning) {
     // SAFE to do cleanup - no async tasks are accessing the data
-    if (hasEntitiesToDelete) {
-      processEntityDeletion();
-    }
+    auto _phase = tickProfiler_.phase(TickPhase::EntityDeletion);
+    processEntityDeletion();
   }
 
   // Handle async task lifecycle - check for completed tasks and launch new ones
   // GUARDRAIL: Do not launch new async tasks if entities are waiting to be
-  // deleted This ensures we get a clean window where no async tasks are running
-  // so deletion can proceed
+  // deleted. This ensures we get a clean window where no async tasks are
+  // running so cleanup can proceed
   if (!hasEntitiesToDelete) {
+    // Task submission and runEcosystemStep (sync ecosystem runs included)
+    // are timed as their own phase; reopening Ecosystem here would stretch
+    // its trace span over everything that ran in between.
+    auto _phase = tickProfiler_.phase(TickPhase::AsyncDispatch);
+
     // Handle Physics Async Task. Skip if the previous task is still
     // in flight; otherwise drain any captured exception (logged here,
     // matching the old future.get() try/catch behaviour) and submit
@@ -1316,6 +1748,8 @@ void World::update() {
     // made it dead code. The metabolism path is sync-only now (serviced
     // by the call earlier in this method).
   }
+
+  tickProfiler_.endTick();
 }
 
 void World::putTimeSeries(const std::string &seriesName, long long timestamp,
@@ -1330,6 +1764,14 @@ World::queryTimeSeries(const std::string &seriesName, long long start,
   return dbHandler->queryTimeSeries(seriesName, start, end);
 }
 
+std::vector<TimeSeriesBucket>
+World::queryTimeSeriesDownsampled(const std::string &seriesName,
+                                  long long start, long long end,
+                                  size_t maxPoints) {
+  return dbHandler->queryTimeSeriesDownsampled(seriesName, start, end,
+                                               maxPoints);
+}
+
 void World::executeSQL(const std::string &sql) { dbHandler->executeSQL(sql); }
 
 size_t World::peekTimeSeriesSize(const std::string &seriesName) const {
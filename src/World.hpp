@@ -7,13 +7,16 @@
 #include <oneapi/tbb/task_group.h>
 #include <spdlog/spdlog.h>
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <entt/entt.hpp>
 #include <exception>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <tuple>
 
 // TracyLockable / TracySharedLockable visualize lock acquire / wait / release
 // on the Tracy timeline. When `TRACY_ENABLE` is undefined these macros
@@ -24,8 +27,10 @@
 
 #include "CombatSystem.hpp"
 #include "EcosystemEngine.hpp"
+#include "EcsCommandBuffer.hpp"
 #include "EffectsSystem.hpp"
 #include "EntityInterface.hpp"
+#include "EntityTypeIndex.hpp"
 #include "EventSink.hpp"
 #include "GameClock.hpp"
 #include "GameDBHandler.hpp"
@@ -37,7 +42,10 @@
 #include "PhysicsEngine.hpp"
 #include "PyRegistry.hpp"
 #include "QueryCommand.hpp"
+#include "SimulationLod.hpp"
 #include "WorldView.hpp"
+#include "diag/Diag.hpp"
+#include "diag/TickProfiler.hpp"
 #include "voxelgrid/VoxelGrid.hpp"
 
 namespace nb = nanobind;
@@ -58,6 +66,7 @@ public:
   entt::dispatcher dispatcher; // Event dispatcher
   WorkerEventSink workerSink_; // Cross-thread event staging buffer
   EventSink eventSink_; // Thread-routing view over dispatcher + workerSink_
+  EcsCommandQueue ecsCommands_; // Deferred registry edits, see playback
   VoxelGrid *voxelGrid; // Change to pointer type
   PyRegistry pyRegistry;
 
@@ -84,6 +93,18 @@ public:
   // Three-path dispatcher (plain terrain / hybrid / non-terrain) classified
   // by `EntityStorageKind`.
   entt::entity createEntityFromPython(nb::object pyEntity);
+
+  // Bulk terrain construction from NumPy columns, for world generation
+  // instead of one create_entity call per voxel. `columns` maps column
+  // names (terrain_id, main_type, sub_type0, ..., see TerrainVoxelColumns)
+  // to arrays shaped (depth, height, width) for the box at `origin`, or
+  // with one value per row of the (N, 3) x, y, z array `coords`. Only the
+  // voxels keyed in `inventories` ((x, y, z) -> Inventory) become
+  // hybrid-terrain entities; their ids are returned.
+  nb::list loadTerrainBox(std::tuple<int, int, int> origin, nb::dict columns,
+                          nb::object inventories);
+  nb::list loadTerrainPoints(nb::object coords, nb::dict columns,
+                             nb::object inventories);
   void removeEntity(entt::entity entity);
   // Destroy only the EnTT entity handle. Caller must hold appropriate lifecycle
   // locks.
@@ -91,6 +112,14 @@ public:
 
   nb::list getEntityIdsByType(int entityMainType, int entitySubType0);
   nb::dict getEntitiesByType(int entityMainType, int entitySubType0);
+  // Every entity of the type, perceiving or not, as one int32 NumPy array
+  // copied out of the type index.
+  nb::object getEntityIdArrayByType(int entityMainType, int entitySubType0);
+  // Non-terrain entities near (x, y, z), from the voxel grid's entity
+  // spatial index, as int32 NumPy arrays: all of them within `radius`, or
+  // the `k` nearest within `maxRadius`, nearest first.
+  nb::object getEntityIdsInRadius(int x, int y, int z, float radius);
+  nb::object getNearestEntityIds(int x, int y, int z, int k, float maxRadius);
   EntityInterface getEntityById(int entityId);
 
   void setTerrain(int x, int y, int z, const EntityInterface &entityInterface);
@@ -174,6 +203,11 @@ public:
   createPerceptionResponseC(int entityId,
                             const std::vector<QueryCommand> &commands);
   nb::dict createPerceptionResponses(nb::dict entitiesWithQueries);
+  // createPerceptionResponses packed for one write to a pipe or socket:
+  // (ids int32[n], offsets int64[n + 1], data uint8[offsets[n]]) NumPy
+  // arrays, response i being data[offsets[i]:offsets[i + 1]]. A response
+  // that failed is empty, as in the dict.
+  nb::tuple createPerceptionResponsesPacked(nb::dict entitiesWithQueries);
   // PerceptionResponse createPerceptionResponse(int entityId);
 
   // New methods for Python system registration
@@ -204,6 +238,27 @@ public:
   bool getProcessMetabolism() const { return processMetabolism_; }
   void setProcessMetabolism(bool value) { processMetabolism_ = value; }
 
+  // Wall-clock budget for the entity-deletion queue per tick. 0 (default)
+  // drains the whole queue; otherwise whatever is left when the budget runs
+  // out stays queued for the next tick, so a mass die-off is spread over
+  // several ticks instead of stalling one.
+  std::chrono::microseconds getEntityDeletionBudget() const {
+    return entityDeletionBudget_;
+  }
+  void setEntityDeletionBudget(std::chrono::microseconds value) {
+    entityDeletionBudget_ = value;
+  }
+
+  // Simulation LOD (see SimulationLod.hpp). Off by default; while on,
+  // regions far from every observer update metabolism, plants and water
+  // boxes on a slower cadence; physics runs every tick. Observers are the
+  // entities with a PerceptionComponent plus the points given here (e.g.
+  // the player's camera), which replace the previous set.
+  void configureSimulationLod(bool enabled, const SimulationLodConfig &config);
+  void setLodObservers(std::vector<VoxelCoord> observers);
+  // Populations and updates per level as of the last complete tick.
+  const SimulationLodStats &getSimulationLodStats() const { return lodStats_; }
+
   // Water simulation phase toggles (delegate to PhysicsManager singleton)
   bool getSimulateVaporCondensation() const;
   void setSimulateVaporCondensation(bool value);
@@ -236,6 +291,9 @@ public:
   std::vector<std::pair<uint64_t, double>>
   queryTimeSeries(const std::string &seriesName, long long start,
                   long long end);
+  std::vector<TimeSeriesBucket>
+  queryTimeSeriesDownsampled(const std::string &seriesName, long long start,
+                             long long end, size_t maxPoints);
   void executeSQL(const std::string &sql);
 
   // Test-facing accessors for the bounded-retention contract:
@@ -246,6 +304,14 @@ public:
   size_t peekTimeSeriesSize(const std::string &seriesName) const;
   long long countTimeSeriesRowsOnDisk(const std::string &seriesName) const;
 
+  // Per-phase wall time of the last ticks of update(); always compiled in,
+  // unlike the Tracy zones. Backs world.get_tick_profile() and the Chrome
+  // trace export.
+  aetherion::diag::TickProfiler &tickProfiler() { return tickProfiler_; }
+  const aetherion::diag::TickProfiler &tickProfiler() const {
+    return tickProfiler_;
+  }
+
   // Per-engine async dispatch state. Type is public so file-scope
   // helpers in World.cpp (which are not members) can refer to it; the
   // *instances* `physicsState_` / `ecosystemState_` stay private below.
@@ -283,6 +349,14 @@ private:
   // the given EnTT entity. Shared by paths 2 and 3.
   void emplaceAllPyComponents(entt::entity newEntity, nb::object pyEntity);
 
+  // Reads `entitiesWithQueries` (entity id -> optional query list, which
+  // is cleared) and builds every perception response on the TBB pool
+  // without the GIL. Returns the responses in the order of `entityIds`,
+  // which it fills; responses that failed are empty.
+  std::vector<std::vector<char>>
+  buildPerceptionResponses(nb::dict entitiesWithQueries,
+                           std::vector<int> &entityIds);
+
   std::mutex registryMutex;
   // NOTE (2026-05-12): briefly wrapped in `TracySharedLockable` for the
   // FPS-wall investigation, then reverted — wrapping caused a SIGSEGV at
@@ -295,6 +369,9 @@ private:
   mutable std::shared_mutex
       entityLifecycleMutex; // Protects entity creation/destruction vs
                             // perception
+  // (mainType, subType0) -> entities, kept current by registry signals.
+  // Read under `entityLifecycleMutex` like any other registry view.
+  EntityTypeIndex entityTypeIndex_;
   std::unique_ptr<GameDBHandler> dbHandler;
 
   // Async-dispatch infrastructure. Replaces the old `std::future<void>`
@@ -313,6 +390,23 @@ private:
   AsyncEngineState physicsState_;
   AsyncEngineState ecosystemState_;
 
+  aetherion::diag::TickProfiler tickProfiler_;
+
+  // Levels the LOD regions for this tick and publishes the last tick's
+  // populations and savings.
+  void beginLodTick();
+
+  SimulationLod simulationLod_;
+  std::vector<VoxelCoord> lodObservers_;
+  SimulationLodStats lodStats_;
+  std::array<aetherion::diag::Gauge, kLodLevels> lodPopulation_;
+  aetherion::diag::Counter lodSkippedUpdates_;
+
+  // Wall time of one agent's createPerceptionResponseC and of one
+  // dispatcher.update() per tick.
+  aetherion::diag::Histogram perceptionResponseNs_;
+  aetherion::diag::Histogram dispatcherUpdateNs_;
+
   // Physics
   PhysicsEngine *physicsEngine;
 
@@ -330,6 +424,7 @@ private:
   // `const bool processMetabolismAsync = false;` was hardcoded, the sync
   // branch always ran). Setting this false skips metabolism entirely.
   bool processMetabolism_ = true;
+  std::chrono::microseconds entityDeletionBudget_{0};
 
   // HealthSystem
   HealthSystem *healthSystem;
@@ -370,6 +465,10 @@ private:
 
   // Process queued entity deletions when safe to do so (no async tasks running)
   void processEntityDeletion();
+
+  // Apply the deferred ECS commands under the exclusive lifecycle lock; only
+  // called when no async task is running.
+  void playbackEcsCommands();
 };
 
 #endif // WORLD_H
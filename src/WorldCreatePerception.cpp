@@ -236,7 +236,8 @@ static EntityInterface buildNonTerrainEntityInterface(
     entt::view<entt::get_t<Velocity>> velocityView,
     entt::view<entt::get_t<MovingComponent>> movingComponentView,
     entt::view<entt::get_t<HealthComponent>> healthView,
-    entt::view<entt::get_t<Inventory>> inventoryView) {
+    entt::view<entt::get_t<Inventory>> inventoryView,
+    const MovementSchedule &movementSchedule) {
   EntityInterface entity_interface;
   entity_interface.entityId = static_cast<int>(entity);
 
@@ -276,8 +277,11 @@ static EntityInterface buildNonTerrainEntityInterface(
 
   if (etc.mainType != static_cast<int>(EntityEnum::TERRAIN) &&
       movingComponentView.contains(entity)) {
-    const MovingComponent &movingComponent =
+    MovingComponent movingComponent =
         movingComponentView.get<MovingComponent>(entity);
+    // timeRemaining is not counted down in the registry any more; the
+    // schedule knows how many ticks are left.
+    movementSchedule.refreshTimeRemaining(entity, movingComponent);
     entity_interface.setComponent<MovingComponent>(movingComponent);
   }
 
@@ -363,7 +367,7 @@ void World::buildNonTerrainEntities(
 
         EntityInterface entity_interface = buildNonTerrainEntityInterface(
             entity, registry, allView, velocityView, movingComponentView,
-            healthView, inventoryView);
+            healthView, inventoryView, physicsEngine->movementSchedule());
         response.world_view.entities.emplace(entity_interface.entityId,
                                              std::move(entity_interface));
       });
@@ -396,6 +400,7 @@ World::createPerceptionResponseC(int entityId,
 #ifdef TRACY_ENABLE
   ZoneScopedN("World::createPerceptionResponseC");
 #endif
+  aetherion::diag::ScopedTimer responseTimer(perceptionResponseNs_);
   auto logger = Logger::getLogger();
 
   // Acquire shared lock to prevent entity destruction during perception
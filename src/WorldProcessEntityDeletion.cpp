@@ -1,51 +1,13 @@
 #include "World.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <span>
 
 #include "physics/PhysicsMutators.hpp"
 
-static void processVelocityRemovals(entt::registry &registry,
-                                    LifeEngine &lifeEngine) {
-  auto console = spdlog::get("console");
-  if (!console)
-    console = spdlog::stdout_color_mt("console");
-
-  console->debug("--- PHASE 1: Removing Velocity components ---");
-  int velocityRemoved = 0;
-  int velocitySkipped = 0;
-  for (const auto &[entity, _] : lifeEngine.entitiesToRemoveVelocity) {
-    int entityId = static_cast<int>(entity);
-    bool valid = registry.valid(entity);
-    bool hasVelocity = valid && registry.all_of<Velocity>(entity);
-
-    if (hasVelocity) {
-      registry.remove<Velocity>(entity);
-      console->debug("[Velocity] Removed from entity {}", entityId);
-      velocityRemoved++;
-    } else {
-      console->debug("[Velocity] Skipped entity {} (valid={}, hasVelocity={})",
-                     entityId, valid, hasVelocity);
-      velocitySkipped++;
-    }
-  }
-  console->debug("[Velocity Summary] Removed: {}, Skipped: {}", velocityRemoved,
-                 velocitySkipped);
-  lifeEngine.entitiesToRemoveVelocity.clear();
-}
-
 namespace {
 
-struct MovingRemovalDecision {
-  int entity_id;
-  bool valid;
-  bool has_moving;
-};
-
-struct MovingRemovalStats {
-  int removed = 0;
-  int skipped = 0;
-};
-
 enum class DeletionIssueReason {
   kDestroyException = 1,
   kSpecialId = 2,
@@ -67,43 +29,6 @@ struct EntityDeletionStats {
   std::map<int, int> deletion_reasons;
 };
 
-MovingRemovalDecision inspectMovingRemoval(entt::registry &registry,
-                                           entt::entity entity) {
-  const bool valid = registry.valid(entity);
-  const bool hasMoving = valid && registry.all_of<MovingComponent>(entity);
-  return {static_cast<int>(entity), valid, hasMoving};
-}
-
-void recordMovingRemoval(spdlog::logger &console,
-                         const MovingRemovalDecision &decision,
-                         MovingRemovalStats &stats) {
-  console.debug("[Moving] Removed from entity {}", decision.entity_id);
-  stats.removed++;
-}
-
-void recordMovingSkip(spdlog::logger &console,
-                      const MovingRemovalDecision &decision,
-                      MovingRemovalStats &stats) {
-  console.debug("[Moving] Skipped entity {} (valid={}, hasMoving={})",
-                decision.entity_id, decision.valid, decision.has_moving);
-  stats.skipped++;
-}
-
-void processSingleMovingComponentRemoval(entt::registry &registry,
-                                         spdlog::logger &console,
-                                         entt::entity entity,
-                                         MovingRemovalStats &stats) {
-  const MovingRemovalDecision decision = inspectMovingRemoval(registry, entity);
-
-  if (decision.has_moving) {
-    registry.remove<MovingComponent>(entity);
-    recordMovingRemoval(console, decision, stats);
-    return;
-  }
-
-  recordMovingSkip(console, decision, stats);
-}
-
 EntityDeletionDecision inspectEntityDeletion(entt::registry &registry,
                                              entt::entity entity,
                                              bool softKill) {
@@ -289,54 +214,210 @@ void logEntityDeletionSummary(spdlog::logger &console,
   }
 }
 
-} // namespace
+using DeletionQueue = std::vector<std::tuple<entt::entity, bool>>;
+
+// Queue entries handled per batch. With a deletion budget the clock is read
+// between batches, so this also bounds how far a tick can overrun it.
+constexpr size_t kDeletionBatchSize = 512;
+
+// One batch of the fast path, grouped by where the entity lives on the
+// grid. Buffers are reused across batches.
+struct DeletionBatch {
+  std::vector<entt::entity> destroy;    // every fast-path entity
+  std::vector<VoxelCoord> entityCells;  // BEAST/PLANT: entity grid
+  std::vector<int> entityIds;
+  std::vector<VoxelCoord> terrainCells; // TERRAIN: terrain storage
+  std::vector<int> terrainIds;
+
+  void clear() {
+    destroy.clear();
+    entityCells.clear();
+    entityIds.clear();
+    terrainCells.clear();
+    terrainIds.clear();
+  }
+};
 
-static void processMovingComponentRemovals(entt::registry &registry,
-                                           LifeEngine &lifeEngine) {
-  auto console = spdlog::get("console");
-  if (!console)
-    console = spdlog::stdout_color_mt("console");
+// Sorts the queue by entity and folds duplicate entries into one; a hard
+// kill wins over a soft one. Sorted handles also let the range destroy walk
+// EnTT's sparse sets in order.
+void normalizeDeletionQueue(DeletionQueue &queue) {
+  std::sort(queue.begin(), queue.end(), [](const auto &a, const auto &b) {
+    return std::get<0>(a) < std::get<0>(b);
+  });
+  auto out = queue.begin();
+  for (auto it = queue.begin(); it != queue.end(); ++it) {
+    if (out != queue.begin() && std::get<0>(*(out - 1)) == std::get<0>(*it)) {
+      std::get<1>(*(out - 1)) = std::get<1>(*(out - 1)) && std::get<1>(*it);
+      continue;
+    }
+    *out++ = *it;
+  }
+  queue.erase(out, queue.end());
+}
 
-  console->debug("--- PHASE 2: Removing MovingComponent ---");
-  MovingRemovalStats stats;
-  for (const auto &[entity, _] : lifeEngine.entitiesToRemoveMovingComponent) {
-    processSingleMovingComponentRemoval(registry, *console, entity, stats);
+// Splits `entries` into the fast path (valid entities with Position and
+// EntityTypeComponent) and everything else, which goes through the
+// per-entity path as before: special ids, handles that are already invalid
+// and entities whose cell has to be looked up in the repository.
+void collectDeletionBatch(
+    entt::registry &registry, VoxelGrid &voxelGrid, EventSink &sink,
+    LifeEngine &lifeEngine, spdlog::logger &console,
+    std::span<const std::tuple<entt::entity, bool>> entries,
+    DeletionBatch &batch, EntityDeletionStats &stats) {
+  batch.clear();
+  for (const auto &[entity, softKill] : entries) {
+    const EntityDeletionDecision decision =
+        inspectEntityDeletion(registry, entity, softKill);
+    if (decision.is_special_id || !decision.is_valid_entity) {
+      processSingleEntityDeletion(registry, voxelGrid, sink, lifeEngine,
+                                  console, decision, stats);
+      continue;
+    }
+    const Position *pos = registry.try_get<Position>(entity);
+    const EntityTypeComponent *type =
+        registry.try_get<EntityTypeComponent>(entity);
+    if (!pos || !type) {
+      destroyValidDeletionTarget(registry, voxelGrid, sink, lifeEngine,
+                                 console, decision, stats);
+      continue;
+    }
+
+    const VoxelCoord cell{pos->x, pos->y, pos->z};
+    if (type->mainType == static_cast<int>(EntityEnum::TERRAIN)) {
+      batch.terrainCells.push_back(cell);
+      batch.terrainIds.push_back(decision.entity_id);
+    } else if (type->mainType == static_cast<int>(EntityEnum::BEAST) ||
+               type->mainType == static_cast<int>(EntityEnum::PLANT)) {
+      batch.entityCells.push_back(cell);
+      batch.entityIds.push_back(decision.entity_id);
+    }
+    batch.destroy.push_back(entity);
+  }
+}
+
+// Batch form of destroyEntityWithGridCleanup. Grid cells are only cleared
+// while they still hold the entity, as removeEntityFromGrid checks;
+// soft-killed entities were taken off the grid when they were killed, so
+// they normally fall through that check.
+void destroyDeletionBatch(entt::registry &registry, VoxelGrid &voxelGrid,
+                          EventSink &sink, LifeEngine &lifeEngine,
+                          spdlog::logger &console, DeletionBatch &batch,
+                          EntityDeletionStats &stats) {
+  if (batch.destroy.empty()) {
+    return;
+  }
+
+  const size_t cleared =
+      voxelGrid.deleteEntities(batch.entityCells, batch.entityIds);
+  stats.grid_mismatches +=
+      static_cast<int>(batch.entityCells.size() - cleared);
+
+  {
+    // One terrain grid lock for the terrain cells and the repository
+    // unmapping of the whole batch.
+    TerrainGridLock terrainLock(voxelGrid.terrainGridRepository.get());
+    for (size_t i = 0; i < batch.terrainCells.size(); ++i) {
+      const VoxelCoord &c = batch.terrainCells[i];
+      if (voxelGrid.getEntity(c.x, c.y, c.z) != batch.terrainIds[i]) {
+        stats.grid_mismatches++;
+        continue;
+      }
+      try {
+        voxelGrid.deleteTerrain(sink, c.x, c.y, c.z, false);
+      } catch (const std::exception &e) {
+        console.error("[Deletion] deleteTerrain failed for entity {}: {}",
+                      batch.terrainIds[i], e.what());
+      }
+    }
+    if (voxelGrid.terrainGridRepository) {
+      voxelGrid.terrainGridRepository->softDeactivateEntities(
+          sink, batch.destroy, false);
+    }
+  }
+
+  try {
+    registry.destroy(batch.destroy.begin(), batch.destroy.end());
+    stats.successful_deletions += static_cast<int>(batch.destroy.size());
+  } catch (const std::exception &e) {
+    // Finish whatever the range destroy left behind one at a time, so a
+    // failure is pinned on the entity that caused it.
+    console.error("[Deletion] EXCEPTION in batch destroy of {} entities: {}",
+                  batch.destroy.size(), e.what());
+    for (entt::entity entity : batch.destroy) {
+      if (!registry.valid(entity)) {
+        stats.successful_deletions++;
+        continue;
+      }
+      try {
+        registry.destroy(entity);
+        stats.successful_deletions++;
+      } catch (const std::exception &inner) {
+        console.error("[Deletion] EXCEPTION while destroying entity {}: {}",
+                      static_cast<int>(entity), inner.what());
+        stats.skipped_deletions++;
+        recordDeletionIssue(stats, static_cast<int>(entity),
+                            DeletionIssueReason::kDestroyException);
+      }
+    }
+  }
+
+  for (entt::entity entity : batch.destroy) {
+    lifeEngine.entitiesScheduledForDeletion.erase(entity);
   }
-  console->debug("[Moving Summary] Removed: {}, Skipped: {}", stats.removed,
-                 stats.skipped);
-  lifeEngine.entitiesToRemoveMovingComponent.clear();
 }
 
-static void processEntityDeletionQueue(entt::registry &registry,
-                                       VoxelGrid &voxelGrid, EventSink &sink,
-                                       LifeEngine &lifeEngine) {
+} // namespace
+
+// Returns how many queue entries were left for the next tick.
+static size_t processEntityDeletionQueue(entt::registry &registry,
+                                         VoxelGrid &voxelGrid, EventSink &sink,
+                                         LifeEngine &lifeEngine,
+                                         std::chrono::microseconds budget) {
   auto console = spdlog::get("console");
   if (!console)
     console = spdlog::stdout_color_mt("console");
 
   console->debug("--- PHASE 3: Full entity deletion ---");
+  const auto start = std::chrono::steady_clock::now();
   EntityDeletionStats stats;
-
-  for (const auto &[entity, softKill] : lifeEngine.entitiesToDelete) {
-    const EntityDeletionDecision decision =
-        inspectEntityDeletion(registry, entity, softKill);
-    processSingleEntityDeletion(registry, voxelGrid, sink, lifeEngine, *console,
-                                decision, stats);
+  DeletionQueue &queue = lifeEngine.entitiesToDelete;
+  normalizeDeletionQueue(queue);
+
+  DeletionBatch batch;
+  size_t done = 0;
+  while (done < queue.size()) {
+    if (budget.count() > 0 && done > 0 &&
+        std::chrono::steady_clock::now() - start >= budget) {
+      break;
+    }
+    const size_t count = std::min(kDeletionBatchSize, queue.size() - done);
+    const std::span<const std::tuple<entt::entity, bool>> entries(
+        queue.data() + done, count);
+    collectDeletionBatch(registry, voxelGrid, sink, lifeEngine, *console,
+                         entries, batch, stats);
+    destroyDeletionBatch(registry, voxelGrid, sink, lifeEngine, *console,
+                         batch, stats);
+    done += count;
   }
 
   logEntityDeletionSummary(*console, stats);
 
-  // Clear the deletion queue - CRITICAL: Only clear if we've processed
-  // everything
-  console->debug("[Deletion] Clearing entitiesToDelete queue");
+  queue.erase(queue.begin(), queue.begin() + static_cast<ptrdiff_t>(done));
+  if (!queue.empty()) {
+    // Out of budget: the rest stay queued (and stay in
+    // entitiesScheduledForDeletion, so they are not queued twice).
+    console->debug("[Deletion] Deferred {} entities to the next tick",
+                   queue.size());
+    return queue.size();
+  }
+
+  // Only clear the schedule once the whole queue has been processed.
   console->debug(
       "[Deletion] Before final clear - entitiesScheduledForDeletion size: {}",
       lifeEngine.entitiesScheduledForDeletion.size());
-  lifeEngine.entitiesToDelete.clear();
   lifeEngine.entitiesScheduledForDeletion.clear();
-  console->debug(
-      "[Deletion] After final clear - entitiesScheduledForDeletion size: {}",
-      lifeEngine.entitiesScheduledForDeletion.size());
+  return 0;
 }
 
 void World::processEntityDeletion() {
@@ -359,21 +440,12 @@ void World::processEntityDeletion() {
   // per-entity debug line.
   const auto _delStart = std::chrono::steady_clock::now();
   const size_t _initialToDelete = lifeEngine->entitiesToDelete.size();
-  const size_t _initialToRemoveVel =
-      lifeEngine->entitiesToRemoveVelocity.size();
-  const size_t _initialToRemoveMov =
-      lifeEngine->entitiesToRemoveMovingComponent.size();
 
   console->debug("\n========== ENTITY DELETION PHASE START ==========");
   console->debug("Total entities in entitiesToDelete: {}", _initialToDelete);
-  console->debug("Total entities in entitiesToRemoveVelocity: {}",
-                 _initialToRemoveVel);
-  console->debug("Total entities in entitiesToRemoveMovingComponent: {}",
-                 _initialToRemoveMov);
 
-  processVelocityRemovals(registry, *lifeEngine);
-  processMovingComponentRemovals(registry, *lifeEngine);
-  processEntityDeletionQueue(registry, *voxelGrid, eventSink_, *lifeEngine);
+  const size_t _deferred = processEntityDeletionQueue(
+      registry, *voxelGrid, eventSink_, *lifeEngine, entityDeletionBudget_);
 
   console->debug("========== ENTITY DELETION PHASE COMPLETE ==========\n");
 
@@ -381,8 +453,20 @@ void World::processEntityDeletion() {
   const auto _delMs =
       std::chrono::duration_cast<std::chrono::milliseconds>(_delEnd - _delStart)
           .count();
-  console->info("[deletion] toDelete={} toRemoveVel={} toRemoveMov={} "
-                "duration_ms={}",
-                _initialToDelete, _initialToRemoveVel, _initialToRemoveMov,
-                _delMs);
+  console->info("[deletion] toDelete={} deferred={} duration_ms={}",
+                _initialToDelete, _deferred, _delMs);
+}
+
+void World::playbackEcsCommands() {
+  // Playback creates, destroys and restructures storages, so perception
+  // readers must be kept out exactly as during entity deletion.
+  std::unique_lock lifecycleLock(entityLifecycleMutex);
+
+  auto console = spdlog::get("console");
+  if (!console)
+    console = spdlog::stdout_color_mt("console");
+
+  const size_t commands = ecsCommands_.pending();
+  ecsCommands_.playback(registry);
+  console->debug("[commands] played back {} deferred ECS commands", commands);
 }
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "EntityInterface.hpp"
+#include "EntityInterfaceFlatB.hpp"
 #include "FlatbufferUtils.hpp"
 #include "WorldView_generated.h"
 #include "components/PerceptionComponent.hpp"
@@ -245,31 +246,7 @@ struct WorldView {
     auto fbEntities = fbWorldView->entities();
     if (fbEntities) {
       for (auto fbEntity : *fbEntities) {
-        int entityId = fbEntity->entityId();
-        // auto fbEntityData = fbEntity->entity_data();
-
-        // Retrieve the entity_data
-        auto data = fbEntity->entity_data();
-        std::vector<char> entity_buffer;
-        if (data) {
-          entity_buffer.resize(data->size());
-          std::memcpy(entity_buffer.data(), data->data(), data->size());
-
-          // Print raw entity_data
-          // std::cout << "Raw entity_data size: " << entity_buffer.size() <<
-          // std::endl; std::cout << "Raw entity_data (hex): "; for (char byte :
-          // entity_buffer) {
-          //     printf("%02x ", static_cast<unsigned char>(byte));
-          // }
-          // std::cout << std::endl;
-        }
-
-        // Deserialize into EntityInterface
-        EntityInterface deserializedEntity = EntityInterface::deserialize(
-            entity_buffer.data(), entity_buffer.size());
-
-        // Assign the entityId (if not already handled in deserialize)
-        deserializedEntity.entityId = fbEntity->entityId();
+        EntityInterface deserializedEntity = deserializeEntityFlatB(fbEntity);
 
         // Use emplace for efficiency
         worldView.entities.emplace(deserializedEntity.entityId,
@@ -314,15 +291,8 @@ struct WorldView {
     std::vector<flatbuffers::Offset<GameEngine::EntityInterface>> entityOffsets;
 
     for (const auto &[entityId, entityInterface] : entitiesMap) {
-      const size_t total = entityInterface.computeSerializedSize();
-      uint8_t *dst = nullptr;
-      auto entityDataOffset =
-          builder.CreateUninitializedVector<uint8_t>(total, &dst);
-      entityInterface.serializeInto(dst);
-
-      auto entityOffset = GameEngine::CreateEntityInterface(builder, entityId,
-                                                            entityDataOffset);
-      entityOffsets.push_back(entityOffset);
+      entityOffsets.push_back(
+          serializeEntityFlatB(builder, entityInterface, entityId));
     }
 
     return entityOffsets;
@@ -12,6 +12,7 @@
 #include <spdlog/spdlog.h>
 
 #include <cstdint>
+#include <fstream>
 
 #include "Camera/DimetricTileWalker.hpp"
 #include "LowLevelRenderer/FontManager.hpp"
@@ -893,6 +894,70 @@ NB_MODULE(_aetherion, m) {
           "process_metabolism",
           [](const World &w) { return w.getProcessMetabolism(); },
           [](World &w, bool v) { w.setProcessMetabolism(v); })
+      .def_prop_rw(
+          "entity_deletion_budget_us",
+          [](const World &w) {
+            return static_cast<int64_t>(w.getEntityDeletionBudget().count());
+          },
+          [](World &w, int64_t us) {
+            w.setEntityDeletionBudget(std::chrono::microseconds(us));
+          })
+      .def(
+          "configure_simulation_lod",
+          [](World &w, bool enabled, int regionSize, int nearRegions,
+             int midRegions, int midInterval, int farInterval) {
+            w.configureSimulationLod(
+                enabled, SimulationLodConfig{regionSize, nearRegions,
+                                             midRegions, midInterval,
+                                             farInterval});
+          },
+          nb::arg("enabled"), nb::arg("region_size") = 16,
+          nb::arg("near_regions") = 2, nb::arg("mid_regions") = 6,
+          nb::arg("mid_interval") = 4, nb::arg("far_interval") = 16,
+          "Turn simulation LOD on or off. The map is cut into "
+          "region_size-voxel columns; regions within near_regions of an "
+          "observer update every tick, within mid_regions every "
+          "mid_interval ticks, the rest every far_interval ticks.")
+      .def(
+          "set_lod_observers",
+          [](World &w, nb::iterable points) {
+            // Walked by hand: <nanobind/stl/vector.h> would clash with the
+            // nb::bind_vector instantiations.
+            std::vector<VoxelCoord> observers;
+            for (nb::handle point : points) {
+              auto [x, y, z] = nb::cast<std::tuple<int, int, int>>(point);
+              observers.push_back(VoxelCoord{x, y, z});
+            }
+            w.setLodObservers(std::move(observers));
+          },
+          nb::arg("points"),
+          "Extra LOD observers as (x, y, z) tuples, on top of every "
+          "perceiving entity. Replaces the previous list.")
+      .def(
+          "get_simulation_lod_stats",
+          [](const World &w) {
+            const SimulationLodStats &stats = w.getSimulationLodStats();
+            const char *names[kLodLevels] = {"near", "mid", "far"};
+            nb::dict levels;
+            for (std::size_t l = 0; l < kLodLevels; ++l) {
+              nb::dict level;
+              level["regions"] = stats.regions[l];
+              level["updated"] = stats.updated[l];
+              level["skipped"] = stats.skipped[l];
+              levels[names[l]] = level;
+            }
+            nb::dict out;
+            out["tick"] = stats.tick;
+            out["levels"] = levels;
+            return out;
+          },
+          "Regions, and entity/box updates done and skipped, per LOD level "
+          "on the last complete tick: {tick, levels: {near|mid|far: "
+          "{regions, updated, skipped}}}. tick is 0 while LOD is off.")
+      .def_prop_rw(
+          "tick_profiler_enabled",
+          [](const World &w) { return w.tickProfiler().enabled(); },
+          [](World &w, bool v) { w.tickProfiler().setEnabled(v); })
       .def_prop_rw(
           "simulate_vapor_condensation",
           [](const World &w) { return w.getSimulateVaporCondensation(); },
@@ -921,13 +986,49 @@ NB_MODULE(_aetherion, m) {
       .def("set_voxel", &World::setVoxel)
       .def("get_voxel", &World::getVoxel)
       .def("create_entity", &World::createEntityFromPython)
+      .def("load_terrain_box", &World::loadTerrainBox, nb::arg("origin"),
+           nb::arg("columns"), nb::arg("inventories") = nb::none(),
+           "Load terrain for the box at origin from a dict of "
+           "(depth, height, width) NumPy columns (terrain_id, main_type, "
+           "sub_type0, sub_type1, terrain_matter, water_matter, "
+           "vapor_matter, biomass_matter, mass, max_speed, min_speed, heat, "
+           "flags, max_load_capacity; main_type is required). A voxel whose "
+           "terrain_id is NONE (-2) is skipped and keeps what it held. A "
+           "missing terrain_id column writes ON_GRID_STORAGE (-1); any other "
+           "missing column writes 0, sub_type1 included, not the -1 an "
+           "unwritten voxel reads. Voxels keyed (x, y, z) in inventories "
+           "become hybrid-terrain entities, whose ids are returned.")
+      .def("load_terrain_points", &World::loadTerrainPoints, nb::arg("coords"),
+           nb::arg("columns"), nb::arg("inventories") = nb::none(),
+           "Like load_terrain_box for the rows of an (N, 3) x, y, z array, "
+           "with one value per row in each column.")
       .def("remove_entity", &World::removeEntity)
       .def("get_entities_by_type", &World::getEntitiesByType)
       .def("get_entity_ids_by_type", &World::getEntityIdsByType)
+      .def("get_entity_id_array_by_type", &World::getEntityIdArrayByType,
+           nb::arg("main_type"), nb::arg("sub_type0"),
+           "IDs of every entity of the type, as an int32 NumPy array. "
+           "Unlike get_entity_ids_by_type, entities without perception are "
+           "included.")
+      .def("get_entity_ids_in_radius", &World::getEntityIdsInRadius,
+           nb::arg("x"), nb::arg("y"), nb::arg("z"), nb::arg("radius"),
+           "IDs of the non-terrain entities within Euclidean `radius` of "
+           "(x, y, z), in no particular order, as an int32 NumPy array.")
+      .def("get_nearest_entity_ids", &World::getNearestEntityIds,
+           nb::arg("x"), nb::arg("y"), nb::arg("z"), nb::arg("k"),
+           nb::arg("max_radius") = 64.0f,
+           "IDs of the k non-terrain entities nearest to (x, y, z) within "
+           "max_radius, nearest first (ties to the lower id), as an int32 "
+           "NumPy array.")
       .def("get_entity_by_id", &World::getEntityById,
            "Retrieve an EntityInterface by entity ID")
       .def("create_perception_response", &World::createPerceptionResponse)
       .def("create_perception_responses", &World::createPerceptionResponses)
+      .def("create_perception_responses_packed",
+           &World::createPerceptionResponsesPacked, nb::arg("queries"),
+           "Like create_perception_responses, but every response is written "
+           "into one buffer: returns (ids, offsets, data) NumPy arrays, the "
+           "response of ids[i] being data[offsets[i]:offsets[i + 1]].")
       .def("set_terrain", &World::setTerrain)
       .def("get_terrain", &World::getTerrain)
       .def("get_entity", &World::getEntity)
@@ -1050,6 +1151,70 @@ NB_MODULE(_aetherion, m) {
              }
              return out;
            })
+      .def(
+          "query_time_series_downsampled",
+          [](World &w, const std::string &seriesName, long long start,
+             long long end, size_t maxPoints) {
+            auto buckets =
+                w.queryTimeSeriesDownsampled(seriesName, start, end, maxPoints);
+            nb::list out;
+            for (const auto &b : buckets) {
+              out.append(
+                  nb::make_tuple(b.timestamp, b.min, b.max, b.mean, b.count));
+            }
+            return out;
+          },
+          nb::arg("series_name"), nb::arg("start"), nb::arg("end"),
+          nb::arg("max_points") = 500,
+          "List of (ts, min, max, mean, count) buckets covering [start, end] "
+          "at the finest stored resolution (raw, 10 s, 1 min, 10 min) that "
+          "fits in max_points.")
+      .def(
+          "get_tick_profile",
+          [](const World &w, size_t n) {
+            namespace diag = aetherion::diag;
+            auto ms = [](std::int64_t ns) {
+              return static_cast<double>(ns) / 1e6;
+            };
+            nb::list out;
+            for (const auto &t : w.tickProfiler().recent(n)) {
+              nb::dict phases;
+              for (size_t i = 0; i < diag::kTickPhaseCount; ++i) {
+                if (t.phase_ns[i] >= 0) {
+                  auto name =
+                      diag::tickPhaseName(static_cast<diag::TickPhase>(i));
+                  phases[nb::str(name.data(), name.size())] =
+                      ms(t.phase_ns[i]);
+                }
+              }
+              nb::dict row;
+              row["tick"] = t.tick;
+              row["start_ms"] = ms(t.start_ns);
+              row["total_ms"] = ms(t.total_ns);
+              row["phases"] = phases;
+              out.append(row);
+            }
+            return out;
+          },
+          nb::arg("n") = 120,
+          "Per-phase wall time (ms) of the last n ticks, oldest first. Each "
+          "entry is {tick, start_ms, total_ms, phases: {name: ms}}; phases "
+          "that did not run that tick are omitted.")
+      .def(
+          "export_tick_profile",
+          [](const World &w, const std::string &path, size_t n) {
+            std::ofstream file(path);
+            if (!file) {
+              throw std::runtime_error("export_tick_profile: cannot open '" +
+                                       path + "'");
+            }
+            auto ticks = w.tickProfiler().recent(n);
+            file << aetherion::diag::TickProfiler::chromeTraceJson(ticks);
+            return ticks.size();
+          },
+          nb::arg("path"), nb::arg("n") = 0,
+          "Write the last n ticks (0 = all buffered) as Chrome trace-event "
+          "JSON for chrome://tracing or Perfetto. Returns the tick count.")
       .def("execute_sql",
            [](World &w, nb::object sql) {
              std::string s = nb::cast<std::string>(sql);
@@ -1162,12 +1327,41 @@ NB_MODULE(_aetherion, m) {
       .def_rw("mapOfMaps", &MapOfMapsOfDoubleResponse::mapOfMaps)
       .def("serialize", &MapOfMapsOfDoubleResponse::py_serialize);
 
+  nb::enum_<EntityWireFormat>(m, "EntityWireFormat")
+      .value("BLOB", EntityWireFormat::BLOB)
+      .value("TABLES", EntityWireFormat::TABLES)
+      .export_values();
+
+  m.def("set_entity_wire_format", &setEntityWireFormat, nb::arg("format"),
+        "Choose how entities are written into FlatBuffers responses. BLOB "
+        "keeps the all-struct_pack form for clients that only read that.");
+  m.def("get_entity_wire_format", &getEntityWireFormat);
+
+  // Zero-copy reads of single components from a FlatBuffers entity
+  nb::class_<EntityInterfaceFlatB>(m, "EntityInterfaceFlatB")
+      .def("get_entity_id", &EntityInterfaceFlatB::getEntityId)
+      .def(
+          "has_component",
+          [](const EntityInterfaceFlatB &self, int flag) {
+            return self.hasComponent(static_cast<ComponentFlag>(flag));
+          },
+          nb::arg("flag"))
+      .def("get_entity_type", &EntityInterfaceFlatB::getEntityType)
+      .def("get_position", &EntityInterfaceFlatB::getPosition)
+      .def("get_velocity", &EntityInterfaceFlatB::getVelocity)
+      .def("get_health", &EntityInterfaceFlatB::getHealth)
+      .def("get_perception", &EntityInterfaceFlatB::getPerception)
+      .def("get_entity", &EntityInterfaceFlatB::getEntity,
+           nb::rv_policy::copy);
+
   nb::class_<PerceptionResponseFlatB>(m, "PerceptionResponseFlatB")
       .def(nb::init<nb::bytes>())
       .def("getWorldView", &PerceptionResponseFlatB::getWorldView,
            nb::rv_policy::reference_internal)
       .def("getEntity", &PerceptionResponseFlatB::getEntity,
            nb::rv_policy::reference_internal)
+      .def("get_entity_view", &PerceptionResponseFlatB::getEntityView,
+           nb::keep_alive<0, 1>())
       .def("get_item_from_inventory_by_id",
            &PerceptionResponseFlatB::getItemFromInventoryById,
            nb::rv_policy::reference_internal)
@@ -1888,6 +2082,14 @@ NB_MODULE(_aetherion, m) {
       .def("get_component", &PyRegistry::get_component, nb::rv_policy::copy)
       .def("set_component", &PyRegistry::set_component)
       .def("remove_component", &PyRegistry::remove_component)
+      .def("component_arrays", &PyRegistry::component_arrays,
+           nb::arg("component_name"),
+           "[(entity_ids, components), ...] per 1024-entity page of a "
+           "plain-data component pool. `components` is a structured NumPy "
+           "array over the pool itself, so writes go straight to the "
+           "registry; valid until that component is added or removed. "
+           "EntityTypeComponent, Position and MovingComponent arrays are "
+           "read-only: change those with set_component.")
       .def("is_valid", &PyRegistry::is_valid);
 
   m.def("get_and_draw_selected_entity", &getAndDrawSelectedEntity);
@@ -2009,6 +2211,10 @@ NB_MODULE(_aetherion, m) {
         .def("set", &diag::Gauge::set, nb::arg("value"))
         .def("enabled", &diag::Gauge::enabled);
 
+    nb::class_<diag::Histogram>(d, "Histogram")
+        .def("record", &diag::Histogram::record, nb::arg("value"))
+        .def("enabled", &diag::Histogram::enabled);
+
     // Convert a Python object to nlohmann::json by round-tripping through
     // Python's `json.dumps`. This is the simplest correct path for v1;
     // payloads are small and emission is not on the hot path.
@@ -2052,6 +2258,19 @@ NB_MODULE(_aetherion, m) {
         nb::arg("name"), nb::arg("flush_every_ms") = 1000,
         "Register a Gauge that flushes to GameDB on the given cadence.");
 
+    d.def(
+        "histogram",
+        [](const std::string &name, long flush_every_ms) {
+          diag::HistogramConfig cfg;
+          cfg.name = name;
+          cfg.flush_every = std::chrono::milliseconds{flush_every_ms};
+          cfg.sinks = {diag::GameDBSink{}};
+          return diag::Registry::instance().histogram(cfg);
+        },
+        nb::arg("name"), nb::arg("flush_every_ms") = 1000,
+        "Register a Histogram that flushes <name>.p50/.p90/.p99/.max to "
+        "GameDB on the given cadence.");
+
     d.def(
         "event",
         [](const std::string &channel, nb::object required_keys) {
@@ -2083,7 +2302,23 @@ NB_MODULE(_aetherion, m) {
         "Flush metrics whose flush_every window has elapsed.");
     d.def(
         "flush_all", []() { diag::Registry::instance().flush_all(); },
-        "Force-flush every registered metric.");
+        "Force-flush every registered metric and wait for the GameDB "
+        "writer thread to commit it.");
+    d.def(
+        "writer_stats",
+        []() {
+          auto st = diag::Registry::instance().writer_stats();
+          nb::dict out;
+          out["enqueued"] = st.enqueued;
+          out["written"] = st.written;
+          out["failed"] = st.failed;
+          out["dropped"] = st.dropped;
+          out["blocked"] = st.blocked;
+          out["batches"] = st.batches;
+          out["queue_depth"] = st.queue_depth;
+          return out;
+        },
+        "GameDB writer-thread counters (all zero when no World is alive).");
     d.def(
         "disable",
         [](const std::string &name_or_glob) {
@@ -2,14 +2,20 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
 #include <chrono>
+#include <cmath>
 #include <mutex>
+#include <new>
 #include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "GameDBHandler.hpp"
+#include "diag/GameDBWriter.hpp"
 #include "diag/Sink.hpp"
 
 namespace aetherion::diag {
@@ -47,18 +53,20 @@ std::string formatJsonBody(const nlohmann::json &payload) {
 
 namespace {
 
+// Hands samples to the GameDB writer thread; never touches SQLite itself.
 class GameDBSinkImpl final : public Sink {
 public:
-  explicit GameDBSinkImpl(GameDBHandler *db) : db_(db) {}
+  explicit GameDBSinkImpl(GameDBWriter *writer) : writer_(writer) {}
 
   void write_metric(const MetricSample &s) override {
-    if (!db_) {
+    if (!writer_) {
       return;
     }
     auto secs = std::chrono::duration_cast<std::chrono::seconds>(
                     s.ts.time_since_epoch())
                     .count();
-    db_->putTimeSeries(s.name, static_cast<long long>(secs), s.value);
+    writer_->enqueue(
+        TimeSeriesPoint{s.name, static_cast<uint64_t>(secs), s.value});
   }
 
   void write_event(const EventRecord &) override {
@@ -66,10 +74,15 @@ public:
     // GameDB while events route to spdlog without complaint.
   }
 
-  void flush() override {}
+  // Barrier: returns once every sample enqueued so far is committed.
+  void flush() override {
+    if (writer_) {
+      writer_->flush();
+    }
+  }
 
 private:
-  GameDBHandler *db_;
+  GameDBWriter *writer_;
 };
 
 class SpdlogSinkImpl final : public Sink {
@@ -119,17 +132,17 @@ private:
 
 } // namespace
 
-std::unique_ptr<Sink> makeSink(const SinkVariant &cfg, GameDBHandler *db) {
+std::unique_ptr<Sink> makeSink(const SinkVariant &cfg, GameDBWriter *writer) {
   return std::visit(
-      [db](const auto &v) -> std::unique_ptr<Sink> {
+      [writer](const auto &v) -> std::unique_ptr<Sink> {
         using T = std::decay_t<decltype(v)>;
         if constexpr (std::is_same_v<T, GameDBSink>) {
-          if (db == nullptr) {
+          if (writer == nullptr) {
             // Caller logged the warn at registration time; return null so
             // tick() skips this sink.
             return nullptr;
           }
-          return std::make_unique<GameDBSinkImpl>(db);
+          return std::make_unique<GameDBSinkImpl>(writer);
         } else if constexpr (std::is_same_v<T, SpdlogSink>) {
           return std::make_unique<SpdlogSinkImpl>(v);
         }
@@ -140,17 +153,58 @@ std::unique_ptr<Sink> makeSink(const SinkVariant &cfg, GameDBHandler *db) {
 
 // ─── Handle implementations ───────────────────────────────────────────
 
+namespace {
+
+// Counters are bumped from every worker pool (water, physics, perception),
+// so a single shared atomic turns each inc() into a cache-line transfer
+// between cores. Instead each counter owns a fixed set of cache-line-padded
+// shards; a thread always hits the same shard, and the shards are only
+// summed when the Registry flushes. With more threads than shards two
+// threads share a line again, but that degrades to today's cost rather
+// than breaking correctness — every shard is still an atomic.
+constexpr std::size_t kCounterShards = 32; // power of two
+constexpr std::size_t kCacheLineBytes = 64;
+
+std::size_t counterShardIndex() noexcept {
+  static std::atomic<std::size_t> next_shard{0};
+  thread_local const std::size_t shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) &
+      (kCounterShards - 1);
+  return shard;
+}
+
+} // namespace
+
 struct Counter::Impl {
+  struct alignas(kCacheLineBytes) Shard {
+    std::atomic<std::uint64_t> value{0};
+  };
+
   std::string name;
   std::atomic<bool> active{true};
-  std::atomic<std::uint64_t> value{0};
+  std::array<Shard, kCounterShards> shards;
 
+  void add(std::uint64_t delta) noexcept {
+    shards[counterShardIndex()].value.fetch_add(delta,
+                                                std::memory_order_relaxed);
+  }
+
+  // Per-shard exchange: an inc() racing the flush lands either in this
+  // window or the next one, never in neither.
   std::uint64_t snapshot_and_reset() noexcept {
-    return value.exchange(0, std::memory_order_acq_rel);
+    std::uint64_t total = 0;
+    for (auto &s : shards) {
+      total += s.value.exchange(0, std::memory_order_acq_rel);
+    }
+    return total;
   }
 
   std::uint64_t peek() const noexcept {
-    return value.load(std::memory_order_acquire);
+    std::uint64_t total = 0;
+    for (const auto &s : shards) {
+      total += s.value.load(std::memory_order_acquire);
+    }
+    return total;
   }
 };
 
@@ -164,7 +218,7 @@ void Counter::inc(std::uint64_t delta) noexcept {
   if (!impl_->active.load(std::memory_order_relaxed)) {
     return;
   }
-  impl_->value.fetch_add(delta, std::memory_order_relaxed);
+  impl_->add(delta);
 }
 
 bool Counter::enabled() const noexcept {
@@ -259,6 +313,174 @@ bool Gauge::enabled() const noexcept {
   return impl_ && impl_->active.load(std::memory_order_relaxed);
 }
 
+// ─── Histogram ────────────────────────────────────────────────────────
+// Log-linear buckets in the style of HdrHistogram: values below 32 get a
+// bucket each, and every power of two above that is split into 16 linear
+// sub-buckets, so a bucket is never wider than 1/16 of its lower bound.
+// Values are clamped at 2^40 (~18 minutes in nanoseconds), which keeps the
+// table at 592 buckets. Shards reuse the Counter thread→shard mapping and
+// are allocated on a thread's first record(), so a histogram touched by
+// two threads costs two tables, not kCounterShards.
+
+namespace {
+
+constexpr unsigned kHistSubBucketBits = 4;
+constexpr std::uint64_t kHistSubBuckets = std::uint64_t{1} << kHistSubBucketBits;
+constexpr unsigned kHistMaxValueBits = 40;
+constexpr std::size_t kHistBuckets =
+    (kHistMaxValueBits - kHistSubBucketBits + 1) * kHistSubBuckets;
+
+std::size_t histBucketIndex(std::uint64_t v) noexcept {
+  v = std::min(v, (std::uint64_t{1} << kHistMaxValueBits) - 1);
+  if (v < 2 * kHistSubBuckets) {
+    return static_cast<std::size_t>(v);
+  }
+  const unsigned shift =
+      static_cast<unsigned>(std::bit_width(v)) - 1 - kHistSubBucketBits;
+  return static_cast<std::size_t>(shift * kHistSubBuckets + (v >> shift));
+}
+
+std::uint64_t histBucketLower(std::size_t idx) noexcept {
+  if (idx < 2 * kHistSubBuckets) {
+    return idx;
+  }
+  const std::uint64_t shift = idx / kHistSubBuckets - 1;
+  return (idx - shift * kHistSubBuckets) << shift;
+}
+
+// Highest value that maps to `idx` — what HdrHistogram reports for a
+// percentile, so p99 never under-states the tail.
+std::uint64_t histBucketUpper(std::size_t idx) noexcept {
+  if (idx < 2 * kHistSubBuckets) {
+    return idx;
+  }
+  const std::uint64_t shift = idx / kHistSubBuckets - 1;
+  return histBucketLower(idx) + (std::uint64_t{1} << shift) - 1;
+}
+
+struct HistogramShard {
+  std::array<std::atomic<std::uint64_t>, kHistBuckets> buckets{};
+  std::atomic<std::uint64_t> max{0};
+};
+
+struct HistogramSnapshot {
+  std::uint64_t count = 0;
+  double p50 = 0.0;
+  double p90 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+};
+
+} // namespace
+
+struct Histogram::Impl {
+  std::string name;
+  std::atomic<bool> active{true};
+  std::array<std::atomic<HistogramShard *>, kCounterShards> shards{};
+
+  Impl() = default;
+  Impl(const Impl &) = delete;
+  Impl &operator=(const Impl &) = delete;
+  ~Impl() {
+    for (auto &slot : shards) {
+      delete slot.load(std::memory_order_acquire);
+    }
+  }
+
+  void record(std::uint64_t v) noexcept {
+    auto &slot = shards[counterShardIndex()];
+    HistogramShard *shard = slot.load(std::memory_order_acquire);
+    if (shard == nullptr) {
+      auto *fresh = new (std::nothrow) HistogramShard();
+      if (fresh == nullptr) {
+        return;
+      }
+      if (slot.compare_exchange_strong(shard, fresh,
+                                       std::memory_order_acq_rel,
+                                       std::memory_order_acquire)) {
+        shard = fresh;
+      } else {
+        delete fresh; // Another thread mapped to this slot won the race.
+      }
+    }
+    shard->buckets[histBucketIndex(v)].fetch_add(1, std::memory_order_relaxed);
+    auto seen = shard->max.load(std::memory_order_relaxed);
+    while (v > seen && !shard->max.compare_exchange_weak(
+                           seen, v, std::memory_order_relaxed)) {
+    }
+  }
+
+  // Drains every shard into one table and resolves the percentiles. A
+  // record() racing the drain can land its bucket in this window and its
+  // max in the next; the max is clamped to the highest populated bucket.
+  HistogramSnapshot snapshot_and_reset() noexcept {
+    std::array<std::uint64_t, kHistBuckets> merged{};
+    HistogramSnapshot out;
+    std::uint64_t max_seen = 0;
+    for (auto &slot : shards) {
+      HistogramShard *shard = slot.load(std::memory_order_acquire);
+      if (shard == nullptr) {
+        continue;
+      }
+      for (std::size_t i = 0; i < kHistBuckets; ++i) {
+        auto n = shard->buckets[i].exchange(0, std::memory_order_acq_rel);
+        merged[i] += n;
+        out.count += n;
+      }
+      max_seen = std::max(
+          max_seen, shard->max.exchange(0, std::memory_order_acq_rel));
+    }
+    if (out.count == 0) {
+      return out;
+    }
+
+    std::size_t top = kHistBuckets - 1;
+    while (merged[top] == 0) {
+      --top;
+    }
+    const std::uint64_t max_value =
+        std::clamp(max_seen, histBucketLower(top), histBucketUpper(top));
+
+    auto percentile = [&](double q) {
+      const auto rank = static_cast<std::uint64_t>(
+          std::ceil(q * static_cast<double>(out.count)));
+      std::uint64_t seen = 0;
+      for (std::size_t i = 0; i <= top; ++i) {
+        seen += merged[i];
+        if (seen >= std::max<std::uint64_t>(rank, 1)) {
+          return static_cast<double>(std::min(histBucketUpper(i), max_value));
+        }
+      }
+      return static_cast<double>(max_value);
+    };
+    out.p50 = percentile(0.50);
+    out.p90 = percentile(0.90);
+    out.p99 = percentile(0.99);
+    out.max = static_cast<double>(max_value);
+    return out;
+  }
+};
+
+void Histogram::record(std::uint64_t value) noexcept {
+  if constexpr (!kEnabled) {
+    return;
+  }
+  if (!impl_) {
+    return;
+  }
+  if (!impl_->active.load(std::memory_order_relaxed)) {
+    return;
+  }
+  impl_->record(value);
+}
+
+bool Histogram::enabled() const noexcept {
+  if constexpr (!kEnabled) {
+    return false;
+  }
+  return impl_ && impl_->active.load(std::memory_order_relaxed);
+}
+
 struct EventLogger::Impl {
   std::string channel;
   std::vector<std::string> required_keys;
@@ -334,22 +556,60 @@ struct GaugeEntry {
   std::chrono::steady_clock::time_point next_flush;
 };
 
+struct HistogramEntry {
+  std::shared_ptr<Histogram::Impl> impl;
+  std::vector<std::unique_ptr<Sink>> sinks;
+  std::chrono::milliseconds flush_every{1000};
+  std::chrono::steady_clock::time_point next_flush;
+};
+
 struct EventEntry {
   std::shared_ptr<EventLogger::Impl> impl;
 };
 
+// One histogram window fans out into a series per statistic. Empty
+// windows write nothing, matching a Gauge with no samples.
+void writeHistogram(HistogramEntry &entry, const std::string &name,
+                    std::chrono::system_clock::time_point ts) {
+  auto snap = entry.impl->snapshot_and_reset();
+  if (snap.count == 0) {
+    return;
+  }
+  const std::pair<const char *, double> stats[] = {
+      {".p50", snap.p50}, {".p90", snap.p90}, {".p99", snap.p99}, {".max", snap.max}};
+  for (const auto &[suffix, value] : stats) {
+    MetricSample sample{name + suffix, ts, value, AggFn::Max};
+    for (auto &s : entry.sinks) {
+      if (s) {
+        s->write_metric(sample);
+      }
+    }
+  }
+}
+
 } // namespace
 
 struct Registry::State {
   std::mutex mu; // Guards registration, tick, enable/disable.
   Registry::InitOptions opts;
   bool initialized = false;
+  // Started by initialize() when a GameDBHandler is supplied; every
+  // GameDBSink registered afterwards enqueues into it.
+  std::unique_ptr<GameDBWriter> writer;
   bool warned_missing_db = false;
 
   std::unordered_map<std::string, CounterEntry> counters;
   std::unordered_map<std::string, GaugeEntry> gauges;
+  std::unordered_map<std::string, HistogramEntry> histograms;
   std::unordered_map<std::string, EventEntry> events;
 
+  // Counters, gauges and histograms all land in the same GameDB series
+  // namespace, so their names must not collide.
+  bool hasMetric(const std::string &name) const {
+    return counters.count(name) || gauges.count(name) ||
+           histograms.count(name);
+  }
+
   // Names disabled before registration so a late-registered handle still
   // honours the gate.
   std::unordered_set<std::string> disable_globs;
@@ -368,9 +628,9 @@ struct Registry::State {
     std::vector<std::unique_ptr<Sink>> out;
     out.reserve(cfgs.size());
     for (const auto &cfg : cfgs) {
-      auto sink = makeSink(cfg, opts.gamedb_handler);
+      auto sink = makeSink(cfg, writer.get());
       if (sink == nullptr && std::holds_alternative<GameDBSink>(cfg) &&
-          opts.gamedb_handler == nullptr && !warned_missing_db) {
+          writer == nullptr && !warned_missing_db) {
         spdlog::warn("diag: GameDBSink registered for '{}' but Registry "
                      "initialised without a GameDBHandler — dropping samples",
                      name);
@@ -395,20 +655,64 @@ void Registry::initialize(const InitOptions &opts) {
   state_->opts = opts;
   state_->initialized = true;
   state_->warned_missing_db = false;
+  state_->writer.reset();
+  if (opts.gamedb_handler != nullptr) {
+    state_->writer =
+        std::make_unique<GameDBWriter>(opts.gamedb_handler, opts.writer);
+  }
 }
 
 void Registry::shutdown() {
   flush_all();
   std::lock_guard<std::mutex> lk(state_->mu);
+  // Drop the sinks before the writer so no handle can enqueue into a
+  // stopped writer, then join it while the GameDBHandler is still alive.
+  state_->counters.clear();
+  state_->gauges.clear();
+  state_->histograms.clear();
+  state_->events.clear();
+  state_->writer.reset();
   state_->initialized = false;
 }
 
+void Registry::detach_gamedb(const GameDBHandler *handler) {
+  {
+    std::lock_guard<std::mutex> lk(state_->mu);
+    if (state_->writer == nullptr || state_->opts.gamedb_handler != handler) {
+      return;
+    }
+  }
+  flush_all();
+  std::lock_guard<std::mutex> lk(state_->mu);
+  if (state_->opts.gamedb_handler != handler) {
+    return;
+  }
+  // Null sinks are skipped, as for a GameDBSink registered without a
+  // writer.
+  auto dropGameDBSinks = [](auto &entries) {
+    for (auto &[name, entry] : entries) {
+      for (auto &s : entry.sinks) {
+        if (dynamic_cast<GameDBSinkImpl *>(s.get()) != nullptr) {
+          s.reset();
+        }
+      }
+    }
+  };
+  dropGameDBSinks(state_->counters);
+  dropGameDBSinks(state_->gauges);
+  dropGameDBSinks(state_->histograms);
+  state_->writer.reset();
+  state_->opts.gamedb_handler = nullptr;
+}
+
 void Registry::reset_for_testing() {
   std::lock_guard<std::mutex> lk(state_->mu);
   state_->counters.clear();
   state_->gauges.clear();
+  state_->histograms.clear();
   state_->events.clear();
   state_->disable_globs.clear();
+  state_->writer.reset();
   state_->opts = InitOptions{};
   state_->initialized = false;
   state_->warned_missing_db = false;
@@ -416,7 +720,7 @@ void Registry::reset_for_testing() {
 
 Counter Registry::counter(const CounterConfig &cfg) {
   std::lock_guard<std::mutex> lk(state_->mu);
-  if (state_->counters.count(cfg.name) || state_->gauges.count(cfg.name)) {
+  if (state_->hasMetric(cfg.name)) {
     throw std::runtime_error("diag::Registry::counter: duplicate name '" +
                              cfg.name + "'");
   }
@@ -438,7 +742,7 @@ Counter Registry::counter(const CounterConfig &cfg) {
 
 Gauge Registry::gauge(const GaugeConfig &cfg) {
   std::lock_guard<std::mutex> lk(state_->mu);
-  if (state_->counters.count(cfg.name) || state_->gauges.count(cfg.name)) {
+  if (state_->hasMetric(cfg.name)) {
     throw std::runtime_error("diag::Registry::gauge: duplicate name '" +
                              cfg.name + "'");
   }
@@ -459,6 +763,28 @@ Gauge Registry::gauge(const GaugeConfig &cfg) {
   return g;
 }
 
+Histogram Registry::histogram(const HistogramConfig &cfg) {
+  std::lock_guard<std::mutex> lk(state_->mu);
+  if (state_->hasMetric(cfg.name)) {
+    throw std::runtime_error("diag::Registry::histogram: duplicate name '" +
+                             cfg.name + "'");
+  }
+  auto impl = std::make_shared<Histogram::Impl>();
+  impl->name = cfg.name;
+  if (state_->isDisabledByGlob(cfg.name)) {
+    impl->active.store(false);
+  }
+  HistogramEntry entry;
+  entry.impl = impl;
+  entry.sinks = state_->buildSinks(cfg.sinks, cfg.name);
+  entry.flush_every = cfg.flush_every;
+  entry.next_flush = std::chrono::steady_clock::now() + cfg.flush_every;
+  state_->histograms.emplace(cfg.name, std::move(entry));
+  Histogram h;
+  h.impl_ = std::move(impl);
+  return h;
+}
+
 EventLogger Registry::event(const EventConfig &cfg) {
   std::lock_guard<std::mutex> lk(state_->mu);
   if (state_->events.count(cfg.channel)) {
@@ -518,6 +844,14 @@ void Registry::tick() {
     }
     entry.next_flush = now + entry.flush_every;
   }
+
+  for (auto &[name, entry] : state_->histograms) {
+    if (now < entry.next_flush) {
+      continue;
+    }
+    writeHistogram(entry, name, wall_now);
+    entry.next_flush = now + entry.flush_every;
+  }
 }
 
 void Registry::flush_all() {
@@ -525,13 +859,15 @@ void Registry::flush_all() {
   auto now = std::chrono::system_clock::now();
   auto steady_now = std::chrono::steady_clock::now();
 
+  // Write every sample first and flush sinks afterwards, so the GameDB
+  // writer commits the whole flush as one batch instead of one
+  // transaction (and one barrier round-trip) per metric.
   for (auto &[name, entry] : state_->counters) {
     auto value = entry.impl->snapshot_and_reset();
     MetricSample sample{name, now, static_cast<double>(value), AggFn::Sum};
     for (auto &s : entry.sinks) {
       if (s) {
         s->write_metric(sample);
-        s->flush();
       }
     }
     entry.next_flush = steady_now + entry.flush_every;
@@ -543,12 +879,46 @@ void Registry::flush_all() {
       for (auto &s : entry.sinks) {
         if (s) {
           s->write_metric(sample);
-          s->flush();
         }
       }
     }
     entry.next_flush = steady_now + entry.flush_every;
   }
+  for (auto &[name, entry] : state_->histograms) {
+    writeHistogram(entry, name, now);
+    entry.next_flush = steady_now + entry.flush_every;
+  }
+
+  auto flushSinks = [](auto &entries) {
+    for (auto &[name, entry] : entries) {
+      for (auto &s : entry.sinks) {
+        if (s) {
+          s->flush();
+        }
+      }
+    }
+  };
+  flushSinks(state_->counters);
+  flushSinks(state_->gauges);
+  flushSinks(state_->histograms);
+  if (state_->writer) {
+    state_->writer->flush();
+  }
+}
+
+GameDBWriterStats Registry::writer_stats() const {
+  std::lock_guard<std::mutex> lk(state_->mu);
+  return state_->writer ? state_->writer->stats() : GameDBWriterStats{};
+}
+
+bool Registry::enqueue_time_series(std::string series_name,
+                                   long long timestamp_s, double value) {
+  std::lock_guard<std::mutex> lk(state_->mu);
+  if (!state_->writer) {
+    return false;
+  }
+  return state_->writer->enqueue(TimeSeriesPoint{
+      std::move(series_name), static_cast<uint64_t>(timestamp_s), value});
 }
 
 void Registry::enable(std::string_view name_or_glob) {
@@ -565,6 +935,11 @@ void Registry::enable(std::string_view name_or_glob) {
       entry.impl->active.store(true);
     }
   }
+  for (auto &[name, entry] : state_->histograms) {
+    if (matchesGlob(name_or_glob, name)) {
+      entry.impl->active.store(true);
+    }
+  }
   for (auto &[name, entry] : state_->events) {
     if (matchesGlob(name_or_glob, name)) {
       entry.impl->active.store(true);
@@ -585,6 +960,11 @@ void Registry::disable(std::string_view name_or_glob) {
       entry.impl->active.store(false);
     }
   }
+  for (auto &[name, entry] : state_->histograms) {
+    if (matchesGlob(name_or_glob, name)) {
+      entry.impl->active.store(false);
+    }
+  }
   for (auto &[name, entry] : state_->events) {
     if (matchesGlob(name_or_glob, name)) {
       entry.impl->active.store(false);
@@ -601,6 +981,10 @@ bool Registry::is_enabled(std::string_view name) const {
   if (auto it = state_->gauges.find(key); it != state_->gauges.end()) {
     return it->second.impl->active.load();
   }
+  if (auto it = state_->histograms.find(key);
+      it != state_->histograms.end()) {
+    return it->second.impl->active.load();
+  }
   if (auto it = state_->events.find(key); it != state_->events.end()) {
     return it->second.impl->active.load();
   }
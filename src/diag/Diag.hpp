@@ -2,13 +2,14 @@
 #define AETHERION_DIAG_DIAG_HPP
 
 // Aetherion diagnostic module — a thin wrapper that gives producers four
-// typed handles (Counter, Gauge, EventLogger; Histogram in v2) and a central
+// typed handles (Counter, Gauge, Histogram, EventLogger) and a central
 // Registry that owns cadence/sink configuration. See
 // `.claude/docs/epics-plans/2026-05-08-unified-diagnostic-logging-cpp.md`.
 
 #include <spdlog/common.h>
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <nlohmann/json.hpp>
@@ -41,6 +42,32 @@ struct SpdlogSink {
 
 using SinkVariant = std::variant<GameDBSink, SpdlogSink>;
 
+// ─── GameDB writer thread ─────────────────────────────────────────────
+// GameDBSink samples are handed to a dedicated writer thread through a
+// bounded lock-free queue so `Registry::tick()` never touches SQLite.
+
+// What a producer does when the writer has fallen behind and the queue
+// is full. `Drop` discards the sample (counted in `dropped`); `Block`
+// spins with yield until a slot frees up (counted in `blocked`).
+enum class OverflowPolicy { Drop, Block };
+
+struct GameDBWriterOptions {
+  std::size_t queue_capacity = 8192; // rounded up to a power of two
+  std::size_t max_batch = 1024;      // rows per SQLite transaction
+  std::chrono::milliseconds idle_wait{50};
+  OverflowPolicy overflow = OverflowPolicy::Drop;
+};
+
+struct GameDBWriterStats {
+  std::uint64_t enqueued = 0;
+  std::uint64_t written = 0;
+  std::uint64_t failed = 0;
+  std::uint64_t dropped = 0;
+  std::uint64_t blocked = 0;
+  std::uint64_t batches = 0;
+  std::size_t queue_depth = 0;
+};
+
 // ─── Configuration types ──────────────────────────────────────────────
 
 struct CounterConfig {
@@ -60,6 +87,16 @@ struct GaugeConfig {
   std::vector<SinkVariant> sinks;
 };
 
+// Values are unsigned integers in `unit`; ScopedTimer records nanoseconds.
+// Each flush window emits `<name>.p50`, `.p90`, `.p99` and `.max` series.
+struct HistogramConfig {
+  std::string name;
+  std::string description;
+  std::string unit = "ns";
+  std::chrono::milliseconds flush_every{1000};
+  std::vector<SinkVariant> sinks;
+};
+
 struct EventConfig {
   std::string channel;
   std::vector<std::string> required_keys;
@@ -104,6 +141,51 @@ private:
   std::shared_ptr<Impl> impl_;
 };
 
+// Log-linear (HDR-style) latency distribution. record() is lock-free and
+// touches only the calling thread's shard; percentiles are resolved at
+// flush time to within ~6% of the recorded value.
+class Histogram {
+public:
+  struct Impl;
+
+  Histogram() = default;
+  void record(std::uint64_t value) noexcept;
+  bool enabled() const noexcept;
+
+private:
+  friend class Registry;
+  std::shared_ptr<Impl> impl_;
+};
+
+// Records the lifetime of the scope into `hist`, in nanoseconds. Reads the
+// clock only when the histogram is enabled, so an inert or disabled handle
+// costs one branch.
+class ScopedTimer {
+public:
+  explicit ScopedTimer(Histogram &hist) noexcept
+      : hist_(hist.enabled() ? &hist : nullptr) {
+    if (hist_) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~ScopedTimer() {
+    if (hist_) {
+      auto elapsed = std::chrono::steady_clock::now() - start_;
+      hist_->record(static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count()));
+    }
+  }
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+  Histogram *hist_;
+  std::chrono::steady_clock::time_point start_;
+};
+
 class EventLogger {
 public:
   struct Impl;
@@ -124,19 +206,30 @@ public:
   struct InitOptions {
     GameDBHandler *gamedb_handler = nullptr;
     std::string session_id;
+    GameDBWriterOptions writer;
   };
 
   static Registry &instance();
 
+  // Starts the GameDB writer thread when `gamedb_handler` is set.
   void initialize(const InitOptions &opts);
+  // Flushes every metric, drains the writer queue and joins the writer
+  // thread. Must run before the GameDBHandler passed to initialize() dies.
   void shutdown();
 
+  // For the owner of a GameDBHandler about to die: if the writer thread
+  // writes to `handler`, flushes every metric, joins the writer and
+  // detaches the GameDB sinks. Registrations stay. A no-op once the
+  // Registry has been initialised against another handler.
+  void detach_gamedb(const GameDBHandler *handler);
+
   // Drop all registrations + clear init state. Test helper; not for
   // production use (would invalidate every outstanding handle).
   void reset_for_testing();
 
   Counter counter(const CounterConfig &cfg);
   Gauge gauge(const GaugeConfig &cfg);
+  Histogram histogram(const HistogramConfig &cfg);
   EventLogger event(const EventConfig &cfg);
 
   // Driven from the engine's main update loop. Walks every registered
@@ -145,8 +238,20 @@ public:
   void tick();
 
   // Forced flush of every registered metric — call on graceful shutdown.
+  // Returns once the writer thread has committed every sample handed to
+  // it, so GameDB reads issued afterwards observe the flushed values.
   void flush_all();
 
+  // Writer-thread counters; all zero when no writer is running.
+  GameDBWriterStats writer_stats() const;
+
+  // Hand a raw time-series row to the writer thread. For legacy producers
+  // with dynamic series names that don't own a Counter handle. Returns
+  // false when no writer is running (caller may fall back to a direct
+  // GameDBHandler::putTimeSeries) or the sample was dropped.
+  bool enqueue_time_series(std::string series_name, long long timestamp_s,
+                           double value);
+
   // Runtime gating. Names support a trailing `*` glob (e.g. "water_sim.*").
   void enable(std::string_view name_or_glob);
   void disable(std::string_view name_or_glob);
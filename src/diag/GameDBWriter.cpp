@@ -0,0 +1,140 @@
+#include "diag/GameDBWriter.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <exception>
+#include <utility>
+
+#include "GameDBHandler.hpp"
+
+namespace aetherion::diag {
+
+GameDBWriter::GameDBWriter(GameDBHandler *db, const GameDBWriterOptions &opts)
+    : db_(db), opts_(opts), queue_(opts.queue_capacity) {
+  if (opts_.max_batch == 0) {
+    opts_.max_batch = 1;
+  }
+  thread_ = std::thread([this] { run(); });
+}
+
+GameDBWriter::~GameDBWriter() { stop(); }
+
+bool GameDBWriter::enqueue(TimeSeriesPoint point) noexcept {
+  if (stopping_.load(std::memory_order_relaxed)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  if (queue_.try_push(std::move(point))) {
+    enqueued_.fetch_add(1, std::memory_order_release);
+    return true;
+  }
+  if (opts_.overflow == OverflowPolicy::Drop) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Backpressure: nudge the writer once, then yield until a slot frees.
+  blocked_.fetch_add(1, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    wake_requested_ = true;
+  }
+  wake_cv_.notify_one();
+  while (!queue_.try_push(std::move(point))) {
+    if (stopping_.load(std::memory_order_relaxed)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  enqueued_.fetch_add(1, std::memory_order_release);
+  return true;
+}
+
+void GameDBWriter::flush() {
+  const std::uint64_t target = enqueued_.load(std::memory_order_acquire);
+  std::unique_lock<std::mutex> lk(mu_);
+  wake_requested_ = true;
+  wake_cv_.notify_one();
+  done_cv_.wait(lk, [&] {
+    return processed_.load(std::memory_order_acquire) >= target || exited_;
+  });
+}
+
+void GameDBWriter::stop() {
+  if (!thread_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    stopping_.store(true, std::memory_order_relaxed);
+    wake_requested_ = true;
+  }
+  wake_cv_.notify_one();
+  thread_.join();
+}
+
+GameDBWriterStats GameDBWriter::stats() const noexcept {
+  GameDBWriterStats s;
+  s.enqueued = enqueued_.load(std::memory_order_relaxed);
+  s.written = written_.load(std::memory_order_relaxed);
+  s.failed = failed_.load(std::memory_order_relaxed);
+  s.dropped = dropped_.load(std::memory_order_relaxed);
+  s.blocked = blocked_.load(std::memory_order_relaxed);
+  s.batches = batches_.load(std::memory_order_relaxed);
+  s.queue_depth = queue_.size_approx();
+  return s;
+}
+
+void GameDBWriter::run() {
+  std::vector<TimeSeriesPoint> batch;
+  batch.reserve(opts_.max_batch);
+
+  for (;;) {
+    TimeSeriesPoint point;
+    while (batch.size() < opts_.max_batch && queue_.try_pop(point)) {
+      batch.push_back(std::move(point));
+    }
+    if (!batch.empty()) {
+      commit(batch);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lk(mu_);
+    // Re-check under the lock: a producer may have pushed between the
+    // failed pop and here, and `stopping_` is only final once the queue
+    // is observed empty with it set.
+    if (stopping_.load(std::memory_order_relaxed) &&
+        queue_.size_approx() == 0) {
+      exited_ = true;
+      done_cv_.notify_all();
+      break;
+    }
+    // Timed wait rather than a producer-side notify keeps `enqueue` free
+    // of syscalls; `idle_wait` bounds the latency of a sample landing.
+    wake_cv_.wait_for(lk, opts_.idle_wait, [&] { return wake_requested_; });
+    wake_requested_ = false;
+  }
+}
+
+void GameDBWriter::commit(std::vector<TimeSeriesPoint> &batch) {
+  const auto n = static_cast<std::uint64_t>(batch.size());
+  bool ok = false;
+  try {
+    ok = db_ != nullptr && db_->putTimeSeriesBatch(batch);
+  } catch (const std::exception &e) {
+    spdlog::warn("diag: GameDB writer batch of {} rows threw: {}", n,
+                 e.what());
+  }
+  (ok ? written_ : failed_).fetch_add(n, std::memory_order_relaxed);
+  batches_.fetch_add(1, std::memory_order_relaxed);
+  batch.clear();
+
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    processed_.fetch_add(n, std::memory_order_release);
+  }
+  done_cv_.notify_all();
+}
+
+} // namespace aetherion::diag
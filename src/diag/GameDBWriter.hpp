@@ -0,0 +1,74 @@
+#ifndef AETHERION_DIAG_GAMEDB_WRITER_HPP
+#define AETHERION_DIAG_GAMEDB_WRITER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "GameDB.hpp"
+#include "diag/Diag.hpp"
+#include "diag/MpscQueue.hpp"
+
+class GameDBHandler;
+
+namespace aetherion::diag {
+
+// Owns the thread that moves GameDBSink samples into SQLite. Producers
+// (Registry::tick, flush_all) call `enqueue`, which is a single lock-free
+// push — no SQLite, no mutex, no allocation beyond the sample's own name.
+// The writer drains up to `max_batch` rows at a time and commits each
+// drain as one transaction via GameDBHandler::putTimeSeriesBatch, which
+// also runs the amortised on-disk trim off the tick thread.
+class GameDBWriter {
+public:
+  GameDBWriter(GameDBHandler *db, const GameDBWriterOptions &opts);
+  ~GameDBWriter();
+
+  GameDBWriter(const GameDBWriter &) = delete;
+  GameDBWriter &operator=(const GameDBWriter &) = delete;
+
+  // Returns false if the sample was dropped (OverflowPolicy::Drop with a
+  // full queue, or the writer already stopped).
+  bool enqueue(TimeSeriesPoint point) noexcept;
+
+  // Barrier: blocks until every sample accepted before the call has been
+  // committed (or failed). Safe to call from any thread except the writer.
+  void flush();
+
+  // Drains what is left, then joins the thread. Idempotent.
+  void stop();
+
+  GameDBWriterStats stats() const noexcept;
+
+private:
+  void run();
+  void commit(std::vector<TimeSeriesPoint> &batch);
+
+  GameDBHandler *db_;
+  GameDBWriterOptions opts_;
+  BoundedMpscQueue<TimeSeriesPoint> queue_;
+
+  std::atomic<std::uint64_t> enqueued_{0};
+  std::atomic<std::uint64_t> processed_{0}; // written + failed
+  std::atomic<std::uint64_t> written_{0};
+  std::atomic<std::uint64_t> failed_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<std::uint64_t> blocked_{0};
+  std::atomic<std::uint64_t> batches_{0};
+
+  std::atomic<bool> stopping_{false};
+  mutable std::mutex mu_;           // Guards the two condvars only.
+  std::condition_variable wake_cv_; // flush()/stop()/full queue → writer
+  std::condition_variable done_cv_; // writer → flush() waiters
+  bool wake_requested_ = false;
+  bool exited_ = false; // writer loop returned; flush() must not wait
+
+  std::thread thread_;
+};
+
+} // namespace aetherion::diag
+
+#endif // AETHERION_DIAG_GAMEDB_WRITER_HPP
@@ -0,0 +1,106 @@
+#ifndef AETHERION_DIAG_MPSC_QUEUE_HPP
+#define AETHERION_DIAG_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace aetherion::diag {
+
+// Bounded lock-free multi-producer / single-consumer ring buffer.
+//
+// Per-cell sequence numbers (Vyukov's bounded queue) let producers claim a
+// slot with one CAS on `enqueue_pos_` and publish it with a release store,
+// so `try_push` never takes a lock or allocates. The consumer side is
+// single-threaded by contract (the GameDB writer thread) and therefore
+// keeps a plain cursor. Capacity is rounded up to a power of two.
+template <typename T> class BoundedMpscQueue {
+public:
+  explicit BoundedMpscQueue(std::size_t capacity)
+      : capacity_(roundUpPow2(capacity < 2 ? 2 : capacity)),
+        mask_(capacity_ - 1), cells_(new Cell[capacity_]) {
+    for (std::size_t i = 0; i < capacity_; ++i) {
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  BoundedMpscQueue(const BoundedMpscQueue &) = delete;
+  BoundedMpscQueue &operator=(const BoundedMpscQueue &) = delete;
+
+  // Returns false without touching `value` when the ring is full.
+  bool try_push(T &&value) noexcept {
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells_[pos & mask_];
+      std::size_t seq = cell.seq.load(std::memory_order_acquire);
+      auto diff = static_cast<std::intptr_t>(seq) -
+                  static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Consumer-only. Returns false when no published element is available.
+  bool try_pop(T &out) noexcept {
+    Cell &cell = cells_[dequeue_pos_ & mask_];
+    std::size_t seq = cell.seq.load(std::memory_order_acquire);
+    if (static_cast<std::intptr_t>(seq) -
+            static_cast<std::intptr_t>(dequeue_pos_ + 1) <
+        0) {
+      return false;
+    }
+    out = std::move(cell.value);
+    cell.seq.store(dequeue_pos_ + capacity_, std::memory_order_release);
+    ++dequeue_pos_;
+    dequeue_seen_.store(dequeue_pos_, std::memory_order_relaxed);
+    return true;
+  }
+
+  std::size_t capacity() const noexcept { return capacity_; }
+
+  // Racy by nature; only suitable for stats and wake-up heuristics.
+  std::size_t size_approx() const noexcept {
+    std::size_t head = dequeue_seen_.load(std::memory_order_relaxed);
+    std::size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+  }
+
+private:
+  static std::size_t roundUpPow2(std::size_t v) {
+    std::size_t p = 1;
+    while (p < v) {
+      p <<= 1;
+    }
+    return p;
+  }
+
+  struct Cell {
+    std::atomic<std::size_t> seq{0};
+    T value{};
+  };
+
+  const std::size_t capacity_;
+  const std::size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+
+  // Producers hammer `enqueue_pos_`; keep it off the consumer's line.
+  alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+  alignas(64) std::size_t dequeue_pos_ = 0;
+  std::atomic<std::size_t> dequeue_seen_{0};
+};
+
+} // namespace aetherion::diag
+
+#endif // AETHERION_DIAG_MPSC_QUEUE_HPP
@@ -9,10 +9,10 @@
 
 #include "diag/Diag.hpp"
 
-class GameDBHandler;
-
 namespace aetherion::diag {
 
+class GameDBWriter;
+
 struct MetricSample {
   std::string name;
   std::chrono::system_clock::time_point ts;
@@ -37,9 +37,9 @@ public:
 
 // Build a concrete Sink for a SinkVariant. Returns nullptr if the variant
 // resolves to a sink that needs a resource which wasn't provided
-// (e.g. GameDBSink without a handler) — caller logs the warning and the
-// metric quietly drops samples for that sink.
-std::unique_ptr<Sink> makeSink(const SinkVariant &cfg, GameDBHandler *db);
+// (e.g. GameDBSink without a writer thread) — caller logs the warning and
+// the metric quietly drops samples for that sink.
+std::unique_ptr<Sink> makeSink(const SinkVariant &cfg, GameDBWriter *writer);
 
 } // namespace aetherion::diag
 
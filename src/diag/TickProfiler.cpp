@@ -0,0 +1,134 @@
+#include "diag/TickProfiler.hpp"
+
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+namespace aetherion::diag {
+
+std::string_view tickPhaseName(TickPhase phase) noexcept {
+  switch (phase) {
+  case TickPhase::Health:
+    return "health";
+  case TickPhase::DiagTick:
+    return "diag.tick";
+  case TickPhase::DispatcherUpdate:
+    return "dispatcher.update";
+  case TickPhase::Physics:
+    return "physics";
+  case TickPhase::Metabolism:
+    return "metabolism";
+  case TickPhase::Ecosystem:
+    return "ecosystem";
+  case TickPhase::Effects:
+    return "effects";
+  case TickPhase::PythonSystems:
+    return "python_systems";
+  case TickPhase::CommandPlayback:
+    return "command_playback";
+  case TickPhase::EntityDeletion:
+    return "entity_deletion";
+  case TickPhase::AsyncDispatch:
+    return "async_dispatch";
+  case TickPhase::Count:
+    break;
+  }
+  return "unknown";
+}
+
+TickProfiler::TickProfiler(std::size_t capacity)
+    : epoch_(Clock::now()), ring_(std::max<std::size_t>(capacity, 1)) {}
+
+void TickProfiler::beginTick() noexcept {
+  inTick_ = enabled_.load(std::memory_order_relaxed);
+  if (!inTick_) {
+    return;
+  }
+  tickStart_ = Clock::now();
+  current_.tick = nextTick_++;
+  current_.start_ns = sinceEpochNs(tickStart_);
+  current_.phase_offset_ns.fill(0);
+  current_.phase_ns.fill(-1);
+}
+
+void TickProfiler::recordPhase(TickPhase phase, Clock::time_point start,
+                               Clock::time_point end) noexcept {
+  const auto i = static_cast<std::size_t>(phase);
+  auto ns = [](Clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+  };
+  // A phase entered twice in one tick reports its first offset and the
+  // summed duration.
+  if (current_.phase_ns[i] < 0) {
+    current_.phase_offset_ns[i] = ns(start - tickStart_);
+    current_.phase_ns[i] = 0;
+  }
+  current_.phase_ns[i] += ns(end - start);
+}
+
+void TickProfiler::endTick() noexcept {
+  if (!inTick_) {
+    return;
+  }
+  inTick_ = false;
+  current_.total_ns = sinceEpochNs(Clock::now()) - current_.start_ns;
+  std::lock_guard<std::mutex> lk(mu_);
+  ring_[head_] = current_;
+  head_ = (head_ + 1) % ring_.size();
+  size_ = std::min(size_ + 1, ring_.size());
+}
+
+void TickProfiler::setEnabled(bool enabled) noexcept {
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+std::vector<TickSample> TickProfiler::recent(std::size_t n) const {
+  std::lock_guard<std::mutex> lk(mu_);
+  const std::size_t count = (n == 0) ? size_ : std::min(n, size_);
+  std::vector<TickSample> out;
+  out.reserve(count);
+  const std::size_t first = (head_ + ring_.size() - count) % ring_.size();
+  for (std::size_t k = 0; k < count; ++k) {
+    out.push_back(ring_[(first + k) % ring_.size()]);
+  }
+  return out;
+}
+
+std::string
+TickProfiler::chromeTraceJson(const std::vector<TickSample> &ticks) {
+  nlohmann::json events = nlohmann::json::array();
+  auto us = [](std::int64_t ns) { return static_cast<double>(ns) / 1000.0; };
+  for (const auto &t : ticks) {
+    events.push_back({{"name", "World::update"},
+                      {"cat", "tick"},
+                      {"ph", "X"},
+                      {"ts", us(t.start_ns)},
+                      {"dur", us(t.total_ns)},
+                      {"pid", 1},
+                      {"tid", 1},
+                      {"args", {{"tick", t.tick}}}});
+    for (std::size_t i = 0; i < kTickPhaseCount; ++i) {
+      if (t.phase_ns[i] < 0) {
+        continue;
+      }
+      events.push_back(
+          {{"name", tickPhaseName(static_cast<TickPhase>(i))},
+           {"cat", "phase"},
+           {"ph", "X"},
+           {"ts", us(t.start_ns + t.phase_offset_ns[i])},
+           {"dur", us(t.phase_ns[i])},
+           {"pid", 1},
+           {"tid", 1}});
+    }
+  }
+  nlohmann::json doc = {{"traceEvents", std::move(events)},
+                        {"displayTimeUnit", "ms"}};
+  return doc.dump();
+}
+
+void TickProfiler::clear() {
+  std::lock_guard<std::mutex> lk(mu_);
+  head_ = 0;
+  size_ = 0;
+}
+
+} // namespace aetherion::diag
@@ -0,0 +1,129 @@
+#ifndef AETHERION_DIAG_TICK_PROFILER_HPP
+#define AETHERION_DIAG_TICK_PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aetherion::diag {
+
+// Phases of World::update(), in the order they run. Names are what
+// get_tick_profile() and the Chrome trace report.
+enum class TickPhase : std::uint8_t {
+  Health,
+  DiagTick,
+  DispatcherUpdate,
+  Physics,
+  Metabolism,
+  Ecosystem,
+  Effects,
+  PythonSystems,
+  CommandPlayback,
+  EntityDeletion,
+  AsyncDispatch,
+  Count
+};
+
+inline constexpr std::size_t kTickPhaseCount =
+    static_cast<std::size_t>(TickPhase::Count);
+
+std::string_view tickPhaseName(TickPhase phase) noexcept;
+
+// One completed tick. Offsets are relative to the tick's own start; a
+// phase that did not run this tick has `phase_ns == -1`.
+struct TickSample {
+  std::uint64_t tick = 0;
+  std::int64_t start_ns = 0; // since the profiler was constructed
+  std::int64_t total_ns = 0;
+  std::array<std::int64_t, kTickPhaseCount> phase_offset_ns{};
+  std::array<std::int64_t, kTickPhaseCount> phase_ns{};
+};
+
+// Always-on phase timer for the main tick, for builds without Tracy.
+// Each tick costs two steady_clock reads per phase and one short lock to
+// publish the finished sample into a fixed-size ring, so the tick thread
+// never allocates. Readers (Python, trace export) copy out under the same
+// lock. Only the thread driving World::update() may call beginTick /
+// phase / endTick.
+class TickProfiler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit TickProfiler(std::size_t capacity = 1024);
+
+  class PhaseScope {
+  public:
+    PhaseScope(TickProfiler *owner, TickPhase phase) noexcept
+        : owner_(owner), phase_(phase) {
+      if (owner_) {
+        start_ = Clock::now();
+      }
+    }
+    ~PhaseScope() {
+      if (owner_) {
+        owner_->recordPhase(phase_, start_, Clock::now());
+      }
+    }
+    PhaseScope(const PhaseScope &) = delete;
+    PhaseScope &operator=(const PhaseScope &) = delete;
+
+  private:
+    TickProfiler *owner_;
+    TickPhase phase_;
+    Clock::time_point start_;
+  };
+
+  void beginTick() noexcept;
+  void endTick() noexcept;
+  // Inert when profiling is disabled or no tick is open.
+  PhaseScope phase(TickPhase phase) noexcept {
+    return PhaseScope(inTick_ ? this : nullptr, phase);
+  }
+
+  void setEnabled(bool enabled) noexcept;
+  bool enabled() const noexcept {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  // Up to `n` most recent ticks, oldest first. `n == 0` means all.
+  std::vector<TickSample> recent(std::size_t n) const;
+
+  // Chrome trace-event JSON ("X" complete events, microseconds) for ticks
+  // taken from recent(). Load in chrome://tracing or Perfetto.
+  static std::string chromeTraceJson(const std::vector<TickSample> &ticks);
+
+  void clear();
+
+private:
+  void recordPhase(TickPhase phase, Clock::time_point start,
+                   Clock::time_point end) noexcept;
+
+  std::int64_t sinceEpochNs(Clock::time_point t) const noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t - epoch_)
+        .count();
+  }
+
+  const Clock::time_point epoch_;
+  std::atomic<bool> enabled_{true};
+
+  // Tick-thread state; not shared.
+  bool inTick_ = false;
+  Clock::time_point tickStart_;
+  TickSample current_;
+  std::uint64_t nextTick_ = 0;
+
+  mutable std::mutex mu_; // Guards the ring below.
+  std::vector<TickSample> ring_;
+  std::size_t head_ = 0; // next slot to write
+  std::size_t size_ = 0;
+};
+
+} // namespace aetherion::diag
+
+#endif // AETHERION_DIAG_TICK_PROFILER_HPP
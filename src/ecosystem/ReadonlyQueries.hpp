@@ -13,11 +13,13 @@
 #include "physics/ReadonlyQueries.hpp"
 #include "voxelgrid/VoxelGrid.hpp"
 
-inline std::tuple<bool, bool> isNeighborWaterOrEmpty(entt::registry &registry,
-                                                     VoxelGrid &voxelGrid,
-                                                     const int x, const int y,
-                                                     const int z) {
-  int64_t terrainNeighborId = voxelGrid.getTerrain(x, y, z);
+// The optional `stencil` (see physics/StencilReads.hpp) needs TERRAIN_ID |
+// ENTITY_TYPE.
+inline std::tuple<bool, bool>
+isNeighborWaterOrEmpty(entt::registry &registry, VoxelGrid &voxelGrid,
+                       const int x, const int y, const int z,
+                       const TerrainStencil *stencil = nullptr) {
+  int64_t terrainNeighborId = terrainIdAt(voxelGrid, stencil, x, y, z);
   bool isNeighborEmpty =
       (terrainNeighborId == static_cast<int64_t>(TerrainIdTypeEnum::NONE));
   bool isTerrainNeighborSoftEmpty{false};
@@ -29,9 +31,7 @@ inline std::tuple<bool, bool> isNeighborWaterOrEmpty(entt::registry &registry,
     isTerrainNeighborSoftEmpty = getTypeAndCheckSoftEmpty(
         registry, voxelGrid, terrainNeighborId, x, y, z);
     EntityTypeComponent typeNeighbor =
-        voxelGrid.terrainGridRepository->getTerrainEntityType(x, y, z);
-    MatterContainer matterContainerNeighbor =
-        voxelGrid.terrainGridRepository->getTerrainMatterContainer(x, y, z);
+        terrainEntityTypeAt(voxelGrid, stencil, x, y, z);
     isNeighborWater =
         (typeNeighbor.mainType == static_cast<int>(EntityEnum::TERRAIN) &&
          typeNeighbor.subType0 == static_cast<int>(TerrainEnum::WATER));
@@ -40,11 +40,11 @@ inline std::tuple<bool, bool> isNeighborWaterOrEmpty(entt::registry &registry,
   return std::make_tuple(isNeighborEmpty, isNeighborWater);
 }
 
-inline bool isTerrainVoxelEmptyOrSoftEmpty(entt::registry &registry,
-                                           VoxelGrid &voxelGrid,
-                                           EventSink &sink, const int x,
-                                           const int y, const int z) {
-  int64_t terrainId = voxelGrid.getTerrain(x, y, z);
+inline bool isTerrainVoxelEmptyOrSoftEmpty(
+    entt::registry &registry, VoxelGrid &voxelGrid, EventSink &sink,
+    const int x, const int y, const int z,
+    const TerrainStencil *stencil = nullptr) {
+  int64_t terrainId = terrainIdAt(voxelGrid, stencil, x, y, z);
   if (terrainId < static_cast<int64_t>(TerrainIdTypeEnum::NONE)) {
     // Value below NONE(-2): this should not happen with Int64Grid storage.
     // Log and treat voxel as non-empty as a safety guard.
@@ -71,8 +71,7 @@ inline bool isTerrainVoxelEmptyOrSoftEmpty(entt::registry &registry,
     return false;
   } else if (terrainId > 0) {
     // Voxel has terrain — check if it's "soft empty" (e.g., EMPTY subtype)
-    EntityTypeComponent type =
-        voxelGrid.terrainGridRepository->getTerrainEntityType(x, y, z);
+    EntityTypeComponent type = terrainEntityTypeAt(voxelGrid, stencil, x, y, z);
     const bool isSoftEmpty{isTerrainSoftEmpty(type)};
     return isSoftEmpty;
   }
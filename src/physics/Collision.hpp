@@ -4,12 +4,15 @@
 #include <entt/entt.hpp>
 
 #include "components/EntityTypeComponent.hpp"
+#include "physics/StencilReads.hpp"
 #include "voxelgrid/VoxelGrid.hpp"
 
+// `stencil`, when given, should be centred on `position` and carry
+// TERRAIN_ID | ENTITY_TYPE; reads it does not cover go to the repository.
 inline std::tuple<bool, int, int, int>
 hasSpecialCollision(entt::registry &registry, VoxelGrid &voxelGrid,
                     Position position, int movingToX, int movingToY,
-                    int movingToZ) {
+                    int movingToZ, const TerrainStencil *stencil = nullptr) {
   bool collision = false;
   int newMovingToX, newMovingToY, newMovingToZ;
   // Check if the movement is within bounds for x, y, z
@@ -19,15 +22,14 @@ hasSpecialCollision(entt::registry &registry, VoxelGrid &voxelGrid,
     // int movingToEntityId = voxelGrid.getEntity(movingToX, movingToY,
     // movingToZ);
     bool movingToSameZTerrainExists =
-        voxelGrid.checkIfTerrainExists(movingToX, movingToY, movingToZ);
-    bool movingToBellowTerrainExists =
-        voxelGrid.checkIfTerrainExists(movingToX, movingToY, movingToZ - 1);
+        terrainExistsAt(voxelGrid, stencil, movingToX, movingToY, movingToZ);
+    bool movingToBellowTerrainExists = terrainExistsAt(
+        voxelGrid, stencil, movingToX, movingToY, movingToZ - 1);
 
     // Check if there is an entity or terrain blocking the destination
     if (movingToSameZTerrainExists) {
-      EntityTypeComponent etc =
-          voxelGrid.terrainGridRepository->getTerrainEntityType(
-              movingToX, movingToY, movingToZ);
+      EntityTypeComponent etc = terrainEntityTypeAt(
+          voxelGrid, stencil, movingToX, movingToY, movingToZ);
       // subType1 == 1 means ramp_east
       if (etc.subType1 == 1) {
         collision = true;
@@ -51,9 +53,8 @@ hasSpecialCollision(entt::registry &registry, VoxelGrid &voxelGrid,
         newMovingToZ = movingToZ + 1;
       }
     } else if (movingToBellowTerrainExists) {
-      EntityTypeComponent etc =
-          voxelGrid.terrainGridRepository->getTerrainEntityType(
-              movingToX, movingToY, movingToZ - 1);
+      EntityTypeComponent etc = terrainEntityTypeAt(
+          voxelGrid, stencil, movingToX, movingToY, movingToZ - 1);
       // subType1 == 1 means ramp_east
       if (etc.subType1 == 1) {
         collision = true;
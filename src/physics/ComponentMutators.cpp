@@ -52,18 +52,11 @@ void ensurePositionComponentForTerrain(entt::registry &registry,
 }
 
 void convertIntoSoftEmpty(entt::registry &registry, entt::entity &terrain) {
-  EntityTypeComponent *terrainType =
-      registry.try_get<EntityTypeComponent>(terrain);
-  bool shouldEmplaceTerrainType{terrainType == nullptr};
-  if (terrainType == nullptr) {
-    terrainType = new EntityTypeComponent();
-  }
-  terrainType->mainType = static_cast<int>(EntityEnum::TERRAIN);
-  terrainType->subType0 = static_cast<int>(TerrainEnum::EMPTY);
-  terrainType->subType1 = 0;
-  if (shouldEmplaceTerrainType) {
-    registry.emplace<EntityTypeComponent>(terrain, *terrainType);
-  }
+  // Replace rather than write through try_get so the type change reaches
+  // on_update listeners (World's EntityTypeIndex).
+  registry.emplace_or_replace<EntityTypeComponent>(
+      terrain, static_cast<int>(EntityEnum::TERRAIN),
+      static_cast<int>(TerrainEnum::EMPTY), 0);
 
   StructuralIntegrityComponent *terrainSI =
       registry.try_get<StructuralIntegrityComponent>(terrain);
@@ -82,18 +75,11 @@ void convertIntoSoftEmpty(entt::registry &registry, entt::entity &terrain) {
 void setEmptyWaterComponentsEnTT(entt::registry &registry,
                                  entt::entity &terrain,
                                  MatterState matterState) {
-  EntityTypeComponent *terrainType =
-      registry.try_get<EntityTypeComponent>(terrain);
-  bool shouldEmplaceTerrainType{terrainType == nullptr};
-  if (terrainType == nullptr) {
-    terrainType = new EntityTypeComponent();
-  }
-  terrainType->mainType = static_cast<int>(EntityEnum::TERRAIN);
-  terrainType->subType0 = static_cast<int>(TerrainEnum::WATER);
-  terrainType->subType1 = 0;
-  if (shouldEmplaceTerrainType) {
-    registry.emplace<EntityTypeComponent>(terrain, *terrainType);
-  }
+  // Replace rather than write through try_get so the type change reaches
+  // on_update listeners (World's EntityTypeIndex).
+  registry.emplace_or_replace<EntityTypeComponent>(
+      terrain, static_cast<int>(EntityEnum::TERRAIN),
+      static_cast<int>(TerrainEnum::WATER), 0);
 
   StructuralIntegrityComponent *terrainSI =
       registry.try_get<StructuralIntegrityComponent>(terrain);
@@ -0,0 +1,124 @@
+#ifndef PHYSICS_GRAVITY_SLEEP_HPP
+#define PHYSICS_GRAVITY_SLEEP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "components/PhysicsComponents.hpp"
+#include "terrain/VoxelCoord.hpp"
+#include "terrain/VoxelCoordMap.hpp"
+
+// Entities the gravity pass found resting on something and has stopped
+// re-checking. Whether an entity can fall depends only on its own voxel and
+// the voxel below it (checkIfCanFall / checkIfTerrainCanFall), so a
+// sleeper is woken when either of those shows up in the VoxelGrid's
+// support-change log. Moving, being destroyed or being re-created at the
+// voxel all write the entity grid or the terrain grid there, so they wake
+// it too. A Position emplaced or replaced without touching either grid is
+// caught by connect() instead.
+//
+// Owned by PhysicsEngine and only touched from the gravity pass (under
+// physicsMutex); the Position signals may fire on any thread and only
+// queue the entity for the next wakeRepositioned().
+class GravitySleep {
+public:
+  GravitySleep() = default;
+  GravitySleep(const GravitySleep &) = delete;
+  GravitySleep &operator=(const GravitySleep &) = delete;
+
+  // Hooks the Position construct/update signals of `registry`. Pair with
+  // disconnect() before either side is destroyed.
+  void connect(entt::registry &registry) {
+    registry.on_construct<Position>()
+        .connect<&GravitySleep::onPositionSet>(*this);
+    registry.on_update<Position>().connect<&GravitySleep::onPositionSet>(
+        *this);
+  }
+
+  void disconnect(entt::registry &registry) {
+    registry.on_construct<Position>()
+        .disconnect<&GravitySleep::onPositionSet>(*this);
+    registry.on_update<Position>().disconnect<&GravitySleep::onPositionSet>(
+        *this);
+  }
+
+  bool asleep(entt::entity entity) const {
+    return cellOf_.find(entity) != nullptr;
+  }
+
+  void sleep(entt::entity entity, const VoxelCoord &cell) {
+    if (asleep(entity)) {
+      return;
+    }
+    cellOf_.set(entity, cell);
+    byCell_[cell].push_back(entity);
+  }
+
+  // Wakes the entities whose Position was emplaced or replaced since the
+  // last call. Returns how many woke.
+  std::size_t wakeRepositioned() {
+    {
+      std::lock_guard<std::mutex> lock(repositionedMutex_);
+      draining_.swap(repositioned_);
+    }
+    std::size_t woken = 0;
+    for (entt::entity entity : draining_) {
+      woken += cellOf_.erase(entity);
+    }
+    draining_.clear();
+    return woken;
+  }
+
+  // Wakes the sleepers at `changed` (their own voxel changed) and the one
+  // above it (their support changed). Returns how many woke.
+  std::size_t wakeAround(const VoxelCoord &changed) {
+    return wakeCell(changed) +
+           wakeCell(VoxelCoord{changed.x, changed.y, changed.z + 1});
+  }
+
+  std::size_t wakeAll() {
+    const std::size_t woken = cellOf_.size();
+    byCell_.clear();
+    cellOf_.clear();
+    return woken;
+  }
+
+  std::size_t size() const { return cellOf_.size(); }
+
+private:
+  void onPositionSet(entt::registry &, entt::entity entity) {
+    std::lock_guard<std::mutex> lock(repositionedMutex_);
+    repositioned_.push_back(entity);
+  }
+
+  std::size_t wakeCell(const VoxelCoord &cell) {
+    std::vector<entt::entity> *sleepers = byCell_.find(cell);
+    if (!sleepers) {
+      return 0;
+    }
+    std::size_t woken = 0;
+    for (entt::entity entity : *sleepers) {
+      // Entries can outlive their entity (destroyed, id recycled) until the
+      // voxel is next written; only count the ones still recorded here.
+      const VoxelCoord *at = cellOf_.find(entity);
+      if (at && *at == cell) {
+        cellOf_.erase(entity);
+        ++woken;
+      }
+    }
+    byCell_.erase(cell);
+    return woken;
+  }
+
+  VoxelCoordMap<std::vector<entt::entity>> byCell_;
+  EntityVoxelIndex cellOf_;
+  std::mutex repositionedMutex_;
+  std::vector<entt::entity> repositioned_;
+  std::vector<entt::entity> draining_; // gravity pass only
+};
+
+#endif // PHYSICS_GRAVITY_SLEEP_HPP
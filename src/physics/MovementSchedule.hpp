@@ -0,0 +1,182 @@
+#ifndef PHYSICS_MOVEMENT_SCHEDULE_HPP
+#define PHYSICS_MOVEMENT_SCHEDULE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "components/MovingComponent.hpp"
+
+// Hashed timer wheel of in-flight MovingComponents, keyed on the physics
+// tick at which each move completes. processPhysics used to walk every
+// MovingComponent each tick just to decrement timeRemaining; with the
+// schedule a tick only touches the moves that finish on it.
+//
+// Ticks count advance() calls. A component emplaced with timeRemaining T
+// before the advance() of tick k is due on tick k + T, the same tick the
+// old decrement-and-check loop would have completed it on. Entries more
+// than kSlots ticks out share a slot with nearer ones and are kept back
+// until their own tick comes round.
+//
+// connect() keeps the schedule in step with the registry through the
+// MovingComponent construct/update/destroy signals, so moves started
+// anywhere (physics mutators, the repository, Python set_component) are
+// picked up. Writing timeRemaining in place through get<>() bypasses the
+// signals; use replace()/patch() to reschedule a running move.
+//
+// The registry's timeRemaining keeps the value the move started with;
+// readers outside processPhysics call refreshTimeRemaining() first.
+//
+// Main thread only, like the rest of processPhysics.
+class MovementSchedule {
+public:
+  static constexpr std::size_t kSlots = 256; // power of two
+
+  MovementSchedule() = default;
+  MovementSchedule(const MovementSchedule &) = delete;
+  MovementSchedule &operator=(const MovementSchedule &) = delete;
+
+  // Hooks the MovingComponent signals of `registry` and schedules the
+  // components it already holds. Pair with disconnect() before either
+  // side is destroyed.
+  void connect(entt::registry &registry) {
+    registry.on_construct<MovingComponent>()
+        .connect<&MovementSchedule::onMovingChanged>(*this);
+    registry.on_update<MovingComponent>()
+        .connect<&MovementSchedule::onMovingChanged>(*this);
+    registry.on_destroy<MovingComponent>()
+        .connect<&MovementSchedule::onMovingDestroyed>(*this);
+    for (auto [entity, moving] : registry.view<MovingComponent>().each()) {
+      schedule(entity, moving.timeRemaining);
+    }
+  }
+
+  void disconnect(entt::registry &registry) {
+    registry.on_construct<MovingComponent>()
+        .disconnect<&MovementSchedule::onMovingChanged>(*this);
+    registry.on_update<MovingComponent>()
+        .disconnect<&MovementSchedule::onMovingChanged>(*this);
+    registry.on_destroy<MovingComponent>()
+        .disconnect<&MovementSchedule::onMovingDestroyed>(*this);
+  }
+
+  // (Re)schedules `entity` to complete `ticks` advance() calls from now.
+  // While advance() is running, anything due now lands on the next tick.
+  void schedule(entt::entity entity, int ticks) {
+    uint64_t due = tick_ + static_cast<uint64_t>(std::max(ticks, 0));
+    if (draining_ && due <= tick_) {
+      due = tick_ + 1;
+    }
+    const std::size_t i = indexOf(entity);
+    if (i >= byEntity_.size()) {
+      byEntity_.resize(std::max<std::size_t>(i + 1, byEntity_.size() * 2));
+    }
+    if (byEntity_[i].entity != entity) {
+      ++size_;
+    }
+    // A superseded wheel entry is left behind and skipped when its slot
+    // comes round, since byEntity_ no longer matches it.
+    byEntity_[i] = Entry{entity, due};
+    wheel_[due & kMask].push_back(Entry{entity, due});
+  }
+
+  void cancel(entt::entity entity) {
+    const std::size_t i = indexOf(entity);
+    if (i < byEntity_.size() && byEntity_[i].entity == entity) {
+      byEntity_[i].entity = entt::null;
+      --size_;
+    }
+  }
+
+  bool scheduled(entt::entity entity) const {
+    const std::size_t i = indexOf(entity);
+    return i < byEntity_.size() && byEntity_[i].entity == entity;
+  }
+
+  // advance() calls left before `entity` completes, or -1 when it is not
+  // scheduled. This is what MovingComponent::timeRemaining would read
+  // under the old per-tick decrement.
+  int ticksRemaining(entt::entity entity) const {
+    const std::size_t i = indexOf(entity);
+    if (i >= byEntity_.size() || byEntity_[i].entity != entity) {
+      return -1;
+    }
+    return static_cast<int>(byEntity_[i].due - tick_);
+  }
+
+  // Writes ticksRemaining(entity) into `moving.timeRemaining`. A move that
+  // is not scheduled keeps its value. Writing the refreshed value back with
+  // replace() leaves the move due on the same tick.
+  void refreshTimeRemaining(entt::entity entity,
+                            MovingComponent &moving) const {
+    const int ticks = ticksRemaining(entity);
+    if (ticks >= 0) {
+      moving.timeRemaining = ticks;
+    }
+  }
+
+  // Unschedules every entity due on the current tick, calls fn(entity)
+  // for each, then moves on to the next tick. Returns how many fired.
+  // fn may schedule or cancel entities, including the one it was given.
+  template <typename Fn> std::size_t advance(Fn &&fn) {
+    firing_.clear();
+    firing_.swap(wheel_[tick_ & kMask]);
+    draining_ = true;
+    std::size_t fired = 0;
+    for (const Entry &entry : firing_) {
+      const std::size_t i = indexOf(entry.entity);
+      if (i >= byEntity_.size() || byEntity_[i].entity != entry.entity ||
+          byEntity_[i].due != entry.due) {
+        continue; // cancelled or rescheduled since
+      }
+      if (entry.due != tick_) {
+        wheel_[tick_ & kMask].push_back(entry); // due on a later lap
+        continue;
+      }
+      byEntity_[i].entity = entt::null;
+      --size_;
+      ++fired;
+      fn(entry.entity);
+    }
+    draining_ = false;
+    ++tick_;
+    return fired;
+  }
+
+  // Number of scheduled entities.
+  std::size_t size() const { return size_; }
+  uint64_t currentTick() const { return tick_; }
+
+private:
+  static constexpr uint64_t kMask = kSlots - 1;
+  static_assert((kSlots & kMask) == 0, "kSlots must be a power of two");
+
+  struct Entry {
+    entt::entity entity = entt::null;
+    uint64_t due = 0;
+  };
+
+  static std::size_t indexOf(entt::entity entity) {
+    return static_cast<std::size_t>(entt::to_entity(entity));
+  }
+
+  void onMovingChanged(entt::registry &registry, entt::entity entity) {
+    schedule(entity, registry.get<MovingComponent>(entity).timeRemaining);
+  }
+  void onMovingDestroyed(entt::registry &, entt::entity entity) {
+    cancel(entity);
+  }
+
+  std::array<std::vector<Entry>, kSlots> wheel_;
+  std::vector<Entry> byEntity_; // indexed by entity id
+  std::vector<Entry> firing_;   // slot being drained, reused across ticks
+  uint64_t tick_ = 0;
+  std::size_t size_ = 0;
+  bool draining_ = false;
+};
+
+#endif // PHYSICS_MOVEMENT_SCHEDULE_HPP
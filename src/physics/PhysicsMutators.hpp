@@ -1319,17 +1319,18 @@ inline void createWaterTerrainFromFall(entt::registry &registry,
 }
 
 // Definition: src/physics/mutators/WaterPhysicsMutators.cpp
-void setGravityFlowWaterTargetDefaults(VoxelGrid &voxelGrid,
+void setGravityFlowWaterTargetDefaults(TerrainWriteBatch &batch,
                                        const Position &targetPos,
                                        const PhysicsStats &physicsStats);
 
 // Definition: src/physics/mutators/WaterPhysicsMutators.cpp
-void setGravityFlowEmptySourceDefaults(VoxelGrid &voxelGrid,
+void setGravityFlowEmptySourceDefaults(TerrainWriteBatch &batch,
                                        const Position &sourcePos);
 
+// Queues the destination writes on `batch`; the caller applies it.
 inline void createWaterTerrainFromGravityFlow(
-    VoxelGrid &voxelGrid, const Position &targetPos, int targetTerrainId,
-    const PhysicsStats &sourcePhysicsStats) {
+    VoxelGrid &voxelGrid, TerrainWriteBatch &batch, const Position &targetPos,
+    int targetTerrainId, const PhysicsStats &sourcePhysicsStats) {
   if (!voxelGrid.terrainGridRepository) {
     spdlog::warn("createWaterTerrainFromGravityFlow: missing "
                  "terrainGridRepository");
@@ -1355,13 +1356,13 @@ inline void createWaterTerrainFromGravityFlow(
       existingType.subType0 != static_cast<int>(TerrainEnum::WATER);
 
   if (destinationNeedsScaffolding) {
-    setGravityFlowWaterTargetDefaults(voxelGrid, gravityTargetPos,
+    setGravityFlowWaterTargetDefaults(batch, gravityTargetPos,
                                       sourcePhysicsStats);
   }
 
-  voxelGrid.terrainGridRepository->setTerrainId(
-      gravityTargetPos.x, gravityTargetPos.y, gravityTargetPos.z,
-      static_cast<int>(TerrainIdTypeEnum::ON_GRID_STORAGE), false);
+  batch.setTerrainId(gravityTargetPos.x, gravityTargetPos.y,
+                     gravityTargetPos.z,
+                     static_cast<int>(TerrainIdTypeEnum::ON_GRID_STORAGE));
 
   // Seed an initial downward gravity velocity so the newly-flowed water
   // voxel enters the VDB velocity grid and keeps falling on subsequent
@@ -1373,9 +1374,8 @@ inline void createWaterTerrainFromGravityFlow(
                            gravityTargetPos.z - 1) ==
           static_cast<int64_t>(TerrainIdTypeEnum::NONE)) {
     float gravityKick = PhysicsManager::Instance()->getGravity();
-    voxelGrid.terrainGridRepository->setVelocity(
-        gravityTargetPos.x, gravityTargetPos.y, gravityTargetPos.z,
-        Velocity{0.0f, 0.0f, -gravityKick});
+    batch.setVelocity(gravityTargetPos.x, gravityTargetPos.y,
+                      gravityTargetPos.z, Velocity{0.0f, 0.0f, -gravityKick});
   }
 }
 
@@ -1827,7 +1827,10 @@ void _handleWaterSpreadEvent(VoxelGrid &voxelGrid,
 inline void _handleWaterGravityFlowEvent(entt::registry &registry,
                                          EventSink &sink, VoxelGrid &voxelGrid,
                                          const WaterGravityFlowEvent &event) {
-  TerrainGridLock lock(voxelGrid.terrainGridRepository.get());
+  TerrainRegionLock lock(
+      voxelGrid.terrainGridRepository.get(),
+      {{event.source.x, event.source.y, event.source.z},
+       {event.target.x, event.target.y, event.target.z}});
 
   const int sourceTerrainId =
       voxelGrid.getTerrain(event.source.x, event.source.y, event.source.z);
@@ -1871,12 +1874,14 @@ inline void _handleWaterGravityFlowEvent(entt::registry &registry,
       (targetType.mainType == static_cast<int>(EntityEnum::TERRAIN) &&
        targetType.subType0 == static_cast<int>(TerrainEnum::EMPTY));
 
+  // Scaffolding and both matter writes go out as one batch.
+  TerrainWriteBatch batch(TerrainWriteOrder::BY_LEAF);
   if (targetTerrainId == static_cast<int>(TerrainIdTypeEnum::NONE) ||
       (isTargetEmptyTerrain &&
        targetTerrainId ==
            static_cast<int>(TerrainIdTypeEnum::ON_GRID_STORAGE))) {
-    createWaterTerrainFromGravityFlow(voxelGrid, event.target, targetTerrainId,
-                                      sourcePhysicsStats);
+    createWaterTerrainFromGravityFlow(voxelGrid, batch, event.target,
+                                      targetTerrainId, sourcePhysicsStats);
   }
 
   // Apply transfer using up-to-date state
@@ -1887,13 +1892,14 @@ inline void _handleWaterGravityFlowEvent(entt::registry &registry,
   _logIfViolatingMatterWrite("_handleWaterGravityFlowEvent:target",
                              event.target.x, event.target.y, event.target.z,
                              currentTarget);
-  voxelGrid.terrainGridRepository->setTerrainMatterContainer(
-      event.target.x, event.target.y, event.target.z, currentTarget);
+  batch.setTerrainMatterContainer(event.target.x, event.target.y,
+                                  event.target.z, currentTarget);
   _logIfViolatingMatterWrite("_handleWaterGravityFlowEvent:source",
                              event.source.x, event.source.y, event.source.z,
                              currentSource);
-  voxelGrid.terrainGridRepository->setTerrainMatterContainer(
-      event.source.x, event.source.y, event.source.z, currentSource);
+  batch.setTerrainMatterContainer(event.source.x, event.source.y,
+                                  event.source.z, currentSource);
+  voxelGrid.terrainGridRepository->applyWriteBatch(batch);
 
   EntityTypeComponent sourceType = voxelGrid.getTerrainEntityTypeComponent(
       event.source.x, event.source.y, event.source.z);
@@ -128,7 +128,7 @@ bool getTypeAndCheckSoftEmpty(entt::registry &registry, VoxelGrid &voxelGrid,
 bool hasCollision(entt::registry &registry, VoxelGrid &voxelGrid,
                   entt::entity entity, int movingFromX, int movingFromY,
                   int movingFromZ, int movingToX, int movingToY, int movingToZ,
-                  bool isTerrain) {
+                  bool isTerrain, const TerrainStencil *stencil) {
   bool collision = false;
   // Check if the movement is within bounds for x, y, z
   if ((0 <= movingToX && movingToX < voxelGrid.width) &&
@@ -136,7 +136,7 @@ bool hasCollision(entt::registry &registry, VoxelGrid &voxelGrid,
       (0 <= movingToZ && movingToZ < voxelGrid.depth)) {
     int movingToEntityId = voxelGrid.getEntity(movingToX, movingToY, movingToZ);
     bool terrainExists =
-        voxelGrid.checkIfTerrainExists(movingToX, movingToY, movingToZ);
+        terrainExistsAt(voxelGrid, stencil, movingToX, movingToY, movingToZ);
 
     bool entityCollision = false;
     if (movingToEntityId != -1) {
@@ -146,11 +146,13 @@ bool hasCollision(entt::registry &registry, VoxelGrid &voxelGrid,
     bool terrainCollision = false;
     if (terrainExists) {
       EntityTypeComponent etc =
-          getEntityTypeComponent(registry, voxelGrid, entity, movingFromX,
-                                 movingFromY, movingFromZ, isTerrain);
-      EntityTypeComponent terrainEtc =
-          voxelGrid.terrainGridRepository->getTerrainEntityType(
-              movingToX, movingToY, movingToZ);
+          isTerrain ? terrainEntityTypeAt(voxelGrid, stencil, movingFromX,
+                                          movingFromY, movingFromZ)
+                    : getEntityTypeComponent(registry, voxelGrid, entity,
+                                             movingFromX, movingFromY,
+                                             movingFromZ, isTerrain);
+      EntityTypeComponent terrainEtc = terrainEntityTypeAt(
+          voxelGrid, stencil, movingToX, movingToY, movingToZ);
       // Any terrain that is different than water
       if (etc.mainType == static_cast<int>(EntityEnum::TERRAIN)) {
         terrainCollision = true;
@@ -176,7 +178,7 @@ bool hasCollision(entt::registry &registry, VoxelGrid &voxelGrid,
 std::tuple<int, int, int, float> calculateMovementDestination(
     entt::registry &registry, VoxelGrid &voxelGrid, const Position &position,
     Velocity &velocity, const PhysicsStats &physicsStats, float newVelocityX,
-    float newVelocityY, float newVelocityZ) {
+    float newVelocityY, float newVelocityZ, const TerrainStencil *stencil) {
   float completionTime =
       calculateTimeToMove(newVelocityX, newVelocityY, newVelocityZ);
   int movingToX = position.x + getDirectionFromVelocity(newVelocityX);
@@ -187,7 +189,7 @@ std::tuple<int, int, int, float> calculateMovementDestination(
   int newMovingToX, newMovingToY, newMovingToZ;
   std::tie(specialCollision, newMovingToX, newMovingToY, newMovingToZ) =
       hasSpecialCollision(registry, voxelGrid, position, movingToX, movingToY,
-                          movingToZ);
+                          movingToZ, stencil);
 
   if (specialCollision) {
     movingToX = newMovingToX;
@@ -15,6 +15,13 @@
 // Forward declarations
 struct MoveSolidEntityEvent;
 
+// Everything checkBelowStability, calculateMovementDestination and
+// hasCollision read from terrain around a moving voxel. Load once per move
+// with TerrainGridRepository::getStencil(x, y, z, kMovementStencilFields).
+inline constexpr uint32_t kMovementStencilFields = StencilField::TERRAIN_ID |
+                                                   StencilField::ENTITY_TYPE |
+                                                   StencilField::FLAGS;
+
 // Helper function to determine direction from velocity
 int getDirectionFromVelocity(float velocity);
 
@@ -85,13 +92,15 @@ bool getTypeAndCheckSoftEmpty(entt::registry &registry, VoxelGrid &voxelGrid,
 
 bool isTerrainSoftEmpty(EntityTypeComponent &terrainType);
 
-// Helper: Check if position below entity is stable
+// Helper: Check if position below entity is stable. `stencil`, when given,
+// should be centred on `position` and carry TERRAIN_ID | FLAGS.
 inline bool checkBelowStability(entt::registry &registry, VoxelGrid &voxelGrid,
-                                const Position &position) {
+                                const Position &position,
+                                const TerrainStencil *stencil = nullptr) {
   int bellowEntityId =
       voxelGrid.getEntity(position.x, position.y, position.z - 1);
-  bool bellowTerrainExists =
-      voxelGrid.checkIfTerrainExists(position.x, position.y, position.z - 1);
+  bool bellowTerrainExists = terrainExistsAt(voxelGrid, stencil, position.x,
+                                             position.y, position.z - 1);
 
   if (bellowEntityId != -1) {
     entt::entity bellowEntity = static_cast<entt::entity>(bellowEntityId);
@@ -99,23 +108,24 @@ inline bool checkBelowStability(entt::registry &registry, VoxelGrid &voxelGrid,
         registry.try_get<StructuralIntegrityComponent>(bellowEntity);
     return bellowEntitySic && bellowEntitySic->canStackEntities;
   } else if (bellowTerrainExists) {
-    StructuralIntegrityComponent bellowTerrainSic =
-        voxelGrid.terrainGridRepository->getTerrainStructuralIntegrity(
-            position.x, position.y, position.z - 1);
-    return bellowTerrainSic.canStackEntities;
+    return terrainCanStackEntitiesAt(voxelGrid, stencil, position.x,
+                                     position.y, position.z - 1);
   }
   return false;
 }
 
+// The optional `stencil` below is the one loaded for checkBelowStability();
+// see kMovementStencilFields.
 std::tuple<int, int, int, float> calculateMovementDestination(
     entt::registry &registry, VoxelGrid &voxelGrid, const Position &position,
     Velocity &velocity, const PhysicsStats &physicsStats, float newVelocityX,
-    float newVelocityY, float newVelocityZ);
+    float newVelocityY, float newVelocityZ,
+    const TerrainStencil *stencil = nullptr);
 
 bool hasCollision(entt::registry &registry, VoxelGrid &voxelGrid,
                   entt::entity entity, int movingFromX, int movingFromY,
                   int movingFromZ, int movingToX, int movingToY, int movingToZ,
-                  bool isTerrain);
+                  bool isTerrain, const TerrainStencil *stencil = nullptr);
 
 // Helper: Print exhaustive terrain diagnostics for debugging
 inline void printTerrainDiagnostics(entt::registry &registry,
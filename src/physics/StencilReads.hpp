@@ -0,0 +1,71 @@
+#ifndef PHYSICS_STENCIL_READS_HPP
+#define PHYSICS_STENCIL_READS_HPP
+
+#include <cstdint>
+
+#include "components/EntityTypeComponent.hpp"
+#include "components/TerrainComponents.hpp"
+#include "terrain/TerrainStorage.hpp"
+#include "voxelgrid/VoxelGrid.hpp"
+
+// Terrain reads for neighbour-heavy queries. Each helper answers from
+// `stencil` when it was loaded with the needed StencilField group and covers
+// the voxel, and falls back to a regular repository read otherwise, so a
+// caller can pass nullptr or a stencil centred somewhere else and still get
+// the right answer.
+
+inline bool stencilServes(const TerrainStencil *stencil, uint32_t fields,
+                          int x, int y, int z) {
+  return stencil && (stencil->fields & fields) == fields &&
+         stencil->covers(x, y, z);
+}
+
+inline int64_t terrainIdAt(VoxelGrid &voxelGrid, const TerrainStencil *stencil,
+                           int x, int y, int z) {
+  if (stencilServes(stencil, StencilField::TERRAIN_ID, x, y, z)) {
+    return stencil->terrainId[stencil->at(x, y, z)];
+  }
+  return voxelGrid.getTerrain(x, y, z);
+}
+
+inline bool terrainExistsAt(VoxelGrid &voxelGrid,
+                            const TerrainStencil *stencil, int x, int y,
+                            int z) {
+  if (stencilServes(stencil, StencilField::TERRAIN_ID, x, y, z)) {
+    return stencil->terrainExists(stencil->at(x, y, z));
+  }
+  return voxelGrid.checkIfTerrainExists(x, y, z);
+}
+
+inline EntityTypeComponent terrainEntityTypeAt(VoxelGrid &voxelGrid,
+                                               const TerrainStencil *stencil,
+                                               int x, int y, int z) {
+  if (stencilServes(stencil, StencilField::ENTITY_TYPE, x, y, z)) {
+    const int i = stencil->at(x, y, z);
+    return EntityTypeComponent{stencil->mainType[i], stencil->subType0[i],
+                               stencil->subType1[i]};
+  }
+  return voxelGrid.terrainGridRepository->getTerrainEntityType(x, y, z);
+}
+
+inline MatterContainer terrainMatterAt(VoxelGrid &voxelGrid,
+                                       const TerrainStencil *stencil, int x,
+                                       int y, int z) {
+  if (stencilServes(stencil, StencilField::MATTER, x, y, z)) {
+    return stencil->matter[stencil->at(x, y, z)];
+  }
+  return voxelGrid.terrainGridRepository->getTerrainMatterContainer(x, y, z);
+}
+
+inline bool terrainCanStackEntitiesAt(VoxelGrid &voxelGrid,
+                                      const TerrainStencil *stencil, int x,
+                                      int y, int z) {
+  if (stencilServes(stencil, StencilField::FLAGS, x, y, z)) {
+    return stencil->canStackEntities[stencil->at(x, y, z)];
+  }
+  return voxelGrid.terrainGridRepository
+      ->getTerrainStructuralIntegrity(x, y, z)
+      .canStackEntities;
+}
+
+#endif // PHYSICS_STENCIL_READS_HPP
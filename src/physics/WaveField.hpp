@@ -0,0 +1,324 @@
+#ifndef PHYSICS_WAVE_FIELD_HPP
+#define PHYSICS_WAVE_FIELD_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "terrain/VoxelCoord.hpp"
+#include "terrain/VoxelCoordMap.hpp"
+
+// Scalar wave field for WavePhysicsEngine's FIELD mode. Amplitude lives in
+// dense 8x8x8 tiles that exist only where the field is non-negligible, so
+// memory and step cost follow the volume the waves currently cover rather
+// than the number of wave packets times their neighbourhood.
+//
+// step() advances the damped wave equation
+//     u' = (2u - u_prev + c^2 * laplacian(u)) * (1 - damping)
+// with the 7-point stencil (dx = dt = 1). Each tile is copied into a padded
+// 10^3 block together with one layer from its six neighbours, so the inner
+// loop runs over contiguous x with no branches and vectorises. The result
+// is written over u_prev in place (each voxel only needs its own u_prev),
+// and a parity bit swaps the roles of the two buffers. c must stay below
+// 1/sqrt(3) for the scheme to be stable; advance() substeps to keep it
+// under kMaxCourant.
+//
+// Tiles are created next to any face whose amplitude exceeds the threshold
+// and dropped once both buffers have decayed below it. Voxels outside
+// [0, extent) are never written and read as zero.
+//
+// Not thread-safe; owned by WavePhysicsEngine.
+class WaveField {
+public:
+  static constexpr int kTile = 8;
+  static constexpr float kMaxCourant = 0.5f;
+
+  WaveField() = default;
+  WaveField(int width, int height, int depth) { resize(width, height, depth); }
+
+  void resize(int width, int height, int depth) {
+    extent_ = {width, height, depth};
+    clear();
+  }
+
+  void clear() {
+    tiles_.clear();
+    index_.clear();
+  }
+
+  // Adds a pulse peaking at `amplitude` on (x, y, z), with zero initial
+  // velocity. The pulse is a small Gaussian rather than a single voxel: a
+  // one-voxel spike is almost all grid-scale content, which the stencil
+  // carries too slowly and leaves ringing behind.
+  void inject(int x, int y, int z, float amplitude) {
+    constexpr float kInvTwoSigma2 = 1.0f / (2.0f * kPulseSigma * kPulseSigma);
+    for (int dz = -kPulseRadius; dz <= kPulseRadius; ++dz) {
+      for (int dy = -kPulseRadius; dy <= kPulseRadius; ++dy) {
+        for (int dx = -kPulseRadius; dx <= kPulseRadius; ++dx) {
+          const float r2 = static_cast<float>(dx * dx + dy * dy + dz * dz);
+          add(x + dx, y + dy, z + dz,
+              amplitude * std::exp(-r2 * kInvTwoSigma2));
+        }
+      }
+    }
+  }
+
+  // Advances by one tick of waves travelling `speed` voxels per tick,
+  // losing `damping` of their amplitude per voxel travelled.
+  void advance(float speed, float damping, float threshold) {
+    if (speed <= 0.0f || tiles_.empty()) {
+      return;
+    }
+    const int substeps =
+        std::max(1, static_cast<int>(std::ceil(speed / kMaxCourant)));
+    const float c = speed / static_cast<float>(substeps);
+    const float keep = std::clamp(1.0f - damping * c, 0.0f, 1.0f);
+    for (int s = 0; s < substeps; ++s) {
+      step(c * c, keep, threshold);
+    }
+  }
+
+  // One finite-difference step with Courant number squared `c2`.
+  void step(float c2, float keep, float threshold) {
+    grow(threshold);
+
+    const int cur = parity_;
+    const int prev = parity_ ^ 1;
+    for (std::size_t t = 0; t < tiles_.size(); ++t) {
+      gather(t, cur);
+      Tile &tile = tiles_[t];
+      float *out = tile.u[prev].data();
+      for (int z = 0; z <= tile.hi.z; ++z) {
+        for (int y = 0; y <= tile.hi.y; ++y) {
+          const float *row = &padded_[pad(0, y + 1, z + 1)];
+          const float *up = &padded_[pad(0, y + 2, z + 1)];
+          const float *down = &padded_[pad(0, y, z + 1)];
+          const float *front = &padded_[pad(0, y + 1, z + 2)];
+          const float *back = &padded_[pad(0, y + 1, z)];
+          float *o = out + local(0, y, z);
+          for (int x = 0; x <= tile.hi.x; ++x) {
+            const float centre = row[x + 1];
+            const float lap = row[x] + row[x + 2] + up[x + 1] + down[x + 1] +
+                              front[x + 1] + back[x + 1] - 6.0f * centre;
+            o[x] = (2.0f * centre - o[x] + c2 * lap) * keep;
+          }
+        }
+      }
+    }
+    parity_ = prev;
+
+    retire(threshold);
+  }
+
+  // Current amplitude at a voxel (0 where no tile is live).
+  float sample(int x, int y, int z) const {
+    const uint32_t *t = index_.find(tileOf(x, y, z));
+    return t ? tiles_[*t].u[parity_][local(x, y, z)] : 0.0f;
+  }
+
+  const VoxelCoord &extent() const { return extent_; }
+  std::size_t activeTiles() const { return tiles_.size(); }
+  std::size_t activeVoxels() const {
+    return tiles_.size() * static_cast<std::size_t>(kTileVoxels);
+  }
+
+private:
+  static constexpr int kTileVoxels = kTile * kTile * kTile;
+  static constexpr int kPulseRadius = 4;
+  static constexpr float kPulseSigma = 1.5f;
+  static constexpr int kPad = kTile + 2;
+
+  struct Tile {
+    VoxelCoord key;
+    VoxelCoord hi; // last in-bounds local voxel on each axis
+    std::array<std::array<float, kTileVoxels>, 2> u{};
+  };
+
+  static int floorDiv(int v) {
+    return v >= 0 ? v / kTile : -((-v + kTile - 1) / kTile);
+  }
+  static VoxelCoord tileOf(int x, int y, int z) {
+    return VoxelCoord{floorDiv(x), floorDiv(y), floorDiv(z)};
+  }
+  static int local(int x, int y, int z) {
+    const int lx = x - floorDiv(x) * kTile;
+    const int ly = y - floorDiv(y) * kTile;
+    const int lz = z - floorDiv(z) * kTile;
+    return (lz * kTile + ly) * kTile + lx;
+  }
+  static int pad(int x, int y, int z) { return (z * kPad + y) * kPad + x; }
+
+  void add(int x, int y, int z, float value) {
+    if (!inBounds(x, y, z)) {
+      return;
+    }
+    Tile &tile = tileAt(tileOf(x, y, z));
+    const int i = local(x, y, z);
+    tile.u[0][i] += value;
+    tile.u[1][i] += value;
+  }
+
+  bool inBounds(int x, int y, int z) const {
+    return x >= 0 && y >= 0 && z >= 0 && x < extent_.x && y < extent_.y &&
+           z < extent_.z;
+  }
+  bool tileInBounds(const VoxelCoord &key) const {
+    return key.x >= 0 && key.y >= 0 && key.z >= 0 &&
+           key.x * kTile < extent_.x && key.y * kTile < extent_.y &&
+           key.z * kTile < extent_.z;
+  }
+
+  Tile &tileAt(const VoxelCoord &key) {
+    if (const uint32_t *slot = index_.find(key)) {
+      return tiles_[*slot];
+    }
+    index_[key] = static_cast<uint32_t>(tiles_.size());
+    Tile &tile = tiles_.emplace_back();
+    tile.key = key;
+    const VoxelCoord base{key.x * kTile, key.y * kTile, key.z * kTile};
+    tile.hi = VoxelCoord{std::min(kTile, extent_.x - base.x) - 1,
+                         std::min(kTile, extent_.y - base.y) - 1,
+                         std::min(kTile, extent_.z - base.z) - 1};
+    return tile;
+  }
+
+  const Tile *neighbour(const VoxelCoord &key, int dx, int dy, int dz) const {
+    const uint32_t *t =
+        index_.find(VoxelCoord{key.x + dx, key.y + dy, key.z + dz});
+    return t ? &tiles_[*t] : nullptr;
+  }
+
+  // Copies tile t's buffer `which`, plus one layer from each face
+  // neighbour, into padded_.
+  void gather(std::size_t t, int which) {
+    std::fill(padded_.begin(), padded_.end(), 0.0f);
+    const Tile &tile = tiles_[t];
+    const auto &src = tile.u[which];
+    for (int z = 0; z < kTile; ++z) {
+      for (int y = 0; y < kTile; ++y) {
+        std::copy_n(&src[local(0, y, z)], kTile,
+                    &padded_[pad(1, y + 1, z + 1)]);
+      }
+    }
+    const VoxelCoord &k = tile.key;
+    const int last = kTile - 1;
+    if (const Tile *n = neighbour(k, -1, 0, 0)) {
+      for (int z = 0; z < kTile; ++z)
+        for (int y = 0; y < kTile; ++y)
+          padded_[pad(0, y + 1, z + 1)] = n->u[which][local(last, y, z)];
+    }
+    if (const Tile *n = neighbour(k, 1, 0, 0)) {
+      for (int z = 0; z < kTile; ++z)
+        for (int y = 0; y < kTile; ++y)
+          padded_[pad(kTile + 1, y + 1, z + 1)] =
+              n->u[which][local(0, y, z)];
+    }
+    if (const Tile *n = neighbour(k, 0, -1, 0)) {
+      for (int z = 0; z < kTile; ++z)
+        std::copy_n(&n->u[which][local(0, last, z)], kTile,
+                    &padded_[pad(1, 0, z + 1)]);
+    }
+    if (const Tile *n = neighbour(k, 0, 1, 0)) {
+      for (int z = 0; z < kTile; ++z)
+        std::copy_n(&n->u[which][local(0, 0, z)], kTile,
+                    &padded_[pad(1, kTile + 1, z + 1)]);
+    }
+    if (const Tile *n = neighbour(k, 0, 0, -1)) {
+      for (int y = 0; y < kTile; ++y)
+        std::copy_n(&n->u[which][local(0, y, last)], kTile,
+                    &padded_[pad(1, y + 1, 0)]);
+    }
+    if (const Tile *n = neighbour(k, 0, 0, 1)) {
+      for (int y = 0; y < kTile; ++y)
+        std::copy_n(&n->u[which][local(0, y, 0)], kTile,
+                    &padded_[pad(1, y + 1, kTile + 1)]);
+    }
+  }
+
+  static constexpr int kFaces[6][3] = {{-1, 0, 0}, {1, 0, 0}, {0, -1, 0},
+                                       {0, 1, 0},  {0, 0, -1}, {0, 0, 1}};
+
+  // Creates the missing neighbour behind every face that carries more
+  // than `threshold`, so the wave has somewhere to go next step.
+  void grow(float threshold) {
+    pending_.clear();
+    for (const Tile &tile : tiles_) {
+      for (const auto &f : kFaces) {
+        const VoxelCoord next{tile.key.x + f[0], tile.key.y + f[1],
+                              tile.key.z + f[2]};
+        if (!tileInBounds(next) || index_.contains(next) ||
+            !faceActive(tile, f, threshold)) {
+          continue;
+        }
+        pending_.push_back(next);
+      }
+    }
+    for (const VoxelCoord &key : pending_) {
+      tileAt(key);
+    }
+  }
+
+  bool faceActive(const Tile &tile, const int (&f)[3], float threshold) const {
+    const auto &u = tile.u[parity_];
+    for (int a = 0; a < kTile; ++a) {
+      for (int b = 0; b < kTile; ++b) {
+        const int x = f[0] < 0 ? 0 : f[0] > 0 ? kTile - 1 : a;
+        const int y = f[1] < 0 ? 0 : f[1] > 0 ? kTile - 1 : (f[0] ? a : b);
+        const int z = f[2] < 0 ? 0 : f[2] > 0 ? kTile - 1 : b;
+        if (std::fabs(u[(z * kTile + y) * kTile + x]) > threshold) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // A tile can go once both of its buffers have decayed below `threshold`
+  // and no neighbour is pushing a wave into it; a tile grow() just made is
+  // still empty, but the wave that asked for it is on its way in.
+  bool quiet(const Tile &tile, float threshold) const {
+    const auto below = [threshold](const auto &u) {
+      return std::all_of(u.begin(), u.end(), [threshold](float v) {
+        return std::fabs(v) <= threshold;
+      });
+    };
+    if (!below(tile.u[0]) || !below(tile.u[1])) {
+      return false;
+    }
+    for (const auto &f : kFaces) {
+      const Tile *n = neighbour(tile.key, f[0], f[1], f[2]);
+      const int back[3] = {-f[0], -f[1], -f[2]};
+      if (n && faceActive(*n, back, threshold)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void retire(float threshold) {
+    for (std::size_t t = 0; t < tiles_.size();) {
+      if (!quiet(tiles_[t], threshold)) {
+        ++t;
+        continue;
+      }
+      index_.erase(tiles_[t].key);
+      if (t + 1 != tiles_.size()) {
+        tiles_[t] = tiles_.back();
+        index_[tiles_[t].key] = static_cast<uint32_t>(t);
+      }
+      tiles_.pop_back();
+    }
+  }
+
+  VoxelCoord extent_{0, 0, 0};
+  std::vector<Tile> tiles_;
+  VoxelCoordMap<uint32_t> index_; // tile key -> index into tiles_
+  std::vector<VoxelCoord> pending_;
+  std::array<float, kPad * kPad * kPad> padded_{};
+  int parity_ = 0; // which of Tile::u holds the current step
+};
+
+#endif // PHYSICS_WAVE_FIELD_HPP
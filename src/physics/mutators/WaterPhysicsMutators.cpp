@@ -64,9 +64,13 @@ void _handleWaterSpreadEvent(VoxelGrid &voxelGrid,
 
   // ────────────────────────────────────────────────────────────────────────
   // Acquire the lock and re-read fresh state. Post-read guards 4 and 5
-  // depend on the up-to-date matter values.
+  // depend on the up-to-date matter values. Only the regions around source
+  // and target are locked, so spreads elsewhere in the world proceed.
   // ────────────────────────────────────────────────────────────────────────
-  TerrainGridLock lock(voxelGrid.terrainGridRepository.get());
+  TerrainRegionLock lock(
+      voxelGrid.terrainGridRepository.get(),
+      {{event.source.x, event.source.y, event.source.z},
+       {event.target.x, event.target.y, event.target.z}});
 
   // Re-read current repository state to avoid TOCTOU races
   MatterContainer currentSource =
@@ -133,18 +137,20 @@ void _handleWaterSpreadEvent(VoxelGrid &voxelGrid,
   currentSource.WaterMatter -= event.amount;
 
   // Update both voxels atomically
+  TerrainWriteBatch batch(TerrainWriteOrder::BY_LEAF);
   _logIfViolatingMatterWrite("_handleWaterSpreadEvent:target", event.target.x,
                              event.target.y, event.target.z, currentTarget);
-  voxelGrid.terrainGridRepository->setTerrainMatterContainer(
-      event.target.x, event.target.y, event.target.z, currentTarget);
+  batch.setTerrainMatterContainer(event.target.x, event.target.y,
+                                  event.target.z, currentTarget);
 
   _logIfViolatingMatterWrite("_handleWaterSpreadEvent:source", event.source.x,
                              event.source.y, event.source.z, currentSource);
-  voxelGrid.terrainGridRepository->setTerrainMatterContainer(
-      event.source.x, event.source.y, event.source.z, currentSource);
+  batch.setTerrainMatterContainer(event.source.x, event.source.y,
+                                  event.source.z, currentSource);
+  voxelGrid.terrainGridRepository->applyWriteBatch(batch);
 }
 
-void setGravityFlowWaterTargetDefaults(VoxelGrid &voxelGrid,
+void setGravityFlowWaterTargetDefaults(TerrainWriteBatch &batch,
                                        const Position &targetPos,
                                        const PhysicsStats &physicsStats) {
   EntityTypeComponent targetType = {};
@@ -157,17 +163,15 @@ void setGravityFlowWaterTargetDefaults(VoxelGrid &voxelGrid,
   targetStructuralIntegrity.maxLoadCapacity = -1;
   targetStructuralIntegrity.matterState = MatterState::LIQUID;
 
-  voxelGrid.terrainGridRepository->setPosition(targetPos.x, targetPos.y,
-                                               targetPos.z, targetPos);
-  voxelGrid.terrainGridRepository->setTerrainEntityType(
-      targetPos.x, targetPos.y, targetPos.z, targetType);
-  voxelGrid.terrainGridRepository->setTerrainStructuralIntegrity(
-      targetPos.x, targetPos.y, targetPos.z, targetStructuralIntegrity);
-  voxelGrid.terrainGridRepository->setPhysicsStats(targetPos.x, targetPos.y,
-                                                   targetPos.z, physicsStats);
+  batch.setPosition(targetPos.x, targetPos.y, targetPos.z, targetPos);
+  batch.setTerrainEntityType(targetPos.x, targetPos.y, targetPos.z,
+                             targetType);
+  batch.setTerrainStructuralIntegrity(targetPos.x, targetPos.y, targetPos.z,
+                                      targetStructuralIntegrity);
+  batch.setPhysicsStats(targetPos.x, targetPos.y, targetPos.z, physicsStats);
 }
 
-void setGravityFlowEmptySourceDefaults(VoxelGrid &voxelGrid,
+void setGravityFlowEmptySourceDefaults(TerrainWriteBatch &batch,
                                        const Position &sourcePos) {
   EntityTypeComponent emptyType = {};
   emptyType.mainType = static_cast<int>(EntityEnum::TERRAIN);
@@ -187,17 +191,15 @@ void setGravityFlowEmptySourceDefaults(VoxelGrid &voxelGrid,
 
   PhysicsStats emptyPhysicsStats = {};
 
-  voxelGrid.terrainGridRepository->setTerrainId(
-      sourcePos.x, sourcePos.y, sourcePos.z,
-      static_cast<int>(TerrainIdTypeEnum::NONE), false);
-  voxelGrid.terrainGridRepository->setTerrainEntityType(
-      sourcePos.x, sourcePos.y, sourcePos.z, emptyType);
-  voxelGrid.terrainGridRepository->setTerrainMatterContainer(
-      sourcePos.x, sourcePos.y, sourcePos.z, emptyMatter);
-  voxelGrid.terrainGridRepository->setTerrainStructuralIntegrity(
-      sourcePos.x, sourcePos.y, sourcePos.z, emptyStructuralIntegrity);
-  voxelGrid.terrainGridRepository->setPhysicsStats(
-      sourcePos.x, sourcePos.y, sourcePos.z, emptyPhysicsStats);
+  batch.setTerrainId(sourcePos.x, sourcePos.y, sourcePos.z,
+                     static_cast<int>(TerrainIdTypeEnum::NONE));
+  batch.setTerrainEntityType(sourcePos.x, sourcePos.y, sourcePos.z, emptyType);
+  batch.setTerrainMatterContainer(sourcePos.x, sourcePos.y, sourcePos.z,
+                                  emptyMatter);
+  batch.setTerrainStructuralIntegrity(sourcePos.x, sourcePos.y, sourcePos.z,
+                                      emptyStructuralIntegrity);
+  batch.setPhysicsStats(sourcePos.x, sourcePos.y, sourcePos.z,
+                        emptyPhysicsStats);
 }
 
 void _handleTerrainPhaseConversionEvent(
@@ -1,6 +1,10 @@
 #ifndef TERRAIN_GRID_LOCK_HPP
 #define TERRAIN_GRID_LOCK_HPP
 
+#include <initializer_list>
+#include <optional>
+#include <span>
+
 #include "terrain/TerrainGridRepository.hpp"
 
 // RAII lock guard for TerrainGridRepository's manual locking mechanism.
@@ -36,4 +40,48 @@ public:
   TerrainGridLock &operator=(TerrainGridLock &&) = delete;
 };
 
+enum class TerrainLockMode { SHARED, EXCLUSIVE };
+
+// RAII lock over the terrain regions around a few voxels, for handlers that
+// read-modify-write a source/target pair or probe a small neighbourhood.
+// Covers every voxel within `margin` of the given voxels, so the usual
+// neighbour reads need no extra locking. Regions are taken in ascending
+// stripe order, so a move that crosses a region boundary cannot deadlock
+// against another one going the other way. An exclusive lock whose voxels
+// or margin reach outside the reserved regions takes the whole grid instead.
+//
+// Usage:
+//   TerrainRegionLock lock(voxelGrid.terrainGridRepository.get(),
+//                          {{sx, sy, sz}, {tx, ty, tz}});
+//
+class TerrainRegionLock {
+private:
+  std::optional<TerrainGridLock> gridLock_;
+  std::optional<TerrainGridRepository::RegionGuard> regionLock_;
+
+public:
+  TerrainRegionLock(TerrainGridRepository *repo,
+                    std::initializer_list<VoxelCoord> voxels,
+                    TerrainLockMode mode = TerrainLockMode::EXCLUSIVE,
+                    int margin = 1) {
+    if (!repo) {
+      return;
+    }
+    const std::span<const VoxelCoord> span(voxels.begin(), voxels.size());
+    const bool exclusive = mode == TerrainLockMode::EXCLUSIVE;
+    if (exclusive && !repo->regionsReserved(span, margin)) {
+      gridLock_.emplace(repo);
+      return;
+    }
+    regionLock_.emplace(
+        *repo, TerrainGridRepository::regionStripeMask(span, margin),
+        exclusive);
+  }
+
+  TerrainRegionLock(const TerrainRegionLock &) = delete;
+  TerrainRegionLock &operator=(const TerrainRegionLock &) = delete;
+  TerrainRegionLock(TerrainRegionLock &&) = delete;
+  TerrainRegionLock &operator=(TerrainRegionLock &&) = delete;
+};
+
 #endif // TERRAIN_GRID_LOCK_HPP
@@ -3,16 +3,71 @@
 #include <openvdb/openvdb.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <shared_mutex>
+#include <vector>
 
+#include "physics/MovementSchedule.hpp"
 #include "physics/PhysicsExceptions.hpp"
 #include "terrain/TerrainGridLock.hpp"
 
 namespace {
 inline openvdb::Coord C(int x, int y, int z) { return openvdb::Coord(x, y, z); }
+
+// Terrain locks the calling thread holds on one repository. `gridDepth`
+// counts nested whole-grid holds; `regionDepth` counts RegionGuards that
+// took stripes, the outermost of which also holds terrainGridMutex shared.
+// A whole-grid hold taken under a region lock holds `gridStripes`
+// exclusively instead, `gridTraded` being the ones it took over from a
+// shared guard.
+struct HeldTerrainLocks {
+  const TerrainGridRepository *repo = nullptr;
+  int gridDepth = 0;
+  int regionDepth = 0;
+  uint64_t sharedStripes = 0;
+  uint64_t exclusiveStripes = 0;
+  uint64_t gridStripes = 0;
+  uint64_t gridTraded = 0;
+};
+// One entry per repository the thread holds locks on, so two worlds on one
+// thread do not see each other's locks. Rarely more than one: a linear
+// scan is enough.
+thread_local std::vector<HeldTerrainLocks> s_heldTerrainLocks;
+
+HeldTerrainLocks &heldLocks(const TerrainGridRepository *repo) {
+  for (HeldTerrainLocks &held : s_heldTerrainLocks) {
+    if (held.repo == repo) {
+      return held;
+    }
+  }
+  s_heldTerrainLocks.push_back(HeldTerrainLocks{repo});
+  return s_heldTerrainLocks.back();
+}
+
+const HeldTerrainLocks *findHeldLocks(const TerrainGridRepository *repo) {
+  for (const HeldTerrainLocks &held : s_heldTerrainLocks) {
+    if (held.repo == repo) {
+      return &held;
+    }
+  }
+  return nullptr;
+}
+
+void forgetIfUnlocked(const TerrainGridRepository *repo) {
+  auto it = std::find_if(
+      s_heldTerrainLocks.begin(), s_heldTerrainLocks.end(),
+      [&](const HeldTerrainLocks &held) { return held.repo == repo; });
+  if (it != s_heldTerrainLocks.end() && it->gridDepth == 0 &&
+      it->regionDepth == 0) {
+    *it = s_heldTerrainLocks.back();
+    s_heldTerrainLocks.pop_back();
+  }
+}
 } // namespace
 
 bool TerrainGridRepository::isTerrainGridLocked() const {
@@ -30,24 +85,24 @@ TerrainGridRepository::TerrainGridRepository(entt::registry &registry,
 
 entt::entity TerrainGridRepository::getEntityAt(int x, int y, int z) const {
   std::shared_lock lock(trackingMapsMutex_);
-  auto it = byCoord_.find(VoxelCoord{x, y, z});
-  if (it == byCoord_.end())
+  const entt::entity *e = byCoord_.find(VoxelCoord{x, y, z});
+  if (!e)
     return entt::null;
-  return it->second;
+  return *e;
 }
 
 Position
 TerrainGridRepository::getPositionOfEntt(entt::entity terrain_entity) const {
   std::shared_lock lock(trackingMapsMutex_);
-  auto it = byEntity_.find(terrain_entity);
-  if (it == byEntity_.end()) {
+  const VoxelCoord *found = byEntity_.find(terrain_entity);
+  if (!found) {
     // Entity not found in mapping, return invalid position
     // return Position{-1, -1, -1, DirectionEnum::UP};
     throw aetherion::InvalidEntityException(
         "Entity not found in TerrainGridRepository mapping");
   }
 
-  const VoxelCoord &key = it->second;
+  const VoxelCoord key = *found;
   return getPosition(key.x, key.y, key.z);
 }
 
@@ -81,106 +136,42 @@ void TerrainGridRepository::moveTerrain(MovingComponent &movingComponent) {
       registry_.remove<MovingComponent>(static_cast<entt::entity>(terrainID));
     }
 
-    // CRITICAL: Reserve destination FIRST to prevent race conditions
-    // This must happen before copying any data to prevent other entities from
-    // trying to move here [COMMENTED OUT FOR TESTING - isolating inconsistent
-    // data source]
-    setTerrainId(movingComponent.movingToX, movingComponent.movingToY,
-                 movingComponent.movingToZ, terrainID, false);
-    setTerrainId(movingComponent.movingFromX, movingComponent.movingFromY,
-                 movingComponent.movingFromZ, -2, false); // Clear old position
-
-    // TODO: Clear moving from data.
-    // [COMMENTED OUT FOR TESTING - only keeping removal from old position]
-    // // Copy Position component
-    // setDirection(movingComponent.movingToX, movingComponent.movingToY,
-    //              movingComponent.movingToZ, movingComponent.direction);
-
-    // // Copy structural EntityTypeComponent component
-    EntityTypeComponent currentEntityType = getTerrainEntityType(
-        movingComponent.movingFromX, movingComponent.movingFromY,
-        movingComponent.movingFromZ, false);
-
-    setTerrainEntityType(movingComponent.movingToX, movingComponent.movingToY,
-                         movingComponent.movingToZ,
-                         EntityTypeComponent{currentEntityType.mainType,
-                                             currentEntityType.subType0,
-                                             currentEntityType.subType1},
-                         false);
-    // EntityTypeComponent
-    // emptyEntityType{static_cast<int>(EntityEnum::TERRAIN),
-    // static_cast<int>(TerrainEnum::EMPTY), 0}; setTerrainEntityType(
-    //     movingComponent.movingToX, movingComponent.movingToY,
-    //     movingComponent.movingToZ, emptyEntityType, false);
-    // Copy structural StructuralIntegrityComponent component
-    StructuralIntegrityComponent currentSIC = getTerrainStructuralIntegrity(
-        movingComponent.movingFromX, movingComponent.movingFromY,
-        movingComponent.movingFromZ, false);
-
-    setTerrainStructuralIntegrity(movingComponent.movingToX,
-                                  movingComponent.movingToY,
-                                  movingComponent.movingToZ, currentSIC);
-    // StructuralIntegrityComponent emptySIC{};
-    // emptySIC.canStackEntities = false;
-    // emptySIC.maxLoadCapacity = -1;
-    // emptySIC.matterState = MatterState::GAS;
-    // setTerrainStructuralIntegrity(movingComponent.movingFromX,
-    // movingComponent.movingFromY, movingComponent.movingFromZ, emptySIC);
-
-    // // I am here, on the refactor work.
-    // // [These ones does not need to takeLock]
-    // setCanStackEntities(movingComponent.movingToX, movingComponent.movingToY,
-    //                     movingComponent.movingToZ,
-    //                     currentSIC.canStackEntities);
-    // setMaxLoadCapacity(movingComponent.movingToX, movingComponent.movingToY,
-    //                    movingComponent.movingToZ,
-    //                    currentSIC.maxLoadCapacity);
-    // setGradient(movingComponent.movingToX, movingComponent.movingToY,
-    // movingComponent.movingToZ,
-    //             currentSIC.gradientVector);
-    // setMatterState(movingComponent.movingToX, movingComponent.movingToY,
-    //                movingComponent.movingToZ, currentSIC.matterState);
-
-    // // Copy structural MatterContainer component
-    MatterContainer currentMC = getTerrainMatterContainer(
-        movingComponent.movingFromX, movingComponent.movingFromY,
-        movingComponent.movingFromZ);
-    setTerrainMatterContainer(movingComponent.movingToX,
-                              movingComponent.movingToY,
-                              movingComponent.movingToZ, currentMC);
-    // MatterContainer emptyMC{0, 0, 0, 0};
-    // setTerrainMatterContainer(movingComponent.movingFromX,
-    // movingComponent.movingFromY,
-    //                           movingComponent.movingFromZ, emptyMC);
-
-    // Copy structural PhysicsStats component
-    PhysicsStats currentPS = getPhysicsStats(
-        movingComponent.movingFromX, movingComponent.movingFromY,
-        movingComponent.movingFromZ, false);
-    setPhysicsStats(movingComponent.movingToX, movingComponent.movingToY,
-                    movingComponent.movingToZ,
-                    PhysicsStats{currentPS.mass, currentPS.maxSpeed,
-                                 currentPS.minSpeed, 0.0f, 0.0f, 0.0f, 0.0f},
-                    false);
-    // PhysicsStats emptyPS{0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
-    // setPhysicsStats(movingComponent.movingFromX, movingComponent.movingFromY,
-    //                 movingComponent.movingFromZ, emptyPS, false);
-
-    // Propagate velocity from source to destination before the source
-    // is cleared. The upcoming `storage_.deleteTerrain(...from...)`
-    // zeros the source's velocity grids; without first carrying the
-    // velocity over, a moving ON_GRID_STORAGE voxel drops out of
-    // `iterateVelocityVoxels`'s active set on the very next tick and
-    // appears to stop mid-fall.
-    Velocity currentVelocity =
-        getVelocity(movingComponent.movingFromX, movingComponent.movingFromY,
-                    movingComponent.movingFromZ);
-    setVelocity(movingComponent.movingToX, movingComponent.movingToY,
-                movingComponent.movingToZ, currentVelocity);
-
-    storage_.deleteTerrain(movingComponent.movingFromX,
-                           movingComponent.movingFromY,
-                           movingComponent.movingFromZ);
+    const int fromX = movingComponent.movingFromX;
+    const int fromY = movingComponent.movingFromY;
+    const int fromZ = movingComponent.movingFromZ;
+    const int toX = movingComponent.movingToX;
+    const int toY = movingComponent.movingToY;
+    const int toZ = movingComponent.movingToZ;
+
+    // Read the source attributes first, then apply every write in one
+    // batch: a single lock and one accessor per grid instead of a lock and
+    // a root-to-leaf descent per setter. Source and destination are
+    // usually neighbours, so grouping by leaf keeps the writes local.
+    EntityTypeComponent currentEntityType =
+        getTerrainEntityType(fromX, fromY, fromZ, false);
+    StructuralIntegrityComponent currentSIC =
+        getTerrainStructuralIntegrity(fromX, fromY, fromZ, false);
+    MatterContainer currentMC = getTerrainMatterContainer(fromX, fromY, fromZ);
+    PhysicsStats currentPS = getPhysicsStats(fromX, fromY, fromZ, false);
+    // Carry the velocity over before the source is cleared; without it a
+    // moving ON_GRID_STORAGE voxel drops out of `iterateVelocityVoxels`'s
+    // active set on the very next tick and appears to stop mid-fall.
+    Velocity currentVelocity = getVelocity(fromX, fromY, fromZ);
+
+    TerrainWriteBatch batch(TerrainWriteOrder::BY_LEAF);
+    // Reserve the destination and clear the old position.
+    batch.setTerrainId(toX, toY, toZ, terrainID);
+    batch.setTerrainId(fromX, fromY, fromZ, -2);
+    batch.setTerrainEntityType(toX, toY, toZ, currentEntityType);
+    batch.setTerrainStructuralIntegrity(toX, toY, toZ, currentSIC);
+    batch.setTerrainMatterContainer(toX, toY, toZ, currentMC);
+    batch.setPhysicsStats(toX, toY, toZ,
+                          PhysicsStats{currentPS.mass, currentPS.maxSpeed,
+                                       currentPS.minSpeed, 0.0f, 0.0f, 0.0f,
+                                       0.0f});
+    batch.setVelocity(toX, toY, toZ, currentVelocity);
+    batch.deleteTerrain(fromX, fromY, fromZ);
+    applyWriteBatch(batch);
 
     if (hasEntity) {
       Position newPosition{movingComponent.movingToX, movingComponent.movingToY,
@@ -207,7 +198,8 @@ void TerrainGridRepository::moveTerrain(MovingComponent &movingComponent) {
 std::optional<int64_t>
 TerrainGridRepository::getTerrainIdIfExists(int x, int y, int z,
                                             bool takeLock) const {
-  return withSharedLock(
+  return withVoxelSharedLock(
+      x, y, z,
       [&]() -> std::optional<int64_t> {
         int64_t terrainId = storage_.getTerrainIdIfExists(x, y, z);
         if (terrainId == -2) {
@@ -220,7 +212,8 @@ TerrainGridRepository::getTerrainIdIfExists(int x, int y, int z,
 
 bool TerrainGridRepository::checkIfTerrainHasEntity(int x, int y, int z,
                                                     bool takeLock) const {
-  return withSharedLock(
+  return withVoxelSharedLock(
+      x, y, z,
       [&]() {
         int64_t entityId = storage_.getTerrainIdIfExists(x, y, z);
         return entityId >= 0;
@@ -230,7 +223,8 @@ bool TerrainGridRepository::checkIfTerrainHasEntity(int x, int y, int z,
 
 void TerrainGridRepository::markActive(int x, int y, int z, entt::entity e,
                                        bool takeLock) {
-  withUniqueLock(
+  withVoxelUniqueLock(
+      x, y, z,
       [&]() {
         if (storage_.terrainGrid) {
           storage_.terrainGrid->tree().setValue(C(x, y, z),
@@ -241,7 +235,8 @@ void TerrainGridRepository::markActive(int x, int y, int z, entt::entity e,
 }
 
 void TerrainGridRepository::clearActive(int x, int y, int z, bool takeLock) {
-  withUniqueLock(
+  withVoxelUniqueLock(
+      x, y, z,
       [&]() {
         if (!storage_.terrainGrid)
           return;
@@ -257,7 +252,8 @@ void TerrainGridRepository::clearActive(int x, int y, int z, bool takeLock) {
 
 void TerrainGridRepository::setTerrainId(int x, int y, int z, int64_t terrainID,
                                          bool takeLock) {
-  withUniqueLock(
+  withVoxelUniqueLock(
+      x, y, z,
       [&]() { storage_.terrainGrid->tree().setValue(C(x, y, z), terrainID); },
       takeLock);
 }
@@ -269,7 +265,7 @@ void TerrainGridRepository::addToTrackingMaps(const VoxelCoord &key,
   withTrackingMapsLock(
       [&]() {
         byCoord_[key] = e;
-        byEntity_[e] = key;
+        byEntity_.set(e, key);
       },
       takeTrackingLock, respectTerrainGridLock);
 }
@@ -363,7 +359,8 @@ entt::entity TerrainGridRepository::ensureActive(int x, int y, int z) {
 EntityTypeComponent
 TerrainGridRepository::getTerrainEntityType(int x, int y, int z,
                                             bool takeLock) const {
-  return withSharedLock(
+  return withVoxelSharedLock(
+      x, y, z,
       [&]() {
         EntityTypeComponent etc{};
         etc.mainType = storage_.getTerrainMainType(x, y, z);
@@ -377,7 +374,8 @@ TerrainGridRepository::getTerrainEntityType(int x, int y, int z,
 void TerrainGridRepository::setTerrainEntityType(int x, int y, int z,
                                                  EntityTypeComponent etc,
                                                  bool takeLock) {
-  withUniqueLock(
+  withVoxelUniqueLock(
+      x, y, z,
       [&]() {
         storage_.setTerrainMainType(x, y, z, etc.mainType);
         storage_.setTerrainSubType0(x, y, z, etc.subType0);
@@ -393,7 +391,7 @@ TerrainInfo TerrainGridRepository::readTerrainInfo(int x, int y, int z) const {
   info.z = z;
 
   // Use single shared lock for all storage reads
-  withSharedLock([&]() {
+  withVoxelSharedLock(x, y, z, [&]() {
     info.active = storage_.isActive(x, y, z);
 
     // Populate static data from VDB grids
@@ -422,8 +420,12 @@ TerrainInfo TerrainGridRepository::readTerrainInfo(int x, int y, int z) const {
       TransientData tr;
       if (auto v = registry_.try_get<Velocity>(e))
         tr.velocity = *v;
-      if (auto m = registry_.try_get<MovingComponent>(e))
+      if (auto m = registry_.try_get<MovingComponent>(e)) {
         tr.moving = *m;
+        if (movementSchedule_) {
+          movementSchedule_->refreshTimeRemaining(e, tr.moving);
+        }
+      }
       info.transient = tr;
     }
   }
@@ -453,7 +455,7 @@ void TerrainGridRepository::setTerrainSubType1(int x, int y, int z, int v) {
 
 MatterContainer TerrainGridRepository::getTerrainMatterContainer(int x, int y,
                                                                  int z) const {
-  return withSharedLock([&]() {
+  return withVoxelSharedLock(x, y, z, [&]() {
     MatterContainer mc{};
     mc.TerrainMatter = storage_.getTerrainMatter(x, y, z);
     mc.WaterVapor = storage_.getTerrainVaporMatter(x, y, z);
@@ -465,7 +467,7 @@ MatterContainer TerrainGridRepository::getTerrainMatterContainer(int x, int y,
 
 void TerrainGridRepository::setTerrainMatterContainer(
     int x, int y, int z, const MatterContainer &mc) {
-  withUniqueLock([&]() {
+  withVoxelUniqueLock(x, y, z, [&]() {
     storage_.setTerrainMatter(x, y, z, mc.TerrainMatter);
     storage_.setTerrainVaporMatter(x, y, z, mc.WaterVapor);
     storage_.setTerrainWaterMatter(x, y, z, mc.WaterMatter);
@@ -519,7 +521,8 @@ void TerrainGridRepository::setMinSpeed(int x, int y, int z, int v) {
 
 PhysicsStats TerrainGridRepository::getPhysicsStats(int x, int y, int z,
                                                     bool takeLock) const {
-  return withSharedLock(
+  return withVoxelSharedLock(
+      x, y, z,
       [&]() {
         PhysicsStats ps{};
         ps.mass = static_cast<float>(storage_.getTerrainMass(x, y, z));
@@ -539,7 +542,7 @@ TerrainPhysicsSnapshot TerrainGridRepository::getPhysicsSnapshot(int x, int y,
   // CRITICAL: All reads happen under a SINGLE shared lock to prevent TOCTOU
   // bugs This prevents terrain from moving/changing between position lookup and
   // velocity read
-  std::shared_lock<std::shared_mutex> lock(terrainGridMutex);
+  RegionGuard guard(*this, stripeBit(x, y, z), false);
 
   // TerrainPhysicsSnapshot snapshot;
 
@@ -590,10 +593,62 @@ TerrainPhysicsSnapshot TerrainGridRepository::getPhysicsSnapshot(int x, int y,
   return TerrainPhysicsSnapshot{}; // TODO: Implement proper snapshot retrieval
 }
 
+TerrainStencil TerrainGridRepository::getStencil(int x, int y, int z,
+                                                uint32_t fields,
+                                                StencilShape shape,
+                                                bool takeLock) const {
+  TerrainStencil stencil;
+  if (!takeLock) {
+    storage_.loadStencil(x, y, z, fields, shape, stencil);
+    return stencil;
+  }
+  RegionGuard guard(
+      *this, regionStripeMask(x - 1, y - 1, z - 1, x + 1, y + 1, z + 1), false);
+  storage_.loadStencil(x, y, z, fields, shape, stencil);
+  return stencil;
+}
+
+void TerrainGridRepository::applyWriteBatch(TerrainWriteBatch &batch,
+                                            bool takeLock) {
+  if (batch.empty()) {
+    return;
+  }
+  if (!takeLock) {
+    storage_.applyWrites(batch);
+    return;
+  }
+  uint64_t stripes = 0;
+  bool reserved = true;
+  for (const TerrainWriteOp &op : batch.ops()) {
+    reserved = reserved && storage_.regionReserved(op.x, op.y, op.z);
+    stripes |= stripeBit(op.x, op.y, op.z);
+  }
+  if (!reserved) {
+    withUniqueLock([&]() { storage_.applyWrites(batch); });
+    return;
+  }
+  RegionGuard guard(*this, stripes, true);
+  storage_.applyWrites(batch);
+}
+
+void TerrainGridRepository::loadTerrainBox(int x0, int y0, int z0, int width,
+                                           int height, int depth,
+                                           const TerrainVoxelColumns &columns) {
+  withUniqueLock([&]() {
+    storage_.loadBox(x0, y0, z0, width, height, depth, columns);
+  });
+}
+
+void TerrainGridRepository::loadTerrainPoints(
+    const int32_t *xyz, std::size_t count, const TerrainVoxelColumns &columns) {
+  withUniqueLock([&]() { storage_.loadPoints(xyz, count, columns); });
+}
+
 void TerrainGridRepository::setPhysicsStats(int x, int y, int z,
                                             const PhysicsStats &ps,
                                             bool takeLock) {
-  withUniqueLock(
+  withVoxelUniqueLock(
+      x, y, z,
       [&]() {
         storage_.setTerrainHeat(x, y, z, static_cast<int>(ps.heat));
         storage_.setTerrainMass(x, y, z, static_cast<int>(ps.mass));
@@ -614,7 +669,7 @@ void TerrainGridRepository::setDirection(int x, int y, int z,
 }
 
 Position TerrainGridRepository::getPosition(int x, int y, int z) const {
-  return withSharedLock([&]() {
+  return withVoxelSharedLock(x, y, z, [&]() {
     Position pos{};
     pos.x = x;
     pos.y = y;
@@ -627,8 +682,8 @@ Position TerrainGridRepository::getPosition(int x, int y, int z) const {
 void TerrainGridRepository::setPosition(int x, int y, int z,
                                         const Position &pos) {
   // Coordinates are implied by (x,y,z); only persist direction.
-  withUniqueLock(
-      [&]() { storage_.setTerrainDirection(x, y, z, pos.direction); });
+  withVoxelUniqueLock(
+      x, y, z, [&]() { storage_.setTerrainDirection(x, y, z, pos.direction); });
 }
 bool TerrainGridRepository::getCanStackEntities(int x, int y, int z) const {
   return storage_.getTerrainCanStackEntities(x, y, z);
@@ -669,21 +724,28 @@ void TerrainGridRepository::setVelocity(int x, int y, int z,
 // ---------------- MovingComponent coord-keyed map ----------------
 void TerrainGridRepository::setMovingComponent(int x, int y, int z,
                                                const MovingComponent &mc) {
-  withUniqueLock([&]() { movingByCoord_[VoxelCoord{x, y, z}] = mc; });
+  withVoxelUniqueLock(x, y, z, [&]() {
+    std::lock_guard mapLock(movingMapMutex_);
+    movingByCoord_[VoxelCoord{x, y, z}] = mc;
+  });
 }
 
 MovingComponent TerrainGridRepository::getMovingComponent(int x, int y,
                                                           int z) const {
-  return withSharedLock([&]() -> MovingComponent {
-    auto it = movingByCoord_.find(VoxelCoord{x, y, z});
-    if (it == movingByCoord_.end())
+  return withVoxelSharedLock(x, y, z, [&]() -> MovingComponent {
+    std::lock_guard mapLock(movingMapMutex_);
+    const MovingComponent *mc = movingByCoord_.find(VoxelCoord{x, y, z});
+    if (!mc)
       return MovingComponent{};
-    return it->second;
+    return *mc;
   });
 }
 
 void TerrainGridRepository::clearMovingComponent(int x, int y, int z) {
-  withUniqueLock([&]() { movingByCoord_.erase(VoxelCoord{x, y, z}); });
+  withVoxelUniqueLock(x, y, z, [&]() {
+    std::lock_guard mapLock(movingMapMutex_);
+    movingByCoord_.erase(VoxelCoord{x, y, z});
+  });
 }
 
 // void TerrainGridRepository::setTerrain(int x, int y, int z, int terrainID) {
@@ -770,14 +832,8 @@ void TerrainGridRepository::setTerrainFromEntt(entt::entity entity) {
     clearActive(x, y, z);
     {
       std::unique_lock lock(trackingMapsMutex_);
-      auto it = byCoord_.find(VoxelCoord{x, y, z});
-      if (it != byCoord_.end()) {
-        byCoord_.erase(it);
-      }
-      auto entityIt = byEntity_.find(entity);
-      if (entityIt != byEntity_.end()) {
-        byEntity_.erase(entityIt);
-      }
+      byCoord_.erase(VoxelCoord{x, y, z});
+      byEntity_.erase(entity);
     }
     registry_.destroy(entity);
     // Set terrain ID to -1 to indicate no active entity, but that terrain
@@ -790,23 +846,21 @@ void TerrainGridRepository::setTerrainFromEntt(entt::entity entity) {
 }
 
 bool TerrainGridRepository::checkIfTerrainExists(int x, int y, int z) const {
-  // Always use shared lock for safety - the lock is reentrant-safe for read
-  // operations The isTerrainGridLocked() check is kept for compatibility with
-  // explicit lock holders
-  if (!isTerrainGridLocked()) {
-    std::shared_lock<std::shared_mutex> lock(terrainGridMutex);
-    return storage_.checkIfTerrainExists(x, y, z);
-  }
-  // If externally locked, caller guarantees consistency
-  return storage_.checkIfTerrainExists(x, y, z);
+  return withVoxelSharedLock(
+      x, y, z, [&]() { return storage_.checkIfTerrainExists(x, y, z); });
 }
 
 // Delete terrain at a specific voxel
 void TerrainGridRepository::deleteTerrain(EventSink &sink, int x, int y, int z,
                                           bool takeLock) {
-  std::unique_ptr<TerrainGridLock> lock;
+  std::optional<GridGuard> gridLock;
+  std::optional<RegionGuard> regionLock;
   if (takeLock) {
-    lock = std::make_unique<TerrainGridLock>(this);
+    if (storage_.regionReserved(x, y, z)) {
+      regionLock.emplace(*this, stripeBit(x, y, z), true);
+    } else {
+      gridLock.emplace(*this);
+    }
   }
 
   int terrainId = storage_.deleteTerrain(x, y, z);
@@ -841,7 +895,8 @@ void TerrainGridRepository::deleteTerrain(EventSink &sink, int x, int y, int z,
 StructuralIntegrityComponent
 TerrainGridRepository::getTerrainStructuralIntegrity(int x, int y, int z,
                                                      bool takeLock) const {
-  return withSharedLock(
+  return withVoxelSharedLock(
+      x, y, z,
       [&]() { return storage_.getTerrainStructuralIntegrity(x, y, z); },
       takeLock);
 }
@@ -849,35 +904,200 @@ TerrainGridRepository::getTerrainStructuralIntegrity(int x, int y, int z,
 void TerrainGridRepository::setTerrainStructuralIntegrity(
     int x, int y, int z, const StructuralIntegrityComponent &sic,
     bool takeLock) {
-  withUniqueLock(
+  withVoxelUniqueLock(
+      x, y, z,
       [&]() { storage_.setTerrainStructuralIntegrity(x, y, z, sic); },
       takeLock);
 }
 
 bool TerrainGridRepository::hasMovingComponent(int x, int y, int z) const {
-  return withSharedLock(
-      [&]() -> bool { return movingByCoord_.count(VoxelCoord{x, y, z}) > 0; });
+  return withVoxelSharedLock(x, y, z, [&]() -> bool {
+    std::lock_guard mapLock(movingMapMutex_);
+    return movingByCoord_.contains(VoxelCoord{x, y, z});
+  });
 }
 
-// Per-thread flag: true only while the calling thread holds the exclusive lock.
-static thread_local bool s_thisThreadHoldsTerrainGridLock = false;
+bool TerrainGridRepository::currentThreadHoldsTerrainGridLock() const {
+  const HeldTerrainLocks *held = findHeldLocks(this);
+  return held && held->gridDepth > 0;
+}
 
-bool TerrainGridRepository::currentThreadHoldsTerrainGridLock() {
-  return s_thisThreadHoldsTerrainGridLock;
+bool TerrainGridRepository::currentThreadHoldsRegionLock() const {
+  const HeldTerrainLocks *held = findHeldLocks(this);
+  return held && held->regionDepth > 0;
+}
+
+uint64_t TerrainGridRepository::lockStripes(uint64_t wanted, bool exclusive,
+                                            bool anyOrder) const {
+  HeldTerrainLocks &held = heldLocks(this);
+  // std::shared_mutex cannot upgrade, so stripes held shared are given up
+  // first; another writer may get in between.
+  const uint64_t traded = exclusive ? wanted & held.sharedStripes : 0;
+  for (uint64_t bits = traded; bits != 0; bits &= bits - 1) {
+    lockStripes_[std::countr_zero(bits)].mutex.unlock_shared();
+  }
+  held.sharedStripes &= ~traded;
+
+  const uint64_t heldAny = held.sharedStripes | held.exclusiveStripes;
+  const int highest = heldAny ? 63 - std::countl_zero(heldAny) : -1;
+  for (uint64_t bits = wanted; bits != 0; bits &= bits - 1) {
+    const int i = std::countr_zero(bits);
+    std::shared_mutex &stripe = lockStripes_[i].mutex;
+    if (i > highest) {
+      exclusive ? stripe.lock() : stripe.lock_shared();
+      continue;
+    }
+    // Below a stripe this thread holds: waiting here could deadlock with a
+    // thread taking both in ascending order. Only whole-grid holds and
+    // stripes just given up for an upgrade may come here; they try first
+    // and only wait while another thread holds the stripe.
+    assert((anyOrder || (traded >> i & 1)) &&
+           "region stripes taken below one already held; widen the outer "
+           "TerrainRegionLock");
+    if (!(exclusive ? stripe.try_lock() : stripe.try_lock_shared())) {
+      exclusive ? stripe.lock() : stripe.lock_shared();
+    }
+  }
+  (exclusive ? held.exclusiveStripes : held.sharedStripes) |= wanted;
+  return traded;
+}
+
+void TerrainGridRepository::unlockStripes(uint64_t acquired, uint64_t traded,
+                                          bool exclusive) const {
+  HeldTerrainLocks &held = heldLocks(this);
+  (exclusive ? held.exclusiveStripes : held.sharedStripes) &= ~acquired;
+  for (uint64_t bits = acquired; bits != 0; bits &= bits - 1) {
+    std::shared_mutex &stripe = lockStripes_[std::countr_zero(bits)].mutex;
+    exclusive ? stripe.unlock() : stripe.unlock_shared();
+  }
+  // Hand the upgraded stripes back to the shared guard that held them.
+  for (uint64_t bits = traded; bits != 0; bits &= bits - 1) {
+    std::shared_mutex &stripe = lockStripes_[std::countr_zero(bits)].mutex;
+    if (!stripe.try_lock_shared()) {
+      stripe.lock_shared();
+    }
+  }
+  held.sharedStripes |= traded;
+}
+
+void TerrainGridRepository::acquireGridExclusive() const {
+  HeldTerrainLocks &held = heldLocks(this);
+  if (held.gridDepth++ > 0) {
+    return;
+  }
+  if (held.regionDepth == 0) {
+    terrainGridMutex.lock();
+    return;
+  }
+  // Under a region lock this thread holds terrainGridMutex shared, and
+  // locking it exclusively would wait on itself. Every stripe held
+  // exclusively keeps out the same readers and writers.
+  held.gridStripes = kAllStripes & ~held.exclusiveStripes;
+  held.gridTraded = lockStripes(held.gridStripes, true, true);
+}
+
+void TerrainGridRepository::releaseGridExclusive() const {
+  HeldTerrainLocks &held = heldLocks(this);
+  assert(held.gridDepth > 0);
+  if (--held.gridDepth > 0) {
+    return;
+  }
+  if (held.regionDepth == 0) {
+    terrainGridMutex.unlock();
+  } else {
+    const uint64_t stripes = held.gridStripes, traded = held.gridTraded;
+    held.gridStripes = held.gridTraded = 0;
+    unlockStripes(stripes, traded, true);
+  }
+  forgetIfUnlocked(this);
 }
 
 // Lock terrain grid for external synchronization
 void TerrainGridRepository::lockTerrainGrid() {
-  terrainGridMutex.lock();
+  acquireGridExclusive();
   terrainGridLocked_.store(true);
-  s_thisThreadHoldsTerrainGridLock = true;
 }
 
 // Unlock terrain grid after external synchronization
 void TerrainGridRepository::unlockTerrainGrid() {
-  s_thisThreadHoldsTerrainGridLock = false;
-  terrainGridLocked_.store(false);
-  terrainGridMutex.unlock();
+  if (heldLocks(this).gridDepth == 1) {
+    terrainGridLocked_.store(false);
+  }
+  releaseGridExclusive();
+}
+
+TerrainGridRepository::RegionGuard::RegionGuard(
+    const TerrainGridRepository &repo, uint64_t stripes, bool exclusive)
+    : repo_(&repo), exclusive_(exclusive) {
+  HeldTerrainLocks &held = heldLocks(&repo);
+  if (held.gridDepth > 0) {
+    return; // The whole grid is already ours.
+  }
+  const uint64_t wanted =
+      stripes & ~(exclusive ? held.exclusiveStripes
+                            : held.sharedStripes | held.exclusiveStripes);
+  if (wanted == 0) {
+    forgetIfUnlocked(&repo);
+    return;
+  }
+  if (held.regionDepth++ == 0) {
+    repo.terrainGridMutex.lock_shared();
+  }
+  traded_ = repo.lockStripes(wanted, exclusive, stripes == kAllStripes);
+  acquired_ = wanted;
+}
+
+TerrainGridRepository::RegionGuard::~RegionGuard() {
+  if (acquired_ == 0) {
+    return;
+  }
+  repo_->unlockStripes(acquired_, traded_, exclusive_);
+  HeldTerrainLocks &held = heldLocks(repo_);
+  if (--held.regionDepth == 0) {
+    repo_->terrainGridMutex.unlock_shared();
+    forgetIfUnlocked(repo_);
+  }
+}
+
+uint64_t TerrainGridRepository::regionStripeMask(int x0, int y0, int z0,
+                                                 int x1, int y1, int z1) {
+  uint64_t mask = 0;
+  for (int rz = TerrainStorage::regionIndex(z0);
+       rz <= TerrainStorage::regionIndex(z1); ++rz) {
+    for (int ry = TerrainStorage::regionIndex(y0);
+         ry <= TerrainStorage::regionIndex(y1); ++ry) {
+      for (int rx = TerrainStorage::regionIndex(x0);
+           rx <= TerrainStorage::regionIndex(x1); ++rx) {
+        mask |= uint64_t{1} << stripeOfRegion(rx, ry, rz);
+      }
+    }
+  }
+  return mask;
+}
+
+uint64_t
+TerrainGridRepository::regionStripeMask(std::span<const VoxelCoord> voxels,
+                                        int margin) {
+  uint64_t mask = 0;
+  for (const VoxelCoord &v : voxels) {
+    mask |= regionStripeMask(v.x - margin, v.y - margin, v.z - margin,
+                             v.x + margin, v.y + margin, v.z + margin);
+  }
+  return mask;
+}
+
+bool TerrainGridRepository::regionsReserved(
+    std::span<const VoxelCoord> voxels, int margin) const {
+  // The reserved regions form one box, so both corners of each voxel's
+  // margin box being inside means every region it touches is.
+  return std::all_of(voxels.begin(), voxels.end(), [&](const VoxelCoord &v) {
+    return storage_.regionReserved(v.x - margin, v.y - margin, v.z - margin) &&
+           storage_.regionReserved(v.x + margin, v.y + margin, v.z + margin);
+  });
+}
+
+void TerrainGridRepository::reserveRegions(int width, int height, int depth) {
+  withUniqueLock([&]() { storage_.reserveRegions(width, height, depth); });
 }
 
 void TerrainGridRepository::softDeactivateEntity(EventSink &sink,
@@ -916,9 +1136,8 @@ void TerrainGridRepository::softDeactivateEntity(EventSink &sink,
   bool found = false;
   {
     std::shared_lock tlock(trackingMapsMutex_);
-    auto it = byEntity_.find(e);
-    if (it != byEntity_.end()) {
-      key = it->second;
+    if (const VoxelCoord *coord = byEntity_.find(e)) {
+      key = *coord;
       found = true;
     }
   }
@@ -964,6 +1183,45 @@ void TerrainGridRepository::softDeactivateEntity(EventSink &sink,
                 static_cast<int>(e));
 }
 
+void TerrainGridRepository::softDeactivateEntities(
+    EventSink &sink, std::span<const entt::entity> entities, bool takeLock) {
+  std::optional<TerrainGridLock> gridLock;
+  if (takeLock) {
+    gridLock.emplace(this);
+  }
+
+  withTrackingMapsLock([&]() {
+    for (entt::entity e : entities) {
+      if (!registry_.valid(e)) {
+        continue;
+      }
+      // Same rule as softDeactivateEntity: entities with transient
+      // components are handed to the removal events, the rest are unmapped
+      // and their voxel goes back to grid storage here.
+      bool hadTransient = false;
+      if (registry_.all_of<Velocity>(e)) {
+        hadTransient = true;
+        sink.enqueue<TerrainRemoveVelocityEvent>(e);
+      }
+      if (registry_.all_of<MovingComponent>(e)) {
+        hadTransient = true;
+        sink.enqueue<TerrainRemoveMovingComponentEvent>(e);
+      }
+      const VoxelCoord *coord = byEntity_.find(e);
+      if (hadTransient || !coord) {
+        continue;
+      }
+      const VoxelCoord key = *coord;
+      byCoord_.erase(key);
+      byEntity_.erase(e);
+      setTerrainId(key.x, key.y, key.z,
+                   static_cast<int>(TerrainIdTypeEnum::ON_GRID_STORAGE),
+                   false);
+      clearActive(key.x, key.y, key.z, false);
+    }
+  });
+}
+
 int64_t TerrainGridRepository::sumTotalWater() const {
   return storage_.sumTotalWater();
 }
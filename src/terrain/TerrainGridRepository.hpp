@@ -1,11 +1,15 @@
 #ifndef TERRAIN_GRID_REPOSITORY_HPP
 #define TERRAIN_GRID_REPOSITORY_HPP
 
+#include <array>
 #include <atomic>
+#include <cstdint>
 #include <entt/entt.hpp>
+#include <mutex>
 #include <optional>
 #include <shared_mutex>
-#include <unordered_map>
+#include <span>
+#include <vector>
 
 // TracySharedLockable expands to a plain `std::shared_mutex` declaration
 // when TRACY_ENABLE is undefined (default builds), and to a Tracy-tracked
@@ -24,6 +28,9 @@
 #include "ecosystem/EcosystemEvents.hpp"
 #include "terrain/TerrainStorage.hpp"
 #include "terrain/VoxelCoord.hpp"
+#include "terrain/VoxelCoordMap.hpp"
+
+class MovementSchedule;
 
 // TerrainGridRepository provides an ECS overlay for transient behavior while
 // delegating all static storage to TerrainStorage (OpenVDB-backed).
@@ -80,6 +87,12 @@ public:
   // transient
   TerrainInfo readTerrainInfo(int x, int y, int z) const;
 
+  // Source of MovingComponent::timeRemaining for readTerrainInfo; the
+  // registry copy is not counted down (see MovementSchedule). Set by World.
+  void setMovementSchedule(const MovementSchedule *schedule) {
+    movementSchedule_ = schedule;
+  }
+
   // Tick transient systems; auto-deactivate when no transients remain
   void tick(int dtTicks = 1);
 
@@ -137,6 +150,26 @@ public:
   // Atomic multi-read for physics calculations (prevents TOCTOU bugs)
   TerrainPhysicsSnapshot getPhysicsSnapshot(int x, int y, int z) const;
 
+  // Neighbourhood read of the requested StencilField groups under a single
+  // shared lock. Prefer this over per-voxel getters when probing a voxel
+  // and its neighbours.
+  TerrainStencil getStencil(int x, int y, int z, uint32_t fields,
+                            StencilShape shape = StencilShape::BOX_27,
+                            bool takeLock = true) const;
+
+  // Apply every op in `batch` under a single unique lock and clear it. Use
+  // this instead of a run of setters when a handler writes several
+  // attributes or several voxels in one go.
+  void applyWriteBatch(TerrainWriteBatch &batch, bool takeLock = true);
+
+  // Bulk world construction (TerrainStorage::loadBox / loadPoints) under
+  // one whole-grid lock. Meant for building a map before the simulation
+  // runs; hybrid terrain ids are set afterwards with setTerrainId.
+  void loadTerrainBox(int x0, int y0, int z0, int width, int height,
+                      int depth, const TerrainVoxelColumns &columns);
+  void loadTerrainPoints(const int32_t *xyz, std::size_t count,
+                         const TerrainVoxelColumns &columns);
+
   int getMass(int x, int y, int z) const;
   void setMass(int x, int y, int z, int v);
   int getMaxSpeed(int x, int y, int z) const;
@@ -166,8 +199,9 @@ public:
   void setVelocity(int x, int y, int z, const Velocity &vel);
 
   // ---------------- MovingComponent coord-keyed map ----------------
-  // MovingComponent is stored in movingByCoord_ (protected by terrainGridMutex)
-  // instead of the ECS registry for terrain voxels.
+  // MovingComponent is stored in movingByCoord_ (protected by the voxel's
+  // region lock plus movingMapMutex_) instead of the ECS registry for terrain
+  // voxels.
   void setMovingComponent(int x, int y, int z, const MovingComponent &mc);
   MovingComponent getMovingComponent(int x, int y, int z) const;
   void clearMovingComponent(int x, int y, int z);
@@ -192,6 +226,11 @@ public:
   // destruction later.
   void softDeactivateEntity(EventSink &sink, entt::entity e,
                             bool takeLock = true);
+  // softDeactivateEntity for a batch of entities (the deletion pass): one
+  // terrain grid lock and one tracking-map lock cover the whole span.
+  void softDeactivateEntities(EventSink &sink,
+                              std::span<const entt::entity> entities,
+                              bool takeLock = true);
 
   // Check if a terrain voxel has a MovingComponent
   bool hasMovingComponent(int x, int y, int z) const;
@@ -247,10 +286,63 @@ public:
   // rather than calling this directly.
   void moveTerrain(MovingComponent &movingComponent);
 
-  // Locking methods for external synchronization during terrain movement
+  // Locking methods for external synchronization during terrain movement.
+  // These take the whole grid; nested calls on the same thread are no-ops.
+  // Under a region lock they take every stripe exclusively instead, since
+  // the thread already holds terrainGridMutex shared.
   void lockTerrainGrid();
   void unlockTerrainGrid();
 
+  // ---------------- Region locks ----------------
+  // Besides the whole-grid lock above, terrain is locked per TerrainStorage
+  // region (one level-1 VDB node, 128^3 voxels). Regions hash onto
+  // kLockStripes reader/writer stripes; a region lock holds terrainGridMutex
+  // shared, which keeps whole-grid writers out, plus the stripes it covers.
+  // The per-voxel methods of this class only take their voxel's stripe, so
+  // water, physics and perception working in different parts of the world
+  // no longer serialise on one mutex. Writes outside the reserved regions
+  // (see reserveRegions) fall back to the whole-grid lock.
+  static constexpr int kLockStripes = 64;
+
+  // Stripes covering every voxel within `margin` of any of `voxels`.
+  static uint64_t regionStripeMask(std::span<const VoxelCoord> voxels,
+                                   int margin = 0);
+  // Stripes covering the box [x0, x1] x [y0, y1] x [z0, z1].
+  static uint64_t regionStripeMask(int x0, int y0, int z0, int x1, int y1,
+                                   int z1);
+  // Whether every voxel within `margin` of any of `voxels` lies in a
+  // reserved region, i.e. the regions regionStripeMask(voxels, margin)
+  // locks can be written under their stripes.
+  bool regionsReserved(std::span<const VoxelCoord> voxels,
+                       int margin = 0) const;
+
+  // Reserve the regions covering a width x height x depth world, under the
+  // whole-grid lock. Until this is called every write takes the whole grid.
+  void reserveRegions(int width, int height, int depth);
+
+  // RAII hold on a set of stripes. Stripes are taken in ascending order, so
+  // two guards over overlapping sets cannot deadlock. Stripes the thread
+  // already holds (or all of them, under lockTerrainGrid) are skipped, so
+  // repository calls made inside a guard do not lock again. A stripe held
+  // shared is given up and retaken exclusively for an exclusive guard, and
+  // handed back when it ends. Taking a stripe below one already held is
+  // only expected from whole-grid calls and asserts otherwise. Prefer
+  // TerrainRegionLock (TerrainGridLock.hpp) outside this class.
+  class RegionGuard {
+  public:
+    RegionGuard(const TerrainGridRepository &repo, uint64_t stripes,
+                bool exclusive);
+    ~RegionGuard();
+    RegionGuard(const RegionGuard &) = delete;
+    RegionGuard &operator=(const RegionGuard &) = delete;
+
+  private:
+    const TerrainGridRepository *repo_ = nullptr;
+    uint64_t acquired_ = 0;
+    uint64_t traded_ = 0; // acquired_ stripes an outer guard held shared
+    bool exclusive_ = false;
+  };
+
   entt::entity createEnttForTerrain(int x, int y, int z);
   entt::entity ensureActive(int x, int y, int z);
 
@@ -289,40 +381,112 @@ public:
 
   // True only when the calling thread is the current exclusive lock holder.
   // Use this for re-entrancy guards inside withUniqueLock/withSharedLock.
-  static bool currentThreadHoldsTerrainGridLock();
+  bool currentThreadHoldsTerrainGridLock() const;
+  // True while the calling thread holds any region stripe of this grid.
+  bool currentThreadHoldsRegionLock() const;
 
 private:
-  // Utility methods for conditional locking
+  static constexpr uint64_t kAllStripes = ~uint64_t{0};
+
+  static int stripeOfRegion(int rx, int ry, int rz) {
+    const uint32_t h = static_cast<uint32_t>(rx) * 73856093u ^
+                       static_cast<uint32_t>(ry) * 19349663u ^
+                       static_cast<uint32_t>(rz) * 83492791u;
+    return static_cast<int>(h % kLockStripes);
+  }
+  static uint64_t stripeBit(int x, int y, int z) {
+    return uint64_t{1} << stripeOfRegion(TerrainStorage::regionIndex(x),
+                                          TerrainStorage::regionIndex(y),
+                                          TerrainStorage::regionIndex(z));
+  }
+
+  // Whole-grid exclusive hold shared by lockTerrainGrid and withUniqueLock.
+  void acquireGridExclusive() const;
+  void releaseGridExclusive() const;
+
+  // Take or release stripes the calling thread does not hold in that mode
+  // yet. lockStripes returns the ones it took over from a shared hold,
+  // which unlockStripes hands back. `anyOrder` allows stripes below one
+  // already held (whole-grid calls).
+  uint64_t lockStripes(uint64_t wanted, bool exclusive, bool anyOrder) const;
+  void unlockStripes(uint64_t acquired, uint64_t traded, bool exclusive) const;
+
+  class GridGuard {
+  public:
+    explicit GridGuard(const TerrainGridRepository &repo) : repo_(repo) {
+      repo_.acquireGridExclusive();
+    }
+    ~GridGuard() { repo_.releaseGridExclusive(); }
+    GridGuard(const GridGuard &) = delete;
+    GridGuard &operator=(const GridGuard &) = delete;
+
+  private:
+    const TerrainGridRepository &repo_;
+  };
+
+  // Utility methods for conditional locking. The whole-grid variants are
+  // for iteration and counts; per-voxel accessors use the voxel variants.
+  // All of them nest inside a region lock: they only take the stripes the
+  // thread does not hold yet.
   template <typename Func>
   auto withSharedLock(Func &&func,
                       bool takeLock = true) const -> decltype(func()) {
     if (!takeLock) {
       return func();
     }
-    if (!currentThreadHoldsTerrainGridLock()) {
-      std::shared_lock<std::shared_mutex> lock(terrainGridMutex);
+    RegionGuard guard(*this, kAllStripes, false);
+    return func();
+  }
+
+  template <typename Func>
+  auto withUniqueLock(Func &&func, bool takeLock = true) -> decltype(func()) {
+    if (!takeLock) {
       return func();
     }
+    GridGuard guard(*this);
     return func();
   }
 
   template <typename Func>
-  auto withUniqueLock(Func &&func, bool takeLock = true) -> decltype(func()) {
+  auto withVoxelSharedLock(int x, int y, int z, Func &&func,
+                           bool takeLock = true) const -> decltype(func()) {
     if (!takeLock) {
       return func();
     }
-    if (!currentThreadHoldsTerrainGridLock()) {
-      std::unique_lock<std::shared_mutex> lock(terrainGridMutex);
+    RegionGuard guard(*this, stripeBit(x, y, z), false);
+    return func();
+  }
+
+  template <typename Func>
+  auto withVoxelUniqueLock(int x, int y, int z, Func &&func,
+                           bool takeLock = true) -> decltype(func()) {
+    if (!takeLock) {
+      return func();
+    }
+    if (!storage_.regionReserved(x, y, z)) {
+      GridGuard guard(*this);
       return func();
     }
+    RegionGuard guard(*this, stripeBit(x, y, z), true);
     return func();
   }
 
-  // Mutex specifically for terrainGrid thread safety
+  // Whole-grid lock. Region locks hold it shared; lockTerrainGrid and
+  // withUniqueLock hold it exclusively.
   mutable std::shared_mutex terrainGridMutex;
   // Track if terrain grid is currently locked (atomic to avoid races)
   mutable std::atomic<bool> terrainGridLocked_{false};
 
+  // One cache line per stripe so threads on different stripes do not
+  // false-share.
+  struct alignas(64) LockStripe {
+    std::shared_mutex mutex;
+  };
+  mutable std::array<LockStripe, kLockStripes> lockStripes_;
+
+  // movingByCoord_ is shared by every region.
+  mutable std::mutex movingMapMutex_;
+
   // Mutex specifically for tracking maps (byCoord_ and byEntity_) thread safety
   // Separate from terrainGridMutex for better performance (less lock
   // contention).
@@ -335,10 +499,10 @@ private:
 
   entt::registry &registry_;
   TerrainStorage &storage_;
-  std::unordered_map<VoxelCoord, entt::entity, VoxelCoordHash> byCoord_;
-  std::unordered_map<entt::entity, VoxelCoord> byEntity_;
-  std::unordered_map<VoxelCoord, MovingComponent, VoxelCoordHash>
-      movingByCoord_;
+  VoxelCoordMap<entt::entity> byCoord_;
+  EntityVoxelIndex byEntity_;
+  VoxelCoordMap<MovingComponent> movingByCoord_;
+  const MovementSchedule *movementSchedule_ = nullptr;
 
   entt::entity getEntityAt(int x, int y, int z) const;
   void markActive(int x, int y, int z, entt::entity e, bool takeLock = true);
@@ -383,8 +547,16 @@ void TerrainGridRepository::iterateBiomassMatter(Callback callback) const {
 
 template <typename Callback>
 void TerrainGridRepository::iterateActiveVoxels(Callback callback) const {
-  // Iterate through all active coordinates and provide full terrain info
-  for (const auto &[key, entity] : byCoord_) {
+  // Snapshot the active coordinates first: readTerrainInfo takes the
+  // tracking lock itself, and a concurrent insert may rehash byCoord_.
+  std::vector<VoxelCoord> keys;
+  {
+    std::shared_lock lock(trackingMapsMutex_);
+    keys.reserve(byCoord_.size());
+    byCoord_.forEach(
+        [&](const VoxelCoord &key, entt::entity) { keys.push_back(key); });
+  }
+  for (const VoxelCoord &key : keys) {
     TerrainInfo info = readTerrainInfo(key.x, key.y, key.z);
     callback(key.x, key.y, key.z, info);
   }
@@ -4,6 +4,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <variant>
 
 namespace {
 // Bit layout for flagsGrid (int32):
@@ -157,6 +162,216 @@ inline uint32_t encodeGradientVector(uint32_t flags,
   return setBits(flags, FlagBits::GRADIENT_SHIFT, FlagBits::GRADIENT_MASK,
                  packGradToBits(gradient));
 }
+
+// Stencil point sets, as TerrainStencil indices. BOX_27 walks x fastest so
+// consecutive reads stay in the same leaf where they can.
+constexpr std::array<int, 27> kBoxPoints = {
+    0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13,
+    14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26};
+constexpr std::array<int, 7> kFacePoints = {4, 10, 12, 13, 14, 16, 22};
+
+inline openvdb::Coord stencilCoord(const openvdb::Coord &c, int i) {
+  return c.offsetBy(i % 3 - 1, (i / 3) % 3 - 1, i / 9 - 1);
+}
+
+// Read `grid` at each stencil point around `c` into `out`. When the whole
+// 3x3x3 block sits inside one leaf (6/8 of voxels per axis) the leaf is
+// probed once and indexed directly; a missing leaf means the block is a
+// constant tile. Otherwise an unregistered accessor keeps the last leaf
+// cached between neighbours -- safe because the caller holds the grid lock,
+// and it skips the registration an ordinary accessor pays on construction.
+template <typename GridT, typename OutT, std::size_t N>
+void gatherStencil(const typename GridT::Ptr &grid, const openvdb::Coord &c,
+                   std::span<const int> points, std::array<OutT, N> &out) {
+  using TreeT = typename GridT::TreeType;
+  using LeafT = typename TreeT::LeafNodeType;
+  if (!grid) {
+    out.fill(OutT{});
+    return;
+  }
+  const TreeT &tree = grid->tree();
+  out.fill(static_cast<OutT>(tree.background()));
+
+  constexpr int kLeafMask = static_cast<int>(LeafT::DIM) - 1;
+  auto interior = [](int v) {
+    const int local = v & kLeafMask;
+    return local >= 1 && local <= kLeafMask - 1;
+  };
+  if (interior(c.x()) && interior(c.y()) && interior(c.z())) {
+    if (const LeafT *leaf = tree.probeConstLeaf(c)) {
+      for (int i : points) {
+        out[i] = static_cast<OutT>(leaf->getValue(stencilCoord(c, i)));
+      }
+    } else {
+      const auto v = static_cast<OutT>(tree.getValue(c));
+      for (int i : points) {
+        out[i] = v;
+      }
+    }
+    return;
+  }
+
+  openvdb::tree::ValueAccessor<const TreeT, /*IsSafe=*/false> acc(tree);
+  for (int i : points) {
+    out[i] = static_cast<OutT>(acc.getValue(stencilCoord(c, i)));
+  }
+}
+
+// Write accessor for one grid, created on first use so a batch only pays for
+// the grids it touches. Unregistered: it lives for one applyWrites() call
+// under the exclusive lock, during which no node is deleted.
+template <typename GridT> class BatchAccessor {
+public:
+  using AccessorT =
+      openvdb::tree::ValueAccessor<typename GridT::TreeType, /*IsSafe=*/false>;
+
+  explicit BatchAccessor(const typename GridT::Ptr &grid) : grid_(grid) {}
+
+  // Null when the grid has not been created.
+  AccessorT *get() {
+    if (!acc_ && grid_) {
+      acc_.emplace(grid_->tree());
+    }
+    return acc_ ? &*acc_ : nullptr;
+  }
+
+private:
+  const typename GridT::Ptr &grid_;
+  std::optional<AccessorT> acc_;
+};
+
+// Origin of the leaf holding (x, y, z), as a sortable key.
+inline std::tuple<int, int, int> leafKey(const TerrainWriteOp &op) {
+  constexpr int kMask =
+      ~(static_cast<int>(openvdb::Int32Tree::LeafNodeType::DIM) - 1);
+  return {op.z & kMask, op.y & kMask, op.x & kMask};
+}
+
+// Writes TerrainVoxelColumns rows into the leaves at one leaf origin of
+// every terrain grid. moveTo() only records the origin; the leaves are
+// touched on the first voxel actually written, so a leaf-sized block of
+// air allocates nothing.
+class TerrainLeafWriter {
+public:
+  using Int64Leaf = openvdb::Int64Tree::LeafNodeType;
+  using Int32Leaf = openvdb::Int32Tree::LeafNodeType;
+  using FloatLeaf = openvdb::FloatTree::LeafNodeType;
+  static_assert(Int64Leaf::DIM == Int32Leaf::DIM &&
+                FloatLeaf::DIM == Int32Leaf::DIM);
+  static constexpr int kDim = static_cast<int>(Int32Leaf::DIM);
+  static constexpr int kMask = ~(kDim - 1);
+
+  TerrainLeafWriter(const TerrainStorage &storage,
+                    const TerrainVoxelColumns &columns)
+      : storage_(storage), columns_(columns) {}
+
+  void moveTo(const openvdb::Coord &origin) {
+    origin_ = origin;
+    bound_ = false;
+  }
+
+  // Row `i` of the columns to voxel `c`, inside the current leaf.
+  void write(const openvdb::Coord &c, std::size_t i) {
+    const int64_t id =
+        columns_.terrainId
+            ? columns_.terrainId[i]
+            : static_cast<int64_t>(TerrainIdTypeEnum::ON_GRID_STORAGE);
+    if (id == static_cast<int64_t>(TerrainIdTypeEnum::NONE)) {
+      return;
+    }
+    if (!bound_) {
+      bind();
+    }
+    written_ = true;
+    const openvdb::Index n = Int32Leaf::coordToOffset(c);
+    setOn(terrain_, n, id);
+    setOn(mainType_, n, value(columns_.mainType, i));
+    setOn(subType0_, n, value(columns_.subType0, i));
+    setOn(subType1_, n, value(columns_.subType1, i));
+    setOn(terrainMatter_, n, value(columns_.terrainMatter, i));
+    // Zero water / vapor deactivates, as in the single-voxel setters.
+    setOnOrOff(waterMatter_, n, value(columns_.waterMatter, i));
+    setOnOrOff(vaporMatter_, n, value(columns_.vaporMatter, i));
+    setOn(biomassMatter_, n, value(columns_.biomassMatter, i));
+    setOn(mass_, n, value(columns_.mass, i));
+    setOn(maxSpeed_, n, value(columns_.maxSpeed, i));
+    setOn(minSpeed_, n, value(columns_.minSpeed, i));
+    // setPhysicsStats persists heat truncated to an int.
+    setOn(heat_, n,
+          static_cast<float>(static_cast<int>(value(columns_.heat, i))));
+    setOn(flags_, n, value(columns_.flags, i));
+    setOn(maxLoadCapacity_, n, value(columns_.maxLoadCapacity, i));
+  }
+
+  bool written() const { return written_; }
+
+private:
+  template <typename GridPtr>
+  auto *touch(const GridPtr &grid) const {
+    return grid ? grid->tree().touchLeaf(origin_) : nullptr;
+  }
+
+  void bind() {
+    terrain_ = touch(storage_.terrainGrid);
+    mainType_ = touch(storage_.mainTypeGrid);
+    subType0_ = touch(storage_.subType0Grid);
+    subType1_ = touch(storage_.subType1Grid);
+    terrainMatter_ = touch(storage_.terrainMatterGrid);
+    waterMatter_ = touch(storage_.waterMatterGrid);
+    vaporMatter_ = touch(storage_.vaporMatterGrid);
+    biomassMatter_ = touch(storage_.biomassMatterGrid);
+    mass_ = touch(storage_.massGrid);
+    maxSpeed_ = touch(storage_.maxSpeedGrid);
+    minSpeed_ = touch(storage_.minSpeedGrid);
+    heat_ = touch(storage_.heatGrid);
+    flags_ = touch(storage_.flagsGrid);
+    maxLoadCapacity_ = touch(storage_.maxLoadCapacityGrid);
+    bound_ = true;
+  }
+
+  template <typename T> static T value(const T *column, std::size_t i) {
+    return column ? column[i] : T{};
+  }
+
+  template <typename LeafT, typename T>
+  static void setOn(LeafT *leaf, openvdb::Index n, T v) {
+    if (leaf) {
+      leaf->setValueOn(n, v);
+    }
+  }
+
+  template <typename LeafT, typename T>
+  static void setOnOrOff(LeafT *leaf, openvdb::Index n, T v) {
+    if (!leaf) {
+      return;
+    }
+    if (v == T{}) {
+      leaf->setValueOff(n, v);
+    } else {
+      leaf->setValueOn(n, v);
+    }
+  }
+
+  const TerrainStorage &storage_;
+  const TerrainVoxelColumns &columns_;
+  openvdb::Coord origin_;
+  bool bound_ = false;
+  bool written_ = false;
+  Int64Leaf *terrain_ = nullptr;
+  Int32Leaf *mainType_ = nullptr;
+  Int32Leaf *subType0_ = nullptr;
+  Int32Leaf *subType1_ = nullptr;
+  Int32Leaf *terrainMatter_ = nullptr;
+  Int32Leaf *waterMatter_ = nullptr;
+  Int32Leaf *vaporMatter_ = nullptr;
+  Int32Leaf *biomassMatter_ = nullptr;
+  Int32Leaf *mass_ = nullptr;
+  Int32Leaf *maxSpeed_ = nullptr;
+  Int32Leaf *minSpeed_ = nullptr;
+  FloatLeaf *heat_ = nullptr;
+  Int32Leaf *flags_ = nullptr;
+  Int32Leaf *maxLoadCapacity_ = nullptr;
+};
 } // namespace
 
 // ------------------ TerrainStorage implementation ------------------
@@ -223,6 +438,56 @@ void TerrainStorage::applyTransform(double voxelSize_) {
   velZGrid->setTransform(xform);
 }
 
+// Region granularity is the level-1 node, so a region write can allocate
+// leaves in its own node without touching a node another region shares.
+static_assert(static_cast<int>(openvdb::Int64Tree::RootNodeType::
+                                   ChildNodeType::ChildNodeType::DIM) ==
+                  TerrainStorage::kRegionDim,
+              "kRegionLog2 must match the level-1 node size of the grid trees");
+
+void TerrainStorage::reserveRegions(int width, int height, int depth) {
+  const auto roundUp = [](int v) {
+    return v <= 0 ? 0 : ((v + kRegionDim - 1) >> kRegionLog2) << kRegionLog2;
+  };
+  reservedWidth = roundUp(width);
+  reservedHeight = roundUp(height);
+  reservedDepth = roundUp(depth);
+
+  // touchLeaf() allocates the whole root-to-leaf path; one leaf per region
+  // is enough to pin the region's level-1 node. The leaf stays inactive, so
+  // value iteration and counts do not see it.
+  auto reserve = [&](auto &grid) {
+    if (!grid) {
+      return;
+    }
+    auto &tree = grid->tree();
+    for (int z = 0; z < reservedDepth; z += kRegionDim) {
+      for (int y = 0; y < reservedHeight; y += kRegionDim) {
+        for (int x = 0; x < reservedWidth; x += kRegionDim) {
+          tree.touchLeaf(openvdb::Coord(x, y, z));
+        }
+      }
+    }
+  };
+  reserve(terrainGrid);
+  reserve(mainTypeGrid);
+  reserve(subType0Grid);
+  reserve(subType1Grid);
+  reserve(terrainMatterGrid);
+  reserve(waterMatterGrid);
+  reserve(vaporMatterGrid);
+  reserve(biomassMatterGrid);
+  reserve(massGrid);
+  reserve(maxSpeedGrid);
+  reserve(minSpeedGrid);
+  reserve(heatGrid);
+  reserve(velXGrid);
+  reserve(velYGrid);
+  reserve(velZGrid);
+  reserve(flagsGrid);
+  reserve(maxLoadCapacityGrid);
+}
+
 size_t TerrainStorage::memUsage() const {
   size_t total = 0;
   total += terrainGrid ? terrainGrid->memUsage() : 0;
@@ -522,6 +787,9 @@ void TerrainStorage::setTerrainSubType0(int x, int y, int z, int subType) {
   if (!subType0Grid)
     return;
   subType0Grid->tree().setValue(openvdb::Coord(x, y, z), subType);
+  if (changeLog) {
+    changeLog->record(x, y, z);
+  }
 }
 
 int TerrainStorage::getTerrainSubType0(int x, int y, int z) const {
@@ -803,6 +1071,11 @@ size_t TerrainStorage::prune(int currentTick) {
   markActive(waterMatterGrid);
   markActive(vaporMatterGrid);
   markActive(biomassMatterGrid);
+  // clear() dropped the terrain grid's reserved region nodes.
+  reserveRegions(reservedWidth, reservedHeight, reservedDepth);
+  if (changeLog) {
+    changeLog->recordAll();
+  }
 
   size_t activeCount = 0;
   for (auto it = terrainGrid->cbeginValueOn(); it; ++it) {
@@ -813,10 +1086,256 @@ size_t TerrainStorage::prune(int currentTick) {
   return activeCount;
 }
 
+void TerrainStorage::loadStencil(int x, int y, int z, uint32_t fields,
+                                 StencilShape shape,
+                                 TerrainStencil &out) const {
+  out.cx = x;
+  out.cy = y;
+  out.cz = z;
+  out.fields = fields;
+  out.shape = shape;
+
+  const openvdb::Coord c(x, y, z);
+  const std::span<const int> points =
+      shape == StencilShape::FACES_7 ? std::span<const int>(kFacePoints)
+                                     : std::span<const int>(kBoxPoints);
+
+  if (fields & StencilField::TERRAIN_ID) {
+    if (terrainGrid) {
+      gatherStencil<openvdb::Int64Grid>(terrainGrid, c, points, out.terrainId);
+    } else {
+      out.terrainId.fill(-2);
+    }
+  }
+  if (fields & StencilField::ENTITY_TYPE) {
+    gatherStencil<openvdb::Int32Grid>(mainTypeGrid, c, points, out.mainType);
+    gatherStencil<openvdb::Int32Grid>(subType0Grid, c, points, out.subType0);
+    gatherStencil<openvdb::Int32Grid>(subType1Grid, c, points, out.subType1);
+  }
+  if (fields & StencilField::MATTER) {
+    std::array<int, TerrainStencil::kSize> terrain, water, vapor, biomass;
+    gatherStencil<openvdb::Int32Grid>(terrainMatterGrid, c, points, terrain);
+    gatherStencil<openvdb::Int32Grid>(waterMatterGrid, c, points, water);
+    gatherStencil<openvdb::Int32Grid>(vaporMatterGrid, c, points, vapor);
+    gatherStencil<openvdb::Int32Grid>(biomassMatterGrid, c, points, biomass);
+    for (int i = 0; i < TerrainStencil::kSize; ++i) {
+      out.matter[i] = MatterContainer{terrain[i], vapor[i], water[i],
+                                      biomass[i]};
+    }
+  }
+  if (fields & StencilField::FLAGS) {
+    std::array<int, TerrainStencil::kSize> flags;
+    gatherStencil<openvdb::Int32Grid>(flagsGrid, c, points, flags);
+    for (int i = 0; i < TerrainStencil::kSize; ++i) {
+      const auto bits = static_cast<uint32_t>(flags[i]);
+      out.canStackEntities[i] = decodeCanStackEntities(bits);
+      out.matterState[i] = decodeMatterState(bits);
+    }
+  }
+}
+
+void TerrainStorage::applyWrites(TerrainWriteBatch &batch) {
+  auto &ops = batch.ops();
+  if (ops.empty()) {
+    return;
+  }
+  if (batch.order() == TerrainWriteOrder::BY_LEAF) {
+    std::stable_sort(ops.begin(), ops.end(),
+                     [](const TerrainWriteOp &a, const TerrainWriteOp &b) {
+                       return leafKey(a) < leafKey(b);
+                     });
+  }
+
+  BatchAccessor<openvdb::Int64Grid> terrainAcc(terrainGrid);
+  BatchAccessor<openvdb::Int32Grid> mainTypeAcc(mainTypeGrid);
+  BatchAccessor<openvdb::Int32Grid> subType0Acc(subType0Grid);
+  BatchAccessor<openvdb::Int32Grid> subType1Acc(subType1Grid);
+  BatchAccessor<openvdb::Int32Grid> terrainMatterAcc(terrainMatterGrid);
+  BatchAccessor<openvdb::Int32Grid> waterMatterAcc(waterMatterGrid);
+  BatchAccessor<openvdb::Int32Grid> vaporMatterAcc(vaporMatterGrid);
+  BatchAccessor<openvdb::Int32Grid> biomassMatterAcc(biomassMatterGrid);
+  BatchAccessor<openvdb::Int32Grid> massAcc(massGrid);
+  BatchAccessor<openvdb::Int32Grid> maxSpeedAcc(maxSpeedGrid);
+  BatchAccessor<openvdb::Int32Grid> minSpeedAcc(minSpeedGrid);
+  BatchAccessor<openvdb::FloatGrid> heatAcc(heatGrid);
+  BatchAccessor<openvdb::FloatGrid> velXAcc(velXGrid);
+  BatchAccessor<openvdb::FloatGrid> velYAcc(velYGrid);
+  BatchAccessor<openvdb::FloatGrid> velZAcc(velZGrid);
+  BatchAccessor<openvdb::Int32Grid> flagsAcc(flagsGrid);
+  BatchAccessor<openvdb::Int32Grid> maxLoadCapacityAcc(maxLoadCapacityGrid);
+
+  // Matter and velocity follow the single-voxel setters: writing zero
+  // deactivates the voxel so the sparse iterators skip it.
+  auto setOrOff = [](auto *acc, const openvdb::Coord &c, auto value) {
+    if (!acc) {
+      return;
+    }
+    if (value == decltype(value){}) {
+      acc->setValueOff(c, value);
+    } else {
+      acc->setValue(c, value);
+    }
+  };
+  auto set = [](auto *acc, const openvdb::Coord &c, auto value) {
+    if (acc) {
+      acc->setValue(c, value);
+    }
+  };
+
+  for (const TerrainWriteOp &op : ops) {
+    const openvdb::Coord c(op.x, op.y, op.z);
+    std::visit(
+        [&](const auto &v) {
+          using T = std::decay_t<decltype(v)>;
+          if constexpr (std::is_same_v<T, int64_t>) {
+            set(terrainAcc.get(), c, v);
+            if (changeLog) {
+              changeLog->record(op.x, op.y, op.z);
+            }
+          } else if constexpr (std::is_same_v<T, EntityTypeComponent>) {
+            set(mainTypeAcc.get(), c, v.mainType);
+            set(subType0Acc.get(), c, v.subType0);
+            set(subType1Acc.get(), c, v.subType1);
+            if (changeLog) {
+              changeLog->record(op.x, op.y, op.z);
+            }
+          } else if constexpr (std::is_same_v<T,
+                                              StructuralIntegrityComponent>) {
+            auto *flags = flagsAcc.get();
+            flags->setValue(c, static_cast<int>(encodeStructuralIntegrity(
+                                   v, static_cast<uint32_t>(
+                                          flags->getValue(c)))));
+            maxLoadCapacityAcc.get()->setValue(c, v.maxLoadCapacity);
+          } else if constexpr (std::is_same_v<T, MatterContainer>) {
+            set(terrainMatterAcc.get(), c, v.TerrainMatter);
+            setOrOff(vaporMatterAcc.get(), c, v.WaterVapor);
+            setOrOff(waterMatterAcc.get(), c, v.WaterMatter);
+            set(biomassMatterAcc.get(), c, v.BioMassMatter);
+          } else if constexpr (std::is_same_v<T, PhysicsStats>) {
+            set(heatAcc.get(), c,
+                static_cast<float>(static_cast<int>(v.heat)));
+            set(massAcc.get(), c, static_cast<int>(v.mass));
+            set(maxSpeedAcc.get(), c, static_cast<int>(v.maxSpeed));
+            set(minSpeedAcc.get(), c, static_cast<int>(v.minSpeed));
+          } else if constexpr (std::is_same_v<T, DirectionEnum>) {
+            auto *flags = flagsAcc.get();
+            flags->setValue(
+                c, static_cast<int>(encodeDirection(
+                       static_cast<uint32_t>(flags->getValue(c)), v)));
+          } else if constexpr (std::is_same_v<T, Velocity>) {
+            if (v.vx == 0.0f && v.vy == 0.0f && v.vz == 0.0f) {
+              setOrOff(velXAcc.get(), c, 0.0f);
+              setOrOff(velYAcc.get(), c, 0.0f);
+              setOrOff(velZAcc.get(), c, 0.0f);
+            } else {
+              set(velXAcc.get(), c, v.vx);
+              set(velYAcc.get(), c, v.vy);
+              set(velZAcc.get(), c, v.vz);
+            }
+          } else if constexpr (std::is_same_v<T, TerrainClear>) {
+            // Same sentinels as deleteTerrain().
+            if (auto *terrain = terrainAcc.get()) {
+              terrain->setValueOff(c, -2);
+            }
+            mainTypeAcc.get()->setValueOff(c, -1);
+            subType0Acc.get()->setValueOff(c, -1);
+            subType1Acc.get()->setValueOff(c, -2);
+            terrainMatterAcc.get()->setValueOff(c, 0);
+            waterMatterAcc.get()->setValueOff(c, 0);
+            vaporMatterAcc.get()->setValueOff(c, 0);
+            biomassMatterAcc.get()->setValueOff(c, 0);
+            massAcc.get()->setValueOff(c, 0);
+            maxSpeedAcc.get()->setValueOff(c, 0);
+            minSpeedAcc.get()->setValueOff(c, 0);
+            flagsAcc.get()->setValueOff(c, 0);
+            maxLoadCapacityAcc.get()->setValueOff(c, 0);
+            setOrOff(velXAcc.get(), c, 0.0f);
+            setOrOff(velYAcc.get(), c, 0.0f);
+            setOrOff(velZAcc.get(), c, 0.0f);
+            if (changeLog) {
+              changeLog->record(op.x, op.y, op.z);
+            }
+          }
+        },
+        op.value);
+  }
+  ops.clear();
+}
+
+void TerrainStorage::loadBox(int x0, int y0, int z0, int width, int height,
+                             int depth, const TerrainVoxelColumns &columns) {
+  if (width <= 0 || height <= 0 || depth <= 0) {
+    return;
+  }
+  constexpr int kDim = TerrainLeafWriter::kDim;
+  constexpr int kMask = TerrainLeafWriter::kMask;
+  const int x1 = x0 + width, y1 = y0 + height, z1 = z0 + depth;
+  TerrainLeafWriter writer(*this, columns);
+  for (int bz = z0 & kMask; bz < z1; bz += kDim) {
+    for (int by = y0 & kMask; by < y1; by += kDim) {
+      for (int bx = x0 & kMask; bx < x1; bx += kDim) {
+        writer.moveTo(openvdb::Coord(bx, by, bz));
+        for (int z = std::max(bz, z0); z < std::min(bz + kDim, z1); ++z) {
+          for (int y = std::max(by, y0); y < std::min(by + kDim, y1); ++y) {
+            const std::size_t row =
+                (static_cast<std::size_t>(z - z0) * height + (y - y0)) *
+                width;
+            for (int x = std::max(bx, x0); x < std::min(bx + kDim, x1); ++x) {
+              writer.write(openvdb::Coord(x, y, z), row + (x - x0));
+            }
+          }
+        }
+      }
+    }
+  }
+  if (changeLog && writer.written()) {
+    changeLog->recordAll();
+  }
+}
+
+void TerrainStorage::loadPoints(const int32_t *xyz, std::size_t count,
+                                const TerrainVoxelColumns &columns) {
+  constexpr int kMask = TerrainLeafWriter::kMask;
+  auto leafOf = [&](std::size_t i) {
+    const int32_t *p = xyz + 3 * i;
+    return std::tuple<int, int, int>{p[2] & kMask, p[1] & kMask,
+                                     p[0] & kMask};
+  };
+  std::vector<std::size_t> order(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    order[i] = i;
+  }
+  // Leaf order; repeated points keep their order, so the last one wins.
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t a, std::size_t b) {
+                     return leafOf(a) < leafOf(b);
+                   });
+
+  TerrainLeafWriter writer(*this, columns);
+  std::tuple<int, int, int> current{};
+  for (std::size_t k = 0; k < count; ++k) {
+    const std::size_t i = order[k];
+    const std::tuple<int, int, int> leaf = leafOf(i);
+    if (k == 0 || leaf != current) {
+      current = leaf;
+      const auto [lz, ly, lx] = leaf;
+      writer.moveTo(openvdb::Coord(lx, ly, lz));
+    }
+    const int32_t *p = xyz + 3 * i;
+    writer.write(openvdb::Coord(p[0], p[1], p[2]), i);
+  }
+  if (changeLog && writer.written()) {
+    changeLog->recordAll();
+  }
+}
+
 void TerrainStorage::setTerrainId(int x, int y, int z, int64_t id) {
   if (terrainGrid) {
     terrainGrid->tree().setValue(openvdb::Coord(x, y, z), id);
   }
+  if (changeLog) {
+    changeLog->record(x, y, z);
+  }
 }
 
 bool TerrainStorage::checkIfTerrainExists(int x, int y, int z) const {
@@ -874,6 +1393,9 @@ int TerrainStorage::deleteTerrain(int x, int y, int z) {
   if (velZGrid)
     velZGrid->tree().setValueOff(coord, 0.0f);
 
+  if (changeLog) {
+    changeLog->record(x, y, z);
+  }
   return oldTerrainId;
 }
 
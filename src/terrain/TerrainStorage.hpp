@@ -3,12 +3,171 @@
 
 #include <openvdb/openvdb.h>
 
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <unordered_map>
+#include <variant>
 #include <vector>
 
+#include "components/EntityTypeComponent.hpp"
 #include "components/PhysicsComponents.hpp"
+#include "components/TerrainComponents.hpp"
+#include "terrain/VoxelChangeLog.hpp"
+
+// --------------------- Neighbourhood stencil ---------------------
+// Attribute groups TerrainStorage::loadStencil() can gather; OR together.
+namespace StencilField {
+constexpr uint32_t TERRAIN_ID = 1u << 0;  // terrainGrid
+constexpr uint32_t ENTITY_TYPE = 1u << 1; // mainType, subType0, subType1
+constexpr uint32_t MATTER = 1u << 2;      // all four MatterContainer grids
+constexpr uint32_t FLAGS = 1u << 3;       // canStackEntities, matterState
+} // namespace StencilField
+
+enum class StencilShape {
+  FACES_7, // centre + six face neighbours
+  BOX_27   // full 3x3x3 block
+};
+
+// Selected attributes of a voxel and its neighbours, read in one pass so
+// neighbour-heavy code (water spread, collision, stability) pays for one
+// lock and a handful of leaf lookups instead of a root-to-leaf descent per
+// attribute per neighbour. Entries are indexed by offset in [-1, 1]^3;
+// entries outside the shape, or of fields not requested, hold the grid
+// background.
+struct TerrainStencil {
+  static constexpr int kSize = 27;
+  static constexpr int index(int dx, int dy, int dz) {
+    return (dz + 1) * 9 + (dy + 1) * 3 + (dx + 1);
+  }
+  static constexpr int kCentre = 13;
+
+  int cx = 0, cy = 0, cz = 0;
+  uint32_t fields = 0;
+  StencilShape shape = StencilShape::BOX_27;
+
+  std::array<int64_t, kSize> terrainId{};
+  std::array<int, kSize> mainType{};
+  std::array<int, kSize> subType0{};
+  std::array<int, kSize> subType1{};
+  std::array<MatterContainer, kSize> matter{};
+  std::array<bool, kSize> canStackEntities{};
+  std::array<MatterState, kSize> matterState{};
+
+  // True when absolute voxel (x, y, z) was read by the load.
+  bool covers(int x, int y, int z) const {
+    const int dx = x - cx, dy = y - cy, dz = z - cz;
+    if (dx < -1 || dx > 1 || dy < -1 || dy > 1 || dz < -1 || dz > 1) {
+      return false;
+    }
+    return shape == StencilShape::BOX_27 ||
+           (dx != 0) + (dy != 0) + (dz != 0) <= 1;
+  }
+  // Index of absolute voxel (x, y, z); only valid when covers() is true.
+  int at(int x, int y, int z) const {
+    return index(x - cx, y - cy, z - cz);
+  }
+  bool terrainExists(int i) const { return terrainId[i] != -2; }
+};
+
+// --------------------- Batched writes ---------------------
+// Resets every attribute of a voxel, as TerrainStorage::deleteTerrain does.
+struct TerrainClear {};
+
+// One typed write. The int64_t alternative is a terrain id.
+using TerrainWriteValue =
+    std::variant<int64_t, EntityTypeComponent, StructuralIntegrityComponent,
+                 MatterContainer, PhysicsStats, DirectionEnum, Velocity,
+                 TerrainClear>;
+
+struct TerrainWriteOp {
+  int x = 0, y = 0, z = 0;
+  TerrainWriteValue value;
+};
+
+enum class TerrainWriteOrder {
+  SUBMISSION, // apply ops in the order they were added
+  BY_LEAF     // group ops by VDB leaf; ops on one voxel keep their order
+};
+
+// Terrain writes collected by a caller and applied together by
+// TerrainGridRepository::applyWriteBatch() under one unique lock, through one
+// accessor per touched grid. Each op writes exactly what the matching
+// single-voxel repository setter writes (zero water/vapor/velocity
+// deactivates the voxel, PhysicsStats persists mass/speed/heat only, ...).
+// An op only touches its own voxel, so regrouping by leaf is safe.
+class TerrainWriteBatch {
+public:
+  explicit TerrainWriteBatch(
+      TerrainWriteOrder order = TerrainWriteOrder::SUBMISSION)
+      : order_(order) {}
+
+  void setTerrainId(int x, int y, int z, int64_t terrainId) {
+    ops_.push_back({x, y, z, terrainId});
+  }
+  void setTerrainEntityType(int x, int y, int z,
+                            const EntityTypeComponent &etc) {
+    ops_.push_back({x, y, z, etc});
+  }
+  void setTerrainStructuralIntegrity(int x, int y, int z,
+                                     const StructuralIntegrityComponent &sic) {
+    ops_.push_back({x, y, z, sic});
+  }
+  void setTerrainMatterContainer(int x, int y, int z,
+                                 const MatterContainer &mc) {
+    ops_.push_back({x, y, z, mc});
+  }
+  void setPhysicsStats(int x, int y, int z, const PhysicsStats &ps) {
+    ops_.push_back({x, y, z, ps});
+  }
+  // Coordinates are implied by (x, y, z); only the direction is persisted.
+  void setPosition(int x, int y, int z, const Position &pos) {
+    ops_.push_back({x, y, z, pos.direction});
+  }
+  void setVelocity(int x, int y, int z, const Velocity &vel) {
+    ops_.push_back({x, y, z, vel});
+  }
+  void deleteTerrain(int x, int y, int z) {
+    ops_.push_back({x, y, z, TerrainClear{}});
+  }
+
+  TerrainWriteOrder order() const { return order_; }
+  bool empty() const { return ops_.empty(); }
+  std::size_t size() const { return ops_.size(); }
+  std::vector<TerrainWriteOp> &ops() { return ops_; }
+  const std::vector<TerrainWriteOp> &ops() const { return ops_; }
+  void clear() { ops_.clear(); }
+
+private:
+  TerrainWriteOrder order_;
+  std::vector<TerrainWriteOp> ops_;
+};
+
+// --------------------- Bulk loads ---------------------
+// Per-voxel attribute columns for TerrainStorage::loadBox() / loadPoints(),
+// one value per voxel in load order. A null column writes what the
+// plain-terrain path writes for a missing component: zero, or
+// ON_GRID_STORAGE (-1) for the terrain id. That includes subType1, whose
+// grid background (-1) only marks voxels never written. Voxels whose
+// terrain id is NONE (-2) are skipped and keep what they held, so a box
+// can carry its air.
+struct TerrainVoxelColumns {
+  const int64_t *terrainId = nullptr;
+  const int32_t *mainType = nullptr;
+  const int32_t *subType0 = nullptr;
+  const int32_t *subType1 = nullptr;
+  const int32_t *terrainMatter = nullptr;
+  const int32_t *waterMatter = nullptr;
+  const int32_t *vaporMatter = nullptr;
+  const int32_t *biomassMatter = nullptr;
+  const int32_t *mass = nullptr;
+  const int32_t *maxSpeed = nullptr;
+  const int32_t *minSpeed = nullptr;
+  const float *heat = nullptr;
+  const int32_t *flags = nullptr; // packed flagsGrid bits, see getFlagBits
+  const int32_t *maxLoadCapacity = nullptr;
+};
 
 // --------------------- TerrainStorage Repo ---------------------
 class TerrainStorage {
@@ -64,10 +223,41 @@ public:
   int pruneInterval = 60; // ticks
   int lastPruneTick = 0;
 
+  // Where terrain id and subType0 changes are recorded (setTerrainId,
+  // setTerrainSubType0, deleteTerrain, applyWrites; prune records a bulk
+  // change). Optional and not owned; VoxelGrid points it at its own log.
+  VoxelChangeLog *changeLog = nullptr;
+
+  // Extent covered by reserveRegions(), rounded up to whole regions.
+  int reservedWidth = 0;
+  int reservedHeight = 0;
+  int reservedDepth = 0;
+
   TerrainStorage();
   void initialize();
   void applyTransform(double voxelSize_);
 
+  // ---------------- Regions ----------------
+  // A region is one level-1 internal node of the grid trees (128^3 voxels
+  // for Tree4<5,4,3>). Once a region's nodes exist in every grid, writes
+  // inside it only touch that region's node and its leaves, so writers in
+  // different regions can run concurrently (see TerrainGridRepository's
+  // region locks). Writes to an unreserved region may allocate upper-level
+  // nodes and must hold the whole grid exclusively.
+  static constexpr int kRegionLog2 = 7;
+  static constexpr int kRegionDim = 1 << kRegionLog2;
+  static int regionIndex(int v) { return v >> kRegionLog2; }
+
+  // Allocate the level-1 nodes covering [0, width) x [0, height) x
+  // [0, depth) in every grid. Caller holds the terrain grid lock
+  // exclusively. Anything that clears or prunes the grids must call this
+  // again.
+  void reserveRegions(int width, int height, int depth);
+  bool regionReserved(int x, int y, int z) const {
+    return x >= 0 && y >= 0 && z >= 0 && x < reservedWidth &&
+           y < reservedHeight && z < reservedDepth;
+  }
+
   // Memory usage of all terrain-related grids
   size_t memUsage() const;
 
@@ -154,6 +344,27 @@ public:
   bool isActive(int x, int y, int z) const;
   size_t prune(int currentTick);
 
+  // Fill `out` with the requested StencilField attributes around (x, y, z).
+  // Caller holds the terrain grid lock (shared is enough).
+  void loadStencil(int x, int y, int z, uint32_t fields, StencilShape shape,
+                   TerrainStencil &out) const;
+
+  // Apply and clear every op in `batch`, sorting first when its order is
+  // BY_LEAF. Caller holds the terrain grid lock exclusively.
+  void applyWrites(TerrainWriteBatch &batch);
+
+  // World construction in bulk. Every loaded voxel gets all attributes
+  // from `columns`, written by offset into leaves that are looked up once
+  // per leaf and grid instead of once per voxel and grid. loadBox covers
+  // [x0, x0 + width) x [y0, y0 + height) x [z0, z0 + depth) with columns
+  // in x-fastest order; loadPoints takes `count` (x, y, z) triples. The
+  // change log records a bulk change. Caller holds the terrain grid lock
+  // exclusively.
+  void loadBox(int x0, int y0, int z0, int width, int height, int depth,
+               const TerrainVoxelColumns &columns);
+  void loadPoints(const int32_t *xyz, std::size_t count,
+                  const TerrainVoxelColumns &columns);
+
   // Delete terrain at a specific voxel
   int deleteTerrain(int x, int y, int z);
 
@@ -0,0 +1,71 @@
+#ifndef VOXEL_CHANGE_LOG_HPP
+#define VOXEL_CHANGE_LOG_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "terrain/VoxelCoord.hpp"
+
+// Coordinates whose support-relevant state changed since the last drain:
+// terrain created, deleted or retyped (TerrainStorage) and entity-grid
+// writes (VoxelGrid). Consumers that cache a conclusion drawn from those
+// voxels -- e.g. "this entity rests on solid ground" -- drain it once per
+// pass and re-check only what the recorded voxels could have changed.
+//
+// Writers can be on any thread. Each thread appends to one of kShards
+// buffers picked by thread id, so concurrent writers rarely share a mutex.
+// Bulk rewrites (deserialise, prune) call recordAll() instead of listing
+// every voxel; a log that grows past kMaxPending without being drained
+// collapses to the same state.
+class VoxelChangeLog {
+public:
+  static constexpr std::size_t kShards = 16;
+  static constexpr std::size_t kMaxPending = 1 << 20;
+
+  void record(int x, int y, int z) {
+    Shard &shard = shards_[shardIndex()];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.coords.size() >= kMaxPending / kShards) {
+      shard.coords.clear();
+      everything_.store(true, std::memory_order_relaxed);
+      return;
+    }
+    shard.coords.push_back(VoxelCoord{x, y, z});
+  }
+
+  void recordAll() { everything_.store(true, std::memory_order_relaxed); }
+
+  // Appends every recorded coordinate to `out` (duplicates included) and
+  // resets the log. Returns true when recordAll() was hit since the last
+  // drain, in which case `out` is not a complete list of changes.
+  bool drain(std::vector<VoxelCoord> &out) {
+    for (Shard &shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      out.insert(out.end(), shard.coords.begin(), shard.coords.end());
+      shard.coords.clear();
+    }
+    return everything_.exchange(false, std::memory_order_relaxed);
+  }
+
+private:
+  struct alignas(64) Shard {
+    std::mutex mutex;
+    std::vector<VoxelCoord> coords;
+  };
+
+  static std::size_t shardIndex() {
+    thread_local const std::size_t index =
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) % kShards;
+    return index;
+  }
+
+  std::array<Shard, kShards> shards_;
+  std::atomic<bool> everything_{false};
+};
+
+#endif // VOXEL_CHANGE_LOG_HPP
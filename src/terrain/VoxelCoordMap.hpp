@@ -0,0 +1,247 @@
+#ifndef VOXEL_COORD_MAP_HPP
+#define VOXEL_COORD_MAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "terrain/VoxelCoord.hpp"
+
+// Flat containers for the repository's voxel <-> entity bookkeeping. The
+// std::unordered_map versions allocated a node per entry, so heavy
+// activate/deactivate churn (rain storms) paid for malloc/free and a pointer
+// chase on every lookup. These keep entries inline in one array.
+
+// 63-bit Morton (Z-order) code of a voxel: 21 bits per axis, biased so
+// coordinates in [-2^20, 2^20) encode. One integer compare per probe, and
+// neighbouring voxels share high bits.
+inline uint64_t mortonEncode(const VoxelCoord &c) {
+  auto spread = [](int v) {
+    uint64_t x = static_cast<uint64_t>(static_cast<uint32_t>(v + (1 << 20))) &
+                 0x1fffffULL;
+    x = (x | x << 32) & 0x1f00000000ffffULL;
+    x = (x | x << 16) & 0x1f0000ff0000ffULL;
+    x = (x | x << 8) & 0x100f00f00f00f00fULL;
+    x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+    x = (x | x << 2) & 0x1249249249249249ULL;
+    return x;
+  };
+  return spread(c.x) | spread(c.y) << 1 | spread(c.z) << 2;
+}
+
+inline VoxelCoord mortonDecode(uint64_t code) {
+  auto compact = [](uint64_t x) {
+    x &= 0x1249249249249249ULL;
+    x = (x | x >> 2) & 0x10c30c30c30c30c3ULL;
+    x = (x | x >> 4) & 0x100f00f00f00f00fULL;
+    x = (x | x >> 8) & 0x1f0000ff0000ffULL;
+    x = (x | x >> 16) & 0x1f00000000ffffULL;
+    x = (x | x >> 32) & 0x1fffffULL;
+    return static_cast<int>(x) - (1 << 20);
+  };
+  return VoxelCoord{compact(code), compact(code >> 1), compact(code >> 2)};
+}
+
+// Open-addressing VoxelCoord -> V map with linear probing and
+// backward-shift deletion (no tombstones, so churn does not degrade probe
+// lengths). Capacity is a power of two kept at most 7/8 full.
+//
+// Pointers returned by find() stay valid until the next insert or erase.
+// Not thread-safe; callers lock as they did around the std::unordered_map.
+template <typename V> class VoxelCoordMap {
+public:
+  V *find(const VoxelCoord &key) {
+    const std::size_t i = slotOf(mortonEncode(key));
+    return i == kNotFound ? nullptr : &slots_[i].value;
+  }
+  const V *find(const VoxelCoord &key) const {
+    const std::size_t i = slotOf(mortonEncode(key));
+    return i == kNotFound ? nullptr : &slots_[i].value;
+  }
+  bool contains(const VoxelCoord &key) const { return find(key) != nullptr; }
+
+  // Inserts a value-initialised entry when `key` is absent.
+  V &operator[](const VoxelCoord &key) {
+    const uint64_t code = mortonEncode(key);
+    if ((size_ + 1) * 8 > slots_.size() * 7) {
+      rehash(slots_.empty() ? kMinCapacity : slots_.size() * 2);
+    }
+    std::size_t i = home(code);
+    while (slots_[i].code != kEmpty) {
+      if (slots_[i].code == code) {
+        return slots_[i].value;
+      }
+      i = (i + 1) & mask_;
+    }
+    slots_[i].code = code;
+    slots_[i].value = V{};
+    ++size_;
+    return slots_[i].value;
+  }
+
+  bool erase(const VoxelCoord &key) {
+    std::size_t hole = slotOf(mortonEncode(key));
+    if (hole == kNotFound) {
+      return false;
+    }
+    // Shift later members of the probe run back so lookups never stop
+    // early at the hole.
+    std::size_t i = hole;
+    for (;;) {
+      i = (i + 1) & mask_;
+      if (slots_[i].code == kEmpty) {
+        break;
+      }
+      const std::size_t want = home(slots_[i].code);
+      if (((i - want) & mask_) >= ((i - hole) & mask_)) {
+        slots_[hole] = std::move(slots_[i]);
+        hole = i;
+      }
+    }
+    slots_[hole].code = kEmpty;
+    slots_[hole].value = V{};
+    --size_;
+    return true;
+  }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void clear() {
+    slots_.clear();
+    mask_ = 0;
+    size_ = 0;
+  }
+
+  void reserve(std::size_t n) {
+    std::size_t capacity = kMinCapacity;
+    while (capacity * 7 < n * 8) {
+      capacity *= 2;
+    }
+    if (capacity > slots_.size()) {
+      rehash(capacity);
+    }
+  }
+
+  // fn(const VoxelCoord &key, const V &value) for every entry, in slot
+  // order. Do not modify the map from `fn`.
+  template <typename Fn> void forEach(Fn &&fn) const {
+    for (const Slot &slot : slots_) {
+      if (slot.code != kEmpty) {
+        fn(mortonDecode(slot.code), slot.value);
+      }
+    }
+  }
+
+private:
+  static constexpr uint64_t kEmpty = ~uint64_t{0}; // Morton codes use 63 bits
+  static constexpr std::size_t kNotFound = ~std::size_t{0};
+  static constexpr std::size_t kMinCapacity = 64;
+
+  struct Slot {
+    uint64_t code = kEmpty;
+    V value{};
+  };
+
+  // Fibonacci hashing: Morton codes of nearby voxels differ in their low
+  // bits, which a plain mask would cluster.
+  std::size_t home(uint64_t code) const {
+    return static_cast<std::size_t>((code * 0x9e3779b97f4a7c15ULL) >> 32) &
+           mask_;
+  }
+
+  std::size_t slotOf(uint64_t code) const {
+    if (size_ == 0) {
+      return kNotFound;
+    }
+    for (std::size_t i = home(code);; i = (i + 1) & mask_) {
+      if (slots_[i].code == code) {
+        return i;
+      }
+      if (slots_[i].code == kEmpty) {
+        return kNotFound;
+      }
+    }
+  }
+
+  void rehash(std::size_t capacity) {
+    std::vector<Slot> old = std::move(slots_);
+    slots_.assign(capacity, Slot{});
+    mask_ = capacity - 1;
+    for (Slot &slot : old) {
+      if (slot.code == kEmpty) {
+        continue;
+      }
+      std::size_t i = home(slot.code);
+      while (slots_[i].code != kEmpty) {
+        i = (i + 1) & mask_;
+      }
+      slots_[i] = std::move(slot);
+    }
+  }
+
+  std::vector<Slot> slots_;
+  std::size_t mask_ = 0;
+  std::size_t size_ = 0;
+};
+
+// entt::entity -> VoxelCoord as a dense array indexed by entity id. The
+// stored entity (with its version) tells a live entry from a recycled id.
+class EntityVoxelIndex {
+public:
+  const VoxelCoord *find(entt::entity e) const {
+    const std::size_t i = indexOf(e);
+    if (i >= slots_.size() || slots_[i].entity != e) {
+      return nullptr;
+    }
+    return &slots_[i].coord;
+  }
+
+  void set(entt::entity e, const VoxelCoord &coord) {
+    const std::size_t i = indexOf(e);
+    if (i >= slots_.size()) {
+      slots_.resize(std::max<std::size_t>(i + 1, slots_.size() * 2));
+    }
+    if (slots_[i].entity != e) {
+      size_ += slots_[i].entity == entt::null ? 1 : 0;
+      slots_[i].entity = e;
+    }
+    slots_[i].coord = coord;
+  }
+
+  bool erase(entt::entity e) {
+    const std::size_t i = indexOf(e);
+    if (i >= slots_.size() || slots_[i].entity != e) {
+      return false;
+    }
+    slots_[i].entity = entt::null;
+    --size_;
+    return true;
+  }
+
+  std::size_t size() const { return size_; }
+
+  void clear() {
+    slots_.clear();
+    size_ = 0;
+  }
+
+private:
+  struct Slot {
+    entt::entity entity = entt::null;
+    VoxelCoord coord{0, 0, 0};
+  };
+
+  static std::size_t indexOf(entt::entity e) {
+    return static_cast<std::size_t>(entt::to_entity(e));
+  }
+
+  std::vector<Slot> slots_;
+  std::size_t size_ = 0;
+};
+
+#endif // VOXEL_COORD_MAP_HPP
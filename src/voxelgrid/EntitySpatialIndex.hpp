@@ -0,0 +1,239 @@
+#ifndef ENTITY_SPATIAL_INDEX_HPP
+#define ENTITY_SPATIAL_INDEX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Cell lists over the non-terrain entities of VoxelGrid's entity grid, for
+// "who is near here" queries that would otherwise visit every voxel of the
+// region. Space is cut into cubes of `cellSize` voxels; each occupied cube
+// keeps the ids and positions of its entities, and each id remembers its
+// cube and slot so moves and removals are O(1).
+//
+// VoxelGrid keeps it in step with every entity-grid write and guards it
+// with entityGridMutex, like the grid itself; the class does no locking.
+// Only ids >= 0 are indexed: the grid's negative values mark empty cells.
+class EntitySpatialIndex {
+public:
+  struct Entry {
+    int id;
+    int x, y, z;
+  };
+
+  explicit EntitySpatialIndex(int cellSize = 8)
+      : cellSize_(std::max(1, cellSize)) {}
+
+  void clear() {
+    cells_.clear();
+    slots_.clear();
+  }
+
+  std::size_t size() const { return slots_.size(); }
+  bool contains(int id) const { return slots_.count(id) != 0; }
+
+  // Puts `id` at (x, y, z), moving it if it is already indexed.
+  void insert(int id, int x, int y, int z) {
+    if (id < 0) {
+      return;
+    }
+    const uint64_t key = cellKey(x, y, z);
+    auto found = slots_.find(id);
+    if (found != slots_.end()) {
+      Slot &slot = found->second;
+      if (slot.cell == key) {
+        Entry &entry = cells_[key][slot.index];
+        entry.x = x, entry.y = y, entry.z = z;
+        return;
+      }
+      detach(slot);
+    }
+    std::vector<Entry> &cell = cells_[key];
+    slots_[id] = Slot{key, static_cast<uint32_t>(cell.size())};
+    cell.push_back(Entry{id, x, y, z});
+  }
+
+  // Removes `id` if it is indexed at (x, y, z); an id that has since been
+  // placed elsewhere stays. Returns whether it was removed.
+  bool erase(int id, int x, int y, int z) {
+    auto found = slots_.find(id);
+    if (found == slots_.end()) {
+      return false;
+    }
+    const Entry &entry = cells_[found->second.cell][found->second.index];
+    if (entry.x != x || entry.y != y || entry.z != z) {
+      return false;
+    }
+    detach(found->second);
+    slots_.erase(found);
+    return true;
+  }
+
+  // Calls f(entry) for every entity inside the inclusive box.
+  template <typename F>
+  void forEachInBox(int xMin, int yMin, int zMin, int xMax, int yMax,
+                    int zMax, F &&f) const {
+    for (int cz = cellOf(zMin); cz <= cellOf(zMax); ++cz) {
+      for (int cy = cellOf(yMin); cy <= cellOf(yMax); ++cy) {
+        for (int cx = cellOf(xMin); cx <= cellOf(xMax); ++cx) {
+          auto cell = cells_.find(packKey(cx, cy, cz));
+          if (cell == cells_.end()) {
+            continue;
+          }
+          for (const Entry &e : cell->second) {
+            if (e.x >= xMin && e.x <= xMax && e.y >= yMin && e.y <= yMax &&
+                e.z >= zMin && e.z <= zMax) {
+              f(e);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Ids within Euclidean `radius` of (x, y, z), in no particular order.
+  std::vector<int> inRadius(int x, int y, int z, float radius) const {
+    std::vector<int> ids;
+    if (radius < 0) {
+      return ids;
+    }
+    const int r = static_cast<int>(std::floor(radius));
+    const int64_t limit = static_cast<int64_t>(
+        std::floor(static_cast<double>(radius) * radius));
+    forEachInBox(x - r, y - r, z - r, x + r, y + r, z + r,
+                 [&](const Entry &e) {
+                   if (distance2(e, x, y, z) <= limit) {
+                     ids.push_back(e.id);
+                   }
+                 });
+    return ids;
+  }
+
+  // Up to `k` ids nearest to (x, y, z) within `maxRadius`, nearest first;
+  // ties go to the lower id. Searches shells of cells outwards and stops
+  // once no unvisited cell can hold anything closer.
+  std::vector<int> nearest(int x, int y, int z, std::size_t k,
+                           float maxRadius) const {
+    std::vector<int> ids;
+    if (k == 0 || maxRadius < 0 || slots_.empty()) {
+      return ids;
+    }
+    const double maxDistance2 = static_cast<double>(maxRadius) * maxRadius;
+    using Candidate = std::pair<int64_t, int>; // (distance², id)
+    std::priority_queue<Candidate> best;       // farthest on top
+    auto consider = [&](const Entry &e) {
+      const int64_t d2 = distance2(e, x, y, z);
+      if (d2 > maxDistance2) {
+        return;
+      }
+      const Candidate candidate{d2, e.id};
+      if (best.size() < k) {
+        best.push(candidate);
+      } else if (candidate < best.top()) {
+        best.pop();
+        best.push(candidate);
+      }
+    };
+
+    const int cx = cellOf(x), cy = cellOf(y), cz = cellOf(z);
+    std::size_t seen = 0;
+    for (int ring = 0;; ++ring) {
+      // Everything in this shell is at least (ring - 1) cells away.
+      const double reach = static_cast<double>(ring - 1) * cellSize_;
+      const double reach2 = reach * reach;
+      if (ring > 0 &&
+          (reach2 >= maxDistance2 || seen == slots_.size() ||
+           (best.size() == k && reach2 >= best.top().first))) {
+        break;
+      }
+      forEachCellInShell(cx, cy, cz, ring,
+                         [&](const std::vector<Entry> &cell) {
+                           seen += cell.size();
+                           for (const Entry &e : cell) {
+                             consider(e);
+                           }
+                         });
+    }
+
+    ids.resize(best.size());
+    for (std::size_t i = best.size(); i-- > 0; best.pop()) {
+      ids[i] = best.top().second;
+    }
+    return ids;
+  }
+
+private:
+  struct Slot {
+    uint64_t cell;
+    uint32_t index;
+  };
+
+  static constexpr int kKeyBits = 21;
+  static constexpr int kKeyBias = 1 << (kKeyBits - 1);
+
+  int cellOf(int v) const {
+    // Floor division, so negative coordinates get their own cells.
+    return v >= 0 ? v / cellSize_ : -((-v - 1) / cellSize_) - 1;
+  }
+
+  static uint64_t packKey(int cx, int cy, int cz) {
+    const uint64_t mask = (uint64_t{1} << kKeyBits) - 1;
+    return (static_cast<uint64_t>(cx + kKeyBias) & mask) << (2 * kKeyBits) |
+           (static_cast<uint64_t>(cy + kKeyBias) & mask) << kKeyBits |
+           (static_cast<uint64_t>(cz + kKeyBias) & mask);
+  }
+
+  uint64_t cellKey(int x, int y, int z) const {
+    return packKey(cellOf(x), cellOf(y), cellOf(z));
+  }
+
+  static int64_t distance2(const Entry &e, int x, int y, int z) {
+    const int64_t dx = e.x - x, dy = e.y - y, dz = e.z - z;
+    return dx * dx + dy * dy + dz * dz;
+  }
+
+  // Takes the entry `slot` points at out of its cell: the cell's last
+  // entry moves into the hole and empty cells are dropped.
+  void detach(const Slot &slot) {
+    auto cell = cells_.find(slot.cell);
+    std::vector<Entry> &entries = cell->second;
+    if (slot.index + 1 != entries.size()) {
+      entries[slot.index] = entries.back();
+      slots_[entries[slot.index].id].index = slot.index;
+    }
+    entries.pop_back();
+    if (entries.empty()) {
+      cells_.erase(cell);
+    }
+  }
+
+  // Calls f(entries) for every occupied cell at Chebyshev distance `ring`
+  // from cell (cx, cy, cz).
+  template <typename F>
+  void forEachCellInShell(int cx, int cy, int cz, int ring, F &&f) const {
+    for (int dz = -ring; dz <= ring; ++dz) {
+      for (int dy = -ring; dy <= ring; ++dy) {
+        const bool face = std::abs(dz) == ring || std::abs(dy) == ring;
+        // Inside the shell's z/y faces every x is on it, else only the ends.
+        const int step = face || ring == 0 ? 1 : 2 * ring;
+        for (int dx = -ring; dx <= ring; dx += step) {
+          auto cell = cells_.find(packKey(cx + dx, cy + dy, cz + dz));
+          if (cell != cells_.end()) {
+            f(cell->second);
+          }
+        }
+      }
+    }
+  }
+
+  int cellSize_;
+  std::unordered_map<uint64_t, std::vector<Entry>> cells_;
+  std::unordered_map<int, Slot> slots_;
+};
+
+#endif // ENTITY_SPATIAL_INDEX_HPP
@@ -9,6 +9,7 @@ VoxelGrid::VoxelGrid(entt::registry &reg) : registry(reg) {
   // Initialize TerrainStorage
   terrainStorage = std::make_unique<TerrainStorage>();
   terrainStorage->initialize();
+  terrainStorage->changeLog = &supportChanges;
 
   // Create TerrainGridRepository with the provided registry and storage
   terrainGridRepository =
@@ -57,8 +58,11 @@ void VoxelGrid::setVoxel(int x, int y, int z, const GridData &data) {
   {
     std::unique_lock<std::shared_mutex> lock(entityGridMutex);
     if (entityGrid) {
-      entityGrid->getAccessor().setValue(openvdb::Coord(x, y, z),
-                                         data.entityID);
+      auto accessor = entityGrid->getAccessor();
+      const openvdb::Coord coord(x, y, z);
+      reindexEntity(x, y, z, accessor.getValue(coord), data.entityID);
+      accessor.setValue(coord, data.entityID);
+      supportChanges.record(x, y, z);
     }
   }
 
@@ -232,7 +236,9 @@ void VoxelGrid::setEntity(int x, int y, int z, int entityID) {
 
   openvdb::Coord coord(x, y, z);
   auto accessor = entityGrid->getAccessor();
+  reindexEntity(x, y, z, accessor.getValue(coord), entityID);
   accessor.setValue(coord, entityID);
+  supportChanges.record(x, y, z);
 }
 
 int VoxelGrid::getEntity(int x, int y, int z) const {
@@ -279,9 +285,34 @@ void VoxelGrid::deleteEntity(int x, int y, int z) {
 
   openvdb::Coord coord(x, y, z);
   auto accessor = entityGrid->getAccessor();
+  reindexEntity(x, y, z, accessor.getValue(coord), defaultEmptyValue);
   accessor.setValueOff(coord,
                        defaultEmptyValue); // Properly deactivate node for
                                            // OpenVDB tree cleanliness
+  supportChanges.record(x, y, z);
+}
+
+std::size_t VoxelGrid::deleteEntities(std::span<const VoxelCoord> cells,
+                                      std::span<const int> entityIds) {
+  std::unique_lock<std::shared_mutex> lock(entityGridMutex);
+  if (!entityGrid)
+    return 0;
+
+  auto accessor = entityGrid->getAccessor();
+  std::size_t cleared = 0;
+  for (std::size_t i = 0; i < cells.size(); ++i) {
+    const VoxelCoord &c = cells[i];
+    openvdb::Coord coord(c.x, c.y, c.z);
+    if (!accessor.isValueOn(coord) ||
+        accessor.getValue(coord) != entityIds[i]) {
+      continue;
+    }
+    accessor.setValueOff(coord, defaultEmptyValue);
+    entityIndex.erase(entityIds[i], c.x, c.y, c.z);
+    supportChanges.record(c.x, c.y, c.z);
+    ++cleared;
+  }
+  return cleared;
 }
 
 void VoxelGrid::setEvent(int x, int y, int z, int eventID) {
@@ -352,6 +383,12 @@ void VoxelGrid::deserializeFromBytes(const std::vector<char> &byteData) {
   // Clear existing grids before populating them
   if (terrainStorage && terrainStorage->mainTypeGrid) {
     terrainStorage->mainTypeGrid->clear();
+    // clear() dropped the reserved region nodes; put them back.
+    if (terrainGridRepository) {
+      terrainGridRepository->reserveRegions(terrainStorage->reservedWidth,
+                                            terrainStorage->reservedHeight,
+                                            terrainStorage->reservedDepth);
+    }
   }
 
   // PROTECTED: Clear entity grid with mutex protection
@@ -360,10 +397,12 @@ void VoxelGrid::deserializeFromBytes(const std::vector<char> &byteData) {
     if (entityGrid) {
       entityGrid->clear(); // Line 234 - NOW PROTECTED
     }
+    entityIndex.clear();
   }
 
   eventGrid->clear();
   lightingGrid->clear();
+  supportChanges.recordAll();
 
   // Populate the grids using the data from the map
   {
@@ -381,6 +420,8 @@ void VoxelGrid::deserializeFromBytes(const std::vector<char> &byteData) {
       if (entityGrid && data.entityID != defaultEmptyValue) {
         entityGrid->tree().setValue(coord,
                                     data.entityID); // Line 248 - NOW PROTECTED
+        entityIndex.insert(data.entityID, coordinates.x, coordinates.y,
+                           coordinates.z);
       }
 
       // Set other grid data (outside the entity mutex - these can be moved
@@ -653,45 +694,28 @@ VoxelGrid::getAllEntityIdsInRegion(int x_min, int y_min, int z_min, int x_max,
   // Read operations use shared lock (multiple readers allowed)
   std::shared_lock<std::shared_mutex> lock(entityGridMutex);
 
+  // The spatial index only visits the cells of the region that hold
+  // entities, instead of every voxel of it.
   std::vector<int> result;
+  entityIndex.forEachInBox(x_min, y_min, z_min, x_max, y_max, z_max,
+                           [&](const EntitySpatialIndex::Entry &e) {
+                             gridView.setEntityVoxel(e.x, e.y, e.z, e.id);
+                             result.push_back(e.id);
+                           });
+  return result;
+}
 
-  if (!entityGrid)
-    return result;
-
-  // Accessor for direct voxel access within the grid
-  openvdb::Int32Grid::ConstAccessor accessor = entityGrid->getConstAccessor();
-
-// Parallelize the outer loop (x) using OpenMP
-#pragma omp parallel
-  {
-    // Each thread maintains its own local result vector
-    std::vector<int> localResult;
-
-#pragma omp for collapse(2) // Parallelize both x and y loops
-    for (int x = x_min; x <= x_max; ++x) {
-      for (int y = y_min; y <= y_max; ++y) {
-        for (int z = z_min; z <= z_max; ++z) {
-          openvdb::Coord coord(x, y, z);
-
-          // Check if the voxel is active and get its value
-          if (accessor.isValueOn(coord)) {
-            // Retrieve and cast the entity ID from the voxel value
-            int entity_id = static_cast<int>(accessor.getValue(coord));
-
-            gridView.setEntityVoxel(x, y, z, entity_id);
-
-            localResult.emplace_back(entity_id);
-          }
-        }
-      }
-    }
-
-// Merge each thread's local result vector into the shared result vector
-#pragma omp critical
-    result.insert(result.end(), localResult.begin(), localResult.end());
-  }
+std::vector<int> VoxelGrid::getEntityIdsInRadius(int x, int y, int z,
+                                                 float radius) const {
+  std::shared_lock<std::shared_mutex> lock(entityGridMutex);
+  return entityIndex.inRadius(x, y, z, radius);
+}
 
-  return result;
+std::vector<int> VoxelGrid::getNearestEntityIds(int x, int y, int z,
+                                                std::size_t k,
+                                                float maxRadius) const {
+  std::shared_lock<std::shared_mutex> lock(entityGridMutex);
+  return entityIndex.nearest(x, y, z, k, maxRadius);
 }
 
 std::vector<int> VoxelGrid::getAllEventIdsInRegion(int x_min, int y_min,
@@ -758,10 +782,16 @@ void VoxelGrid::moveEntity(entt::entity entity, Position movingToPosition) {
                               movingToPosition.z);
 
       auto accessor = entityGrid->getAccessor();
+      // Whatever stood at the new cell is overwritten, as in setEntity.
+      reindexEntity(movingToPosition.x, movingToPosition.y,
+                    movingToPosition.z, accessor.getValue(newCoord), entityId);
       accessor.setValue(
           oldCoord,
           defaultEmptyValue); // Set to -1 (empty) instead of setValueOff()
       accessor.setValue(newCoord, entityId); // Set at new position
+      supportChanges.record(pos.x, pos.y, pos.z);
+      supportChanges.record(movingToPosition.x, movingToPosition.y,
+                            movingToPosition.z);
     } else {
       // This should not happen
       std::cout << "Error: entity id mismatch when creating MovingComponent."
@@ -776,3 +806,12 @@ void VoxelGrid::moveEntity(entt::entity entity, Position movingToPosition) {
               << entityId << std::endl;
   }
 }
+
+void VoxelGrid::reindexEntity(int x, int y, int z, int oldId, int newId) {
+  if (oldId >= 0) {
+    entityIndex.erase(oldId, x, y, z);
+  }
+  if (newId >= 0) {
+    entityIndex.insert(newId, x, y, z);
+  }
+}
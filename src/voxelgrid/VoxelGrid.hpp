@@ -14,6 +14,7 @@
 #include <msgpack.hpp>
 #include <mutex>
 #include <shared_mutex>
+#include <span>
 #include <sstream>
 #include <tuple>
 #include <vector>
@@ -21,6 +22,8 @@
 #include "VoxelGridView_generated.h"
 #include "terrain/TerrainGridRepository.hpp"
 #include "terrain/TerrainStorage.hpp"
+#include "terrain/VoxelChangeLog.hpp"
+#include "voxelgrid/EntitySpatialIndex.hpp"
 #include "voxelgrid/GridData.hpp"
 #include "voxelgrid/VoxelGridView.hpp"
 
@@ -40,6 +43,10 @@ public:
   openvdb::Int32Grid::Ptr eventGrid;    // Grid for event ID
   openvdb::FloatGrid::Ptr lightingGrid; // Grid for lighting level
 
+  // Terrain id/type changes (via terrainStorage) and entity-grid writes,
+  // drained by the physics gravity pass to wake settled entities.
+  VoxelChangeLog supportChanges;
+
   VoxelGrid(entt::registry &registry); // Constructor that takes registry
   ~VoxelGrid();                        // Destructor
 
@@ -71,6 +78,11 @@ public:
       int x, int y,
       int z) const; // Fast unsafe read for performance-critical paths
   void deleteEntity(int x, int y, int z);
+  // Batch deleteEntity: clears cells[i] if it still holds entityIds[i],
+  // under one entityGridMutex hold and one accessor. Returns how many
+  // cells were cleared; the rest hold another entity (or none) by now.
+  std::size_t deleteEntities(std::span<const VoxelCoord> cells,
+                             std::span<const int> entityIds);
   void moveEntity(entt::entity entity, Position movingToPosition);
 
   void setEvent(int x, int y, int z, int eventID);
@@ -122,6 +134,14 @@ public:
                                            int x_max, int y_max, int z_max,
                                            VoxelGridView &gridView) const;
 
+  // Non-terrain entities within Euclidean `radius` of (x, y, z), in no
+  // particular order, and the `k` nearest ones within `maxRadius`, nearest
+  // first. Both are answered from the entity spatial index.
+  std::vector<int> getEntityIdsInRadius(int x, int y, int z,
+                                        float radius) const;
+  std::vector<int> getNearestEntityIds(int x, int y, int z, std::size_t k,
+                                       float maxRadius) const;
+
   std::vector<int> getAllEventIdsInRegion(int x_min, int y_min, int z_min,
                                           int x_max, int y_max,
                                           int z_max) const;
@@ -135,6 +155,14 @@ private:
 
   // Mutex specifically for entityGrid thread safety
   mutable std::shared_mutex entityGridMutex;
+
+  // Cell lists over the ids >= 0 in entityGrid, kept in step with every
+  // write to it and guarded by entityGridMutex.
+  EntitySpatialIndex entityIndex;
+
+  // Moves the index from `oldId` to `newId` at (x, y, z), ahead of the
+  // matching entityGrid write. Caller holds entityGridMutex exclusively.
+  void reindexEntity(int x, int y, int z, int oldId, int newId);
 };
 
 #endif // VOXELGRID_HPP
\ No newline at end of file
@@ -6,9 +6,42 @@
 #include <openvdb/openvdb.h>
 
 #include "VoxelGridView_generated.h"
+#include "VoxelLayerCodec.hpp"
 
 namespace nb = nanobind;
 
+// Spans over a FlatBuffers VoxelLayer for the codec in VoxelLayerCodec.hpp.
+inline VoxelLayerSpans voxelLayerSpans(const GameEngine::VoxelLayer *layer) {
+  VoxelLayerSpans s;
+  s.encoding = static_cast<VoxelLayerEncoding>(layer->encoding());
+  s.background = layer->background();
+  if (auto *v = layer->palette()) {
+    s.palette = v->data();
+  }
+  if (auto *v = layer->run_values()) {
+    s.runValues = v->data();
+  }
+  if (auto *v = layer->run_lengths()) {
+    s.runLengths = v->data();
+    s.runCount = v->size();
+  }
+  if (auto *v = layer->slice_runs()) {
+    s.sliceRuns = v->data();
+    s.depth = v->size();
+  }
+  if (auto *v = layer->mask()) {
+    s.mask = v->data();
+  }
+  if (auto *v = layer->values()) {
+    s.values = v->data();
+  }
+  if (auto *v = layer->slice_values()) {
+    s.sliceValues = v->data();
+    s.depth = v->size();
+  }
+  return s;
+}
+
 class VoxelGridViewFlatB {
 public:
   // Constructor accepts the raw FlatBuffer data pointer
@@ -52,12 +85,9 @@ public:
 
     if (local_x >= 0 && local_x < getWidth() && local_y >= 0 &&
         local_y < getHeight() && local_z >= 0 && local_z < getDepth()) {
-      // Calculate the index in the FlatBuffer data array
-      int index =
-          local_x + local_y * getWidth() + local_z * getWidth() * getHeight();
-
-      // Access the GridData at the calculated index
-      return fbVoxelGridView->terrainData()->Get(index);
+      return readVoxel(fbVoxelGridView->terrainData(),
+                       fbVoxelGridView->terrainLayer(), terrainSlices, local_x,
+                       local_y, local_z);
     } else {
       // Handle out-of-bounds access
       // std::cerr << "Attempted to get voxel out of bounds at (" << x << ", "
@@ -76,12 +106,9 @@ public:
 
     if (local_x >= 0 && local_x < getWidth() && local_y >= 0 &&
         local_y < getHeight() && local_z >= 0 && local_z < getDepth()) {
-      // Calculate the index in the FlatBuffer data array
-      int index =
-          local_x + local_y * getWidth() + local_z * getWidth() * getHeight();
-
-      // Access the GridData at the calculated index
-      return fbVoxelGridView->entityData()->Get(index);
+      return readVoxel(fbVoxelGridView->entityData(),
+                       fbVoxelGridView->entityLayer(), entitySlices, local_x,
+                       local_y, local_z);
     } else {
       // Handle out-of-bounds access
       // std::cerr << "Attempted to get voxel out of bounds at (" << x << ", "
@@ -93,9 +120,28 @@ public:
   }
 
 private:
+  // Dense layers are indexed directly; compressed ones go through a few
+  // decoded z slices.
+  int readVoxel(const flatbuffers::Vector<int32_t> *dense,
+                const GameEngine::VoxelLayer *layer, VoxelSliceCache &slices,
+                int local_x, int local_y, int local_z) const {
+    const int width = getWidth();
+    const int sliceSize = width * getHeight();
+    if (!layer) {
+      return dense->Get(local_x + local_y * width + local_z * sliceSize);
+    }
+    const int *slice = slices.find(local_z);
+    if (!slice) {
+      slice = slices.load(voxelLayerSpans(layer), sliceSize, local_z);
+    }
+    return slice[local_x + local_y * width];
+  }
+
   const GameEngine::VoxelGridView *fbVoxelGridView;
   std::vector<char> serialized_buffer; // Owns the serialized data when
                                        // constructed from nb::bytes
+  mutable VoxelSliceCache terrainSlices;
+  mutable VoxelSliceCache entitySlices;
 };
 
 class VoxelGridView {
@@ -120,16 +166,33 @@ public:
   // FlatBuffers serialization (returns FlatBuffers offset)
   flatbuffers::Offset<GameEngine::VoxelGridView>
   serializeFlatBuffers(flatbuffers::FlatBufferBuilder &builder) const {
-    // Serialize terrainData vector
-    auto terrainDataOffset = builder.CreateVector(terrainData);
+    // Each layer goes out dense or compressed, whichever is smaller.
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> terrainDataOffset = 0;
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> entityDataOffset = 0;
+    flatbuffers::Offset<GameEngine::VoxelLayer> terrainLayerOffset = 0;
+    flatbuffers::Offset<GameEngine::VoxelLayer> entityLayerOffset = 0;
+
+    EncodedVoxelLayer terrainLayer =
+        encodeVoxelLayer(terrainData, width, height, depth);
+    if (terrainLayer.encoding == VoxelLayerEncoding::DENSE) {
+      terrainDataOffset = builder.CreateVector(terrainData);
+    } else {
+      terrainLayerOffset = serializeLayer(builder, terrainLayer);
+    }
 
-    // Serialize entityData vector
-    auto entityDataOffset = builder.CreateVector(entityData);
+    EncodedVoxelLayer entityLayer =
+        encodeVoxelLayer(entityData, width, height, depth);
+    if (entityLayer.encoding == VoxelLayerEncoding::DENSE) {
+      entityDataOffset = builder.CreateVector(entityData);
+    } else {
+      entityLayerOffset = serializeLayer(builder, entityLayer);
+    }
 
     // Create the VoxelGridView FlatBuffer object
-    return GameEngine::CreateVoxelGridView(builder, width, height, depth,
-                                           x_offset, y_offset, z_offset,
-                                           terrainDataOffset, entityDataOffset);
+    return GameEngine::CreateVoxelGridView(
+        builder, width, height, depth, x_offset, y_offset, z_offset,
+        terrainDataOffset, entityDataOffset, terrainLayerOffset,
+        entityLayerOffset);
   }
 
   // FlatBuffers deserialization
@@ -149,10 +212,17 @@ public:
     vgv.y_offset = fbVoxelGridView->y_offset();
     vgv.z_offset = fbVoxelGridView->z_offset();
 
+    const std::size_t sliceSize =
+        static_cast<std::size_t>(vgv.width) * vgv.height;
+    const std::size_t depth = static_cast<std::size_t>(vgv.depth);
+
     // Deserialize terrainData
     auto fbTerrainData = fbVoxelGridView->terrainData();
     if (fbTerrainData) {
       vgv.terrainData.assign(fbTerrainData->begin(), fbTerrainData->end());
+    } else if (auto *layer = fbVoxelGridView->terrainLayer()) {
+      decodeVoxelLayer(voxelLayerSpans(layer), sliceSize, depth,
+                       vgv.terrainData);
     } else {
       // Handle the case where terrainData is missing
       throw std::runtime_error(
@@ -163,6 +233,9 @@ public:
     auto fbEntityData = fbVoxelGridView->entityData();
     if (fbEntityData) {
       vgv.entityData.assign(fbEntityData->begin(), fbEntityData->end());
+    } else if (auto *layer = fbVoxelGridView->entityLayer()) {
+      decodeVoxelLayer(voxelLayerSpans(layer), sliceSize, depth,
+                       vgv.entityData);
     } else {
       // Handle the case where entityData is missing
       throw std::runtime_error(
@@ -171,6 +244,27 @@ public:
 
     return vgv;
   }
+
+private:
+  static flatbuffers::Offset<GameEngine::VoxelLayer>
+  serializeLayer(flatbuffers::FlatBufferBuilder &builder,
+                 const EncodedVoxelLayer &layer) {
+    auto vector = [&builder](const auto &v) {
+      using Offset = decltype(builder.CreateVector(v));
+      return v.empty() ? Offset() : builder.CreateVector(v);
+    };
+    auto palette = vector(layer.palette);
+    auto runValues = vector(layer.runValues);
+    auto runLengths = vector(layer.runLengths);
+    auto sliceRuns = vector(layer.sliceRuns);
+    auto mask = vector(layer.mask);
+    auto values = vector(layer.values);
+    auto sliceValues = vector(layer.sliceValues);
+    return GameEngine::CreateVoxelLayer(
+        builder, static_cast<GameEngine::VoxelEncoding>(layer.encoding),
+        palette, runValues, runLengths, sliceRuns, layer.background, mask,
+        values, sliceValues);
+  }
 };
 
 #endif // READONLY_QUERIES_HPP
\ No newline at end of file
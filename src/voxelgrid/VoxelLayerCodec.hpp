@@ -0,0 +1,259 @@
+#ifndef VOXEL_LAYER_CODEC_HPP
+#define VOXEL_LAYER_CODEC_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+// Compact wire encodings for one int layer (terrain or entity ids) of a
+// VoxelGridView. The encoder picks whichever is smallest for the data:
+//   - DENSE:       the plain x-fastest [int] array;
+//   - PALETTE_RLE: each distinct value once, then (palette index, length)
+//                  runs in x-fastest order. Runs end at every z slice and
+//                  slice_runs holds the first run of each slice, so one
+//                  slice can be decoded without the others;
+//   - SPARSE:      one bit per voxel (LSB first) set where the value
+//                  differs from the most common one, followed by those
+//                  values in order; slice_values holds the first value of
+//                  each slice.
+// Perception views are mostly long stretches of empty (0) and occluded
+// (-3) voxels, so terrain usually ends up PALETTE_RLE and the entity layer
+// SPARSE. The numbering matches VoxelEncoding in VoxelGridView.fbs.
+//
+// Decoding works on plain pointers (VoxelLayerSpans) so it reads straight
+// from the FlatBuffers vectors without copying them.
+
+enum class VoxelLayerEncoding : uint8_t { DENSE, PALETTE_RLE, SPARSE };
+
+struct VoxelLayerSpans {
+  VoxelLayerEncoding encoding = VoxelLayerEncoding::DENSE;
+  const int *dense = nullptr;
+  const int *palette = nullptr;
+  const uint16_t *runValues = nullptr;
+  const uint16_t *runLengths = nullptr;
+  const uint32_t *sliceRuns = nullptr;
+  std::size_t runCount = 0;
+  int background = 0;
+  const uint8_t *mask = nullptr;
+  const int *values = nullptr;
+  const uint32_t *sliceValues = nullptr;
+  std::size_t depth = 0;
+};
+
+struct EncodedVoxelLayer {
+  VoxelLayerEncoding encoding = VoxelLayerEncoding::DENSE;
+  std::vector<int> palette;
+  std::vector<uint16_t> runValues;
+  std::vector<uint16_t> runLengths;
+  std::vector<uint32_t> sliceRuns;
+  int background = 0;
+  std::vector<uint8_t> mask;
+  std::vector<int> values;
+  std::vector<uint32_t> sliceValues;
+  // Approximate size on the wire, vector headers and padding included.
+  std::size_t bytes = 0;
+
+  // Spans over this layer; `dense` is only read for DENSE.
+  VoxelLayerSpans spans(const int *dense = nullptr) const {
+    VoxelLayerSpans s;
+    s.encoding = encoding;
+    s.dense = dense;
+    s.palette = palette.data();
+    s.runValues = runValues.data();
+    s.runLengths = runLengths.data();
+    s.sliceRuns = sliceRuns.data();
+    s.runCount = runLengths.size();
+    s.background = background;
+    s.mask = mask.data();
+    s.values = values.data();
+    s.sliceValues = sliceValues.data();
+    s.depth = encoding == VoxelLayerEncoding::SPARSE ? sliceValues.size()
+                                                     : sliceRuns.size();
+    return s;
+  }
+};
+
+namespace voxel_layer_detail {
+
+// A FlatBuffers vector: 4-byte length, elements padded to 4 bytes.
+inline std::size_t vectorBytes(std::size_t count, std::size_t elementSize) {
+  return 4 + (count * elementSize + 3) / 4 * 4;
+}
+
+// Sub-table vtable, offsets, the encoding byte and the background int.
+constexpr std::size_t kLayerTableBytes = 40;
+
+constexpr std::size_t kMaxRun = 0xFFFF;
+constexpr std::size_t kMaxPalette = 0x10000;
+
+} // namespace voxel_layer_detail
+
+// Picks the smallest encoding for `data` (width * height * depth values,
+// x-fastest). Returns DENSE with empty vectors when neither compressed
+// form is smaller, in which case the caller writes the plain array.
+inline EncodedVoxelLayer encodeVoxelLayer(const std::vector<int> &data,
+                                          int width, int height, int depth) {
+  using namespace voxel_layer_detail;
+  EncodedVoxelLayer out;
+  const std::size_t slice =
+      static_cast<std::size_t>(std::max(width, 0)) * std::max(height, 0);
+  const std::size_t d = static_cast<std::size_t>(std::max(depth, 0));
+  const std::size_t n = slice * d;
+  out.bytes = vectorBytes(data.size(), sizeof(int));
+  if (n == 0 || data.size() != n) {
+    return out;
+  }
+
+  // Runs and palette in one pass; the palette keeps a count per value so
+  // the most common one can serve as the SPARSE background.
+  std::unordered_map<int, uint32_t> index;
+  std::vector<std::size_t> counts;
+  bool paletteFits = true;
+  for (std::size_t z = 0; z < d; ++z) {
+    out.sliceRuns.push_back(static_cast<uint32_t>(out.runLengths.size()));
+    const int *src = data.data() + z * slice;
+    for (std::size_t i = 0; i < slice;) {
+      const int value = src[i];
+      std::size_t len = 1;
+      while (i + len < slice && len < kMaxRun && src[i + len] == value) {
+        ++len;
+      }
+      auto [it, added] =
+          index.try_emplace(value, static_cast<uint32_t>(out.palette.size()));
+      if (added) {
+        out.palette.push_back(value);
+        counts.push_back(0);
+      }
+      counts[it->second] += len;
+      if (it->second >= kMaxPalette) {
+        paletteFits = false;
+      }
+      out.runValues.push_back(static_cast<uint16_t>(it->second));
+      out.runLengths.push_back(static_cast<uint16_t>(len));
+      i += len;
+    }
+  }
+
+  const std::size_t common = static_cast<std::size_t>(
+      std::max_element(counts.begin(), counts.end()) - counts.begin());
+  const std::size_t sparseCount = n - counts[common];
+
+  const std::size_t denseBytes = out.bytes;
+  const std::size_t rleBytes =
+      paletteFits ? kLayerTableBytes + vectorBytes(out.palette.size(), 4) +
+                        2 * vectorBytes(out.runLengths.size(), 2) +
+                        vectorBytes(d, 4)
+                  : denseBytes;
+  const std::size_t sparseBytes =
+      kLayerTableBytes + vectorBytes((n + 7) / 8, 1) +
+      vectorBytes(sparseCount, 4) + vectorBytes(d, 4);
+
+  if (sparseBytes < rleBytes && sparseBytes < denseBytes) {
+    out.encoding = VoxelLayerEncoding::SPARSE;
+    out.bytes = sparseBytes;
+    out.background = out.palette[common];
+    out.mask.assign((n + 7) / 8, 0);
+    out.values.reserve(sparseCount);
+    out.sliceValues.reserve(d);
+    for (std::size_t i = 0; i < n; ++i) {
+      if (i % slice == 0) {
+        out.sliceValues.push_back(static_cast<uint32_t>(out.values.size()));
+      }
+      if (data[i] != out.background) {
+        out.mask[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+        out.values.push_back(data[i]);
+      }
+    }
+  } else if (rleBytes < denseBytes) {
+    out.encoding = VoxelLayerEncoding::PALETTE_RLE;
+    out.bytes = rleBytes;
+    return out;
+  }
+
+  out.palette.clear();
+  out.runValues.clear();
+  out.runLengths.clear();
+  out.sliceRuns.clear();
+  return out;
+}
+
+// Writes slice `z` (sliceSize values) of `layer` to `out`.
+inline void decodeVoxelSlice(const VoxelLayerSpans &layer,
+                             std::size_t sliceSize, std::size_t z, int *out) {
+  switch (layer.encoding) {
+  case VoxelLayerEncoding::DENSE:
+    std::memcpy(out, layer.dense + z * sliceSize, sliceSize * sizeof(int));
+    return;
+  case VoxelLayerEncoding::PALETTE_RLE: {
+    const std::size_t end =
+        z + 1 < layer.depth ? layer.sliceRuns[z + 1] : layer.runCount;
+    for (std::size_t r = layer.sliceRuns[z]; r < end; ++r) {
+      out = std::fill_n(out, layer.runLengths[r],
+                        layer.palette[layer.runValues[r]]);
+    }
+    return;
+  }
+  case VoxelLayerEncoding::SPARSE: {
+    const int *value = layer.values + layer.sliceValues[z];
+    const std::size_t base = z * sliceSize;
+    for (std::size_t i = 0; i < sliceSize; ++i) {
+      const std::size_t bit = base + i;
+      out[i] = (layer.mask[bit >> 3] >> (bit & 7)) & 1 ? *value++
+                                                       : layer.background;
+    }
+    return;
+  }
+  }
+}
+
+inline void decodeVoxelLayer(const VoxelLayerSpans &layer,
+                             std::size_t sliceSize, std::size_t depth,
+                             std::vector<int> &out) {
+  out.resize(sliceSize * depth);
+  for (std::size_t z = 0; z < depth; ++z) {
+    decodeVoxelSlice(layer, sliceSize, z, out.data() + z * sliceSize);
+  }
+}
+
+// The last few decoded z slices of one layer, for random access into a
+// compressed layer. Perception readers walk a view slice by slice, so a
+// handful of slots covers them; slots are reused round-robin.
+class VoxelSliceCache {
+public:
+  const int *find(int z) const {
+    for (const Slot &slot : slots_) {
+      if (slot.z == z) {
+        return slot.values.data();
+      }
+    }
+    return nullptr;
+  }
+
+  const int *load(const VoxelLayerSpans &layer, std::size_t sliceSize,
+                  int z) {
+    Slot &slot = slots_[next_];
+    next_ = (next_ + 1) % kSlots;
+    slot.values.resize(sliceSize);
+    decodeVoxelSlice(layer, sliceSize, static_cast<std::size_t>(z),
+                     slot.values.data());
+    slot.z = z;
+    return slot.values.data();
+  }
+
+private:
+  static constexpr std::size_t kSlots = 4;
+
+  struct Slot {
+    int z = -1;
+    std::vector<int> values;
+  };
+
+  std::array<Slot, kSlots> slots_{};
+  std::size_t next_ = 0;
+};
+
+#endif // VOXEL_LAYER_CODEC_HPP
@@ -0,0 +1,109 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "diag/Diag.hpp"
+
+/**
+ * Contention microbenchmark for aetherion::diag::Counter
+ *
+ * Hammers one Counter from 1..32 threads and reports the per-call cost of
+ * inc(), next to the same loop on a single shared std::atomic (what
+ * Counter::Impl used to be). The sharded counter should stay roughly flat
+ * as threads are added; the shared atomic degrades with every core that
+ * joins the cache-line ping-pong.
+ *
+ * Numbers past the machine's hardware thread count measure time-slicing,
+ * not contention.
+ *
+ * The run fails if the summed shards do not equal the number of
+ * increments; test_diag_counter covers that under ctest.
+ *
+ * Usage: bench_diag_counter [increments_per_thread]
+ */
+
+using namespace aetherion::diag;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+template <typename Fn>
+double nsPerCall(int threads, std::uint64_t iters, Fn &&body) {
+  std::atomic<int> ready{0};
+  std::atomic<bool> go{false};
+  std::vector<std::thread> pool;
+  pool.reserve(threads);
+  for (int t = 0; t < threads; ++t) {
+    pool.emplace_back([&] {
+      ready.fetch_add(1);
+      while (!go.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      for (std::uint64_t i = 0; i < iters; ++i) {
+        body();
+      }
+    });
+  }
+  while (ready.load() < threads) {
+    std::this_thread::yield();
+  }
+  auto start = Clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto &th : pool) {
+    th.join();
+  }
+  auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start);
+  // Wall time per call as seen by one thread; flat == no contention.
+  return elapsed.count() / static_cast<double>(iters);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const std::uint64_t iters =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000ULL;
+
+  auto &registry = Registry::instance();
+  registry.reset_for_testing();
+
+  std::cout << "=== diag::Counter contention (" << iters
+            << " inc/thread, " << std::thread::hardware_concurrency()
+            << " hardware threads) ===" << std::endl;
+  std::cout << std::setw(8) << "threads" << std::setw(16) << "sharded ns/op"
+            << std::setw(16) << "atomic ns/op" << std::endl;
+
+  bool ok = true;
+  for (int threads : {1, 2, 4, 8, 16, 32}) {
+    CounterConfig cfg;
+    cfg.name = "bench.counter_" + std::to_string(threads);
+    auto counter = registry.counter(cfg);
+    double sharded = nsPerCall(threads, iters, [&] { counter.inc(); });
+
+    std::atomic<std::uint64_t> shared{0};
+    double baseline = nsPerCall(threads, iters, [&] {
+      shared.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    std::cout << std::setw(8) << threads << std::setw(16) << std::fixed
+              << std::setprecision(2) << sharded << std::setw(16) << baseline
+              << std::endl;
+
+    const std::uint64_t expected = iters * static_cast<std::uint64_t>(threads);
+    const std::uint64_t got = registry.peek_counter(cfg.name);
+    if (got != expected) {
+      std::cerr << "Counter total mismatch at " << threads
+                << " threads: expected " << expected << ", got " << got
+                << std::endl;
+      ok = false;
+    }
+  }
+
+  registry.reset_for_testing();
+  return ok ? 0 : 1;
+}
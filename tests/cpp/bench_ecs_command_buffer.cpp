@@ -0,0 +1,221 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "EcsCommandBuffer.hpp"
+
+/**
+ * ECS command buffer benchmark
+ *
+ * Worker threads each walk their own slice of a populated registry and make
+ * structural edits: drop a component, add one, destroy the entity, or spawn
+ * a new entity with two components. This runs two ways:
+ *   - locked:   every edit takes one registry mutex and applies directly
+ *               (the only safe way to edit the registry from workers);
+ *   - buffered: every edit is recorded into the thread's EcsCommandBuffer
+ *               through EcsCommandQueue and played back afterwards on the
+ *               calling thread.
+ * Wall time for the worker phase and the playback is reported. Edits are
+ * decided per entity, not per thread, so both runs should leave the same
+ * registry behind; a mismatch is reported. Playback ordering is covered by
+ * test_ecs_command_buffer.
+ *
+ * Usage: bench_ecs_command_buffer [entities] [threads]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Speed {
+  float value;
+};
+
+struct Tag {
+  int value;
+};
+
+struct Summary {
+  std::size_t alive = 0;
+  std::size_t speeds = 0;
+  std::size_t tags = 0;
+  int64_t tagSum = 0;
+
+  bool operator==(const Summary &) const = default;
+};
+
+struct RunResult {
+  double workMs = 0.0;
+  double playbackMs = 0.0;
+  Summary summary;
+};
+
+// What happens to entity number `i`: 0 drop Speed, 1 add Tag, 2 destroy,
+// 3 spawn a sibling, anything else nothing.
+int editFor(std::size_t i) {
+  uint64_t h = static_cast<uint64_t>(i) * 0x9e3779b97f4a7c15ULL;
+  h ^= h >> 31;
+  return static_cast<int>(h % 6);
+}
+
+std::vector<entt::entity> populate(entt::registry &registry,
+                                   std::size_t count) {
+  std::vector<entt::entity> entities(count);
+  registry.create(entities.begin(), entities.end());
+  for (std::size_t i = 0; i < count; ++i) {
+    registry.emplace<Speed>(entities[i], static_cast<float>(i % 7));
+  }
+  return entities;
+}
+
+Summary summarize(entt::registry &registry) {
+  Summary s;
+  s.alive = registry.storage<entt::entity>().free_list();
+  s.speeds = registry.storage<Speed>().size();
+  s.tags = registry.storage<Tag>().size();
+  for (auto [entity, tag] : registry.view<const Tag>().each()) {
+    s.tagSum += tag.value;
+  }
+  return s;
+}
+
+template <typename WorkerFn>
+double runWorkers(std::size_t count, int threads, WorkerFn &&worker) {
+  auto start = Clock::now();
+  std::vector<std::thread> pool;
+  const std::size_t slice = (count + threads - 1) / threads;
+  for (int t = 0; t < threads; ++t) {
+    const std::size_t begin = std::min(count, slice * t);
+    const std::size_t end = std::min(count, begin + slice);
+    pool.emplace_back([&worker, begin, end]() { worker(begin, end); });
+  }
+  for (std::thread &thread : pool) {
+    thread.join();
+  }
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+RunResult runLocked(std::size_t count, int threads) {
+  entt::registry registry;
+  const std::vector<entt::entity> entities = populate(registry, count);
+  std::mutex mutex;
+
+  RunResult r;
+  r.workMs = runWorkers(count, threads, [&](std::size_t begin,
+                                            std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      const entt::entity e = entities[i];
+      std::lock_guard<std::mutex> lock(mutex);
+      switch (editFor(i)) {
+      case 0:
+        registry.remove<Speed>(e);
+        break;
+      case 1:
+        registry.emplace<Tag>(e, static_cast<int>(i % 100));
+        break;
+      case 2:
+        registry.destroy(e);
+        break;
+      case 3: {
+        const entt::entity spawned = registry.create();
+        registry.emplace<Speed>(spawned, 1.0f);
+        registry.emplace<Tag>(spawned, 1);
+        break;
+      }
+      default:
+        break;
+      }
+    }
+  });
+  r.summary = summarize(registry);
+  return r;
+}
+
+RunResult runBuffered(std::size_t count, int threads) {
+  entt::registry registry;
+  const std::vector<entt::entity> entities = populate(registry, count);
+  EcsCommandQueue commands;
+
+  RunResult r;
+  r.workMs = runWorkers(count, threads, [&](std::size_t begin,
+                                            std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      const entt::entity e = entities[i];
+      switch (editFor(i)) {
+      case 0:
+        commands.remove<Speed>(e);
+        break;
+      case 1:
+        commands.emplace<Tag>(e, static_cast<int>(i % 100));
+        break;
+      case 2:
+        commands.destroy(e);
+        break;
+      case 3: {
+        EcsCommandBuffer &buffer = commands.local();
+        const PendingEntity spawned = buffer.create();
+        buffer.emplace<Speed>(spawned, 1.0f);
+        buffer.emplace<Tag>(spawned, 1);
+        commands.noteRecorded(3);
+        break;
+      }
+      default:
+        break;
+      }
+    }
+  });
+
+  auto start = Clock::now();
+  commands.playback(registry);
+  r.playbackMs =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  if (commands.pending() != 0) {
+    std::cerr << "Playback left " << commands.pending() << " commands pending"
+              << std::endl;
+  }
+  r.summary = summarize(registry);
+  return r;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const std::size_t count =
+      argc > 1 ? static_cast<std::size_t>(std::atoll(argv[1])) : 1'000'000;
+  const int threads = argc > 2 ? std::atoi(argv[2]) : 8;
+
+  RunResult locked = runLocked(count, threads);
+  RunResult buffered = runBuffered(count, threads);
+
+  bool ok = locked.summary == buffered.summary;
+  if (!ok) {
+    std::cerr << "Buffered run diverged from the locked run: alive "
+              << locked.summary.alive << " vs " << buffered.summary.alive
+              << ", tags " << locked.summary.tags << " vs "
+              << buffered.summary.tags << std::endl;
+  }
+
+  std::cout << "=== ECS command buffer (" << count << " entities, " << threads
+            << " threads) ===" << std::endl;
+  std::cout << std::setw(12) << "run" << std::setw(14) << "workers ms"
+            << std::setw(14) << "playback ms" << std::setw(12) << "total ms"
+            << std::endl;
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << std::setw(12) << "locked" << std::setw(14) << locked.workMs
+            << std::setw(14) << 0.0 << std::setw(12) << locked.workMs
+            << std::endl;
+  std::cout << std::setw(12) << "buffered" << std::setw(14)
+            << buffered.workMs << std::setw(14) << buffered.playbackMs
+            << std::setw(12) << buffered.workMs + buffered.playbackMs
+            << std::endl;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "voxelgrid/EntitySpatialIndex.hpp"
+
+/**
+ * Entity spatial index benchmark
+ *
+ * Scatters 1k, 10k and 100k entities over a 512 x 512 x 16 map and answers
+ * the same radius queries three ways:
+ *   - dense: visit every voxel of the query box in a dense id grid, as
+ *            VoxelGrid::getAllEntityIdsInRegion used to walk the entity
+ *            grid;
+ *   - scan:  test every entity's position;
+ *   - index: EntitySpatialIndex::inRadius.
+ * It also times k-nearest queries against a partial sort of every entity.
+ *
+ * The run fails if, after random moves and removals, a radius or nearest
+ * query on the index disagrees with the scan.
+ *
+ * Usage: bench_entity_spatial_index [queries] [radius] [k]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kWidth = 512, kHeight = 512, kDepth = 16;
+
+struct Placed {
+  int id;
+  int x, y, z;
+};
+
+struct Query {
+  int x, y, z;
+};
+
+int64_t distance2(const Placed &p, const Query &q) {
+  const int64_t dx = p.x - q.x, dy = p.y - q.y, dz = p.z - q.z;
+  return dx * dx + dy * dy + dz * dz;
+}
+
+std::vector<int> scanRadius(const std::vector<Placed> &placed,
+                            const Query &q, float radius) {
+  const int64_t limit = static_cast<int64_t>(radius * radius);
+  std::vector<int> ids;
+  for (const Placed &p : placed) {
+    if (distance2(p, q) <= limit) {
+      ids.push_back(p.id);
+    }
+  }
+  return ids;
+}
+
+std::vector<int> scanNearest(const std::vector<Placed> &placed,
+                             const Query &q, std::size_t k,
+                             float maxRadius) {
+  const double limit = static_cast<double>(maxRadius) * maxRadius;
+  std::vector<std::pair<int64_t, int>> candidates;
+  for (const Placed &p : placed) {
+    const int64_t d2 = distance2(p, q);
+    if (d2 <= limit) {
+      candidates.emplace_back(d2, p.id);
+    }
+  }
+  const std::size_t n = std::min(k, candidates.size());
+  std::partial_sort(candidates.begin(), candidates.begin() + n,
+                    candidates.end());
+  std::vector<int> ids;
+  for (std::size_t i = 0; i < n; ++i) {
+    ids.push_back(candidates[i].second);
+  }
+  return ids;
+}
+
+std::vector<int> denseRadius(const std::vector<int> &grid, const Query &q,
+                             float radius) {
+  const int r = static_cast<int>(radius);
+  const int64_t limit = static_cast<int64_t>(radius * radius);
+  std::vector<int> ids;
+  for (int x = std::max(0, q.x - r); x <= std::min(kWidth - 1, q.x + r);
+       ++x) {
+    for (int y = std::max(0, q.y - r); y <= std::min(kHeight - 1, q.y + r);
+         ++y) {
+      for (int z = std::max(0, q.z - r); z <= std::min(kDepth - 1, q.z + r);
+           ++z) {
+        const int id = grid[(static_cast<std::size_t>(z) * kHeight + y) *
+                                kWidth +
+                            x];
+        const int64_t dx = x - q.x, dy = y - q.y, dz = z - q.z;
+        if (id >= 0 && dx * dx + dy * dy + dz * dz <= limit) {
+          ids.push_back(id);
+        }
+      }
+    }
+  }
+  return ids;
+}
+
+// One entity per voxel, as in the entity grid.
+std::vector<Placed> scatter(int count, std::mt19937 &gen) {
+  std::uniform_int_distribution<int> x(0, kWidth - 1), y(0, kHeight - 1),
+      z(0, kDepth - 1);
+  std::vector<char> taken(static_cast<std::size_t>(kWidth) * kHeight * kDepth);
+  std::vector<Placed> placed;
+  while (static_cast<int>(placed.size()) < count) {
+    const Placed p{static_cast<int>(placed.size()), x(gen), y(gen), z(gen)};
+    char &cell =
+        taken[(static_cast<std::size_t>(p.z) * kHeight + p.y) * kWidth + p.x];
+    if (!cell) {
+      cell = 1;
+      placed.push_back(p);
+    }
+  }
+  return placed;
+}
+
+std::vector<Query> makeQueries(int count, std::mt19937 &gen) {
+  std::uniform_int_distribution<int> x(0, kWidth - 1), y(0, kHeight - 1),
+      z(0, kDepth - 1);
+  std::vector<Query> queries;
+  for (int i = 0; i < count; ++i) {
+    queries.push_back(Query{x(gen), y(gen), z(gen)});
+  }
+  return queries;
+}
+
+std::vector<int> sorted(std::vector<int> ids) {
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+// Random moves and removals on the index and on a plain list, then every
+// query must agree with the scan.
+bool checkAgainstScan(int entities, const std::vector<Query> &queries,
+                      float radius, std::size_t k) {
+  std::mt19937 gen(3);
+  std::vector<Placed> placed = scatter(entities, gen);
+  EntitySpatialIndex index;
+  for (const Placed &p : placed) {
+    index.insert(p.id, p.x, p.y, p.z);
+  }
+
+  std::uniform_int_distribution<int> step(-3, 3);
+  std::uniform_int_distribution<int> action(0, 9);
+  for (std::size_t i = 0; i < placed.size();) {
+    Placed &p = placed[i];
+    if (action(gen) == 0) {
+      // Erasing at a stale position must not remove it.
+      if (index.erase(p.id, p.x + 1, p.y, p.z) ||
+          !index.erase(p.id, p.x, p.y, p.z)) {
+        std::cerr << "erase of entity " << p.id << " misbehaved"
+                  << std::endl;
+        return false;
+      }
+      placed[i] = placed.back();
+      placed.pop_back();
+      continue;
+    }
+    p.x = std::clamp(p.x + step(gen) * 4, 0, kWidth - 1);
+    p.y = std::clamp(p.y + step(gen) * 4, 0, kHeight - 1);
+    p.z = std::clamp(p.z + step(gen), 0, kDepth - 1);
+    index.insert(p.id, p.x, p.y, p.z);
+    ++i;
+  }
+  if (index.size() != placed.size()) {
+    std::cerr << "index holds " << index.size() << " entities, expected "
+              << placed.size() << std::endl;
+    return false;
+  }
+
+  for (const Query &q : queries) {
+    if (sorted(index.inRadius(q.x, q.y, q.z, radius)) !=
+        sorted(scanRadius(placed, q, radius))) {
+      std::cerr << "radius query at (" << q.x << ", " << q.y << ", " << q.z
+                << ") disagrees with the scan" << std::endl;
+      return false;
+    }
+    for (float maxRadius : {radius, 1000.f}) {
+      if (index.nearest(q.x, q.y, q.z, k, maxRadius) !=
+          scanNearest(placed, q, k, maxRadius)) {
+        std::cerr << "nearest query at (" << q.x << ", " << q.y << ", "
+                  << q.z << ") disagrees with the scan" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename F> double usPerQuery(int queries, F &&run) {
+  const auto start = Clock::now();
+  run();
+  return std::chrono::duration<double, std::micro>(Clock::now() - start)
+             .count() /
+         std::max(queries, 1);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int queryCount = argc > 1 ? std::atoi(argv[1]) : 2000;
+  const float radius = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 16;
+  const std::size_t k = argc > 3 ? std::atoi(argv[3]) : 8;
+
+  std::mt19937 gen(7);
+  const std::vector<Query> queries = makeQueries(queryCount, gen);
+
+  bool ok = true;
+  for (int entities : {1'000, 10'000}) {
+    ok = checkAgainstScan(entities, queries, radius, k) && ok;
+  }
+
+  std::cout << "=== entity spatial index (" << kWidth << " x " << kHeight
+            << " x " << kDepth << ", radius " << radius << ", k " << k
+            << ", " << queryCount << " queries) ===" << std::endl;
+  std::cout << std::setw(10) << "entities" << std::setw(10) << "hits"
+            << std::setw(12) << "dense us" << std::setw(12) << "scan us"
+            << std::setw(12) << "index us" << std::setw(14) << "kNN scan us"
+            << std::setw(14) << "kNN index us" << std::endl;
+  std::cout << std::fixed << std::setprecision(2);
+  for (int entities : {1'000, 10'000, 100'000}) {
+    std::vector<Placed> placed = scatter(entities, gen);
+    std::vector<int> grid(static_cast<std::size_t>(kWidth) * kHeight * kDepth,
+                          -1);
+    EntitySpatialIndex index;
+    for (const Placed &p : placed) {
+      grid[(static_cast<std::size_t>(p.z) * kHeight + p.y) * kWidth + p.x] =
+          p.id;
+      index.insert(p.id, p.x, p.y, p.z);
+    }
+
+    std::size_t hits = 0, sink = 0;
+    const double dense = usPerQuery(queryCount, [&] {
+      for (const Query &q : queries) {
+        sink += denseRadius(grid, q, radius).size();
+      }
+    });
+    const double scan = usPerQuery(queryCount, [&] {
+      for (const Query &q : queries) {
+        sink += scanRadius(placed, q, radius).size();
+      }
+    });
+    const double indexed = usPerQuery(queryCount, [&] {
+      for (const Query &q : queries) {
+        hits += index.inRadius(q.x, q.y, q.z, radius).size();
+      }
+    });
+    const double knnScan = usPerQuery(queryCount, [&] {
+      for (const Query &q : queries) {
+        sink += scanNearest(placed, q, k, 1000.f).size();
+      }
+    });
+    const double knnIndex = usPerQuery(queryCount, [&] {
+      for (const Query &q : queries) {
+        sink += index.nearest(q.x, q.y, q.z, k, 1000.f).size();
+      }
+    });
+    if (sink != 2 * hits + 2 * k * queries.size()) {
+      std::cerr << "timed queries disagree" << std::endl;
+      ok = false;
+    }
+
+    std::cout << std::setw(10) << entities << std::setw(10)
+              << static_cast<double>(hits) / std::max(queryCount, 1)
+              << std::setw(12) << dense << std::setw(12) << scan
+              << std::setw(12) << indexed << std::setw(14) << knnScan
+              << std::setw(14) << knnIndex << std::endl;
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <tuple>
+#include <unordered_map>
+
+#include "ComponentStorage.hpp"
+#include "components/ConsoleLogsComponent.hpp"
+#include "components/DnaComponents.hpp"
+#include "components/EntityTypeComponent.hpp"
+#include "components/HealthComponents.hpp"
+#include "components/ItemsComponents.hpp"
+#include "components/MetabolismComponents.hpp"
+#include "components/MovingComponent.hpp"
+#include "components/PerceptionComponent.hpp"
+#include "components/PhysicsComponents.hpp"
+#include "components/TerrainComponents.hpp"
+
+/**
+ * Entity component storage benchmark
+ *
+ * Builds the terrain entities of one perception view the way
+ * createPerceptionResponseC does (buildTerrainEntityInterface into an
+ * unordered_map keyed by virtual id, then a copy into the response), with
+ * the components held two ways:
+ *   - tuple:  every component type, as EntityInterface used to hold them;
+ *   - sparse: SparseComponentStorage, which only makes room for the
+ *             components that are set.
+ * Most voxels get entity type, position and matter container; every
+ * `effectEvery`-th one also gets a TileEffectsList, which sends it to the
+ * heap part of the sparse storage.
+ *
+ * Reports the per-entity size, heap bytes and allocations (counted by
+ * replacing operator new) and the build and copy times. The run fails if
+ * a sparse entity reads back differently from its tuple twin.
+ *
+ * Usage: bench_entity_storage [voxels] [effectEvery] [rounds]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+std::atomic<std::size_t> gAllocBytes{0};
+std::atomic<std::size_t> gAllocCount{0};
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  gAllocBytes.fetch_add(size, std::memory_order_relaxed);
+  gAllocCount.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+// GCC pairs the free() below with the new-expressions it inlines into and
+// warns; the replacement operator new above is what allocated it.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+#pragma GCC diagnostic pop
+
+namespace {
+
+// Same list as ComponentTypes in EntityInterface.hpp.
+using Components =
+    std::tuple<EntityTypeComponent, PhysicsStats, Position, Velocity,
+               MovingComponent, HealthComponent, PerceptionComponent, Inventory,
+               ConsoleLogsComponent, MatterContainer, ItemEnum, FoodItem,
+               ParentsComponent, ItemTypeComponent, TileEffectComponent,
+               TileEffectsList, MetabolismComponent>;
+
+constexpr std::size_t kComponentCount = std::tuple_size_v<Components>;
+
+struct TupleEntity {
+  int entityId = -1;
+  std::bitset<kComponentCount> componentMask;
+  Components components;
+
+  template <typename C> const C &get() const {
+    return std::get<C>(components);
+  }
+  template <typename C> void set(const C &c) { std::get<C>(components) = c; }
+};
+
+struct SparseEntity {
+  int entityId = -1;
+  std::bitset<kComponentCount> componentMask;
+  SparseComponentStorage<64, Components> components;
+
+  template <typename C> const C &get() const { return components.get<C>(); }
+  template <typename C> void set(const C &c) { components.set(c); }
+};
+
+template <typename Entity> Entity buildTerrain(int id, int effectEvery) {
+  Entity e;
+  e.entityId = -id;
+  e.set(EntityTypeComponent{0, id % 7, 0});
+  e.set(Position{id % 97, id / 97, 3, DirectionEnum::UP});
+  e.set(MatterContainer{id % 11, 0, id % 5, 0});
+  if (effectEvery > 0 && id % effectEvery == 0) {
+    TileEffectsList effects;
+    effects.addEffect(id);
+    e.set(effects);
+  }
+  return e;
+}
+
+struct Result {
+  double buildMs = 0.0;
+  double copyMs = 0.0;
+  std::size_t heapBytes = 0;
+  std::size_t allocs = 0;
+};
+
+template <typename Entity>
+Result run(int voxels, int effectEvery, int rounds,
+           std::unordered_map<int, Entity> &out) {
+  Result r;
+  for (int round = 0; round < rounds; ++round) {
+    std::unordered_map<int, Entity> terrainEntities;
+    const std::size_t bytesBefore = gAllocBytes.load();
+    const std::size_t countBefore = gAllocCount.load();
+    auto start = Clock::now();
+    for (int id = 1; id <= voxels; ++id) {
+      terrainEntities[-id] = buildTerrain<Entity>(id, effectEvery);
+    }
+    r.buildMs +=
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+    r.heapBytes = gAllocBytes.load() - bytesBefore;
+    r.allocs = gAllocCount.load() - countBefore;
+
+    start = Clock::now();
+    out = terrainEntities;
+    r.copyMs +=
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+  }
+  r.buildMs /= rounds;
+  r.copyMs /= rounds;
+  return r;
+}
+
+bool sameComponents(const TupleEntity &a, const SparseEntity &b) {
+  const auto &ta = a.get<EntityTypeComponent>();
+  const auto &tb = b.get<EntityTypeComponent>();
+  const auto &pa = a.get<Position>();
+  const auto &pb = b.get<Position>();
+  const auto &ma = a.get<MatterContainer>();
+  const auto &mb = b.get<MatterContainer>();
+  return a.entityId == b.entityId && ta.mainType == tb.mainType &&
+         ta.subType0 == tb.subType0 && pa.x == pb.x && pa.y == pb.y &&
+         pa.z == pb.z && pa.direction == pb.direction &&
+         ma.TerrainMatter == mb.TerrainMatter &&
+         ma.WaterMatter == mb.WaterMatter &&
+         a.get<TileEffectsList>().tileEffectsIDs ==
+             b.get<TileEffectsList>().tileEffectsIDs &&
+         b.get<Velocity>().vx == 0.0f && b.get<Inventory>().itemIDs.empty();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int voxels = argc > 1 ? std::atoi(argv[1]) : 35000;
+  const int effectEvery = argc > 2 ? std::atoi(argv[2]) : 50;
+  const int rounds = argc > 3 ? std::max(1, std::atoi(argv[3])) : 10;
+  bool ok = true;
+
+  std::unordered_map<int, TupleEntity> tupleMap;
+  std::unordered_map<int, SparseEntity> sparseMap;
+  const Result tuple = run(voxels, effectEvery, rounds, tupleMap);
+  const Result sparse = run(voxels, effectEvery, rounds, sparseMap);
+
+  for (const auto &[id, entity] : tupleMap) {
+    auto it = sparseMap.find(id);
+    if (it == sparseMap.end() || !sameComponents(entity, it->second)) {
+      std::cerr << "Sparse entity " << id << " differs" << std::endl;
+      ok = false;
+      break;
+    }
+  }
+
+  std::cout << "=== entity storage (" << voxels << " terrain voxels, effects "
+            << "every " << effectEvery << ", " << rounds
+            << " rounds) ===" << std::endl;
+  std::cout << std::setw(8) << "storage" << std::setw(12) << "sizeof"
+            << std::setw(14) << "heap KiB" << std::setw(10) << "allocs"
+            << std::setw(12) << "build ms" << std::setw(12) << "copy ms"
+            << std::endl;
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << std::setw(8) << "tuple" << std::setw(12) << sizeof(TupleEntity)
+            << std::setw(14) << tuple.heapBytes / 1024.0 << std::setw(10)
+            << tuple.allocs << std::setw(12) << tuple.buildMs << std::setw(12)
+            << tuple.copyMs << std::endl;
+  std::cout << std::setw(8) << "sparse" << std::setw(12)
+            << sizeof(SparseEntity) << std::setw(14)
+            << sparse.heapBytes / 1024.0 << std::setw(10) << sparse.allocs
+            << std::setw(12) << sparse.buildMs << std::setw(12)
+            << sparse.copyMs << std::endl;
+
+  return ok ? 0 : 1;
+}
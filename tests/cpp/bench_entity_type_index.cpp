@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "EntityTypeIndex.hpp"
+#include "components/EntityTypeComponent.hpp"
+
+/**
+ * Entity type index benchmark
+ *
+ * Fills a registry with typed entities (mostly terrain, a few plant and
+ * beast kinds) and answers "every entity of type (main, sub0)" two ways:
+ *   - scan:  walk registry.view<EntityTypeComponent>() and compare, what
+ *            World::getEntitiesByType did before the index;
+ *   - index: EntityTypeIndex::entities(), kept current by the registry
+ *            signals.
+ * Between rounds some entities are destroyed, created or retyped (through
+ * replace and patch), so the index is also measured while it churns. The
+ * run stops with an error if the index and the scan ever disagree.
+ *
+ * Usage: bench_entity_type_index [entities] [rounds]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kMainTypes = 3;
+constexpr int kSubTypes = 8;
+
+EntityTypeComponent randomType(std::mt19937 &gen) {
+  // Terrain dominates, as in a generated world.
+  const int mainType = gen() % 10 < 8 ? 0 : 1 + static_cast<int>(gen() % 2);
+  return EntityTypeComponent{mainType, static_cast<int>(gen() % kSubTypes),
+                             0};
+}
+
+std::vector<entt::entity> scan(entt::registry &registry, int mainType,
+                               int subType0) {
+  std::vector<entt::entity> out;
+  for (auto [entity, type] : registry.view<EntityTypeComponent>().each()) {
+    if (type.mainType == mainType && type.subType0 == subType0) {
+      out.push_back(entity);
+    }
+  }
+  return out;
+}
+
+std::vector<entt::entity> lookup(const EntityTypeIndex &index, int mainType,
+                                 int subType0) {
+  const entt::sparse_set &set = index.entities(mainType, subType0);
+  return {set.begin(), set.end()};
+}
+
+void churn(entt::registry &registry, std::vector<entt::entity> &live,
+           std::mt19937 &gen, std::size_t edits) {
+  for (std::size_t i = 0; i < edits && !live.empty(); ++i) {
+    const std::size_t slot = gen() % live.size();
+    switch (gen() % 4) {
+    case 0:
+      registry.destroy(live[slot]);
+      live[slot] = live.back();
+      live.pop_back();
+      break;
+    case 1: {
+      const entt::entity e = registry.create();
+      registry.emplace<EntityTypeComponent>(e, randomType(gen));
+      live.push_back(e);
+      break;
+    }
+    case 2:
+      registry.replace<EntityTypeComponent>(live[slot], randomType(gen));
+      break;
+    default:
+      registry.patch<EntityTypeComponent>(
+          live[slot], [&](EntityTypeComponent &type) {
+            type.subType0 = static_cast<int>(gen() % kSubTypes);
+          });
+      break;
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int entities = argc > 1 ? std::atoi(argv[1]) : 1'000'000;
+  const int rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+
+  entt::registry registry;
+  std::mt19937 gen(7);
+  std::vector<entt::entity> live;
+  live.reserve(entities);
+  for (int i = 0; i < entities; ++i) {
+    const entt::entity e = registry.create();
+    registry.emplace<EntityTypeComponent>(e, randomType(gen));
+    live.push_back(e);
+  }
+
+  EntityTypeIndex index;
+  index.connect(registry);
+
+  bool ok = true;
+  std::chrono::nanoseconds scanTime{0}, indexTime{0};
+  int queries = 0;
+  for (int r = 0; r < rounds && ok; ++r) {
+    churn(registry, live, gen, live.size() / 100 + 1);
+    for (int mainType = 0; mainType < kMainTypes; ++mainType) {
+      for (int subType0 = 0; subType0 < kSubTypes; ++subType0) {
+        auto start = Clock::now();
+        std::vector<entt::entity> expected =
+            scan(registry, mainType, subType0);
+        scanTime += Clock::now() - start;
+
+        start = Clock::now();
+        std::vector<entt::entity> actual = lookup(index, mainType, subType0);
+        indexTime += Clock::now() - start;
+        ++queries;
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        if (expected != actual) {
+          std::cerr << "Type index diverged from the scan for (" << mainType
+                    << ", " << subType0 << ") in round " << r << ": "
+                    << actual.size() << " vs " << expected.size()
+                    << " entities" << std::endl;
+          ok = false;
+        }
+      }
+    }
+  }
+  ok = ok && index.size() == live.size();
+  index.disconnect(registry);
+
+  std::cout << "=== entity type query (" << live.size() << " entities, "
+            << queries << " queries) ===" << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+  const double scanUs =
+      std::chrono::duration<double, std::micro>(scanTime).count() / queries;
+  const double indexUs =
+      std::chrono::duration<double, std::micro>(indexTime).count() / queries;
+  std::cout << std::setw(10) << "scan" << std::setw(12) << scanUs
+            << " us/query" << std::endl;
+  std::cout << std::setw(10) << "index" << std::setw(12) << indexUs
+            << " us/query" << std::endl;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "components/TerrainComponents.hpp"
+#include "physics/GravitySleep.hpp"
+#include "terrain/TerrainStorage.hpp"
+#include "terrain/VoxelChangeLog.hpp"
+
+/**
+ * Gravity sleep benchmark
+ *
+ * Places one entity on top of every column of a solid floor, then each tick
+ * rewrites a few random floor voxels (dig a hole, flood it, fill it back in)
+ * and asks which entities could now fall -- the checkIfCanFall test: no
+ * terrain below, or water below. This runs two ways:
+ *   - check all: test every entity every tick (what the gravity pass did);
+ *   - sleep:     drain the TerrainStorage change log, wake the entities
+ *                around the written voxels, and test only awake entities,
+ *                putting the ones still supported back to sleep.
+ * ns per tick and the average awake population are reported; the run
+ * fails if the two passes find different fallers on any tick.
+ *
+ * Usage: bench_gravity_sleep [ticks] [side] [writes_per_tick]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Resting {
+  entt::entity entity;
+  VoxelCoord at;
+};
+
+void buildFloor(TerrainStorage &storage, int side) {
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      storage.setTerrainId(
+          x, y, 0, static_cast<int>(TerrainIdTypeEnum::ON_GRID_STORAGE));
+      storage.setTerrainSubType0(x, y, 0, static_cast<int>(TerrainEnum::GRASS));
+    }
+  }
+}
+
+bool canFall(const TerrainStorage &storage, const VoxelCoord &at) {
+  if (!storage.checkIfTerrainExists(at.x, at.y, at.z - 1)) {
+    return true;
+  }
+  return storage.getTerrainSubType0(at.x, at.y, at.z - 1) ==
+         static_cast<int>(TerrainEnum::WATER);
+}
+
+// One random floor edit: dig, flood or refill.
+void editFloor(TerrainStorage &storage, std::mt19937 &gen, int side) {
+  const int x = static_cast<int>(gen() % side);
+  const int y = static_cast<int>(gen() % side);
+  switch (gen() % 3) {
+  case 0:
+    storage.deleteTerrain(x, y, 0);
+    break;
+  case 1:
+    storage.setTerrainId(x, y, 0,
+                         static_cast<int>(TerrainIdTypeEnum::ON_GRID_STORAGE));
+    storage.setTerrainSubType0(x, y, 0, static_cast<int>(TerrainEnum::WATER));
+    break;
+  default:
+    storage.setTerrainId(x, y, 0,
+                         static_cast<int>(TerrainIdTypeEnum::ON_GRID_STORAGE));
+    storage.setTerrainSubType0(x, y, 0, static_cast<int>(TerrainEnum::GRASS));
+    break;
+  }
+}
+
+struct RunResult {
+  double nsPerTick = 0.0;
+  double awakePerTick = 0.0;
+  std::vector<uint64_t> fallersPerTick;
+};
+
+RunResult run(int ticks, int side, int writesPerTick, bool useSleep) {
+  TerrainStorage storage;
+  storage.initialize();
+  VoxelChangeLog log;
+  storage.changeLog = &log;
+  buildFloor(storage, side);
+
+  entt::registry registry;
+  std::vector<Resting> resting;
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      resting.push_back({registry.create(), VoxelCoord{x, y, 1}});
+    }
+  }
+
+  GravitySleep sleep;
+  std::vector<VoxelCoord> changes;
+  std::mt19937 gen(5);
+  RunResult r;
+  uint64_t awakeTotal = 0;
+  std::chrono::nanoseconds elapsed{0};
+
+  for (int t = 0; t < ticks; ++t) {
+    for (int w = 0; w < writesPerTick; ++w) {
+      editFloor(storage, gen, side);
+    }
+
+    auto start = Clock::now();
+    uint64_t fallers = 0;
+    if (useSleep) {
+      changes.clear();
+      if (log.drain(changes)) {
+        sleep.wakeAll();
+      } else {
+        for (const VoxelCoord &c : changes) {
+          sleep.wakeAround(c);
+        }
+      }
+      for (const Resting &e : resting) {
+        if (sleep.asleep(e.entity)) {
+          continue;
+        }
+        ++awakeTotal;
+        if (canFall(storage, e.at)) {
+          ++fallers;
+        } else {
+          sleep.sleep(e.entity, e.at);
+        }
+      }
+    } else {
+      changes.clear();
+      log.drain(changes); // keep the log from growing; not used
+      for (const Resting &e : resting) {
+        ++awakeTotal;
+        fallers += canFall(storage, e.at) ? 1 : 0;
+      }
+    }
+    elapsed += Clock::now() - start;
+    r.fallersPerTick.push_back(fallers);
+  }
+
+  r.nsPerTick = std::chrono::duration<double, std::nano>(elapsed).count() /
+                static_cast<double>(ticks);
+  r.awakePerTick =
+      static_cast<double>(awakeTotal) / static_cast<double>(ticks);
+  return r;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int ticks = argc > 1 ? std::atoi(argv[1]) : 500;
+  const int side = argc > 2 ? std::atoi(argv[2]) : 256;
+  const int writesPerTick = argc > 3 ? std::atoi(argv[3]) : 64;
+
+  RunResult all = run(ticks, side, writesPerTick, false);
+  RunResult slept = run(ticks, side, writesPerTick, true);
+
+  bool ok = all.fallersPerTick == slept.fallersPerTick;
+  if (!ok) {
+    std::cerr << "Sleeping pass missed entities that could fall" << std::endl;
+  }
+
+  std::cout << "=== gravity sleep (" << side * side << " resting entities, "
+            << writesPerTick << " floor writes/tick, " << ticks
+            << " ticks) ===" << std::endl;
+  std::cout << std::setw(12) << "pass" << std::setw(14) << "ns/tick"
+            << std::setw(14) << "awake/tick" << std::endl;
+  std::cout << std::fixed << std::setprecision(0);
+  std::cout << std::setw(12) << "check all" << std::setw(14) << all.nsPerTick
+            << std::setw(14) << all.awakePerTick << std::endl;
+  std::cout << std::setw(12) << "sleep" << std::setw(14) << slept.nsPerTick
+            << std::setw(14) << slept.awakePerTick << std::endl;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "MetabolismPass.hpp"
+
+/**
+ * Metabolism pass benchmark
+ *
+ * Populates two identical registries with creatures (energy, health,
+ * food being digested) and runs the metabolism rules on them two ways:
+ *   - serial:   the loop MetabolismSystem::processMetabolism ran before,
+ *               a view walk with an any_of/get per HealthComponent access
+ *               and clone_entity (nine any_of/emplace pairs) per birth,
+ *               right inside the loop;
+ *   - parallel: runMetabolismPass over the metabolism group, then one
+ *               cloneEntities for every birth of the tick.
+ * The first tick has births; the timed ticks after it do not, so the two
+ * registries keep the same entities and the pass itself is measured.
+ *
+ * The run fails if the two ever report different starved entities or
+ * parents, or end a tick with different energy or health.
+ *
+ * Usage: bench_metabolism_pass [creatures] [ticks]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct TickResult {
+  std::vector<entt::entity> starved;
+  std::vector<entt::entity> parents;
+  std::size_t offspring = 0;
+};
+
+void populate(entt::registry &registry, int creatures) {
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<float> energy(-20.f, 160.f);
+  std::uniform_real_distribution<float> unit(0.f, 1.f);
+  for (int i = 0; i < creatures; ++i) {
+    const entt::entity e = registry.create();
+    const bool beast = gen() % 10 != 0;
+    registry.emplace<EntityTypeComponent>(e, beast ? 2 : 1,
+                                          static_cast<int>(gen() % 3), 0);
+    registry.emplace<Position>(e, static_cast<int>(gen() % 64),
+                               static_cast<int>(gen() % 64), 1,
+                               DirectionEnum::UP);
+    registry.emplace<MetabolismComponent>(e, energy(gen), 200.f);
+    if (gen() % 4 != 0) {
+      registry.emplace<HealthComponent>(e, 1.f + 40.f * unit(gen), 100.f);
+    }
+    DigestionComponent digestion{};
+    digestion.sizeOfStomach = 10;
+    for (int item = static_cast<int>(gen() % 4); item > 0; --item) {
+      digestion.digestingItems.push_back(DigestingFoodItem{
+          static_cast<int>(gen() % 1000), static_cast<int>(gen() % 10),
+          5.f, 2.f + 8.f * unit(gen), 0.5f + 3.f * unit(gen), 1.f,
+          0.2f * unit(gen), 0.5f + 0.5f * unit(gen)});
+    }
+    registry.emplace<DigestionComponent>(e, std::move(digestion));
+  }
+}
+
+entt::entity cloneOne(entt::registry &registry, entt::entity source) {
+  entt::entity e = registry.create();
+  if (registry.any_of<EntityTypeComponent>(source)) {
+    registry.emplace<EntityTypeComponent>(
+        e, registry.get<EntityTypeComponent>(source));
+  }
+  if (registry.any_of<PhysicsStats>(source)) {
+    registry.emplace<PhysicsStats>(e, registry.get<PhysicsStats>(source));
+  }
+  if (registry.any_of<Position>(source)) {
+    registry.emplace<Position>(e, registry.get<Position>(source));
+  }
+  if (registry.any_of<Velocity>(source)) {
+    registry.emplace<Velocity>(e, registry.get<Velocity>(source));
+  }
+  if (registry.any_of<HealthComponent>(source)) {
+    registry.emplace<HealthComponent>(e,
+                                      registry.get<HealthComponent>(source));
+  }
+  if (registry.any_of<PerceptionComponent>(source)) {
+    registry.emplace<PerceptionComponent>(
+        e, registry.get<PerceptionComponent>(source));
+  }
+  if (registry.any_of<DigestionComponent>(source)) {
+    registry.emplace<DigestionComponent>(
+        e, registry.get<DigestionComponent>(source));
+  }
+  if (registry.any_of<MetabolismComponent>(source)) {
+    registry.emplace<MetabolismComponent>(
+        e, registry.get<MetabolismComponent>(source));
+  }
+  if (registry.any_of<Inventory>(source)) {
+    registry.emplace<Inventory>(e, registry.get<Inventory>(source));
+  }
+  return e;
+}
+
+// The loop body of the old processMetabolism, minus the voxel grid and the
+// dispatcher.
+TickResult serialTick(entt::registry &registry, const MetabolismRules &rules,
+                      bool allowBirths) {
+  TickResult result;
+  auto view =
+      registry
+          .view<MetabolismComponent, DigestionComponent, EntityTypeComponent>();
+  for (auto entity : view) {
+    auto &metabolism = view.get<MetabolismComponent>(entity);
+    auto &digestion = view.get<DigestionComponent>(entity);
+    auto &etc = view.get<EntityTypeComponent>(entity);
+
+    if (metabolism.energyReserve < 0 &&
+        registry.any_of<HealthComponent>(entity)) {
+      auto &health = registry.get<HealthComponent>(entity);
+      health.healthLevel -= rules.starvationDamage;
+      if (health.healthLevel <= 0) {
+        result.starved.push_back(entity);
+      }
+      metabolism.energyReserve += rules.starvationRefund;
+    }
+
+    if (allowBirths && metabolism.energyReserve > rules.reproduceAbove &&
+        etc.mainType == 2 && etc.subType0 != rules.playerSubType) {
+      metabolism.energyReserve -= rules.reproduceCost;
+      const entt::entity cloned = cloneOne(registry, entity);
+      registry.get<MetabolismComponent>(cloned).energyReserve =
+          rules.offspringEnergy;
+      result.parents.push_back(entity);
+      ++result.offspring;
+    }
+
+    std::vector<int> itemsToRemove;
+    for (auto &item : digestion.digestingItems) {
+      item.processingTime += 1;
+      if (item.processingTime % rules.chunkDigestionTime != 0) {
+        continue;
+      }
+      double digestedMass = rules.chunkMass * item.convertionEfficiency;
+      double energyInChunk = digestedMass * item.energyDensity;
+      item.mass -= digestedMass;
+      metabolism.energyReserve += energyInChunk;
+      if (registry.any_of<HealthComponent>(entity)) {
+        auto &health = registry.get<HealthComponent>(entity);
+        double healthInChunk = energyInChunk * item.energyHealthRatio;
+        if (healthInChunk > 0 &&
+            health.healthLevel + healthInChunk < health.maxHealth) {
+          health.healthLevel += healthInChunk;
+        } else if (healthInChunk > 0) {
+          health.healthLevel = health.maxHealth;
+        }
+      }
+      if (item.mass <= 0) {
+        itemsToRemove.push_back(item.foodItemID);
+      }
+    }
+    for (int foodItemID : itemsToRemove) {
+      digestion.removeItem(foodItemID);
+    }
+  }
+  return result;
+}
+
+TickResult parallelTick(entt::registry &registry,
+                        const MetabolismRules &rules, bool allowBirths) {
+  MetabolismOutcome outcome = runMetabolismPass(registry, rules, allowBirths);
+  TickResult result{std::move(outcome.starved), std::move(outcome.parents),
+                    0};
+  const std::vector<entt::entity> offspring =
+      cloneEntities(registry, result.parents);
+  for (entt::entity child : offspring) {
+    registry.get<MetabolismComponent>(child).energyReserve =
+        rules.offspringEnergy;
+  }
+  result.offspring = offspring.size();
+  return result;
+}
+
+bool sameOutcome(TickResult a, TickResult b) {
+  std::sort(a.starved.begin(), a.starved.end());
+  std::sort(b.starved.begin(), b.starved.end());
+  std::sort(a.parents.begin(), a.parents.end());
+  std::sort(b.parents.begin(), b.parents.end());
+  return a.starved == b.starved && a.parents == b.parents &&
+         a.offspring == b.offspring;
+}
+
+// Energy and health of the creatures both registries created up front.
+// Offspring get different ids in the two runs, so they are only counted.
+bool sameState(entt::registry &a, entt::registry &b, int creatures) {
+  for (int i = 0; i < creatures; ++i) {
+    const auto e = static_cast<entt::entity>(i);
+    if (a.get<MetabolismComponent>(e).energyReserve !=
+        b.get<MetabolismComponent>(e).energyReserve) {
+      return false;
+    }
+    const auto *ha = a.try_get<HealthComponent>(e);
+    const auto *hb = b.try_get<HealthComponent>(e);
+    if ((ha == nullptr) != (hb == nullptr) ||
+        (ha && ha->healthLevel != hb->healthLevel)) {
+      return false;
+    }
+  }
+  return a.storage<MetabolismComponent>().size() ==
+         b.storage<MetabolismComponent>().size();
+}
+
+double msSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int creatures = argc > 1 ? std::atoi(argv[1]) : 100'000;
+  const int ticks = argc > 2 ? std::atoi(argv[2]) : 20;
+
+  const MetabolismRules rules;
+  entt::registry serial, parallel;
+  populate(serial, creatures);
+  populate(parallel, creatures);
+  // The group sorts its pools once, when it is first asked for; World pays
+  // that on its first tick, not on every one.
+  metabolismGroup(parallel);
+
+  auto start = Clock::now();
+  TickResult s = serialTick(serial, rules, true);
+  const double serialBirthMs = msSince(start);
+  start = Clock::now();
+  TickResult p = parallelTick(parallel, rules, true);
+  const double parallelBirthMs = msSince(start);
+  const std::size_t births = s.offspring;
+
+  bool ok = sameOutcome(s, p) && sameState(serial, parallel, creatures);
+  if (!ok) {
+    std::cerr << "Metabolism pass diverged from the serial loop on the birth "
+                 "tick"
+              << std::endl;
+  }
+
+  double serialMs = 0, parallelMs = 0;
+  for (int t = 0; t < ticks && ok; ++t) {
+    start = Clock::now();
+    s = serialTick(serial, rules, false);
+    serialMs += msSince(start);
+    start = Clock::now();
+    p = parallelTick(parallel, rules, false);
+    parallelMs += msSince(start);
+    if (!sameOutcome(s, p) || !sameState(serial, parallel, creatures)) {
+      std::cerr << "Metabolism pass diverged from the serial loop on tick "
+                << t << std::endl;
+      ok = false;
+    }
+  }
+
+  std::cout << "=== metabolism pass (" << creatures << " creatures, "
+            << births << " births, " << ticks << " ticks) ===" << std::endl;
+  std::cout << std::setw(12) << "" << std::setw(14) << "birth tick ms"
+            << std::setw(14) << "ms/tick" << std::endl;
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << std::setw(12) << "serial" << std::setw(14) << serialBirthMs
+            << std::setw(14) << serialMs / std::max(ticks, 1) << std::endl;
+  std::cout << std::setw(12) << "parallel" << std::setw(14)
+            << parallelBirthMs << std::setw(14)
+            << parallelMs / std::max(ticks, 1) << std::endl;
+
+  return ok ? 0 : 1;
+}
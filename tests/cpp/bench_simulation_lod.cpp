@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "MetabolismPass.hpp"
+#include "SimulationLod.hpp"
+
+/**
+ * Simulation LOD benchmark
+ *
+ * Scatters creatures over a 1024 x 1024 map with a handful of observers
+ * and runs the metabolism pass on them two ways:
+ *   - full: every creature every tick, as with LOD disabled;
+ *   - lod:  SimulationLod::beginTick each tick, and the pass skips the
+ *           creatures whose region is not due.
+ * It reports the per-level populations, the share of updates skipped and
+ * the time per tick of both.
+ *
+ * The run fails if LOD with every interval at 1 changes anything, or if
+ * a creature ends more than one interval behind.
+ *
+ * Usage: bench_simulation_lod [creatures] [ticks] [observers]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kMapSize = 1024;
+
+void populate(entt::registry &registry, int creatures) {
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> coord(0, kMapSize - 1);
+  std::uniform_real_distribution<float> energy(10.f, 90.f);
+  // Stomachs are allocated up front and handed out in random order: in a
+  // world that has run for a while, births and deaths have scattered them
+  // over the heap, so the full pass does not get to stream through them.
+  std::vector<DigestionComponent> stomachs(creatures);
+  for (DigestionComponent &digestion : stomachs) {
+    digestion.sizeOfStomach = 10;
+    // One item too big to finish, so its clock counts every tick covered.
+    digestion.digestingItems.push_back(
+        DigestingFoodItem{1, 0, 0.f, 0.01f, 1e6f, 1.f, 0.f, 1.f});
+  }
+  std::shuffle(stomachs.begin(), stomachs.end(), gen);
+  for (int i = 0; i < creatures; ++i) {
+    const entt::entity e = registry.create();
+    registry.emplace<EntityTypeComponent>(e, 2, 0, 0);
+    registry.emplace<Position>(e, coord(gen), coord(gen), 1,
+                               DirectionEnum::UP);
+    registry.emplace<MetabolismComponent>(e, energy(gen), 200.f);
+    registry.emplace<HealthComponent>(e, 100.f, 100.f);
+    registry.emplace<DigestionComponent>(e, std::move(stomachs[i]));
+  }
+  metabolismGroup(registry);
+}
+
+std::vector<VoxelCoord> makeObservers(int count) {
+  std::mt19937 gen(9);
+  std::uniform_int_distribution<int> coord(0, kMapSize - 1);
+  std::vector<VoxelCoord> observers;
+  for (int i = 0; i < count; ++i) {
+    observers.push_back(VoxelCoord{coord(gen), coord(gen), 1});
+  }
+  return observers;
+}
+
+int digestionClock(entt::registry &registry, entt::entity e) {
+  return registry.get<DigestionComponent>(e).digestingItems.front()
+      .processingTime;
+}
+
+double msSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+// Runs `ticks` LOD ticks and returns the stats of the last one.
+SimulationLodStats runLod(entt::registry &registry, SimulationLod &lod,
+                          const std::vector<VoxelCoord> &observers,
+                          const MetabolismRules &rules, int ticks) {
+  for (int t = 0; t < ticks; ++t) {
+    lod.beginTick(observers);
+    const auto map = lod.snapshot();
+    map->record(runMetabolismPass(registry, rules, false, map.get()).lod);
+  }
+  return lod.beginTick(observers);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int creatures = argc > 1 ? std::atoi(argv[1]) : 200'000;
+  const int ticks = argc > 2 ? std::atoi(argv[2]) : 64;
+  const int observerCount = argc > 3 ? std::atoi(argv[3]) : 4;
+
+  const MetabolismRules rules;
+  const std::vector<VoxelCoord> observers = makeObservers(observerCount);
+  bool ok = true;
+
+  // Every interval at 1: LOD must not change anything.
+  {
+    entt::registry full, lodded;
+    populate(full, creatures / 10);
+    populate(lodded, creatures / 10);
+    SimulationLod lod;
+    SimulationLodConfig everyTick;
+    everyTick.midInterval = 1;
+    everyTick.farInterval = 1;
+    lod.configure(kMapSize, kMapSize, everyTick);
+    for (int t = 0; t < 8; ++t) {
+      runMetabolismPass(full, rules, false);
+    }
+    runLod(lodded, lod, observers, rules, 8);
+    for (auto e : full.view<MetabolismComponent>()) {
+      if (full.get<MetabolismComponent>(e).energyReserve !=
+              lodded.get<MetabolismComponent>(e).energyReserve ||
+          digestionClock(full, e) != digestionClock(lodded, e)) {
+        std::cerr << "LOD with unit intervals diverged from the full pass"
+                  << std::endl;
+        ok = false;
+        break;
+      }
+    }
+  }
+
+  entt::registry full, lodded;
+  populate(full, creatures);
+  populate(lodded, creatures);
+
+  auto start = Clock::now();
+  for (int t = 0; t < ticks; ++t) {
+    runMetabolismPass(full, rules, false);
+  }
+  const double fullMs = msSince(start);
+
+  SimulationLod lod;
+  const SimulationLodConfig config;
+  lod.configure(kMapSize, kMapSize, config);
+  start = Clock::now();
+  const SimulationLodStats stats = runLod(lodded, lod, observers, rules, ticks);
+  const double lodMs = msSince(start);
+
+  // Accumulated dt: nobody may fall more than one interval behind.
+  const auto map = lod.snapshot();
+  for (auto e : lodded.view<MetabolismComponent>()) {
+    const Position &pos = lodded.get<Position>(e);
+    const int interval = map->interval(map->level(pos.x, pos.y));
+    const int clock = digestionClock(lodded, e);
+    if (clock > ticks || clock <= ticks - interval) {
+      std::cerr << "Creature at (" << pos.x << ", " << pos.y
+                << ") caught up " << clock << " of " << ticks << " ticks"
+                << std::endl;
+      ok = false;
+      break;
+    }
+  }
+
+  const char *names[kLodLevels] = {"near", "mid", "far"};
+  uint64_t updated = 0, skipped = 0;
+  std::cout << "=== simulation lod (" << creatures << " creatures, "
+            << observerCount << " observers, " << ticks
+            << " ticks) ===" << std::endl;
+  std::cout << std::setw(8) << "level" << std::setw(10) << "regions"
+            << std::setw(12) << "population" << std::setw(10) << "updated"
+            << std::endl;
+  for (std::size_t l = 0; l < kLodLevels; ++l) {
+    std::cout << std::setw(8) << names[l] << std::setw(10)
+              << stats.regions[l] << std::setw(12)
+              << stats.updated[l] + stats.skipped[l] << std::setw(10)
+              << stats.updated[l] << std::endl;
+    updated += stats.updated[l];
+    skipped += stats.skipped[l];
+  }
+  const double skippedShare =
+      100.0 * skipped / std::max<uint64_t>(1, updated + skipped);
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << "skipped " << skippedShare << "% of updates on the last tick"
+            << std::endl;
+  std::cout << std::setw(8) << "full" << std::setw(12)
+            << fullMs / std::max(ticks, 1) << " ms/tick" << std::endl;
+  std::cout << std::setw(8) << "lod" << std::setw(12)
+            << lodMs / std::max(ticks, 1) << " ms/tick" << std::endl;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "components/EntityTypeComponent.hpp"
+#include "components/PhysicsComponents.hpp"
+#include "components/TerrainComponents.hpp"
+#include "terrain/TerrainGridRepository.hpp"
+#include "terrain/TerrainStorage.hpp"
+
+/**
+ * Terrain bulk load benchmark
+ *
+ * Builds the same generated map (stone up to a height field, a water layer
+ * over the low ground, air above) two ways:
+ *   - setters: the repository setters createPlainTerrainFromPython calls
+ *              for every voxel (position, entity type, matter, structural
+ *              integrity, physics stats, terrain id);
+ *   - box:     one loadTerrainBox over x-fastest columns, as
+ *              World.load_terrain_box gets them from NumPy.
+ * The Python attribute lookups of create_entity are not part of the
+ * setters time, so the real gap is larger than reported. The run fails
+ * if the two maps differ anywhere.
+ *
+ * Usage: bench_terrain_bulk_load [width] [height] [depth]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Map {
+  int width, height, depth;
+  std::vector<int64_t> terrainId;
+  std::vector<int32_t> subType0;
+  std::vector<int32_t> terrainMatter;
+  std::vector<int32_t> waterMatter;
+  std::vector<int32_t> mass;
+
+  std::size_t index(int x, int y, int z) const {
+    return (static_cast<std::size_t>(z) * height + y) * width + x;
+  }
+};
+
+Map generate(int width, int height, int depth) {
+  Map map{width, height, depth, {}, {}, {}, {}, {}};
+  const std::size_t n = static_cast<std::size_t>(width) * height * depth;
+  map.terrainId.assign(n, static_cast<int64_t>(TerrainIdTypeEnum::NONE));
+  map.subType0.assign(n, 0);
+  map.terrainMatter.assign(n, 0);
+  map.waterMatter.assign(n, 0);
+  map.mass.assign(n, 0);
+  const int sea = depth / 3;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const int ground = 1 + (x * 7 + y * 13) % (depth / 2 + 1);
+      for (int z = 0; z < depth; ++z) {
+        const std::size_t i = map.index(x, y, z);
+        if (z < ground) {
+          map.terrainId[i] =
+              static_cast<int64_t>(TerrainIdTypeEnum::ON_GRID_STORAGE);
+          map.subType0[i] = 0;
+          map.terrainMatter[i] = 100;
+          map.mass[i] = 10;
+        } else if (z < sea) {
+          map.terrainId[i] =
+              static_cast<int64_t>(TerrainIdTypeEnum::ON_GRID_STORAGE);
+          map.subType0[i] = 1;
+          map.waterMatter[i] = 50;
+          map.mass[i] = 1;
+        }
+      }
+    }
+  }
+  return map;
+}
+
+double loadWithSetters(const Map &map, TerrainGridRepository &repo) {
+  const auto start = Clock::now();
+  for (int z = 0; z < map.depth; ++z) {
+    for (int y = 0; y < map.height; ++y) {
+      for (int x = 0; x < map.width; ++x) {
+        const std::size_t i = map.index(x, y, z);
+        if (map.terrainId[i] == static_cast<int64_t>(TerrainIdTypeEnum::NONE)) {
+          continue;
+        }
+        repo.setPosition(x, y, z, Position{x, y, z, DirectionEnum::UP});
+        repo.setTerrainEntityType(x, y, z,
+                                  EntityTypeComponent{0, map.subType0[i], 0});
+        repo.setTerrainMatterContainer(
+            x, y, z,
+            MatterContainer{map.terrainMatter[i], 0, map.waterMatter[i], 0});
+        repo.setTerrainStructuralIntegrity(x, y, z,
+                                           StructuralIntegrityComponent{});
+        repo.setPhysicsStats(x, y, z,
+                             PhysicsStats{static_cast<float>(map.mass[i]), 0.f,
+                                          0.f, 0.f, 0.f, 0.f, 0.f});
+        repo.setTerrainId(x, y, z, map.terrainId[i]);
+      }
+    }
+  }
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+double loadBox(const Map &map, TerrainGridRepository &repo,
+               int32_t flagBits) {
+  const std::vector<int32_t> flags(map.terrainId.size(), flagBits);
+
+  TerrainVoxelColumns columns;
+  columns.terrainId = map.terrainId.data();
+  columns.subType0 = map.subType0.data();
+  columns.terrainMatter = map.terrainMatter.data();
+  columns.waterMatter = map.waterMatter.data();
+  columns.mass = map.mass.data();
+  columns.flags = flags.data();
+
+  const auto start = Clock::now();
+  repo.loadTerrainBox(0, 0, 0, map.width, map.height, map.depth, columns);
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int width = argc > 1 ? std::atoi(argv[1]) : 256;
+  const int height = argc > 2 ? std::atoi(argv[2]) : 256;
+  const int depth = argc > 3 ? std::atoi(argv[3]) : 32;
+
+  const Map map = generate(width, height, depth);
+
+  TerrainStorage setterStorage, boxStorage;
+  setterStorage.initialize();
+  boxStorage.initialize();
+  entt::registry setterRegistry, boxRegistry;
+  TerrainGridRepository setterRepo(setterRegistry, setterStorage);
+  TerrainGridRepository boxRepo(boxRegistry, boxStorage);
+
+  const double settersMs = loadWithSetters(map, setterRepo);
+  // Direction UP and a default StructuralIntegrityComponent, as written by
+  // the setters.
+  const double boxMs =
+      loadBox(map, boxRepo, setterStorage.getFlagBits(0, 0, 0));
+
+  bool ok = true;
+  std::size_t voxels = 0;
+  for (int z = 0; z < depth && ok; ++z) {
+    for (int y = 0; y < height && ok; ++y) {
+      for (int x = 0; x < width && ok; ++x) {
+        const int64_t a = setterStorage.getTerrainIdIfExists(x, y, z);
+        const int64_t b = boxStorage.getTerrainIdIfExists(x, y, z);
+        voxels += a != static_cast<int64_t>(TerrainIdTypeEnum::NONE);
+        ok = a == b &&
+             setterStorage.getTerrainSubType0(x, y, z) ==
+                 boxStorage.getTerrainSubType0(x, y, z) &&
+             setterStorage.getTerrainMatter(x, y, z) ==
+                 boxStorage.getTerrainMatter(x, y, z) &&
+             setterStorage.getTerrainWaterMatter(x, y, z) ==
+                 boxStorage.getTerrainWaterMatter(x, y, z) &&
+             setterStorage.getTerrainMass(x, y, z) ==
+                 boxStorage.getTerrainMass(x, y, z) &&
+             setterStorage.getFlagBits(x, y, z) ==
+                 boxStorage.getFlagBits(x, y, z);
+        if (!ok) {
+          std::cerr << "Voxel (" << x << ", " << y << ", " << z
+                    << ") differs between setters and box" << std::endl;
+        }
+      }
+    }
+  }
+  ok = ok && setterStorage.countActiveWaterMatterVoxels() ==
+                 boxStorage.countActiveWaterMatterVoxels();
+
+  std::cout << "=== terrain bulk load (" << width << "x" << height << "x"
+            << depth << ", " << voxels << " terrain voxels) ===" << std::endl;
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << std::setw(10) << "setters" << std::setw(12) << settersMs
+            << " ms" << std::endl;
+  std::cout << std::setw(10) << "box" << std::setw(12) << boxMs << " ms"
+            << std::endl;
+  if (boxMs > 0.0) {
+    std::cout << "speedup " << settersMs / boxMs << "x" << std::endl;
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "components/MovingComponent.hpp"
+#include "components/TerrainComponents.hpp"
+#include "terrain/TerrainGridLock.hpp"
+#include "terrain/TerrainGridRepository.hpp"
+#include "terrain/TerrainStorage.hpp"
+
+/**
+ * Terrain lock contention benchmark
+ *
+ * Runs three kinds of worker against one repository at the same time, the
+ * way the water workers, physics and perception overlap in a tick:
+ *   - water:      move one unit of water from a voxel to a face neighbour
+ *                 (read both matter containers, write both back);
+ *   - physics:    moveTerrain() a solid voxel into an empty neighbour;
+ *   - perception: getStencil() reads around a random voxel.
+ * Each op picks its voxel at random over a world of 4x4 regions. The run is
+ * repeated with writers holding the whole-grid TerrainGridLock (the old
+ * behaviour) and with a TerrainRegionLock over source and target, and ops/s
+ * per worker kind is reported for both.
+ *
+ * Water is moved, never created or destroyed, so the run fails if the
+ * grid total changes; test_terrain_region_lock covers lost updates under
+ * ctest.
+ *
+ * Usage: bench_terrain_contention [millis_per_run] [threads_per_kind]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kWidth = 4 * TerrainStorage::kRegionDim;
+constexpr int kHeight = 4 * TerrainStorage::kRegionDim;
+constexpr int kDepth = 16;
+
+constexpr int kFaces[6][3] = {{1, 0, 0},  {-1, 0, 0}, {0, 1, 0},
+                              {0, -1, 0}, {0, 0, 1},  {0, 0, -1}};
+
+enum class LockKind { GRID, REGION };
+
+struct RunResult {
+  uint64_t waterOps = 0;
+  uint64_t physicsOps = 0;
+  uint64_t perceptionOps = 0;
+  double seconds = 0.0;
+};
+
+void populate(TerrainStorage &storage) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<> coin(0, 15);
+  std::uniform_int_distribution<> amount(1, 8);
+  for (int z = 1; z < kDepth - 1; ++z) {
+    for (int y = 1; y < kHeight - 1; ++y) {
+      for (int x = 1; x < kWidth - 1; ++x) {
+        const int roll = coin(gen);
+        if (roll > 2) {
+          continue; // mostly empty, so movers have somewhere to go
+        }
+        const bool water = roll != 0;
+        storage.setTerrainId(
+            x, y, z, static_cast<int>(TerrainIdTypeEnum::ON_GRID_STORAGE));
+        storage.setTerrainMainType(x, y, z, 0);
+        storage.setTerrainSubType0(
+            x, y, z,
+            static_cast<int>(water ? TerrainEnum::WATER : TerrainEnum::GRASS));
+        storage.setTerrainWaterMatter(x, y, z, water ? amount(gen) : 0);
+        storage.setTerrainMatter(x, y, z, water ? 0 : 10);
+      }
+    }
+  }
+}
+
+struct Picker {
+  std::mt19937 gen;
+  std::uniform_int_distribution<> x{1, kWidth - 2};
+  std::uniform_int_distribution<> y{1, kHeight - 2};
+  std::uniform_int_distribution<> z{1, kDepth - 2};
+  std::uniform_int_distribution<> face{0, 5};
+
+  explicit Picker(unsigned seed) : gen(seed) {}
+
+  VoxelCoord voxel() { return VoxelCoord{x(gen), y(gen), z(gen)}; }
+  VoxelCoord neighbour(const VoxelCoord &v) {
+    const int *d = kFaces[face(gen)];
+    return VoxelCoord{v.x + d[0], v.y + d[1], v.z + d[2]};
+  }
+};
+
+bool inside(const VoxelCoord &v) {
+  return v.x >= 0 && v.y >= 0 && v.z >= 0 && v.x < kWidth && v.y < kHeight &&
+         v.z < kDepth;
+}
+
+void waterOp(TerrainGridRepository &repo, const VoxelCoord &src,
+             const VoxelCoord &dst) {
+  if (!inside(dst)) {
+    return;
+  }
+  MatterContainer from = repo.getTerrainMatterContainer(src.x, src.y, src.z);
+  if (from.WaterMatter <= 0) {
+    return;
+  }
+  MatterContainer to = repo.getTerrainMatterContainer(dst.x, dst.y, dst.z);
+  if (to.WaterVapor > 0) {
+    return;
+  }
+  from.WaterMatter -= 1;
+  to.WaterMatter += 1;
+  TerrainWriteBatch batch(TerrainWriteOrder::BY_LEAF);
+  batch.setTerrainMatterContainer(src.x, src.y, src.z, from);
+  batch.setTerrainMatterContainer(dst.x, dst.y, dst.z, to);
+  repo.applyWriteBatch(batch);
+}
+
+void physicsOp(TerrainGridRepository &repo, const VoxelCoord &src,
+               const VoxelCoord &dst) {
+  if (!inside(dst) || !repo.getTerrainIdIfExists(src.x, src.y, src.z) ||
+      repo.getTerrainIdIfExists(dst.x, dst.y, dst.z)) {
+    return;
+  }
+  MovingComponent mc{};
+  mc.isMoving = true;
+  mc.movingFromX = src.x;
+  mc.movingFromY = src.y;
+  mc.movingFromZ = src.z;
+  mc.movingToX = dst.x;
+  mc.movingToY = dst.y;
+  mc.movingToZ = dst.z;
+  mc.direction = DirectionEnum::UP;
+  repo.moveTerrain(mc);
+}
+
+RunResult run(TerrainGridRepository &repo, LockKind kind, int millis,
+              int threadsPerKind) {
+  std::atomic<bool> stop{false};
+  std::atomic<uint64_t> waterOps{0}, physicsOps{0}, perceptionOps{0};
+
+  auto worker = [&](int role, unsigned seed) {
+    Picker pick(seed);
+    uint64_t ops = 0;
+    while (!stop.load(std::memory_order_relaxed)) {
+      if (role == 0 || role == 1) {
+        // Writers lock source and target for the whole read-modify-write,
+        // as _handleWaterSpreadEvent and the physics move path do.
+        const VoxelCoord src = pick.voxel();
+        const VoxelCoord dst = pick.neighbour(src);
+        auto op = role == 0 ? waterOp : physicsOp;
+        if (kind == LockKind::GRID) {
+          TerrainGridLock lock(&repo);
+          op(repo, src, dst);
+        } else {
+          TerrainRegionLock lock(&repo, {src, dst});
+          op(repo, src, dst);
+        }
+      } else {
+        const VoxelCoord v = pick.voxel();
+        TerrainStencil st = repo.getStencil(
+            v.x, v.y, v.z, StencilField::TERRAIN_ID | StencilField::MATTER);
+        if (st.matter[TerrainStencil::kCentre].WaterMatter < 0) {
+          std::cerr << "negative water at stencil centre" << std::endl;
+        }
+      }
+      ++ops;
+    }
+    (role == 0 ? waterOps : role == 1 ? physicsOps : perceptionOps) += ops;
+  };
+
+  std::vector<std::thread> threads;
+  auto start = Clock::now();
+  for (int role = 0; role < 3; ++role) {
+    for (int t = 0; t < threadsPerKind; ++t) {
+      threads.emplace_back(worker, role,
+                           static_cast<unsigned>(1000 * role + t + 1));
+    }
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+  stop = true;
+  for (auto &t : threads) {
+    t.join();
+  }
+  RunResult r;
+  r.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  r.waterOps = waterOps;
+  r.physicsOps = physicsOps;
+  r.perceptionOps = perceptionOps;
+  return r;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int millis = argc > 1 ? std::atoi(argv[1]) : 2000;
+  const int threadsPerKind = argc > 2 ? std::atoi(argv[2]) : 2;
+
+  TerrainStorage storage;
+  storage.initialize();
+  entt::registry registry;
+  TerrainGridRepository repo(registry, storage);
+  repo.reserveRegions(kWidth, kHeight, kDepth);
+  populate(storage);
+
+  const int64_t waterBefore = repo.sumTotalWater();
+  bool ok = true;
+
+  std::cout << "=== terrain lock contention (" << kWidth << "x" << kHeight
+            << "x" << kDepth << ", " << threadsPerKind
+            << " threads per kind, " << millis << " ms per run) ==="
+            << std::endl;
+  std::cout << std::setw(8) << "lock" << std::setw(14) << "water/s"
+            << std::setw(14) << "physics/s" << std::setw(16) << "perception/s"
+            << std::endl;
+  std::cout << std::fixed << std::setprecision(0);
+
+  for (LockKind kind : {LockKind::GRID, LockKind::REGION}) {
+    RunResult r = run(repo, kind, millis, threadsPerKind);
+    std::cout << std::setw(8) << (kind == LockKind::GRID ? "grid" : "region")
+              << std::setw(14) << r.waterOps / r.seconds << std::setw(14)
+              << r.physicsOps / r.seconds << std::setw(16)
+              << r.perceptionOps / r.seconds << std::endl;
+
+    const int64_t waterAfter = repo.sumTotalWater();
+    if (waterAfter != waterBefore) {
+      std::cerr << "Water not conserved under "
+                << (kind == LockKind::GRID ? "grid" : "region")
+                << " locking: " << waterBefore << " -> " << waterAfter
+                << std::endl;
+      ok = false;
+    }
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,199 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "components/TerrainComponents.hpp"
+#include "terrain/TerrainGridRepository.hpp"
+#include "terrain/TerrainStorage.hpp"
+
+/**
+ * Neighbourhood read benchmark for TerrainGridRepository::getStencil
+ *
+ * Fills a block of terrain with random water/grass cells, then visits every
+ * interior voxel and reads terrain id, entity type and matter for its
+ * neighbours -- once through the per-voxel repository getters (a lock per
+ * call and, for most attributes, a root-to-leaf descent per neighbour, which
+ * is what the water spread and collision paths used to do) and once through a
+ * single getStencil() call. Reports ns per visited voxel for the 3x3x3 box and the
+ * 7-point face stencil.
+ *
+ * The run fails if the two paths disagree on any value;
+ * test_terrain_stencil covers that under ctest.
+ *
+ * Usage: bench_terrain_stencil [passes]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 64;
+constexpr int kDepth = 16;
+
+constexpr uint32_t kFields = StencilField::TERRAIN_ID |
+                             StencilField::ENTITY_TYPE | StencilField::MATTER;
+
+struct Sample {
+  int64_t terrainId;
+  int mainType, subType0, subType1;
+  MatterContainer matter;
+};
+
+void populate(TerrainStorage &storage) {
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<> coin(0, 3);
+  std::uniform_int_distribution<> amount(0, 12);
+  for (int z = 0; z < kDepth; ++z) {
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        const int roll = coin(gen);
+        if (roll == 0) {
+          continue; // empty
+        }
+        const bool water = roll == 1;
+        storage.setTerrainId(
+            x, y, z, static_cast<int>(TerrainIdTypeEnum::ON_GRID_STORAGE));
+        storage.setTerrainMainType(x, y, z, 0);
+        storage.setTerrainSubType0(
+            x, y, z,
+            static_cast<int>(water ? TerrainEnum::WATER : TerrainEnum::GRASS));
+        storage.setTerrainSubType1(x, y, z, coin(gen) == 3 ? 1 : 0);
+        storage.setTerrainWaterMatter(x, y, z, amount(gen));
+        storage.setTerrainMatter(x, y, z, water ? 0 : 10);
+      }
+    }
+  }
+}
+
+Sample readPointwise(const TerrainGridRepository &repo, int x, int y, int z) {
+  Sample s{};
+  s.terrainId = repo.getTerrainIdIfExists(x, y, z).value_or(-2);
+  EntityTypeComponent etc = repo.getTerrainEntityType(x, y, z);
+  s.mainType = etc.mainType;
+  s.subType0 = etc.subType0;
+  s.subType1 = etc.subType1;
+  s.matter = repo.getTerrainMatterContainer(x, y, z);
+  return s;
+}
+
+bool same(const Sample &a, const TerrainStencil &st, int i) {
+  return a.terrainId == st.terrainId[i] && a.mainType == st.mainType[i] &&
+         a.subType0 == st.subType0[i] && a.subType1 == st.subType1[i] &&
+         a.matter.TerrainMatter == st.matter[i].TerrainMatter &&
+         a.matter.WaterMatter == st.matter[i].WaterMatter &&
+         a.matter.WaterVapor == st.matter[i].WaterVapor &&
+         a.matter.BioMassMatter == st.matter[i].BioMassMatter;
+}
+
+// Sink for the timed loops so the reads are not optimised away.
+volatile int64_t g_sink = 0;
+
+template <typename Fn> double nsPerVoxel(int passes, Fn &&visit) {
+  int64_t acc = 0;
+  std::size_t visited = 0;
+  auto start = Clock::now();
+  for (int p = 0; p < passes; ++p) {
+    for (int z = 1; z < kDepth - 1; ++z) {
+      for (int y = 1; y < kHeight - 1; ++y) {
+        for (int x = 1; x < kWidth - 1; ++x) {
+          acc += visit(x, y, z);
+          ++visited;
+        }
+      }
+    }
+  }
+  auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start);
+  g_sink = acc;
+  return elapsed.count() / static_cast<double>(visited);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int passes = argc > 1 ? std::atoi(argv[1]) : 20;
+
+  TerrainStorage storage;
+  storage.initialize();
+  entt::registry registry;
+  TerrainGridRepository repo(registry, storage);
+  populate(storage);
+
+  // Correctness: every stencil entry matches the per-voxel getters.
+  bool ok = true;
+  for (int z = 1; z < kDepth - 1 && ok; ++z) {
+    for (int y = 1; y < kHeight - 1 && ok; ++y) {
+      for (int x = 1; x < kWidth - 1 && ok; ++x) {
+        TerrainStencil box = repo.getStencil(x, y, z, kFields);
+        TerrainStencil faces =
+            repo.getStencil(x, y, z, kFields, StencilShape::FACES_7);
+        for (int dz = -1; dz <= 1; ++dz) {
+          for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+              const int i = TerrainStencil::index(dx, dy, dz);
+              Sample s = readPointwise(repo, x + dx, y + dy, z + dz);
+              bool match = same(s, box, i);
+              if (faces.covers(x + dx, y + dy, z + dz)) {
+                match = match && same(s, faces, i);
+              }
+              if (!match) {
+                std::cerr << "Stencil mismatch at (" << x + dx << ", "
+                          << y + dy << ", " << z + dz << ") around (" << x
+                          << ", " << y << ", " << z << ")" << std::endl;
+                ok = false;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  auto pointwise = [&](int n) {
+    return [&, n](int x, int y, int z) {
+      int64_t sum = 0;
+      for (int dz = -1; dz <= 1; ++dz) {
+        for (int dy = -1; dy <= 1; ++dy) {
+          for (int dx = -1; dx <= 1; ++dx) {
+            if (n == 7 && (dx != 0) + (dy != 0) + (dz != 0) > 1) {
+              continue;
+            }
+            Sample s = readPointwise(repo, x + dx, y + dy, z + dz);
+            sum += s.terrainId + s.subType0 + s.matter.WaterMatter;
+          }
+        }
+      }
+      return sum;
+    };
+  };
+  auto stencil = [&](StencilShape shape) {
+    return [&, shape](int x, int y, int z) {
+      TerrainStencil st = repo.getStencil(x, y, z, kFields, shape);
+      int64_t sum = 0;
+      for (int i = 0; i < TerrainStencil::kSize; ++i) {
+        sum += st.terrainId[i] + st.subType0[i] + st.matter[i].WaterMatter;
+      }
+      return sum;
+    };
+  };
+
+  std::cout << "=== terrain neighbourhood reads (" << kWidth << "x" << kHeight
+            << "x" << kDepth << ", " << passes << " passes) ===" << std::endl;
+  std::cout << std::setw(10) << "shape" << std::setw(18) << "pointwise ns/vox"
+            << std::setw(18) << "stencil ns/vox" << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << std::setw(10) << "box27" << std::setw(18)
+            << nsPerVoxel(passes, pointwise(27)) << std::setw(18)
+            << nsPerVoxel(passes, stencil(StencilShape::BOX_27)) << std::endl;
+  std::cout << std::setw(10) << "faces7" << std::setw(18)
+            << nsPerVoxel(passes, pointwise(7)) << std::setw(18)
+            << nsPerVoxel(passes, stencil(StencilShape::FACES_7)) << std::endl;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "EventSink.hpp"
+#include "components/TerrainComponents.hpp"
+#include "terrain/TerrainGridRepository.hpp"
+#include "terrain/TerrainStorage.hpp"
+#include "terrain/VoxelCoordMap.hpp"
+
+/**
+ * Activate/deactivate churn benchmark for the repository tracking maps
+ *
+ * Replays a rain-storm-like cycle: keep a working set of active voxels,
+ * and on every step activate one random voxel (create an entity, map
+ * coord <-> entity), look a few live ones up by coord and by entity, then
+ * deactivate a random live one (unmap, destroy the entity so its id is
+ * recycled). The same op stream runs against
+ *   - the std::unordered_map pair the repository used to hold, and
+ *   - VoxelCoordMap + EntityVoxelIndex,
+ * and ns per step is reported for each. A third row times the full
+ * TerrainGridRepository::createEnttForTerrain / softDeactivateEntity cycle.
+ *
+ * The run fails if the two bookkeeping variants end with different
+ * contents; test_voxel_coord_map covers that under ctest.
+ *
+ * Usage: bench_terrain_tracking [steps] [working_set]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kExtent = 256; // voxels per axis the churn is spread over
+
+struct StdMaps {
+  std::unordered_map<VoxelCoord, entt::entity, VoxelCoordHash> byCoord;
+  std::unordered_map<entt::entity, VoxelCoord> byEntity;
+
+  void add(const VoxelCoord &c, entt::entity e) {
+    byCoord[c] = e;
+    byEntity[e] = c;
+  }
+  void remove(const VoxelCoord &c, entt::entity e) {
+    byCoord.erase(c);
+    byEntity.erase(e);
+  }
+  entt::entity at(const VoxelCoord &c) const {
+    auto it = byCoord.find(c);
+    return it == byCoord.end() ? entt::null : it->second;
+  }
+  bool has(entt::entity e) const { return byEntity.count(e) > 0; }
+};
+
+struct FlatMaps {
+  VoxelCoordMap<entt::entity> byCoord;
+  EntityVoxelIndex byEntity;
+
+  void add(const VoxelCoord &c, entt::entity e) {
+    byCoord[c] = e;
+    byEntity.set(e, c);
+  }
+  void remove(const VoxelCoord &c, entt::entity e) {
+    byCoord.erase(c);
+    byEntity.erase(e);
+  }
+  entt::entity at(const VoxelCoord &c) const {
+    const entt::entity *e = byCoord.find(c);
+    return e ? *e : entt::null;
+  }
+  bool has(entt::entity e) const { return byEntity.find(e) != nullptr; }
+};
+
+// Sink for the timed loops so the lookups are not optimised away.
+volatile int64_t g_sink = 0;
+
+template <typename Maps>
+double nsPerStep(Maps &maps, int steps, int workingSet) {
+  entt::registry registry;
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<> axis(0, kExtent - 1);
+  std::vector<std::pair<VoxelCoord, entt::entity>> live;
+  live.reserve(workingSet + 1);
+  int64_t acc = 0;
+
+  auto start = Clock::now();
+  for (int step = 0; step < steps; ++step) {
+    VoxelCoord c{axis(gen), axis(gen), axis(gen) / 16};
+    if (maps.at(c) == entt::null) {
+      entt::entity e = registry.create();
+      maps.add(c, e);
+      live.emplace_back(c, e);
+    }
+    for (int probe = 0; probe < 4 && !live.empty(); ++probe) {
+      const auto &[pc, pe] = live[gen() % live.size()];
+      acc += static_cast<int64_t>(entt::to_integral(maps.at(pc)));
+      acc += maps.has(pe) ? 1 : 0;
+    }
+    if (static_cast<int>(live.size()) > workingSet) {
+      const std::size_t victim = gen() % live.size();
+      auto [vc, ve] = live[victim];
+      maps.remove(vc, ve);
+      registry.destroy(ve);
+      live[victim] = live.back();
+      live.pop_back();
+    }
+  }
+  auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start);
+  g_sink = acc;
+  return elapsed.count() / steps;
+}
+
+double repositoryNsPerCycle(int steps) {
+  TerrainStorage storage;
+  storage.initialize();
+  entt::registry registry;
+  TerrainGridRepository repo(registry, storage);
+  entt::dispatcher dispatcher;
+  WorkerEventSink staging;
+  EventSink sink(dispatcher, staging, std::this_thread::get_id());
+
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<> axis(0, kExtent - 1);
+  auto start = Clock::now();
+  for (int step = 0; step < steps; ++step) {
+    const int x = axis(gen), y = axis(gen), z = axis(gen) / 16;
+    entt::entity e = repo.createEnttForTerrain(x, y, z);
+    repo.softDeactivateEntity(sink, e);
+    registry.destroy(e);
+  }
+  auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start);
+  return elapsed.count() / steps;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int steps = argc > 1 ? std::atoi(argv[1]) : 2'000'000;
+  const int workingSet = argc > 2 ? std::atoi(argv[2]) : 20'000;
+
+  StdMaps stdMaps;
+  FlatMaps flatMaps;
+  const double stdNs = nsPerStep(stdMaps, steps, workingSet);
+  const double flatNs = nsPerStep(flatMaps, steps, workingSet);
+  const double repoNs = repositoryNsPerCycle(steps / 10);
+
+  // Same seed, same op stream: both must hold exactly the same mapping.
+  bool ok = stdMaps.byCoord.size() == flatMaps.byCoord.size() &&
+            stdMaps.byEntity.size() == flatMaps.byEntity.size();
+  for (const auto &[coord, entity] : stdMaps.byCoord) {
+    const VoxelCoord *back = flatMaps.byEntity.find(entity);
+    if (flatMaps.at(coord) != entity || !back || !(*back == coord)) {
+      ok = false;
+      break;
+    }
+  }
+  if (!ok) {
+    std::cerr << "Flat tracking maps diverged from std::unordered_map"
+              << std::endl;
+  }
+
+  std::cout << "=== terrain tracking map churn (" << steps << " steps, "
+            << workingSet << " live) ===" << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << std::setw(28) << "unordered_map ns/step" << std::setw(12)
+            << stdNs << std::endl;
+  std::cout << std::setw(28) << "flat ns/step" << std::setw(12) << flatNs
+            << std::endl;
+  std::cout << std::setw(28) << "repository ns/cycle" << std::setw(12)
+            << repoNs << std::endl;
+
+  return ok ? 0 : 1;
+}
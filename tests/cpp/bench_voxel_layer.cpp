@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "voxelgrid/VoxelLayerCodec.hpp"
+
+/**
+ * Voxel layer codec benchmark
+ *
+ * Builds the terrain and entity layers of one perception view the way
+ * World::buildTerrainView fills them: a (2r+1)^2 x (2zr+1) cube with empty
+ * (0) air, a ground surface of unique virtual terrain ids, occluded (-3)
+ * voxels under it, and a sprinkling of entity ids. Each layer is encoded
+ * with encodeVoxelLayer and the bytes on the wire are compared with the
+ * dense [int] array VoxelGridView used to send.
+ *
+ * Reading back is timed as VoxelGridViewFlatB does it: one voxel at a
+ * time, straight from the dense array or through a VoxelSliceCache, in
+ * slice order (how perception code walks a view) and in random order.
+ * A layer that reads back wrong fails the run.
+ *
+ * Usage: bench_voxel_layer [radius] [z_radius] [reads]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Layers {
+  std::vector<int> terrain;
+  std::vector<int> entity;
+};
+
+Layers buildView(int side, int depth) {
+  const std::size_t n = static_cast<std::size_t>(side) * side * depth;
+  Layers layers{std::vector<int>(n, 0), std::vector<int>(n, 0)};
+  int virtualId = -1000;
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      const float h = 0.5f * depth + 1.5f * std::sin(x * 0.3f) *
+                                         std::cos(y * 0.2f);
+      const int top = std::clamp(static_cast<int>(h), 0, depth - 1);
+      for (int z = 0; z <= top; ++z) {
+        const std::size_t i =
+            (static_cast<std::size_t>(z) * side + y) * side + x;
+        layers.terrain[i] = z == top ? virtualId-- : -3;
+      }
+      if ((x * 31 + y * 17) % 23 == 0 && top + 1 < depth) {
+        const std::size_t i =
+            (static_cast<std::size_t>(top + 1) * side + y) * side + x;
+        layers.entity[i] = 100 + x + y * side;
+      }
+    }
+  }
+  return layers;
+}
+
+const char *encodingName(VoxelLayerEncoding encoding) {
+  switch (encoding) {
+  case VoxelLayerEncoding::DENSE:
+    return "dense";
+  case VoxelLayerEncoding::PALETTE_RLE:
+    return "palette+rle";
+  case VoxelLayerEncoding::SPARSE:
+    return "sparse";
+  }
+  return "?";
+}
+
+struct ReadResult {
+  double denseNs = 0.0;
+  double cachedNs = 0.0;
+  bool ok = true;
+};
+
+// Reads `order` (linear voxel indices) back from the dense array and from
+// the encoded layer through a slice cache.
+ReadResult timeReads(const std::vector<int> &dense,
+                     const EncodedVoxelLayer &layer, int side,
+                     const std::vector<uint32_t> &order) {
+  const std::size_t sliceSize = static_cast<std::size_t>(side) * side;
+  const VoxelLayerSpans spans = layer.spans(dense.data());
+  ReadResult r;
+
+  long long sum = 0;
+  auto start = Clock::now();
+  for (uint32_t i : order) {
+    sum += dense[i];
+  }
+  r.denseNs = std::chrono::duration<double, std::nano>(Clock::now() - start)
+                  .count() /
+              order.size();
+
+  VoxelSliceCache cache;
+  long long cachedSum = 0;
+  start = Clock::now();
+  for (uint32_t i : order) {
+    const int z = static_cast<int>(i / sliceSize);
+    const int *slice = cache.find(z);
+    if (!slice) {
+      slice = cache.load(spans, sliceSize, z);
+    }
+    const int value = slice[i % sliceSize];
+    cachedSum += value;
+    if (value != dense[i]) {
+      r.ok = false;
+    }
+  }
+  r.cachedNs = std::chrono::duration<double, std::nano>(Clock::now() - start)
+                   .count() /
+               order.size();
+  if (sum != cachedSum) {
+    r.ok = false;
+  }
+  return r;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int radius = argc > 1 ? std::atoi(argv[1]) : 16;
+  const int zRadius = argc > 2 ? std::atoi(argv[2]) : 4;
+  const int reads = argc > 3 ? std::atoi(argv[3]) : 1000000;
+  const int side = 2 * radius + 1;
+  const int depth = 2 * zRadius + 1;
+  const std::size_t n = static_cast<std::size_t>(side) * side * depth;
+
+  Layers layers = buildView(side, depth);
+  bool ok = true;
+
+  std::vector<uint32_t> sliceOrder(static_cast<std::size_t>(reads));
+  std::vector<uint32_t> randomOrder(static_cast<std::size_t>(reads));
+  uint32_t state = 12345;
+  for (std::size_t k = 0; k < sliceOrder.size(); ++k) {
+    sliceOrder[k] = static_cast<uint32_t>(k % n);
+    state = state * 1664525u + 1013904223u;
+    randomOrder[k] = static_cast<uint32_t>((state >> 8) % n);
+  }
+
+  std::cout << "=== voxel layer codec (radius " << radius << ", z radius "
+            << zRadius << ", " << n << " voxels) ===" << std::endl;
+  std::cout << std::setw(8) << "layer" << std::setw(13) << "encoding"
+            << std::setw(12) << "dense B" << std::setw(12) << "encoded B"
+            << std::setw(12) << "encode us" << std::setw(16)
+            << "ns/read dense" << std::setw(16) << "ns/read slice"
+            << std::setw(17) << "ns/read random" << std::endl;
+
+  std::size_t denseTotal = 0;
+  std::size_t encodedTotal = 0;
+  const std::pair<const char *, const std::vector<int> *> named[] = {
+      {"terrain", &layers.terrain}, {"entity", &layers.entity}};
+  for (const auto &[name, data] : named) {
+    auto start = Clock::now();
+    EncodedVoxelLayer layer = encodeVoxelLayer(*data, side, side, depth);
+    const double encodeUs =
+        std::chrono::duration<double, std::micro>(Clock::now() - start)
+            .count();
+
+    std::vector<int> decoded;
+    decodeVoxelLayer(layer.spans(data->data()),
+                     static_cast<std::size_t>(side) * side, depth, decoded);
+    if (decoded != *data) {
+      std::cerr << name << " layer does not decode to the original"
+                << std::endl;
+      ok = false;
+    }
+
+    ReadResult inOrder = timeReads(*data, layer, side, sliceOrder);
+    ReadResult random = timeReads(*data, layer, side, randomOrder);
+    if (!inOrder.ok || !random.ok) {
+      std::cerr << name << " layer reads back wrong values" << std::endl;
+      ok = false;
+    }
+
+    const std::size_t denseBytes = 4 + n * sizeof(int);
+    denseTotal += denseBytes;
+    encodedTotal += layer.bytes;
+    std::cout << std::setw(8) << name << std::setw(13)
+              << encodingName(layer.encoding) << std::setw(12) << denseBytes
+              << std::setw(12) << layer.bytes << std::fixed
+              << std::setprecision(1) << std::setw(12) << encodeUs
+              << std::setprecision(2) << std::setw(16) << inOrder.denseNs
+              << std::setw(16) << inOrder.cachedNs << std::setw(17)
+              << random.cachedNs << std::endl;
+  }
+  std::cout << "voxel bytes per response: " << denseTotal << " -> "
+            << encodedTotal << std::endl;
+
+  return ok ? 0 : 1;
+}
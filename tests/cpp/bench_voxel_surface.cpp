@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include "Gui/VoxelSurfaceMesh.hpp"
+
+/**
+ * Voxel viewport surface benchmark
+ *
+ * Builds a side^3 int voxel array shaped like terrain (rolling hills in
+ * layers of a few materials, with some floating blocks) and times what the
+ * 3D voxel viewport does per frame, two ways:
+ *   - per voxel: walk the whole array, collect every non-zero voxel and
+ *                test its six neighbours for exposed faces (the old
+ *                processIntVoxelData + drawVoxelPoints path);
+ *   - cached:    VoxelSurfaceMesh::update() on unchanged data, which only
+ *                compares the array with its copy and hands back the
+ *                greedy-merged quads.
+ * The one-off rebuild time and the face/quad counts are reported too. The
+ * run fails if the quads do not cover the per-voxel faces, so a timing is
+ * never reported for a wrong mesh.
+ *
+ * Usage: bench_voxel_surface [side] [frames]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// (face, x, y, z, value) of one exposed unit face.
+using UnitFace = std::tuple<int, int, int, int, int>;
+
+std::vector<int> buildTerrain(int side) {
+  std::vector<int> voxels(static_cast<std::size_t>(side) * side * side, 0);
+  auto at = [&](int x, int y, int z) -> int & {
+    return voxels[(static_cast<std::size_t>(z) * side + y) * side + x];
+  };
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      const float h = 0.35f * side +
+                      0.1f * side * std::sin(x * 0.09f) * std::cos(y * 0.07f);
+      const int top = std::clamp(static_cast<int>(h), 1, side - 1);
+      for (int z = 0; z < top; ++z) {
+        at(x, y, z) = z + 4 < top ? (z < top / 2 ? 3 : 2) : 1;
+      }
+    }
+  }
+  for (int i = 0; i < side; i += 5) {
+    at(i, (i * 7) % side, side - 2) = 4;
+  }
+  return voxels;
+}
+
+std::vector<UnitFace> perVoxelFaces(const std::vector<int> &voxels,
+                                    int side) {
+  static constexpr int kSteps[6][3] = {{-1, 0, 0}, {1, 0, 0}, {0, -1, 0},
+                                       {0, 1, 0},  {0, 0, -1}, {0, 0, 1}};
+  auto solid = [&](int x, int y, int z) {
+    if (x < 0 || y < 0 || z < 0 || x >= side || y >= side || z >= side) {
+      return false;
+    }
+    return voxels[(static_cast<std::size_t>(z) * side + y) * side + x] != 0;
+  };
+  std::vector<UnitFace> faces;
+  for (int x = 0; x < side; ++x) {
+    for (int y = 0; y < side; ++y) {
+      for (int z = 0; z < side; ++z) {
+        const int value =
+            voxels[(static_cast<std::size_t>(z) * side + y) * side + x];
+        if (value == 0) {
+          continue;
+        }
+        for (int f = 0; f < 6; ++f) {
+          if (!solid(x + kSteps[f][0], y + kSteps[f][1], z + kSteps[f][2])) {
+            faces.emplace_back(f, x, y, z, value);
+          }
+        }
+      }
+    }
+  }
+  return faces;
+}
+
+std::vector<UnitFace> rasterise(const std::vector<SurfaceQuad> &quads) {
+  std::vector<UnitFace> faces;
+  for (const SurfaceQuad &q : quads) {
+    const int f = static_cast<int>(q.face);
+    const int axis = f / 2;
+    float lo[3], hi[3];
+    for (int a = 0; a < 3; ++a) {
+      lo[a] = std::min({q.corners[0][a], q.corners[1][a], q.corners[2][a],
+                        q.corners[3][a]});
+      hi[a] = std::max({q.corners[0][a], q.corners[1][a], q.corners[2][a],
+                        q.corners[3][a]});
+    }
+    // The voxel sits behind the face plane along the normal.
+    const int plane = static_cast<int>(lo[axis]) - (f % 2 == 1 ? 1 : 0);
+    lo[axis] = static_cast<float>(plane);
+    hi[axis] = static_cast<float>(plane + 1);
+    for (int z = static_cast<int>(lo[2]); z < static_cast<int>(hi[2]); ++z) {
+      for (int y = static_cast<int>(lo[1]); y < static_cast<int>(hi[1]);
+           ++y) {
+        for (int x = static_cast<int>(lo[0]); x < static_cast<int>(hi[0]);
+             ++x) {
+          faces.emplace_back(f, x, y, z, q.value);
+        }
+      }
+    }
+  }
+  return faces;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int side = argc > 1 ? std::atoi(argv[1]) : 128;
+  const int frames = argc > 2 ? std::atoi(argv[2]) : 20;
+
+  std::vector<int> voxels = buildTerrain(side);
+  bool ok = true;
+
+  std::vector<UnitFace> expected;
+  auto start = Clock::now();
+  for (int f = 0; f < frames; ++f) {
+    expected = perVoxelFaces(voxels, side);
+  }
+  const double perVoxelMs =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count() /
+      frames;
+
+  VoxelSurfaceMesh mesh;
+  start = Clock::now();
+  mesh.update(voxels.data(), VoxelSurfaceMesh::Kind::INT, side, side, side);
+  const double rebuildMs =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  int rebuilds = 0;
+  start = Clock::now();
+  for (int f = 0; f < frames; ++f) {
+    rebuilds += mesh.update(voxels.data(), VoxelSurfaceMesh::Kind::INT, side,
+                            side, side)
+                    ? 1
+                    : 0;
+  }
+  const double cachedMs =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count() /
+      frames;
+  if (rebuilds != 0) {
+    std::cerr << "Unchanged data was rebuilt " << rebuilds << " times"
+              << std::endl;
+    ok = false;
+  }
+
+  std::vector<UnitFace> merged = rasterise(mesh.quads());
+  std::sort(expected.begin(), expected.end());
+  std::sort(merged.begin(), merged.end());
+  if (merged != expected || mesh.exposedFaces() != expected.size()) {
+    std::cerr << "Merged quads cover " << merged.size()
+              << " faces, per-voxel pass found " << expected.size()
+              << std::endl;
+    ok = false;
+  }
+
+  // An in-place edit must be noticed.
+  voxels[voxels.size() - 1] = 9;
+  if (!mesh.update(voxels.data(), VoxelSurfaceMesh::Kind::INT, side, side,
+                   side)) {
+    std::cerr << "In-place edit did not trigger a rebuild" << std::endl;
+    ok = false;
+  }
+
+  std::cout << "=== voxel surface (" << side << "^3, " << frames
+            << " frames) ===" << std::endl;
+  std::cout << std::setw(12) << "pass" << std::setw(14) << "ms/frame"
+            << std::setw(14) << "primitives" << std::endl;
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << std::setw(12) << "per voxel" << std::setw(14) << perVoxelMs
+            << std::setw(14) << expected.size() << std::endl;
+  std::cout << std::setw(12) << "cached" << std::setw(14) << cachedMs
+            << std::setw(14) << mesh.quads().size() << std::endl;
+  std::cout << "rebuild: " << rebuildMs << " ms" << std::endl;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,240 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "physics/WaveField.hpp"
+
+/**
+ * Wave field benchmark
+ *
+ * Emits one sound wave (the emitter defaults: amplitude 1, lifetime
+ * `ticks`) in the middle of a cubic world and propagates it, two ways:
+ *   - packet: the per-voxel expansion WavePhysicsEngine's PACKET mode does
+ *             -- every packet re-emits into each voxel of its speed-radius
+ *             sphere, packets meeting in a voxel merge, keyed by the 16-bit
+ *             packed coordinate;
+ *   - field:  WaveField, the tiled finite-difference field behind FIELD
+ *             mode.
+ * Wall time per tick over the packet lifetime and the peak number of live
+ * packets / field voxels are reported. Merged packets keep their summed
+ * amplitude, so the packet run only stops when the lifetime runs out.
+ *
+ * The two models attenuate differently, so their amplitudes are not
+ * compared. Instead the run fails if the field spreads unevenly along the
+ * six axes, falls behind speed * tick, exceeds the injected amplitude, or
+ * keeps tiles once it has decayed (it keeps running past `ticks` for
+ * that); test_wave_field covers those under ctest.
+ *
+ * Usage: bench_wave_field [side] [ticks] [speed]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Packet {
+  float amplitude;
+  uint32_t lifetimeTicks;
+};
+
+uint64_t coordToKey(int x, int y, int z) {
+  return (static_cast<uint64_t>(x + 32768) << 32) |
+         (static_cast<uint64_t>(y + 32768) << 16) |
+         static_cast<uint64_t>(z + 32768);
+}
+
+struct RunResult {
+  int ticks = 0;
+  double msPerTick = 0.0;
+  std::size_t peakCells = 0;
+};
+
+RunResult runPacket(int side, int ticks, float amplitude, float speed) {
+  const float attenuation = 0.1f;
+  std::unordered_map<uint64_t, std::vector<Packet>> waves;
+  const int c = side / 2;
+  waves[coordToKey(c, c, c)].push_back(
+      Packet{amplitude, static_cast<uint32_t>(ticks)});
+
+  RunResult r;
+  auto start = Clock::now();
+  while (!waves.empty()) {
+    std::unordered_map<uint64_t, std::vector<Packet>> next;
+    for (auto &[key, packets] : waves) {
+      // Sound packets in one voxel merge into one.
+      float total = 0.0f;
+      for (const Packet &p : packets) {
+        total += p.amplitude;
+      }
+      const Packet merged{total, packets.front().lifetimeTicks};
+      if (merged.amplitude <= 0.001f || merged.lifetimeTicks == 0) {
+        continue;
+      }
+      const int x = static_cast<int>((key >> 32) & 0xFFFF) - 32768;
+      const int y = static_cast<int>((key >> 16) & 0xFFFF) - 32768;
+      const int z = static_cast<int>(key & 0xFFFF) - 32768;
+
+      // What getSphericalNeighbors builds for every packet, every tick.
+      std::vector<std::tuple<int, int, int, float>> neighbours;
+      const int radius = static_cast<int>(std::ceil(speed));
+      for (int dx = -radius; dx <= radius; ++dx) {
+        for (int dy = -radius; dy <= radius; ++dy) {
+          for (int dz = -radius; dz <= radius; ++dz) {
+            if (dx == 0 && dy == 0 && dz == 0) {
+              continue;
+            }
+            const float d = std::sqrt(static_cast<float>(dx * dx + dy * dy +
+                                                         dz * dz));
+            if (d <= speed) {
+              neighbours.emplace_back(x + dx, y + dy, z + dz, d);
+            }
+          }
+        }
+      }
+      for (const auto &[nx, ny, nz, d] : neighbours) {
+        if (nx < 0 || ny < 0 || nz < 0 || nx >= side || ny >= side ||
+            nz >= side) {
+          continue;
+        }
+        float a = merged.amplitude - attenuation * d;
+        if (d > 1.0f) {
+          a /= d * d;
+        }
+        if (a > 0.001f) {
+          next[coordToKey(nx, ny, nz)].push_back(
+              Packet{a, merged.lifetimeTicks - 1});
+        }
+      }
+    }
+    waves = std::move(next);
+    r.peakCells = std::max(r.peakCells, waves.size());
+    ++r.ticks;
+  }
+  r.msPerTick = std::chrono::duration<double, std::milli>(Clock::now() -
+                                                          start)
+                    .count() /
+                std::max(1, r.ticks);
+  return r;
+}
+
+// Tiles sit on the same grid along every axis, so the field must match
+// under axis swaps up to rounding. Mirrored voxels (+x vs -x) sit at
+// different offsets within their tiles; tiles appear and retire at the
+// amplitude threshold, so those can differ by about that much.
+bool same(float a, float b) {
+  return std::fabs(a - b) <= 1e-6f + 1e-4f * std::fabs(a);
+}
+
+bool mirrored(float a, float b, float threshold) {
+  return std::fabs(a - b) <= 2.0f * threshold;
+}
+
+RunResult runField(int side, int ticks, float amplitude, float speed,
+                   bool &ok) {
+  const float damping = 0.05f;
+  const float threshold = 0.001f;
+  // Odd extent so the walls are as far from the centre on every side.
+  const int c = side / 2;
+  WaveField field(2 * c + 1, 2 * c + 1, 2 * c + 1);
+  field.inject(c, c, c, amplitude);
+
+  RunResult r;
+  std::chrono::nanoseconds elapsed{0};
+  const int maxTicks =
+      static_cast<int>(static_cast<float>(side) * 8.0f / speed);
+  int tick = 0;
+  while (field.activeTiles() != 0 && tick < maxTicks) {
+    auto start = Clock::now();
+    field.advance(speed, damping, threshold);
+    ++tick;
+    if (tick <= ticks) {
+      elapsed += Clock::now() - start;
+      r.ticks = tick;
+      r.peakCells = std::max(r.peakCells, field.activeVoxels());
+    }
+
+    // Same amplitude at the same distance along every axis. Once the wave
+    // has bounced off the walls the threshold error can build up, so
+    // mirrors are only compared until then.
+    const float front = speed * static_cast<float>(tick);
+    const bool beforeWall = front < static_cast<float>(c);
+    int edge = 0;
+    for (int d = 0; d <= c; ++d) {
+      const float v = field.sample(c + d, c, c);
+      const float m = field.sample(c - d, c, c);
+      const bool symmetric =
+          same(v, field.sample(c, c + d, c)) &&
+          same(v, field.sample(c, c, c + d)) &&
+          same(m, field.sample(c, c - d, c)) &&
+          same(m, field.sample(c, c, c - d)) &&
+          (!beforeWall || mirrored(v, m, threshold));
+      if (!symmetric) {
+        std::cerr << "Field is not symmetric at distance " << d << " on tick "
+                  << tick << std::endl;
+        ok = false;
+        return r;
+      }
+      if (std::fabs(v) > amplitude) {
+        std::cerr << "Field grew past the injected amplitude on tick "
+                  << tick << std::endl;
+        ok = false;
+        return r;
+      }
+      if (std::fabs(v) > 2.0f * threshold) {
+        edge = d;
+      }
+    }
+
+    // Until it reaches the wall, the leading edge travels at `speed`.
+    // The injected pulse starts a few voxels wide.
+    if (front >= 8.0f && front < static_cast<float>(c) - 8.0f &&
+        (edge < front - 4.0f || edge > front + 6.0f)) {
+      std::cerr << "Wave front at " << edge << ", expected about " << front
+                << " on tick " << tick << std::endl;
+      ok = false;
+      return r;
+    }
+  }
+  if (field.activeTiles() != 0) {
+    std::cerr << field.activeTiles() << " tiles still live after " << tick
+              << " ticks" << std::endl;
+    ok = false;
+  }
+  r.msPerTick = std::chrono::duration<double, std::milli>(elapsed).count() /
+                std::max(1, r.ticks);
+  return r;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int side = argc > 1 ? std::atoi(argv[1]) : 96;
+  const int ticks = argc > 2 ? std::atoi(argv[2]) : 24;
+  const float speed = argc > 3 ? static_cast<float>(std::atof(argv[3])) : 1.0f;
+  const float amplitude = 1.0f;
+
+  RunResult packet = runPacket(side, ticks, amplitude, speed);
+  bool ok = true;
+  RunResult field = runField(side, ticks, amplitude, speed, ok);
+
+  std::cout << "=== wave field (" << side << "^3 world, " << ticks
+            << " ticks, speed " << speed << ") ===" << std::endl;
+  std::cout << std::setw(10) << "model" << std::setw(10) << "ticks"
+            << std::setw(14) << "ms/tick" << std::setw(14) << "peak cells"
+            << std::endl;
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << std::setw(10) << "packet" << std::setw(10) << packet.ticks
+            << std::setw(14) << packet.msPerTick << std::setw(14)
+            << packet.peakCells << std::endl;
+  std::cout << std::setw(10) << "field" << std::setw(10) << field.ticks
+            << std::setw(14) << field.msPerTick << std::setw(14)
+            << field.peakCells << std::endl;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "EcsCommandBuffer.hpp"
+
+/**
+ * EcsCommandBuffer / EcsCommandQueue playback tests
+ *
+ * Each case records a few commands and checks the registry after playback:
+ * commands for one entity and component type apply in recording order,
+ * destroys drop what was recorded for the entity, pending entities resolve,
+ * stale entities are skipped, and every thread's buffer is played back.
+ */
+
+namespace {
+
+struct Speed {
+  float value;
+};
+
+struct Tag {
+  int value;
+};
+
+void testRemoveThenEmplaceKeepsComponent() {
+  std::cout << "Testing remove then emplace..." << std::endl;
+  entt::registry registry;
+  const entt::entity e = registry.create();
+  registry.emplace<Speed>(e, 1.0f);
+
+  EcsCommandBuffer buffer;
+  buffer.remove<Speed>(e);
+  buffer.emplace<Speed>(e, 2.0f);
+  buffer.playback(registry);
+
+  assert(registry.all_of<Speed>(e));
+  assert(registry.get<Speed>(e).value == 2.0f);
+  std::cout << "✓ Remove then emplace test passed" << std::endl;
+}
+
+void testEmplaceThenRemoveDropsComponent() {
+  std::cout << "Testing emplace then remove..." << std::endl;
+  entt::registry registry;
+  const entt::entity e = registry.create();
+
+  EcsCommandBuffer buffer;
+  buffer.emplace<Speed>(e, 2.0f);
+  buffer.remove<Speed>(e);
+  buffer.playback(registry);
+
+  assert(!registry.all_of<Speed>(e));
+  std::cout << "✓ Emplace then remove test passed" << std::endl;
+}
+
+void testInterleavedEntitiesKeepTheirOwnOrder() {
+  std::cout << "Testing interleaved commands for several entities..."
+            << std::endl;
+  entt::registry registry;
+  std::vector<entt::entity> entities(4);
+  registry.create(entities.begin(), entities.end());
+  for (entt::entity e : entities) {
+    registry.emplace<Speed>(e, 1.0f);
+  }
+
+  // 0: remove; 1: remove, emplace; 2: emplace, remove; 3: remove, emplace,
+  // remove. Removes of different entities sit in the same run.
+  EcsCommandBuffer buffer;
+  buffer.remove<Speed>(entities[0]);
+  buffer.remove<Speed>(entities[1]);
+  buffer.remove<Speed>(entities[3]);
+  buffer.emplace<Speed>(entities[1], 5.0f);
+  buffer.emplace<Speed>(entities[3], 6.0f);
+  buffer.emplace<Speed>(entities[2], 7.0f);
+  buffer.emplace<Tag>(entities[2], 1);
+  buffer.remove<Speed>(entities[2]);
+  buffer.remove<Speed>(entities[3]);
+  buffer.playback(registry);
+
+  assert(!registry.all_of<Speed>(entities[0]));
+  assert(registry.get<Speed>(entities[1]).value == 5.0f);
+  assert(!registry.all_of<Speed>(entities[2]));
+  assert(registry.get<Tag>(entities[2]).value == 1);
+  assert(!registry.all_of<Speed>(entities[3]));
+  std::cout << "✓ Interleaved commands test passed" << std::endl;
+}
+
+void testDestroyDropsRecordedComponents() {
+  std::cout << "Testing destroy after emplace..." << std::endl;
+  entt::registry registry;
+  const entt::entity e = registry.create();
+
+  EcsCommandBuffer buffer;
+  buffer.emplace<Tag>(e, 3);
+  buffer.destroy(e);
+  buffer.destroy(e); // duplicates are dropped
+  buffer.playback(registry);
+
+  assert(!registry.valid(e));
+  assert(registry.storage<Tag>().empty());
+  std::cout << "✓ Destroy test passed" << std::endl;
+}
+
+void testPendingEntitiesResolveAtPlayback() {
+  std::cout << "Testing pending entities..." << std::endl;
+  entt::registry registry;
+
+  EcsCommandBuffer buffer;
+  const PendingEntity first = buffer.create();
+  const PendingEntity second = buffer.create();
+  buffer.emplace<Tag>(second, 2);
+  buffer.emplace<Tag>(first, 1);
+  buffer.emplace<Speed>(first, 4.0f);
+  buffer.remove<Speed>(first);
+  assert(!buffer.empty());
+  buffer.playback(registry);
+
+  assert(buffer.empty());
+  int tagSum = 0;
+  std::size_t tagged = 0;
+  for (auto [entity, tag] : registry.view<const Tag>().each()) {
+    tagSum += tag.value;
+    ++tagged;
+  }
+  assert(tagged == 2 && tagSum == 3);
+  assert(registry.storage<Speed>().empty());
+  std::cout << "✓ Pending entities test passed" << std::endl;
+}
+
+void testStaleEntitiesAreSkipped() {
+  std::cout << "Testing commands for destroyed entities..." << std::endl;
+  entt::registry registry;
+  const entt::entity e = registry.create();
+  registry.destroy(e);
+
+  EcsCommandBuffer buffer;
+  buffer.emplace<Tag>(e, 1);
+  buffer.remove<Speed>(e);
+  buffer.destroy(e);
+  buffer.playback(registry);
+
+  assert(registry.storage<Tag>().empty());
+  std::cout << "✓ Stale entities test passed" << std::endl;
+}
+
+void testQueuePlaysBackEveryThread() {
+  std::cout << "Testing the per-thread queue..." << std::endl;
+  entt::registry registry;
+  std::vector<entt::entity> entities(64);
+  registry.create(entities.begin(), entities.end());
+
+  EcsCommandQueue commands;
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (std::size_t i = t; i < entities.size(); i += 4) {
+        commands.emplace<Tag>(entities[i], static_cast<int>(i));
+        if (i % 2 == 0) {
+          commands.remove<Tag>(entities[i]);
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  assert(commands.pending() == entities.size() * 3 / 2);
+  commands.playback(registry);
+
+  assert(commands.pending() == 0);
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    assert(registry.all_of<Tag>(entities[i]) == (i % 2 == 1));
+  }
+  std::cout << "✓ Per-thread queue test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== ECS Command Buffer Tests ===" << std::endl;
+
+  testRemoveThenEmplaceKeepsComponent();
+  testEmplaceThenRemoveDropsComponent();
+  testInterleavedEntitiesKeepTheirOwnOrder();
+  testDestroyDropsRecordedComponents();
+  testPendingEntitiesResolveAtPlayback();
+  testStaleEntitiesAreSkipped();
+  testQueuePlaysBackEveryThread();
+
+  std::cout << "\n🎉 All ECS command buffer tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "voxelgrid/EntitySpatialIndex.hpp"
+
+/**
+ * EntitySpatialIndex tests
+ *
+ * insert moves an id that is already indexed, erase only removes an id
+ * still at the given position, and negative ids are ignored. Negative
+ * coordinates get their own cells. Box, radius and nearest queries must
+ * agree with a scan of a plain list through random moves and removals,
+ * with nearest results ordered by distance and then by id.
+ */
+
+namespace {
+
+using Entry = EntitySpatialIndex::Entry;
+
+std::vector<int> sorted(std::vector<int> ids) {
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+int64_t distance2(const Entry &e, int x, int y, int z) {
+  const int64_t dx = e.x - x, dy = e.y - y, dz = e.z - z;
+  return dx * dx + dy * dy + dz * dz;
+}
+
+std::vector<int> boxIds(const EntitySpatialIndex &index, int xMin, int yMin,
+                        int zMin, int xMax, int yMax, int zMax) {
+  std::vector<int> ids;
+  index.forEachInBox(xMin, yMin, zMin, xMax, yMax, zMax,
+                     [&](const Entry &e) { ids.push_back(e.id); });
+  return sorted(ids);
+}
+
+void testInsertMovesAndErase() {
+  std::cout << "Testing insert and erase..." << std::endl;
+  EntitySpatialIndex index;
+  index.insert(1, 0, 0, 0);
+  index.insert(2, 1, 0, 0);
+  index.insert(-1, 0, 0, 0); // an empty grid cell, not an entity
+  assert(index.size() == 2);
+  assert(!index.contains(-1));
+
+  // Within its cell, then into another one.
+  index.insert(1, 3, 3, 3);
+  index.insert(1, 20, 0, 0);
+  assert(index.size() == 2);
+  assert((index.inRadius(20, 0, 0, 0.f) == std::vector<int>{1}));
+  assert(index.inRadius(3, 3, 3, 1.f).empty());
+
+  // A stale position leaves the entity where it is.
+  assert(!index.erase(1, 3, 3, 3));
+  assert(!index.erase(7, 0, 0, 0));
+  assert(index.contains(1));
+  assert(index.erase(1, 20, 0, 0));
+  assert(!index.contains(1) && index.size() == 1);
+  assert(!index.erase(1, 20, 0, 0));
+
+  index.clear();
+  assert(index.size() == 0 && index.inRadius(1, 0, 0, 5.f).empty());
+  std::cout << "✓ Insert and erase test passed" << std::endl;
+}
+
+void testNegativeCoordinates() {
+  std::cout << "Testing negative coordinates..." << std::endl;
+  EntitySpatialIndex index(4);
+  index.insert(1, -1, -1, -1);
+  index.insert(2, 0, 0, 0);
+  index.insert(3, -4, 0, 0);
+  index.insert(4, -5, 0, 0);
+
+  assert((boxIds(index, -1, -1, -1, -1, -1, -1) == std::vector<int>{1}));
+  assert((boxIds(index, -4, 0, 0, -1, 0, 0) == std::vector<int>{3}));
+  assert((boxIds(index, -5, -1, -1, 0, 0, 0) ==
+          std::vector<int>{1, 2, 3, 4}));
+  assert((sorted(index.inRadius(-3, 0, 0, 2.f)) ==
+          std::vector<int>{3, 4}));
+  assert(index.erase(4, -5, 0, 0));
+  assert((index.nearest(-9, 0, 0, 1, 100.f) == std::vector<int>{3}));
+  std::cout << "✓ Negative coordinates test passed" << std::endl;
+}
+
+void testRadiusIsInclusive() {
+  std::cout << "Testing the radius bound..." << std::endl;
+  EntitySpatialIndex index;
+  index.insert(1, 3, 4, 0);  // distance 5
+  index.insert(2, 5, 1, 0);  // distance sqrt(26)
+  index.insert(3, 0, 0, -2); // distance 2
+  assert((sorted(index.inRadius(0, 0, 0, 5.f)) == std::vector<int>{1, 3}));
+  assert((sorted(index.inRadius(0, 0, 0, 5.1f)) ==
+          std::vector<int>{1, 2, 3}));
+  assert(index.inRadius(0, 0, 0, 1.9f).empty());
+  assert(index.inRadius(0, 0, 0, -1.f).empty());
+  std::cout << "✓ Radius test passed" << std::endl;
+}
+
+void testNearestOrder() {
+  std::cout << "Testing nearest..." << std::endl;
+  EntitySpatialIndex index;
+  index.insert(9, 2, 0, 0);
+  index.insert(4, 0, 2, 0);  // ties with 9: the lower id goes first
+  index.insert(7, 1, 0, 0);
+  index.insert(5, 40, 0, 0); // several cells out
+  index.insert(6, 0, 0, 3);
+
+  assert((index.nearest(0, 0, 0, 3, 100.f) == std::vector<int>{7, 4, 9}));
+  assert((index.nearest(0, 0, 0, 10, 100.f) ==
+          std::vector<int>{7, 4, 9, 6, 5}));
+  assert((index.nearest(0, 0, 0, 10, 2.f) == std::vector<int>{7, 4, 9}));
+  assert((index.nearest(45, 0, 0, 1, 10.f) == std::vector<int>{5}));
+  assert(index.nearest(100, 100, 100, 1, 10.f).empty());
+  assert(index.nearest(0, 0, 0, 0, 100.f).empty());
+  assert(index.nearest(0, 0, 0, 2, -1.f).empty());
+  std::cout << "✓ Nearest test passed" << std::endl;
+}
+
+void testChurnMatchesScan() {
+  std::cout << "Testing random churn against a scan..." << std::endl;
+  constexpr int kSide = 96, kDepth = 12;
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<int> coordXY(-kSide / 2, kSide / 2);
+  std::uniform_int_distribution<int> coordZ(-kDepth / 2, kDepth / 2);
+  auto randomEntry = [&](int id) {
+    return Entry{id, coordXY(gen), coordXY(gen), coordZ(gen)};
+  };
+
+  EntitySpatialIndex index(6);
+  std::vector<Entry> placed;
+  for (int id = 0; id < 1500; ++id) {
+    placed.push_back(randomEntry(id));
+    index.insert(id, placed.back().x, placed.back().y, placed.back().z);
+  }
+  int nextId = 1500;
+
+  for (int round = 0; round < 30; ++round) {
+    for (int edit = 0; edit < 60; ++edit) {
+      const std::size_t slot = gen() % placed.size();
+      Entry &e = placed[slot];
+      switch (gen() % 3) {
+      case 0: // a move
+        e = randomEntry(e.id);
+        index.insert(e.id, e.x, e.y, e.z);
+        break;
+      case 1: // a removal
+        assert(index.erase(e.id, e.x, e.y, e.z));
+        e = placed.back();
+        placed.pop_back();
+        break;
+      default: // a birth
+        placed.push_back(randomEntry(nextId++));
+        index.insert(placed.back().id, placed.back().x, placed.back().y,
+                     placed.back().z);
+        break;
+      }
+    }
+    assert(index.size() == placed.size());
+
+    const Entry q = randomEntry(-1);
+    const float radius = static_cast<float>(gen() % 200) / 10.f;
+    const int64_t limit =
+        static_cast<int64_t>(static_cast<double>(radius) * radius);
+    std::vector<int> inRadius;
+    std::vector<std::pair<int64_t, int>> byDistance;
+    for (const Entry &e : placed) {
+      const int64_t d2 = distance2(e, q.x, q.y, q.z);
+      if (d2 <= limit) {
+        inRadius.push_back(e.id);
+      }
+      byDistance.push_back({d2, e.id});
+    }
+    assert(sorted(index.inRadius(q.x, q.y, q.z, radius)) ==
+           sorted(inRadius));
+
+    std::sort(byDistance.begin(), byDistance.end());
+    const std::size_t k = 1 + gen() % 12;
+    std::vector<int> nearest;
+    for (std::size_t i = 0; i < k && i < byDistance.size(); ++i) {
+      nearest.push_back(byDistance[i].second);
+    }
+    assert(index.nearest(q.x, q.y, q.z, k, 1000.f) == nearest);
+
+    std::vector<int> inBox;
+    for (const Entry &e : placed) {
+      if (e.x >= q.x - 7 && e.x <= q.x + 7 && e.y >= q.y && e.y <= q.y + 9 &&
+          e.z >= q.z - 1 && e.z <= q.z + 2) {
+        inBox.push_back(e.id);
+      }
+    }
+    assert(boxIds(index, q.x - 7, q.y, q.z - 1, q.x + 7, q.y + 9, q.z + 2) ==
+           sorted(inBox));
+  }
+  std::cout << "✓ Churn test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Entity Spatial Index Tests ===" << std::endl;
+
+  testInsertMovesAndErase();
+  testNegativeCoordinates();
+  testRadiusIsInclusive();
+  testNearestOrder();
+  testChurnMatchesScan();
+
+  std::cout << "\n🎉 All entity spatial index tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,155 @@
+#include <cassert>
+#include <iostream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "ComponentStorage.hpp"
+#include "components/EntityTypeComponent.hpp"
+#include "components/ItemsComponents.hpp"
+#include "components/PhysicsComponents.hpp"
+#include "components/TerrainComponents.hpp"
+
+/**
+ * SparseComponentStorage tests
+ *
+ * Uses a cut-down component list with the same 64-byte arena as
+ * EntityInterface: a terrain voxel's entity type, position and matter
+ * container stay inline, while components with vectors or that no longer
+ * fit go to the spilled tuple. Unset components read as value-initialised,
+ * references survive later additions, and copies and moves keep (or, for
+ * the moved-from side, drop) every component.
+ */
+
+namespace {
+
+using Components =
+    std::tuple<EntityTypeComponent, PhysicsStats, Position, Velocity,
+               Inventory, MatterContainer, TileEffectsList>;
+using Storage = SparseComponentStorage<64, Components>;
+
+Storage terrainVoxel() {
+  Storage s;
+  s.set(EntityTypeComponent{0, 3, 0});
+  s.set(Position{4, 5, 6, DirectionEnum::UP});
+  s.set(MatterContainer{7, 0, 8, 0});
+  return s;
+}
+
+void testUnsetComponentsReadAsEmpty() {
+  std::cout << "Testing unset components..." << std::endl;
+  const Storage s;
+  assert(s.get<Position>().x == 0 && s.get<Position>().z == 0);
+  assert(s.get<Inventory>().itemIDs.empty());
+  // Reading through a const storage does not make room.
+  assert(s.inlineBytesUsed() == 0);
+  assert(!s.spilled());
+  std::cout << "✓ Unset components test passed" << std::endl;
+}
+
+void testTerrainVoxelStaysInline() {
+  std::cout << "Testing a terrain voxel..." << std::endl;
+  Storage s = terrainVoxel();
+  assert(!s.spilled());
+  assert(s.inlineBytesUsed() == sizeof(EntityTypeComponent) +
+                                    sizeof(Position) +
+                                    sizeof(MatterContainer));
+  assert(s.get<EntityTypeComponent>().subType0 == 3);
+  assert(s.get<Position>().y == 5);
+  assert(s.get<Position>().direction == DirectionEnum::UP);
+  assert(s.get<MatterContainer>().WaterMatter == 8);
+  std::cout << "✓ Terrain voxel test passed" << std::endl;
+}
+
+void testSpillsWhatDoesNotFitInline() {
+  std::cout << "Testing spilled components..." << std::endl;
+  Storage s = terrainVoxel();
+  TileEffectsList effects;
+  effects.addEffect(11);
+  s.set(effects); // has vectors: never inline
+  assert(s.spilled());
+  const std::size_t used = s.inlineBytesUsed();
+
+  // Trivially copyable, but 28 bytes no longer fit next to the voxel's 44.
+  s.set(PhysicsStats{1.0f, 2.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+  assert(s.inlineBytesUsed() == used);
+  assert(s.get<PhysicsStats>().maxSpeed == 2.0f);
+  assert(s.get<TileEffectsList>().tileEffectsIDs == std::vector<int>{11});
+
+  // A small one still fits in what is left of the arena.
+  s.set(Velocity{1.0f, 0.0f, 0.0f});
+  assert(s.inlineBytesUsed() == used + sizeof(Velocity));
+  assert(s.get<Velocity>().vx == 1.0f);
+  std::cout << "✓ Spilled components test passed" << std::endl;
+}
+
+void testReferencesSurviveLaterComponents() {
+  std::cout << "Testing references..." << std::endl;
+  Storage s = terrainVoxel();
+  const Position *position = &s.get<Position>();
+  Inventory inventory;
+  inventory.itemIDs = {4, 5};
+  s.set(inventory);
+  const Inventory *held = &s.get<Inventory>();
+  s.set(PhysicsStats{});
+  s.set(Velocity{});
+  s.set(TileEffectsList{});
+
+  assert(position == &s.get<Position>());
+  assert(held == &s.get<Inventory>());
+  assert(position->x == 4);
+  assert((held->itemIDs == std::vector<int>{4, 5}));
+  std::cout << "✓ References test passed" << std::endl;
+}
+
+void testCopiesAndMovesKeepComponents() {
+  std::cout << "Testing copies and moves..." << std::endl;
+  Storage rich = terrainVoxel();
+  Inventory inventory;
+  inventory.itemIDs = {4, 5};
+  rich.set(inventory);
+
+  Storage copy = rich;
+  assert(copy.spilled());
+  assert(copy.get<Position>().z == 6);
+  assert((copy.get<Inventory>().itemIDs == std::vector<int>{4, 5}));
+  // The copy owns its own tuple and arena.
+  copy.get<Inventory>().itemIDs.push_back(6);
+  copy.get<Position>().x = 40;
+  assert(rich.get<Inventory>().itemIDs.size() == 2);
+  assert(rich.get<Position>().x == 4);
+
+  Storage moved = std::move(copy);
+  assert(moved.get<Position>().x == 40);
+  assert(moved.get<Inventory>().itemIDs.size() == 3);
+  assert(!copy.spilled() && copy.inlineBytesUsed() == 0);
+
+  Storage assigned;
+  assigned = rich;
+  assert(assigned.get<MatterContainer>().TerrainMatter == 7);
+  assert(assigned.get<Inventory>().itemIDs.size() == 2);
+  assigned = std::move(moved);
+  assert(assigned.get<Position>().x == 40);
+  assert(assigned.get<Inventory>().itemIDs.size() == 3);
+
+  Storage &self = assigned;
+  assigned = self;
+  assert(assigned.get<Position>().x == 40);
+  assert(assigned.get<Inventory>().itemIDs.size() == 3);
+  std::cout << "✓ Copies and moves test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Entity Storage Tests ===" << std::endl;
+
+  testUnsetComponentsReadAsEmpty();
+  testTerrainVoxelStaysInline();
+  testSpillsWhatDoesNotFitInline();
+  testReferencesSurviveLaterComponents();
+  testCopiesAndMovesKeepComponents();
+
+  std::cout << "\n🎉 All entity storage tests passed!" << std::endl;
+  return 0;
+}
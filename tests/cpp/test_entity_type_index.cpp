@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "EntityTypeIndex.hpp"
+#include "components/EntityTypeComponent.hpp"
+
+/**
+ * EntityTypeIndex tests
+ *
+ * The index must pick up the types already in the registry on connect(),
+ * follow emplace, replace, patch, remove and destroy through the registry
+ * signals, file a recycled entity id under its new type only, and stop
+ * following once disconnected. A random churn then checks every type
+ * against a scan of the registry.
+ */
+
+namespace {
+
+bool holds(const EntityTypeIndex &index, int mainType, int subType0,
+           entt::entity entity) {
+  return index.entities(mainType, subType0).contains(entity);
+}
+
+std::vector<entt::entity> sorted(const entt::sparse_set &set) {
+  std::vector<entt::entity> out(set.begin(), set.end());
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+void testConnectIndexesExistingTypes() {
+  std::cout << "Testing connect..." << std::endl;
+  entt::registry registry;
+  const entt::entity rock = registry.create();
+  const entt::entity fern = registry.create();
+  const entt::entity untyped = registry.create();
+  registry.emplace<EntityTypeComponent>(rock, 0, 3, 0);
+  registry.emplace<EntityTypeComponent>(fern, 1, 2, 0);
+
+  EntityTypeIndex index;
+  index.connect(registry);
+  assert(index.size() == 2);
+  assert(index.count(0, 3) == 1 && holds(index, 0, 3, rock));
+  assert(index.count(1, 2) == 1 && holds(index, 1, 2, fern));
+  assert(!holds(index, 0, 3, untyped));
+  // Unknown types read as empty without being created.
+  assert(index.entities(2, 7).empty());
+  index.disconnect(registry);
+  std::cout << "✓ Connect test passed" << std::endl;
+}
+
+void testSignalsKeepIndexCurrent() {
+  std::cout << "Testing emplace, replace, patch, remove and destroy..."
+            << std::endl;
+  entt::registry registry;
+  EntityTypeIndex index;
+  index.connect(registry);
+
+  const entt::entity a = registry.create();
+  const entt::entity b = registry.create();
+  registry.emplace<EntityTypeComponent>(a, 2, 1, 0);
+  registry.emplace<EntityTypeComponent>(b, 2, 1, 0);
+  assert(index.count(2, 1) == 2);
+
+  registry.replace<EntityTypeComponent>(a, 2, 4, 0);
+  assert(index.count(2, 1) == 1 && holds(index, 2, 4, a));
+
+  registry.patch<EntityTypeComponent>(
+      b, [](EntityTypeComponent &type) { type.mainType = 1; });
+  assert(index.count(2, 1) == 0 && holds(index, 1, 1, b));
+
+  // subType1 is not part of the key: the entity stays where it is.
+  registry.patch<EntityTypeComponent>(
+      b, [](EntityTypeComponent &type) { type.subType1 = 9; });
+  assert(index.size() == 2 && holds(index, 1, 1, b));
+
+  registry.remove<EntityTypeComponent>(a);
+  assert(index.count(2, 4) == 0 && index.size() == 1);
+  registry.destroy(b);
+  assert(index.count(1, 1) == 0 && index.size() == 0);
+  index.disconnect(registry);
+  std::cout << "✓ Signals test passed" << std::endl;
+}
+
+void testRecycledIdTakesNewType() {
+  std::cout << "Testing recycled entity ids..." << std::endl;
+  entt::registry registry;
+  EntityTypeIndex index;
+  index.connect(registry);
+
+  const entt::entity old = registry.create();
+  registry.emplace<EntityTypeComponent>(old, 2, 5, 0);
+  registry.destroy(old);
+  const entt::entity reborn = registry.create();
+  assert(entt::to_entity(reborn) == entt::to_entity(old));
+  registry.emplace<EntityTypeComponent>(reborn, 0, 1, 0);
+
+  assert(index.size() == 1);
+  assert(index.count(2, 5) == 0);
+  assert(holds(index, 0, 1, reborn));
+  index.disconnect(registry);
+  std::cout << "✓ Recycled id test passed" << std::endl;
+}
+
+void testDisconnectStopsFollowing() {
+  std::cout << "Testing disconnect..." << std::endl;
+  entt::registry registry;
+  EntityTypeIndex index;
+  index.connect(registry);
+  const entt::entity e = registry.create();
+  registry.emplace<EntityTypeComponent>(e, 0, 0, 0);
+  index.disconnect(registry);
+
+  registry.replace<EntityTypeComponent>(e, 1, 1, 0);
+  registry.emplace<EntityTypeComponent>(registry.create(), 1, 1, 0);
+  assert(index.size() == 1);
+  assert(holds(index, 0, 0, e));
+  assert(index.count(1, 1) == 0);
+  std::cout << "✓ Disconnect test passed" << std::endl;
+}
+
+void testChurnMatchesScan() {
+  std::cout << "Testing random churn against a registry scan..."
+            << std::endl;
+  constexpr int kMainTypes = 3, kSubTypes = 4;
+  entt::registry registry;
+  std::mt19937 gen(7);
+  auto randomType = [&] {
+    return EntityTypeComponent{static_cast<int>(gen() % kMainTypes),
+                               static_cast<int>(gen() % kSubTypes), 0};
+  };
+  std::vector<entt::entity> live;
+  for (int i = 0; i < 500; ++i) {
+    const entt::entity e = registry.create();
+    registry.emplace<EntityTypeComponent>(e, randomType());
+    live.push_back(e);
+  }
+
+  EntityTypeIndex index;
+  index.connect(registry);
+  for (int round = 0; round < 20; ++round) {
+    for (int edit = 0; edit < 50 && !live.empty(); ++edit) {
+      const std::size_t slot = gen() % live.size();
+      switch (gen() % 4) {
+      case 0:
+        registry.destroy(live[slot]);
+        live[slot] = live.back();
+        live.pop_back();
+        break;
+      case 1: {
+        const entt::entity e = registry.create();
+        registry.emplace<EntityTypeComponent>(e, randomType());
+        live.push_back(e);
+        break;
+      }
+      case 2:
+        registry.replace<EntityTypeComponent>(live[slot], randomType());
+        break;
+      default:
+        registry.patch<EntityTypeComponent>(
+            live[slot], [&](EntityTypeComponent &type) {
+              type.subType0 = static_cast<int>(gen() % kSubTypes);
+            });
+        break;
+      }
+    }
+
+    for (int mainType = 0; mainType < kMainTypes; ++mainType) {
+      for (int subType0 = 0; subType0 < kSubTypes; ++subType0) {
+        std::vector<entt::entity> expected;
+        for (auto [e, type] : registry.view<EntityTypeComponent>().each()) {
+          if (type.mainType == mainType && type.subType0 == subType0) {
+            expected.push_back(e);
+          }
+        }
+        std::sort(expected.begin(), expected.end());
+        assert(sorted(index.entities(mainType, subType0)) == expected);
+      }
+    }
+    assert(index.size() == live.size());
+  }
+  index.disconnect(registry);
+  std::cout << "✓ Churn test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Entity Type Index Tests ===" << std::endl;
+
+  testConnectIndexesExistingTypes();
+  testSignalsKeepIndexCurrent();
+  testRecycledIdTakesNewType();
+  testDisconnectStopsFollowing();
+  testChurnMatchesScan();
+
+  std::cout << "\n🎉 All entity type index tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,283 @@
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "components/TerrainComponents.hpp"
+#include "physics/GravitySleep.hpp"
+#include "terrain/TerrainStorage.hpp"
+#include "terrain/VoxelChangeLog.hpp"
+
+/**
+ * GravitySleep tests
+ *
+ * The first cases drive GravitySleep directly: sleeping is idempotent, a
+ * changed voxel wakes the sleepers in it and in the voxel above, and
+ * wakeAll empties it. Once connected, a Position emplaced or replaced
+ * wakes its entity on the next wakeRepositioned. The last ones wake it
+ * from a TerrainStorage change log, as the gravity pass does, and check
+ * that no entity that could fall is left asleep while the floor under it
+ * is dug, flooded and refilled.
+ */
+
+namespace {
+
+struct Resting {
+  entt::entity entity;
+  VoxelCoord at;
+};
+
+void setFloor(TerrainStorage &storage, int x, int y, TerrainEnum type) {
+  storage.setTerrainId(x, y, 0,
+                       static_cast<int>(TerrainIdTypeEnum::ON_GRID_STORAGE));
+  storage.setTerrainSubType0(x, y, 0, static_cast<int>(type));
+}
+
+void buildFloor(TerrainStorage &storage, int side) {
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      setFloor(storage, x, y, TerrainEnum::GRASS);
+    }
+  }
+}
+
+// The checkIfCanFall test: no terrain below, or water below.
+bool canFall(const TerrainStorage &storage, const VoxelCoord &at) {
+  if (!storage.checkIfTerrainExists(at.x, at.y, at.z - 1)) {
+    return true;
+  }
+  return storage.getTerrainSubType0(at.x, at.y, at.z - 1) ==
+         static_cast<int>(TerrainEnum::WATER);
+}
+
+// Wakes what the change log recorded since the last drain.
+void wakeFromLog(VoxelChangeLog &log, GravitySleep &sleep) {
+  std::vector<VoxelCoord> changes;
+  if (log.drain(changes)) {
+    sleep.wakeAll();
+    return;
+  }
+  for (const VoxelCoord &c : changes) {
+    sleep.wakeAround(c);
+  }
+}
+
+std::vector<Resting> restOnFloor(entt::registry &registry, int side) {
+  std::vector<Resting> resting;
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      resting.push_back({registry.create(), VoxelCoord{x, y, 1}});
+    }
+  }
+  return resting;
+}
+
+void testSleepIsIdempotent() {
+  std::cout << "Testing sleep and asleep..." << std::endl;
+  entt::registry registry;
+  const entt::entity a = registry.create();
+  const entt::entity b = registry.create();
+
+  GravitySleep sleep;
+  sleep.sleep(a, VoxelCoord{1, 2, 3});
+  sleep.sleep(a, VoxelCoord{4, 5, 6}); // already asleep: stays at (1, 2, 3)
+
+  assert(sleep.asleep(a));
+  assert(!sleep.asleep(b));
+  assert(sleep.size() == 1);
+  assert(sleep.wakeAround(VoxelCoord{4, 5, 6}) == 0);
+  assert(sleep.wakeAround(VoxelCoord{1, 2, 3}) == 1);
+  assert(!sleep.asleep(a));
+  std::cout << "✓ Sleep test passed" << std::endl;
+}
+
+void testWakeAroundWakesCellAndCellAbove() {
+  std::cout << "Testing wakeAround..." << std::endl;
+  entt::registry registry;
+  const entt::entity own = registry.create();
+  const entt::entity above = registry.create();
+  const entt::entity twoAbove = registry.create();
+  const entt::entity below = registry.create();
+  const entt::entity beside = registry.create();
+
+  GravitySleep sleep;
+  sleep.sleep(own, VoxelCoord{0, 0, 1});
+  sleep.sleep(above, VoxelCoord{0, 0, 2});
+  sleep.sleep(twoAbove, VoxelCoord{0, 0, 3});
+  sleep.sleep(below, VoxelCoord{0, 0, 0});
+  sleep.sleep(beside, VoxelCoord{1, 0, 1});
+
+  assert(sleep.wakeAround(VoxelCoord{0, 0, 1}) == 2);
+  assert(!sleep.asleep(own));
+  assert(!sleep.asleep(above));
+  assert(sleep.asleep(twoAbove));
+  assert(sleep.asleep(below));
+  assert(sleep.asleep(beside));
+  assert(sleep.size() == 3);
+
+  // Nothing is left to wake there until someone sleeps in it again.
+  assert(sleep.wakeAround(VoxelCoord{0, 0, 1}) == 0);
+  sleep.sleep(own, VoxelCoord{0, 0, 1});
+  assert(sleep.wakeAround(VoxelCoord{0, 0, 0}) == 2);
+  assert(!sleep.asleep(own));
+  assert(!sleep.asleep(below));
+  std::cout << "✓ wakeAround test passed" << std::endl;
+}
+
+void testWakeAllEmptiesIt() {
+  std::cout << "Testing wakeAll..." << std::endl;
+  entt::registry registry;
+  std::vector<entt::entity> entities(8);
+  registry.create(entities.begin(), entities.end());
+
+  GravitySleep sleep;
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    sleep.sleep(entities[i], VoxelCoord{static_cast<int>(i), 0, 1});
+  }
+  assert(sleep.wakeAll() == entities.size());
+  assert(sleep.size() == 0);
+  for (entt::entity e : entities) {
+    assert(!sleep.asleep(e));
+  }
+  assert(sleep.wakeAround(VoxelCoord{0, 0, 1}) == 0);
+  std::cout << "✓ wakeAll test passed" << std::endl;
+}
+
+void testPositionSignalsWakeEntities() {
+  std::cout << "Testing Position signals..." << std::endl;
+  entt::registry registry;
+  const entt::entity replaced = registry.create();
+  const entt::entity patched = registry.create();
+  const entt::entity untouched = registry.create();
+  for (entt::entity e : {replaced, patched, untouched}) {
+    registry.emplace<Position>(e, 1, 1, 1, DirectionEnum::UP);
+  }
+
+  GravitySleep sleep;
+  sleep.connect(registry);
+  for (entt::entity e : {replaced, patched, untouched}) {
+    sleep.sleep(e, VoxelCoord{1, 1, 1});
+  }
+  registry.replace<Position>(replaced, 5, 5, 9, DirectionEnum::UP);
+  registry.patch<Position>(patched, [](Position &p) { p.z = 7; });
+  assert(sleep.asleep(replaced)); // only queued so far
+  assert(sleep.wakeRepositioned() == 2);
+  assert(!sleep.asleep(replaced) && !sleep.asleep(patched));
+  assert(sleep.asleep(untouched));
+  assert(sleep.wakeRepositioned() == 0);
+
+  // An entity placed while asleep, e.g. one rested before its Position
+  // was emplaced, wakes too.
+  const entt::entity placed = registry.create();
+  sleep.sleep(placed, VoxelCoord{3, 3, 3});
+  registry.emplace<Position>(placed, 3, 3, 3, DirectionEnum::UP);
+  assert(sleep.wakeRepositioned() == 1);
+  assert(!sleep.asleep(placed));
+
+  // Disconnected: writes are no longer seen.
+  sleep.sleep(replaced, VoxelCoord{5, 5, 9});
+  sleep.disconnect(registry);
+  registry.replace<Position>(replaced, 6, 5, 9, DirectionEnum::UP);
+  assert(sleep.wakeRepositioned() == 0);
+  assert(sleep.asleep(replaced));
+  std::cout << "✓ Position signals test passed" << std::endl;
+}
+
+void testChangeLogWakesEntitiesOverEditedFloor() {
+  std::cout << "Testing waking from the change log..." << std::endl;
+  TerrainStorage storage;
+  storage.initialize();
+  VoxelChangeLog log;
+  storage.changeLog = &log;
+  buildFloor(storage, 3);
+
+  entt::registry registry;
+  const std::vector<Resting> resting = restOnFloor(registry, 3);
+  GravitySleep sleep;
+  wakeFromLog(log, sleep);
+  for (const Resting &e : resting) {
+    assert(!canFall(storage, e.at));
+    sleep.sleep(e.entity, e.at);
+  }
+
+  // Dig under (1, 1) and flood under (2, 0); everyone else stays asleep.
+  storage.deleteTerrain(1, 1, 0);
+  setFloor(storage, 2, 0, TerrainEnum::WATER);
+  wakeFromLog(log, sleep);
+  for (const Resting &e : resting) {
+    const bool edited = (e.at.x == 1 && e.at.y == 1) ||
+                        (e.at.x == 2 && e.at.y == 0);
+    assert(sleep.asleep(e.entity) == !edited);
+    assert(canFall(storage, e.at) == edited);
+  }
+
+  // A bulk rewrite collapses the log, which wakes everyone.
+  log.recordAll();
+  wakeFromLog(log, sleep);
+  assert(sleep.size() == 0);
+  std::cout << "✓ Change log test passed" << std::endl;
+}
+
+void testSleepingPassFindsEveryFaller() {
+  std::cout << "Testing the sleeping pass against checking everyone..."
+            << std::endl;
+  constexpr int kSide = 16;
+  TerrainStorage storage;
+  storage.initialize();
+  VoxelChangeLog log;
+  storage.changeLog = &log;
+  buildFloor(storage, kSide);
+
+  entt::registry registry;
+  const std::vector<Resting> resting = restOnFloor(registry, kSide);
+  GravitySleep sleep;
+  std::mt19937 gen(5);
+
+  for (int tick = 0; tick < 50; ++tick) {
+    for (int w = 0; w < 8; ++w) {
+      const int x = static_cast<int>(gen() % kSide);
+      const int y = static_cast<int>(gen() % kSide);
+      switch (gen() % 3) {
+      case 0:
+        storage.deleteTerrain(x, y, 0);
+        break;
+      case 1:
+        setFloor(storage, x, y, TerrainEnum::WATER);
+        break;
+      default:
+        setFloor(storage, x, y, TerrainEnum::GRASS);
+        break;
+      }
+    }
+
+    wakeFromLog(log, sleep);
+    for (const Resting &e : resting) {
+      const bool falls = canFall(storage, e.at);
+      // Every entity that could fall must be awake to be found.
+      assert(!falls || !sleep.asleep(e.entity));
+      if (!falls) {
+        sleep.sleep(e.entity, e.at);
+      }
+    }
+  }
+  std::cout << "✓ Sleeping pass test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Gravity Sleep Tests ===" << std::endl;
+
+  testSleepIsIdempotent();
+  testWakeAroundWakesCellAndCellAbove();
+  testWakeAllEmptiesIt();
+  testPositionSignalsWakeEntities();
+  testChangeLogWakesEntitiesOverEditedFloor();
+  testSleepingPassFindsEveryFaller();
+
+  std::cout << "\n🎉 All gravity sleep tests passed!" << std::endl;
+  return 0;
+}
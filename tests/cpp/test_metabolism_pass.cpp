@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "MetabolismPass.hpp"
+
+/**
+ * runMetabolismPass / cloneEntities tests
+ *
+ * Hand-built creatures check each rule on its own: starvation trades
+ * health for energy and reports the ones that die, only non-player beasts
+ * above the energy threshold breed, and digestion releases a chunk every
+ * chunkDigestionTime ticks until the item is gone. A population larger
+ * than one TBB grain checks the pass reports starved entities and parents
+ * in group order. cloneEntities must copy exactly the components each
+ * prototype has.
+ */
+
+namespace {
+
+constexpr int kBeast = static_cast<int>(EntityEnum::BEAST);
+constexpr int kPlant = static_cast<int>(EntityEnum::PLANT);
+
+entt::entity addCreature(entt::registry &registry, int mainType,
+                         int subType0, float energy) {
+  const entt::entity e = registry.create();
+  registry.emplace<EntityTypeComponent>(e, mainType, subType0, 0);
+  registry.emplace<MetabolismComponent>(e, energy, 200.f);
+  registry.emplace<DigestionComponent>(e, DigestionComponent{{}, 10.f});
+  return e;
+}
+
+bool near(double a, double b) { return std::abs(a - b) < 1e-4; }
+
+void testStarvationTradesHealthForEnergy() {
+  std::cout << "Testing starvation..." << std::endl;
+  entt::registry registry;
+  const MetabolismRules rules;
+  const entt::entity hungry = addCreature(registry, kBeast, 0, -5.f);
+  registry.emplace<HealthComponent>(hungry, 15.f, 100.f);
+  const entt::entity dying = addCreature(registry, kBeast, 0, -5.f);
+  registry.emplace<HealthComponent>(dying, 8.f, 100.f);
+  const entt::entity healthless = addCreature(registry, kPlant, 0, -5.f);
+
+  const MetabolismOutcome outcome =
+      runMetabolismPass(registry, rules, false);
+  assert(outcome.entities == 3);
+  assert((outcome.starved == std::vector<entt::entity>{dying}));
+  assert(registry.get<HealthComponent>(hungry).healthLevel == 5.f);
+  assert(registry.get<MetabolismComponent>(hungry).energyReserve == 5.f);
+  // Without health there is nothing to trade.
+  assert(registry.get<MetabolismComponent>(healthless).energyReserve == -5.f);
+
+  // Back above zero: no more damage.
+  runMetabolismPass(registry, rules, false);
+  assert(registry.get<HealthComponent>(hungry).healthLevel == 5.f);
+  std::cout << "✓ Starvation test passed" << std::endl;
+}
+
+void testOnlyNonPlayerBeastsBreed() {
+  std::cout << "Testing reproduction..." << std::endl;
+  entt::registry registry;
+  const MetabolismRules rules;
+  const entt::entity beast = addCreature(registry, kBeast, 0, 150.f);
+  const entt::entity player =
+      addCreature(registry, kBeast, rules.playerSubType, 150.f);
+  const entt::entity plant = addCreature(registry, kPlant, 0, 150.f);
+  const entt::entity thin = addCreature(registry, kBeast, 0, 90.f);
+
+  MetabolismOutcome outcome = runMetabolismPass(registry, rules, false);
+  assert(outcome.parents.empty());
+  assert(registry.get<MetabolismComponent>(beast).energyReserve == 150.f);
+
+  outcome = runMetabolismPass(registry, rules, true);
+  assert((outcome.parents == std::vector<entt::entity>{beast}));
+  assert(registry.get<MetabolismComponent>(beast).energyReserve ==
+         150.f - rules.reproduceCost);
+  assert(registry.get<MetabolismComponent>(player).energyReserve == 150.f);
+  assert(registry.get<MetabolismComponent>(plant).energyReserve == 150.f);
+  assert(registry.get<MetabolismComponent>(thin).energyReserve == 90.f);
+  std::cout << "✓ Reproduction test passed" << std::endl;
+}
+
+void testDigestionReleasesChunks() {
+  std::cout << "Testing digestion..." << std::endl;
+  entt::registry registry;
+  MetabolismRules rules;
+  rules.chunkDigestionTime = 3;
+  const entt::entity e = addCreature(registry, kBeast, 0, 0.f);
+  registry.emplace<HealthComponent>(e, 95.f, 100.f);
+  // 1.5 mass at 0.5 efficiency: three chunks of 0.5, each worth
+  // 0.5 * 4 = 2 energy and 2 * 2 = 4 health.
+  registry.get<DigestionComponent>(e).digestingItems.push_back(
+      DigestingFoodItem{7, 0, 0.f, 4.f, 1.5f, 1.f, 2.f, 0.5f});
+
+  auto &metabolism = registry.get<MetabolismComponent>(e);
+  auto &health = registry.get<HealthComponent>(e);
+  auto &items = registry.get<DigestionComponent>(e).digestingItems;
+  for (int tick = 1; tick <= 2; ++tick) {
+    runMetabolismPass(registry, rules, false);
+    assert(metabolism.energyReserve == 0.f);
+    assert(items[0].processingTime == tick);
+  }
+  runMetabolismPass(registry, rules, false);
+  assert(near(metabolism.energyReserve, 2.0));
+  assert(near(items[0].mass, 1.0));
+  assert(near(health.healthLevel, 99.0));
+
+  // Health is capped at maxHealth; the third chunk empties the item.
+  for (int tick = 0; tick < 6; ++tick) {
+    runMetabolismPass(registry, rules, false);
+  }
+  assert(near(metabolism.energyReserve, 6.0));
+  assert(health.healthLevel == 100.f);
+  assert(items.empty());
+  std::cout << "✓ Digestion test passed" << std::endl;
+}
+
+void testOutcomeFollowsGroupOrder() {
+  std::cout << "Testing a population over several TBB chunks..."
+            << std::endl;
+  entt::registry registry;
+  const MetabolismRules rules;
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<float> energy(-20.f, 160.f);
+  for (int i = 0; i < 3000; ++i) {
+    const entt::entity e = addCreature(
+        registry, gen() % 10 ? kBeast : kPlant, static_cast<int>(gen() % 3),
+        energy(gen));
+    if (gen() % 4) {
+      registry.emplace<HealthComponent>(e, 1.f + 20.f * (gen() % 3), 100.f);
+    }
+  }
+
+  // Expected outcome, worked out from the state before the pass.
+  std::vector<entt::entity> starved, parents;
+  auto group = metabolismGroup(registry);
+  for (entt::entity e : group) {
+    const auto &metabolism = group.get<MetabolismComponent>(e);
+    const auto &type = group.get<EntityTypeComponent>(e);
+    const auto *health = registry.try_get<HealthComponent>(e);
+    float reserve = metabolism.energyReserve;
+    if (reserve < 0 && health) {
+      if (health->healthLevel - rules.starvationDamage <= 0) {
+        starved.push_back(e);
+      }
+      reserve += rules.starvationRefund;
+    }
+    if (reserve > rules.reproduceAbove && type.mainType == kBeast &&
+        type.subType0 != rules.playerSubType) {
+      parents.push_back(e);
+    }
+  }
+  assert(!starved.empty() && !parents.empty());
+
+  const MetabolismOutcome outcome = runMetabolismPass(registry, rules, true);
+  assert(outcome.entities == 3000);
+  assert(outcome.starved == starved);
+  assert(outcome.parents == parents);
+  std::cout << "✓ Group order test passed" << std::endl;
+}
+
+void testCloneCopiesPresentComponents() {
+  std::cout << "Testing cloneEntities..." << std::endl;
+  entt::registry registry;
+  const entt::entity a = addCreature(registry, kBeast, 0, 50.f);
+  registry.emplace<HealthComponent>(a, 30.f, 100.f);
+  registry.emplace<Position>(a, 1, 2, 3, DirectionEnum::UP);
+  Inventory inventory{};
+  inventory.itemIDs = {4, 5};
+  registry.emplace<Inventory>(a, inventory);
+  registry.get<DigestionComponent>(a).digestingItems.push_back(
+      DigestingFoodItem{9, 1, 0.f, 1.f, 1.f, 1.f, 0.f, 1.f});
+  const entt::entity b = addCreature(registry, kPlant, 2, 20.f);
+
+  const std::vector<entt::entity> clones = cloneEntities(registry, {a, b, a});
+  assert(clones.size() == 3);
+  assert(clones[0] != a && clones[2] != a && clones[0] != clones[2]);
+
+  for (const entt::entity clone : {clones[0], clones[2]}) {
+    assert(registry.get<HealthComponent>(clone).healthLevel == 30.f);
+    assert(registry.get<Position>(clone).z == 3);
+    assert((registry.get<Inventory>(clone).itemIDs ==
+            std::vector<int>{4, 5}));
+    assert(registry.get<DigestionComponent>(clone).digestingItems.size() ==
+           1);
+    assert(registry.get<MetabolismComponent>(clone).energyReserve == 50.f);
+  }
+  assert(registry.get<EntityTypeComponent>(clones[1]).subType0 == 2);
+  assert(!registry.any_of<HealthComponent>(clones[1]));
+  assert(!registry.any_of<Position>(clones[1]));
+  assert(!registry.any_of<Inventory>(clones[1]));
+  assert(!registry.any_of<Velocity>(clones[0]));
+  std::cout << "✓ Clone test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Metabolism Pass Tests ===" << std::endl;
+
+  testStarvationTradesHealthForEnergy();
+  testOnlyNonPlayerBeastsBreed();
+  testDigestionReleasesChunks();
+  testOutcomeFollowsGroupOrder();
+  testCloneCopiesPresentComponents();
+
+  std::cout << "\n🎉 All metabolism pass tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "components/MovingComponent.hpp"
+#include "physics/MovementSchedule.hpp"
+
+/**
+ * MovementSchedule tests
+ *
+ * A move emplaced with timeRemaining T completes on the T-th advance(),
+ * the tick the old per-tick decrement would have completed it on, also
+ * when T is more than a lap of the wheel out. replace() reschedules,
+ * removal or destruction cancels, and a recycled entity id never fires
+ * for its older version. Moves scheduled from inside advance() land on a
+ * later tick. Under churn the schedule must complete the same entities
+ * on the same ticks as a scan of every MovingComponent.
+ */
+
+namespace {
+
+entt::entity startMove(entt::registry &registry, int ticks) {
+  MovingComponent mc{};
+  mc.isMoving = true;
+  mc.completionTime = ticks;
+  mc.timeRemaining = ticks;
+  const entt::entity e = registry.create();
+  registry.emplace<MovingComponent>(e, mc);
+  return e;
+}
+
+std::vector<entt::entity> advance(MovementSchedule &schedule) {
+  std::vector<entt::entity> done;
+  schedule.advance([&](entt::entity e) { done.push_back(e); });
+  return done;
+}
+
+// Ticks until `e` fires, or -1 if it does not within `limit`.
+int ticksUntilFired(MovementSchedule &schedule, entt::entity e, int limit) {
+  for (int t = 0; t < limit; ++t) {
+    const std::vector<entt::entity> done = advance(schedule);
+    if (std::find(done.begin(), done.end(), e) != done.end()) {
+      return t;
+    }
+  }
+  return -1;
+}
+
+void testDueTicks() {
+  std::cout << "Testing due ticks..." << std::endl;
+  constexpr int kLap = static_cast<int>(MovementSchedule::kSlots);
+  for (int ticks : {0, 1, 7, kLap - 1, kLap, kLap + 3, 2 * kLap + 44}) {
+    entt::registry registry;
+    MovementSchedule schedule;
+    schedule.connect(registry);
+    // Two moves sharing its slot, a lap either side.
+    const entt::entity e = startMove(registry, ticks);
+    startMove(registry, ticks + kLap);
+    if (ticks >= kLap) {
+      startMove(registry, ticks - kLap);
+    }
+    assert(schedule.scheduled(e) && schedule.ticksRemaining(e) == ticks);
+    assert(ticksUntilFired(schedule, e, 3 * kLap) == ticks);
+    assert(!schedule.scheduled(e) && schedule.ticksRemaining(e) == -1);
+    schedule.disconnect(registry);
+  }
+  std::cout << "✓ Due tick test passed" << std::endl;
+}
+
+void testSignalsKeepTheScheduleInStep() {
+  std::cout << "Testing registry signals..." << std::endl;
+  entt::registry registry;
+  // Moves already in flight are picked up by connect().
+  const entt::entity early = startMove(registry, 2);
+  MovementSchedule schedule;
+  schedule.connect(registry);
+  assert(schedule.size() == 1 && schedule.ticksRemaining(early) == 2);
+
+  const entt::entity moved = startMove(registry, 5);
+  const entt::entity removed = startMove(registry, 1);
+  const entt::entity destroyed = startMove(registry, 1);
+  assert(schedule.size() == 4);
+
+  registry.patch<MovingComponent>(
+      moved, [](MovingComponent &m) { m.timeRemaining = 3; });
+  registry.remove<MovingComponent>(removed);
+  registry.destroy(destroyed);
+  assert(schedule.size() == 2 && !schedule.scheduled(removed));
+
+  // The recycled id of `destroyed` does not inherit its move.
+  const entt::entity recycled = registry.create();
+  assert(entt::to_entity(recycled) == entt::to_entity(destroyed));
+  assert(!schedule.scheduled(recycled));
+
+  assert(advance(schedule).empty());
+  assert(advance(schedule).empty());
+  assert((advance(schedule) == std::vector<entt::entity>{early}));
+  assert((advance(schedule) == std::vector<entt::entity>{moved}));
+  assert(schedule.size() == 0 && schedule.currentTick() == 4);
+
+  // Writing timeRemaining in place bypasses the signals.
+  const entt::entity silent = startMove(registry, 1);
+  registry.get<MovingComponent>(silent).timeRemaining = 9;
+  assert(schedule.ticksRemaining(silent) == 1);
+  schedule.disconnect(registry);
+  startMove(registry, 1);
+  assert(schedule.size() == 1);
+  std::cout << "✓ Signals test passed" << std::endl;
+}
+
+void testRefreshTimeRemaining() {
+  std::cout << "Testing refreshTimeRemaining..." << std::endl;
+  entt::registry registry;
+  MovementSchedule schedule;
+  schedule.connect(registry);
+  const entt::entity e = startMove(registry, 6);
+  advance(schedule);
+  advance(schedule);
+
+  MovingComponent moving = registry.get<MovingComponent>(e);
+  assert(moving.timeRemaining == 6);
+  schedule.refreshTimeRemaining(e, moving);
+  assert(moving.timeRemaining == 4);
+  // Writing the refreshed value back keeps the move due on the same tick.
+  registry.replace<MovingComponent>(e, moving);
+  assert(ticksUntilFired(schedule, e, 10) == 4);
+
+  MovingComponent idle{};
+  idle.timeRemaining = 11;
+  schedule.refreshTimeRemaining(e, idle);
+  assert(idle.timeRemaining == 11);
+  schedule.disconnect(registry);
+  std::cout << "✓ Refresh test passed" << std::endl;
+}
+
+void testSchedulingFromAdvance() {
+  std::cout << "Testing schedule and cancel from advance()..." << std::endl;
+  MovementSchedule schedule;
+  entt::registry registry;
+  const entt::entity a = registry.create();
+  const entt::entity b = registry.create();
+  const entt::entity c = registry.create();
+  schedule.schedule(a, 0);
+  schedule.schedule(b, 0);
+  schedule.schedule(c, 0);
+
+  // The first to fire cancels the other two; due now means next tick.
+  std::vector<entt::entity> fired;
+  assert(schedule.advance([&](entt::entity e) {
+    fired.push_back(e);
+    for (entt::entity other : {a, b, c}) {
+      if (other != e) {
+        schedule.cancel(other);
+      }
+    }
+    schedule.schedule(e, 0);
+  }) == 1);
+  assert(fired.size() == 1 && schedule.size() == 1);
+  assert(schedule.ticksRemaining(fired.front()) == 0);
+  assert(advance(schedule) == fired);
+  assert(schedule.size() == 0);
+  std::cout << "✓ Advance callback test passed" << std::endl;
+}
+
+// Order-independent digest of (tick, entity) pairs.
+uint64_t digest(int tick, entt::entity e) {
+  uint64_t h = (static_cast<uint64_t>(tick) << 32) ^
+               static_cast<uint64_t>(entt::to_integral(e));
+  h *= 0x9e3779b97f4a7c15ULL;
+  return h ^ (h >> 29);
+}
+
+struct Churn {
+  uint64_t completed = 0;
+  uint64_t checksum = 0;
+};
+
+// Keeps `inFlight` moves of up to `maxTicks` running and replaces each one
+// that completes, with `tick` reporting the completions.
+template <typename TickFn>
+Churn churn(int ticks, int inFlight, int maxTicks, TickFn &&tick) {
+  entt::registry registry;
+  MovementSchedule schedule;
+  schedule.connect(registry);
+  std::mt19937 gen(99);
+  auto start = [&] {
+    startMove(registry, 1 + static_cast<int>(gen() % maxTicks));
+  };
+  for (int i = 0; i < inFlight; ++i) {
+    start();
+  }
+  Churn result;
+  std::vector<entt::entity> done;
+  for (int t = 0; t < ticks; ++t) {
+    done.clear();
+    tick(registry, schedule, done);
+    // Same refill order for both, whatever order they completed in.
+    std::sort(done.begin(), done.end());
+    for (entt::entity e : done) {
+      result.checksum += digest(t, e);
+      registry.destroy(e);
+      start();
+    }
+    result.completed += done.size();
+  }
+  schedule.disconnect(registry);
+  return result;
+}
+
+void testChurnMatchesScan() {
+  std::cout << "Testing churn against a per-tick scan..." << std::endl;
+  auto scanTick = [](entt::registry &registry, MovementSchedule &,
+                     std::vector<entt::entity> &done) {
+    for (auto [entity, moving] : registry.view<MovingComponent>().each()) {
+      if (moving.timeRemaining <= 0) {
+        done.push_back(entity);
+      } else {
+        moving.timeRemaining--;
+      }
+    }
+  };
+  auto scheduleTick = [](entt::registry &, MovementSchedule &schedule,
+                         std::vector<entt::entity> &done) {
+    schedule.advance([&](entt::entity e) { done.push_back(e); });
+  };
+  // 600 ticks is longer than the wheel, so later laps are exercised too.
+  for (int maxTicks : {8, 60, 600}) {
+    const Churn scan = churn(700, 3000, maxTicks, scanTick);
+    const Churn wheel = churn(700, 3000, maxTicks, scheduleTick);
+    assert(scan.completed > 0);
+    assert(scan.completed == wheel.completed);
+    assert(scan.checksum == wheel.checksum);
+  }
+  std::cout << "✓ Churn test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== MovementSchedule Tests ===" << std::endl;
+
+  testDueTicks();
+  testSignalsKeepTheScheduleInStep();
+  testRefreshTimeRemaining();
+  testSchedulingFromAdvance();
+  testChurnMatchesScan();
+
+  std::cout << "\n🎉 All MovementSchedule tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "MetabolismPass.hpp"
+#include "SimulationLod.hpp"
+
+/**
+ * SimulationLod tests
+ *
+ * Regions are levelled by their Chebyshev distance to the nearest
+ * observer, and only run every interval ticks away from it, staggered so
+ * a level's regions do not all run together; whenever a region runs, its
+ * ticksDue covers every tick since it last did. The metabolism pass must
+ * match the full pass with every interval at 1 and, with the default
+ * intervals, leave no creature more than one interval behind.
+ */
+
+namespace {
+
+constexpr int kMapSize = 256;
+
+// 5 x 5 regions of 16 voxels: Near within 1, Mid within 2, Far beyond.
+SimulationLodConfig smallConfig() {
+  SimulationLodConfig config;
+  config.nearRegions = 1;
+  config.midRegions = 2;
+  config.midInterval = 3;
+  config.farInterval = 5;
+  return config;
+}
+
+void testDisabledByDefault() {
+  std::cout << "Testing a disabled LOD..." << std::endl;
+  SimulationLod lod;
+  assert(!lod.enabled());
+  const SimulationLodStats stats = lod.beginTick({VoxelCoord{0, 0, 0}});
+  assert(stats.tick == 0);
+  assert(lod.snapshot() == nullptr);
+
+  lod.configure(80, 80, smallConfig());
+  lod.beginTick({});
+  assert(lod.snapshot() != nullptr);
+  lod.disable();
+  assert(!lod.enabled() && lod.snapshot() == nullptr);
+  std::cout << "✓ Disabled test passed" << std::endl;
+}
+
+void testConfigureClampsSettings() {
+  std::cout << "Testing configure..." << std::endl;
+  SimulationLod lod;
+  SimulationLodConfig config;
+  config.regionSize = 0;
+  config.nearRegions = -2;
+  config.midRegions = -1;
+  config.midInterval = 0;
+  config.farInterval = -4;
+  lod.configure(10, 10, config);
+  assert(lod.config().regionSize == 1);
+  assert(lod.config().nearRegions == 0);
+  assert(lod.config().midRegions == 0);
+  assert(lod.config().midInterval == 1);
+  assert(lod.config().farInterval == 1);
+  std::cout << "✓ Configure test passed" << std::endl;
+}
+
+void testLevelsFollowObserverDistance() {
+  std::cout << "Testing levels..." << std::endl;
+  SimulationLod lod;
+  lod.configure(80, 80, smallConfig());
+  // Off the map: clamped into the corner region (0, 4).
+  lod.beginTick({VoxelCoord{-5, 1000, 3}});
+  const auto map = lod.snapshot();
+
+  for (int ry = 0; ry < 5; ++ry) {
+    for (int rx = 0; rx < 5; ++rx) {
+      const int distance = std::max(rx, 4 - ry);
+      const LodLevel expected = distance <= 1   ? LodLevel::Near
+                                : distance <= 2 ? LodLevel::Mid
+                                                : LodLevel::Far;
+      assert(map->level(rx * 16 + 8, ry * 16 + 8) == expected);
+    }
+  }
+  // Positions off the map read the nearest edge region.
+  assert(map->level(-100, 2000) == LodLevel::Near);
+  assert(map->level(2000, -100) == LodLevel::Far);
+  assert(map->interval(LodLevel::Mid) == 3);
+
+  assert(map->nearestLevel(48, 0, 79, 31) == LodLevel::Far);
+  assert(map->nearestLevel(32, 48, 79, 79) == LodLevel::Mid);
+  assert(map->nearestLevel(0, 0, 79, 79) == LodLevel::Near);
+
+  // A second observer pulls the far corner in.
+  lod.beginTick({VoxelCoord{0, 79, 0}, VoxelCoord{79, 0, 0}});
+  assert(lod.snapshot()->level(79, 0) == LodLevel::Near);
+  assert(lod.snapshot()->level(40, 40) == LodLevel::Mid);
+  std::cout << "✓ Levels test passed" << std::endl;
+}
+
+void testSkippedRegionsCatchUp() {
+  std::cout << "Testing staggered regions and catch-up..." << std::endl;
+  SimulationLod lod;
+  lod.configure(80, 80, smallConfig());
+  const std::vector<VoxelCoord> observers = {VoxelCoord{0, 0, 0}};
+  constexpr int kTicks = 40;
+
+  std::vector<int> covered(25, 0);
+  bool staggered = false;
+  for (int t = 1; t <= kTicks; ++t) {
+    lod.beginTick(observers);
+    const auto map = lod.snapshot();
+    int farDue = 0, farRegions = 0;
+    for (int r = 0; r < 25; ++r) {
+      const int x = (r % 5) * 16, y = (r / 5) * 16;
+      const int due = map->ticksDue(x, y);
+      const int interval = map->interval(map->level(x, y));
+      if (map->level(x, y) == LodLevel::Near) {
+        assert(due == 1);
+      }
+      // A region that runs covers exactly the ticks it missed.
+      if (due != 0) {
+        assert(covered[r] + due == t);
+      }
+      assert(due <= interval);
+      covered[r] += due;
+      if (map->level(x, y) == LodLevel::Far) {
+        ++farRegions;
+        farDue += due != 0;
+      }
+    }
+    staggered |= farDue > 0 && farDue < farRegions;
+  }
+  assert(staggered);
+  for (int r = 0; r < 25; ++r) {
+    const int x = (r % 5) * 16, y = (r / 5) * 16;
+    const auto map = lod.snapshot();
+    assert(covered[r] > kTicks - map->interval(map->level(x, y)));
+  }
+  std::cout << "✓ Catch-up test passed" << std::endl;
+}
+
+void testStatsReportPreviousTick() {
+  std::cout << "Testing stats..." << std::endl;
+  SimulationLod lod;
+  lod.configure(80, 80, smallConfig());
+  lod.beginTick({VoxelCoord{0, 0, 0}});
+  LodTally tally;
+  tally.add(LodLevel::Near, true);
+  tally.add(LodLevel::Far, false);
+  tally.add(LodLevel::Far, false);
+  lod.snapshot()->record(tally);
+  lod.snapshot()->record(tally);
+
+  const SimulationLodStats stats = lod.beginTick({VoxelCoord{0, 0, 0}});
+  assert(stats.tick == 1);
+  assert(stats.regions[0] == 4 && stats.regions[1] == 5);
+  assert(stats.regions[2] == 16);
+  assert(stats.updated[0] == 2 && stats.skipped[2] == 4);
+  assert(stats.updated[2] == 0 && stats.skipped[0] == 0);
+  std::cout << "✓ Stats test passed" << std::endl;
+}
+
+// Creatures with a digestion clock: one item too big to ever finish, so
+// processingTime counts every tick the pass covered.
+std::vector<entt::entity> populate(entt::registry &registry, int creatures) {
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> coord(0, kMapSize - 1);
+  std::vector<entt::entity> entities;
+  for (int i = 0; i < creatures; ++i) {
+    const entt::entity e = registry.create();
+    registry.emplace<EntityTypeComponent>(e, 2, 0, 0);
+    registry.emplace<Position>(e, coord(gen), coord(gen), 1,
+                               DirectionEnum::UP);
+    registry.emplace<MetabolismComponent>(e, 10.f + i % 50, 200.f);
+    registry.emplace<HealthComponent>(e, 100.f, 100.f);
+    DigestionComponent digestion{{}, 10.f};
+    digestion.digestingItems.push_back(
+        DigestingFoodItem{1, 0, 0.f, 0.01f, 1e6f, 1.f, 0.f, 1.f});
+    registry.emplace<DigestionComponent>(e, std::move(digestion));
+    entities.push_back(e);
+  }
+  return entities;
+}
+
+int digestionClock(entt::registry &registry, entt::entity e) {
+  return registry.get<DigestionComponent>(e)
+      .digestingItems.front()
+      .processingTime;
+}
+
+void runLod(entt::registry &registry, SimulationLod &lod, int ticks) {
+  const MetabolismRules rules;
+  const std::vector<VoxelCoord> observers = {VoxelCoord{20, 30, 1},
+                                             VoxelCoord{200, 180, 1}};
+  for (int t = 0; t < ticks; ++t) {
+    lod.beginTick(observers);
+    const auto map = lod.snapshot();
+    map->record(runMetabolismPass(registry, rules, false, map.get()).lod);
+  }
+}
+
+void testUnitIntervalsMatchFullPass() {
+  std::cout << "Testing LOD with every interval at 1..." << std::endl;
+  entt::registry full, lodded;
+  const std::vector<entt::entity> creatures = populate(full, 2000);
+  populate(lodded, 2000);
+  SimulationLodConfig everyTick;
+  everyTick.midInterval = 1;
+  everyTick.farInterval = 1;
+  SimulationLod lod;
+  lod.configure(kMapSize, kMapSize, everyTick);
+
+  const MetabolismRules rules;
+  for (int t = 0; t < 12; ++t) {
+    runMetabolismPass(full, rules, false);
+  }
+  runLod(lodded, lod, 12);
+  for (const entt::entity e : creatures) {
+    assert(full.get<MetabolismComponent>(e).energyReserve ==
+           lodded.get<MetabolismComponent>(e).energyReserve);
+    assert(digestionClock(full, e) == 12);
+    assert(digestionClock(lodded, e) == 12);
+  }
+  std::cout << "✓ Unit intervals test passed" << std::endl;
+}
+
+void testPassCatchesUpSkippedCreatures() {
+  std::cout << "Testing the metabolism pass with LOD..." << std::endl;
+  entt::registry registry;
+  const std::vector<entt::entity> creatures = populate(registry, 4000);
+  // No Position: never skipped.
+  const entt::entity unplaced = creatures.back();
+  registry.remove<Position>(unplaced);
+  SimulationLod lod;
+  lod.configure(kMapSize, kMapSize, SimulationLodConfig{});
+
+  constexpr int kTicks = 40;
+  runLod(registry, lod, kTicks);
+  const auto map = lod.snapshot();
+  std::array<int, kLodLevels> seen{};
+  for (const entt::entity e : creatures) {
+    if (e == unplaced) {
+      continue;
+    }
+    const Position &pos = registry.get<Position>(e);
+    const LodLevel level = map->level(pos.x, pos.y);
+    const int clock = digestionClock(registry, e);
+    assert(clock <= kTicks && clock > kTicks - map->interval(level));
+    ++seen[static_cast<std::size_t>(level)];
+  }
+  assert(seen[0] > 0 && seen[1] > 0 && seen[2] > 0);
+  assert(digestionClock(registry, unplaced) == kTicks);
+
+  // The tally covers every creature once, the unplaced one as Near.
+  const SimulationLodStats stats = lod.beginTick({});
+  uint64_t counted = 0;
+  for (std::size_t l = 0; l < kLodLevels; ++l) {
+    counted += stats.updated[l] + stats.skipped[l];
+  }
+  assert(counted == creatures.size());
+  assert(stats.skipped[0] == 0 && stats.skipped[2] > 0);
+  std::cout << "✓ Catch-up pass test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Simulation LOD Tests ===" << std::endl;
+
+  testDisabledByDefault();
+  testConfigureClampsSettings();
+  testLevelsFollowObserverDistance();
+  testSkippedRegionsCatchUp();
+  testStatsReportPreviousTick();
+  testUnitIntervalsMatchFullPass();
+  testPassCatchesUpSkippedCreatures();
+
+  std::cout << "\n🎉 All simulation LOD tests passed!" << std::endl;
+  return 0;
+}
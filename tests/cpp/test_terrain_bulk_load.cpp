@@ -0,0 +1,228 @@
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "components/EntityTypeComponent.hpp"
+#include "components/PhysicsComponents.hpp"
+#include "components/TerrainComponents.hpp"
+#include "terrain/TerrainGridRepository.hpp"
+#include "terrain/TerrainStorage.hpp"
+#include "terrain/VoxelChangeLog.hpp"
+
+/**
+ * Terrain bulk load tests
+ *
+ * loadTerrainBox and loadTerrainPoints must leave every voxel as the
+ * per-voxel repository setters would. The other cases pin down the column
+ * rules: NONE ids are skipped without touching their leaf, zero water
+ * stays inactive, missing columns default to ON_GRID_STORAGE and zero,
+ * heat is truncated like setPhysicsStats, a repeated point keeps its last
+ * row, and a load that writes anything marks the whole change log.
+ */
+
+namespace {
+
+constexpr int64_t kNone = static_cast<int64_t>(TerrainIdTypeEnum::NONE);
+constexpr int64_t kOnGrid =
+    static_cast<int64_t>(TerrainIdTypeEnum::ON_GRID_STORAGE);
+
+void testBoxAndPointsMatchSetters() {
+  std::cout << "Testing bulk loads against per-voxel setters..."
+            << std::endl;
+  TerrainStorage setterStorage, boxStorage, pointStorage;
+  setterStorage.initialize();
+  boxStorage.initialize();
+  pointStorage.initialize();
+  entt::registry setterRegistry, boxRegistry, pointRegistry;
+  TerrainGridRepository setterRepo(setterRegistry, setterStorage);
+  TerrainGridRepository boxRepo(boxRegistry, boxStorage);
+  TerrainGridRepository pointRepo(pointRegistry, pointStorage);
+
+  // A 10x3x2 box straddling two leaves in x; one column is left empty and
+  // every other voxel has no water.
+  const int x0 = 5, y0 = 0, z0 = 1, w = 10, h = 3, d = 2;
+  const std::size_t n = static_cast<std::size_t>(w) * h * d;
+  std::vector<int64_t> terrainId(n, kOnGrid);
+  std::vector<int32_t> mainType(n, 0), subType0(n), water(n), mass(n),
+      flags(n), xyz;
+  std::vector<float> heat(n);
+  for (int z = z0; z < z0 + d; ++z) {
+    for (int y = y0; y < y0 + h; ++y) {
+      for (int x = x0; x < x0 + w; ++x) {
+        const std::size_t i =
+            (static_cast<std::size_t>(z - z0) * h + (y - y0)) * w + (x - x0);
+        xyz.insert(xyz.end(), {x, y, z});
+        if (x == 9 && y == 1) {
+          terrainId[i] = kNone;
+          continue;
+        }
+        subType0[i] = x % 3;
+        water[i] = x % 2 ? 0 : x;
+        mass[i] = y + 1;
+        heat[i] = 20.7f;
+        setterRepo.setTerrainId(x, y, z, kOnGrid);
+        setterRepo.setTerrainEntityType(x, y, z,
+                                        EntityTypeComponent{0, subType0[i], 0});
+        setterRepo.setTerrainMatterContainer(
+            x, y, z, MatterContainer{0, 0, water[i], 0});
+        setterRepo.setPhysicsStats(
+            x, y, z,
+            PhysicsStats{static_cast<float>(mass[i]), 0.f, 0.f, 0.f, 0.f, 0.f,
+                         heat[i]});
+        setterRepo.setPosition(x, y, z, Position{x, y, z, DirectionEnum::DOWN});
+        flags[i] = setterStorage.getFlagBits(x, y, z);
+      }
+    }
+  }
+
+  TerrainVoxelColumns columns;
+  columns.terrainId = terrainId.data();
+  columns.mainType = mainType.data();
+  columns.subType0 = subType0.data();
+  columns.waterMatter = water.data();
+  columns.mass = mass.data();
+  columns.heat = heat.data();
+  columns.flags = flags.data();
+  boxRepo.loadTerrainBox(x0, y0, z0, w, h, d, columns);
+  pointRepo.loadTerrainPoints(xyz.data(), n, columns);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const int x = xyz[3 * i], y = xyz[3 * i + 1], z = xyz[3 * i + 2];
+    for (TerrainGridRepository *repo : {&boxRepo, &pointRepo}) {
+      TerrainInfo a = setterRepo.readTerrainInfo(x, y, z);
+      TerrainInfo b = repo->readTerrainInfo(x, y, z);
+      assert(setterRepo.getTerrainIdIfExists(x, y, z) ==
+             repo->getTerrainIdIfExists(x, y, z));
+      assert(a.stat.mainType == b.stat.mainType);
+      assert(a.stat.subType0 == b.stat.subType0);
+      assert(a.stat.matter.WaterMatter == b.stat.matter.WaterMatter);
+      assert(a.stat.mass == b.stat.mass);
+      assert(a.stat.direction == b.stat.direction);
+      assert(setterRepo.getPhysicsStats(x, y, z).heat ==
+             repo->getPhysicsStats(x, y, z).heat);
+    }
+  }
+  assert(setterRepo.countActiveWaterMatterVoxels() ==
+         boxRepo.countActiveWaterMatterVoxels());
+  assert(setterRepo.countActiveWaterMatterVoxels() ==
+         pointRepo.countActiveWaterMatterVoxels());
+  std::cout << "✓ Setters test passed" << std::endl;
+}
+
+void testNoneIdsAreSkipped() {
+  std::cout << "Testing NONE ids..." << std::endl;
+  TerrainStorage storage;
+  storage.initialize();
+
+  // One solid voxel at (1, 0, 0); the rest of the box, including a whole
+  // leaf further along x, is air.
+  const int w = 16;
+  std::vector<int64_t> terrainId(w, kNone);
+  std::vector<int32_t> subType0(w, 5);
+  terrainId[1] = kOnGrid;
+  TerrainVoxelColumns columns;
+  columns.terrainId = terrainId.data();
+  columns.subType0 = subType0.data();
+  storage.loadBox(0, 0, 0, w, 1, 1, columns);
+
+  assert(storage.checkIfTerrainExists(1, 0, 0));
+  assert(storage.getTerrainSubType0(1, 0, 0) == 5);
+  for (int x = 0; x < w; ++x) {
+    if (x != 1) {
+      assert(!storage.checkIfTerrainExists(x, 0, 0));
+    }
+  }
+  assert(storage.terrainGrid->tree().leafCount() == 1);
+  std::cout << "✓ NONE ids test passed" << std::endl;
+}
+
+void testMissingColumnsAndZeroWater() {
+  std::cout << "Testing default columns and zero water..." << std::endl;
+  TerrainStorage storage;
+  storage.initialize();
+
+  // No terrainId column: every voxel is ON_GRID_STORAGE terrain.
+  const std::vector<int32_t> water = {0, 7, 0, 9};
+  const std::vector<float> heat = {20.7f, -3.5f, 0.f, 99.9f};
+  TerrainVoxelColumns columns;
+  columns.waterMatter = water.data();
+  columns.heat = heat.data();
+  storage.loadBox(0, 0, 0, 2, 2, 1, columns);
+
+  for (int y = 0; y < 2; ++y) {
+    for (int x = 0; x < 2; ++x) {
+      const std::size_t i = static_cast<std::size_t>(y) * 2 + x;
+      assert(storage.getTerrainIdIfExists(x, y, 0) == kOnGrid);
+      assert(storage.getTerrainSubType0(x, y, 0) == 0);
+      assert(storage.getTerrainSubType1(x, y, 0) == 0);
+      assert(storage.getTerrainMass(x, y, 0) == 0);
+      assert(storage.getTerrainWaterMatter(x, y, 0) == water[i]);
+      assert(storage.getTerrainHeat(x, y, 0) ==
+             static_cast<float>(static_cast<int>(heat[i])));
+    }
+  }
+  // Zero, not the background an unwritten voxel reads.
+  assert(storage.getTerrainSubType1(5, 5, 0) == -1);
+  // Only the voxels with water are active in the water grid.
+  assert(storage.countActiveWaterMatterVoxels() == 2);
+  std::cout << "✓ Default columns test passed" << std::endl;
+}
+
+void testRepeatedPointKeepsLastRow() {
+  std::cout << "Testing repeated points..." << std::endl;
+  TerrainStorage storage;
+  storage.initialize();
+
+  // (3, 3, 3) appears twice, with a point in another leaf in between.
+  const std::vector<int32_t> xyz = {3, 3, 3, 40, 0, 0, 3, 3, 3};
+  const std::vector<int32_t> subType0 = {1, 2, 3};
+  TerrainVoxelColumns columns;
+  columns.subType0 = subType0.data();
+  storage.loadPoints(xyz.data(), 3, columns);
+
+  assert(storage.getTerrainSubType0(3, 3, 3) == 3);
+  assert(storage.getTerrainSubType0(40, 0, 0) == 2);
+  std::cout << "✓ Repeated points test passed" << std::endl;
+}
+
+void testLoadMarksChangeLog() {
+  std::cout << "Testing the change log..." << std::endl;
+  TerrainStorage storage;
+  storage.initialize();
+  VoxelChangeLog log;
+  storage.changeLog = &log;
+  std::vector<VoxelCoord> changes;
+
+  // Nothing but air: nothing written, nothing to report.
+  const std::vector<int64_t> air(8, kNone);
+  TerrainVoxelColumns columns;
+  columns.terrainId = air.data();
+  storage.loadBox(0, 0, 0, 2, 2, 2, columns);
+  assert(!log.drain(changes));
+  assert(changes.empty());
+
+  // A real load is reported as a bulk rewrite rather than voxel by voxel.
+  columns.terrainId = nullptr;
+  storage.loadBox(0, 0, 0, 2, 2, 2, columns);
+  assert(log.drain(changes));
+  assert(changes.empty());
+  std::cout << "✓ Change log test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Terrain Bulk Load Tests ===" << std::endl;
+
+  testBoxAndPointsMatchSetters();
+  testNoneIdsAreSkipped();
+  testMissingColumnsAndZeroWater();
+  testRepeatedPointKeepsLastRow();
+  testLoadMarksChangeLog();
+
+  std::cout << "\n🎉 All terrain bulk load tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,341 @@
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "components/MovingComponent.hpp"
+#include "components/TerrainComponents.hpp"
+#include "terrain/TerrainGridLock.hpp"
+#include "terrain/TerrainGridRepository.hpp"
+#include "terrain/TerrainStorage.hpp"
+
+/**
+ * Terrain region lock tests
+ *
+ * Every repository call must nest inside a TerrainRegionLock: whole-grid
+ * reads and counts, whole-grid writes (withUniqueLock, lockTerrainGrid and
+ * writes outside the reserved regions) and exclusive writes under a shared
+ * region lock. Each case starts from a lock over a region whose stripe is
+ * not the lowest, so nested calls have to take stripes below it. Locks are
+ * tracked per repository, region locks on different regions do not wait
+ * for each other, and nothing stays locked once the guards end. Writers
+ * moving water and terrain across a stripe boundary under region and
+ * whole-grid locks at once must not lose an update.
+ */
+
+namespace {
+
+constexpr int kDim = TerrainStorage::kRegionDim;
+// Region (1, 0, 0): its stripe is above stripe 0, which region (0, 0, 0)
+// and the rest of the whole-grid calls need.
+constexpr VoxelCoord kHigh{kDim + 40, 5, 5};
+constexpr VoxelCoord kLow{5, 5, 5};
+constexpr VoxelCoord kUnreserved{4 * kDim, 5, 5};
+
+constexpr auto kPatience = std::chrono::seconds(5);
+
+struct World {
+  TerrainStorage storage;
+  entt::registry registry;
+  TerrainGridRepository repo{registry, storage};
+
+  World() {
+    storage.initialize();
+    repo.reserveRegions(2 * kDim, kDim, kDim);
+  }
+};
+
+MatterContainer water(int amount) { return MatterContainer{0, 0, amount, 0}; }
+
+void setWater(TerrainGridRepository &repo, const VoxelCoord &v, int amount) {
+  repo.setTerrainMatterContainer(v.x, v.y, v.z, water(amount));
+}
+
+int waterAt(const TerrainGridRepository &repo, const VoxelCoord &v) {
+  return repo.getTerrainMatterContainer(v.x, v.y, v.z).WaterMatter;
+}
+
+// Runs `f` on another thread and reports whether it finished in time.
+template <typename F> bool finishesOnOtherThread(F &&f) {
+  auto done = std::async(std::launch::async, std::forward<F>(f));
+  return done.wait_for(kPatience) == std::future_status::ready;
+}
+
+void testWholeGridReadsNest() {
+  std::cout << "Testing whole-grid reads inside a region lock..."
+            << std::endl;
+  World w;
+  setWater(w.repo, kLow, 3);
+  setWater(w.repo, kHigh, 4);
+  {
+    TerrainRegionLock lock(&w.repo, {kHigh});
+    assert(w.repo.currentThreadHoldsRegionLock());
+    assert(w.repo.countActiveWaterMatterVoxels() == 2);
+    assert(w.repo.sumTotalWater() == 7);
+    // Still holding the outer stripe: nested voxel calls need nothing more.
+    setWater(w.repo, kHigh, 5);
+    assert(waterAt(w.repo, kHigh) == 5);
+  }
+  assert(!w.repo.currentThreadHoldsRegionLock());
+  assert(finishesOnOtherThread([&] { TerrainGridLock lock(&w.repo); }));
+  std::cout << "✓ Whole-grid reads test passed" << std::endl;
+}
+
+void testWholeGridWritesNest() {
+  std::cout << "Testing whole-grid writes inside a region lock..."
+            << std::endl;
+  World w;
+  {
+    TerrainRegionLock lock(&w.repo, {kHigh});
+    // Outside the reserved regions: falls back to the whole grid.
+    setWater(w.repo, kUnreserved, 2);
+    assert(!w.repo.currentThreadHoldsTerrainGridLock());
+    {
+      TerrainGridLock grid(&w.repo);
+      assert(w.repo.currentThreadHoldsTerrainGridLock());
+      assert(w.repo.isTerrainGridLocked());
+      setWater(w.repo, kLow, 1);
+      setWater(w.repo, kHigh, 6);
+      assert(w.repo.sumTotalWater() == 9);
+    }
+    assert(!w.repo.currentThreadHoldsTerrainGridLock());
+    assert(!w.repo.isTerrainGridLocked());
+    assert(w.repo.currentThreadHoldsRegionLock());
+    // The outer stripe is still held exclusively.
+    setWater(w.repo, kHigh, 7);
+  }
+  assert(finishesOnOtherThread([&] { TerrainGridLock lock(&w.repo); }));
+  assert(waterAt(w.repo, kUnreserved) == 2);
+  assert(waterAt(w.repo, kLow) == 1);
+  assert(waterAt(w.repo, kHigh) == 7);
+  std::cout << "✓ Whole-grid writes test passed" << std::endl;
+}
+
+void testWritesUnderSharedLock() {
+  std::cout << "Testing writes under a shared region lock..." << std::endl;
+  World w;
+  setWater(w.repo, kHigh, 1);
+  std::future<void> writer;
+  {
+    TerrainRegionLock lock(&w.repo, {kHigh}, TerrainLockMode::SHARED);
+    setWater(w.repo, kHigh, 2);
+    assert(waterAt(w.repo, kHigh) == 2);
+    // The stripe went back to shared: other readers get in, writers wait.
+    assert(finishesOnOtherThread([&] { return waterAt(w.repo, kHigh); }));
+    writer = std::async(std::launch::async,
+                        [&] { setWater(w.repo, kHigh, 9); });
+    assert(writer.wait_for(std::chrono::milliseconds(50)) ==
+           std::future_status::timeout);
+    assert(waterAt(w.repo, kHigh) == 2);
+  }
+  assert(writer.wait_for(kPatience) == std::future_status::ready);
+  assert(waterAt(w.repo, kHigh) == 9);
+  std::cout << "✓ Shared lock writes test passed" << std::endl;
+}
+
+void testRepositoriesKeepSeparateLocks() {
+  std::cout << "Testing two repositories on one thread..." << std::endl;
+  World a, b;
+  TerrainRegionLock regionA(&a.repo, {kHigh});
+  TerrainGridLock gridB(&b.repo);
+  assert(a.repo.currentThreadHoldsRegionLock());
+  assert(!a.repo.currentThreadHoldsTerrainGridLock());
+  assert(b.repo.currentThreadHoldsTerrainGridLock());
+  assert(!b.repo.currentThreadHoldsRegionLock());
+  setWater(a.repo, kHigh, 1);
+  setWater(b.repo, kLow, 2);
+  assert(a.repo.sumTotalWater() == 1 && b.repo.sumTotalWater() == 2);
+  std::cout << "✓ Separate repositories test passed" << std::endl;
+}
+
+void testRegionLocksDoNotSerialise() {
+  std::cout << "Testing region locks on different regions..." << std::endl;
+  World w;
+  std::future<void> blocked;
+  {
+    TerrainRegionLock lock(&w.repo, {kHigh});
+    assert(finishesOnOtherThread([&] {
+      TerrainRegionLock other(&w.repo, {kLow});
+      setWater(w.repo, kLow, 4);
+    }));
+    blocked = std::async(std::launch::async, [&] {
+      TerrainRegionLock same(&w.repo, {kHigh});
+      setWater(w.repo, kHigh, 5);
+    });
+    assert(blocked.wait_for(std::chrono::milliseconds(50)) ==
+           std::future_status::timeout);
+  }
+  assert(blocked.wait_for(kPatience) == std::future_status::ready);
+  assert(waterAt(w.repo, kLow) == 4 && waterAt(w.repo, kHigh) == 5);
+  std::cout << "✓ Independent regions test passed" << std::endl;
+}
+
+// A band across the boundary between stripes 0 and 1: water and grass
+// voxels, one in four left empty.
+constexpr int kBandMinX = kDim - 12;
+constexpr int kBandMaxX = kDim + 12;
+constexpr int kBandY = 12;
+constexpr int kBandZ = 6;
+
+constexpr int kFaces[6][3] = {{1, 0, 0},  {-1, 0, 0}, {0, 1, 0},
+                              {0, -1, 0}, {0, 0, 1},  {0, 0, -1}};
+
+bool inBand(const VoxelCoord &v) {
+  return v.x >= kBandMinX && v.x < kBandMaxX && v.y >= 0 && v.y < kBandY &&
+         v.z >= 0 && v.z < kBandZ;
+}
+
+bool isType(const TerrainGridRepository &repo, const VoxelCoord &v,
+            TerrainEnum type) {
+  return repo.getTerrainIdIfExists(v.x, v.y, v.z) &&
+         repo.getTerrainEntityType(v.x, v.y, v.z).subType0 ==
+             static_cast<int>(type);
+}
+
+void fillBand(World &w) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<> roll(0, 3);
+  std::uniform_int_distribution<> amount(1, 8);
+  for (int z = 0; z < kBandZ; ++z) {
+    for (int y = 0; y < kBandY; ++y) {
+      for (int x = kBandMinX; x < kBandMaxX; ++x) {
+        const int r = roll(gen);
+        if (r == 0) {
+          continue;
+        }
+        const bool isWater = r != 3;
+        w.storage.setTerrainId(
+            x, y, z, static_cast<int>(TerrainIdTypeEnum::ON_GRID_STORAGE));
+        w.storage.setTerrainMainType(x, y, z, 0);
+        w.storage.setTerrainSubType0(
+            x, y, z,
+            static_cast<int>(isWater ? TerrainEnum::WATER
+                                     : TerrainEnum::GRASS));
+        w.storage.setTerrainWaterMatter(x, y, z, isWater ? amount(gen) : 0);
+        w.storage.setTerrainMatter(x, y, z, isWater ? 0 : 10);
+      }
+    }
+  }
+}
+
+int countGrass(const TerrainGridRepository &repo) {
+  int grass = 0;
+  for (int z = 0; z < kBandZ; ++z) {
+    for (int y = 0; y < kBandY; ++y) {
+      for (int x = kBandMinX; x < kBandMaxX; ++x) {
+        grass += isType(repo, VoxelCoord{x, y, z}, TerrainEnum::GRASS);
+      }
+    }
+  }
+  return grass;
+}
+
+// One unit of water from src to dst, both water voxels.
+void moveWater(TerrainGridRepository &repo, const VoxelCoord &src,
+               const VoxelCoord &dst) {
+  if (!isType(repo, src, TerrainEnum::WATER) ||
+      !isType(repo, dst, TerrainEnum::WATER)) {
+    return;
+  }
+  MatterContainer from = repo.getTerrainMatterContainer(src.x, src.y, src.z);
+  if (from.WaterMatter <= 0) {
+    return;
+  }
+  MatterContainer to = repo.getTerrainMatterContainer(dst.x, dst.y, dst.z);
+  from.WaterMatter -= 1;
+  to.WaterMatter += 1;
+  TerrainWriteBatch batch(TerrainWriteOrder::BY_LEAF);
+  batch.setTerrainMatterContainer(src.x, src.y, src.z, from);
+  batch.setTerrainMatterContainer(dst.x, dst.y, dst.z, to);
+  repo.applyWriteBatch(batch);
+}
+
+// A grass voxel into an empty neighbour.
+void moveGrass(TerrainGridRepository &repo, const VoxelCoord &src,
+               const VoxelCoord &dst) {
+  if (!isType(repo, src, TerrainEnum::GRASS) ||
+      repo.getTerrainIdIfExists(dst.x, dst.y, dst.z)) {
+    return;
+  }
+  MovingComponent mc{};
+  mc.isMoving = true;
+  mc.movingFromX = src.x;
+  mc.movingFromY = src.y;
+  mc.movingFromZ = src.z;
+  mc.movingToX = dst.x;
+  mc.movingToY = dst.y;
+  mc.movingToZ = dst.z;
+  mc.direction = DirectionEnum::UP;
+  repo.moveTerrain(mc);
+}
+
+void testConcurrentWritersLoseNothing() {
+  std::cout << "Testing concurrent writers across a stripe boundary..."
+            << std::endl;
+  World w;
+  fillBand(w);
+  const int64_t waterBefore = w.repo.sumTotalWater();
+  const int grassBefore = countGrass(w.repo);
+  assert(waterBefore > 0 && grassBefore > 0);
+
+  constexpr int kOps = 4000;
+  // Water under region locks, water under the whole-grid lock, grass under
+  // region locks.
+  auto writer = [&](int role, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> x(kBandMinX, kBandMaxX - 1);
+    std::uniform_int_distribution<> y(0, kBandY - 1);
+    std::uniform_int_distribution<> z(0, kBandZ - 1);
+    std::uniform_int_distribution<> face(0, 5);
+    for (int i = 0; i < kOps; ++i) {
+      const VoxelCoord src{x(gen), y(gen), z(gen)};
+      const int *d = kFaces[face(gen)];
+      const VoxelCoord dst{src.x + d[0], src.y + d[1], src.z + d[2]};
+      if (!inBand(dst)) {
+        continue;
+      }
+      if (role == 1) {
+        TerrainGridLock lock(&w.repo);
+        moveWater(w.repo, src, dst);
+      } else {
+        TerrainRegionLock lock(&w.repo, {src, dst});
+        (role == 0 ? moveWater : moveGrass)(w.repo, src, dst);
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int role : {0, 0, 0, 1, 2, 2}) {
+    threads.emplace_back(writer, role,
+                         static_cast<unsigned>(threads.size() + 1));
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  assert(w.repo.sumTotalWater() == waterBefore);
+  assert(countGrass(w.repo) == grassBefore);
+  std::cout << "✓ Concurrent writers test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Terrain Region Lock Tests ===" << std::endl;
+
+  testWholeGridReadsNest();
+  testWholeGridWritesNest();
+  testWritesUnderSharedLock();
+  testRepositoriesKeepSeparateLocks();
+  testRegionLocksDoNotSerialise();
+  testConcurrentWritersLoseNothing();
+
+  std::cout << "\n🎉 All terrain region lock tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,179 @@
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include <entt/entt.hpp>
+
+#include "components/TerrainComponents.hpp"
+#include "terrain/TerrainGridRepository.hpp"
+#include "terrain/TerrainStorage.hpp"
+
+/**
+ * Terrain stencil tests
+ *
+ * getStencil must return what the per-voxel getters return for every
+ * neighbour it covers, whether the 3x3x3 block sits inside one leaf or
+ * straddles leaves (and the origin), for both the box and the 7-point face
+ * shape. Entries outside the face shape hold the grid background, and
+ * fields that were not requested are left as constructed.
+ */
+
+namespace {
+
+// Spans negative coordinates and several 8^3 leaves on each axis.
+constexpr int kMin = -6;
+constexpr int kMax = 20;
+constexpr int kMinZ = -3;
+constexpr int kMaxZ = 10;
+
+constexpr uint32_t kFields = StencilField::TERRAIN_ID |
+                             StencilField::ENTITY_TYPE | StencilField::MATTER;
+
+struct World {
+  TerrainStorage storage;
+  entt::registry registry;
+  TerrainGridRepository repo{registry, storage};
+
+  World() {
+    storage.initialize();
+    populate();
+  }
+
+  // Random water and grass cells, a quarter of them left empty.
+  void populate() {
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<> coin(0, 3);
+    std::uniform_int_distribution<> amount(0, 12);
+    for (int z = kMinZ; z < kMaxZ; ++z) {
+      for (int y = kMin; y < kMax; ++y) {
+        for (int x = kMin; x < kMax; ++x) {
+          const int roll = coin(gen);
+          if (roll == 0) {
+            continue;
+          }
+          const bool water = roll == 1;
+          storage.setTerrainId(
+              x, y, z, static_cast<int>(TerrainIdTypeEnum::ON_GRID_STORAGE));
+          storage.setTerrainMainType(x, y, z, 0);
+          storage.setTerrainSubType0(
+              x, y, z,
+              static_cast<int>(water ? TerrainEnum::WATER
+                                     : TerrainEnum::GRASS));
+          storage.setTerrainSubType1(x, y, z, coin(gen) == 3 ? 1 : 0);
+          storage.setTerrainWaterMatter(x, y, z, amount(gen));
+          storage.setTerrainVaporMatter(x, y, z, amount(gen) / 4);
+          storage.setTerrainMatter(x, y, z, water ? 0 : 10);
+        }
+      }
+    }
+  }
+};
+
+// Whether entry `i` of `st` holds what the getters read at (x, y, z).
+bool matchesGetters(const TerrainGridRepository &repo,
+                    const TerrainStencil &st, int i, int x, int y, int z) {
+  const int64_t terrainId = repo.getTerrainIdIfExists(x, y, z).value_or(-2);
+  const EntityTypeComponent type = repo.getTerrainEntityType(x, y, z);
+  const MatterContainer matter = repo.getTerrainMatterContainer(x, y, z);
+  return terrainId == st.terrainId[i] && type.mainType == st.mainType[i] &&
+         type.subType0 == st.subType0[i] && type.subType1 == st.subType1[i] &&
+         matter.TerrainMatter == st.matter[i].TerrainMatter &&
+         matter.WaterMatter == st.matter[i].WaterMatter &&
+         matter.WaterVapor == st.matter[i].WaterVapor &&
+         matter.BioMassMatter == st.matter[i].BioMassMatter;
+}
+
+void testStencilsMatchGetters() {
+  std::cout << "Testing stencils against the per-voxel getters..."
+            << std::endl;
+  World w;
+  int checked = 0;
+  for (int z = kMinZ + 1; z < kMaxZ - 1; ++z) {
+    for (int y = kMin + 1; y < kMax - 1; ++y) {
+      for (int x = kMin + 1; x < kMax - 1; ++x) {
+        const TerrainStencil box = w.repo.getStencil(x, y, z, kFields);
+        const TerrainStencil faces =
+            w.repo.getStencil(x, y, z, kFields, StencilShape::FACES_7);
+        assert(box.cx == x && box.cy == y && box.cz == z);
+        for (int dz = -1; dz <= 1; ++dz) {
+          for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+              const int i = TerrainStencil::index(dx, dy, dz);
+              assert(box.covers(x + dx, y + dy, z + dz));
+              assert(box.at(x + dx, y + dy, z + dz) == i);
+              assert(matchesGetters(w.repo, box, i, x + dx, y + dy, z + dz));
+              if (faces.covers(x + dx, y + dy, z + dz)) {
+                assert(matchesGetters(w.repo, faces, i, x + dx, y + dy,
+                                      z + dz));
+                ++checked;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  // Seven face points per centre.
+  assert(checked == 7 * (kMax - kMin - 2) * (kMax - kMin - 2) *
+                        (kMaxZ - kMinZ - 2));
+  std::cout << "✓ Getter agreement test passed" << std::endl;
+}
+
+void testFacesLeaveCornersAtBackground() {
+  std::cout << "Testing the face stencil's unread entries..." << std::endl;
+  World w;
+  // Far from anything populated: every entry is the background.
+  const TerrainStencil empty = w.repo.getStencil(500, 500, 500, kFields);
+  const int c = TerrainStencil::kCentre;
+  assert(!empty.terrainExists(c));
+
+  const TerrainStencil faces =
+      w.repo.getStencil(8, 8, 4, kFields, StencilShape::FACES_7);
+  int unread = 0;
+  for (int i = 0; i < TerrainStencil::kSize; ++i) {
+    const int dx = i % 3 - 1, dy = (i / 3) % 3 - 1, dz = i / 9 - 1;
+    if (faces.covers(8 + dx, 8 + dy, 4 + dz)) {
+      continue;
+    }
+    ++unread;
+    assert(faces.terrainId[i] == empty.terrainId[c]);
+    assert(faces.mainType[i] == empty.mainType[c]);
+    assert(faces.subType1[i] == empty.subType1[c]);
+    assert(faces.matter[i].WaterMatter == empty.matter[c].WaterMatter);
+  }
+  assert(unread == 20);
+  std::cout << "✓ Face stencil test passed" << std::endl;
+}
+
+void testUnrequestedFieldsAreUntouched() {
+  std::cout << "Testing a stencil of one field group..." << std::endl;
+  World w;
+  const TerrainStencil fresh;
+  const TerrainStencil matter =
+      w.repo.getStencil(3, 3, 3, StencilField::MATTER);
+  assert(matter.fields == StencilField::MATTER);
+  assert(matter.terrainId == fresh.terrainId);
+  assert(matter.mainType == fresh.mainType);
+  assert(matter.subType0 == fresh.subType0);
+  for (int i = 0; i < TerrainStencil::kSize; ++i) {
+    const int dx = i % 3 - 1, dy = (i / 3) % 3 - 1, dz = i / 9 - 1;
+    assert(matter.matter[i].WaterMatter ==
+           w.repo.getTerrainMatterContainer(3 + dx, 3 + dy, 3 + dz)
+               .WaterMatter);
+  }
+  std::cout << "✓ Field selection test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Terrain Stencil Tests ===" << std::endl;
+
+  testStencilsMatchGetters();
+  testFacesLeaveCornersAtBackground();
+  testUnrequestedFieldsAreUntouched();
+
+  std::cout << "\n🎉 All terrain stencil tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,209 @@
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "terrain/VoxelCoord.hpp"
+#include "terrain/VoxelCoordMap.hpp"
+
+/**
+ * VoxelCoordMap tests
+ *
+ * Morton codes round-trip over the whole encodable range and stay
+ * distinct. VoxelCoordMap must keep every surviving key reachable through
+ * erases in the middle of a probe run, and EntityVoxelIndex must tell a
+ * live entity from an older version of its recycled id. Under the
+ * repository's activate/deactivate churn both must hold exactly what a
+ * std::unordered_map pair holds.
+ */
+
+namespace {
+
+constexpr int kMortonMin = -(1 << 20);
+constexpr int kMortonMax = (1 << 20) - 1;
+
+void testMortonRoundTrip() {
+  std::cout << "Testing Morton codes..." << std::endl;
+  std::vector<VoxelCoord> coords = {
+      {0, 0, 0},
+      {-1, -1, -1},
+      {kMortonMin, kMortonMin, kMortonMin},
+      {kMortonMax, kMortonMax, kMortonMax},
+      {kMortonMin, kMortonMax, 0},
+  };
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> axis(kMortonMin, kMortonMax);
+  for (int i = 0; i < 10000; ++i) {
+    coords.push_back(VoxelCoord{axis(gen), axis(gen), axis(gen)});
+  }
+
+  std::unordered_set<uint64_t> codes;
+  std::unordered_set<VoxelCoord, VoxelCoordHash> distinct;
+  for (const VoxelCoord &c : coords) {
+    const uint64_t code = mortonEncode(c);
+    assert(code >> 63 == 0);
+    assert(mortonDecode(code) == c);
+    codes.insert(code);
+    distinct.insert(c);
+  }
+  assert(codes.size() == distinct.size());
+  // Neighbours along x differ only in the low bits of their code.
+  assert((mortonEncode({0, 0, 0}) ^ mortonEncode({1, 0, 0})) == 1);
+  std::cout << "✓ Morton test passed" << std::endl;
+}
+
+void testEraseKeepsProbeRunsReachable() {
+  std::cout << "Testing insert and erase..." << std::endl;
+  VoxelCoordMap<int> map;
+  assert(map.empty() && !map.find({0, 0, 0}) && !map.erase({0, 0, 0}));
+
+  // A dense block: enough keys to rehash several times and share probe
+  // runs.
+  std::vector<VoxelCoord> keys;
+  for (int z = 0; z < 8; ++z) {
+    for (int y = -8; y < 8; ++y) {
+      for (int x = -8; x < 8; ++x) {
+        keys.push_back(VoxelCoord{x, y, z});
+        map[keys.back()] = static_cast<int>(keys.size());
+      }
+    }
+  }
+  assert(map.size() == keys.size());
+  map[keys.front()] += 100; // present: no new entry
+  assert(map.size() == keys.size() && *map.find(keys.front()) == 101);
+
+  // Every other key, then check the survivors are all still found.
+  for (std::size_t i = 0; i < keys.size(); i += 2) {
+    assert(map.erase(keys[i]));
+    assert(!map.erase(keys[i]));
+  }
+  assert(map.size() == keys.size() / 2);
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    const int *value = map.find(keys[i]);
+    if (i % 2 == 0) {
+      assert(!value && !map.contains(keys[i]));
+    } else {
+      assert(value && *value == static_cast<int>(i + 1));
+    }
+  }
+
+  std::size_t visited = 0;
+  map.forEach([&](const VoxelCoord &key, int value) {
+    assert(*map.find(key) == value);
+    ++visited;
+  });
+  assert(visited == map.size());
+
+  map.clear();
+  assert(map.empty() && !map.find(keys[1]));
+  map.reserve(1000);
+  map[keys[1]] = 5;
+  assert(map.size() == 1 && *map.find(keys[1]) == 5);
+  std::cout << "✓ Insert and erase test passed" << std::endl;
+}
+
+void testEntityIndexRejectsRecycledIds() {
+  std::cout << "Testing EntityVoxelIndex with recycled ids..." << std::endl;
+  entt::registry registry;
+  EntityVoxelIndex index;
+  const entt::entity first = registry.create();
+  index.set(first, VoxelCoord{1, 2, 3});
+  assert(index.size() == 1 && (*index.find(first) == VoxelCoord{1, 2, 3}));
+  index.set(first, VoxelCoord{4, 5, 6});
+  assert(index.size() == 1 && (*index.find(first) == VoxelCoord{4, 5, 6}));
+
+  registry.destroy(first);
+  const entt::entity recycled = registry.create();
+  assert(entt::to_entity(recycled) == entt::to_entity(first));
+  assert(recycled != first);
+  // The stale entry still holds the slot, but not for the new version.
+  assert(!index.find(recycled) && !index.erase(recycled));
+  index.set(recycled, VoxelCoord{7, 8, 9});
+  assert(index.size() == 1);
+  assert(!index.find(first) && (*index.find(recycled) == VoxelCoord{7, 8, 9}));
+  assert(!index.erase(first));
+  assert(index.erase(recycled) && index.size() == 0);
+  assert(!index.find(entt::null));
+  std::cout << "✓ Recycled id test passed" << std::endl;
+}
+
+// The repository's bookkeeping before and after the flat maps.
+struct StdMaps {
+  std::unordered_map<VoxelCoord, entt::entity, VoxelCoordHash> byCoord;
+  std::unordered_map<entt::entity, VoxelCoord> byEntity;
+};
+
+struct FlatMaps {
+  VoxelCoordMap<entt::entity> byCoord;
+  EntityVoxelIndex byEntity;
+};
+
+void testChurnMatchesUnorderedMap() {
+  std::cout << "Testing activate/deactivate churn..." << std::endl;
+  constexpr int kExtent = 256;
+  constexpr int kSteps = 50000;
+  constexpr std::size_t kWorkingSet = 2000;
+  entt::registry registry;
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<> axis(0, kExtent - 1);
+  StdMaps expected;
+  FlatMaps flat;
+  std::vector<std::pair<VoxelCoord, entt::entity>> live;
+
+  for (int step = 0; step < kSteps; ++step) {
+    // Activate a voxel, unless it is already tracked.
+    const VoxelCoord c{axis(gen), axis(gen), axis(gen) / 16};
+    const entt::entity *tracked = flat.byCoord.find(c);
+    assert((tracked != nullptr) == (expected.byCoord.count(c) > 0));
+    if (!tracked) {
+      const entt::entity e = registry.create();
+      expected.byCoord[c] = e;
+      expected.byEntity[e] = c;
+      flat.byCoord[c] = e;
+      flat.byEntity.set(e, c);
+      live.emplace_back(c, e);
+    }
+    // Deactivate a random one and recycle its id.
+    if (live.size() > kWorkingSet) {
+      const std::size_t victim = gen() % live.size();
+      const auto [vc, ve] = live[victim];
+      expected.byCoord.erase(vc);
+      expected.byEntity.erase(ve);
+      assert(flat.byCoord.erase(vc));
+      assert(flat.byEntity.erase(ve));
+      registry.destroy(ve);
+      live[victim] = live.back();
+      live.pop_back();
+    }
+  }
+
+  assert(flat.byCoord.size() == expected.byCoord.size());
+  assert(flat.byEntity.size() == expected.byEntity.size());
+  for (const auto &[coord, entity] : expected.byCoord) {
+    const entt::entity *e = flat.byCoord.find(coord);
+    const VoxelCoord *back = flat.byEntity.find(entity);
+    assert(e && *e == entity);
+    assert(back && *back == coord);
+  }
+  std::cout << "✓ Churn test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== VoxelCoordMap Tests ===" << std::endl;
+
+  testMortonRoundTrip();
+  testEraseKeepsProbeRunsReachable();
+  testEntityIndexRejectsRecycledIds();
+  testChurnMatchesUnorderedMap();
+
+  std::cout << "\n🎉 All VoxelCoordMap tests passed!" << std::endl;
+  return 0;
+}
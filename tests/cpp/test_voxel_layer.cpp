@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "voxelgrid/VoxelLayerCodec.hpp"
+
+/**
+ * VoxelLayerCodec tests
+ *
+ * Each case encodes a hand-built layer, checks which encoding was picked,
+ * and decodes it back whole and slice by slice: a perception-style terrain
+ * layer goes PALETTE_RLE, a scattered crowd of entity ids goes SPARSE, and
+ * noise or a mis-sized array stays DENSE. VoxelSliceCache must return the
+ * same values in any read order and keep only its last few slices.
+ */
+
+namespace {
+
+constexpr int kSide = 9;
+constexpr int kDepth = 5;
+constexpr std::size_t kSlice = static_cast<std::size_t>(kSide) * kSide;
+
+std::size_t index(int x, int y, int z) {
+  return (static_cast<std::size_t>(z) * kSide + y) * kSide + x;
+}
+
+// Air (0) above a surface of unique virtual ids, occluded (-3) below.
+std::vector<int> terrainLayer() {
+  std::vector<int> data(kSlice * kDepth, 0);
+  int virtualId = -1000;
+  for (int y = 0; y < kSide; ++y) {
+    for (int x = 0; x < kSide; ++x) {
+      const int top = x < kSide / 2 ? 2 : 3; // one step across the view
+      for (int z = 0; z <= top; ++z) {
+        data[index(x, y, z)] = z == top ? virtualId-- : -3;
+      }
+    }
+  }
+  return data;
+}
+
+// A crowd too scattered for runs: an entity in every seventh voxel.
+std::vector<int> entityLayer() {
+  std::vector<int> data(kSlice * kDepth, 0);
+  for (std::size_t i = 0; i < data.size(); i += 7) {
+    data[i] = 100 + static_cast<int>(i);
+  }
+  return data;
+}
+
+// Decodes every slice on its own, last slice first.
+std::vector<int> decodeSliceBySlice(const VoxelLayerSpans &spans,
+                                    std::size_t sliceSize,
+                                    std::size_t depth) {
+  std::vector<int> out(sliceSize * depth);
+  for (std::size_t z = depth; z-- > 0;) {
+    decodeVoxelSlice(spans, sliceSize, z, out.data() + z * sliceSize);
+  }
+  return out;
+}
+
+void checkRoundTrip(const std::vector<int> &data,
+                    const EncodedVoxelLayer &layer, std::size_t sliceSize,
+                    std::size_t depth) {
+  const VoxelLayerSpans spans = layer.spans(data.data());
+  std::vector<int> decoded;
+  decodeVoxelLayer(spans, sliceSize, depth, decoded);
+  assert(decoded == data);
+  assert(decodeSliceBySlice(spans, sliceSize, depth) == data);
+}
+
+void testTerrainLayerUsesRuns() {
+  std::cout << "Testing a terrain layer..." << std::endl;
+  const std::vector<int> data = terrainLayer();
+  const EncodedVoxelLayer layer = encodeVoxelLayer(data, kSide, kSide, kDepth);
+
+  assert(layer.encoding == VoxelLayerEncoding::PALETTE_RLE);
+  assert(layer.sliceRuns.size() == kDepth);
+  assert(layer.bytes < 4 + data.size() * sizeof(int));
+  // 0, -3 and one id per column.
+  assert(layer.palette.size() == 2 + kSlice);
+  checkRoundTrip(data, layer, kSlice, kDepth);
+  std::cout << "✓ Terrain layer test passed" << std::endl;
+}
+
+void testEntityLayerIsSparse() {
+  std::cout << "Testing an entity layer..." << std::endl;
+  const std::vector<int> data = entityLayer();
+  const EncodedVoxelLayer layer = encodeVoxelLayer(data, kSide, kSide, kDepth);
+
+  assert(layer.encoding == VoxelLayerEncoding::SPARSE);
+  assert(layer.background == 0);
+  assert(layer.values.size() == (data.size() + 6) / 7);
+  assert(layer.values.front() == 100 && layer.values.back() == 100 + 399);
+  assert(layer.sliceValues.size() == kDepth);
+  assert(layer.palette.empty() && layer.runLengths.empty());
+  checkRoundTrip(data, layer, kSlice, kDepth);
+  std::cout << "✓ Entity layer test passed" << std::endl;
+}
+
+void testUniformSliceSplitsLongRuns() {
+  std::cout << "Testing runs longer than a run length holds..."
+            << std::endl;
+  const int side = 300; // 90000 voxels per slice
+  const std::size_t slice = static_cast<std::size_t>(side) * side;
+  std::vector<int> data(slice * 2, -3);
+  std::fill(data.begin() + slice, data.end(), 0);
+  const EncodedVoxelLayer layer = encodeVoxelLayer(data, side, side, 2);
+
+  assert(layer.encoding == VoxelLayerEncoding::PALETTE_RLE);
+  assert(layer.runLengths.size() == 4);
+  assert(layer.runLengths[0] == 0xFFFF);
+  assert((layer.sliceRuns == std::vector<uint32_t>{0, 2}));
+  checkRoundTrip(data, layer, slice, 2);
+  std::cout << "✓ Long run test passed" << std::endl;
+}
+
+void testNoiseStaysDense() {
+  std::cout << "Testing a layer that does not compress..." << std::endl;
+  // More distinct values than a run's palette index can address.
+  const int side = 64, depth = 20;
+  const std::size_t slice = static_cast<std::size_t>(side) * side;
+  std::vector<int> data(slice * depth);
+  uint32_t state = 12345;
+  for (int &v : data) {
+    state = state * 1664525u + 1013904223u;
+    v = static_cast<int>(state);
+  }
+  const EncodedVoxelLayer layer = encodeVoxelLayer(data, side, side, depth);
+
+  assert(layer.encoding == VoxelLayerEncoding::DENSE);
+  assert(layer.palette.empty() && layer.mask.empty());
+  assert(layer.bytes == 4 + data.size() * sizeof(int));
+  checkRoundTrip(data, layer, slice, depth);
+
+  // A shape that does not match the data is sent as it is.
+  const std::vector<int> entities = entityLayer();
+  assert(encodeVoxelLayer(entities, kSide, kSide, kDepth + 1).encoding ==
+         VoxelLayerEncoding::DENSE);
+  std::cout << "✓ Dense layer test passed" << std::endl;
+}
+
+void testSliceCacheReads() {
+  std::cout << "Testing VoxelSliceCache..." << std::endl;
+  const std::vector<int> data = terrainLayer();
+  const EncodedVoxelLayer layer = encodeVoxelLayer(data, kSide, kSide, kDepth);
+  const VoxelLayerSpans spans = layer.spans(data.data());
+
+  VoxelSliceCache cache;
+  assert(cache.find(0) == nullptr);
+  uint32_t state = 7;
+  for (int k = 0; k < 2000; ++k) {
+    state = state * 1664525u + 1013904223u;
+    const std::size_t i = (state >> 8) % data.size();
+    const int z = static_cast<int>(i / kSlice);
+    const int *slice = cache.find(z);
+    if (!slice) {
+      slice = cache.load(spans, kSlice, z);
+    }
+    assert(slice[i % kSlice] == data[i]);
+  }
+
+  // Four slots: loading a fifth slice drops the oldest.
+  VoxelSliceCache fresh;
+  for (int z = 0; z < kDepth; ++z) {
+    fresh.load(spans, kSlice, z);
+  }
+  assert(fresh.find(0) == nullptr);
+  for (int z = 1; z < kDepth; ++z) {
+    const int *slice = fresh.find(z);
+    assert(slice != nullptr);
+    assert(std::equal(slice, slice + kSlice, data.begin() + z * kSlice));
+  }
+  std::cout << "✓ Slice cache test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Voxel Layer Codec Tests ===" << std::endl;
+
+  testTerrainLayerUsesRuns();
+  testEntityLayerIsSparse();
+  testUniformSliceSplitsLongRuns();
+  testNoiseStaysDense();
+  testSliceCacheReads();
+
+  std::cout << "\n🎉 All voxel layer codec tests passed!" << std::endl;
+  return 0;
+}
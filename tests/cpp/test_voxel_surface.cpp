@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include "Gui/VoxelSurfaceMesh.hpp"
+
+/**
+ * VoxelSurfaceMesh tests
+ *
+ * Small hand-built arrays check the quads themselves: a lone voxel is a
+ * cube of six outward-wound quads, a flat slab of one value merges to one
+ * quad per side, and different values do not merge. A terrain-shaped array
+ * then checks that the merged quads cover exactly the faces a per-voxel
+ * neighbour test finds. The last cases cover when update() rebuilds and how
+ * float arrays are read.
+ */
+
+namespace {
+
+// (face, x, y, z, value) of one exposed unit face.
+using UnitFace = std::tuple<int, int, int, int, int>;
+
+std::size_t index(int side, int x, int y, int z) {
+  return (static_cast<std::size_t>(z) * side + y) * side + x;
+}
+
+std::vector<UnitFace> perVoxelFaces(const std::vector<int> &voxels,
+                                    int side) {
+  static constexpr int kSteps[6][3] = {{-1, 0, 0}, {1, 0, 0}, {0, -1, 0},
+                                       {0, 1, 0},  {0, 0, -1}, {0, 0, 1}};
+  auto solid = [&](int x, int y, int z) {
+    if (x < 0 || y < 0 || z < 0 || x >= side || y >= side || z >= side) {
+      return false;
+    }
+    return voxels[index(side, x, y, z)] != 0;
+  };
+  std::vector<UnitFace> faces;
+  for (int z = 0; z < side; ++z) {
+    for (int y = 0; y < side; ++y) {
+      for (int x = 0; x < side; ++x) {
+        const int value = voxels[index(side, x, y, z)];
+        if (value == 0) {
+          continue;
+        }
+        for (int f = 0; f < 6; ++f) {
+          if (!solid(x + kSteps[f][0], y + kSteps[f][1], z + kSteps[f][2])) {
+            faces.emplace_back(f, x, y, z, value);
+          }
+        }
+      }
+    }
+  }
+  std::sort(faces.begin(), faces.end());
+  return faces;
+}
+
+// Splits every quad back into the unit faces it covers.
+std::vector<UnitFace> rasterise(const std::vector<SurfaceQuad> &quads) {
+  std::vector<UnitFace> faces;
+  for (const SurfaceQuad &q : quads) {
+    const int f = static_cast<int>(q.face);
+    const int axis = f / 2;
+    int lo[3], hi[3];
+    for (int a = 0; a < 3; ++a) {
+      lo[a] = static_cast<int>(std::min({q.corners[0][a], q.corners[1][a],
+                                         q.corners[2][a], q.corners[3][a]}));
+      hi[a] = static_cast<int>(std::max({q.corners[0][a], q.corners[1][a],
+                                         q.corners[2][a], q.corners[3][a]}));
+    }
+    // The voxel sits behind the face plane along the normal.
+    lo[axis] -= f % 2 == 1 ? 1 : 0;
+    hi[axis] = lo[axis] + 1;
+    for (int z = lo[2]; z < hi[2]; ++z) {
+      for (int y = lo[1]; y < hi[1]; ++y) {
+        for (int x = lo[0]; x < hi[0]; ++x) {
+          faces.emplace_back(f, x, y, z, q.value);
+        }
+      }
+    }
+  }
+  std::sort(faces.begin(), faces.end());
+  return faces;
+}
+
+// Seen from outside (against the normal) the corners turn counter-clockwise.
+bool woundOutwards(const SurfaceQuad &q) {
+  float a[3], b[3];
+  for (int i = 0; i < 3; ++i) {
+    a[i] = q.corners[1][i] - q.corners[0][i];
+    b[i] = q.corners[2][i] - q.corners[0][i];
+  }
+  const float cross[3] = {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+                          a[0] * b[1] - a[1] * b[0]};
+  return cross[0] * q.normal[0] + cross[1] * q.normal[1] +
+             cross[2] * q.normal[2] >
+         0;
+}
+
+std::vector<int> buildTerrain(int side) {
+  std::vector<int> voxels(static_cast<std::size_t>(side) * side * side, 0);
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      const float h = 0.35f * side +
+                      0.1f * side * std::sin(x * 0.9f) * std::cos(y * 0.7f);
+      const int top = std::clamp(static_cast<int>(h), 1, side - 1);
+      for (int z = 0; z < top; ++z) {
+        voxels[index(side, x, y, z)] = z + 2 < top ? (z < top / 2 ? 3 : 2) : 1;
+      }
+    }
+  }
+  for (int i = 0; i < side; i += 3) {
+    voxels[index(side, i, (i * 7) % side, side - 2)] = 4;
+  }
+  return voxels;
+}
+
+void testLoneVoxelIsACube() {
+  std::cout << "Testing a lone voxel..." << std::endl;
+  std::vector<int> voxels(27, 0);
+  voxels[index(3, 1, 1, 1)] = 5;
+
+  VoxelSurfaceMesh mesh;
+  assert(mesh.update(voxels.data(), VoxelSurfaceMesh::Kind::INT, 3, 3, 3));
+  assert(mesh.quads().size() == 6);
+  assert(mesh.exposedFaces() == 6);
+  for (const SurfaceQuad &q : mesh.quads()) {
+    assert(q.value == 5);
+    assert(woundOutwards(q));
+  }
+  assert(rasterise(mesh.quads()) == perVoxelFaces(voxels, 3));
+  std::cout << "✓ Lone voxel test passed" << std::endl;
+}
+
+void testFlatSlabMergesToOneQuadPerSide() {
+  std::cout << "Testing a flat slab..." << std::endl;
+  constexpr int kSide = 4;
+  std::vector<int> voxels(kSide * kSide * kSide, 0);
+  for (int y = 0; y < kSide; ++y) {
+    for (int x = 0; x < kSide; ++x) {
+      voxels[index(kSide, x, y, 0)] = 2;
+    }
+  }
+
+  VoxelSurfaceMesh mesh;
+  mesh.update(voxels.data(), VoxelSurfaceMesh::Kind::INT, kSide, kSide,
+              kSide);
+  // 16 faces on top, 16 below and 4 along each of the four edges.
+  assert(mesh.exposedFaces() == 48);
+  assert(mesh.quads().size() == 6);
+  assert(rasterise(mesh.quads()) == perVoxelFaces(voxels, kSide));
+  std::cout << "✓ Flat slab test passed" << std::endl;
+}
+
+void testDifferentValuesDoNotMerge() {
+  std::cout << "Testing neighbours with different values..." << std::endl;
+  std::vector<int> voxels(8, 0);
+  voxels[index(2, 0, 0, 0)] = 1;
+  voxels[index(2, 1, 0, 0)] = 2;
+
+  VoxelSurfaceMesh mesh;
+  mesh.update(voxels.data(), VoxelSurfaceMesh::Kind::INT, 2, 2, 2);
+  // The shared face is hidden; the four long sides stay split by value.
+  assert(mesh.exposedFaces() == 10);
+  assert(mesh.quads().size() == 10);
+  assert(rasterise(mesh.quads()) == perVoxelFaces(voxels, 2));
+  std::cout << "✓ Different values test passed" << std::endl;
+}
+
+void testQuadsCoverExactlyTheExposedFaces() {
+  std::cout << "Testing merged quads against per-voxel faces..."
+            << std::endl;
+  constexpr int kSide = 24;
+  const std::vector<int> voxels = buildTerrain(kSide);
+  const std::vector<UnitFace> expected = perVoxelFaces(voxels, kSide);
+
+  VoxelSurfaceMesh mesh;
+  mesh.update(voxels.data(), VoxelSurfaceMesh::Kind::INT, kSide, kSide,
+              kSide);
+  assert(rasterise(mesh.quads()) == expected);
+  assert(mesh.exposedFaces() == expected.size());
+  assert(mesh.quads().size() < expected.size());
+  for (const SurfaceQuad &q : mesh.quads()) {
+    assert(woundOutwards(q));
+  }
+  std::cout << "✓ Merged quads test passed" << std::endl;
+}
+
+void testUpdateRebuildsOnlyOnChange() {
+  std::cout << "Testing when update() rebuilds..." << std::endl;
+  constexpr int kSide = 8;
+  std::vector<int> voxels = buildTerrain(kSide);
+
+  VoxelSurfaceMesh mesh;
+  assert(mesh.update(voxels.data(), VoxelSurfaceMesh::Kind::INT, kSide,
+                     kSide, kSide));
+  assert(!mesh.update(voxels.data(), VoxelSurfaceMesh::Kind::INT, kSide,
+                      kSide, kSide));
+
+  // Edited in place, as Python does through the same buffer.
+  voxels[voxels.size() - 1] = 9;
+  assert(mesh.update(voxels.data(), VoxelSurfaceMesh::Kind::INT, kSide,
+                     kSide, kSide));
+  assert(rasterise(mesh.quads()) == perVoxelFaces(voxels, kSide));
+
+  // Same contents under a new shape or at a new address.
+  assert(mesh.update(voxels.data(), VoxelSurfaceMesh::Kind::INT, kSide,
+                     kSide * kSide, 1));
+  std::vector<int> copy = voxels;
+  assert(mesh.update(copy.data(), VoxelSurfaceMesh::Kind::INT, kSide, kSide,
+                     kSide));
+  assert(!mesh.update(copy.data(), VoxelSurfaceMesh::Kind::INT, kSide, kSide,
+                      kSide));
+  std::cout << "✓ Rebuild test passed" << std::endl;
+}
+
+void testFloatArraysUseThreshold() {
+  std::cout << "Testing float arrays..." << std::endl;
+  std::vector<float> voxels(8, 0.0f);
+  voxels[0] = 0.0005f; // below the threshold: empty
+  voxels[1] = 2.7f;    // drawn with value 2
+
+  VoxelSurfaceMesh mesh;
+  mesh.update(voxels.data(), VoxelSurfaceMesh::Kind::FLOAT, 2, 2, 2);
+  assert(mesh.exposedFaces() == 6);
+  assert(mesh.quads().size() == 6);
+  for (const SurfaceQuad &q : mesh.quads()) {
+    assert(q.value == 2);
+  }
+  std::cout << "✓ Float array test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Voxel Surface Mesh Tests ===" << std::endl;
+
+  testLoneVoxelIsACube();
+  testFlatSlabMergesToOneQuadPerSide();
+  testDifferentValuesDoNotMerge();
+  testQuadsCoverExactlyTheExposedFaces();
+  testUpdateRebuildsOnlyOnChange();
+  testFloatArraysUseThreshold();
+
+  std::cout << "\n🎉 All voxel surface mesh tests passed!" << std::endl;
+  return 0;
+}
@@ -350,6 +350,71 @@ void testHighLevelIterators() {
     std::cout << "✓ High-level iterators test passed!" << std::endl;
 }
 
+void testWriteBatchMatchesSetters() {
+    std::cout << "Testing TerrainWriteBatch against per-voxel setters..." << std::endl;
+
+    TerrainStorage setterStorage, batchStorage;
+    setterStorage.initialize();
+    batchStorage.initialize();
+    entt::registry setterRegistry, batchRegistry;
+    TerrainGridRepository setterRepo(setterRegistry, setterStorage);
+    TerrainGridRepository batchRepo(batchRegistry, batchStorage);
+
+    // Writes spread over two leaves, including zero matter / velocity and a
+    // delete, applied leaf-sorted on one side and one setter at a time on
+    // the other.
+    TerrainWriteBatch batch(TerrainWriteOrder::BY_LEAF);
+    const int xs[] = {1, 2, 9, 15};
+    for (int x : xs) {
+        EntityTypeComponent etc{0, 1, 0};
+        MatterContainer mc{0, 0, x, 0};
+        StructuralIntegrityComponent sic{false, -1, MatterState::LIQUID, {0.f, 0.f, 0.f}};
+        PhysicsStats ps{3.0f, 5.0f, 1.0f, 0.f, 0.f, 0.f, 0.f};
+        Velocity vel{0.f, 0.f, x % 2 ? -1.f : 0.f};
+        Position pos{x, 1, 1, DirectionEnum::DOWN};
+
+        setterRepo.setTerrainId(x, 1, 1, -1);
+        setterRepo.setTerrainEntityType(x, 1, 1, etc);
+        setterRepo.setTerrainMatterContainer(x, 1, 1, mc);
+        setterRepo.setTerrainStructuralIntegrity(x, 1, 1, sic);
+        setterRepo.setPhysicsStats(x, 1, 1, ps);
+        setterRepo.setVelocity(x, 1, 1, vel);
+        setterRepo.setPosition(x, 1, 1, pos);
+
+        batch.setTerrainId(x, 1, 1, -1);
+        batch.setTerrainEntityType(x, 1, 1, etc);
+        batch.setTerrainMatterContainer(x, 1, 1, mc);
+        batch.setTerrainStructuralIntegrity(x, 1, 1, sic);
+        batch.setPhysicsStats(x, 1, 1, ps);
+        batch.setVelocity(x, 1, 1, vel);
+        batch.setPosition(x, 1, 1, pos);
+    }
+    setterStorage.deleteTerrain(9, 1, 1);
+    batch.deleteTerrain(9, 1, 1);
+    batchRepo.applyWriteBatch(batch);
+    assert(batch.empty());
+
+    for (int x : xs) {
+        TerrainInfo a = setterRepo.readTerrainInfo(x, 1, 1);
+        TerrainInfo b = batchRepo.readTerrainInfo(x, 1, 1);
+        assert(setterRepo.getTerrainIdIfExists(x, 1, 1) == batchRepo.getTerrainIdIfExists(x, 1, 1));
+        assert(a.stat.mainType == b.stat.mainType);
+        assert(a.stat.subType0 == b.stat.subType0);
+        assert(a.stat.subType1 == b.stat.subType1);
+        assert(a.stat.matter.WaterMatter == b.stat.matter.WaterMatter);
+        assert(a.stat.mass == b.stat.mass);
+        assert(a.stat.maxSpeed == b.stat.maxSpeed);
+        assert(a.stat.direction == b.stat.direction);
+        assert(a.stat.matterState == b.stat.matterState);
+        assert(a.stat.maxLoadCapacity == b.stat.maxLoadCapacity);
+        assert(setterRepo.getVelocity(x, 1, 1).vz == batchRepo.getVelocity(x, 1, 1).vz);
+    }
+    assert(setterRepo.countActiveWaterMatterVoxels() == batchRepo.countActiveWaterMatterVoxels());
+    assert(setterRepo.countActiveVelocityVoxels() == batchRepo.countActiveVelocityVoxels());
+
+    std::cout << "✓ Write batch test passed!" << std::endl;
+}
+
 int main() {
     std::cout << "=== Terrain Storage Water Simulation C++ Tests ===" << std::endl;
     std::cout << std::endl;
@@ -375,6 +440,10 @@ int main() {
         // Test high-level repository iterators
         testHighLevelIterators();
         std::cout << std::endl;
+
+        testWriteBatchMatchesSetters();
+        std::cout << std::endl;
+
         
         std::cout << "🎉 All tests passed successfully!" << std::endl;
         std::cout << std::endl;
@@ -0,0 +1,139 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+#include "physics/WaveField.hpp"
+
+/**
+ * WaveField tests
+ *
+ * An injected pulse peaks at its amplitude on the given voxel, and
+ * nothing outside the extent is ever written. A pulse in the middle of a
+ * cube must spread the same way along all six axes, keep its leading edge
+ * near speed * tick until it reaches the walls, never exceed the injected
+ * amplitude, and release every tile once it has decayed, also when the
+ * speed needs substeps.
+ */
+
+namespace {
+
+constexpr float kDamping = 0.05f;
+constexpr float kThreshold = 0.001f;
+
+// Tiles sit on the same grid along every axis, so the field must match
+// under axis swaps up to rounding. Mirrored voxels (+x vs -x) sit at
+// different offsets within their tiles; tiles appear and retire at the
+// amplitude threshold, so those can differ by about that much.
+bool same(float a, float b) {
+  return std::fabs(a - b) <= 1e-6f + 1e-4f * std::fabs(a);
+}
+
+bool mirrored(float a, float b) {
+  return std::fabs(a - b) <= 2.0f * kThreshold;
+}
+
+void testInjectStaysInBounds() {
+  std::cout << "Testing inject..." << std::endl;
+  WaveField field(20, 20, 20);
+  assert(field.activeTiles() == 0);
+  field.advance(1.0f, kDamping, kThreshold); // nothing to advance
+  assert(field.activeTiles() == 0);
+
+  field.inject(10, 10, 10, 2.0f);
+  assert(field.sample(10, 10, 10) == 2.0f);
+  assert(field.sample(11, 10, 10) > 0.0f);
+  assert(field.sample(11, 10, 10) < 2.0f);
+  assert(field.activeTiles() > 0);
+
+  // The pulse spills over the corner; nothing lands outside [0, 20).
+  field.clear();
+  field.inject(0, 0, 19, 1.0f);
+  assert(field.sample(0, 0, 19) == 1.0f);
+  assert(field.sample(-1, 0, 19) == 0.0f);
+  assert(field.sample(0, -1, 19) == 0.0f);
+  assert(field.sample(0, 0, 20) == 0.0f);
+  for (int i = 0; i < 30; ++i) {
+    field.advance(1.0f, kDamping, kThreshold);
+    assert(field.sample(-1, 0, 19) == 0.0f);
+    assert(field.sample(0, 0, 20) == 0.0f);
+  }
+
+  // A stopped wave does not move.
+  field.clear();
+  field.inject(10, 10, 10, 1.0f);
+  field.advance(0.0f, kDamping, kThreshold);
+  assert(field.sample(10, 10, 10) == 1.0f);
+  std::cout << "✓ Inject test passed" << std::endl;
+}
+
+// Runs a unit pulse from the middle of a `side` cube until every tile is
+// gone, checking the field after each tick.
+void checkPulse(int side, float speed) {
+  // Odd extent so the walls are as far from the centre on every side.
+  const int c = side / 2;
+  WaveField field(2 * c + 1, 2 * c + 1, 2 * c + 1);
+  field.inject(c, c, c, 1.0f);
+
+  const int maxTicks =
+      static_cast<int>(static_cast<float>(side) * 8.0f / speed);
+  int tick = 0;
+  bool reachedWall = false;
+  while (field.activeTiles() != 0 && tick < maxTicks) {
+    field.advance(speed, kDamping, kThreshold);
+    ++tick;
+
+    // Same amplitude at the same distance along every axis. Once the wave
+    // has bounced off the walls the threshold error can build up, so
+    // mirrors are only compared until then.
+    const float front = speed * static_cast<float>(tick);
+    const bool beforeWall = front < static_cast<float>(c);
+    reachedWall |= !beforeWall;
+    int edge = 0;
+    for (int d = 0; d <= c; ++d) {
+      const float v = field.sample(c + d, c, c);
+      const float m = field.sample(c - d, c, c);
+      assert(same(v, field.sample(c, c + d, c)));
+      assert(same(v, field.sample(c, c, c + d)));
+      assert(same(m, field.sample(c, c - d, c)));
+      assert(same(m, field.sample(c, c, c - d)));
+      assert(!beforeWall || mirrored(v, m));
+      assert(std::fabs(v) <= 1.0f);
+      if (std::fabs(v) > 2.0f * kThreshold) {
+        edge = d;
+      }
+    }
+
+    // Until it reaches the wall, the leading edge travels at `speed`.
+    // The injected pulse starts a few voxels wide.
+    if (front >= 8.0f && front < static_cast<float>(c) - 8.0f) {
+      assert(edge >= front - 4.0f && edge <= front + 6.0f);
+    }
+  }
+  assert(reachedWall);
+  assert(field.activeTiles() == 0 && field.activeVoxels() == 0);
+}
+
+void testPulseSpreadsEvenly() {
+  std::cout << "Testing a pulse at one voxel per tick..." << std::endl;
+  checkPulse(48, 1.0f);
+  std::cout << "✓ Unit speed test passed" << std::endl;
+}
+
+void testSubstepsKeepPace() {
+  std::cout << "Testing a pulse that needs substeps..." << std::endl;
+  checkPulse(48, 1.5f);
+  std::cout << "✓ Substep test passed" << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== WaveField Tests ===" << std::endl;
+
+  testInjectStaysInBounds();
+  testPulseSpreadsEvenly();
+  testSubstepsKeepPace();
+
+  std::cout << "\n🎉 All WaveField tests passed!" << std::endl;
+  return 0;
+}
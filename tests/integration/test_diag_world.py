@@ -8,6 +8,7 @@ from __future__ import annotations
 
 import gc
 import time
+import uuid
 
 from aetherion import World
 from aetherion._aetherion import diag
@@ -88,3 +89,106 @@ def test_physics_metric_names_unchanged():
         world.release_python_state()
         del world
         gc.collect()
+
+
+def test_flush_all_is_a_barrier_for_the_gamedb_writer():
+    """GameDBSink samples go through the async writer thread; flush_all()
+    must not return until they are committed, so a query issued right
+    after it sees the value without sleeping or polling."""
+    world = World(3, 3, 3)
+    try:
+        name = f"test.diag_world.barrier.{uuid.uuid4().hex[:8]}"
+        c = diag.counter(name, flush_every_ms=60_000)
+        c.inc(42)
+        diag.flush_all()
+
+        stats = diag.writer_stats()
+        assert stats["enqueued"] >= 1
+        assert stats["written"] + stats["failed"] == stats["enqueued"]
+        assert stats["dropped"] == 0
+
+        rows = world.query_time_series(name, 0, 2**40)
+        assert [v for _, v in rows] == [42.0]
+    finally:
+        world.release_python_state()
+        del world
+        gc.collect()
+
+
+def test_world_teardown_stops_gamedb_writer():
+    world = World(3, 3, 3)
+    world.release_python_state()
+    del world
+    gc.collect()
+    # ~World joins the writer thread that writes to its GameDB.
+    assert diag.writer_stats()["enqueued"] == 0
+
+
+def test_older_world_teardown_keeps_the_newer_worlds_metrics():
+    """The Registry belongs to the World created last. Destroying an
+    older World must not unregister its metrics or stop its writer."""
+    older = World(3, 3, 3)
+    newer = World(3, 3, 3)
+    try:
+        older.release_python_state()
+        del older
+        gc.collect()
+
+        assert diag.is_enabled("physics_move_gas_entity")
+        name = f"test.diag_world.survivor.{uuid.uuid4().hex[:8]}"
+        c = diag.counter(name, flush_every_ms=60_000)
+        c.inc(5)
+        diag.flush_all()
+        rows = newer.query_time_series(name, 0, 2**40)
+        assert [v for _, v in rows] == [5.0]
+    finally:
+        newer.release_python_state()
+        del newer
+        gc.collect()
+
+
+def test_histogram_flushes_percentile_series():
+    """A Histogram window lands in GameDB as `<name>.p50/.p90/.p99/.max`.
+    Percentiles come from log-linear buckets, so they are exact to within
+    one sub-bucket (1/16 of the value) and never under-state; max is exact."""
+    world = World(3, 3, 3)
+    try:
+        name = f"test.diag_world.hist.{uuid.uuid4().hex[:8]}"
+        h = diag.histogram(name, flush_every_ms=60_000)
+        for v in range(1, 1001):
+            h.record(v)
+        diag.flush_all()
+
+        def last(suffix):
+            rows = world.query_time_series(name + suffix, 0, 2**40)
+            assert len(rows) == 1
+            return rows[0][1]
+
+        for suffix, expected in ((".p50", 500), (".p90", 900), (".p99", 990)):
+            assert expected <= last(suffix) <= expected * (1 + 1 / 16)
+        assert last(".max") == 1000.0
+
+        # An empty window writes nothing.
+        diag.flush_all()
+        assert len(world.query_time_series(name + ".p50", 0, 2**40)) == 1
+    finally:
+        world.release_python_state()
+        del world
+        gc.collect()
+
+
+def test_world_records_its_latency_histograms():
+    """The dispatcher timer records on every tick, so a flush after a few
+    updates writes its percentile series."""
+    world = World(3, 3, 3)
+    try:
+        for _ in range(3):
+            world.update()
+        diag.flush_all()
+        rows = world.query_time_series("world_dispatcher_update_ns.max", 0, 2**40)
+        assert len(rows) == 1
+        assert rows[0][1] > 0
+    finally:
+        world.release_python_state()
+        del world
+        gc.collect()
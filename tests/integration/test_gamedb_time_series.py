@@ -169,3 +169,44 @@ def test_no_growth_under_steady_inserts(world):
     assert size_a == size_b, (
         f"cache size grew from {size_a} to {size_b} between batches; eviction is not stable at the cap"
     )
+
+
+# ─── Rollup tiers + downsampled query ────────────────────────────────
+
+
+def test_downsampled_query_returns_raw_rows_when_budget_allows(world):
+    series = _unique_series("test.rollup_raw")
+    for ts in range(1_000, 1_050):
+        world.put_time_series(series, ts, float(ts))
+    buckets = world.query_time_series_downsampled(series, 1_000, 1_049, max_points=100)
+    assert len(buckets) == 50
+    assert buckets[0] == (1_000, 1_000.0, 1_000.0, 1_000.0, 1)
+
+
+def test_downsampled_query_picks_rollup_tier_within_budget(world):
+    """One hour of 1 Hz data with a 100-point budget lands on the 60 s
+    tier: 60 buckets (61 when the range straddles a bucket edge), each
+    folding 60 samples into min/max/mean/count."""
+    series = _unique_series("test.rollup_tier")
+    base = 120_000  # aligned to 60 s and 600 s
+    for i in range(3_600):
+        world.put_time_series(series, base + i, float(i))
+    buckets = world.query_time_series_downsampled(series, base, base + 3_599, max_points=100)
+    assert len(buckets) == 60
+    ts, lo, hi, mean, count = buckets[0]
+    assert ts == base
+    assert (lo, hi, count) == (0.0, 59.0, 60)
+    assert mean == pytest.approx(29.5)
+    assert sum(b[4] for b in buckets) == 3_600
+
+
+def test_downsampled_query_falls_back_to_coarsest_tier(world):
+    series = _unique_series("test.rollup_coarsest")
+    base = 600_000
+    for i in range(0, 3_600, 5):
+        world.put_time_series(series, base + i, 1.0)
+    buckets = world.query_time_series_downsampled(series, base, base + 3_599, max_points=2)
+    # 10-minute tier is the coarsest; six buckets exceed the budget but
+    # are still far fewer than the 720 raw rows.
+    assert len(buckets) == 6
+    assert all(b[4] == 120 for b in buckets)
@@ -22,6 +22,7 @@ import time
 from collections.abc import Iterable
 from dataclasses import dataclass
 
+import numpy as np
 import pytest
 
 import aetherion
@@ -178,6 +179,26 @@ def test_create_perception_responses_handles_single_observer():
     assert len(responses[pid]) > 0
 
 
+def test_packed_perception_responses_match_the_dict():
+    world = _make_world(32, 32, 4)
+    ids = _spawn_perceivers(world, [(5, 5), (15, 15), (25, 25)], perception_area=3)
+
+    expected = world.create_perception_responses({eid: [] for eid in ids})
+    packed_ids, offsets, data = world.create_perception_responses_packed({eid: [] for eid in ids})
+
+    assert packed_ids.dtype == np.int32 and offsets.dtype == np.int64 and data.dtype == np.uint8
+    assert len(offsets) == len(packed_ids) + 1 and offsets[0] == 0 and offsets[-1] == len(data)
+    assert sorted(packed_ids.tolist()) == sorted(ids)
+    for i, eid in enumerate(packed_ids.tolist()):
+        assert data[offsets[i] : offsets[i + 1]].tobytes() == expected[eid]
+
+
+def test_packed_perception_responses_handle_no_observers():
+    world = _make_world(8, 8, 4)
+    packed_ids, offsets, data = world.create_perception_responses_packed({})
+    assert len(packed_ids) == 0 and offsets.tolist() == [0] and len(data) == 0
+
+
 # ────────────────────────────────────────────────────────────────────────────
 # Scaling along one axis at a time. Each test prints µs/call so a `-s` run
 # makes the growth curve visible without needing a separate benchmark tool.
@@ -203,6 +224,25 @@ def test_perception_time_grows_with_perception_area(perception_area):
     assert elapsed < 1.0  # ceiling, not a tight assertion
 
 
+@pytest.mark.parametrize("perception_area", [1, 3, 5, 10, 16])
+def test_perception_payload_bytes_with_perception_area(perception_area):
+    """Single observer, fixed world; bytes per response as the view grows.
+
+    The voxel layers are sent palette/run-length or bitmask encoded when
+    that is smaller, so the payload should stay well under the dense
+    ``2 × 4 × volume`` bytes printed next to it.
+    """
+    world = _make_world(64, 64, 4)
+    [pid] = _spawn_perceivers(world, [(32, 32)], perception_area=perception_area)
+
+    responses = world.create_perception_responses({pid: []})
+    payload_bytes = len(responses[pid])
+    dense_bytes = 2 * 4 * (2 * perception_area + 1) ** 2 * 3
+
+    print(f"[area={perception_area:>2}] {payload_bytes:>8} B per response ({dense_bytes:>8} B as dense voxel arrays)")
+    assert payload_bytes > 0
+
+
 @pytest.mark.parametrize("entity_count", [1, 4, 16, 64])
 def test_perception_time_grows_with_entity_count(entity_count):
     """Fixed world, fixed perception_area; sweep observer count.
@@ -226,6 +266,28 @@ def test_perception_time_grows_with_entity_count(entity_count):
     assert elapsed < 5.0
 
 
+@pytest.mark.parametrize("entity_count", [16, 64])
+def test_packed_perception_time_against_the_dict(entity_count):
+    """Same observers through both calls; the packed one skips the
+    per-observer bytes objects and dict inserts under the GIL."""
+    world = _make_world(128, 128, 4)
+    ids = _spawn_perceivers(world, _grid_positions(entity_count, world_size=128), perception_area=3)
+
+    def median(call):
+        samples = []
+        for _ in range(5):
+            t0 = time.perf_counter()
+            call({eid: [] for eid in ids})
+            samples.append(time.perf_counter() - t0)
+        return sorted(samples)[len(samples) // 2]
+
+    as_dict = median(world.create_perception_responses)
+    packed = median(world.create_perception_responses_packed)
+
+    print(f"[entities={entity_count:>3}] dict {as_dict * 1e6:>9.1f} µs / packed {packed * 1e6:>9.1f} µs")
+    assert packed < 5.0
+
+
 @pytest.mark.parametrize("world_dim", [16, 32, 64, 128])
 def test_perception_time_flat_with_world_size_when_count_held_constant(world_dim):
     """One observer, fixed perception_area, vary world dimensions.
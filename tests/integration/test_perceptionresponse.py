@@ -1,10 +1,18 @@
+import pytest
+
 from aetherion import (
+    ComponentFlag,
     DirectionEnum,
     EntityInterface,
+    EntityWireFormat,
+    HealthComponent,
+    Inventory,
     PerceptionResponse,
     PerceptionResponseFlatB,
     Position,
     WorldView,
+    get_entity_wire_format,
+    set_entity_wire_format,
 )
 
 
@@ -95,3 +103,68 @@ def test_perception_response_flatbuffer_access():
 
     flatb_accessor = PerceptionResponseFlatB(serialized_data)
     assert flatb_accessor.getWorldView().get_entity(1, 1, 1).get_position().x == entity1.get_position().x
+
+
+def _tables_and_blob_entity():
+    entity = EntityInterface()
+    entity.set_entity_id(5)
+    position = Position()
+    position.x = 3
+    position.y = 4
+    position.z = 5
+    position.direction = DirectionEnum.LEFT
+    entity.set_position(position)
+    health = HealthComponent()
+    health.health_level = 12.5
+    health.max_health = 40.0
+    entity.set_health(health)
+    inventory = Inventory()
+    inventory.max_items = 2
+    inventory.resize(2)
+    inventory.add_item(77)
+    entity.set_inventory(inventory)
+    return entity
+
+
+def _empty_world_view():
+    world_view = WorldView()
+    world_view.voxelGridView.initVoxelGridView(3, 3, 3, 0, 0, 0)
+    return world_view
+
+
+def test_perception_response_entity_view_reads_table_components():
+    entity = _tables_and_blob_entity()
+    serialized = PerceptionResponse(entity, _empty_world_view()).serialize_flatbuffer()
+    pr_flatb = PerceptionResponseFlatB(serialized)
+
+    view = pr_flatb.get_entity_view()
+    assert view.get_entity_id() == 5
+    assert view.has_component(ComponentFlag.POSITION)
+    assert view.has_component(ComponentFlag.HEALTH)
+    assert view.has_component(ComponentFlag.INVENTORY)
+    assert not view.has_component(ComponentFlag.VELOCITY)
+    assert view.get_position().x == 3
+    assert view.get_position().direction == DirectionEnum.LEFT
+    assert view.get_health().max_health == pytest.approx(40.0)
+    # Blob components come from the full decode.
+    assert list(view.get_entity().get_inventory().item_ids) == [77, -1]
+
+
+@pytest.mark.parametrize("wire_format", [EntityWireFormat.BLOB, EntityWireFormat.TABLES])
+def test_perception_response_entity_wire_formats_round_trip(wire_format):
+    entity = _tables_and_blob_entity()
+    world_view = _empty_world_view()
+    world_view.entities[5] = entity
+    previous = get_entity_wire_format()
+    set_entity_wire_format(wire_format)
+    try:
+        serialized = PerceptionResponse(entity, world_view).serialize_flatbuffer()
+    finally:
+        set_entity_wire_format(previous)
+
+    pr_flatb = PerceptionResponseFlatB(serialized)
+    assert pr_flatb.getEntity().serialize() == entity.serialize()
+    assert pr_flatb.get_entity_view().get_position().y == 4
+
+    decoded_wv = WorldView.deserialize_flatbuffer(pr_flatb.getWorldView())
+    assert decoded_wv.entities[5].serialize() == entity.serialize()
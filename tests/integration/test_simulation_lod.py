@@ -0,0 +1,64 @@
+"""Simulation LOD — slower update cadence far from observers.
+
+`world.configure_simulation_lod` cuts the map into square regions and
+levels them by distance to the nearest observer (perceiving entities plus
+`world.set_lod_observers` points); `world.get_simulation_lod_stats` reads
+back the regions and updates per level of the last complete tick.
+"""
+
+from __future__ import annotations
+
+import gc
+
+import pytest
+
+from aetherion import World
+
+
+@pytest.fixture
+def world():
+    w = World(64, 64, 3)
+    try:
+        yield w
+    finally:
+        w.release_python_state()
+        del w
+        gc.collect()
+
+
+def _regions(stats):
+    return {name: level["regions"] for name, level in stats["levels"].items()}
+
+
+def test_lod_is_off_by_default(world):
+    world.update()
+    stats = world.get_simulation_lod_stats()
+    assert stats["tick"] == 0
+    assert _regions(stats) == {"near": 0, "mid": 0, "far": 0}
+
+
+def test_regions_are_levelled_by_observer_distance(world):
+    # 8 x 8 regions of 8 voxels; one observer in the corner region.
+    world.configure_simulation_lod(True, region_size=8, near_regions=1, mid_regions=3)
+    world.set_lod_observers([(0, 0, 1)])
+    world.update()
+    world.update()
+
+    stats = world.get_simulation_lod_stats()
+    assert stats["tick"] > 0
+    assert _regions(stats) == {"near": 4, "mid": 12, "far": 48}
+
+    # Observers are replaced, not added: a second corner moves the levels.
+    world.set_lod_observers([(0, 0, 1), (63, 63, 1)])
+    world.update()
+    world.update()
+    assert _regions(world.get_simulation_lod_stats()) == {"near": 8, "mid": 24, "far": 32}
+
+
+def test_disabling_lod_clears_the_stats(world):
+    world.configure_simulation_lod(True)
+    world.update()
+    world.update()
+    world.configure_simulation_lod(False)
+    world.update()
+    assert world.get_simulation_lod_stats()["tick"] == 0
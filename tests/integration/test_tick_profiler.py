@@ -0,0 +1,95 @@
+"""World tick profiler — per-phase timings without Tracy.
+
+World::update() records each phase's wall time into a ring buffer that
+`world.get_tick_profile(n)` reads back and `world.export_tick_profile`
+dumps as Chrome trace-event JSON.
+"""
+
+from __future__ import annotations
+
+import gc
+import json
+
+import pytest
+
+from aetherion import World
+
+
+@pytest.fixture
+def world():
+    w = World(3, 3, 3)
+    try:
+        yield w
+    finally:
+        w.release_python_state()
+        del w
+        gc.collect()
+
+
+ALWAYS_RUN = {
+    "health",
+    "diag.tick",
+    "dispatcher.update",
+    "physics",
+    "ecosystem",
+    "effects",
+    "python_systems",
+    "async_dispatch",
+}
+
+
+def test_get_tick_profile_reports_each_phase(world):
+    for _ in range(5):
+        world.update()
+
+    profile = world.get_tick_profile(3)
+    assert len(profile) == 3
+    assert [t["tick"] for t in profile] == sorted(t["tick"] for t in profile)
+    for t in profile:
+        assert ALWAYS_RUN <= set(t["phases"])
+        assert all(ms >= 0.0 for ms in t["phases"].values())
+        # Phases run back to back inside the tick, never longer than it.
+        assert sum(t["phases"].values()) <= t["total_ms"] + 1e-6
+
+
+def test_tick_profiler_can_be_disabled(world):
+    world.update()
+    world.tick_profiler_enabled = False
+    world.update()
+    world.update()
+    assert len(world.get_tick_profile(0)) == 1
+    world.tick_profiler_enabled = True
+    world.update()
+    assert len(world.get_tick_profile(0)) == 2
+
+
+def test_export_tick_profile_writes_chrome_trace(world, tmp_path):
+    for _ in range(4):
+        world.update()
+
+    path = tmp_path / "ticks.json"
+    assert world.export_tick_profile(str(path), 2) == 2
+
+    trace = json.loads(path.read_text())
+    events = trace["traceEvents"]
+    ticks = [e for e in events if e["cat"] == "tick"]
+    assert len(ticks) == 2
+    assert all(e["ph"] == "X" and e["dur"] >= 0 for e in events)
+    assert {e["name"] for e in events if e["cat"] == "phase"} >= ALWAYS_RUN
+
+
+
+def test_phase_spans_do_not_overlap(world, tmp_path):
+    # Each phase is entered once per tick, so its span ends before the next
+    # phase starts instead of stretching over the phases in between.
+    for _ in range(3):
+        world.update()
+
+    path = tmp_path / "ticks.json"
+    assert world.export_tick_profile(str(path), 1) == 1
+
+    events = json.loads(path.read_text())["traceEvents"]
+    phases = sorted((e for e in events if e["cat"] == "phase"), key=lambda e: e["ts"])
+    assert {e["name"] for e in phases} >= ALWAYS_RUN
+    for prev, nxt in zip(phases, phases[1:]):
+        assert prev["ts"] + prev["dur"] <= nxt["ts"] + 1e-3
@@ -1,6 +1,7 @@
+import numpy as np
 import pytest
 
-from aetherion import World
+from aetherion import EntityTypeComponent, HealthComponent, MovingComponent, Position, World
 
 
 class TestWorldCreation:
@@ -310,3 +311,176 @@ class TestWorldWaterSimulationToggles:
         world.simulate_water_movement = False
         assert world.simulate_water_movement is False
         world.simulate_water_movement = True
+
+
+class TestRegistryComponentArrays:
+    """NumPy views of component pools from PyRegistry.component_arrays."""
+
+    def _registry_with_positions(self, count):
+        world = World(3, 3, 3)
+        registry = world.get_py_registry()
+        ids = []
+        for i in range(count):
+            entity = registry.create_entity()
+            pos = Position()
+            pos.x, pos.y, pos.z = i, 2 * i, 1
+            registry.set_component(entity, "Position", pos)
+            ids.append(entity)
+        return world, registry, ids
+
+    def test_arrays_match_components(self):
+        world, registry, ids = self._registry_with_positions(5)
+        pages = registry.component_arrays("Position")
+        assert len(pages) == 1
+        entity_ids, positions = pages[0]
+        assert sorted(entity_ids.tolist()) == sorted(ids)
+        for entity, row in zip(entity_ids.tolist(), positions):
+            pos = registry.get_component(entity, "Position")
+            assert (row["x"], row["y"], row["z"]) == (pos.x, pos.y, pos.z)
+
+    def test_writes_reach_the_registry(self):
+        world, registry, ids = self._registry_with_positions(4)
+        for entity in ids:
+            registry.set_component(entity, "HealthComponent", HealthComponent())
+        entity_ids, healths = registry.component_arrays("HealthComponent")[0]
+        healths["health_level"] = 42.0
+        for entity in entity_ids.tolist():
+            health = registry.get_component(entity, "HealthComponent")
+            assert health.health_level == 42.0
+
+    def test_indexed_components_are_read_only(self):
+        world, registry, ids = self._registry_with_positions(4)
+        for entity in ids:
+            registry.set_component(entity, "EntityTypeComponent", EntityTypeComponent())
+            registry.set_component(entity, "MovingComponent", MovingComponent())
+        for name in ("Position", "EntityTypeComponent", "MovingComponent"):
+            _, rows = registry.component_arrays(name)[0]
+            assert not rows.flags.writeable
+            with pytest.raises(ValueError):
+                rows[rows.dtype.names[0]] = 1
+
+    def test_pools_split_into_pages(self):
+        world, registry, ids = self._registry_with_positions(1500)
+        pages = registry.component_arrays("Position")
+        assert [len(entity_ids) for entity_ids, _ in pages] == [1024, 476]
+        assert all(len(e) == len(c) for e, c in pages)
+
+    def test_empty_pool_and_unknown_component(self):
+        world = World(3, 3, 3)
+        registry = world.get_py_registry()
+        assert registry.component_arrays("Velocity") == []
+        with pytest.raises(ValueError):
+            registry.component_arrays("Inventory")
+
+
+class TestMovingComponentTimeRemaining:
+    """time_remaining read from Python follows the movement schedule."""
+
+    def test_reads_count_down(self):
+        world = World(3, 3, 3)
+        registry = world.get_py_registry()
+        entity = registry.create_entity()
+        moving = MovingComponent()
+        moving.is_moving = True
+        moving.completion_time = 50
+        moving.time_remaining = 50
+        registry.set_component(entity, "MovingComponent", moving)
+
+        for _ in range(3):
+            world.update()
+
+        assert registry.get_component(entity, "MovingComponent").time_remaining == 47
+        entity_ids, rows = registry.component_arrays("MovingComponent")[0]
+        assert entity_ids.tolist() == [entity]
+        assert rows["time_remaining"][0] == 47
+
+    def test_writing_the_read_value_back_keeps_the_schedule(self):
+        world = World(3, 3, 3)
+        registry = world.get_py_registry()
+        entity = registry.create_entity()
+        moving = MovingComponent()
+        moving.completion_time = 10
+        moving.time_remaining = 10
+        registry.set_component(entity, "MovingComponent", moving)
+
+        world.update()
+        moving = registry.get_component(entity, "MovingComponent")
+        registry.set_component(entity, "MovingComponent", moving)
+        world.update()
+        assert registry.get_component(entity, "MovingComponent").time_remaining == 8
+
+
+class TestEntityTypeQueries:
+    """get_entities_by_type and friends, answered from the World's type index."""
+
+    def _set_type(self, registry, entity, main_type, sub_type0):
+        etc = EntityTypeComponent()
+        etc.main_type, etc.sub_type0, etc.sub_type1 = main_type, sub_type0, 0
+        registry.set_component(entity, "EntityTypeComponent", etc)
+
+    def _typed_world(self):
+        world = World(3, 3, 3)
+        registry = world.get_py_registry()
+        ids = {}
+        for i in range(24):
+            entity = registry.create_entity()
+            key = (1 + i % 2, i % 3)
+            self._set_type(registry, entity, *key)
+            ids.setdefault(key, []).append(entity)
+        return world, registry, ids
+
+    def test_queries_return_every_entity_of_the_type(self):
+        world, registry, ids = self._typed_world()
+        for (main_type, sub_type0), expected in ids.items():
+            array = world.get_entity_id_array_by_type(main_type, sub_type0)
+            assert array.dtype == np.int32
+            assert sorted(array.tolist()) == sorted(expected)
+            entities = world.get_entities_by_type(main_type, sub_type0)
+            assert sorted(entities.keys()) == sorted(expected)
+        assert len(world.get_entity_id_array_by_type(9, 9)) == 0
+
+    def test_retyped_and_destroyed_entities_move(self):
+        world, registry, ids = self._typed_world()
+        moved, destroyed = ids[(1, 0)][:2]
+        self._set_type(registry, moved, 2, 2)
+        registry.destroy_entity(destroyed)
+        remaining = world.get_entity_id_array_by_type(1, 0).tolist()
+        assert sorted(remaining) == sorted(ids[(1, 0)][2:])
+        assert moved in world.get_entity_id_array_by_type(2, 2).tolist()
+
+    def test_ids_by_type_only_lists_perceiving_entities(self):
+        world, registry, ids = self._typed_world()
+        assert world.get_entity_ids_by_type(1, 0) == []
+
+
+class TestEntitySpatialQueries:
+    """get_entity_ids_in_radius and get_nearest_entity_ids, from the entity spatial index."""
+
+    def _placed_world(self):
+        world = World(32, 32, 4)
+        grid = world.get_voxel_grid()
+        cells = {7: (2, 2, 1), 8: (4, 2, 1), 9: (2, 9, 1), 10: (30, 30, 3)}
+        for entity_id, (x, y, z) in cells.items():
+            grid.set_entity(x, y, z, entity_id)
+        return world, grid
+
+    def test_radius_query(self):
+        world, _ = self._placed_world()
+        ids = world.get_entity_ids_in_radius(2, 2, 1, 2.0)
+        assert ids.dtype == np.int32
+        assert sorted(ids.tolist()) == [7, 8]
+        assert sorted(world.get_entity_ids_in_radius(2, 2, 1, 7.0).tolist()) == [7, 8, 9]
+        assert len(world.get_entity_ids_in_radius(16, 16, 0, 3.0)) == 0
+
+    def test_nearest_query_is_ordered_and_bounded(self):
+        world, _ = self._placed_world()
+        assert world.get_nearest_entity_ids(3, 3, 1, 3).tolist() == [7, 8, 9]
+        assert world.get_nearest_entity_ids(29, 29, 3, 1).tolist() == [10]
+        assert world.get_nearest_entity_ids(2, 2, 1, 4, max_radius=3.0).tolist() == [7, 8]
+
+    def test_index_follows_grid_writes(self):
+        world, grid = self._placed_world()
+        grid.set_entity(4, 2, 1, -1)
+        grid.set_entity(20, 20, 1, 7)
+        assert world.get_entity_ids_in_radius(2, 2, 1, 3.0).tolist() == []
+        assert world.get_nearest_entity_ids(20, 20, 1, 1).tolist() == [7]
@@ -0,0 +1,145 @@
+"""
+Tests for bulk terrain construction from NumPy columns
+(World.load_terrain_box / World.load_terrain_points).
+
+The loaded grids are read back through the same public surface the
+per-voxel path is tested with: world.get_terrain and the
+TerrainGridRepository from world.get_voxel_grid().
+"""
+
+import numpy as np
+import pytest
+
+from aetherion import Inventory, World
+
+ON_GRID_STORAGE = -1
+NONE = -2
+
+
+@pytest.fixture()
+def world():
+    w = World(16, 16, 8)
+    w.initialize_voxel_grid()
+    return w
+
+
+def _repo(world):
+    return world.get_voxel_grid().terrain_grid_repository
+
+
+class TestLoadTerrainBox:
+    def test_box_fills_every_voxel(self, world):
+        shape = (2, 3, 10)  # depth, height, width
+        sub_type0 = np.arange(np.prod(shape), dtype=np.int32).reshape(shape) % 5
+        water = np.zeros(shape, dtype=np.int32)
+        water[1, 2, :] = 7
+        world.load_terrain_box(
+            (3, 4, 1),
+            {
+                "main_type": np.zeros(shape, dtype=np.int32),
+                "sub_type0": sub_type0,
+                "water_matter": water,
+            },
+        )
+        repo = _repo(world)
+        for z in range(shape[0]):
+            for y in range(shape[1]):
+                for x in range(shape[2]):
+                    wx, wy, wz = x + 3, y + 4, z + 1
+                    assert world.get_terrain(wx, wy, wz) == ON_GRID_STORAGE
+                    etc = repo.get_terrain_entity_type(wx, wy, wz)
+                    assert etc.sub_type0 == sub_type0[z, y, x]
+                    mc = repo.get_terrain_matter_container(wx, wy, wz)
+                    assert mc.water_matter == water[z, y, x]
+        assert world.get_terrain(2, 4, 1) == NONE
+
+    def test_none_terrain_id_leaves_voxel_empty(self, world):
+        shape = (1, 1, 4)
+        terrain_id = np.full(shape, ON_GRID_STORAGE, dtype=np.int64)
+        terrain_id[0, 0, 2] = NONE
+        world.load_terrain_box(
+            (0, 0, 0),
+            {"main_type": np.zeros(shape, dtype=np.int32), "terrain_id": terrain_id},
+        )
+        assert [world.get_terrain(x, 0, 0) for x in range(4)] == [-1, -1, -2, -1]
+
+    def test_columns_are_converted(self, world):
+        shape = (1, 2, 2)
+        world.load_terrain_box(
+            (0, 0, 0),
+            {
+                "main_type": np.zeros(shape, dtype=np.int64),
+                "mass": np.full(shape, 3.0),
+                "heat": np.full(shape, 21, dtype=np.int32),
+            },
+        )
+        stats = _repo(world).get_physics_stats(1, 1, 0)
+        assert stats.mass == 3.0
+        assert stats.heat == 21.0
+
+    def test_inventories_become_hybrid_entities(self, world):
+        shape = (1, 1, 3)
+        inventory = Inventory()
+        inventory.max_items = 4
+        ids = world.load_terrain_box(
+            (5, 5, 5),
+            {"main_type": np.zeros(shape, dtype=np.int32)},
+            inventories={(6, 5, 5): inventory},
+        )
+        assert len(ids) == 1
+        assert world.get_terrain(6, 5, 5) == ids[0]
+        assert world.get_terrain(5, 5, 5) == ON_GRID_STORAGE
+        entity = world.get_entity_by_id(ids[0])
+        assert entity.get_position().x == 6
+
+    def test_inventory_outside_the_box_is_rejected(self, world):
+        with pytest.raises(ValueError):
+            world.load_terrain_box(
+                (0, 0, 0),
+                {"main_type": np.zeros((1, 1, 1), dtype=np.int32)},
+                inventories={(3, 3, 3): Inventory()},
+            )
+
+    def test_bad_columns_are_rejected(self, world):
+        with pytest.raises(ValueError):
+            world.load_terrain_box((0, 0, 0), {"sub_type0": np.zeros((1, 1, 1), dtype=np.int32)})
+        with pytest.raises(ValueError):
+            world.load_terrain_box(
+                (0, 0, 0),
+                {
+                    "main_type": np.zeros((1, 1, 2), dtype=np.int32),
+                    "water_matter": np.zeros((1, 1, 3), dtype=np.int32),
+                },
+            )
+        with pytest.raises(ValueError):
+            world.load_terrain_box(
+                (0, 0, 0),
+                {"main_type": np.zeros((1, 1, 1), dtype=np.int32), "colour": np.zeros((1, 1, 1))},
+            )
+
+
+class TestLoadTerrainPoints:
+    def test_points_match_box(self, world):
+        coords = np.array([[1, 1, 1], [9, 1, 1], [2, 12, 3]], dtype=np.int32)
+        sub_type0 = np.array([4, 5, 6], dtype=np.int32)
+        world.load_terrain_points(
+            coords, {"main_type": np.zeros(3, dtype=np.int32), "sub_type0": sub_type0}
+        )
+        repo = _repo(world)
+        for (x, y, z), sub in zip(coords.tolist(), sub_type0.tolist()):
+            assert world.get_terrain(x, y, z) == ON_GRID_STORAGE
+            assert repo.get_terrain_entity_type(x, y, z).sub_type0 == sub
+
+    def test_points_with_inventory(self, world):
+        coords = np.array([[0, 0, 0], [4, 4, 4]], dtype=np.int32)
+        ids = world.load_terrain_points(
+            coords,
+            {"main_type": np.zeros(2, dtype=np.int32)},
+            inventories={(4, 4, 4): Inventory()},
+        )
+        assert world.get_terrain(4, 4, 4) == ids[0]
+        assert world.get_terrain(0, 0, 0) == ON_GRID_STORAGE
+
+    def test_coords_must_be_n_by_3(self, world):
+        with pytest.raises(ValueError):
+            world.load_terrain_points(np.zeros((2, 2), dtype=np.int32), {})
@@ -0,0 +1,40 @@
+import { EntityInterface as FBEntityInterface } from './game-engine/entity-interface.js';
+import { EntityFormat } from './game-engine/entity-format.js';
+import type { AetherionWasmModule } from './wasm/index.js';
+
+// Builds the WASM EntityInterface for a FlatBuffers entity in either wire
+// format (see src/EntityInterfaceFlatB.hpp). BLOB entities are the
+// struct_pack blob alone; TABLES entities carry entity type, position,
+// velocity, health and perception as tables, and the blob (if any) holds
+// the remaining components. Returns null when there is nothing to decode.
+export function decodeEntityFlatB(fb: FBEntityInterface, wasm: AetherionWasmModule): any | null {
+  const bytes = fb.entityDataArray();
+  const tables = fb.format?.() === EntityFormat.TABLES;
+  if (!tables) {
+    return bytes ? wasm.EntityInterface.deserialize(bytes) : null;
+  }
+
+  const ent = bytes && bytes.length > 0 ? wasm.EntityInterface.deserialize(bytes) : new wasm.EntityInterface();
+  const entityType = fb.entityType();
+  if (entityType) {
+    ent.set_entity_type_js({ type: entityType.type(), subType0: entityType.subType0(), subType1: entityType.subType1() });
+  }
+  const position = fb.position();
+  if (position) {
+    ent.set_position_js({ x: position.x(), y: position.y(), z: position.z(), direction: position.direction() });
+  }
+  const velocity = fb.velocity();
+  if (velocity) {
+    ent.set_velocity_js({ vx: velocity.vx(), vy: velocity.vy(), vz: velocity.vz() });
+  }
+  const health = fb.health();
+  if (health) {
+    ent.set_health_js({ healthLevel: health.healthLevel(), maxHealth: health.maxHealth() });
+  }
+  const perception = fb.perception();
+  if (perception) {
+    ent.set_perception_js({ perceptionArea: perception.perceptionArea(), zPerceptionArea: perception.zPerceptionArea() });
+  }
+  if (typeof ent.set_entity_id === 'function') ent.set_entity_id(fb.entityId());
+  return ent;
+}
@@ -4,6 +4,7 @@
 
 export { Component } from './game-engine/component.js';
 export { DirectionEnum } from './game-engine/direction-enum.js';
+export { EntityFormat } from './game-engine/entity-format.js';
 export { EntityInterface } from './game-engine/entity-interface.js';
 export { EntityTypeComponent } from './game-engine/entity-type-component.js';
 export { HealthComponent } from './game-engine/health-component.js';
@@ -3,10 +3,10 @@
 /* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
 
 export enum DirectionEnum {
-  UP = 0,
-  DOWN = 1,
-  LEFT = 2,
-  RIGHT = 3,
-  FORWARD = 4,
-  BACKWARD = 5
+  UP = 1,
+  RIGHT = 2,
+  DOWN = 3,
+  LEFT = 4,
+  UPWARD = 5,
+  DOWNWARD = 6
 }
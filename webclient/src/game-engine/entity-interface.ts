@@ -4,6 +4,14 @@
 
 import * as flatbuffers from 'flatbuffers';
 
+import { EntityFormat } from './entity-format.js';
+import { EntityTypeComponent } from './entity-type-component.js';
+import { HealthComponent } from './health-component.js';
+import { PerceptionComponent } from './perception-component.js';
+import { Position } from './position.js';
+import { Velocity } from './velocity.js';
+
+
 export class EntityInterface {
   bb: flatbuffers.ByteBuffer|null = null;
   bb_pos = 0;
@@ -42,8 +50,43 @@ entityDataArray():Uint8Array|null {
   return offset ? new Uint8Array(this.bb!.bytes().buffer, this.bb!.bytes().byteOffset + this.bb!.__vector(this.bb_pos + offset), this.bb!.__vector_len(this.bb_pos + offset)) : null;
 }
 
+format():EntityFormat {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? this.bb!.readUint8(this.bb_pos + offset) : EntityFormat.BLOB;
+}
+
+componentMask():bigint {
+  const offset = this.bb!.__offset(this.bb_pos, 10);
+  return offset ? this.bb!.readUint64(this.bb_pos + offset) : BigInt('0');
+}
+
+entityType(obj?:EntityTypeComponent):EntityTypeComponent|null {
+  const offset = this.bb!.__offset(this.bb_pos, 12);
+  return offset ? (obj || new EntityTypeComponent()).__init(this.bb!.__indirect(this.bb_pos + offset), this.bb!) : null;
+}
+
+position(obj?:Position):Position|null {
+  const offset = this.bb!.__offset(this.bb_pos, 14);
+  return offset ? (obj || new Position()).__init(this.bb!.__indirect(this.bb_pos + offset), this.bb!) : null;
+}
+
+velocity(obj?:Velocity):Velocity|null {
+  const offset = this.bb!.__offset(this.bb_pos, 16);
+  return offset ? (obj || new Velocity()).__init(this.bb!.__indirect(this.bb_pos + offset), this.bb!) : null;
+}
+
+health(obj?:HealthComponent):HealthComponent|null {
+  const offset = this.bb!.__offset(this.bb_pos, 18);
+  return offset ? (obj || new HealthComponent()).__init(this.bb!.__indirect(this.bb_pos + offset), this.bb!) : null;
+}
+
+perception(obj?:PerceptionComponent):PerceptionComponent|null {
+  const offset = this.bb!.__offset(this.bb_pos, 20);
+  return offset ? (obj || new PerceptionComponent()).__init(this.bb!.__indirect(this.bb_pos + offset), this.bb!) : null;
+}
+
 static startEntityInterface(builder:flatbuffers.Builder) {
-  builder.startObject(2);
+  builder.startObject(7);
 }
 
 static addEntityId(builder:flatbuffers.Builder, entityId:number) {
@@ -54,6 +97,34 @@ static addEntityData(builder:flatbuffers.Builder, entityDataOffset:flatbuffers.O
   builder.addFieldOffset(1, entityDataOffset, 0);
 }
 
+static addFormat(builder:flatbuffers.Builder, format:EntityFormat) {
+  builder.addFieldInt8(2, format, EntityFormat.BLOB);
+}
+
+static addComponentMask(builder:flatbuffers.Builder, componentMask:bigint) {
+  builder.addFieldInt64(3, componentMask, BigInt('0'));
+}
+
+static addEntityType(builder:flatbuffers.Builder, entityTypeOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(4, entityTypeOffset, 0);
+}
+
+static addPosition(builder:flatbuffers.Builder, positionOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(5, positionOffset, 0);
+}
+
+static addVelocity(builder:flatbuffers.Builder, velocityOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(6, velocityOffset, 0);
+}
+
+static addHealth(builder:flatbuffers.Builder, healthOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(7, healthOffset, 0);
+}
+
+static addPerception(builder:flatbuffers.Builder, perceptionOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(8, perceptionOffset, 0);
+}
+
 static createEntityDataVector(builder:flatbuffers.Builder, data:number[]|Uint8Array):flatbuffers.Offset {
   builder.startVector(1, data.length, 1);
   for (let i = data.length - 1; i >= 0; i--) {
@@ -71,10 +142,17 @@ static endEntityInterface(builder:flatbuffers.Builder):flatbuffers.Offset {
   return offset;
 }
 
-static createEntityInterface(builder:flatbuffers.Builder, entityId:number, entityDataOffset:flatbuffers.Offset):flatbuffers.Offset {
+static createEntityInterface(builder:flatbuffers.Builder, entityId:number, entityDataOffset:flatbuffers.Offset, format:EntityFormat, componentMask:bigint, entityTypeOffset:flatbuffers.Offset, positionOffset:flatbuffers.Offset, velocityOffset:flatbuffers.Offset, healthOffset:flatbuffers.Offset, perceptionOffset:flatbuffers.Offset):flatbuffers.Offset {
   EntityInterface.startEntityInterface(builder);
   EntityInterface.addEntityId(builder, entityId);
   EntityInterface.addEntityData(builder, entityDataOffset);
+  EntityInterface.addFormat(builder, format);
+  EntityInterface.addComponentMask(builder, componentMask);
+  EntityInterface.addEntityType(builder, entityTypeOffset);
+  EntityInterface.addPosition(builder, positionOffset);
+  EntityInterface.addVelocity(builder, velocityOffset);
+  EntityInterface.addHealth(builder, healthOffset);
+  EntityInterface.addPerception(builder, perceptionOffset);
   return EntityInterface.endEntityInterface(builder);
 }
 }
@@ -0,0 +1,9 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+export enum VoxelEncoding {
+  DENSE = 0,
+  PALETTE_RLE = 1,
+  SPARSE = 2
+}
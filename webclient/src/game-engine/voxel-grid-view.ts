@@ -4,6 +4,7 @@
 
 import * as flatbuffers from 'flatbuffers';
 
+import { VoxelLayer } from './voxel-layer.js';
 
 
 export class VoxelGridView {
@@ -84,8 +85,18 @@ entityDataArray():Int32Array|null {
   return offset ? new Int32Array(this.bb!.bytes().buffer, this.bb!.bytes().byteOffset + this.bb!.__vector(this.bb_pos + offset), this.bb!.__vector_len(this.bb_pos + offset)) : null;
 }
 
+terrainLayer(obj?:VoxelLayer):VoxelLayer|null {
+  const offset = this.bb!.__offset(this.bb_pos, 20);
+  return offset ? (obj || new VoxelLayer()).__init(this.bb!.__indirect(this.bb_pos + offset), this.bb!) : null;
+}
+
+entityLayer(obj?:VoxelLayer):VoxelLayer|null {
+  const offset = this.bb!.__offset(this.bb_pos, 22);
+  return offset ? (obj || new VoxelLayer()).__init(this.bb!.__indirect(this.bb_pos + offset), this.bb!) : null;
+}
+
 static startVoxelGridView(builder:flatbuffers.Builder) {
-  builder.startObject(8);
+  builder.startObject(10);
 }
 
 static addWidth(builder:flatbuffers.Builder, width:number) {
@@ -154,6 +165,14 @@ static startEntityDataVector(builder:flatbuffers.Builder, numElems:number) {
   builder.startVector(4, numElems, 4);
 }
 
+static addTerrainLayer(builder:flatbuffers.Builder, terrainLayerOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(8, terrainLayerOffset, 0);
+}
+
+static addEntityLayer(builder:flatbuffers.Builder, entityLayerOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(9, entityLayerOffset, 0);
+}
+
 static endVoxelGridView(builder:flatbuffers.Builder):flatbuffers.Offset {
   const offset = builder.endObject();
   return offset;
@@ -167,7 +186,7 @@ static finishSizePrefixedVoxelGridViewBuffer(builder:flatbuffers.Builder, offset
   builder.finish(offset, undefined, true);
 }
 
-static createVoxelGridView(builder:flatbuffers.Builder, width:number, height:number, depth:number, xOffset:number, yOffset:number, zOffset:number, terrainDataOffset:flatbuffers.Offset, entityDataOffset:flatbuffers.Offset):flatbuffers.Offset {
+static createVoxelGridView(builder:flatbuffers.Builder, width:number, height:number, depth:number, xOffset:number, yOffset:number, zOffset:number, terrainDataOffset:flatbuffers.Offset, entityDataOffset:flatbuffers.Offset, terrainLayerOffset:flatbuffers.Offset, entityLayerOffset:flatbuffers.Offset):flatbuffers.Offset {
   VoxelGridView.startVoxelGridView(builder);
   VoxelGridView.addWidth(builder, width);
   VoxelGridView.addHeight(builder, height);
@@ -177,6 +196,8 @@ static createVoxelGridView(builder:flatbuffers.Builder, width:number, height:num
   VoxelGridView.addZOffset(builder, zOffset);
   VoxelGridView.addTerrainData(builder, terrainDataOffset);
   VoxelGridView.addEntityData(builder, entityDataOffset);
+  VoxelGridView.addTerrainLayer(builder, terrainLayerOffset);
+  VoxelGridView.addEntityLayer(builder, entityLayerOffset);
   return VoxelGridView.endVoxelGridView(builder);
 }
 }
@@ -1,6 +1,8 @@
 import * as flatbuffers from 'flatbuffers';
 import { PerceptionResponse } from './game-engine/perception-response.js';
 import { EntityInterface as FBEntityInterface } from './game-engine/entity-interface.js';
+import { EntityFormat } from './game-engine/entity-format.js';
+import { decodeEntityFlatB } from './entity-interface-flatb.js';
 import type { EntityInterface } from './entity-interface.js';
 import { getCachedAetherionWasm, loadAetherionWasm } from './wasm/index.js';
 import { buildDefaultCodecs } from './codecs.js';
@@ -55,13 +57,12 @@ export class PerceptionResponseFlatB {
     this.ensureValid();
     const ent = this._fb.entity();
     if (!ent) return null;
-    const bytes = ent.entityDataArray();
-    if (!bytes) return null;
     // Prefer the already-loaded WASM module for performance, but catch failures.
     const wasm = getCachedAetherionWasm();
     if (wasm && wasm.EntityInterface && typeof wasm.EntityInterface.deserialize === 'function') {
       try {
-        return wasm.EntityInterface.deserialize(bytes) as unknown as EntityInterface;
+        const decoded = decodeEntityFlatB(ent, wasm);
+        if (decoded) return decoded as unknown as EntityInterface;
       } catch (e) {
         try { console.warn('[embind] Deserialize failed:', (e as Error)?.message || e); } catch {}
         // fall through to headerless fallback
@@ -69,10 +70,21 @@ export class PerceptionResponseFlatB {
     }
     // Headerless minimal fallback to keep camera and world decoding functional
     try {
-      const codecs = buildDefaultCodecs();
-      const u8 = bytes as unknown as Uint8Array;
-      const et = codecs.ENTITY_TYPE?.decode(u8, 0);
-      const pos = codecs.POSITION?.decode(u8, 12);
+      let et: any;
+      let pos: any;
+      if (ent.format() === EntityFormat.TABLES) {
+        const t = ent.entityType();
+        const p = ent.position();
+        et = t ? { type: t.type(), sub_type0: t.subType0(), sub_type1: t.subType1() } : undefined;
+        pos = p ? { x: p.x(), y: p.y(), z: p.z(), direction: p.direction() } : undefined;
+      } else {
+        const bytes = ent.entityDataArray();
+        if (!bytes) return null;
+        const codecs = buildDefaultCodecs();
+        const u8 = bytes as unknown as Uint8Array;
+        et = codecs.ENTITY_TYPE?.decode(u8, 0);
+        pos = codecs.POSITION?.decode(u8, 12);
+      }
       const id = typeof ent.entityId === 'function' ? ent.entityId() : 0;
       // Avoid `this`-based accessors so TS doesn’t infer an empty `{}` receiver.
       const fallback = {
@@ -98,11 +110,9 @@ export class PerceptionResponseFlatB {
       const e: FBEntityInterface | null = this._fb.itemsEntities(i);
       if (!e) continue;
       if (e.entityId && e.entityId() === id) {
-  const bytes = e.entityDataArray();
-  if (!bytes) return null;
   const wasm = getCachedAetherionWasm();
   if (wasm && wasm.EntityInterface && typeof wasm.EntityInterface.deserialize === 'function') {
-    return wasm.EntityInterface.deserialize(bytes) as unknown as EntityInterface;
+    return decodeEntityFlatB(e, wasm) as unknown as EntityInterface | null;
   }
   // Trigger background load for future calls.
   // eslint-disable-next-line @typescript-eslint/no-floating-promises
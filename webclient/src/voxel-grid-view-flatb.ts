@@ -1,4 +1,6 @@
 import { VoxelGridView as FBVoxelGridView } from './game-engine/voxel-grid-view.js';
+import { VoxelLayer } from './game-engine/voxel-layer.js';
+import { VoxelEncoding } from './game-engine/voxel-encoding.js';
 
 export type VoxelBounds = {
   xOffset: number;
@@ -9,8 +11,57 @@ export type VoxelBounds = {
   voxelDepth: number;
 };
 
+// Expands a compressed voxel layer (see src/voxelgrid/VoxelLayerCodec.hpp)
+// into the dense x-fastest array the server would otherwise have sent.
+export function decodeVoxelLayer(layer: VoxelLayer, count: number): Int32Array {
+  const out = new Int32Array(count);
+  switch (layer.encoding()) {
+    case VoxelEncoding.PALETTE_RLE: {
+      const palette = layer.paletteArray();
+      const runValues = layer.runValuesArray();
+      const runLengths = layer.runLengthsArray();
+      if (!palette || !runValues || !runLengths) break;
+      let at = 0;
+      for (let r = 0; r < runLengths.length; r++) {
+        out.fill(palette[runValues[r]], at, at + runLengths[r]);
+        at += runLengths[r];
+      }
+      break;
+    }
+    case VoxelEncoding.SPARSE: {
+      const mask = layer.maskArray();
+      const values = layer.valuesArray();
+      out.fill(layer.background());
+      if (!mask || !values) break;
+      let v = 0;
+      for (let i = 0; i < count; i++) {
+        if ((mask[i >> 3] >> (i & 7)) & 1) out[i] = values[v++];
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return out;
+}
+
+// Terrain and entity layers as dense arrays, whichever way they were sent.
+export function denseTerrainData(fb: FBVoxelGridView): Int32Array | null {
+  const layer = fb.terrainLayer?.();
+  if (layer) return decodeVoxelLayer(layer, fb.width() * fb.height() * fb.depth());
+  return fb.terrainDataArray?.() ?? null;
+}
+
+export function denseEntityData(fb: FBVoxelGridView): Int32Array | null {
+  const layer = fb.entityLayer?.();
+  if (layer) return decodeVoxelLayer(layer, fb.width() * fb.height() * fb.depth());
+  return fb.entityDataArray?.() ?? null;
+}
+
 export class VoxelGridViewFlatB {
   private fb: FBVoxelGridView;
+  private terrainCache: Int32Array | null | undefined;
+  private entityCache: Int32Array | null | undefined;
 
   private constructor(fb: FBVoxelGridView) {
     this.fb = fb;
@@ -40,9 +91,15 @@ export class VoxelGridViewFlatB {
     };
   }
 
-  // Raw arrays
-  get terrainData(): Int32Array | null { return this.fb.terrainDataArray?.() ?? null; }
-  get entityData(): Int32Array | null { return this.fb.entityDataArray?.() ?? null; }
+  // Dense arrays; compressed layers are expanded once on first use
+  get terrainData(): Int32Array | null {
+    if (this.terrainCache === undefined) this.terrainCache = denseTerrainData(this.fb);
+    return this.terrainCache;
+  }
+  get entityData(): Int32Array | null {
+    if (this.entityCache === undefined) this.entityCache = denseEntityData(this.fb);
+    return this.entityCache;
+  }
 
   // Index helpers (world space -> local linear index)
   voxelIndex(x: number, y: number, z: number): number {
@@ -7,6 +7,7 @@
 
 export type AetherionWasmModule = {
   EntityInterface: {
+    new (): any;
     // static
     deserialize(bytes: Uint8Array): any;
   };
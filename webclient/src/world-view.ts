@@ -1,5 +1,7 @@
 import { WorldView as FBWorldView } from './game-engine/world-view.js';
 import { VoxelGridView as FBVoxelGridView } from './game-engine/voxel-grid-view.js';
+import { denseEntityData, denseTerrainData } from './voxel-grid-view-flatb.js';
+import { decodeEntityFlatB } from './entity-interface-flatb.js';
 import { getCachedAetherionWasm, loadAetherionWasm } from './wasm/index.js';
 
 // Debug flag: when true, break early after decoding the first entity to verify decode pipeline
@@ -22,8 +24,8 @@ export const WorldView = {
     const yOffset = voxel ? voxel.yOffset() : 0;
     const zOffset = voxel ? voxel.zOffset() : 0;
 
-    const terrainData: Int32Array | null = voxel ? voxel.terrainDataArray() : null;
-    const entityData: Int32Array | null = voxel ? voxel.entityDataArray() : null;
+    const terrainData: Int32Array | null = voxel ? denseTerrainData(voxel) : null;
+    const entityData: Int32Array | null = voxel ? denseEntityData(voxel) : null;
 
   // Build an ID -> EntityInterface (WASM) cache once per WorldView, mirroring C++ WorldView::entities
     const entityById = new Map<number, any>();
@@ -37,12 +39,11 @@ export const WorldView = {
       const e = fbWorldView.entities(i);
       if (!e) continue;
       const id = e.entityId ? e.entityId() : 0;
-      const bytes = e.entityDataArray ? e.entityDataArray() : null;
-      if (!bytes) continue;
       try {
         if (wasm && typeof (wasm as any).EntityInterface?.deserialize === 'function') {
           // Prefer the real C++ struct_pack path via WASM
-          const ent = (wasm as any).EntityInterface.deserialize(bytes);
+          const ent = decodeEntityFlatB(e, wasm);
+          if (!ent) continue;
           if (typeof ent?.set_entity_id === 'function') ent.set_entity_id(id);
           entityById.set(id, ent);
           // console.info(`[WorldView] Entity #${id} decoded via WASM`, ent);
@@ -52,7 +53,7 @@ export const WorldView = {
           try {
             console.info('[WorldView] Early entity decode OK', {
               id,
-              bytesLen: (bytes as any)?.byteLength ?? (bytes as any)?.length,
+              bytesLen: e.entityDataLength(),
               hasComponent: typeof (entityById.get(id)?.has_component) === 'function',
             });
           } catch { }